@@ -9,6 +9,22 @@ THIRD_PARTY_DIR     = path.join(ROOT_DIR, "third_party")
 -- @note these are the new kids
 RUNTIME_DIR         = path.join(SOURCE_DIR, "Runtime")
 SHADER_COMPILER_DIR = path.join(SOURCE_DIR, "ShaderCompiler")
+BENCHMARKS_DIR      = path.join(SOURCE_DIR, "Benchmarks")
+MATH_BENCH_DIR      = path.join(SOURCE_DIR, "MathBench")
+
+-- @note    the instruction set math_simd.h compiles the kernels for. the default runs on any x64 machine since Penryn / Bulldozer,
+--          the wider ones are opt in, e.g. genie --simd=native gmake for benchmarking on the build machine
+newoption {
+    trigger     = "simd",
+    value       = "ISA",
+    description = "Instruction set of the SIMD kernels, sse4 by default",
+    allowed     = {
+        { "sse4",   "SSE4.1" },
+        { "avx2",   "AVX2 with FMA and F16C, Haswell and later" },
+        { "native", "Whatever the build machine has (gmake only, MSVC builds it as avx2)" },
+    }
+}
+SIMD_ISA            = _OPTIONS["simd"] or "sse4"
 
 -- Defaults for all projects
 function project_defaults()
@@ -50,7 +66,8 @@ function project_defaults()
     configuration "Release"
         flags { "OptimizeSpeed", "No64BitChecks" }
         defines { "NDEBUG" }
-    configuration {}
+    -- @note MSVC specific options, the headless tools are also built with gmake on Linux
+    configuration "vs*"
     linkoptions {
         "/ignore:4199", -- LNK4199: no imports found from *.dll
         "/ignore:4668", -- C4668: symbol not defined as a preprocessor macro
@@ -61,6 +78,12 @@ function project_defaults()
         "/OPT:NOICF",
         "/DEBUG:FULL"
     }
+    -- @note    MSVC has no x64 /arch switch below AVX and never defines __SSE4_1__, so the SSE4 baseline is requested through a define
+    if SIMD_ISA == "sse4" then
+        defines { "MINI_SIMD_SSE4_BASELINE" }
+    else
+        buildoptions { "/arch:AVX2" }
+    end
     buildoptions_cpp {
         "/std:c++17",   -- 
         "/wd4100",      -- C4100: unreferenced formal parameter
@@ -70,10 +93,26 @@ function project_defaults()
         "/wd4706",      -- C4706: assignment within conditional expression
         "/wd4251",      -- C4251: struct A needs to have dll-interface to be used by clients of struct B
     }
-    configuration "Release"
+    configuration { "vs*", "Release" }
     buildoptions_cpp {
         "/wd4189",       -- C4189: local variable is initialized but not referenced (imgui.cpp)
     }
+    configuration "gmake"
+    buildoptions_cpp {
+        "-std=c++17",
+        "-Wno-unused-parameter",
+    }
+    if SIMD_ISA == "native" then
+        buildoptions { "-march=native" }
+    elseif SIMD_ISA == "avx2" then
+        buildoptions { "-mavx2", "-mfma", "-mf16c" }
+    else
+        buildoptions { "-msse4.1" }
+    end
+    configuration "linux"
+    links {
+        "pthread",
+    }
     configuration {}
 end -- project_defaults
 
@@ -196,6 +235,36 @@ solution "mini"
             path.join(SHADER_COMPILER_DIR, "**.h"),
         }
     -- ---------------------
+    --  Benchmarks, headless so they can be run on Linux and tracked across commits
+    project "Benchmarks"
+        kind "ConsoleApp"
+        project_defaults()
+        add_eastl()
+        files {
+            path.join(BENCHMARKS_DIR, "**.cpp"),
+            path.join(BENCHMARKS_DIR, "**.h"),
+            path.join(RUNTIME_DIR, "eastl_new.cpp"),
+            path.join(RUNTIME_DIR, "Memory/**.cpp"),
+            path.join(RUNTIME_DIR, "MeshProcessing/**.cpp"),
+            path.join(RUNTIME_DIR, "Culling/**.cpp"),
+            path.join(RUNTIME_DIR, "Math/**.cpp"),
+            path.join(RUNTIME_DIR, "AssetLibraries/GTMesh.cpp"),
+            path.join(RUNTIME_DIR, "AssetLibraries/MeshAllocator.cpp"),
+            path.join(RUNTIME_DIR, "Renderables/StaticMeshBatching.cpp"),
+            path.join(RUNTIME_DIR, "Renderables/StaticMeshScene.cpp"),
+            path.join(RUNTIME_DIR, "Renderables/TransformHierarchy.cpp"),
+        }
+    -- ---------------------
+    --  Math throughput, latency and accuracy per function, headless like the Benchmarks. only needs the math library
+    project "MathBench"
+        kind "ConsoleApp"
+        project_defaults()
+        files {
+            path.join(MATH_BENCH_DIR, "**.cpp"),
+            path.join(MATH_BENCH_DIR, "**.h"),
+            path.join(RUNTIME_DIR, "Math/**.cpp"),
+        }
+    -- ---------------------
     group "Shaders"
         -- ---------------------
         -- Main executable
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include <algorithm>
+
+#include <Runtime/util.h>
+
+namespace mini
+{
+    namespace bench
+    {
+        struct Options
+        {
+            char const* workDir = "bench_corpus";  // @note scratch directory for generated data, relative to the working directory
+            uint32_t    scale   = 1;                // multiplies the size of generated data sets
+            bool        csv     = false;            // print results as csv so they can be tracked across commits
+        };
+
+        struct LatencyStats
+        {
+            double p50  = 0.0;
+            double p99  = 0.0;
+            double mean = 0.0;
+            double max  = 0.0;
+        };
+
+        inline LatencyStats ComputeLatencyStats(std::vector<double> samples)
+        {
+            LatencyStats stats;
+            if (samples.empty()) { return stats; }
+            std::sort(samples.begin(), samples.end());
+            auto Percentile = [&](double p) {
+                auto const index = static_cast<size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+                return samples[index];
+            };
+            stats.p50 = Percentile(0.5);
+            stats.p99 = Percentile(0.99);
+            stats.max = samples.back();
+            double sum = 0.0;
+            for (auto s : samples) { sum += s; }
+            stats.mean = sum / static_cast<double>(samples.size());
+            return stats;
+        }
+
+        // @note keeps the optimizer from discarding results of benchmarked code
+        template <class T>
+        inline void DoNotOptimize(T const& value)
+        {
+#if defined(_MSC_VER)
+            static volatile char sink;
+            sink = *reinterpret_cast<char const volatile*>(&value);
+#else
+            asm volatile("" : : "r,m"(value) : "memory");
+#endif
+        }
+
+        // @note    average time of numRuns back to back calls of kernel, in nanoseconds per element when each call processes count of them
+        template <class Kernel>
+        inline double MeasureNsPerElement(uint32_t count, uint32_t numRuns, Kernel&& kernel)
+        {
+            Timer timer;
+            for (auto run = 0u; run < numRuns; ++run) { kernel(); }
+            return timer.GetElapsedTime() * 1e9 / (static_cast<double>(numRuns) * count);
+        }
+
+        // benchmark entry points, see main.cpp
+        int RunResourceLoadBenchmark(Options const& options);
+        int RunSlotMapBenchmark(Options const& options);
+        int RunOffsetAllocatorBenchmark(Options const& options);
+        int RunRingAllocatorBenchmark(Options const& options);
+        int RunMeshStreamingBenchmark(Options const& options);
+        int RunVertexQuantizationBenchmark(Options const& options);
+        int RunMeshOptimizerBenchmark(Options const& options);
+        int RunMeshletBenchmark(Options const& options);
+        int RunMeshLodBenchmark(Options const& options);
+        int RunGTMeshLoadBenchmark(Options const& options);
+        int RunMeshBoundsBenchmark(Options const& options);
+        int RunStaticMeshBatchingBenchmark(Options const& options);
+        int RunStaticBatchingBenchmark(Options const& options);
+        int RunMathSimdBenchmark(Options const& options);
+        int RunMathBatchBenchmark(Options const& options);
+        int RunFrustumCullingBenchmark(Options const& options);
+        int RunMathApproxBenchmark(Options const& options);
+        int RunPackingBenchmark(Options const& options);
+        int RunQuatAnimBenchmark(Options const& options);
+        int RunStaticMeshSceneBenchmark(Options const& options);
+        int RunTransformHierarchyBenchmark(Options const& options);
+    }
+}
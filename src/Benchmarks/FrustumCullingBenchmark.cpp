@@ -0,0 +1,165 @@
+#include "Benchmark.h"
+
+#include <Runtime/Math/math_batch.h>
+#include <Runtime/Math/math_functions.h>
+#include <Runtime/Culling/MeshletCulling.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+    struct Bounds
+    {
+        std::vector<float> x, y, z;         // centers
+        std::vector<float> ex, ey, ez;      // half extents
+        std::vector<float> radius;          // the box's bounding sphere
+    };
+
+    // smallest margin over the planes, in double: negative if outside. the boxes use their extent projected on each normal
+    double Margin(mini::math::frustum_t const& frustum, Bounds const& b, uint32_t i, bool box)
+    {
+        auto margin = INFINITY;
+        for (auto const& plane : frustum.planes) {
+            auto const distance = static_cast<double>(plane.normal.x) * b.x[i] + static_cast<double>(plane.normal.y) * b.y[i]
+                + static_cast<double>(plane.normal.z) * b.z[i] + plane.d;
+            auto const radius = box ? fabs(plane.normal.x) * b.ex[i] + fabs(plane.normal.y) * b.ey[i] + fabs(plane.normal.z) * b.ez[i] : b.radius[i];
+            margin = fmin(margin, distance + radius);
+        }
+        return margin;
+    }
+
+    // what a per object loop looks like, with an early out at the first plane the bounds are outside of
+    uint32_t CullScalar(mini::math::frustum_t const& frustum, Bounds const& b, uint32_t count, bool box, uint32_t* outVisible)
+    {
+        uint32_t numVisible = 0;
+        for (auto i = 0u; i < count; ++i) {
+            bool outside = false;
+            for (auto p = 0; p < mini::math::frustum_t::NUM_PLANES && !outside; ++p) {
+                auto const& plane = frustum.planes[p];
+                auto const distance = plane.normal.x * b.x[i] + plane.normal.y * b.y[i] + plane.normal.z * b.z[i] + plane.d;
+                auto const radius = box ? fabsf(plane.normal.x) * b.ex[i] + fabsf(plane.normal.y) * b.ey[i] + fabsf(plane.normal.z) * b.ez[i] : b.radius[i];
+                outside = distance < -radius;
+            }
+            if (!outside) { outVisible[numVisible++] = i; }
+        }
+        return numVisible;
+    }
+
+    // @note    the kernels and the double reference may only disagree about bounds touching a plane, where rounding decides
+    bool CheckVisible(mini::math::frustum_t const& frustum, Bounds const& b, uint32_t count, bool box, uint32_t const* visible, uint32_t numVisible)
+    {
+        bool ok = true;
+        auto next = 0u;
+        for (auto i = 0u; i < count; ++i) {
+            auto const kept = next < numVisible && visible[next] == i;
+            next += kept ? 1 : 0;
+            auto const margin = Margin(frustum, b, i, box);
+            ok &= kept == (margin >= 0.0) || fabs(margin) < 1e-3;
+        }
+        return ok && next == numVisible;
+    }
+}
+
+int mini::bench::RunFrustumCullingBenchmark(Options const& options)
+{
+    std::mt19937 rng(0xf257);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    bool ok = true;
+
+    math::vec3f_t const eye(0.0f, 10.0f, 0.0f);
+    auto const proj = math::make_perspective_proj(math::DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    auto const view = math::inverse(math::make_lookat(eye, math::vec3f_t(300.0f, 0.0f, 200.0f), math::vec3f_t(0.0f, 1.0f, 0.0f)));
+    auto const viewProj = proj * view;
+    auto const frustum = math::make_frustum(viewProj);
+
+    {   // points unprojected from inside the clip volume are inside every plane, points just outside it are outside one
+        auto const inverseViewProj = math::inverse(viewProj);
+        auto const Unproject = [&](float x, float y, float z) {
+            auto const p = inverseViewProj * math::vec4f_t(x, y, z, 1.0f);
+            return p.xyz / p.w;
+        };
+        for (auto i = 0; i < 1000; ++i) {
+            auto const inside = Unproject(unit(rng) * 0.99f, unit(rng) * 0.99f, 0.5f + unit(rng) * 0.49f);
+            auto const outside = Unproject(unit(rng) > 0.0f ? 1.05f : -1.05f, unit(rng) * 0.99f, 0.5f + unit(rng) * 0.49f);
+            auto minInside = INFINITY, minOutside = INFINITY;
+            for (auto const& plane : frustum.planes) {
+                minInside = fminf(minInside, math::dot(plane.normal, inside) + plane.d);
+                minOutside = fminf(minOutside, math::dot(plane.normal, outside) + plane.d);
+            }
+            ok &= minInside >= 0.0f && minOutside < 0.0f;
+        }
+
+        // the same planes as the culling view built from the camera directly, in some order
+        float const position[3] = { eye.x, eye.y, eye.z };
+        float const forward[3] = { 300.0f - eye.x, -eye.y, 200.0f - eye.z };
+        float const up[3] = { 0.0f, 1.0f, 0.0f };
+        auto const cullingView = MakeCullingView(position, forward, up, math::DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+        for (auto const& plane : frustum.planes) {
+            bool found = false;
+            for (auto const& other : cullingView.frustumPlanes) {
+                auto const scale = fmaxf(1.0f, fabsf(other[3]));
+                found |= fabsf(plane.normal.x - other[0]) < 1e-4f && fabsf(plane.normal.y - other[1]) < 1e-4f && fabsf(plane.normal.z - other[2]) < 1e-4f
+                    && fabsf(plane.d - other[3]) < 1e-4f * scale;
+            }
+            ok &= found;
+        }
+    }
+
+    if (options.csv) {
+        printf("benchmark,bounds,count,visible,scalar_ms,batch_ms,speedup,batch_ns_per_bound\n");
+    }
+    else {
+        printf("%-8s %8s %8s %10s %10s %8s %14s\n", "bounds", "count", "visible", "scalar ms", "batch ms", "speedup", "batch ns/bound");
+    }
+    // @note 100k objects spread around the camera, about a tenth of them in view. the odd count leaves a tail
+    for (auto const count : { 100000u * options.scale + 5, 1000000u * options.scale + 3 }) {
+        Bounds b;
+        for (auto v : { &b.x, &b.y, &b.z, &b.ex, &b.ey, &b.ez, &b.radius }) { v->resize(count); }
+        for (auto i = 0u; i < count; ++i) {
+            b.x[i] = unit(rng) * 600.0f;
+            b.y[i] = unit(rng) * 20.0f;
+            b.z[i] = unit(rng) * 600.0f;
+            b.ex[i] = 0.5f + (unit(rng) + 1.0f) * 2.0f;
+            b.ey[i] = 0.5f + (unit(rng) + 1.0f) * 2.0f;
+            b.ez[i] = 0.5f + (unit(rng) + 1.0f) * 2.0f;
+            b.radius[i] = sqrtf(b.ex[i] * b.ex[i] + b.ey[i] * b.ey[i] + b.ez[i] * b.ez[i]);
+        }
+        math::vec3f_soa_const_t const centers(b.x.data(), b.y.data(), b.z.data());
+        math::vec3f_soa_const_t const extents(b.ex.data(), b.ey.data(), b.ez.data());
+        std::vector<uint32_t> visible(count), reference(count);
+        auto const numRuns = std::max(1u, 20u * 100000u / count);
+
+        for (auto const box : { false, true }) {
+            uint32_t numScalar = 0, numBatch = 0;
+            Timer timer;
+            for (auto run = 0u; run < numRuns; ++run) { numScalar = CullScalar(frustum, b, count, box, reference.data()); }
+            auto const scalarMs = timer.GetElapsedTime() * 1000.0 / numRuns;
+            timer.Reset();
+            for (auto run = 0u; run < numRuns; ++run) {
+                numBatch = box ? math::cull_aabbs_batch(frustum, centers, extents, count, visible.data())
+                    : math::cull_spheres_batch(frustum, centers, b.radius.data(), count, visible.data());
+                DoNotOptimize(visible[0]);
+            }
+            auto const batchMs = timer.GetElapsedTime() * 1000.0 / numRuns;
+            ok &= CheckVisible(frustum, b, count, box, visible.data(), numBatch) && CheckVisible(frustum, b, count, box, reference.data(), numScalar);
+            ok &= numBatch > 0 && numBatch < count;
+
+            auto const name = box ? "aabb" : "sphere";
+            if (options.csv) {
+                printf("frustumcull,%s,%u,%u,%.4f,%.4f,%.2f,%.3f\n", name, count, numBatch, scalarMs, batchMs, scalarMs / batchMs, batchMs * 1e6 / count);
+            }
+            else {
+                printf("%-8s %8u %8u %10.4f %10.4f %7.2fx %14.3f\n", name, count, numBatch, scalarMs, batchMs, scalarMs / batchMs, batchMs * 1e6 / count);
+            }
+        }
+    }
+
+    if (!options.csv) {
+        printf("(backend %s)\n", math::GetSimdBackendName());
+        printf("frustum culling checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
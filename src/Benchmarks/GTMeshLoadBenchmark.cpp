@@ -0,0 +1,263 @@
+#include "Benchmark.h"
+#include "TestMeshes.h"
+
+#include <Runtime/AssetLibraries/GTMesh.h>
+#include <Runtime/Resources/ResourceManager.h>
+#include <Runtime/util.h>
+
+#include <random>
+#include <string>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    using BenchResourceManager = mini::ResourceManager<16384>;
+
+    struct CorpusFile
+    {
+        std::string                 path;
+        uint64_t                    size = 0;
+        mini::GTMeshParseResult     expected = mini::GTMeshParseResult::Success;
+        mini::GTMeshIndexFormat     indexFormat = mini::GTMeshIndexFormat::UInt16;
+    };
+
+    // small, medium and large meshes in both supported layouts, plus one file per validation failure
+    bool GenerateCorpus(mini::bench::Options const& options, std::vector<CorpusFile>& outFiles)
+    {
+        std::string dir;
+        if (!mini::bench::MakeCorpusDirectory(options, "gtmesh", &dir)) { return false; }
+
+        std::mt19937 rng(0x97e5);
+        auto const numFiles = 400u * options.scale;
+        for (auto i = 0u; i < numFiles; ++i) {
+            auto const bucket = rng() % 10;
+            auto const numVertices = bucket < 3 ? 64 + rng() % 192 : bucket < 9 ? 1024 + rng() % 15000 : 100000 + rng() % 100000;
+            auto const vertexFormat = rng() % 2 == 0 ? mini::GTMeshVertexFormat::PositionNormal : mini::GTMeshVertexFormat::PositionNormalTangentTexcoord0;
+            auto const data = mini::bench::MakeGTMesh(vertexFormat, numVertices, i % 3 != 0, rng);
+            char name[64];
+            snprintf(name, sizeof(name), "/mesh_%05u.gtmesh", i);
+            if (!mini::bench::WriteFile((dir + name).c_str(), data)) { return false; }
+            outFiles.push_back({ dir + name, data.size(), mini::GTMeshParseResult::Success, static_cast<mini::GTMeshIndexFormat>(data[1]) });
+        }
+
+        struct Corruption
+        {
+            char const*             name;
+            mini::GTMeshParseResult expected;
+            void(*apply)(std::vector<char>&);
+        };
+        Corruption const corruptions[] = {
+            { "truncated_header", mini::GTMeshParseResult::TooSmall, [](std::vector<char>& d) { d.resize(20); } },
+            { "unknown_vertex_format", mini::GTMeshParseResult::UnknownVertexFormat, [](std::vector<char>& d) { d[0] = 42; } },
+            { "unsupported_vertex_format", mini::GTMeshParseResult::UnsupportedVertexFormat, [](std::vector<char>& d) { d[0] = 8; } },
+            { "unknown_index_format", mini::GTMeshParseResult::UnknownIndexFormat, [](std::vector<char>& d) { d[1] = 7; } },
+            { "non_indexed", mini::GTMeshParseResult::UnsupportedIndexFormat, [](std::vector<char>& d) { d[1] = 0; } },
+            { "huge_vertex_count", mini::GTMeshParseResult::InvalidCounts, [](std::vector<char>& d) { uint64_t const v = 1ull << 40; memcpy(d.data() + 2, &v, 8); } },
+            { "partial_triangle", mini::GTMeshParseResult::InvalidCounts, [](std::vector<char>& d) { uint64_t v; memcpy(&v, d.data() + 10, 8); v -= 1; memcpy(d.data() + 10, &v, 8); } },
+            { "truncated_indices", mini::GTMeshParseResult::SizeMismatch, [](std::vector<char>& d) { d.resize(d.size() - 40); } },
+            { "trailing_bytes", mini::GTMeshParseResult::SizeMismatch, [](std::vector<char>& d) { d.resize(d.size() + 3, 0); } },
+            { "submesh_out_of_range", mini::GTMeshParseResult::InvalidSubmesh, [](std::vector<char>& d) { uint64_t const v = 1ull << 33; memcpy(d.data() + d.size() - 8, &v, 8); } },
+        };
+        for (auto const& corruption : corruptions) {
+            auto data = mini::bench::MakeGTMesh(mini::GTMeshVertexFormat::PositionNormalTangentTexcoord0, 4096, true, rng);
+            corruption.apply(data);
+            auto const path = dir + "/corrupt_" + corruption.name + ".gtmesh";
+            if (!mini::bench::WriteFile(path.c_str(), data)) { return false; }
+            outFiles.push_back({ path, data.size(), corruption.expected, mini::GTMeshIndexFormat::UInt16 });
+        }
+
+        std::shuffle(outFiles.begin(), outFiles.end(), rng);
+        return true;
+    }
+
+    // @note    stands in for MeshLibrary::AllocateWithData, which can't run without a device: the mesh data is written into a
+    //          staging ring in chunks, the only copy the zero copy path makes
+    struct StagingSink
+    {
+        std::vector<char>   ring = std::vector<char>(16 * 1024 * 1024);
+        size_t              head = 0;
+        uint64_t            bytesStaged = 0;
+
+        void Stage(char const* src, uint32_t size)
+        {
+            auto const maxChunkSize = ring.size() / 4;
+            while (size > 0) {
+                auto const chunkSize = size < maxChunkSize ? size : static_cast<uint32_t>(maxChunkSize);
+                head = head + chunkSize > ring.size() ? 0 : head;
+                memcpy(ring.data() + head, src, chunkSize);
+                head += chunkSize;
+                src += chunkSize;
+                size -= chunkSize;
+                bytesStaged += chunkSize;
+            }
+        }
+    };
+
+    struct LoadContext
+    {
+        StagingSink                 sink;
+        mini::GTMeshScratch         scratch;
+        bool                        copyFirst = false;      // @note baseline: copy vertices and indices out of the file before staging them
+        uint32_t                    numWidened = 0;
+        mini::GTMeshParseResult     lastResult = mini::GTMeshParseResult::Success;
+        mini::MeshData              lastData;
+    };
+
+    bool LoadGTMesh(LoadContext& context, mini::Resource* resource)
+    {
+        mini::GTMeshView view;
+        context.lastResult = mini::ParseGTMesh(resource->GetData(), resource->GetInfo().file.size, &view);
+        if (context.lastResult != mini::GTMeshParseResult::Success) { return false; }
+
+        mini::MeshData data;
+        mini::GetGTMeshData(view, &context.scratch, &data);
+        context.numWidened += view.indexFormat == mini::GTMeshIndexFormat::UInt8 ? 1 : 0;
+        if (context.copyFirst) {
+            std::vector<char> vertices(data.vertexData, data.vertexData + data.vertexDataSize);
+            std::vector<char> indices(data.indexData, data.indexData + data.indexDataSize);
+            context.sink.Stage(vertices.data(), data.vertexDataSize);
+            context.sink.Stage(indices.data(), data.indexDataSize);
+        }
+        else {
+            context.sink.Stage(data.vertexData, data.vertexDataSize);
+            context.sink.Stage(data.indexData, data.indexDataSize);
+        }
+        context.lastData = data;
+        return true;
+    }
+
+    // the widened or referenced indices, the submeshes and the bounds, given or computed, have to describe the grid the generator wrote
+    bool CheckMeshData(mini::MeshData const& data)
+    {
+        auto const stride = mini::GetIndexFormatStride(data.indexFormat);
+        auto const numIndices = data.indexDataSize / stride;
+        auto const numVertices = data.vertexDataSize / data.vertexStride;
+        uint32_t first[6];
+        for (auto i = 0u; i < 6 && i < numIndices; ++i) {
+            if (stride == 2) { uint16_t v; memcpy(&v, data.indexData + i * 2, 2); first[i] = v; }
+            else { memcpy(first + i, data.indexData + i * 4, 4); }
+        }
+        float position[3];
+        memcpy(position, data.vertexData + (numVertices - 1) * data.vertexStride, sizeof(position));
+        auto const rows = numVertices / 16;
+        bool const boundsOk = data.bounds != nullptr && data.bounds->aabbMin[0] == 0.0f && data.bounds->aabbMax[0] == 15.0f && data.bounds->aabbMin[2] == 0.0f
+            && data.bounds->aabbMax[2] == static_cast<float>(rows - 1) && data.bounds->aabbMax[1] <= 0.1f && data.bounds->sphereRadius > 0.0f;
+        bool const submeshesOk = data.numSubmeshes == 2 && data.submeshes[0].firstIndex == 0 && data.submeshes[0].materialSlot == 0
+            && data.submeshes[1].firstIndex == data.submeshes[0].numIndices && data.submeshes[1].materialSlot == 1
+            && data.submeshes[0].numIndices + data.submeshes[1].numIndices == numIndices;
+        return boundsOk && submeshesOk && numIndices >= 6 && first[0] == 0 && first[1] == 16 && first[2] == 1 && first[3] == 1 && first[5] == 17
+            && position[0] == 15.0f && position[2] == static_cast<float>(numVertices / 16 - 1);
+    }
+
+    struct RunResult
+    {
+        uint64_t            bytes = 0;
+        uint32_t            loaded = 0;
+        uint32_t            rejected = 0;
+        uint32_t            widened = 0;
+        double              seconds = 0.0;
+        bool                ok = true;
+        std::vector<double> latencies;  // in microseconds
+    };
+
+    RunResult LoadCorpus(std::vector<CorpusFile> const& files, bool copyFirst)
+    {
+        auto manager = new BenchResourceManager;
+        LoadContext context;
+        context.copyFirst = copyFirst;
+        auto contextPtr = &context;
+        manager->RegisterResourceHandler(mini::ResourceType::Mesh, [contextPtr](mini::Resource* resource) { return LoadGTMesh(*contextPtr, resource); });
+
+        RunResult result;
+        result.latencies.reserve(files.size());
+        mini::Timer total;
+        uint32_t nextId = 1;
+        for (auto const& file : files) {
+            mini::Timer timer;
+            auto const res = manager->LoadResource(file.path.c_str(), { nextId++ });
+            result.latencies.push_back(timer.GetElapsedTime() * 1e6);
+            if (res == mini::ResourceLoadResult::Success) {
+                result.bytes += file.size;
+                result.loaded++;
+                result.ok &= file.expected == mini::GTMeshParseResult::Success && CheckMeshData(context.lastData);
+                result.ok &= (context.lastData.indexData == context.scratch.indexData.data()) == (file.indexFormat == mini::GTMeshIndexFormat::UInt8);
+            }
+            else {
+                result.rejected++;
+                result.ok &= res == mini::ResourceLoadResult::InvalidData && context.lastResult == file.expected;
+                if (res == mini::ResourceLoadResult::InvalidData && context.lastResult != file.expected) {
+                    printf("%s: expected %s, got %s\n", file.path.c_str(), mini::GetGTMeshParseResultName(file.expected), mini::GetGTMeshParseResultName(context.lastResult));
+                }
+            }
+        }
+        result.seconds = total.GetElapsedTime();
+        result.widened = context.numWidened;
+        result.ok &= manager->GetNumResources() == result.loaded;  // @note rejected files must not stay resident
+        manager->UnloadAll();
+        delete manager;
+        return result;
+    }
+}
+
+int mini::bench::RunGTMeshLoadBenchmark(Options const& options)
+{
+    std::vector<CorpusFile> files;
+    if (!GenerateCorpus(options, files)) {
+        printf("Failed to generate .gtmesh corpus\n");
+        return 1;
+    }
+    uint32_t numValid = 0, numUInt8 = 0;
+    uint64_t corpusBytes = 0;
+    for (auto const& file : files) {
+        corpusBytes += file.size;
+        numValid += file.expected == GTMeshParseResult::Success ? 1 : 0;
+        numUInt8 += file.expected == GTMeshParseResult::Success && file.indexFormat == GTMeshIndexFormat::UInt8 ? 1 : 0;
+    }
+
+    // parse cost alone, on a file already in memory
+    double parseNs = 0.0;
+    {
+        std::mt19937 rng(1);
+        auto const data = bench::MakeGTMesh(GTMeshVertexFormat::PositionNormalTangentTexcoord0, 32768, true, rng);
+        uint32_t const numRuns = 1000000;
+        Timer timer;
+        for (auto i = 0u; i < numRuns; ++i) {
+            GTMeshView view;
+            auto const result = ParseGTMesh(data.data(), data.size(), &view);
+            DoNotOptimize(result);
+            DoNotOptimize(view);
+        }
+        parseNs = timer.GetElapsedTime() * 1e9 / numRuns;
+    }
+
+    bool ok = true;
+    if (options.csv) {
+        printf("benchmark,path,loaded,rejected,widened,mb,mb_per_sec,meshes_per_sec,p50_us,p99_us\n");
+    }
+    else {
+        printf("corpus: %zu files (%u valid, %u with UINT8 indices), %.1f MB\n", files.size(), numValid, numUInt8, static_cast<double>(corpusBytes) / (1024.0 * 1024.0));
+        printf("%-10s %8s %8s %8s %10s %10s %12s %10s %10s\n", "path", "loaded", "rejected", "widened", "MB", "MB/s", "meshes/s", "p50 us", "p99 us");
+    }
+    LoadCorpus(files, false);   // @note untimed pass so both paths read from the page cache
+    for (auto const copyFirst : { false, true }) {
+        auto const result = LoadCorpus(files, copyFirst);
+        ok &= result.ok && result.loaded == numValid && result.rejected == files.size() - numValid && result.widened == numUInt8;
+        auto const stats = ComputeLatencyStats(result.latencies);
+        auto const mb = static_cast<double>(result.bytes) / (1024.0 * 1024.0);
+        auto const name = copyFirst ? "copy" : "zerocopy";
+        if (options.csv) {
+            printf("gtmesh,%s,%u,%u,%u,%.3f,%.2f,%.1f,%.2f,%.2f\n", name, result.loaded, result.rejected, result.widened, mb, mb / result.seconds,
+                result.loaded / result.seconds, stats.p50, stats.p99);
+        }
+        else {
+            printf("%-10s %8u %8u %8u %10.1f %10.1f %12.1f %10.2f %10.2f\n", name, result.loaded, result.rejected, result.widened, mb, mb / result.seconds,
+                result.loaded / result.seconds, stats.p50, stats.p99);
+        }
+    }
+    if (!options.csv) {
+        printf("parse: %.1f ns per header\n", parseNs);
+        printf("gtmesh checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
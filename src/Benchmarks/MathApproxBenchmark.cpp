@@ -0,0 +1,227 @@
+#include "Benchmark.h"
+
+#include <Runtime/Math/math_batch.h>
+#include <Runtime/Math/math_functions.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    enum class ErrorUnit { Absolute, Relative, Ulp };
+
+    // one function's inputs with its double precision reference, the three tiers timed and the fast ones measured against it
+    struct Case
+    {
+        char const*         function;
+        char const*         domain;
+        ErrorUnit           unit;
+        double              bound;
+        std::vector<float>  a, b;           // b only for atan2
+        std::vector<double> reference;
+    };
+
+    double Error(ErrorUnit unit, float value, double reference)
+    {
+        auto const difference = fabs(static_cast<double>(value) - reference);
+        switch (unit) {
+        case ErrorUnit::Absolute: return difference;
+        case ErrorUnit::Relative: return difference / fabs(reference);
+        default: {
+            // @note in units of the float spacing at the reference
+            auto const rounded = fabsf(static_cast<float>(reference));
+            return difference / (nextafterf(rounded, INFINITY) - rounded);
+        }
+        }
+    }
+
+    double MaxError(Case const& c, std::vector<float> const& values)
+    {
+        double largest = 0.0;
+        for (size_t i = 0; i < values.size(); ++i) { largest = fmax(largest, Error(c.unit, values[i], c.reference[i])); }
+        return largest;
+    }
+
+    // count floats evenly spaced over [lo, hi]
+    std::vector<float> Linear(float lo, float hi, uint32_t count)
+    {
+        std::vector<float> values(count);
+        for (auto i = 0u; i < count; ++i) { values[i] = static_cast<float>(lo + (static_cast<double>(hi) - lo) * i / (count - 1)); }
+        return values;
+    }
+
+    // count floats evenly spaced in their bit patterns over every positive normal float: every exponent, many mantissas
+    std::vector<float> PositiveNormals(uint32_t count)
+    {
+        std::vector<float> values(count);
+        uint32_t const first = 0x00800000u, last = 0x7f7fffffu;
+        for (auto i = 0u; i < count; ++i) {
+            auto const bits = first + static_cast<uint32_t>((static_cast<uint64_t>(last - first) * i) / (count - 1));
+            memcpy(&values[i], &bits, sizeof(float));
+        }
+        return values;
+    }
+
+    // @note    the fastest run of each tier rather than the average, the tiers are compared against each other and other processes
+    //          only ever add time. runs are interleaved and the tier that goes first rotates, so frequency changes, other processes
+    //          and whatever the previous kernel left in the caches and predictors hit the three tiers alike
+    template <class Crt, class Fast, class Batch>
+    void MeasureTiers(uint32_t count, uint32_t numRuns, Crt&& crt, Fast&& fast, Batch&& batch, double* outNs)
+    {
+        outNs[0] = outNs[1] = outNs[2] = 1e30;
+        for (auto run = 0u; run < numRuns; ++run) {
+            for (auto i = 0u; i < 3; ++i) {
+                auto const tier = (run + i) % 3;
+                auto const ns = tier == 0 ? MeasureNsPerElement(count, 1, crt) : tier == 1 ? MeasureNsPerElement(count, 1, fast) : MeasureNsPerElement(count, 1, batch);
+                outNs[tier] = fmin(outNs[tier], ns);
+            }
+        }
+    }
+}
+
+int mini::bench::RunMathApproxBenchmark(Options const& options)
+{
+    std::mt19937 rng(0xa9f0);
+    bool ok = true;
+    auto const count = (1u << 20) * options.scale;
+    auto const numRuns = 16u;
+
+    std::vector<Case> cases;
+    cases.push_back({ "sin", "|v| <= 8192", ErrorUnit::Absolute, 1.5e-7, Linear(-8192.0f, 8192.0f, count), {}, {} });
+    cases.push_back({ "cos", "|v| <= 8192", ErrorUnit::Absolute, 1.5e-7, Linear(-8192.0f, 8192.0f, count), {}, {} });
+    cases.push_back({ "sincos", "|v| <= pi", ErrorUnit::Absolute, 1.5e-7, Linear(-3.14159265f, 3.14159265f, count), {}, {} });
+    cases.push_back({ "rsqrt", "normal v > 0", ErrorUnit::Relative, ldexp(1.0, -21), PositiveNormals(count), {}, {} });
+    cases.push_back({ "atan2", "finite", ErrorUnit::Absolute, 4e-7, {}, {}, {} });
+    cases.push_back({ "exp", "[-87.3, 88.3]", ErrorUnit::Ulp, 2.0, Linear(-87.3f, 88.3f, count), {}, {} });
+    cases.push_back({ "log", "normal v > 0", ErrorUnit::Ulp, 2.0, PositiveNormals(count), {}, {} });
+
+    {   // points on circles from 1e-3 to 1e3 at every angle, the axes and the origin
+        auto& atan2Case = cases[4];
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        for (auto i = 0u; i < count; ++i) {
+            auto const angle = unit(rng) * 3.14159265;
+            auto const radius = pow(10.0, unit(rng) * 3.0);
+            atan2Case.b.push_back(static_cast<float>(radius * cos(angle)));
+            atan2Case.a.push_back(static_cast<float>(radius * sin(angle)));
+        }
+        float const axes[][2] = { { 0.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, -1.0f }, { -1.0f, 0.0f }, { 0.0f, 0.0f }, { 1.0f, 1.0f }, { -1.0f, -1.0f } };
+        for (auto const& axis : axes) {
+            atan2Case.a.push_back(axis[0]);
+            atan2Case.b.push_back(axis[1]);
+        }
+    }
+
+    for (auto& c : cases) {
+        c.reference.resize(c.a.size());
+        for (size_t i = 0; i < c.a.size(); ++i) {
+            double const v = c.a[i];
+            auto const name = c.function;
+            c.reference[i] = !strcmp(name, "sin") || !strcmp(name, "sincos") ? sin(v) : !strcmp(name, "cos") ? cos(v)
+                : !strcmp(name, "rsqrt") ? 1.0 / sqrt(v) : !strcmp(name, "atan2") ? atan2(v, static_cast<double>(c.b[i]))
+                : !strcmp(name, "exp") ? exp(v) : log(v);
+        }
+    }
+
+    if (options.csv) {
+        printf("benchmark,function,domain,unit,bound,crt_error,fast_error,batch_error,crt_ns,fast_ns,batch_ns,fast_speedup,batch_speedup\n");
+    }
+    else {
+        printf("%-7s %-14s %-4s %9s %9s %9s %9s %8s %8s %8s %7s %7s\n", "func", "domain", "unit", "bound", "crt err", "fast err", "batch err",
+            "crt ns", "fast ns", "batch ns", "fast x", "batch x");
+    }
+    for (auto const& c : cases) {
+        auto const n = static_cast<uint32_t>(c.a.size());
+        auto const name = c.function;
+        std::vector<float> crt(n), fast(n), batch(n), second(n);
+        double ns[3] = {};
+
+        // @note the CRT row goes through the exact tier, math::sin and so on. sincos checks both outputs
+        if (!strcmp(name, "sin") || !strcmp(name, "sincos")) {
+            if (!strcmp(name, "sin")) {
+                MeasureTiers(n, numRuns,
+                    [&]() { for (auto i = 0u; i < n; ++i) { crt[i] = math::sin(c.a[i]); } DoNotOptimize(crt[0]); },
+                    [&]() { for (auto i = 0u; i < n; ++i) { fast[i] = math::fast_sin(c.a[i]); } DoNotOptimize(fast[0]); },
+                    [&]() { math::fast_sin_batch(c.a.data(), batch.data(), n); DoNotOptimize(batch[0]); }, ns);
+            }
+            else {
+                // @note both outputs on every tier
+                std::vector<float> batchCos(n);
+                MeasureTiers(n, numRuns,
+                    [&]() { for (auto i = 0u; i < n; ++i) { crt[i] = math::sin(c.a[i]); second[i] = math::cos(c.a[i]); } DoNotOptimize(crt[0]); },
+                    [&]() { for (auto i = 0u; i < n; ++i) { math::fast_sincos(c.a[i], &fast[i], &second[i]); } DoNotOptimize(fast[0]); },
+                    [&]() { math::fast_sincos_batch(c.a.data(), batch.data(), batchCos.data(), n); DoNotOptimize(batch[0]); }, ns);
+                for (auto i = 0u; i < n; ++i) {
+                    ok &= Error(c.unit, second[i], cos(static_cast<double>(c.a[i]))) <= c.bound;
+                    ok &= Error(c.unit, batchCos[i], cos(static_cast<double>(c.a[i]))) <= c.bound;
+                }
+            }
+        }
+        else if (!strcmp(name, "cos")) {
+            MeasureTiers(n, numRuns,
+                [&]() { for (auto i = 0u; i < n; ++i) { crt[i] = math::cos(c.a[i]); } DoNotOptimize(crt[0]); },
+                [&]() { for (auto i = 0u; i < n; ++i) { fast[i] = math::fast_cos(c.a[i]); } DoNotOptimize(fast[0]); },
+                [&]() { math::fast_cos_batch(c.a.data(), batch.data(), n); DoNotOptimize(batch[0]); }, ns);
+        }
+        else if (!strcmp(name, "rsqrt")) {
+            MeasureTiers(n, numRuns,
+                [&]() { for (auto i = 0u; i < n; ++i) { crt[i] = math::rsqrt(c.a[i]); } DoNotOptimize(crt[0]); },
+                [&]() { for (auto i = 0u; i < n; ++i) { fast[i] = math::fast_rsqrt(c.a[i]); } DoNotOptimize(fast[0]); },
+                [&]() { math::fast_rsqrt_batch(c.a.data(), batch.data(), n); DoNotOptimize(batch[0]); }, ns);
+        }
+        else if (!strcmp(name, "atan2")) {
+            MeasureTiers(n, numRuns,
+                [&]() { for (auto i = 0u; i < n; ++i) { crt[i] = math::atan2(c.a[i], c.b[i]); } DoNotOptimize(crt[0]); },
+                [&]() { for (auto i = 0u; i < n; ++i) { fast[i] = math::fast_atan2(c.a[i], c.b[i]); } DoNotOptimize(fast[0]); },
+                [&]() { math::fast_atan2_batch(c.a.data(), c.b.data(), batch.data(), n); DoNotOptimize(batch[0]); }, ns);
+        }
+        else if (!strcmp(name, "exp")) {
+            MeasureTiers(n, numRuns,
+                [&]() { for (auto i = 0u; i < n; ++i) { crt[i] = math::exp(c.a[i]); } DoNotOptimize(crt[0]); },
+                [&]() { for (auto i = 0u; i < n; ++i) { fast[i] = math::fast_exp(c.a[i]); } DoNotOptimize(fast[0]); },
+                [&]() { math::fast_exp_batch(c.a.data(), batch.data(), n); DoNotOptimize(batch[0]); }, ns);
+        }
+        else {
+            MeasureTiers(n, numRuns,
+                [&]() { for (auto i = 0u; i < n; ++i) { crt[i] = math::log(c.a[i]); } DoNotOptimize(crt[0]); },
+                [&]() { for (auto i = 0u; i < n; ++i) { fast[i] = math::fast_log(c.a[i]); } DoNotOptimize(fast[0]); },
+                [&]() { math::fast_log_batch(c.a.data(), batch.data(), n); DoNotOptimize(batch[0]); }, ns);
+        }
+
+        auto const crtError = MaxError(c, crt), fastError = MaxError(c, fast), batchError = MaxError(c, batch);
+        ok &= fastError <= c.bound && batchError <= c.bound;
+        // @note the speedups are reported but never gated on, they depend on the build flags and the machine
+        auto const crtNs = ns[0], fastNs = ns[1], batchNs = ns[2];
+        char const* const units[] = { "abs", "rel", "ulp" };
+        auto const unit = units[static_cast<int>(c.unit)];
+        if (options.csv) {
+            printf("mathapprox,%s,%s,%s,%.3g,%.3g,%.3g,%.3g,%.3f,%.3f,%.3f,%.2f,%.2f\n", name, c.domain, unit, c.bound, crtError, fastError, batchError,
+                crtNs, fastNs, batchNs, crtNs / fastNs, crtNs / batchNs);
+        }
+        else {
+            printf("%-7s %-14s %-4s %9.3g %9.3g %9.3g %9.3g %8.3f %8.3f %8.3f %6.2fx %6.2fx\n", name, c.domain, unit, c.bound, crtError, fastError, batchError,
+                crtNs, fastNs, batchNs, crtNs / fastNs, crtNs / batchNs);
+        }
+    }
+
+    {   // the atan2 special cases exactly, fast_normalize's length, and the tails of odd counts
+        ok &= math::fast_atan2(0.0f, 0.0f) == 0.0f && math::fast_atan2(0.0f, -1.0f) == 3.14159265f && math::fast_atan2(-1.0f, 0.0f) == -1.57079632f;
+        std::uniform_real_distribution<float> unit(-100.0f, 100.0f);
+        for (auto i = 0; i < 1000; ++i) {
+            auto const v = math::vec3f_t(unit(rng), unit(rng), unit(rng));
+            ok &= fabs(math::length(math::fast_normalize(v)) - 1.0) <= ldexp(1.0, -20);
+        }
+        float in[11], out[11];
+        for (auto i = 0; i < 11; ++i) { in[i] = 0.3f * i - 1.0f; }
+        math::fast_exp_batch(in, out, 11);
+        for (auto i = 0; i < 11; ++i) { ok &= Error(ErrorUnit::Ulp, out[i], exp(static_cast<double>(in[i]))) <= 2.0; }
+    }
+
+    if (!options.csv) {
+        printf("(max error against double over %u samples, crt = C runtime through the exact tier, backend %s)\n", count, math::GetSimdBackendName());
+        printf("math approx checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
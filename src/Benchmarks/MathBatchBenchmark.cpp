@@ -0,0 +1,285 @@
+#include "Benchmark.h"
+
+#include <Runtime/Math/math_batch.h>
+#include <Runtime/Math/math_functions.h>
+#include <Runtime/Renderables/StaticMeshRenderer.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    // one float array per component, sized for count elements
+    struct Streams
+    {
+        std::vector<float> px, py, pz;          // positions
+        std::vector<float> qw, qx, qy, qz;      // unit quaternions
+        std::vector<float> sx, sy, sz;          // scales
+
+        mini::math::vec3f_soa_const_t Positions() const { return { px.data(), py.data(), pz.data() }; }
+        mini::math::vec3f_soa_const_t Scales() const { return { sx.data(), sy.data(), sz.data() }; }
+        mini::math::quatf_soa_const_t Rotations() const { return { qw.data(), qx.data(), qy.data(), qz.data() }; }
+    };
+
+    Streams MakeStreams(uint32_t count, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::normal_distribution<float> normal;
+        Streams s;
+        for (auto v : { &s.px, &s.py, &s.pz, &s.qw, &s.qx, &s.qy, &s.qz, &s.sx, &s.sy, &s.sz }) { v->resize(count); }
+        for (auto i = 0u; i < count; ++i) {
+            s.px[i] = unit(rng) * 1000.0f;
+            s.py[i] = unit(rng) * 1000.0f;
+            s.pz[i] = unit(rng) * 1000.0f;
+            float q[4] = { normal(rng), normal(rng), normal(rng), normal(rng) };
+            auto const length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+            s.qw[i] = q[0] / length;
+            s.qx[i] = q[1] / length;
+            s.qy[i] = q[2] / length;
+            s.qz[i] = q[3] / length;
+            s.sx[i] = 0.5f + unit(rng) * 0.25f;
+            s.sy[i] = 0.5f + unit(rng) * 0.25f;
+            s.sz[i] = 0.5f + unit(rng) * 0.25f;
+        }
+        return s;
+    }
+
+    // @note    the batch kernels use the single value expressions but the compiler may contract either side into FMAs differently,
+    //          which changes the rounding of one term. allowed is 1 ULP of the sum of the terms' magnitudes, since the sum may cancel
+    bool CloseTransformed(mini::math::mat4x4f_t const& m, float const* v, float w, float const* value, mini::math::vec3f_t const& expected)
+    {
+        bool ok = true;
+        for (auto row = 0; row < 3; ++row) {
+            auto const magnitude = fabsf(m.elements[row] * v[0]) + fabsf(m.elements[4 + row] * v[1]) + fabsf(m.elements[8 + row] * v[2]) + fabsf(m.elements[12 + row] * w);
+            ok &= fabsf(value[row] - expected[row]) <= nextafterf(magnitude, INFINITY) - magnitude;
+        }
+        return ok;
+    }
+
+    bool CloseMatrix(mini::math::mat4x4f_t const& value, mini::math::mat4x4f_t const& expected, float ulps = 1.0f)
+    {
+        // @note relative to the largest element, like the mathsimd ULP columns
+        float largest = 0.0f;
+        for (auto k = 0; k < 16; ++k) { largest = fmaxf(largest, fabsf(expected.elements[k])); }
+        auto const ulp = nextafterf(largest, INFINITY) - largest;
+        bool ok = true;
+        for (auto k = 0; k < 16; ++k) { ok &= fabsf(value.elements[k] - expected.elements[k]) <= ulp * ulps; }
+        return ok;
+    }
+}
+
+int mini::bench::RunMathBatchBenchmark(Options const& options)
+{
+    std::mt19937 rng(0xba7c);
+    bool ok = true;
+
+    // @note 4096 objects stay in L1 / L2, the larger counts are bounded by memory. odd counts exercise the scalar tails
+    auto const baseCount = 4096u * options.scale;
+    math::mat4x4f_t viewProj = math::make_perspective_proj(math::DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f)
+        * math::inverse(math::make_lookat(math::vec3f_t(10.0f, 5.0f, -20.0f), math::vec3f_t(), math::vec3f_t(0.0f, 1.0f, 0.0f)));
+    auto const transform = math::make_translation(math::vec3f_t(1.0f, -2.0f, 3.0f)) * math::quat_to_mat(math::angle_axis(math::vec3f_t(1.0f, 1.0f, 0.0f), 0.7f));
+
+    if (options.csv) {
+        printf("benchmark,function,count,per_element_ns,batch_ns,speedup,batch_gb_per_s\n");
+    }
+    else {
+        printf("%-13s %8s %16s %10s %8s %12s\n", "function", "count", "per element ns", "batch ns", "speedup", "batch GB/s");
+    }
+    for (auto const count : { 4099u, baseCount * 64 + 3 }) {
+        auto const s = MakeStreams(count, rng);
+        auto const numRuns = std::max(1u, 4096u * 256u / count) * options.scale;
+        std::vector<float> ox(count), oy(count), oz(count);
+        std::vector<math::mat4x4f_t> matrices(count), expected(count);
+
+        auto const Report = [&](char const* function, double perElementNs, double batchNs, uint32_t bytesPerElement) {
+            auto const gbPerSecond = bytesPerElement / batchNs;
+            if (options.csv) {
+                printf("mathbatch,%s,%u,%.3f,%.3f,%.2f,%.2f\n", function, count, perElementNs, batchNs, perElementNs / batchNs, gbPerSecond);
+            }
+            else {
+                printf("%-13s %8u %16.3f %10.3f %7.2fx %12.2f\n", function, count, perElementNs, batchNs, perElementNs / batchNs, gbPerSecond);
+            }
+        };
+
+        {   // transform_pos / transform_dir, 12 bytes in and out
+            auto const PerElementPos = [&]() {
+                for (auto i = 0u; i < count; ++i) {
+                    auto const p = math::transform_pos(transform, math::vec3f_t(s.px[i], s.py[i], s.pz[i]));
+                    ox[i] = p.x; oy[i] = p.y; oz[i] = p.z;
+                }
+                DoNotOptimize(ox[0]);
+            };
+            auto const BatchPos = [&]() { math::transform_pos_batch(transform, s.Positions(), { ox.data(), oy.data(), oz.data() }, count); DoNotOptimize(ox[0]); };
+            auto const perElementNs = MeasureNsPerElement(count, numRuns, PerElementPos);
+            auto const batchNs = MeasureNsPerElement(count, numRuns, BatchPos);
+            for (auto i = 0u; i < count; ++i) {
+                float const p[3] = { s.px[i], s.py[i], s.pz[i] }, out[3] = { ox[i], oy[i], oz[i] };
+                ok &= CloseTransformed(transform, p, 1.0f, out, math::transform_pos(transform, math::vec3f_t(p[0], p[1], p[2])));
+            }
+            Report("transform_pos", perElementNs, batchNs, 24);
+
+            math::transform_dir_batch(transform, s.Positions(), { ox.data(), oy.data(), oz.data() }, count);
+            for (auto i = 0u; i < count; ++i) {
+                float const d[3] = { s.px[i], s.py[i], s.pz[i] }, out[3] = { ox[i], oy[i], oz[i] };
+                ok &= CloseTransformed(transform, d, 0.0f, out, math::transform_dir(transform, math::vec3f_t(d[0], d[1], d[2])));
+            }
+            // @note in place
+            auto inPlace = s.px, inPlaceY = s.py, inPlaceZ = s.pz;
+            math::transform_pos_batch(transform, { inPlace.data(), inPlaceY.data(), inPlaceZ.data() }, { inPlace.data(), inPlaceY.data(), inPlaceZ.data() }, count);
+            math::transform_pos_batch(transform, s.Positions(), { ox.data(), oy.data(), oz.data() }, count);
+            ok &= inPlace == ox && inPlaceY == oy && inPlaceZ == oz;
+        }
+        {   // quat_to_mat, 16 bytes in and 64 out
+            auto const PerElement = [&]() {
+                for (auto i = 0u; i < count; ++i) { matrices[i] = math::quat_to_mat(math::quatf_t(s.qw[i], s.qx[i], s.qy[i], s.qz[i])); }
+                DoNotOptimize(matrices[0]);
+            };
+            auto const Batch = [&]() { math::quat_to_mat_batch(s.Rotations(), matrices.data(), count); DoNotOptimize(matrices[0]); };
+            auto const perElementNs = MeasureNsPerElement(count, numRuns, PerElement);
+            auto const batchNs = MeasureNsPerElement(count, numRuns, Batch);
+            for (auto i = 0u; i < count; ++i) { ok &= CloseMatrix(matrices[i], math::quat_to_mat(math::quatf_t(s.qw[i], s.qx[i], s.qy[i], s.qz[i]))); }
+            Report("quat_to_mat", perElementNs, batchNs, 80);
+        }
+        {   // compose_trs, 40 bytes in and 64 out. the per element version is what the scene loop used to do
+            auto const PerElement = [&]() {
+                for (auto i = 0u; i < count; ++i) {
+                    matrices[i] = math::make_translation(math::vec3f_t(s.px[i], s.py[i], s.pz[i])) * math::quat_to_mat(math::quatf_t(s.qw[i], s.qx[i], s.qy[i], s.qz[i]))
+                        * math::make_scale(math::vec3f_t(s.sx[i], s.sy[i], s.sz[i]));
+                }
+                DoNotOptimize(matrices[0]);
+            };
+            auto const Batch = [&]() { math::compose_trs_batch(s.Positions(), s.Rotations(), s.Scales(), matrices.data(), count); DoNotOptimize(matrices[0]); };
+            auto const perElementNs = MeasureNsPerElement(count, numRuns, PerElement);
+            expected = matrices;
+            auto const batchNs = MeasureNsPerElement(count, numRuns, Batch);
+            for (auto i = 0u; i < count; ++i) { ok &= CloseMatrix(matrices[i], expected[i]); }
+            Report("compose_trs", perElementNs, batchNs, 104);
+        }
+        {   // view projection * model, 64 bytes in and out
+            auto const models = matrices;
+            auto const PerElement = [&]() {
+                for (auto i = 0u; i < count; ++i) { expected[i] = viewProj * models[i]; }
+                DoNotOptimize(expected[0]);
+            };
+            auto const Batch = [&]() { math::mat_mul_batch(viewProj, models.data(), matrices.data(), count); DoNotOptimize(matrices[0]); };
+            auto const perElementNs = MeasureNsPerElement(count, numRuns, PerElement);
+            auto const batchNs = MeasureNsPerElement(count, numRuns, Batch);
+            for (auto i = 0u; i < count; ++i) { ok &= CloseMatrix(matrices[i], expected[i]); }
+            Report("mat_mul", perElementNs, batchNs, 128);
+        }
+    }
+
+    {   // affine and rigid fast paths against the 4x4 operations they replace
+        uint32_t const count = 4096;
+        auto const numRuns = 256u * options.scale;
+        auto const s = MakeStreams(count, rng);
+        std::vector<math::mat4x4f_t> full(count), fullResult(count);
+        std::vector<math::mat3x4f_t> affine(count), affineResult(count);
+        math::compose_trs_batch(s.Positions(), s.Rotations(), s.Scales(), full.data(), count);
+        math::compose_trs_batch(s.Positions(), s.Rotations(), s.Scales(), affine.data(), count);
+        for (auto i = 0u; i < count; ++i) { ok &= memcmp(affine[i].elements, math::to_affine(full[i]).elements, sizeof(affine[i].elements)) == 0; }
+
+        // rigid transforms, e.g. cameras
+        std::vector<math::mat4x4f_t> rigid(count);
+        std::vector<math::mat3x4f_t> rigidAffine(count);
+        for (auto i = 0u; i < count; ++i) {
+            rigid[i] = math::make_lookat(math::vec3f_t(s.px[i], s.py[i], s.pz[i]), math::vec3f_t(s.qx[i], s.qy[i], s.qz[i]), math::vec3f_t(0.0f, 1.0f, 0.0f));
+            rigidAffine[i] = math::to_affine(rigid[i]);
+        }
+
+        auto const parent = math::make_affine(math::vec3f_t(1.0f, 2.0f, 3.0f), math::angle_axis(math::vec3f_t(0.0f, 1.0f, 0.0f), 0.3f), math::vec3f_t(2.0f));
+        auto const parentFull = math::to_mat4x4(parent);
+        struct Row { char const* function; double fullNs; double affineNs; };
+        std::vector<Row> rows;
+        rows.push_back({ "compose",
+            MeasureNsPerElement(count, numRuns, [&]() { for (auto i = 0u; i < count; ++i) { fullResult[i] = parentFull * full[i]; } DoNotOptimize(fullResult[0]); }),
+            MeasureNsPerElement(count, numRuns, [&]() { for (auto i = 0u; i < count; ++i) { affineResult[i] = parent * affine[i]; } DoNotOptimize(affineResult[0]); }) });
+        for (auto i = 0u; i < count; ++i) { ok &= CloseMatrix(math::to_mat4x4(affineResult[i]), fullResult[i]); }
+        rows.push_back({ "inverse",
+            MeasureNsPerElement(count, numRuns, [&]() { for (auto i = 0u; i < count; ++i) { fullResult[i] = math::inverse(full[i]); } DoNotOptimize(fullResult[0]); }),
+            MeasureNsPerElement(count, numRuns, [&]() { for (auto i = 0u; i < count; ++i) { affineResult[i] = math::inverse(affine[i]); } DoNotOptimize(affineResult[0]); }) });
+        for (auto i = 0u; i < count; ++i) {
+            // @note against the identity, relative to the inverse's largest element the way mathsimd bounds the 4x4 inverse
+            auto const product = math::to_mat4x4(affineResult[i] * affine[i]);
+            float largest = 0.0f;
+            for (auto k = 0; k < 12; ++k) { largest = fmaxf(largest, fabsf(affineResult[i].elements[k])); }
+            for (auto k = 0; k < 16; ++k) { ok &= fabsf(product.elements[k] - math::mat4x4f_t::identity().elements[k]) <= 1e-5f * fmaxf(1.0f, largest); }
+        }
+        rows.push_back({ "inverse_rigid",
+            MeasureNsPerElement(count, numRuns, [&]() { for (auto i = 0u; i < count; ++i) { fullResult[i] = math::inverse(rigid[i]); } DoNotOptimize(fullResult[0]); }),
+            MeasureNsPerElement(count, numRuns, [&]() { for (auto i = 0u; i < count; ++i) { affineResult[i] = math::inverse_rigid(rigidAffine[i]); } DoNotOptimize(affineResult[0]); }) });
+        for (auto i = 0u; i < count; ++i) {
+            // @note a different algorithm than the general inverse, so within the 32 ULP mathsimd allows the general inverse
+            ok &= CloseMatrix(math::to_mat4x4(affineResult[i]), fullResult[i], 32.0f) || memcmp(fullResult[i].elements, math::mat4x4f_t::identity().elements, sizeof(fullResult[i].elements)) == 0;
+            auto const point = math::vec3f_t(s.sx[i], s.sy[i], s.sz[i]);
+            auto const back = math::transform_pos(affineResult[i], math::transform_pos(rigidAffine[i], point));
+            ok &= math::distance(back, point) < 1e-3f * fmaxf(1.0f, math::length(rigidAffine[i][3]));
+            ok &= math::distance(math::transform_pos(rigidAffine[i], point), math::transform_pos(rigid[i], point)) <= 1e-3f;
+        }
+        rows.push_back({ "compose_trs",
+            MeasureNsPerElement(count, numRuns, [&]() { math::compose_trs_batch(s.Positions(), s.Rotations(), s.Scales(), full.data(), count); DoNotOptimize(full[0]); }),
+            MeasureNsPerElement(count, numRuns, [&]() { math::compose_trs_batch(s.Positions(), s.Rotations(), s.Scales(), affine.data(), count); DoNotOptimize(affine[0]); }) });
+
+        Transform transform;
+        transform.position = math::vec3f_t(1.0f, -2.0f, 3.0f);
+        transform.rotation = math::angle_axis(math::vec3f_t(1.0f, 0.0f, 1.0f), 1.1f);
+        transform.uniformScale = 0.5f;
+        ok &= CloseMatrix(math::to_mat4x4(ToAffine(transform)), math::make_translation(transform.position) * math::quat_to_mat(transform.rotation)
+            * math::make_scale(math::vec3f_t(transform.uniformScale)));
+
+        if (options.csv) {
+            printf("benchmark,function,count,mat4x4_ns,mat3x4_ns,speedup\n");
+            for (auto const& row : rows) { printf("mathbatch_affine,%s,%u,%.3f,%.3f,%.2f\n", row.function, count, row.fullNs, row.affineNs, row.fullNs / row.affineNs); }
+        }
+        else {
+            printf("%-13s %8s %10s %10s %8s\n", "affine", "count", "4x4 ns", "3x4 ns", "speedup");
+            for (auto const& row : rows) { printf("%-13s %8u %10.3f %10.3f %7.2fx\n", row.function, count, row.fullNs, row.affineNs, row.fullNs / row.affineNs); }
+        }
+    }
+
+    {   // creating a bulk buffer: default initialization leaves the matrices alone, the identity fill is what mat4x4f_t() used to do
+        auto const count = 100000u * options.scale;
+        auto const numRuns = 64u;
+        auto const defaultNs = MeasureNsPerElement(count, numRuns, [&]() {
+            auto const matrices = new math::mat4x4f_t[count];
+            DoNotOptimize(matrices);
+            delete[] matrices;
+        });
+        auto const identityNs = MeasureNsPerElement(count, numRuns, [&]() {
+            auto const matrices = new math::mat4x4f_t[count];
+            for (auto i = 0u; i < count; ++i) { matrices[i] = math::mat4x4f_t::identity(); }
+            DoNotOptimize(matrices[count - 1]);
+            delete[] matrices;
+        });
+        if (options.csv) {
+            printf("benchmark,function,count,default_ns,identity_ns\n");
+            printf("mathbatch_construct,new_mat4x4,%u,%.3f,%.3f\n", count, defaultNs, identityNs);
+        }
+        else {
+            printf("%-13s %8s %10s %11s\n", "construct", "count", "default ns", "identity ns");
+            printf("%-13s %8u %10.3f %11.3f\n", "new mat4x4[]", count, defaultNs, identityNs);
+        }
+
+        Transform const transform;
+        ok &= memcmp(math::to_affine(math::make_translation(transform.position)).elements, math::mat3x4f_t::identity().elements, sizeof(math::mat3x4f_t)) == 0;
+        ok &= transform.rotation.w == 1.0f && transform.rotation.x == 0.0f && transform.rotation.y == 0.0f && transform.rotation.z == 0.0f;
+        ok &= memcmp(math::make_scale(math::vec3f_t(1.0f)).elements, math::mat4x4f_t::identity().elements, sizeof(math::mat4x4f_t)) == 0;
+    }
+
+    {   // counts below one vector only take the tail
+        auto const s = MakeStreams(3, rng);
+        math::mat4x4f_t matrices[3];
+        math::quat_to_mat_batch(s.Rotations(), matrices, 3);
+        for (auto i = 0u; i < 3; ++i) { ok &= CloseMatrix(matrices[i], math::quat_to_mat(math::quatf_t(s.qw[i], s.qx[i], s.qy[i], s.qz[i]))); }
+        math::transform_pos_batch(transform, s.Positions(), { nullptr, nullptr, nullptr }, 0);
+    }
+
+    if (!options.csv) {
+        printf("(bytes per element read and written / batch ns, backend %s)\n", math::GetSimdBackendName());
+        printf("math batch checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+#include "Benchmark.h"
+
+#include <Runtime/Math/math_functions.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    namespace kernels = mini::math::kernels;
+
+    struct Inputs
+    {
+        std::vector<float> matrices;    // 16 per entry
+        std::vector<float> others;      // second operand of mat_mul
+        std::vector<float> quats;       // 4 per entry, unit length
+        std::vector<float> points;      // 3 per entry
+        std::vector<float> affines;     // 12 per entry, the 3x4 part of matrices
+        std::vector<float> rigids;      // 12 per entry, rotation and translation only
+    };
+
+    void MakeQuat(std::mt19937& rng, float* out)
+    {
+        std::normal_distribution<float> normal;
+        float q[4] = { normal(rng), normal(rng), normal(rng), normal(rng) };
+        auto const length = sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        for (auto k = 0; k < 4; ++k) { out[k] = q[k] / length; }
+    }
+
+    // rotation, non uniform scale and translation, the transforms the scene loop actually builds
+    void MakeTransform(std::mt19937& rng, float* out)
+    {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        float q[4];
+        MakeQuat(rng, q);
+        kernels::scalar::quat_to_mat(q, out);
+        for (auto column = 0; column < 3; ++column) {
+            auto const scale = powf(10.0f, unit(rng));  // @note 0.1 to 10, so condition numbers stay below 100
+            for (auto row = 0; row < 3; ++row) { out[column * 4 + row] *= scale; }
+        }
+        for (auto row = 0; row < 3; ++row) { out[12 + row] = unit(rng) * 100.0f; }
+    }
+
+    Inputs MakeInputs(uint32_t count, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        Inputs inputs;
+        inputs.matrices.resize(count * 16);
+        inputs.others.resize(count * 16);
+        inputs.quats.resize(count * 4);
+        inputs.points.resize(count * 3);
+        inputs.affines.resize(count * 12);
+        inputs.rigids.resize(count * 12);
+        for (auto i = 0u; i < count; ++i) {
+            MakeTransform(rng, &inputs.matrices[i * 16]);
+            for (auto k = 0; k < 16; ++k) { inputs.others[i * 16 + k] = unit(rng) * 10.0f; }
+            MakeQuat(rng, &inputs.quats[i * 4]);
+            for (auto k = 0; k < 3; ++k) { inputs.points[i * 3 + k] = unit(rng) * 1000.0f; }
+            float rotation[16];
+            kernels::scalar::quat_to_mat(&inputs.quats[i * 4], rotation);
+            for (auto column = 0; column < 4; ++column) {
+                for (auto row = 0; row < 3; ++row) {
+                    inputs.affines[i * 12 + column * 3 + row] = inputs.matrices[i * 16 + column * 4 + row];
+                    inputs.rigids[i * 12 + column * 3 + row] = column < 3 ? rotation[column * 4 + row] : inputs.points[i * 3 + row] * 0.1f;
+                }
+            }
+        }
+        return inputs;
+    }
+
+    // largest difference in ULPs of the largest element of reference
+    double MaxUlpError(float const* values, float const* reference, uint32_t count)
+    {
+        float largest = 0.0f;
+        for (auto i = 0u; i < count; ++i) { largest = fmaxf(largest, fabsf(reference[i])); }
+        auto const ulp = nextafterf(largest, INFINITY) - largest;
+        double error = 0.0;
+        for (auto i = 0u; i < count; ++i) { error = fmax(error, fabs(static_cast<double>(values[i]) - reference[i]) / ulp); }
+        return error;
+    }
+
+    struct Result
+    {
+        char const* function;
+        char const* backend;
+        double      nsPerOp;
+        double      maxUlp;
+    };
+}
+
+int mini::bench::RunMathSimdBenchmark(Options const& options)
+{
+    std::mt19937 rng(0x3a7);
+    bool ok = true;
+
+    uint32_t const count = 4096;
+    uint32_t const numRuns = 500 * options.scale;
+    auto const inputs = MakeInputs(count, rng);
+    std::vector<float> reference(count * 16), output(count * 16);
+    std::vector<Result> results;
+
+    // @note    the scalar kernels are the reference. the SIMD ones do the same operations in the same order and are bit exact
+    //          unless the compiler contracts the scalar code into FMAs (GCC and Clang with -march=native), hence the 1 ULP bound
+    auto Run = [&](char const* function, char const* backend, uint32_t outputFloats, auto&& kernel) {
+        std::fill(output.begin(), output.end(), 0.0f);
+        for (auto i = 0u; i < count; ++i) { kernel(i); }
+        auto const isReference = strcmp(backend, "scalar") == 0;
+        if (isReference) { reference = output; }
+        auto const maxUlp = isReference ? 0.0 : MaxUlpError(output.data(), reference.data(), count * outputFloats);
+        auto const ns = MeasureNsPerElement(count, numRuns, [&]() { for (auto i = 0u; i < count; ++i) { kernel(i); } });
+        DoNotOptimize(output[0]);
+        results.push_back({ function, backend, ns, maxUlp });
+        return maxUlp;
+    };
+
+    {   // mat_mul
+        auto const Scalar = [&](uint32_t i) { kernels::scalar::mat_mul(&inputs.matrices[i * 16], &inputs.others[i * 16], &output[i * 16]); };
+        Run("mat_mul", "scalar", 16, Scalar);
+#if defined(MINI_SIMD_SSE4)
+        ok &= Run("mat_mul", "sse4", 16, [&](uint32_t i) { kernels::sse4::mat_mul(&inputs.matrices[i * 16], &inputs.others[i * 16], &output[i * 16]); }) <= 1.0;
+#endif
+#if defined(MINI_SIMD_AVX2)
+        ok &= Run("mat_mul", "avx2", 16, [&](uint32_t i) { kernels::avx2::mat_mul(&inputs.matrices[i * 16], &inputs.others[i * 16], &output[i * 16]); }) <= 1.0;
+#endif
+#if defined(MINI_SIMD_NEON)
+        ok &= Run("mat_mul", "neon", 16, [&](uint32_t i) { kernels::neon::mat_mul(&inputs.matrices[i * 16], &inputs.others[i * 16], &output[i * 16]); }) <= 1.0;
+#endif
+    }
+    {   // transform_pos
+        Run("transform_pos", "scalar", 3, [&](uint32_t i) { kernels::scalar::transform_pos(&inputs.matrices[i * 16], &inputs.points[i * 3], &output[i * 3]); });
+#if defined(MINI_SIMD_SSE4)
+        ok &= Run("transform_pos", "sse4", 3, [&](uint32_t i) { kernels::sse4::transform_pos(&inputs.matrices[i * 16], &inputs.points[i * 3], &output[i * 3]); }) <= 1.0;
+#endif
+#if defined(MINI_SIMD_NEON)
+        ok &= Run("transform_pos", "neon", 3, [&](uint32_t i) { kernels::neon::transform_pos(&inputs.matrices[i * 16], &inputs.points[i * 3], &output[i * 3]); }) <= 1.0;
+#endif
+    }
+    {   // quat_to_mat
+        Run("quat_to_mat", "scalar", 16, [&](uint32_t i) { kernels::scalar::quat_to_mat(&inputs.quats[i * 4], &output[i * 16]); });
+#if defined(MINI_SIMD_SSE4)
+        ok &= Run("quat_to_mat", "sse4", 16, [&](uint32_t i) { kernels::sse4::quat_to_mat(&inputs.quats[i * 4], &output[i * 16]); }) <= 1.0;
+#endif
+#if defined(MINI_SIMD_NEON)
+        ok &= Run("quat_to_mat", "neon", 16, [&](uint32_t i) { kernels::neon::quat_to_mat(&inputs.quats[i * 4], &output[i * 16]); }) <= 1.0;
+#endif
+    }
+    {   // inverse, checked per matrix since the bound is relative to each inverse's largest element
+        Run("inverse", "scalar", 16, [&](uint32_t i) { kernels::scalar::inverse(&inputs.matrices[i * 16], &output[i * 16]); });
+#if defined(MINI_SIMD_SSE4) || defined(MINI_SIMD_NEON)
+        auto const CheckInverse = [&]() {
+            double maxUlp = 0.0;
+            for (auto i = 0u; i < count; ++i) { maxUlp = fmax(maxUlp, MaxUlpError(&output[i * 16], &reference[i * 16], 16)); }
+            return maxUlp;
+        };
+#endif
+#if defined(MINI_SIMD_SSE4)
+        Run("inverse", "sse4", 16, [&](uint32_t i) { kernels::sse4::inverse(&inputs.matrices[i * 16], &output[i * 16]); });
+        results.back().maxUlp = CheckInverse();
+        ok &= results.back().maxUlp <= 32.0;
+#endif
+#if defined(MINI_SIMD_NEON)
+        Run("inverse", "neon", 16, [&](uint32_t i) { kernels::neon::inverse(&inputs.matrices[i * 16], &output[i * 16]); });
+        results.back().maxUlp = CheckInverse();
+        ok &= results.back().maxUlp <= 32.0;
+#endif
+    }
+
+    {   // affine kernels, the product's right hand side is the next entry
+        auto const next = [&](uint32_t i) { return &inputs.affines[((i + 1) % count) * 12]; };
+        Run("affine_mul", "scalar", 12, [&](uint32_t i) { kernels::scalar::affine_mul(&inputs.affines[i * 12], next(i), &output[i * 12]); });
+#if defined(MINI_SIMD_SSE4)
+        ok &= Run("affine_mul", "sse4", 12, [&](uint32_t i) { kernels::sse4::affine_mul(&inputs.affines[i * 12], next(i), &output[i * 12]); }) <= 1.0;
+#endif
+#if defined(MINI_SIMD_NEON)
+        ok &= Run("affine_mul", "neon", 12, [&](uint32_t i) { kernels::neon::affine_mul(&inputs.affines[i * 12], next(i), &output[i * 12]); }) <= 1.0;
+#endif
+        Run("affine_rigid", "scalar", 12, [&](uint32_t i) { kernels::scalar::affine_inverse_rigid(&inputs.rigids[i * 12], &output[i * 12]); });
+#if defined(MINI_SIMD_SSE4)
+        ok &= Run("affine_rigid", "sse4", 12, [&](uint32_t i) { kernels::sse4::affine_inverse_rigid(&inputs.rigids[i * 12], &output[i * 12]); }) <= 1.0;
+#endif
+#if defined(MINI_SIMD_NEON)
+        ok &= Run("affine_rigid", "neon", 12, [&](uint32_t i) { kernels::neon::affine_inverse_rigid(&inputs.rigids[i * 12], &output[i * 12]); }) <= 1.0;
+#endif
+        // @note the contracted scalar cross products round differently and the difference goes through 1 / det, hence 4 ULPs
+        Run("affine_inv", "scalar", 12, [&](uint32_t i) { kernels::scalar::affine_inverse(&inputs.affines[i * 12], &output[i * 12]); });
+#if defined(MINI_SIMD_SSE4)
+        ok &= Run("affine_inv", "sse4", 12, [&](uint32_t i) { kernels::sse4::affine_inverse(&inputs.affines[i * 12], &output[i * 12]); }) <= 4.0;
+#endif
+#if defined(MINI_SIMD_NEON)
+        ok &= Run("affine_inv", "neon", 12, [&](uint32_t i) { kernels::neon::affine_inverse(&inputs.affines[i * 12], &output[i * 12]); }) <= 4.0;
+#endif
+    }
+
+    {   // singular matrices give the identity everywhere, and the math_functions.h entry points match the selected kernels
+        float const singular[16] = { 1.0f, 2.0f, 3.0f, 4.0f, 2.0f, 4.0f, 6.0f, 8.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+        float const identity[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+        float inverse[16];
+        ok &= !kernels::scalar::inverse(singular, inverse) && memcmp(inverse, identity, sizeof(identity)) == 0;
+        ok &= !kernels::selected::inverse(singular, inverse) && memcmp(inverse, identity, sizeof(identity)) == 0;
+
+        math::mat4x4f_t a, b;
+        memcpy(a.elements, &inputs.matrices[0], sizeof(a.elements));
+        memcpy(b.elements, &inputs.others[0], sizeof(b.elements));
+        float expected[16];
+        kernels::scalar::mat_mul(a.elements, b.elements, expected);
+        ok &= MaxUlpError((a * b).elements, expected, 16) <= 1.0;
+        math::quatf_t const q(inputs.quats[0], inputs.quats[1], inputs.quats[2], inputs.quats[3]);
+        kernels::scalar::quat_to_mat(q.elements, expected);
+        ok &= MaxUlpError(math::quat_to_mat(q).elements, expected, 16) <= 1.0;
+        auto const product = math::inverse(a) * a;     // @note should be close to the identity
+        ok &= MaxUlpError(product.elements, identity, 16) < 64.0;
+    }
+
+    if (options.csv) {
+        printf("benchmark,function,backend,ns_per_op,max_ulp\n");
+        for (auto const& result : results) { printf("mathsimd,%s,%s,%.3f,%.1f\n", result.function, result.backend, result.nsPerOp, result.maxUlp); }
+    }
+    else {
+        printf("%-14s %8s %10s %8s\n", "function", "backend", "ns/op", "max ulp");
+        for (auto const& result : results) { printf("%-14s %8s %10.3f %8.1f\n", result.function, result.backend, result.nsPerOp, result.maxUlp); }
+        printf("selected backend: %s\n", math::GetSimdBackendName());
+        printf("math simd checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,158 @@
+#include "Benchmark.h"
+
+#include <Runtime/AssetLibraries/GTMesh.h>
+#include <Runtime/Culling/MeshBounds.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    // random positions inside an offset box, written at the start of every vertex. firstByte shifts the data off alignment
+    // the way .gtmesh vertices are
+    std::vector<char> MakeVertices(uint32_t numVertices, uint32_t stride, uint32_t firstByte, std::mt19937& rng)
+    {
+        std::vector<char> data(firstByte + static_cast<size_t>(numVertices) * stride);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        for (auto i = 0u; i < numVertices; ++i) {
+            float const p[3] = { 10.0f + unit(rng) * 3.0f, -2.0f + unit(rng), 5.0f + unit(rng) * 0.5f };
+            memcpy(data.data() + firstByte + static_cast<size_t>(i) * stride, p, sizeof(p));
+            for (auto b = sizeof(p); b < stride; ++b) { data[firstByte + i * stride + b] = static_cast<char>(rng()); }    // @note garbage after the position
+        }
+        return data;
+    }
+
+    bool CheckBounds(mini::MeshBounds const& bounds, mini::MeshBounds const& reference, char const* vertices, uint32_t numVertices, uint32_t stride)
+    {
+        bool ok = memcmp(bounds.aabbMin, reference.aabbMin, sizeof(bounds.aabbMin)) == 0 && memcmp(bounds.aabbMax, reference.aabbMax, sizeof(bounds.aabbMax)) == 0
+            && memcmp(bounds.sphereCenter, reference.sphereCenter, sizeof(bounds.sphereCenter)) == 0;
+        // @note summation order matches, but the compiler may still contract the scalar path into fused multiply adds
+        ok &= fabsf(bounds.sphereRadius - reference.sphereRadius) <= reference.sphereRadius * 1e-6f;
+        for (auto i = 0u; i < numVertices; ++i) {
+            float p[3];
+            memcpy(p, vertices + static_cast<size_t>(i) * stride, sizeof(p));
+            double distanceSquared = 0.0;
+            for (auto k = 0; k < 3; ++k) {
+                ok &= p[k] >= bounds.aabbMin[k] && p[k] <= bounds.aabbMax[k];
+                distanceSquared += (static_cast<double>(p[k]) - bounds.sphereCenter[k]) * (static_cast<double>(p[k]) - bounds.sphereCenter[k]);
+            }
+            ok &= sqrt(distanceSquared) <= bounds.sphereRadius * (1.0 + 1e-6);
+        }
+        return ok;
+    }
+
+    // a mesh may only be rejected if none of its vertices is inside the frustum
+    bool CheckVisibility(std::mt19937& rng, uint32_t* outNumCulled, uint32_t* outNumViews)
+    {
+        std::vector<float> vertices;
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        for (auto i = 0u; i < 2000; ++i) {
+            vertices.insert(vertices.end(), { unit(rng) * 2.0f, unit(rng) * 0.5f, unit(rng) });
+        }
+        auto const bounds = mini::ComputeMeshBounds(vertices.data(), 2000, sizeof(float) * 3);
+
+        bool ok = true;
+        uint32_t numCulled = 0;
+        uint32_t const numViews = 20000;
+        for (auto v = 0u; v < numViews; ++v) {
+            float const position[3] = { unit(rng) * 8.0f, unit(rng) * 8.0f, unit(rng) * 8.0f };
+            float const forward[3] = { unit(rng), unit(rng), unit(rng) };
+            float const up[3] = { 0.0f, 1.0f, 0.0f };
+            auto const view = mini::MakeCullingView(position, forward, up, 1.0f, 16.0f / 9.0f, 0.1f, 20.0f);
+            if (mini::IsMeshVisible(bounds, view)) { continue; }
+            numCulled++;
+            for (auto i = 0u; i < 2000; ++i) {
+                bool inside = true;
+                for (auto p = 0; p < 6; ++p) {
+                    auto const plane = view.frustumPlanes[p];
+                    inside &= plane[0] * vertices[i * 3] + plane[1] * vertices[i * 3 + 1] + plane[2] * vertices[i * 3 + 2] + plane[3] >= 0.0f;
+                }
+                ok &= !inside;
+            }
+        }
+        *outNumCulled = numCulled;
+        *outNumViews = numViews;
+        return ok && numCulled > 0;
+    }
+}
+
+int mini::bench::RunMeshBoundsBenchmark(Options const& options)
+{
+    std::mt19937 rng(0xb0b);
+    bool ok = true;
+
+    struct Layout
+    {
+        char const* name;
+        uint32_t    stride;
+        uint32_t    firstByte;
+    };
+    Layout const layouts[] = {
+        { "position", 12, 0 },
+        { "position_normal", 24, 0 },
+        { "gtmesh_48", 48, GTMESH_HEADER_SIZE },
+    };
+
+    if (options.csv) {
+        printf("benchmark,layout,vertices,simd_kernel,scalar_ns_per_vertex,simd_ns_per_vertex,speedup\n");
+    }
+    else {
+        printf("%-16s %10s %8s %12s %12s %8s\n", "layout", "vertices", "kernel", "scalar ns/v", "simd ns/v", "speedup");
+    }
+    auto const numVertices = 1000000u * options.scale;
+    for (auto const& layout : layouts) {
+        auto const data = MakeVertices(numVertices, layout.stride, layout.firstByte, rng);
+        auto const vertices = data.data() + layout.firstByte;
+
+        // @note odd counts and a single vertex exercise the scalar tails
+        for (auto const count : { 1u, 2u, 3u, 17u, numVertices }) {
+            ok &= CheckBounds(ComputeMeshBounds(vertices, count, layout.stride), ComputeMeshBoundsScalar(vertices, count, layout.stride), vertices, count, layout.stride);
+        }
+
+        uint32_t const numRuns = 20;
+        Timer timer;
+        for (auto run = 0u; run < numRuns; ++run) {
+            auto const bounds = ComputeMeshBoundsScalar(vertices, numVertices, layout.stride);
+            DoNotOptimize(bounds);
+        }
+        auto const scalarNs = timer.GetElapsedTime() * 1e9 / (static_cast<double>(numRuns) * numVertices);
+        timer.Reset();
+        for (auto run = 0u; run < numRuns; ++run) {
+            auto const bounds = ComputeMeshBounds(vertices, numVertices, layout.stride);
+            DoNotOptimize(bounds);
+        }
+        auto const simdNs = timer.GetElapsedTime() * 1e9 / (static_cast<double>(numRuns) * numVertices);
+
+        if (options.csv) {
+            printf("meshbounds,%s,%u,%s,%.3f,%.3f,%.2f\n", layout.name, numVertices, GetMeshBoundsKernelName(), scalarNs, simdNs, scalarNs / simdNs);
+        }
+        else {
+            printf("%-16s %10u %8s %12.3f %12.3f %7.2fx\n", layout.name, numVertices, GetMeshBoundsKernelName(), scalarNs, simdNs, scalarNs / simdNs);
+        }
+    }
+
+    {   // bounds derived from a box only have to enclose its corners
+        float const aabbMin[3] = { -1.0f, 2.0f, -3.0f };
+        float const aabbMax[3] = { 4.0f, 2.5f, 1.0f };
+        auto const bounds = MakeMeshBounds(aabbMin, aabbMax);
+        for (auto corner = 0; corner < 8; ++corner) {
+            float const p[3] = { (corner & 1) ? aabbMax[0] : aabbMin[0], (corner & 2) ? aabbMax[1] : aabbMin[1], (corner & 4) ? aabbMax[2] : aabbMin[2] };
+            float const d[3] = { p[0] - bounds.sphereCenter[0], p[1] - bounds.sphereCenter[1], p[2] - bounds.sphereCenter[2] };
+            ok &= sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]) <= bounds.sphereRadius * (1.0f + 1e-6f);
+        }
+        float const zero[3] = { 0.0f, 0.0f, 0.0f };
+        float const nan[3] = { NAN, 0.0f, 0.0f };
+        ok &= IsValidAabb(aabbMin, aabbMax) && !IsValidAabb(aabbMax, aabbMin) && !IsValidAabb(zero, zero) && !IsValidAabb(nan, aabbMax);
+    }
+
+    uint32_t numCulled = 0, numViews = 0;
+    ok &= CheckVisibility(rng, &numCulled, &numViews);
+    if (!options.csv) {
+        printf("visibility: %u of %u random views rejected the mesh by its bounds\n", numCulled, numViews);
+        printf("mesh bounds checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
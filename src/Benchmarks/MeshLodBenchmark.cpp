@@ -0,0 +1,199 @@
+#include "Benchmark.h"
+#include "TestMeshes.h"
+
+#include <Runtime/Culling/LodSelection.h>
+#include <Runtime/Culling/MeshBounds.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <vector>
+#include <string.h>
+#include <algorithm>
+
+namespace
+{
+    using mini::bench::CookedMesh;
+    using mini::bench::FLOATS_PER_VERTEX;
+    using mini::bench::VERTEX_STRIDE;
+
+    float PointTriangleDistance(float const* p, float const* a, float const* b, float const* c)
+    {
+        // @note closest point on triangle, Ericson - Real-Time Collision Detection 5.1.5
+        auto const sub = [](float const* x, float const* y, float* out) { for (auto k = 0; k < 3; ++k) { out[k] = x[k] - y[k]; } };
+        auto const dot = [](float const* x, float const* y) { return x[0] * y[0] + x[1] * y[1] + x[2] * y[2]; };
+        float ab[3], ac[3], ap[3], bp[3], cp[3], closest[3];
+        sub(b, a, ab); sub(c, a, ac); sub(p, a, ap);
+        auto const d1 = dot(ab, ap), d2 = dot(ac, ap);
+        auto const set = [&](float const* base, float const* dir, float t) { for (auto k = 0; k < 3; ++k) { closest[k] = base[k] + (dir ? dir[k] * t : 0.0f); } };
+        sub(p, b, bp);
+        auto const d3 = dot(ab, bp), d4 = dot(ac, bp);
+        sub(p, c, cp);
+        auto const d5 = dot(ab, cp), d6 = dot(ac, cp);
+        auto const vc = d1 * d4 - d3 * d2, vb = d5 * d2 - d1 * d6, va = d3 * d6 - d5 * d4;
+        if (d1 <= 0.0f && d2 <= 0.0f) { set(a, nullptr, 0.0f); }
+        else if (d3 >= 0.0f && d4 <= d3) { set(b, nullptr, 0.0f); }
+        else if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) { set(a, ab, d1 / (d1 - d3)); }
+        else if (d6 >= 0.0f && d5 <= d6) { set(c, nullptr, 0.0f); }
+        else if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) { set(a, ac, d2 / (d2 - d6)); }
+        else if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+            float bc[3];
+            sub(c, b, bc);
+            set(b, bc, (d4 - d3) / ((d4 - d3) + (d5 - d6)));
+        }
+        else {
+            auto const denom = 1.0f / (va + vb + vc);
+            for (auto k = 0; k < 3; ++k) { closest[k] = a[k] + ab[k] * vb * denom + ac[k] * vc * denom; }
+        }
+        float d[3];
+        sub(p, closest, d);
+        return sqrtf(dot(d, d));
+    }
+
+    // one sided Hausdorff distance from the LOD 0 vertices to a LOD's surface
+    float MeasureDeviation(CookedMesh const& mesh, mini::MeshLod const& lod)
+    {
+        auto const vertices = reinterpret_cast<float const*>(mesh.vertexData.data());
+        auto const& base = mesh.lods[0];
+        std::vector<bool> visited(mesh.vertexData.size() / VERTEX_STRIDE, false);
+        auto deviation = 0.0f;
+        for (auto i = base.firstIndex; i < base.firstIndex + base.numIndices; ++i) {
+            auto const v = mesh.indices[i];
+            if (visited[v]) { continue; }
+            visited[v] = true;
+            auto const p = vertices + v * FLOATS_PER_VERTEX;
+            auto closest = 1e30f;
+            for (auto t = lod.firstIndex; t < lod.firstIndex + lod.numIndices; t += 3) {
+                auto const d = PointTriangleDistance(p, vertices + mesh.indices[t] * FLOATS_PER_VERTEX, vertices + mesh.indices[t + 1] * FLOATS_PER_VERTEX,
+                    vertices + mesh.indices[t + 2] * FLOATS_PER_VERTEX);
+                closest = d < closest ? d : closest;
+            }
+            deviation = closest > deviation ? closest : deviation;
+        }
+        return deviation;
+    }
+
+    // LODs must stay valid, closed meshes with fewer triangles and growing error down the chain
+    bool CheckLods(CookedMesh const& mesh)
+    {
+        auto const numVertices = static_cast<uint32_t>(mesh.vertexData.size() / VERTEX_STRIDE);
+        bool ok = mesh.lods.size() >= 4;
+        for (auto l = 0u; l < mesh.lods.size(); ++l) {
+            auto const& lod = mesh.lods[l];
+            if (l > 0) {
+                ok &= lod.numIndices < mesh.lods[l - 1].numIndices && lod.error >= mesh.lods[l - 1].error;
+            }
+            std::vector<uint64_t> edges;
+            for (auto i = lod.firstIndex; i < lod.firstIndex + lod.numIndices; i += 3) {
+                uint32_t const* t = mesh.indices.data() + i;
+                ok &= t[0] < numVertices && t[1] < numVertices && t[2] < numVertices;
+                ok &= t[0] != t[1] && t[1] != t[2] && t[0] != t[2];
+                for (auto k = 0; k < 3; ++k) { edges.push_back((static_cast<uint64_t>(t[k]) << 32) | t[(k + 1) % 3]); }
+            }
+            std::sort(edges.begin(), edges.end());
+            for (auto const edge : edges) {
+                auto const reverse = (edge << 32) | (edge >> 32);
+                ok &= std::binary_search(edges.begin(), edges.end(), reverse);
+            }
+            // @note meshlets of the LOD cover exactly its index range
+            uint32_t covered = 0;
+            for (auto m = lod.firstMeshlet; m < lod.firstMeshlet + lod.numMeshlets; ++m) {
+                ok &= mesh.meshlets[m].firstIndex == lod.firstIndex + covered;
+                covered += mesh.meshlets[m].numIndices;
+            }
+            ok &= covered == lod.numIndices;
+        }
+        return ok;
+    }
+}
+
+int mini::bench::RunMeshLodBenchmark(Options const& options)
+{
+    bool ok = true;
+    // @note bumpy spheres, so the simplifier has curvature to keep
+    float const origin[3] = { 0.0f, 0.0f, 0.0f };
+    LodChainSettings const lodSettings;
+
+    // accuracy on a small mesh where the brute force deviation is affordable
+    {
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+        AppendSphere(48, 96, origin, 0.08f, vertices, indices);
+        CookedMesh mesh;
+        Cook(vertices, indices, &lodSettings, &mesh);
+        ok &= CheckLods(mesh);
+        if (!options.csv) {
+            printf("%-5s %10s %10s %12s %12s\n", "lod", "triangles", "meshlets", "error", "measured");
+        }
+        for (auto l = 0u; l < mesh.lods.size(); ++l) {
+            auto const& lod = mesh.lods[l];
+            auto const measured = MeasureDeviation(mesh, lod);
+            // @note the quadric error is an estimate, not a bound. it has to stay in the same ballpark to be usable for selection
+            ok &= measured <= lod.error * 4.0f + 1e-3f;
+            if (options.csv) {
+                printf("lods,accuracy,%u,%u,%u,%.6f,%.6f\n", l, lod.numIndices / 3, lod.numMeshlets, lod.error, measured);
+            }
+            else {
+                printf("%-5u %10u %10u %12.6f %12.6f\n", l, lod.numIndices / 3, lod.numMeshlets, lod.error, measured);
+            }
+        }
+    }
+
+    // large scene: a field of detailed asteroids seen from one edge, full detail vs selected LODs
+    std::vector<float> vertices;
+    std::vector<uint32_t> indices;
+    AppendSphere(128, 256, origin, 0.08f, vertices, indices);
+    CookedMesh mesh;
+    mini::Timer timer;
+    Cook(vertices, indices, &lodSettings, &mesh);
+    auto const cookMs = timer.GetElapsedTime() * 1000.0;
+    ok &= CheckLods(mesh);
+
+    auto const gridSize = 100u * options.scale;
+    std::vector<float> positions;
+    for (auto z = 0u; z < gridSize; ++z) {
+        for (auto x = 0u; x < gridSize; ++x) {
+            positions.insert(positions.end(), { x * 20.0f - gridSize * 10.0f, 0.0f, z * 20.0f + 5.0f });
+        }
+    }
+    auto const numInstances = static_cast<uint32_t>(positions.size() / 3);
+
+    mini::LodSelectionView view;
+    view.position[1] = 2.0f;
+    view.projectionScale = mini::ComputeLodProjectionScale(60.0f * 3.14159265f / 180.0f, 1080.0f);
+    view.errorThreshold = 1.0f;
+
+    uint64_t fullTriangles = 0;
+    uint64_t selectedTriangles = 0;
+    uint32_t lodHistogram[mini::MAX_MESH_LODS] = {};
+    uint32_t const numRuns = 20;
+    timer.Reset();
+    for (auto run = 0u; run < numRuns; ++run) {
+        for (auto i = 0u; i < numInstances; ++i) {
+            auto const lod = mini::SelectMeshLod(mesh.resource, positions.data() + i * 3, 1.0f, view);
+            if (run == 0) {
+                fullTriangles += mesh.lods[0].numIndices / 3;
+                selectedTriangles += mesh.lods[lod].numIndices / 3;
+                lodHistogram[lod]++;
+            }
+            DoNotOptimize(lod);
+        }
+    }
+    auto const nsPerInstance = timer.GetElapsedTime() * 1e9 / (static_cast<double>(numRuns) * numInstances);
+    auto const reduction = static_cast<double>(fullTriangles) / selectedTriangles;
+    ok &= reduction >= 10.0;
+
+    if (options.csv) {
+        printf("lods,scene,%u,%zu,%llu,%llu,%.2f,%.2f,%.2f\n", numInstances, mesh.lods.size(), static_cast<unsigned long long>(fullTriangles),
+            static_cast<unsigned long long>(selectedTriangles), reduction, nsPerInstance, cookMs);
+    }
+    else {
+        printf("lod checks: %s\n", ok ? "ok" : "FAILED");
+        printf("asteroid: %u triangles, %zu lods, cooked in %.1fms\n", mesh.lods[0].numIndices / 3, mesh.lods.size(), cookMs);
+        printf("scene: %u instances, %llu triangles at full detail, %llu with lod selection at 1px error (%.1fx fewer)\n", numInstances,
+            static_cast<unsigned long long>(fullTriangles), static_cast<unsigned long long>(selectedTriangles), reduction);
+        printf("instances per lod:");
+        for (auto l = 0u; l < mesh.lods.size(); ++l) { printf(" %u", lodHistogram[l]); }
+        printf("\nselect: %.2f ns per instance\n", nsPerInstance);
+    }
+    return ok ? 0 : 1;
+}
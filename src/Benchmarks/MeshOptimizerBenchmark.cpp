@@ -0,0 +1,182 @@
+#include "Benchmark.h"
+#include "TestMeshes.h"
+
+#include <Runtime/MeshProcessing/MeshOptimizer.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    using mini::bench::FLOATS_PER_VERTEX;
+    using mini::bench::VERTEX_STRIDE;
+
+    struct TestMesh
+    {
+        std::vector<float>      vertices;
+        std::vector<uint32_t>   indices;
+        uint32_t                numUniqueVertices = 0;
+
+        uint32_t NumVertices() const { return static_cast<uint32_t>(vertices.size() / FLOATS_PER_VERTEX); }
+    };
+
+    // indexed UV spheres along the x axis, overlapping so there is something to overdraw
+    TestMesh MakeSpheres(uint32_t numSpheres, uint32_t stacks, uint32_t slices)
+    {
+        TestMesh mesh;
+        for (auto s = 0u; s < numSpheres; ++s) {
+            float const center[3] = { s * 0.75f, 0.0f, 0.0f };
+            mini::bench::AppendSphere(stacks, slices, center, 0.0f, mesh.vertices, mesh.indices);
+        }
+        mesh.numUniqueVertices = mesh.NumVertices();
+        return mesh;
+    }
+
+    // worst case input as a careless exporter produces it: one vertex per corner and triangles in random order
+    TestMesh UnweldAndShuffle(TestMesh const& source, std::mt19937& rng)
+    {
+        auto const numTriangles = static_cast<uint32_t>(source.indices.size() / 3);
+        std::vector<uint32_t> order(numTriangles);
+        for (auto t = 0u; t < numTriangles; ++t) { order[t] = t; }
+        std::shuffle(order.begin(), order.end(), rng);
+
+        TestMesh mesh;
+        mesh.numUniqueVertices = source.numUniqueVertices;
+        for (auto const t : order) {
+            for (auto k = 0u; k < 3; ++k) {
+                auto const v = source.vertices.data() + source.indices[t * 3 + k] * FLOATS_PER_VERTEX;
+                mesh.indices.push_back(mesh.NumVertices());
+                mesh.vertices.insert(mesh.vertices.end(), v, v + FLOATS_PER_VERTEX);
+            }
+        }
+        return mesh;
+    }
+
+    // triangles as rotation invariant keys, reordering passes must keep the same set with the same winding
+    std::vector<uint64_t> TriangleKeys(uint32_t const* indices, uint32_t numIndices)
+    {
+        std::vector<uint64_t> keys;
+        for (auto i = 0u; i < numIndices; i += 3) {
+            uint32_t const* t = indices + i;
+            auto const first = t[0] < t[1] ? (t[0] < t[2] ? 0 : 2) : (t[1] < t[2] ? 1 : 2);
+            keys.push_back((static_cast<uint64_t>(t[first]) << 42) | (static_cast<uint64_t>(t[(first + 1) % 3]) << 21) | t[(first + 2) % 3]);
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    struct StageReport
+    {
+        char const*                     name;
+        uint32_t                        numVertices;
+        mini::VertexCacheStatistics     cache16;
+        mini::VertexCacheStatistics     cache32;
+        mini::OverdrawStatistics        overdraw;
+        mini::VertexFetchStatistics     fetch;
+        double                          ms;
+    };
+
+    StageReport Analyze(char const* name, std::vector<uint32_t> const& indices, void const* vertices, uint32_t numVertices, double ms)
+    {
+        auto const numIndices = static_cast<uint32_t>(indices.size());
+        return {
+            name, numVertices,
+            mini::AnalyzeVertexCache(indices.data(), numIndices, numVertices, 16),
+            mini::AnalyzeVertexCache(indices.data(), numIndices, numVertices, 32),
+            mini::AnalyzeOverdraw(indices.data(), numIndices, vertices, numVertices, VERTEX_STRIDE),
+            mini::AnalyzeVertexFetch(indices.data(), numIndices, numVertices, VERTEX_STRIDE),
+            ms
+        };
+    }
+}
+
+int mini::bench::RunMeshOptimizerBenchmark(Options const& options)
+{
+    std::mt19937 rng(0x0b71);
+    bool ok = true;
+
+    auto const source = MakeSpheres(6, 64 * options.scale, 128 * options.scale);
+    auto const input = UnweldAndShuffle(source, rng);
+    auto const numIndices = static_cast<uint32_t>(input.indices.size());
+    std::vector<StageReport> reports;
+    reports.push_back(Analyze("input", input.indices, input.vertices.data(), input.NumVertices(), 0.0));
+
+    // weld: every corner must find its twin, the result has exactly the vertices of the indexed source
+    std::vector<uint32_t> remap(input.NumVertices());
+    mini::Timer timer;
+    auto const numWelded = mini::WeldVertices(input.vertices.data(), input.NumVertices(), VERTEX_STRIDE, 1e-6f, 1e-5f, remap.data());
+    std::vector<float> welded(numWelded * FLOATS_PER_VERTEX);
+    mini::RemapVertices(welded.data(), input.vertices.data(), input.NumVertices(), VERTEX_STRIDE, remap.data());
+    std::vector<uint32_t> indices(numIndices);
+    mini::RemapIndices(indices.data(), input.indices.data(), numIndices, remap.data());
+    reports.push_back(Analyze("weld", indices, welded.data(), numWelded, timer.GetElapsedTime() * 1000.0));
+    ok &= numWelded == source.numUniqueVertices;
+    for (auto i = 0u; i < numIndices; ++i) {
+        ok &= memcmp(welded.data() + indices[i] * FLOATS_PER_VERTEX, input.vertices.data() + input.indices[i] * FLOATS_PER_VERTEX, VERTEX_STRIDE) == 0;
+    }
+    auto const weldedKeys = TriangleKeys(indices.data(), numIndices);
+
+    timer = mini::Timer();
+    std::vector<uint32_t> cacheOptimized(numIndices);
+    mini::OptimizeVertexCache(cacheOptimized.data(), indices.data(), numIndices, numWelded);
+    reports.push_back(Analyze("vertex cache", cacheOptimized, welded.data(), numWelded, timer.GetElapsedTime() * 1000.0));
+    ok &= TriangleKeys(cacheOptimized.data(), numIndices) == weldedKeys;
+    ok &= reports.back().cache16.acmr < 0.75f && reports.back().cache32.acmr < reports.back().cache16.acmr;
+
+    timer = mini::Timer();
+    std::vector<uint32_t> overdrawOptimized(numIndices);
+    float const threshold = 1.05f;
+    mini::OptimizeOverdraw(overdrawOptimized.data(), cacheOptimized.data(), numIndices, welded.data(), numWelded, VERTEX_STRIDE, threshold);
+    reports.push_back(Analyze("overdraw", overdrawOptimized, welded.data(), numWelded, timer.GetElapsedTime() * 1000.0));
+    ok &= TriangleKeys(overdrawOptimized.data(), numIndices) == weldedKeys;
+    ok &= reports.back().cache16.acmr <= reports[2].cache16.acmr * threshold;
+    ok &= reports.back().overdraw.overdraw <= reports[2].overdraw.overdraw;
+
+    // fetch: same triangles in the same order, vertices in first use order
+    timer = mini::Timer();
+    std::vector<float> fetchOptimized(welded.size());
+    std::vector<uint32_t> finalIndices = overdrawOptimized;
+    auto const numFinal = mini::OptimizeVertexFetch(fetchOptimized.data(), finalIndices.data(), numIndices, welded.data(), numWelded, VERTEX_STRIDE);
+    reports.push_back(Analyze("vertex fetch", finalIndices, fetchOptimized.data(), numFinal, timer.GetElapsedTime() * 1000.0));
+    ok &= numFinal == numWelded;
+    for (auto i = 0u; i < numIndices; ++i) {
+        ok &= memcmp(fetchOptimized.data() + finalIndices[i] * FLOATS_PER_VERTEX, welded.data() + overdrawOptimized[i] * FLOATS_PER_VERTEX, VERTEX_STRIDE) == 0;
+    }
+    ok &= reports.back().fetch.overfetch < reports[3].fetch.overfetch;
+
+    // the packaged pipeline produces the same as the passes above and narrows the indices
+    {
+        mini::MeshData data;
+        data.vertexData = reinterpret_cast<char*>(const_cast<float*>(input.vertices.data()));
+        data.vertexDataSize = static_cast<uint32_t>(input.vertices.size() * sizeof(float));
+        data.vertexStride = VERTEX_STRIDE;
+        data.indexData = reinterpret_cast<char*>(const_cast<uint32_t*>(input.indices.data()));
+        data.indexDataSize = numIndices * sizeof(uint32_t);
+        data.indexFormat = mini::IndexFormat::R32_UINT;
+        eastl::vector<char> vertexData, indexData;
+        mini::MeshData optimized;
+        ok &= mini::OptimizeMeshData(data, &vertexData, &indexData, &optimized);
+        ok &= optimized.vertexDataSize == numFinal * VERTEX_STRIDE && memcmp(vertexData.data(), fetchOptimized.data(), optimized.vertexDataSize) == 0;
+        ok &= optimized.indexFormat == mini::IndexFormat::R16_UINT && optimized.indexDataSize == numIndices * sizeof(uint16_t);
+    }
+
+    if (options.csv) {
+        for (auto const& r : reports) {
+            printf("meshopt,%s,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.3f\n", r.name, r.numVertices, r.cache16.acmr, r.cache16.atvr, r.cache32.acmr,
+                r.overdraw.overdraw, r.fetch.overfetch, r.ms);
+        }
+    }
+    else {
+        printf("mesh optimizer checks: %s\n", ok ? "ok" : "FAILED");
+        printf("%u triangles\n", numIndices / 3);
+        printf("%-14s %9s %10s %10s %10s %10s %10s %10s\n", "stage", "vertices", "acmr@16", "atvr@16", "acmr@32", "overdraw", "overfetch", "ms");
+        for (auto const& r : reports) {
+            printf("%-14s %9u %10.3f %10.3f %10.3f %10.3f %10.3f %10.2f\n", r.name, r.numVertices, r.cache16.acmr, r.cache16.atvr, r.cache32.acmr,
+                r.overdraw.overdraw, r.fetch.overfetch, r.ms);
+        }
+    }
+    return ok ? 0 : 1;
+}
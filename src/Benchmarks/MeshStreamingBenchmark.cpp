@@ -0,0 +1,218 @@
+#include "Benchmark.h"
+
+#include <Runtime/Containers/SlotMap.h>
+#include <Runtime/AssetLibraries/MeshAllocator.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+#include <Runtime/AssetLibraries/RenderResourceHandles.h>
+#include <Runtime/util.h>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace
+{
+    // @note MeshLibrary minus the D3D12 objects: the same slot map for handles and the same MeshAllocator, sized like MeshLibrary::Initialize
+    struct SimulatedMeshLibrary
+    {
+        struct Range { uint32_t offset; uint32_t size; };
+        struct Mesh { mini::MeshAllocations allocations; uint32_t vertexSize = 0; uint32_t indexSize = 0; };
+
+        mini::SlotMap<mini::MeshResourceHandle, Mesh> slots;
+        mini::MeshAllocator allocator;
+        bool deferDestroy = true;
+        uint32_t numFailedAllocations = 0;
+
+        bool Initialize(uint32_t poolSize)
+        {
+            return slots.Initialize(poolSize) && allocator.Initialize(poolSize, mini::MeshLibrary::GetMaxPendingDestroys(poolSize),
+                mini::MeshLibrary::DEFAULT_VERTEX_BUFFER_SIZE, mini::MeshLibrary::DEFAULT_INDEX_BUFFER_SIZE, mini::MeshLibrary::MESHLET_CAPACITY, mini::MeshLibrary::SUBMESH_CAPACITY);
+        }
+
+        // @note    like MeshLibrary::SetData, the old ranges go the way of a destroyed mesh's. without deferred destruction they are
+        //          recycled right away, as if the GPU was idle
+        void SetData(mini::MeshResourceHandle handle, uint32_t vertexSize)
+        {
+            auto& mesh = *slots.LookupHot(handle);
+            Release(mesh);
+            auto const indexSize = vertexSize / 2;
+            if (!allocator.AllocateGeometry(vertexSize, indexSize, &mesh.allocations)) {
+                numFailedAllocations++;
+                return;
+            }
+            mesh.allocations.meshlet = allocator.AllocateMeshlets(1 + vertexSize / 1024);
+            mesh.allocations.submesh = allocator.AllocateSubmeshes(1 + vertexSize % 4);
+            numFailedAllocations += mesh.allocations.meshlet.IsValid() && mesh.allocations.submesh.IsValid() ? 0 : 1;
+            mesh.vertexSize = vertexSize;
+            mesh.indexSize = indexSize;
+        }
+
+        mini::MeshResourceHandle Allocate(uint32_t vertexSize)
+        {
+            auto handle = slots.Allocate();
+            if (!slots.IsValid(handle)) {
+                numFailedAllocations++;
+                return handle;
+            }
+            SetData(handle, vertexSize);
+            return handle;
+        }
+
+        void Release(Mesh& mesh)
+        {
+            allocator.Release(mesh.allocations);
+            if (!deferDestroy) { allocator.CollectGarbage(UINT64_MAX); }
+            mesh = Mesh();
+        }
+
+        void Destroy(mini::MeshResourceHandle handle)
+        {
+            Release(*slots.LookupHot(handle));
+            slots.Free(handle);
+        }
+    };
+
+    // frames the simulated GPU hasn't finished, with every buffer range they read
+    struct InFlightFrame
+    {
+        uint64_t fenceValue;
+        std::vector<SimulatedMeshLibrary::Range> vertexRanges;
+        std::vector<SimulatedMeshLibrary::Range> indexRanges;
+    };
+
+    struct StreamingResult
+    {
+        uint64_t minResident = ~0ull;
+        uint64_t maxResident = 0;
+        uint32_t numHazards = 0;    // allocations that overlapped a range a frame in flight still reads
+        uint32_t numFailedAllocations = 0;
+        uint32_t maxPendingDestroys = 0;
+    };
+
+    // @note with reupload the first frames after a swap replace the data of a tenth of the live meshes, the handles stay while the ranges change
+    StreamingResult RunCycles(bool deferDestroy, bool reupload, uint32_t numCycles, uint32_t poolSize, uint32_t meshesPerLevel, uint32_t gpuLatency)
+    {
+        SimulatedMeshLibrary library;
+        library.Initialize(poolSize);
+        library.deferDestroy = deferDestroy;
+        library.Allocate(1024);     // @note fallback mesh, lives forever
+
+        std::mt19937 rng;
+        std::deque<InFlightFrame> inFlight;
+        std::vector<mini::MeshResourceHandle> level;
+        uint64_t frameFenceValue = 0;
+        uint64_t completedFenceValue = 0;
+        StreamingResult result;
+
+        auto const overlaps = [](std::vector<SimulatedMeshLibrary::Range> const& ranges, mini::OffsetAllocation allocation, uint32_t size) {
+            for (auto const& r : ranges) {
+                if (allocation.offset < r.offset + r.size && r.offset < allocation.offset + size) { return true; }
+            }
+            return false;
+        };
+        auto const overlapsInFlight = [&](mini::MeshResourceHandle handle) {
+            auto const& mesh = *library.slots.LookupHot(handle);
+            for (auto const& frame : inFlight) {
+                if (overlaps(frame.vertexRanges, mesh.allocations.vertex, mesh.vertexSize) || overlaps(frame.indexRanges, mesh.allocations.index, mesh.indexSize)) { return true; }
+            }
+            return false;
+        };
+        // @note a level takes about a quarter of the default buffers, sizes are multiples of 32 so the index half stays aligned
+        auto const randomVertexSize = [&]() { return (4096 + rng() % (48 * 1024)) & ~31u; };
+        auto const runFrame = [&](bool streamIn, bool streamOut, uint32_t numReuploads) {
+            library.allocator.BeginFrame(frameFenceValue + 1, completedFenceValue);
+            if (streamOut) {
+                for (auto h : level) { library.Destroy(h); }
+                level.clear();
+            }
+            if (streamIn) {
+                rng.seed(0x1e7e1);  // @note every level has the same size distribution so resident bytes are comparable across cycles
+                for (auto i = 0u; i < meshesPerLevel; ++i) {
+                    level.push_back(library.Allocate(randomVertexSize()));
+                    result.numHazards += overlapsInFlight(level.back()) ? 1 : 0;
+                }
+            }
+            for (auto i = 0u; i < numReuploads; ++i) {
+                auto const handle = level[rng() % level.size()];
+                library.SetData(handle, randomVertexSize());
+                result.numHazards += overlapsInFlight(handle) ? 1 : 0;
+            }
+            // "record" the frame: every live mesh is drawn
+            InFlightFrame frame{ ++frameFenceValue, {}, {} };
+            for (auto h : level) {
+                auto const& mesh = *library.slots.LookupHot(h);
+                frame.vertexRanges.push_back({ mesh.allocations.vertex.offset, mesh.vertexSize });
+                frame.indexRanges.push_back({ mesh.allocations.index.offset, mesh.indexSize });
+            }
+            inFlight.push_back(std::move(frame));
+            // the simulated GPU finishes frames gpuLatency frames after they were submitted
+            while (!inFlight.empty() && inFlight.front().fenceValue + gpuLatency <= frameFenceValue) {
+                completedFenceValue = inFlight.front().fenceValue;
+                inFlight.pop_front();
+            }
+            auto const pending = library.allocator.GetNumPendingReleases();
+            result.maxPendingDestroys = pending > result.maxPendingDestroys ? pending : result.maxPendingDestroys;
+        };
+
+        // @note each cycle swaps the previous level out for the next one in the same frame, like a streaming boundary would
+        for (auto cycle = 0u; cycle < numCycles; ++cycle) {
+            runFrame(true, true, 0);
+            // @note the reuploads' sizes come from the level's seed, so every cycle ends up with the same resident bytes
+            for (auto f = 0u; f < gpuLatency + 8; ++f) { runFrame(false, false, reupload && f < 4 ? meshesPerLevel / 10 : 0); }
+
+            // once the GPU caught up with the swap only the fallback mesh and the current level may be resident
+            auto const resident = library.allocator.GetResidentBytes();
+            result.minResident = resident < result.minResident ? resident : result.minResident;
+            result.maxResident = resident > result.maxResident ? resident : result.maxResident;
+        }
+        result.numFailedAllocations = library.numFailedAllocations;
+        return result;
+    }
+}
+
+int mini::bench::RunMeshStreamingBenchmark(Options const& options)
+{
+    auto const numCycles = 50 * options.scale;
+    uint32_t const poolSize = 1024;     // @note what main.cpp initializes the mesh library with
+    uint32_t const meshesPerLevel = 600;
+    uint32_t const gpuLatency = 2;
+
+    struct Scenario
+    {
+        char const*     name;
+        bool            deferDestroy;
+        bool            reupload;
+        StreamingResult result;
+    };
+    Scenario scenarios[] = {
+        { "deferred", true, false, {} },
+        { "immediate", false, false, {} },
+        { "reupload", true, true, {} },
+        { "reupload immediate", false, true, {} },
+    };
+    bool ok = true;
+    for (auto& scenario : scenarios) {
+        scenario.result = RunCycles(scenario.deferDestroy, scenario.reupload, numCycles, poolSize, meshesPerLevel, gpuLatency);
+        // @note    every allocation must succeed while the old level waits for its frames, resident bytes must come back to the same
+        //          value after every cycle and no recycled range may still be in use by the GPU
+        ok &= scenario.result.numFailedAllocations == 0;
+        if (scenario.deferDestroy) { ok &= scenario.result.minResident == scenario.result.maxResident && scenario.result.numHazards == 0; }
+    }
+
+    if (!options.csv) {
+        printf("deferred destroy checks: %s\n", ok ? "ok" : "FAILED");
+        printf("%-20s %8s %16s %16s %10s %10s %16s\n", "destroy", "cycles", "min resident", "max resident", "hazards", "failed", "max pending");
+    }
+    for (auto const& scenario : scenarios) {
+        auto const& r = scenario.result;
+        if (options.csv) {
+            printf("mesh_streaming,%s,%u,%llu,%llu,%u,%u,%u\n", scenario.name, numCycles, (unsigned long long)r.minResident, (unsigned long long)r.maxResident,
+                r.numHazards, r.numFailedAllocations, r.maxPendingDestroys);
+        }
+        else {
+            printf("%-20s %8u %16llu %16llu %10u %10u %16u\n", scenario.name, numCycles, (unsigned long long)r.minResident, (unsigned long long)r.maxResident,
+                r.numHazards, r.numFailedAllocations, r.maxPendingDestroys);
+        }
+    }
+    return ok ? 0 : 1;
+}
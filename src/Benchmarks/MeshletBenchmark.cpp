@@ -0,0 +1,201 @@
+#include "Benchmark.h"
+#include "TestMeshes.h"
+
+#include <Runtime/Culling/MeshletCulling.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    using mini::bench::CookedMesh;
+    using mini::bench::FLOATS_PER_VERTEX;
+    using mini::bench::VERTEX_STRIDE;
+
+    struct Instance
+    {
+        CookedMesh const*   mesh;
+        float               position[3];
+        float               rotation[4];
+        float               scale;
+    };
+
+    void ToWorld(Instance const& instance, float const* p, float* out)
+    {
+        auto const q = instance.rotation;
+        float const t[3] = { 2.0f * (q[1] * p[2] - q[2] * p[1]), 2.0f * (q[2] * p[0] - q[0] * p[2]), 2.0f * (q[0] * p[1] - q[1] * p[0]) };
+        float const c[3] = { q[1] * t[2] - q[2] * t[1], q[2] * t[0] - q[0] * t[2], q[0] * t[1] - q[1] * t[0] };
+        for (auto k = 0; k < 3; ++k) { out[k] = instance.position[k] + instance.scale * (p[k] + q[3] * t[k] + c[k]); }
+    }
+
+    // brute force reference: every triangle of a culled meshlet must be back facing or entirely outside one frustum plane
+    bool IsCullingConservative(Instance const& instance, mini::Meshlet const& meshlet, mini::CullingView const& view)
+    {
+        auto const vertices = reinterpret_cast<float const*>(instance.mesh->vertexData.data());
+        for (auto i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.numIndices; i += 3) {
+            float p[3][3];
+            for (auto k = 0; k < 3; ++k) { ToWorld(instance, vertices + instance.mesh->indices[i + k] * FLOATS_PER_VERTEX, p[k]); }
+
+            bool outside = false;
+            for (auto plane = 0; plane < 6 && !outside; ++plane) {
+                auto const& f = view.frustumPlanes[plane];
+                outside = true;
+                for (auto k = 0; k < 3; ++k) { outside &= f[0] * p[k][0] + f[1] * p[k][1] + f[2] * p[k][2] + f[3] < 1e-4f; }
+            }
+            if (outside) { continue; }
+
+            float const e0[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+            float const e1[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+            float n[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+            auto const length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (length <= 0.0f) { continue; }
+            float const toTriangle[3] = { p[0][0] - view.position[0], p[0][1] - view.position[1], p[0][2] - view.position[2] };
+            if ((n[0] * toTriangle[0] + n[1] * toTriangle[1] + n[2] * toTriangle[2]) / length < -1e-4f) { return false; }
+        }
+        return true;
+    }
+
+    bool CheckMeshlets(CookedMesh const& mesh, std::vector<uint32_t> const& sourceIndices)
+    {
+        bool ok = mesh.indices.size() == sourceIndices.size();
+        auto const vertices = reinterpret_cast<float const*>(mesh.vertexData.data());
+        auto const numVertices = static_cast<uint32_t>(mesh.vertexData.size() / VERTEX_STRIDE);
+        uint32_t expectedFirstIndex = 0;
+        std::vector<uint32_t> tags(numVertices, ~0u);
+        for (auto m = 0u; m < mesh.meshlets.size(); ++m) {
+            auto const& meshlet = mesh.meshlets[m];
+            ok &= meshlet.firstIndex == expectedFirstIndex && meshlet.numIndices % 3 == 0;
+            ok &= meshlet.numIndices / 3 <= mini::MAX_MESHLET_TRIANGLES;
+            expectedFirstIndex += meshlet.numIndices;
+
+            uint32_t uniqueVertices = 0;
+            auto const coneCos = sqrtf(1.0f - meshlet.coneCutoff * meshlet.coneCutoff);
+            for (auto i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.numIndices; ++i) {
+                auto const v = mesh.indices[i];
+                if (tags[v] != m) { tags[v] = m; uniqueVertices++; }
+                auto const p = vertices + v * FLOATS_PER_VERTEX;
+                float const d[3] = { p[0] - meshlet.center[0], p[1] - meshlet.center[1], p[2] - meshlet.center[2] };
+                ok &= sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]) <= meshlet.radius * 1.0001f + 1e-6f;
+            }
+            ok &= uniqueVertices <= mini::MAX_MESHLET_VERTICES;
+
+            // @note every triangle normal must lie inside the cone
+            if (meshlet.coneCutoff < 1.0f) {
+                for (auto i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.numIndices; i += 3) {
+                    auto const a = vertices + mesh.indices[i] * FLOATS_PER_VERTEX;
+                    auto const b = vertices + mesh.indices[i + 1] * FLOATS_PER_VERTEX;
+                    auto const c = vertices + mesh.indices[i + 2] * FLOATS_PER_VERTEX;
+                    float const e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+                    float const e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+                    float const n[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+                    auto const length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                    if (length > 0.0f) {
+                        ok &= (n[0] * meshlet.coneAxis[0] + n[1] * meshlet.coneAxis[1] + n[2] * meshlet.coneAxis[2]) / length >= coneCos - 1e-4f;
+                    }
+                }
+            }
+        }
+        ok &= expectedFirstIndex == mesh.indices.size();
+        return ok;
+    }
+}
+
+int mini::bench::RunMeshletBenchmark(Options const& options)
+{
+    std::mt19937 rng(0x3e51);
+    bool ok = true;
+
+    CookedMesh sphere, ground;
+    {
+        std::vector<float> vertices;
+        std::vector<uint32_t> indices;
+        float const origin[3] = { 0.0f, 0.0f, 0.0f };
+        AppendSphere(48, 96, origin, 0.0f, vertices, indices);
+        mini::Timer timer;
+        Cook(vertices, indices, nullptr, &sphere);
+        auto const cookMs = timer.GetElapsedTime() * 1000.0;
+        ok &= CheckMeshlets(sphere, indices);
+
+        std::vector<float> groundVertices;
+        std::vector<uint32_t> groundIndices;
+        AppendGrid(256, 64.0f, groundVertices, groundIndices);
+        Cook(groundVertices, groundIndices, nullptr, &ground);
+        ok &= CheckMeshlets(ground, groundIndices);
+
+        if (!options.csv) {
+            for (auto const mesh : { &sphere, &ground }) {
+                auto const numTriangles = mesh->indices.size() / 3;
+                uint32_t numConeless = 0;
+                for (auto const& m : mesh->meshlets) { numConeless += m.coneCutoff >= 1.0f ? 1 : 0; }
+                printf("%-7s %7zu triangles, %5zu meshlets, %.1f triangles per meshlet, %.1f%% without a usable cone\n", mesh == &sphere ? "sphere" : "ground",
+                    numTriangles, mesh->meshlets.size(), static_cast<double>(numTriangles) / mesh->meshlets.size(), 100.0 * numConeless / mesh->meshlets.size());
+            }
+            printf("sphere cook time %.2fms\n", cookMs);
+        }
+    }
+
+    // test scene: rows of randomly rotated and scaled spheres on a ground plane, seen from one corner
+    std::vector<Instance> instances;
+    instances.push_back({ &ground, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f, 1.0f }, 1.0f });
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 1.5f);
+    auto const gridSize = 12u * options.scale;
+    for (auto z = 0u; z < gridSize; ++z) {
+        for (auto x = 0u; x < gridSize; ++x) {
+            Instance instance = { &sphere, { 2.0f + x * 5.0f, 1.5f, 2.0f + z * 5.0f }, { unit(rng), unit(rng), unit(rng), unit(rng) }, scale(rng) };
+            auto const length = sqrtf(instance.rotation[0] * instance.rotation[0] + instance.rotation[1] * instance.rotation[1] +
+                instance.rotation[2] * instance.rotation[2] + instance.rotation[3] * instance.rotation[3]);
+            for (auto& c : instance.rotation) { c /= length; }
+            instances.push_back(instance);
+        }
+    }
+
+    float const eye[3] = { 20.0f, 4.0f, 24.0f };
+    float const forward[3] = { 1.0f, -0.25f, 0.4f };
+    float const up[3] = { 0.0f, 1.0f, 0.0f };
+    auto const view = mini::MakeCullingView(eye, forward, up, 60.0f * 3.14159265f / 180.0f, 16.0f / 9.0f, 0.1f, 100.0f);
+
+    std::vector<uint32_t> visible(sphere.meshlets.size() > ground.meshlets.size() ? sphere.meshlets.size() : ground.meshlets.size());
+    mini::MeshletCullingStats stats;
+    for (auto const& instance : instances) {
+        auto const localView = mini::TransformCullingView(view, instance.position, instance.rotation, instance.scale);
+        auto const& meshlets = instance.mesh->meshlets;
+        auto const numVisible = mini::CullMeshlets(meshlets.data(), static_cast<uint32_t>(meshlets.size()), localView, visible.data(), &stats);
+
+        uint32_t v = 0;
+        for (auto m = 0u; m < meshlets.size(); ++m) {
+            if (v < numVisible && visible[v] == m) { v++; continue; }
+            ok &= IsCullingConservative(instance, meshlets[m], view);
+        }
+    }
+    ok &= stats.numFrustumCulled > 0 && stats.numBackfaceCulled > 0;
+
+    // timing without the reference checks
+    uint32_t const numRuns = 50;
+    uint64_t visibleSum = 0;
+    mini::Timer timer;
+    for (auto run = 0u; run < numRuns; ++run) {
+        for (auto const& instance : instances) {
+            auto const localView = mini::TransformCullingView(view, instance.position, instance.rotation, instance.scale);
+            visibleSum += mini::CullMeshlets(instance.mesh->meshlets.data(), static_cast<uint32_t>(instance.mesh->meshlets.size()), localView, visible.data());
+        }
+    }
+    DoNotOptimize(visibleSum);
+    auto const nsPerMeshlet = timer.GetElapsedTime() * 1e9 / (static_cast<double>(numRuns) * stats.numMeshlets);
+
+    if (options.csv) {
+        printf("meshlets,%u,%u,%u,%llu,%llu,%.3f,%.3f\n", stats.numMeshlets, stats.numFrustumCulled, stats.numBackfaceCulled,
+            static_cast<unsigned long long>(stats.numTriangles), static_cast<unsigned long long>(stats.numVisibleTriangles), stats.GetCulledTrianglePercentage(), nsPerMeshlet);
+    }
+    else {
+        printf("meshlet checks: %s\n", ok ? "ok" : "FAILED");
+        printf("scene: %zu instances, %u meshlets, %llu triangles\n", instances.size(), stats.numMeshlets, static_cast<unsigned long long>(stats.numTriangles));
+        printf("culled: %u meshlets by frustum, %u by normal cone, %.1f%% of triangles culled, %llu left\n", stats.numFrustumCulled, stats.numBackfaceCulled,
+            stats.GetCulledTrianglePercentage(), static_cast<unsigned long long>(stats.numVisibleTriangles));
+        printf("cull: %.2f ns per meshlet\n", nsPerMeshlet);
+    }
+    return ok ? 0 : 1;
+}
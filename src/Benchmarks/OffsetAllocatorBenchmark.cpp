@@ -0,0 +1,161 @@
+#include "Benchmark.h"
+
+#include <Runtime/Memory/OffsetAllocator.h>
+#include <Runtime/util.h>
+
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    struct LiveAllocation
+    {
+        mini::OffsetAllocation  allocation;
+        uint32_t                size = 0;
+        uint8_t                 pattern = 0;
+    };
+
+    // @note mesh-like size distribution: mostly small, occasionally very large
+    uint32_t RandomAllocationSize(std::mt19937& rng)
+    {
+        auto const bucket = rng() % 100;
+        uint32_t size = 0;
+        if (bucket < 70) { size = 256 + rng() % 16384; }
+        else if (bucket < 97) { size = 16384 + rng() % (256 * 1024); }
+        else { size = 1024 * 1024 + rng() % (4 * 1024 * 1024); }
+        return (size + 15) & ~15u;
+    }
+
+    // live allocations must not overlap, stay in bounds and add up with the free storage
+    bool Validate(mini::OffsetAllocator const& allocator, std::vector<LiveAllocation> live)
+    {
+        std::sort(live.begin(), live.end(), [](LiveAllocation const& a, LiveAllocation const& b) { return a.allocation.offset < b.allocation.offset; });
+        uint64_t used = 0;
+        for (auto i = 0u; i < live.size(); ++i) {
+            auto const end = static_cast<uint64_t>(live[i].allocation.offset) + live[i].size;
+            if (end > allocator.GetSize()) { return false; }
+            if (i + 1 < live.size() && end > live[i + 1].allocation.offset) { return false; }
+            if (allocator.GetAllocationSize(live[i].allocation) != live[i].size) { return false; }
+            used += live[i].size;
+        }
+        return allocator.GetReport().totalFree == allocator.GetSize() - used;
+    }
+
+    bool CheckPatterns(std::vector<uint8_t> const& memory, std::vector<LiveAllocation> const& live)
+    {
+        for (auto const& l : live) {
+            for (auto i = 0u; i < l.size; i += 61) {
+                if (memory[l.allocation.offset + i] != l.pattern) { return false; }
+            }
+        }
+        return true;
+    }
+
+    void Churn(mini::OffsetAllocator& allocator, std::vector<LiveAllocation>& live, std::vector<uint8_t>* memory, uint32_t numOps, std::mt19937& rng)
+    {
+        for (auto op = 0u; op < numOps; ++op) {
+            bool const allocate = live.empty() || (rng() % 100) < 55;
+            if (allocate) {
+                LiveAllocation l;
+                l.size = RandomAllocationSize(rng);
+                l.allocation = allocator.Allocate(l.size);
+                if (!l.allocation.IsValid()) { continue; }
+                l.pattern = static_cast<uint8_t>(rng());
+                if (memory) { memset(memory->data() + l.allocation.offset, l.pattern, l.size); }
+                live.push_back(l);
+            }
+            else {
+                auto const idx = rng() % live.size();
+                allocator.Free(live[idx].allocation);
+                live[idx] = live.back();
+                live.pop_back();
+            }
+        }
+    }
+}
+
+int mini::bench::RunOffsetAllocatorBenchmark(Options const& options)
+{
+    uint32_t const bufferSize = 256 * 1024 * 1024;
+    std::mt19937 rng(0xa110c);
+    bool ok = true;
+
+    {   // fragmentation checks on a simulated buffer: churn, validate, compact, verify contents survived
+        mini::OffsetAllocator allocator;
+        allocator.Initialize(bufferSize);
+        std::vector<uint8_t> memory(bufferSize);
+        std::vector<LiveAllocation> live;
+
+        Churn(allocator, live, &memory, 20000 * options.scale, rng);
+        ok &= Validate(allocator, live);
+        ok &= CheckPatterns(memory, live);
+        auto const before = allocator.GetReport();
+
+        std::vector<mini::OffsetAllocation> allocations;
+        for (auto const& l : live) { allocations.push_back(l.allocation); }
+        std::vector<mini::OffsetAllocatorMove> moves(allocations.size());
+        mini::Timer timer;
+        auto const numMoves = allocator.Compact(allocations.data(), static_cast<uint32_t>(allocations.size()), moves.data());
+        uint64_t bytesMoved = 0;
+        for (auto i = 0u; i < numMoves; ++i) {
+            memmove(memory.data() + moves[i].dstOffset, memory.data() + moves[i].srcOffset, moves[i].size);
+            bytesMoved += moves[i].size;
+        }
+        auto const compactMs = timer.GetElapsedTime() * 1000.0;
+        for (auto i = 0u; i < live.size(); ++i) { live[i].allocation = allocations[i]; }
+        ok &= Validate(allocator, live);
+        ok &= CheckPatterns(memory, live);
+        auto const after = allocator.GetReport();
+        ok &= after.numFreeRegions <= 1;
+
+        // everything freed must coalesce back into a single region
+        for (auto const& l : live) { allocator.Free(l.allocation); }
+        auto const empty = allocator.GetReport();
+        ok &= empty.numFreeRegions == 1 && empty.largestFree == bufferSize && empty.totalFree == bufferSize;
+
+        if (options.csv) {
+            printf("offset_allocator,fragmentation,%zu,%.4f,%u,%.4f,%u,%u,%.3f\n", live.size(), before.GetFragmentation(), before.numFreeRegions,
+                after.GetFragmentation(), after.numFreeRegions, numMoves, compactMs);
+        }
+        else {
+            printf("fragmentation checks: %s\n", ok ? "ok" : "FAILED");
+            printf("after churn : %zu live, %.1f MB free in %u regions, largest %.1f MB, fragmentation %.1f%%\n", live.size(),
+                before.totalFree / (1024.0 * 1024.0), before.numFreeRegions, before.largestFree / (1024.0 * 1024.0), before.GetFragmentation() * 100.0f);
+            printf("after compact: %u moves, %.1f MB moved in %.2fms, %u free regions, fragmentation %.1f%%\n", numMoves,
+                bytesMoved / (1024.0 * 1024.0), compactMs, after.numFreeRegions, after.GetFragmentation() * 100.0f);
+        }
+    }
+
+    {   // throughput under steady state churn
+        mini::OffsetAllocator allocator;
+        allocator.Initialize(bufferSize);
+        std::vector<LiveAllocation> live;
+        Churn(allocator, live, nullptr, 10000, rng);
+
+        uint32_t const numOps = 1000000;
+        std::vector<uint32_t> sizes(numOps);
+        for (auto& s : sizes) { s = RandomAllocationSize(rng) / 16; }     // @note smaller sizes so the buffer doesn't run full
+
+        mini::Timer timer;
+        for (auto i = 0u; i < numOps; ++i) {
+            auto const allocation = allocator.Allocate(sizes[i]);
+            if (allocation.IsValid()) {
+                live.push_back({ allocation, sizes[i], 0 });
+            }
+            auto const idx = (i * 2654435761u) % live.size();
+            allocator.Free(live[idx].allocation);
+            live[idx] = live.back();
+            live.pop_back();
+        }
+        auto const nsPerOp = timer.GetElapsedTime() * 1e9 / (numOps * 2.0);
+        ok &= Validate(allocator, live);
+        if (options.csv) {
+            printf("offset_allocator,churn,%zu,%.2f\n", live.size(), nsPerOp);
+        }
+        else {
+            printf("churn: %.2f ns per allocate / free with %zu live allocations\n", nsPerOp, live.size());
+        }
+    }
+    return ok ? 0 : 1;
+}
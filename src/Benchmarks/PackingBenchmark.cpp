@@ -0,0 +1,339 @@
+#include "Benchmark.h"
+
+#include <Runtime/Math/math_packing.h>
+#include <Runtime/Math/math_simd.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    // @note    references in double following the D3D rules directly, nothing shared with math_packing.h. a float times a small
+    //          integer and a small integer over one are exact in double, so rounding them once to float is the correctly rounded
+    //          float result, and nearbyint rounds to nearest even
+    uint16_t ReferenceFloatToHalf(float v)
+    {
+        uint16_t const sign = signbit(v) ? 0x8000 : 0;
+        double const a = fabs(static_cast<double>(v));
+        if (isnan(v)) { return sign | 0x7e00; }
+        if (a >= 65520.0) { return sign | 0x7c00; }     // halfway between 65504 and 2^16 and above
+        if (a < ldexp(1.0, -14)) { return sign | static_cast<uint16_t>(nearbyint(a * ldexp(1.0, 24))); }
+        int exponent;
+        frexp(a, &exponent);
+        exponent -= 1;  // a = 1.m * 2^exponent
+        auto mantissa = static_cast<uint32_t>(nearbyint(ldexp(a, 10 - exponent)));
+        if (mantissa == 2048) {
+            mantissa = 1024;
+            ++exponent;
+        }
+        return sign | static_cast<uint16_t>(((exponent + 15) << 10) | (mantissa - 1024));
+    }
+
+    double ReferenceHalfToFloat(uint16_t h)
+    {
+        auto const exponent = (h >> 10) & 0x1f;
+        auto const mantissa = h & 0x3ff;
+        auto const magnitude = exponent == 0 ? ldexp(mantissa, -24) : exponent == 31 ? (mantissa ? NAN : INFINITY) : ldexp(1024 + mantissa, exponent - 25);
+        return h & 0x8000 ? -magnitude : magnitude;
+    }
+
+    int32_t ReferencePackNorm(float v, uint32_t bits, bool isSigned)
+    {
+        if (isnan(v)) { return 0; }
+        double const scale = isSigned ? (1u << (bits - 1)) - 1 : (1u << bits) - 1;
+        double const c = fmin(fmax(static_cast<double>(v), isSigned ? -1.0 : 0.0), 1.0);
+        return static_cast<int32_t>(nearbyint(static_cast<float>(c * scale)));
+    }
+
+    float ReferenceUnpackNorm(int32_t q, uint32_t bits, bool isSigned)
+    {
+        double const scale = isSigned ? (1u << (bits - 1)) - 1 : (1u << bits) - 1;
+        return static_cast<float>(fmax(q / scale, -1.0));
+    }
+
+    // the float nearest each rounding boundary (k + 0.5) / scale and its neighbors on both sides, the codes themselves,
+    // out of range values and the specials
+    std::vector<float> NormInputs(uint32_t bits, bool isSigned)
+    {
+        auto const scale = static_cast<int32_t>(isSigned ? (1u << (bits - 1)) - 1 : (1u << bits) - 1);
+        std::vector<float> values;
+        for (auto k = isSigned ? -scale - 1 : -1; k <= scale; ++k) {
+            auto const boundary = static_cast<float>((k + 0.5) / scale);
+            values.insert(values.end(), { boundary, nextafterf(boundary, -INFINITY), nextafterf(boundary, INFINITY), static_cast<float>(static_cast<double>(k) / scale) });
+        }
+        values.insert(values.end(), { 0.0f, -0.0f, 1.0f, -1.0f, 2.0f, -2.0f, 1e30f, -1e30f, 1e-40f, -1e-40f, INFINITY, -INFINITY, NAN, -NAN });
+        return values;
+    }
+
+    bool SameFloat(float a, double reference)
+    {
+        return isnan(reference) ? isnan(a) : (a == reference && signbit(a) == signbit(reference));
+    }
+}
+
+int mini::bench::RunPackingBenchmark(Options const& options)
+{
+    std::mt19937 rng(0x9ac4);
+    bool ok = true;
+
+    {   // every half to float, and float to half at every rounding boundary between two halves plus a sweep over all float bit patterns
+        std::vector<uint16_t> halves(65536);
+        for (auto h = 0u; h < 65536; ++h) { halves[h] = static_cast<uint16_t>(h); }
+        std::vector<float> floats(halves.size());
+        math::half_to_float_batch(halves.data(), floats.data(), static_cast<uint32_t>(halves.size()));
+        for (auto h = 0u; h < 65536; ++h) {
+            auto const reference = ReferenceHalfToFloat(static_cast<uint16_t>(h));
+            ok &= SameFloat(math::half_to_float(static_cast<uint16_t>(h)), reference) && SameFloat(floats[h], reference);
+        }
+
+        std::vector<float> inputs;
+        for (auto h = 0u; h < 0x7c00; ++h) {
+            auto const value = ReferenceHalfToFloat(static_cast<uint16_t>(h));
+            auto const next = h == 0x7bff ? 65536.0 : ReferenceHalfToFloat(static_cast<uint16_t>(h + 1));
+            auto const boundary = static_cast<float>((value + next) * 0.5);
+            for (auto f : { static_cast<float>(value), boundary, nextafterf(boundary, 0.0f), nextafterf(boundary, INFINITY) }) {
+                inputs.push_back(f);
+                inputs.push_back(-f);
+            }
+        }
+        for (uint64_t bits = 0; bits < (1ull << 32); bits += 4099) {
+            float f;
+            auto const b = static_cast<uint32_t>(bits);
+            memcpy(&f, &b, sizeof(f));
+            inputs.push_back(f);
+        }
+        inputs.insert(inputs.end(), { INFINITY, -INFINITY, NAN, 65504.0f, 65519.996f, 65520.0f, 1e-45f, 2.9802322e-8f, 2.9802326e-8f });
+
+        std::vector<uint16_t> packed(inputs.size());
+        math::float_to_half_batch(inputs.data(), packed.data(), static_cast<uint32_t>(inputs.size()));
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            auto const reference = ReferenceFloatToHalf(inputs[i]);
+            auto const scalar = math::float_to_half(inputs[i]);
+            if (isnan(inputs[i])) {     // @note only NaN-ness, the payload depends on the conversion
+                ok &= (scalar & 0x7fff) > 0x7c00 && (packed[i] & 0x7fff) > 0x7c00;
+            }
+            else {
+                ok &= scalar == reference && packed[i] == reference;
+            }
+        }
+    }
+
+    {   // unorm / snorm both ways for 8 and 16 bits: packing at the rounding boundaries, unpacking every code
+        struct Format { uint32_t bits; bool isSigned; };
+        for (auto const format : { Format{ 8, false }, Format{ 16, false }, Format{ 8, true }, Format{ 16, true } }) {
+            auto const inputs = NormInputs(format.bits, format.isSigned);
+            auto const n = static_cast<uint32_t>(inputs.size());
+            std::vector<int32_t> batch(n);
+            if (format.bits == 8 && !format.isSigned) {
+                std::vector<uint8_t> q(n);
+                math::pack_unorm8_batch(inputs.data(), q.data(), n);
+                batch.assign(q.begin(), q.end());
+            }
+            else if (format.bits == 16 && !format.isSigned) {
+                std::vector<uint16_t> q(n);
+                math::pack_unorm16_batch(inputs.data(), q.data(), n);
+                batch.assign(q.begin(), q.end());
+            }
+            else if (format.bits == 8) {
+                std::vector<int8_t> q(n);
+                math::pack_snorm8_batch(inputs.data(), q.data(), n);
+                batch.assign(q.begin(), q.end());
+            }
+            else {
+                std::vector<int16_t> q(n);
+                math::pack_snorm16_batch(inputs.data(), q.data(), n);
+                batch.assign(q.begin(), q.end());
+            }
+            for (auto i = 0u; i < n; ++i) {
+                auto const reference = ReferencePackNorm(inputs[i], format.bits, format.isSigned);
+                auto const scalar = format.isSigned ? math::pack_snorm(inputs[i], format.bits) : static_cast<int32_t>(math::pack_unorm(inputs[i], format.bits));
+                ok &= scalar == reference && batch[i] == reference;
+            }
+
+            auto const first = format.isSigned ? -(1 << (format.bits - 1)) : 0;
+            auto const numCodes = 1u << format.bits;
+            std::vector<float> unpacked(numCodes);
+            if (format.bits == 8 && !format.isSigned) {
+                std::vector<uint8_t> q(numCodes);
+                for (auto k = 0u; k < numCodes; ++k) { q[k] = static_cast<uint8_t>(first + static_cast<int32_t>(k)); }
+                math::unpack_unorm8_batch(q.data(), unpacked.data(), numCodes);
+            }
+            else if (format.bits == 16 && !format.isSigned) {
+                std::vector<uint16_t> q(numCodes);
+                for (auto k = 0u; k < numCodes; ++k) { q[k] = static_cast<uint16_t>(first + static_cast<int32_t>(k)); }
+                math::unpack_unorm16_batch(q.data(), unpacked.data(), numCodes);
+            }
+            else if (format.bits == 8) {
+                std::vector<int8_t> q(numCodes);
+                for (auto k = 0u; k < numCodes; ++k) { q[k] = static_cast<int8_t>(first + static_cast<int32_t>(k)); }
+                math::unpack_snorm8_batch(q.data(), unpacked.data(), numCodes);
+            }
+            else {
+                std::vector<int16_t> q(numCodes);
+                for (auto k = 0u; k < numCodes; ++k) { q[k] = static_cast<int16_t>(first + static_cast<int32_t>(k)); }
+                math::unpack_snorm16_batch(q.data(), unpacked.data(), numCodes);
+            }
+            for (auto k = 0u; k < numCodes; ++k) {
+                auto const q = first + static_cast<int32_t>(k);
+                auto const reference = ReferenceUnpackNorm(q, format.bits, format.isSigned);
+                auto const scalar = format.isSigned ? math::unpack_snorm(q, format.bits) : math::unpack_unorm(static_cast<uint32_t>(q), format.bits);
+                ok &= scalar == reference && unpacked[k] == reference;
+            }
+        }
+    }
+
+    {   // r10g10b10a2: random values partly out of range and the specials, every code of every channel
+        std::uniform_real_distribution<float> unit(-0.25f, 1.25f);
+        std::vector<math::vec4f_t> values;
+        for (auto i = 0u; i < (1u << 18); ++i) { values.push_back(math::vec4f_t(unit(rng), unit(rng), unit(rng), unit(rng))); }
+        for (auto const v : NormInputs(10, false)) { values.push_back(math::vec4f_t(v, 1.0f - v, v * 0.5f, v)); }
+        values.push_back(math::vec4f_t(NAN, INFINITY, -INFINITY, -0.0f));
+
+        auto const n = static_cast<uint32_t>(values.size());
+        std::vector<uint32_t> packed(n);
+        math::pack_r10g10b10a2_batch(values.data(), packed.data(), n);
+        for (auto i = 0u; i < n; ++i) {
+            auto const& v = values[i];
+            auto const reference = static_cast<uint32_t>(ReferencePackNorm(v.x, 10, false)) | (static_cast<uint32_t>(ReferencePackNorm(v.y, 10, false)) << 10)
+                | (static_cast<uint32_t>(ReferencePackNorm(v.z, 10, false)) << 20) | (static_cast<uint32_t>(ReferencePackNorm(v.w, 2, false)) << 30);
+            ok &= math::pack_r10g10b10a2(v) == reference && packed[i] == reference;
+        }
+
+        std::vector<uint32_t> codes;
+        for (auto k = 0u; k < 1024; ++k) { codes.push_back(k | ((1023 - k) << 10) | (((k * 7) & 1023) << 20) | ((k & 3) << 30)); }
+        std::uniform_int_distribution<uint32_t> anyBits;
+        for (auto i = 0u; i < (1u << 18); ++i) { codes.push_back(anyBits(rng)); }
+        std::vector<math::vec4f_t> unpacked(codes.size());
+        math::unpack_r10g10b10a2_batch(codes.data(), unpacked.data(), static_cast<uint32_t>(codes.size()));
+        for (size_t i = 0; i < codes.size(); ++i) {
+            auto const p = codes[i];
+            float const reference[4] = { ReferenceUnpackNorm(p & 0x3ff, 10, false), ReferenceUnpackNorm((p >> 10) & 0x3ff, 10, false),
+                ReferenceUnpackNorm((p >> 20) & 0x3ff, 10, false), ReferenceUnpackNorm(p >> 30, 2, false) };
+            auto const scalar = math::unpack_r10g10b10a2(p);
+            for (auto c = 0; c < 4; ++c) { ok &= scalar.elements[c] == reference[c] && unpacked[i].elements[c] == reference[c]; }
+        }
+    }
+
+    double maxAngle = 0.0;
+    {   // octahedral: batch packing bit exact against scalar, direction error of the round trip, unit length after unpacking
+        std::normal_distribution<float> gaussian;
+        std::vector<float> x, y, z;
+        for (auto i = 0u; i < (1u << 20); ++i) {
+            x.push_back(gaussian(rng));
+            y.push_back(gaussian(rng));
+            z.push_back(gaussian(rng));
+        }
+        float const special[][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }, { 1, 1, 1 }, { -1, -1, -1 },
+            { 1, -1, -0.0f }, { -0.0f, -0.0f, -1 } };
+        for (auto const& s : special) {
+            x.push_back(s[0]);
+            y.push_back(s[1]);
+            z.push_back(s[2]);
+        }
+
+        auto const n = static_cast<uint32_t>(x.size());
+        std::vector<uint32_t> packed(n);
+        std::vector<float> ux(n), uy(n), uz(n);
+        math::pack_octahedral_batch({ x.data(), y.data(), z.data() }, packed.data(), n);
+        math::unpack_octahedral_batch(packed.data(), { ux.data(), uy.data(), uz.data() }, n);
+        for (auto i = 0u; i < n; ++i) {
+            ok &= packed[i] == math::pack_octahedral(math::vec3f_t(x[i], y[i], z[i]));
+            auto const scalar = math::unpack_octahedral(packed[i]);
+            ok &= fabsf(scalar.x - ux[i]) <= 2.4e-7f && fabsf(scalar.y - uy[i]) <= 2.4e-7f && fabsf(scalar.z - uz[i]) <= 2.4e-7f;
+            // @note atan2 of the cross and dot products, acos of the cosine can't resolve such small angles
+            double const cx = uy[i] * static_cast<double>(z[i]) - uz[i] * static_cast<double>(y[i]);
+            double const cy = uz[i] * static_cast<double>(x[i]) - ux[i] * static_cast<double>(z[i]);
+            double const cz = ux[i] * static_cast<double>(y[i]) - uy[i] * static_cast<double>(x[i]);
+            double const cosine = ux[i] * static_cast<double>(x[i]) + uy[i] * static_cast<double>(y[i]) + uz[i] * static_cast<double>(z[i]);
+            maxAngle = fmax(maxAngle, atan2(sqrt(cx * cx + cy * cy + cz * cz), cosine) * 57.29577951308232);
+            ok &= fabs(sqrt(static_cast<double>(ux[i]) * ux[i] + static_cast<double>(uy[i]) * uy[i] + static_cast<double>(uz[i]) * uz[i]) - 1.0) <= 3e-7;
+        }
+        ok &= maxAngle <= 0.005;
+        ok &= math::unpack_octahedral(math::pack_octahedral(math::vec3f_t(0.0f, 0.0f, 0.0f))).z == 1.0f;
+    }
+
+    // -----------------------------------------------------------
+
+    auto const count = (1u << 20) * options.scale + 5;     // @note odd on purpose, the tails go through the scalar functions
+    auto const numRuns = 16u;
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::vector<float> a(count), b(count), c(count), floats(count);
+    for (auto i = 0u; i < count; ++i) {
+        a[i] = unit(rng);
+        b[i] = unit(rng);
+        c[i] = unit(rng);
+    }
+    std::vector<uint8_t> bytes(count);
+    std::vector<uint16_t> shorts(count);
+    std::vector<uint32_t> words(count);
+    std::vector<math::vec4f_t> colors(count), colorsOut(count);
+    for (auto i = 0u; i < count; ++i) { colors[i] = math::vec4f_t(a[i] * 0.5f + 0.5f, b[i] * 0.5f + 0.5f, c[i] * 0.5f + 0.5f, 1.0f); }
+    math::float_to_half_batch(a.data(), shorts.data(), count);
+
+    struct Row { char const* format; char const* direction; uint32_t bytesPerElement; double scalarNs, batchNs; };
+    std::vector<Row> rows;
+    auto measure = [&](char const* format, char const* direction, uint32_t bytesPerElement, auto&& scalar, auto&& batch) {
+        rows.push_back({ format, direction, bytesPerElement, MeasureNsPerElement(count, numRuns, scalar), MeasureNsPerElement(count, numRuns, batch) });
+    };
+    measure("half", "pack", 6,
+        [&]() { for (auto i = 0u; i < count; ++i) { shorts[i] = math::float_to_half(a[i]); } DoNotOptimize(shorts[0]); },
+        [&]() { math::float_to_half_batch(a.data(), shorts.data(), count); DoNotOptimize(shorts[0]); });
+    measure("half", "unpack", 6,
+        [&]() { for (auto i = 0u; i < count; ++i) { floats[i] = math::half_to_float(shorts[i]); } DoNotOptimize(floats[0]); },
+        [&]() { math::half_to_float_batch(shorts.data(), floats.data(), count); DoNotOptimize(floats[0]); });
+    measure("unorm8", "pack", 5,
+        [&]() { for (auto i = 0u; i < count; ++i) { bytes[i] = static_cast<uint8_t>(math::pack_unorm(a[i], 8)); } DoNotOptimize(bytes[0]); },
+        [&]() { math::pack_unorm8_batch(a.data(), bytes.data(), count); DoNotOptimize(bytes[0]); });
+    measure("unorm8", "unpack", 5,
+        [&]() { for (auto i = 0u; i < count; ++i) { floats[i] = math::unpack_unorm(bytes[i], 8); } DoNotOptimize(floats[0]); },
+        [&]() { math::unpack_unorm8_batch(bytes.data(), floats.data(), count); DoNotOptimize(floats[0]); });
+    measure("snorm16", "pack", 6,
+        [&]() { for (auto i = 0u; i < count; ++i) { shorts[i] = static_cast<uint16_t>(math::pack_snorm(a[i], 16)); } DoNotOptimize(shorts[0]); },
+        [&]() { math::pack_snorm16_batch(a.data(), reinterpret_cast<int16_t*>(shorts.data()), count); DoNotOptimize(shorts[0]); });
+    measure("snorm16", "unpack", 6,
+        [&]() { for (auto i = 0u; i < count; ++i) { floats[i] = math::unpack_snorm(static_cast<int16_t>(shorts[i]), 16); } DoNotOptimize(floats[0]); },
+        [&]() { math::unpack_snorm16_batch(reinterpret_cast<int16_t const*>(shorts.data()), floats.data(), count); DoNotOptimize(floats[0]); });
+    measure("rgb10a2", "pack", 20,
+        [&]() { for (auto i = 0u; i < count; ++i) { words[i] = math::pack_r10g10b10a2(colors[i]); } DoNotOptimize(words[0]); },
+        [&]() { math::pack_r10g10b10a2_batch(colors.data(), words.data(), count); DoNotOptimize(words[0]); });
+    measure("rgb10a2", "unpack", 20,
+        [&]() { for (auto i = 0u; i < count; ++i) { colorsOut[i] = math::unpack_r10g10b10a2(words[i]); } DoNotOptimize(colorsOut[0]); },
+        [&]() { math::unpack_r10g10b10a2_batch(words.data(), colorsOut.data(), count); DoNotOptimize(colorsOut[0]); });
+    measure("octahedral", "pack", 16,
+        [&]() { for (auto i = 0u; i < count; ++i) { words[i] = math::pack_octahedral(math::vec3f_t(a[i], b[i], c[i])); } DoNotOptimize(words[0]); },
+        [&]() { math::pack_octahedral_batch({ a.data(), b.data(), c.data() }, words.data(), count); DoNotOptimize(words[0]); });
+    std::vector<float> ox(count), oy(count), oz(count);
+    measure("octahedral", "unpack", 16,
+        [&]() {
+            for (auto i = 0u; i < count; ++i) {
+                auto const n = math::unpack_octahedral(words[i]);
+                ox[i] = n.x;
+                oy[i] = n.y;
+                oz[i] = n.z;
+            }
+            DoNotOptimize(ox[0]);
+        },
+        [&]() { math::unpack_octahedral_batch(words.data(), { ox.data(), oy.data(), oz.data() }, count); DoNotOptimize(ox[0]); });
+
+    if (options.csv) { printf("benchmark,format,direction,scalar_ns,batch_ns,speedup,batch_gbps\n"); }
+    else { printf("%-11s %-7s %10s %10s %8s %11s\n", "format", "dir", "scalar ns", "batch ns", "speedup", "batch GB/s"); }
+    for (auto const& row : rows) {
+        auto const gbps = row.bytesPerElement / row.batchNs;     // bytes per ns is GB/s
+        if (options.csv) {
+            printf("packing,%s,%s,%.3f,%.3f,%.2f,%.2f\n", row.format, row.direction, row.scalarNs, row.batchNs, row.scalarNs / row.batchNs, gbps);
+        }
+        else {
+            printf("%-11s %-7s %10.3f %10.3f %7.2fx %11.2f\n", row.format, row.direction, row.scalarNs, row.batchNs, row.scalarNs / row.batchNs, gbps);
+        }
+    }
+
+    if (!options.csv) {
+        printf("(%u elements, GB/s counts the floats read or written and the packed bytes, octahedral round trip max error %.5f degrees, backend %s)\n",
+            count, maxAngle, math::GetSimdBackendName());
+        printf("packing checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,318 @@
+#include "Benchmark.h"
+
+#include <Runtime/Math/math_batch.h>
+#include <Runtime/Math/math_functions.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using mini::math::quatf_t;
+    using mini::math::dualquatf_t;
+    using mini::math::vec3f_t;
+
+    // one float array per component
+    struct QuatStreams
+    {
+        std::vector<float> w, x, y, z;
+
+        explicit QuatStreams(uint32_t count) : w(count), x(count), y(count), z(count) {}
+
+        quatf_t Get(uint32_t i) const { return quatf_t(w[i], x[i], y[i], z[i]); }
+        void Set(uint32_t i, quatf_t const& q) { w[i] = q.w; x[i] = q.x; y[i] = q.y; z[i] = q.z; }
+        mini::math::quatf_soa_t Soa() { return { w.data(), x.data(), y.data(), z.data() }; }
+        mini::math::quatf_soa_const_t Soa() const { return { w.data(), x.data(), y.data(), z.data() }; }
+    };
+
+    // two keys per bone, a few degrees to ~60 degrees apart like neighbouring keys of a clip, stored with either sign
+    struct Keys
+    {
+        QuatStreams a, b;
+        std::vector<float> t;
+        std::vector<float> tx, ty, tz;
+
+        explicit Keys(uint32_t count) : a(count), b(count), t(count), tx(count), ty(count), tz(count) {}
+    };
+
+    quatf_t RandomRotation(std::mt19937& rng)
+    {
+        std::normal_distribution<float> normal;
+        quatf_t q(normal(rng), normal(rng), normal(rng), normal(rng));
+        return mini::math::normalize(q);
+    }
+
+    Keys MakeKeys(uint32_t count, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        Keys keys(count);
+        for (auto i = 0u; i < count; ++i) {
+            auto const a = RandomRotation(rng);
+            auto const axis = mini::math::vec3f_t(unit(rng) - 0.5f, unit(rng) - 0.5f, unit(rng) - 0.5f + 0.01f);
+            auto b = a * mini::math::angle_axis(axis, unit(rng) * 1.0f);
+            b = unit(rng) < 0.5f ? quatf_t(-b.w, -b.x, -b.y, -b.z) : b;
+            keys.a.Set(i, a);
+            keys.b.Set(i, b);
+            keys.t[i] = unit(rng);
+            keys.tx[i] = (unit(rng) - 0.5f) * 20.0f;
+            keys.ty[i] = (unit(rng) - 0.5f) * 20.0f;
+            keys.tz[i] = (unit(rng) - 0.5f) * 20.0f;
+        }
+        return keys;
+    }
+
+    bool CloseQuat(quatf_t const& value, quatf_t const& expected, float tolerance)
+    {
+        bool ok = true;
+        for (auto k = 0; k < 4; ++k) { ok &= fabsf(value.elements[k] - expected.elements[k]) <= tolerance; }
+        return ok;
+    }
+
+    // the rotation angle between two unit quaternions, 2 atan(|a - b| / |a + b|) in double with b on a's side
+    double AngleBetween(quatf_t const& a, quatf_t const& b)
+    {
+        auto const d = static_cast<double>(a.w) * b.w + static_cast<double>(a.x) * b.x + static_cast<double>(a.y) * b.y + static_cast<double>(a.z) * b.z;
+        auto const sign = d < 0.0 ? -1.0 : 1.0;
+        double diff = 0.0, sum = 0.0;
+        for (auto k = 0; k < 4; ++k) {
+            auto const c = sign * b.elements[k];
+            diff += (a.elements[k] - c) * (a.elements[k] - c);
+            sum += (a.elements[k] + c) * (a.elements[k] + c);
+        }
+        return 2.0 * atan2(sqrt(diff), sqrt(sum));
+    }
+}
+
+int mini::bench::RunQuatAnimBenchmark(Options const& options)
+{
+    std::mt19937 rng(0xa41e);
+    bool ok = true;
+
+    // @note    a few hundred skinned characters of 64 bones is thousands of bones per frame. 4099 stays in L1 / L2, the larger
+    //          count doesn't. odd counts exercise the scalar tails
+    auto const baseCount = 4096u * options.scale;
+    if (options.csv) {
+        printf("benchmark,function,count,per_element_ns,batch_ns,speedup\n");
+    }
+    else {
+        printf("%-20s %8s %16s %10s %8s\n", "function", "count", "per element ns", "batch ns", "speedup");
+    }
+    for (auto const count : { 4099u, baseCount * 16 + 3 }) {
+        auto const keys = MakeKeys(count, rng);
+        auto const numRuns = std::max(1u, 4096u * 64u / count) * options.scale;
+        QuatStreams out(count), expected(count);
+        std::vector<dualquatf_t> palette(count), expectedPalette(count);
+
+        auto const Report = [&](char const* function, double perElementNs, double batchNs) {
+            if (options.csv) {
+                printf("quatanim,%s,%u,%.3f,%.3f,%.2f\n", function, count, perElementNs, batchNs, perElementNs / batchNs);
+            }
+            else {
+                printf("%-20s %8u %16.3f %10.3f %7.2fx\n", function, count, perElementNs, batchNs, perElementNs / batchNs);
+            }
+        };
+
+        // @note    the batch kernels evaluate the scalar expressions, but fast_rsqrt's estimate and FMA contraction may differ
+        //          between the vector lanes and the scalar calls, hence a tolerance instead of bit equality
+        auto const Interpolate = [&](char const* function, bool spherical, bool perBoneT) {
+            auto const PerElement = [&]() {
+                for (auto i = 0u; i < count; ++i) {
+                    auto const t = perBoneT ? keys.t[i] : 0.3f;
+                    expected.Set(i, spherical ? math::slerp(keys.a.Get(i), keys.b.Get(i), t) : math::nlerp(keys.a.Get(i), keys.b.Get(i), t));
+                }
+                DoNotOptimize(expected.w[0]);
+            };
+            auto const Batch = [&]() {
+                if (spherical) {
+                    perBoneT ? math::slerp_batch(keys.a.Soa(), keys.b.Soa(), keys.t.data(), out.Soa(), count) : math::slerp_batch(keys.a.Soa(), keys.b.Soa(), 0.3f, out.Soa(), count);
+                }
+                else {
+                    perBoneT ? math::nlerp_batch(keys.a.Soa(), keys.b.Soa(), keys.t.data(), out.Soa(), count) : math::nlerp_batch(keys.a.Soa(), keys.b.Soa(), 0.3f, out.Soa(), count);
+                }
+                DoNotOptimize(out.w[0]);
+            };
+            auto const perElementNs = MeasureNsPerElement(count, numRuns, PerElement);
+            auto const batchNs = MeasureNsPerElement(count, numRuns, Batch);
+            for (auto i = 0u; i < count; ++i) { ok &= CloseQuat(out.Get(i), expected.Get(i), 1e-6f); }
+            Report(function, perElementNs, batchNs);
+        };
+        Interpolate("nlerp", false, false);
+        Interpolate("nlerp (t per bone)", false, true);
+        Interpolate("slerp", true, false);
+        Interpolate("slerp (t per bone)", true, true);
+
+        {   // fast_normalize, e.g. after blending several clips' rotations
+            QuatStreams scaled(count);
+            for (auto i = 0u; i < count; ++i) {
+                auto const q = keys.a.Get(i);
+                auto const s = 0.5f + keys.t[i];
+                scaled.Set(i, quatf_t(q.w * s, q.x * s, q.y * s, q.z * s));
+            }
+            auto const PerElement = [&]() {
+                for (auto i = 0u; i < count; ++i) { expected.Set(i, math::fast_normalize(scaled.Get(i))); }
+                DoNotOptimize(expected.w[0]);
+            };
+            auto const Batch = [&]() { math::fast_normalize_batch(scaled.Soa(), out.Soa(), count); DoNotOptimize(out.w[0]); };
+            auto const perElementNs = MeasureNsPerElement(count, numRuns, PerElement);
+            auto const batchNs = MeasureNsPerElement(count, numRuns, Batch);
+            for (auto i = 0u; i < count; ++i) { ok &= CloseQuat(out.Get(i), expected.Get(i), 1e-6f) && CloseQuat(out.Get(i), math::normalize(scaled.Get(i)), 1e-6f); }
+            Report("fast_normalize", perElementNs, batchNs);
+
+            // @note in place
+            math::fast_normalize_batch(scaled.Soa(), scaled.Soa(), count);
+            ok &= scaled.w == out.w && scaled.x == out.x && scaled.y == out.y && scaled.z == out.z;
+        }
+        {   // the skinning palette from the posed bones
+            math::vec3f_soa_const_t const translations(keys.tx.data(), keys.ty.data(), keys.tz.data());
+            auto const PerElement = [&]() {
+                for (auto i = 0u; i < count; ++i) { expectedPalette[i] = math::make_dualquat(keys.a.Get(i), vec3f_t(keys.tx[i], keys.ty[i], keys.tz[i])); }
+                DoNotOptimize(expectedPalette[0]);
+            };
+            auto const Batch = [&]() { math::make_dualquat_batch(keys.a.Soa(), translations, palette.data(), count); DoNotOptimize(palette[0]); };
+            auto const perElementNs = MeasureNsPerElement(count, numRuns, PerElement);
+            auto const batchNs = MeasureNsPerElement(count, numRuns, Batch);
+            for (auto i = 0u; i < count; ++i) { ok &= CloseQuat(palette[i].real, expectedPalette[i].real, 0.0f) && CloseQuat(palette[i].dual, expectedPalette[i].dual, 1e-5f); }
+            Report("make_dualquat", perElementNs, batchNs);
+        }
+    }
+
+    {   // skinning a vertex with 4 influences: dual quaternion blend against the linear blend of the matrices it replaces
+        auto const numBones = 256u;
+        auto const numVertices = 4096u * options.scale;
+        auto const numRuns = 64u;
+        std::vector<dualquatf_t> palette(numBones);
+        std::vector<math::mat3x4f_t> matrices(numBones);
+        for (auto i = 0u; i < numBones; ++i) {
+            std::uniform_real_distribution<float> unit(-10.0f, 10.0f);
+            palette[i] = math::make_dualquat(RandomRotation(rng), vec3f_t(unit(rng), unit(rng), unit(rng)));
+            matrices[i] = math::dualquat_to_mat(palette[i]);
+        }
+        struct Vertex { vec3f_t position; uint32_t bones[4]; float weights[4]; };
+        std::vector<Vertex> vertices(numVertices);
+        std::uniform_int_distribution<uint32_t> bone(0, numBones - 1);
+        std::uniform_real_distribution<float> weight(0.05f, 1.0f), coordinate(-1.0f, 1.0f);
+        for (auto& v : vertices) {
+            v.position = vec3f_t(coordinate(rng), coordinate(rng), coordinate(rng));
+            auto sum = 0.0f;
+            for (auto k = 0; k < 4; ++k) { v.bones[k] = bone(rng); v.weights[k] = weight(rng); sum += v.weights[k]; }
+            for (auto& w : v.weights) { w /= sum; }
+        }
+        std::vector<vec3f_t> skinned(numVertices);
+
+        auto const linearNs = MeasureNsPerElement(numVertices, numRuns, [&]() {
+            for (auto i = 0u; i < numVertices; ++i) {
+                auto const& v = vertices[i];
+                math::mat3x4f_t m;
+                for (auto e = 0; e < 12; ++e) {
+                    m.elements[e] = matrices[v.bones[0]].elements[e] * v.weights[0] + matrices[v.bones[1]].elements[e] * v.weights[1]
+                        + matrices[v.bones[2]].elements[e] * v.weights[2] + matrices[v.bones[3]].elements[e] * v.weights[3];
+                }
+                skinned[i] = math::transform_pos(m, v.position);
+            }
+            DoNotOptimize(skinned[0]);
+        });
+        auto const dualQuatNs = MeasureNsPerElement(numVertices, numRuns, [&]() {
+            for (auto i = 0u; i < numVertices; ++i) {
+                auto const& v = vertices[i];
+                dualquatf_t const influences[4] = { palette[v.bones[0]], palette[v.bones[1]], palette[v.bones[2]], palette[v.bones[3]] };
+                skinned[i] = math::transform_pos(math::dualquat_blend(influences, v.weights, 4), v.position);
+            }
+            DoNotOptimize(skinned[0]);
+        });
+        if (options.csv) {
+            printf("benchmark,function,count,linear_blend_ns,dualquat_blend_ns\n");
+            printf("quatanim_skinning,4_influences,%u,%.3f,%.3f\n", numVertices, linearNs, dualQuatNs);
+        }
+        else {
+            printf("%-20s %8s %16s %10s\n", "skinning", "vertices", "linear blend ns", "dualquat ns");
+            printf("%-20s %8u %16.3f %10.3f\n", "4 influences", numVertices, linearNs, dualQuatNs);
+        }
+    }
+
+    {   // slerp: constant angular speed, the shortest way and the ends
+        auto const keys = MakeKeys(1024, rng);
+        for (auto i = 0u; i < 1024; ++i) {
+            auto const a = keys.a.Get(i), b = keys.b.Get(i);
+            auto const flipped = quatf_t(-b.w, -b.x, -b.y, -b.z);
+            auto const angle = AngleBetween(a, b);
+            ok &= angle <= 1.0 + 1e-5;      // b is at most 1 rad from a whichever sign it was stored with
+            for (auto step = 0; step <= 8; ++step) {
+                auto const t = step / 8.0f;
+                auto const q = math::slerp(a, b, t);
+                ok &= fabs(AngleBetween(a, q) - t * angle) <= 2e-6 && fabs(AngleBetween(q, b) - (1.0 - t) * angle) <= 2e-6;
+                ok &= fabsf(math::length(math::vec4f_t(q.w, q.x, q.y, q.z)) - 1.0f) <= 1e-6f;
+                auto const same = math::slerp(a, flipped, t);
+                ok &= memcmp(same.elements, q.elements, sizeof(q.elements)) == 0;
+                auto const n = math::nlerp(a, b, t), sameN = math::nlerp(a, flipped, t);
+                ok &= memcmp(n.elements, sameN.elements, sizeof(n.elements)) == 0;
+                // nlerp is on the same great circle, only faster in the middle
+                ok &= AngleBetween(a, n) <= angle + 1e-5 && AngleBetween(n, b) <= angle + 1e-5;
+            }
+            auto const sign = math::dot(math::vec4f_t(a.w, a.x, a.y, a.z), math::vec4f_t(b.w, b.x, b.y, b.z)) < 0.0f ? -1.0f : 1.0f;
+            ok &= CloseQuat(math::slerp(a, b, 0.0f), a, 1e-6f);
+            ok &= CloseQuat(math::slerp(a, b, 1.0f), quatf_t(b.w * sign, b.x * sign, b.y * sign, b.z * sign), 1e-6f);
+            ok &= CloseQuat(math::slerp(a, a, 0.5f), a, 1e-6f);     // no angle to divide by
+        }
+    }
+
+    {   // dual quaternions against the matrices
+        std::uniform_real_distribution<float> unit(-10.0f, 10.0f);
+        for (auto i = 0u; i < 1024; ++i) {
+            auto const r = RandomRotation(rng);
+            auto const t = vec3f_t(unit(rng), unit(rng), unit(rng));
+            auto const p = vec3f_t(unit(rng), unit(rng), unit(rng));
+            auto const dq = math::make_dualquat(r, t);
+            auto const m = math::make_affine(t, r, vec3f_t(1.0f));
+            auto const tolerance = 1e-5f * (1.0f + math::length(t) + math::length(p));
+
+            ok &= math::distance(math::transform_pos(dq, p), math::transform_pos(m, p)) <= tolerance;
+            ok &= math::distance(math::transform_dir(dq, p), math::transform_dir(m, p)) <= tolerance;
+            ok &= math::distance(math::dualquat_translation(dq), t) <= tolerance;
+
+            // round trip through the matrix, either sign
+            auto const back = math::dualquat_to_mat(math::dualquat_from_mat(m));
+            for (auto e = 0; e < 12; ++e) { ok &= fabsf(back.elements[e] - m.elements[e]) <= tolerance; }
+            auto const fromMat = math::dualquat_from_mat(m);
+            auto const sign = fromMat.real.w * dq.real.w + fromMat.real.x * dq.real.x + fromMat.real.y * dq.real.y + fromMat.real.z * dq.real.z < 0.0f ? -1.0f : 1.0f;
+            for (auto k = 0; k < 4; ++k) { ok &= fabsf(fromMat.real.elements[k] * sign - dq.real.elements[k]) <= 1e-6f && fabsf(fromMat.dual.elements[k] * sign - dq.dual.elements[k]) <= tolerance; }
+
+            // products apply rhs first, the inverse undoes
+            auto const other = math::make_dualquat(RandomRotation(rng), vec3f_t(unit(rng), unit(rng), unit(rng)));
+            ok &= math::distance(math::transform_pos(dq * other, p), math::transform_pos(dq, math::transform_pos(other, p))) <= 2.0f * tolerance;
+            ok &= math::distance(math::transform_pos(math::inverse(dq) * dq, p), p) <= 2.0f * tolerance;
+
+            // blending: a single influence and a bone stored with the other sign change nothing, the result stays unit
+            float const one = 1.0f;
+            auto const single = math::dualquat_blend(&dq, &one, 1);
+            ok &= CloseQuat(single.real, dq.real, 1e-6f) && CloseQuat(single.dual, dq.dual, tolerance);
+            dualquatf_t const pair[2] = { dq, dualquatf_t(quatf_t(-dq.real.w, -dq.real.x, -dq.real.y, -dq.real.z), quatf_t(-dq.dual.w, -dq.dual.x, -dq.dual.y, -dq.dual.z)) };
+            float const halves[2] = { 0.5f, 0.5f };
+            auto const antipodal = math::dualquat_blend(pair, halves, 2);
+            ok &= CloseQuat(antipodal.real, dq.real, 1e-6f) && CloseQuat(antipodal.dual, dq.dual, tolerance);
+
+            dualquatf_t const influences[3] = { dq, other, math::make_dualquat(math::nlerp(r, other.real, 0.5f), p) };
+            float const weights[3] = { 0.2f, 0.3f, 0.1f };     // @note don't add up to 1
+            auto const blended = math::dualquat_blend(influences, weights, 3);
+            auto const& br = blended.real;
+            auto const& bd = blended.dual;
+            ok &= fabsf(br.w * br.w + br.x * br.x + br.y * br.y + br.z * br.z - 1.0f) <= 1e-6f;
+            ok &= fabsf(br.w * bd.w + br.x * bd.x + br.y * bd.y + br.z * bd.z) <= 1e-6f * (1.0f + math::length(math::dualquat_translation(blended)));
+        }
+    }
+
+    {   // counts below one vector only take the tail, and nothing is touched for 0
+        auto const keys = MakeKeys(3, rng);
+        QuatStreams out(3);
+        math::slerp_batch(keys.a.Soa(), keys.b.Soa(), keys.t.data(), out.Soa(), 3);
+        for (auto i = 0u; i < 3; ++i) { ok &= memcmp(out.Get(i).elements, math::slerp(keys.a.Get(i), keys.b.Get(i), keys.t[i]).elements, sizeof(quatf_t)) == 0; }
+        math::nlerp_batch(keys.a.Soa(), keys.b.Soa(), 0.5f, { nullptr, nullptr, nullptr, nullptr }, 0);
+    }
+
+    if (!options.csv) {
+        printf("(backend %s)\n", math::GetSimdBackendName());
+        printf("quaternion animation checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+#include "Benchmark.h"
+#include "TestMeshes.h"
+
+#include <Runtime/Resources/ResourceManager.h>
+#include <Runtime/util.h>
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    using BenchResourceManager = mini::ResourceManager<16384>;
+
+    struct CorpusFile
+    {
+        std::string path;
+        uint64_t    size = 0;
+        bool        isLarge = false;
+    };
+
+    bool WriteGTMesh(char const* path, uint32_t numVertices, std::mt19937& rng)
+    {
+        return mini::bench::WriteFile(path, mini::bench::MakeGTMesh(mini::GTMeshVertexFormat::PositionNormalTangentTexcoord0, numVertices, true, rng));
+    }
+
+    bool WriteRandomBlob(char const* path, uint64_t size, std::mt19937& rng)
+    {
+        FILE* file = fopen(path, "wb");
+        if (file == nullptr) { return false; }
+        std::vector<uint32_t> data((size + 3) / 4);
+        for (auto& d : data) { d = rng(); }
+        fwrite(data.data(), 1, size, file);
+        fclose(file);
+        return true;
+    }
+
+    // many small files of mixed types plus a handful of very large meshes
+    bool GenerateCorpus(mini::bench::Options const& options, std::vector<CorpusFile>& outFiles)
+    {
+        std::string dir;
+        if (!mini::bench::MakeCorpusDirectory(options, "resources", &dir)) { return false; }
+
+        std::mt19937 rng(0x5eed);
+        auto const numSmall = 2000u * options.scale;
+        auto const numLarge = 3u;
+        auto const largeVertices = 600000u * options.scale;
+
+        for (auto i = 0u; i < numSmall; ++i) {
+            auto const bucket = rng() % 10;
+            char name[64];
+            bool ok = false;
+            if (bucket < 4) {
+                snprintf(name, sizeof(name), "/small_%05u.material", i);
+                ok = WriteRandomBlob((dir + name).c_str(), 512 + rng() % 3584, rng);
+            }
+            else if (bucket < 7) {
+                snprintf(name, sizeof(name), "/small_%05u.shader", i);
+                ok = WriteRandomBlob((dir + name).c_str(), 4096 + rng() % 28672, rng);
+            }
+            else if (bucket < 9) {
+                snprintf(name, sizeof(name), "/small_%05u.dds", i);
+                ok = WriteRandomBlob((dir + name).c_str(), 16384 + rng() % 245760, rng);
+            }
+            else {
+                snprintf(name, sizeof(name), "/small_%05u.gtmesh", i);
+                ok = WriteGTMesh((dir + name).c_str(), 500 + rng() % 4500, rng);
+            }
+            if (!ok) { return false; }
+            outFiles.push_back({ dir + name, 0, false });
+        }
+        for (auto i = 0u; i < numLarge; ++i) {
+            char name[64];
+            snprintf(name, sizeof(name), "/large_%02u.gtmesh", i);
+            if (!WriteGTMesh((dir + name).c_str(), largeVertices, rng)) { return false; }
+            outFiles.push_back({ dir + name, 0, true });
+        }
+
+        // @note load order is shuffled so large files are interleaved with small ones
+        std::shuffle(outFiles.begin(), outFiles.end(), rng);
+        std::error_code ec;
+        for (auto& file : outFiles) {
+            file.size = fs::file_size(file.path, ec);
+        }
+        return true;
+    }
+
+    // @note returns false if the platform has no way for us to drop cached file pages
+    bool EvictFromPageCache(char const* path)
+    {
+#if defined(__linux__)
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) { return false; }
+        fdatasync(fd);
+        auto const res = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+        return res == 0;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    struct LoaderPath
+    {
+        char const* name;
+        mini::ResourceLoadResult(*load)(BenchResourceManager&, char const*, mini::ResourceID);
+    };
+
+    // @todo add async and mapped paths here once ResourceManager supports them
+    LoaderPath const g_loaderPaths[] = {
+        { "sync", [](BenchResourceManager& manager, char const* path, mini::ResourceID id) { return manager.LoadResource(path, id); } },
+    };
+
+    struct RunResult
+    {
+        uint64_t            bytes = 0;
+        uint32_t            assets = 0;
+        uint32_t            failures = 0;
+        double              seconds = 0.0;
+        std::vector<double> latencies;  // in microseconds
+    };
+
+    RunResult LoadCorpus(BenchResourceManager& manager, LoaderPath const& loader, std::vector<CorpusFile> const& files)
+    {
+        RunResult result;
+        result.latencies.reserve(files.size());
+        manager.UnloadAll();
+
+        mini::Timer total;
+        uint32_t nextId = 1;
+        for (auto const& file : files) {
+            mini::Timer timer;
+            auto const res = loader.load(manager, file.path.c_str(), { nextId++ });
+            result.latencies.push_back(timer.GetElapsedTime() * 1e6);
+            if (res != mini::ResourceLoadResult::Success) {
+                result.failures++;
+                continue;
+            }
+            result.bytes += file.size;
+            result.assets++;
+        }
+        result.seconds = total.GetElapsedTime();
+        manager.UnloadAll();
+        return result;
+    }
+
+    void Report(mini::bench::Options const& options, char const* scenario, char const* path, RunResult const& result)
+    {
+        auto const stats = mini::bench::ComputeLatencyStats(result.latencies);
+        auto const mb = static_cast<double>(result.bytes) / (1024.0 * 1024.0);
+        auto const mbPerSec = result.seconds > 0.0 ? mb / result.seconds : 0.0;
+        auto const assetsPerSec = result.seconds > 0.0 ? result.assets / result.seconds : 0.0;
+        if (options.csv) {
+            printf("resources,%s,%s,%u,%.3f,%.2f,%.1f,%.2f,%.2f,%u\n", scenario, path, result.assets, mb, mbPerSec, assetsPerSec, stats.p50, stats.p99, result.failures);
+        }
+        else {
+            printf("%-8s %-8s %8u %10.1f %10.1f %12.1f %10.2f %10.2f %8u\n", scenario, path, result.assets, mb, mbPerSec, assetsPerSec, stats.p50, stats.p99, result.failures);
+        }
+    }
+}
+
+int mini::bench::RunResourceLoadBenchmark(Options const& options)
+{
+    std::vector<CorpusFile> files;
+    if (!GenerateCorpus(options, files)) {
+        printf("Failed to generate resource corpus\n");
+        return 1;
+    }
+    if (files.size() > 16384) {
+        files.resize(16384);
+    }
+
+    uint64_t corpusBytes = 0;
+    for (auto const& file : files) { corpusBytes += file.size; }
+    if (options.csv) {
+        printf("benchmark,scenario,path,assets,mb,mb_per_sec,assets_per_sec,p50_us,p99_us,failures\n");
+    }
+    else {
+        printf("corpus: %zu files, %.1f MB\n", files.size(), static_cast<double>(corpusBytes) / (1024.0 * 1024.0));
+        printf("%-8s %-8s %8s %10s %10s %12s %10s %10s %8s\n", "cache", "path", "assets", "MB", "MB/s", "assets/s", "p50 us", "p99 us", "failed");
+    }
+
+    auto manager = new BenchResourceManager;
+    for (auto const& loader : g_loaderPaths) {
+        {   // cold cache: drop file pages before the run so every read hits the storage device
+            bool evicted = true;
+            for (auto const& file : files) {
+                evicted &= EvictFromPageCache(file.path.c_str());
+            }
+            if (evicted) {
+                Report(options, "cold", loader.name, LoadCorpus(*manager, loader, files));
+            }
+            else if (!options.csv) {
+                printf("%-8s %-8s (page cache eviction not supported on this platform)\n", "cold", loader.name);
+            }
+        }
+        {   // warm cache: prime the page cache with one untimed pass
+            LoadCorpus(*manager, loader, files);
+            Report(options, "warm", loader.name, LoadCorpus(*manager, loader, files));
+        }
+    }
+    delete manager;
+    return 0;
+}
@@ -0,0 +1,162 @@
+#include "Benchmark.h"
+
+#include <Runtime/Memory/RingAllocator.h>
+#include <Runtime/util.h>
+
+#include <deque>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    struct StagedRange
+    {
+        uint32_t offset     = 0;
+        uint32_t size       = 0;
+        uint8_t  pattern    = 0;
+    };
+
+    // stands in for the copy queue: every submission completes a fixed number of submissions later
+    struct SimulatedCopyQueue
+    {
+        struct Submission { uint64_t fenceValue; std::vector<StagedRange> ranges; };
+
+        std::deque<Submission>  inFlight;
+        uint64_t                lastSubmitted = 0;
+        uint64_t                completed = 0;
+        uint32_t                latency = 3;
+
+        uint64_t Submit(std::vector<StagedRange>& ranges)
+        {
+            inFlight.push_back({ ++lastSubmitted, std::move(ranges) });
+            ranges.clear();
+            return lastSubmitted;
+        }
+
+        // the "GPU" reads staged data when a submission completes, anything overwritten before then was reclaimed too early
+        bool Advance(std::vector<uint8_t> const& staging, bool drain)
+        {
+            bool ok = true;
+            while (!inFlight.empty() && (drain || inFlight.front().fenceValue + latency <= lastSubmitted)) {
+                for (auto const& r : inFlight.front().ranges) {
+                    for (auto i = 0u; i < r.size; i += 37) {
+                        ok &= staging[r.offset + i] == r.pattern;
+                    }
+                }
+                completed = inFlight.front().fenceValue;
+                inFlight.pop_front();
+            }
+            return ok;
+        }
+    };
+
+    bool Overlaps(std::deque<SimulatedCopyQueue::Submission> const& inFlight, std::vector<StagedRange> const& open, StagedRange const& r)
+    {
+        auto const overlaps = [&](StagedRange const& o) { return r.offset < o.offset + o.size && o.offset < r.offset + r.size; };
+        for (auto const& s : inFlight) {
+            for (auto const& o : s.ranges) { if (overlaps(o)) { return true; } }
+        }
+        for (auto const& o : open) { if (overlaps(o)) { return true; } }
+        return false;
+    }
+}
+
+int mini::bench::RunRingAllocatorBenchmark(Options const& options)
+{
+    uint32_t const ringSize = 16 * 1024 * 1024;
+    std::mt19937 rng(0x5a9e);
+    bool ok = true;
+
+    {   // basic wrap around and reclamation rules
+        mini::RingAllocator ring;
+        ring.Initialize(1024);
+        ok &= ring.Allocate(512, 16) == 0;
+        ok &= ring.Allocate(256, 16) == 512;
+        ring.CloseBatch(1);
+        ok &= ring.Allocate(512, 16) == mini::RingAllocator::NO_SPACE;     // only 256 left at the end, nothing at the start
+        ok &= ring.Reclaim(0) == 0;
+        ok &= ring.Reclaim(1) == 768 && ring.GetUsed() == 0;
+        ok &= ring.Allocate(1024, 16) == 0;                                 // empty ring starts over
+        ring.CloseBatch(2);
+        ok &= ring.Allocate(16, 16) == mini::RingAllocator::NO_SPACE;       // full
+        ring.Reclaim(2);
+        ok &= ring.Allocate(600, 16) == 0 && ring.Allocate(300, 16) == 608;
+        ring.CloseBatch(3);
+        ok &= ring.Allocate(200, 16) == mini::RingAllocator::NO_SPACE;     // 116 left at the end, tail is at 0
+        ring.Reclaim(3);
+        ok &= ring.GetUsed() == 0 && ring.GetNumPendingBatches() == 0;
+    }
+
+    // staging uploads with random mesh sized chunks, batches submitted to a simulated copy queue with a few submissions of latency
+    mini::RingAllocator ring;
+    ring.Initialize(ringSize);
+    std::vector<uint8_t> staging(ringSize);
+    SimulatedCopyQueue queue;
+    std::vector<StagedRange> open;
+
+    uint32_t const numUploads = 20000 * options.scale;
+    uint64_t bytesStaged = 0;
+    uint32_t numStalls = 0;
+    bool noOverlap = true;
+    mini::Timer timer;
+    for (auto i = 0u; i < numUploads; ++i) {
+        StagedRange r;
+        r.size = 64 + rng() % (rng() % 8 == 0 ? 2 * 1024 * 1024 : 64 * 1024);
+        r.pattern = static_cast<uint8_t>(rng());
+
+        ring.Reclaim(queue.completed);
+        r.offset = ring.Allocate(r.size, 16);
+        if (r.offset == mini::RingAllocator::NO_SPACE) {
+            // what MeshLibrary does when the ring is full: submit, wait for the copy queue, retry
+            ring.CloseBatch(queue.Submit(open));
+            ok &= queue.Advance(staging, true);
+            ring.Reclaim(queue.completed);
+            r.offset = ring.Allocate(r.size, 16);
+            numStalls++;
+        }
+        if (i % 64 == 0) {  // @note occasional validation only, it's quadratic in the number of live ranges
+            noOverlap &= !Overlaps(queue.inFlight, open, r);
+        }
+        memset(staging.data() + r.offset, r.pattern, r.size);
+        open.push_back(r);
+        bytesStaged += r.size;
+
+        if (open.size() == 32) {    // @note a batch per loaded "level chunk"
+            ring.CloseBatch(queue.Submit(open));
+            ok &= queue.Advance(staging, false);
+        }
+    }
+    ring.CloseBatch(queue.Submit(open));
+    ok &= queue.Advance(staging, true);
+    ring.Reclaim(queue.completed);
+    auto const elapsed = timer.GetElapsedTime();
+    ok &= noOverlap && ring.GetUsed() == 0 && ring.GetNumPendingBatches() == 0;
+
+    // raw allocator cost without the memset
+    ring.Reset();
+    uint32_t const numOps = 1000000;
+    uint64_t fence = 0;
+    timer = mini::Timer();
+    for (auto i = 0u; i < numOps; ++i) {
+        auto offset = ring.Allocate(256 + (i & 1023), 16);
+        if (offset == mini::RingAllocator::NO_SPACE) {
+            ring.Reclaim(fence);
+            offset = ring.Allocate(256 + (i & 1023), 16);
+        }
+        DoNotOptimize(offset);
+        if ((i & 63) == 63) { ring.CloseBatch(++fence); }
+    }
+    auto const nsPerAlloc = timer.GetElapsedTime() * 1e9 / numOps;
+
+    if (options.csv) {
+        printf("ring_allocator,staging,%u,%.1f,%u,%.2f\n", numUploads, bytesStaged / (1024.0 * 1024.0) / elapsed, numStalls, nsPerAlloc);
+    }
+    else {
+        printf("reclamation checks: %s\n", ok ? "ok" : "FAILED");
+        printf("staged %u uploads, %.1f MB at %.1f MB/s through a %u MB ring, %u full-ring stalls\n", numUploads,
+            bytesStaged / (1024.0 * 1024.0), bytesStaged / (1024.0 * 1024.0) / elapsed, ringSize / (1024 * 1024), numStalls);
+        printf("allocate: %.2f ns per op\n", nsPerAlloc);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,136 @@
+#include "Benchmark.h"
+
+#include <Runtime/Containers/SlotMap.h>
+#include <Runtime/AssetLibraries/RenderResourceHandles.h>
+#include <Runtime/util.h>
+
+#include <random>
+#include <vector>
+
+namespace
+{
+    // @note same footprint as the hot / cold parts of a MeshLibrary pool entry
+    struct HotData { uint64_t views[2] = {}; uint32_t counts[2] = {}; };
+    struct ColdData { uint32_t resourceId = 0; void* resources[2] = {}; };
+
+    using BenchSlotMap = mini::SlotMap<mini::MeshResourceHandle, HotData, ColdData>;
+
+    // the pool layout MeshLibrary used before, kept around as a baseline
+    struct LinearScanPool
+    {
+        struct Element { HotData hot; bool isUsed = false; ColdData cold; };
+        std::vector<Element> elements;
+
+        uint32_t Allocate()
+        {
+            for (auto i = 0u; i < elements.size(); ++i) {
+                if (!elements[i].isUsed) { elements[i].isUsed = true; return i; }
+            }
+            return 0;
+        }
+        void Free(uint32_t index) { elements[index].isUsed = false; }
+    };
+
+    // @note verifies that handles to freed slots are rejected, even after their slot has been reused
+    bool CheckStaleHandles()
+    {
+        BenchSlotMap map;
+        map.Initialize(4);
+        bool ok = true;
+
+        auto const a = map.Allocate();
+        map.LookupHot(a)->counts[0] = 42;
+        ok &= map.Free(a);
+        ok &= !map.IsValid(a) && map.LookupHot(a) == nullptr && map.LookupCold(a) == nullptr;
+        ok &= !map.Free(a);    // double free is rejected
+
+        // cycle through the free list until slot a is handed out again
+        std::vector<mini::MeshResourceHandle> handles;
+        mini::MeshResourceHandle reused;
+        for (auto i = 0; i < 4; ++i) {
+            handles.push_back(map.Allocate());
+            if (BenchSlotMap::GetIndex(handles.back()) == BenchSlotMap::GetIndex(a)) { reused = handles.back(); }
+        }
+        ok &= BenchSlotMap::GetIndex(reused) == BenchSlotMap::GetIndex(a) && reused.handle != a.handle;
+        ok &= map.IsValid(reused) && !map.IsValid(a);
+        ok &= map.LookupHot(reused)->counts[0] == 0;    // freed slots come back default initialized
+        ok &= map.Allocate().handle == mini::SlotMapHandleLayout::INVALID_HANDLE;   // map is full
+        return ok;
+    }
+}
+
+int mini::bench::RunSlotMapBenchmark(Options const& options)
+{
+    auto const staleOk = CheckStaleHandles();
+    if (!options.csv) {
+        printf("stale handle detection: %s\n", staleOk ? "ok" : "FAILED");
+        printf("%-12s %10s %14s %14s %14s\n", "pool", "occupancy", "alloc ns/op", "free ns/op", "lookup ns/op");
+    }
+
+    uint32_t const occupancies[] = { 1000, 10000, 100000 };
+    uint32_t const numChurnOps = 100000;
+    std::mt19937 rng(0x5107);
+
+    for (auto const occupancy : occupancies) {
+        auto const capacity = occupancy + numChurnOps;
+        {
+            BenchSlotMap map;
+            map.Initialize(capacity);
+            std::vector<mini::MeshResourceHandle> live;
+            live.reserve(capacity);
+            for (auto i = 0u; i < occupancy; ++i) { live.push_back(map.Allocate()); }
+            // free random entries so the free list isn't just the untouched tail of the pool
+            std::vector<mini::MeshResourceHandle> freed;
+            for (auto i = 0u; i < numChurnOps && !live.empty(); ++i) {
+                auto const idx = rng() % live.size();
+                freed.push_back(live[idx]);
+                live[idx] = live.back();
+                live.pop_back();
+            }
+            auto const freeNs = MeasureNsPerElement(static_cast<uint32_t>(freed.size()), 1, [&] {
+                for (auto h : freed) { map.Free(h); }
+            });
+            auto const allocNs = MeasureNsPerElement(occupancy, 1, [&] {
+                for (auto i = 0u; i < occupancy; ++i) { live.push_back(map.Allocate()); }
+            });
+            uint64_t sum = 0;
+            auto const lookupNs = MeasureNsPerElement(static_cast<uint32_t>(live.size()), 1, [&] {
+                for (auto h : live) { sum += map.LookupHot(h)->counts[0]; }
+            });
+            DoNotOptimize(sum);
+            if (options.csv) {
+                printf("slotmap,slotmap,%u,%.2f,%.2f,%.2f\n", occupancy, allocNs, freeNs, lookupNs);
+            }
+            else {
+                printf("%-12s %10u %14.2f %14.2f %14.2f\n", "slotmap", occupancy, allocNs, freeNs, lookupNs);
+            }
+        }
+        {
+            LinearScanPool pool;
+            pool.elements.resize(capacity);
+            std::vector<uint32_t> live;
+            for (auto i = 0u; i < occupancy; ++i) { live.push_back(pool.Allocate()); }
+            std::vector<uint32_t> freed;
+            auto const numFreed = occupancy < 1000 ? occupancy : 1000u;   // @note linear scan is too slow to churn the full set
+            for (auto i = 0u; i < numFreed; ++i) {
+                auto const idx = rng() % live.size();
+                freed.push_back(live[idx]);
+                live[idx] = live.back();
+                live.pop_back();
+            }
+            auto const freeNs = MeasureNsPerElement(numFreed, 1, [&] {
+                for (auto i : freed) { pool.Free(i); }
+            });
+            auto const allocNs = MeasureNsPerElement(numFreed, 1, [&] {
+                for (auto i = 0u; i < numFreed; ++i) { live.push_back(pool.Allocate()); }
+            });
+            if (options.csv) {
+                printf("slotmap,linear_scan,%u,%.2f,%.2f,\n", occupancy, allocNs, freeNs);
+            }
+            else {
+                printf("%-12s %10u %14.2f %14.2f %14s\n", "linear scan", occupancy, allocNs, freeNs, "-");
+            }
+        }
+    }
+    return staleOk ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+#include "Benchmark.h"
+
+#include <Runtime/MeshProcessing/MeshOptimizer.h>
+#include <Runtime/MeshProcessing/StaticBatchBuilder.h>
+#include <Runtime/Culling/MeshBounds.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    struct PropMesh
+    {
+        std::vector<float>      vertices;   // @note VertexFormat::PositionNormal
+        std::vector<uint16_t>   indices;
+        mini::MeshBounds        bounds;
+        mini::MeshData          data;
+    };
+
+    // low poly ellipsoid, the shape doesn't matter, only that props differ in size and vertex count
+    void MakeProp(uint32_t stacks, uint32_t slices, float const radii[3], PropMesh* outMesh)
+    {
+        for (auto i = 0u; i <= stacks; ++i) {
+            for (auto j = 0u; j <= slices; ++j) {
+                auto const theta = 3.14159265f * i / stacks;
+                auto const phi = 2.0f * 3.14159265f * j / slices;
+                float const n[3] = { sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi) };
+                outMesh->vertices.insert(outMesh->vertices.end(), { n[0] * radii[0], n[1] * radii[1], n[2] * radii[2], n[0], n[1], n[2] });
+            }
+        }
+        for (auto i = 0u; i < stacks; ++i) {
+            for (auto j = 0u; j < slices; ++j) {
+                auto const a = static_cast<uint16_t>(i * (slices + 1) + j);
+                auto const b = static_cast<uint16_t>(a + slices + 1);
+                outMesh->indices.insert(outMesh->indices.end(), { a, static_cast<uint16_t>(a + 1), b, static_cast<uint16_t>(a + 1), static_cast<uint16_t>(b + 1), b });
+            }
+        }
+        auto& data = outMesh->data;
+        data.vertexData = reinterpret_cast<char*>(outMesh->vertices.data());
+        data.vertexDataSize = static_cast<uint32_t>(outMesh->vertices.size() * sizeof(float));
+        data.vertexStride = mini::GetVertexFormatStride(mini::VertexFormat::PositionNormal);
+        data.indexData = reinterpret_cast<char*>(outMesh->indices.data());
+        data.indexDataSize = static_cast<uint32_t>(outMesh->indices.size() * sizeof(uint16_t));
+        data.indexFormat = mini::IndexFormat::R16_UINT;
+        outMesh->bounds = mini::ComputeMeshBounds(data.vertexData, data.vertexDataSize / data.vertexStride, data.vertexStride);
+        data.bounds = &outMesh->bounds;
+    }
+
+    void TransformPoint(mini::StaticBatchSource const& source, float const* p, float* out)
+    {
+        auto const q = source.rotation;
+        float const v[3] = { p[0] * source.scale, p[1] * source.scale, p[2] * source.scale };
+        float const t[3] = { 2.0f * (q[1] * v[2] - q[2] * v[1]), 2.0f * (q[2] * v[0] - q[0] * v[2]), 2.0f * (q[0] * v[1] - q[1] * v[0]) };
+        out[0] = v[0] + q[3] * t[0] + q[1] * t[2] - q[2] * t[1] + source.position[0];
+        out[1] = v[1] + q[3] * t[1] + q[2] * t[0] - q[0] * t[2] + source.position[1];
+        out[2] = v[2] + q[3] * t[2] + q[0] * t[1] - q[1] * t[0] + source.position[2];
+    }
+
+    // every batch within the limits, every batched triangle maps back to its source and matches the source's transformed triangle
+    bool CheckBatches(std::vector<mini::StaticBatchSource> const& sources, eastl::vector<mini::StaticBatch> const& batches,
+        eastl::vector<uint32_t> const& unbatched, mini::StaticBatchSettings const& settings)
+    {
+        bool ok = true;
+        std::vector<uint32_t> seen(sources.size(), 0);
+        for (auto const index : unbatched) { seen[index]++; }
+        for (auto const& batch : batches) {
+            auto const extent = std::max(batch.bounds.aabbMax[0] - batch.bounds.aabbMin[0],
+                std::max(batch.bounds.aabbMax[1] - batch.bounds.aabbMin[1], batch.bounds.aabbMax[2] - batch.bounds.aabbMin[2]));
+            ok &= batch.sources.size() == 1 || (extent <= settings.maxClusterExtent && batch.numVertices <= settings.maxClusterVertices);
+            ok &= batch.indexFormat == (batch.numVertices <= 0xffff ? mini::IndexFormat::R16_UINT : mini::IndexFormat::R32_UINT);
+
+            std::vector<uint32_t> indices(batch.numIndices);
+            mini::MeshData data;
+            mini::GetStaticBatchMeshData(batch, &data);
+            mini::UnpackIndices(data, indices.data());
+            uint32_t expectedFirst = 0;
+            for (auto const& range : batch.sources) {
+                auto const& source = sources[range.sourceId];   // @note the benchmark uses source indices as ids
+                seen[range.sourceId]++;
+                ok &= range.firstIndex == expectedFirst && source.materialKey == batch.materialKey && source.data->vertexFormat == batch.vertexFormat;
+                ok &= range.numIndices == source.data->indexDataSize / sizeof(uint16_t);
+                expectedFirst += range.numIndices;
+
+                auto const sourceIndices = reinterpret_cast<uint16_t const*>(source.data->indexData);
+                auto const sourceVertices = reinterpret_cast<float const*>(source.data->vertexData);
+                for (auto i = 0u; i < range.numIndices; i += 3) {
+                    ok &= mini::FindStaticBatchSource(batch, (range.firstIndex + i) / 3) == range.sourceId;
+                    for (auto corner = 0u; corner < 3; ++corner) {
+                        float expected[3], actual[3];
+                        TransformPoint(source, sourceVertices + sourceIndices[i + corner] * 6, expected);
+                        memcpy(actual, batch.vertexData.data() + static_cast<size_t>(indices[range.firstIndex + i + corner]) * data.vertexStride, sizeof(actual));
+                        for (auto k = 0; k < 3; ++k) { ok &= fabsf(actual[k] - expected[k]) <= 1e-3f; }
+                    }
+                }
+            }
+            ok &= expectedFirst == batch.numIndices && mini::FindStaticBatchSource(batch, batch.numIndices / 3) == UINT32_MAX;
+        }
+        for (auto const count : seen) { ok &= count == 1; }
+        return ok;
+    }
+}
+
+int mini::bench::RunStaticBatchingBenchmark(Options const& options)
+{
+    std::mt19937 rng(0x57a7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    bool ok = true;
+
+    // @note    a prop heavy level: small props of a few kinds scattered over the ground, a handful of materials
+    uint32_t const numPropKinds = 12;
+    uint32_t const numMaterials = 4;
+    std::vector<PropMesh> props(numPropKinds);
+    for (auto i = 0u; i < numPropKinds; ++i) {
+        float const radii[3] = { 0.2f + unit(rng), 0.2f + unit(rng) * 1.5f, 0.2f + unit(rng) };
+        MakeProp(4 + i % 6, 6 + i, radii, &props[i]);
+    }
+    auto const levelSize = 512.0f * sqrtf(static_cast<float>(options.scale));
+    uint32_t const numSources = 50000 * options.scale;
+    std::vector<StaticBatchSource> sources(numSources);
+    for (auto i = 0u; i < numSources; ++i) {
+        auto& source = sources[i];
+        auto const kind = static_cast<uint32_t>(rng() % numPropKinds);
+        source.data = &props[kind].data;
+        source.position[0] = unit(rng) * levelSize;
+        source.position[2] = unit(rng) * levelSize;
+        auto const angle = unit(rng) * 6.2831853f;
+        source.rotation[1] = sinf(angle * 0.5f);
+        source.rotation[3] = cosf(angle * 0.5f);
+        source.scale = 0.5f + unit(rng);
+        source.materialKey = kind % numMaterials;
+        source.sourceId = i;
+    }
+
+    eastl::vector<StaticBatch> batches;
+    eastl::vector<uint32_t> unbatched;
+    {   // sources that can't be merged are handed back
+        auto quantized = props[0].data;
+        quantized.vertexFormat = VertexFormat::QuantizedPositionNormal;
+        std::vector<StaticBatchSource> rejected(3);
+        rejected[0].data = &props[numPropKinds - 1].data;
+        rejected[1].data = &quantized;
+        rejected[2].data = &props[1].data;
+        StaticBatchSettings settings;
+        settings.maxClusterVertices = 100;  // @note between the vertex counts of the first and the last kind
+        BuildStaticBatches(rejected.data(), 3, settings, &batches, &unbatched);
+        ok &= unbatched.size() == 2 && unbatched[0] == 0 && unbatched[1] == 1 && batches.size() == 1 && batches[0].sources.size() == 1;
+        batches.clear();
+        unbatched.clear();
+    }
+
+    if (options.csv) {
+        printf("benchmark,sources,max_extent,batches,draw_reduction,build_ms,triangles_per_object,draws_per_object,triangles_batched,draws_batched\n");
+    }
+    else {
+        printf("%8s %10s %8s %10s %10s %16s %16s %14s %14s\n", "sources", "max extent", "batches", "draw ratio", "build ms", "tris per object", "draws per object", "tris batched", "draws batched");
+    }
+    for (auto const maxExtent : { 16.0f, 32.0f, 64.0f, 128.0f }) {
+        StaticBatchSettings settings;
+        settings.maxClusterExtent = maxExtent;
+        batches.clear();
+        unbatched.clear();
+        Timer timer;
+        BuildStaticBatches(sources.data(), numSources, settings, &batches, &unbatched);
+        auto const buildMs = timer.GetElapsedTime() * 1000.0;
+        ok &= unbatched.empty() && CheckBatches(sources, batches, unbatched, settings);
+
+        // @note    triangles drawn from a few views standing in the level, per object culling against culling whole batches.
+        //          bigger batches mean fewer draws but more triangles outside the frustum
+        uint64_t objectTriangles = 0, objectDraws = 0, batchTriangles = 0, batchDraws = 0;
+        std::mt19937 viewRng(0x71e3);
+        for (auto v = 0; v < 32; ++v) {
+            float const position[3] = { unit(viewRng) * levelSize, 1.8f, unit(viewRng) * levelSize };
+            float const forward[3] = { unit(viewRng) - 0.5f, -0.1f, unit(viewRng) - 0.5f };
+            float const up[3] = { 0.0f, 1.0f, 0.0f };
+            auto const view = MakeCullingView(position, forward, up, 1.0f, 16.0f / 9.0f, 0.1f, 150.0f);
+            for (auto const& source : sources) {
+                auto const localView = TransformCullingView(view, source.position, source.rotation, source.scale);
+                auto const visible = IsMeshVisible(*source.data->bounds, localView);
+                objectTriangles += visible ? source.data->indexDataSize / sizeof(uint16_t) / 3 : 0;
+                objectDraws += visible ? 1 : 0;
+            }
+            for (auto const& batch : batches) {
+                auto const visible = IsMeshVisible(batch.bounds, view);
+                batchTriangles += visible ? batch.numIndices / 3 : 0;
+                batchDraws += visible ? 1 : 0;
+            }
+        }
+        auto const ratio = static_cast<double>(numSources) / static_cast<double>(batches.size());
+        if (options.csv) {
+            printf("staticbatch,%u,%.0f,%u,%.2f,%.2f,%llu,%llu,%llu,%llu\n", numSources, maxExtent, static_cast<uint32_t>(batches.size()), ratio, buildMs,
+                static_cast<unsigned long long>(objectTriangles / 32), static_cast<unsigned long long>(objectDraws / 32),
+                static_cast<unsigned long long>(batchTriangles / 32), static_cast<unsigned long long>(batchDraws / 32));
+        }
+        else {
+            printf("%8u %10.0f %8u %9.1fx %10.2f %16llu %16llu %14llu %14llu\n", numSources, maxExtent, static_cast<uint32_t>(batches.size()), ratio, buildMs,
+                static_cast<unsigned long long>(objectTriangles / 32), static_cast<unsigned long long>(objectDraws / 32),
+                static_cast<unsigned long long>(batchTriangles / 32), static_cast<unsigned long long>(batchDraws / 32));
+        }
+    }
+
+    if (!options.csv) {
+        printf("(triangles and draws are per view, averaged over 32 views)\n");
+        printf("static batching checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+#include "Benchmark.h"
+
+#include <Runtime/Renderables/StaticMeshBatching.h>
+#include <Runtime/util.h>
+
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::vector<mini::StaticMeshInstance> MakeInstances(uint32_t numInstances, uint32_t numMeshes, uint32_t numLods, std::mt19937& rng)
+    {
+        std::vector<mini::StaticMeshInstance> instances(numInstances);
+        for (auto i = 0u; i < numInstances; ++i) {
+            instances[i].resourceHandle.handle = 1 + static_cast<uint32_t>(rng() % numMeshes) * 7919;   // @note spread out like generational handles
+            instances[i].lod = static_cast<uint32_t>(rng() % numLods);
+            instances[i].meshIndex = i;
+        }
+        return instances;
+    }
+
+    // every instance in exactly one batch, batches homogeneous and unique, instances in their original order within a batch
+    bool CheckBatches(std::vector<mini::StaticMeshInstance> const& instances, std::vector<uint32_t> const& order, eastl::vector<mini::StaticMeshBatch> const& batches)
+    {
+        bool ok = true;
+        std::vector<uint32_t> seen(instances.size(), 0);
+        std::set<std::pair<uint32_t, uint32_t>> keys;
+        uint32_t expectedFirst = 0;
+        for (auto const& batch : batches) {
+            ok &= batch.firstInstance == expectedFirst && batch.numInstances > 0;
+            ok &= keys.insert({ batch.resourceHandle.handle, batch.lod }).second;
+            for (auto i = batch.firstInstance; i < batch.firstInstance + batch.numInstances && i < order.size(); ++i) {
+                auto const& instance = instances[order[i]];
+                ok &= instance.resourceHandle.handle == batch.resourceHandle.handle && instance.lod == batch.lod;
+                ok &= i == batch.firstInstance || order[i] > order[i - 1];
+                seen[order[i]]++;
+            }
+            expectedFirst += batch.numInstances;
+        }
+        ok &= expectedFirst == instances.size();
+        for (auto const count : seen) { ok &= count == 1; }
+
+        std::set<std::pair<uint32_t, uint32_t>> expectedKeys;
+        for (auto const& instance : instances) { expectedKeys.insert({ instance.resourceHandle.handle, instance.lod }); }
+        return ok && expectedKeys == keys;
+    }
+}
+
+int mini::bench::RunStaticMeshBatchingBenchmark(Options const& options)
+{
+    std::mt19937 rng(0x1257);
+    bool ok = true;
+
+    eastl::vector<StaticMeshBatch> batches;
+    {   // the demo scene: 9 meshes alternating between a cube and a sphere at a single LOD
+        std::vector<StaticMeshInstance> instances(9);
+        for (auto i = 0u; i < 9; ++i) {
+            instances[i].resourceHandle.handle = i % 2 == 0 ? 1u : 2u;
+            instances[i].meshIndex = i;
+        }
+        std::vector<uint32_t> order(instances.size());
+        BuildStaticMeshBatches(instances.data(), 9, order.data(), &batches);
+        ok &= CheckBatches(instances, order, batches) && batches.size() == 2;
+        if (!options.csv) {
+            printf("demo scene: %u draws without instancing, %u with\n", 9u, static_cast<uint32_t>(batches.size()));
+        }
+    }
+    {   // edge cases, nothing visible and the largest key values
+        BuildStaticMeshBatches(nullptr, 0, nullptr, &batches);
+        ok &= batches.empty();
+        std::vector<StaticMeshInstance> instances(2);
+        instances[0] = { { UINT32_MAX }, 255, MAX_BATCHED_MESH_INDEX };
+        instances[1] = { { UINT32_MAX }, 255, 0 };
+        std::vector<uint32_t> order(2);
+        BuildStaticMeshBatches(instances.data(), 2, order.data(), &batches);
+        ok &= batches.size() == 1 && batches[0].resourceHandle.handle == UINT32_MAX && batches[0].lod == 255 && order[0] == 0 && order[1] == MAX_BATCHED_MESH_INDEX;
+    }
+
+    if (options.csv) {
+        printf("benchmark,instances,meshes,lods,batches,draw_reduction,ns_per_instance\n");
+    }
+    else {
+        printf("%10s %8s %6s %10s %12s %14s\n", "instances", "meshes", "lods", "batches", "draw ratio", "ns/instance");
+    }
+    struct Scene
+    {
+        uint32_t numInstances;
+        uint32_t numMeshes;
+        uint32_t numLods;
+    };
+    Scene const scenes[] = {
+        { 1000, 4, 1 },
+        { 10000, 16, 4 },
+        { 100000 * options.scale, 64, 6 },
+        { 100000 * options.scale, 100000 * options.scale, 1 },  // @note hardly anything repeats, batching can't help here
+    };
+    for (auto const& scene : scenes) {
+        auto const instances = MakeInstances(scene.numInstances, scene.numMeshes, scene.numLods, rng);
+        std::vector<uint32_t> order(instances.size());
+        BuildStaticMeshBatches(instances.data(), scene.numInstances, order.data(), &batches);
+        ok &= CheckBatches(instances, order, batches);
+
+        uint32_t const numRuns = 20;
+        Timer timer;
+        for (auto run = 0u; run < numRuns; ++run) {
+            BuildStaticMeshBatches(instances.data(), scene.numInstances, order.data(), &batches);
+            DoNotOptimize(batches.size());
+        }
+        auto const ns = timer.GetElapsedTime() * 1e9 / (static_cast<double>(numRuns) * scene.numInstances);
+        auto const ratio = static_cast<double>(scene.numInstances) / static_cast<double>(batches.size());
+        if (options.csv) {
+            printf("instancing,%u,%u,%u,%u,%.2f,%.2f\n", scene.numInstances, scene.numMeshes, scene.numLods, static_cast<uint32_t>(batches.size()), ratio, ns);
+        }
+        else {
+            printf("%10u %8u %6u %10u %11.1fx %14.2f\n", scene.numInstances, scene.numMeshes, scene.numLods, static_cast<uint32_t>(batches.size()), ratio, ns);
+        }
+    }
+
+    if (!options.csv) {
+        printf("batching checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+#include "Benchmark.h"
+
+#include <Runtime/Renderables/StaticMeshScene.h>
+#include <Runtime/Math/math_functions.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+    using mini::StaticMeshScene;
+    using mini::StaticMeshHandle;
+    using mini::Transform;
+
+    // the layout the scene replaces: one struct per object, culling and matrix loops stride over all of it
+    struct AosObject
+    {
+        mini::StaticMesh    mesh;
+        float               boundingRadius = 0.0f;
+    };
+
+    Transform RandomTransform(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> coordinate(-500.0f, 500.0f), unit(-1.0f, 1.0f), scale(0.5f, 2.0f);
+        Transform transform;
+        transform.position = mini::math::vec3f_t(coordinate(rng), coordinate(rng) * 0.1f, coordinate(rng));
+        transform.rotation = mini::math::normalize(mini::math::quatf_t(unit(rng), unit(rng), unit(rng), unit(rng) + 0.01f));
+        transform.uniformScale = scale(rng);
+        return transform;
+    }
+
+    mini::MeshResourceHandle RandomMesh(std::mt19937& rng) { return { static_cast<uint32_t>(rng() % 64) }; }
+
+    bool SameTransform(Transform const& a, Transform const& b)
+    {
+        return memcmp(&a.position, &b.position, sizeof(a.position)) == 0 && memcmp(&a.rotation, &b.rotation, sizeof(a.rotation)) == 0
+            && a.uniformScale == b.uniformScale;
+    }
+
+    // @note verifies that handles to destroyed objects are rejected, even after their slot has been reused, and that a full scene says so
+    bool CheckStaleHandles()
+    {
+        StaticMeshScene scene;
+        scene.Initialize(4);
+        bool ok = true;
+        std::mt19937 rng(0x5ce1);
+
+        ok &= !scene.IsValid(StaticMeshHandle()) && !scene.Destroy(StaticMeshHandle());
+        auto const a = scene.Create(RandomMesh(rng), RandomTransform(rng), 1.0f);
+        ok &= scene.IsValid(a) && scene.GetDenseIndex(a) == 0;
+        ok &= scene.Destroy(a);
+        ok &= !scene.IsValid(a) && scene.GetDenseIndex(a) == StaticMeshScene::INVALID_INDEX;
+        ok &= !scene.Destroy(a);    // double destroy is rejected
+        Transform transform;
+        ok &= !scene.SetTransform(a, transform) && !scene.GetTransform(a, &transform);
+
+        // cycle through the free list until a's slot is handed out again
+        StaticMeshHandle reused;
+        for (auto i = 0; i < 4; ++i) {
+            auto const handle = scene.Create(RandomMesh(rng), RandomTransform(rng), 1.0f);
+            if (mini::SlotMapHandleLayout::GetIndex(handle.handle) == mini::SlotMapHandleLayout::GetIndex(a.handle)) { reused = handle; }
+        }
+        ok &= mini::SlotMapHandleLayout::GetIndex(reused.handle) == mini::SlotMapHandleLayout::GetIndex(a.handle) && reused.handle != a.handle;
+        ok &= scene.IsValid(reused) && !scene.IsValid(a);
+        ok &= scene.Create(RandomMesh(rng), RandomTransform(rng), 1.0f).handle == mini::SlotMapHandleLayout::INVALID_HANDLE;   // scene is full
+        ok &= scene.GetCount() == 4;
+        return ok;
+    }
+
+    // @note    random creates, destroys and transform changes against a shadow copy: every live handle keeps its own data through
+    //          the swap-removes, the streams stay packed and the radii follow the scale
+    bool CheckShadowCopy()
+    {
+        struct Expected { StaticMeshHandle handle; mini::MeshResourceHandle mesh; Transform transform; float radius; };
+        StaticMeshScene scene;
+        scene.Initialize(1000);
+        std::vector<Expected> live;
+        std::mt19937 rng(0x5ce2);
+        std::uniform_real_distribution<float> radius(0.1f, 10.0f);
+        bool ok = true;
+
+        for (auto op = 0; op < 20000; ++op) {
+            auto const choice = rng() % 8;
+            if (choice < 4 && live.size() < 1000) {
+                Expected e = { {}, RandomMesh(rng), RandomTransform(rng), radius(rng) };
+                e.handle = scene.Create(e.mesh, e.transform, e.radius);
+                ok &= scene.IsValid(e.handle);
+                live.push_back(e);
+            }
+            else if (choice < 7 && !live.empty()) {
+                auto const i = rng() % live.size();
+                ok &= scene.Destroy(live[i].handle) && !scene.IsValid(live[i].handle);
+                live[i] = live.back();
+                live.pop_back();
+            }
+            else if (!live.empty()) {
+                auto& e = live[rng() % live.size()];
+                e.transform = RandomTransform(rng);
+                ok &= scene.SetTransform(e.handle, e.transform);
+            }
+
+            if (op % 97 != 0) { continue; }
+            ok &= scene.GetCount() == live.size();
+            for (auto const& e : live) {
+                auto const index = scene.GetDenseIndex(e.handle);
+                Transform transform;
+                ok &= index < scene.GetCount() && scene.GetTransform(e.handle, &transform) && SameTransform(transform, e.transform);
+                ok &= index < scene.GetCount() && scene.GetHandles()[index].handle == e.handle.handle && scene.GetMeshes()[index].handle == e.mesh.handle;
+                ok &= index < scene.GetCount() && scene.GetBoundingRadii()[index] == e.radius * e.transform.uniformScale;
+            }
+        }
+        return ok;
+    }
+
+    // the smallest margin of a sphere over the planes in double, negative if outside
+    double Margin(mini::math::frustum_t const& frustum, float const* center, double radius)
+    {
+        auto margin = INFINITY;
+        for (auto const& plane : frustum.planes) {
+            auto const distance = static_cast<double>(plane.normal.x) * center[0] + static_cast<double>(plane.normal.y) * center[1]
+                + static_cast<double>(plane.normal.z) * center[2] + plane.d;
+            margin = fmin(margin, distance + radius);
+        }
+        return margin;
+    }
+
+    // what a per object loop over the AoS layout looks like, with an early out at the first plane the sphere is outside of
+    uint32_t CullAos(mini::math::frustum_t const& frustum, std::vector<AosObject> const& objects, uint32_t* outVisible)
+    {
+        uint32_t numVisible = 0;
+        for (auto i = 0u; i < objects.size(); ++i) {
+            auto const& object = objects[i];
+            auto const& position = object.mesh.transform.position;
+            auto const radius = object.boundingRadius * object.mesh.transform.uniformScale;
+            bool outside = false;
+            for (auto p = 0; p < mini::math::frustum_t::NUM_PLANES && !outside; ++p) {
+                auto const& plane = frustum.planes[p];
+                outside = plane.normal.x * position.x + plane.normal.y * position.y + plane.normal.z * position.z + plane.d < -radius;
+            }
+            if (!outside) { outVisible[numVisible++] = i; }
+        }
+        return numVisible;
+    }
+}
+
+int mini::bench::RunStaticMeshSceneBenchmark(Options const& options)
+{
+    auto const staleOk = CheckStaleHandles();
+    auto const shadowOk = CheckShadowCopy();
+    bool ok = staleOk && shadowOk;
+    std::mt19937 rng(0x5ce3);
+    std::uniform_real_distribution<float> radius(0.5f, 5.0f);
+
+    math::vec3f_t const eye(0.0f, 10.0f, 0.0f);
+    auto const proj = math::make_perspective_proj(math::DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+    auto const view = math::inverse(math::make_lookat(eye, math::vec3f_t(300.0f, 0.0f, 200.0f), math::vec3f_t(0.0f, 1.0f, 0.0f)));
+    auto const frustum = math::make_frustum(proj * view);
+
+    if (options.csv) {
+        printf("benchmark,pass,count,aos_ns,soa_ns,speedup\n");
+    }
+    else {
+        printf("stale handle detection: %s, shadow copy: %s\n", staleOk ? "ok" : "FAILED", shadowOk ? "ok" : "FAILED");
+        printf("%-22s %8s %12s %12s %8s\n", "pass", "count", "aos ns/obj", "soa ns/obj", "speedup");
+    }
+
+    // @note 1M objects is the target from the request, the small scene stays in cache
+    for (auto const count : { 10000u, 1000000u }) {
+        auto const numRuns = std::max(1u, 10000000u / count) * options.scale;
+        auto const Report = [&](char const* pass, double aosNs, double soaNs) {
+            if (options.csv) {
+                printf("scene,%s,%u,%.3f,%.3f,%.2f\n", pass, count, aosNs, soaNs, aosNs / soaNs);
+            }
+            else if (aosNs > 0.0) {
+                printf("%-22s %8u %12.3f %12.3f %7.2fx\n", pass, count, aosNs, soaNs, aosNs / soaNs);
+            }
+            else {
+                printf("%-22s %8u %12s %12.3f %8s\n", pass, count, "-", soaNs, "-");
+            }
+        };
+
+        std::vector<AosObject> objects(count);
+        std::vector<StaticMeshHandle> handles(count);
+        for (auto& object : objects) {
+            object.mesh.resourceHandle = RandomMesh(rng);
+            object.mesh.transform = RandomTransform(rng);
+            object.boundingRadius = radius(rng);
+        }
+
+        StaticMeshScene scene;
+        scene.Initialize(count);
+        auto const createNs = MeasureNsPerElement(count, 1, [&]() {
+            for (auto i = 0u; i < count; ++i) { handles[i] = scene.Create(objects[i].mesh.resourceHandle, objects[i].mesh.transform, objects[i].boundingRadius); }
+        });
+        Report("create", 0.0, createNs);
+
+        {   // a pass that only needs positions, e.g. distances to the camera
+            float aosSum = 0.0f, soaSum = 0.0f;
+            auto const aosNs = MeasureNsPerElement(count, numRuns, [&]() {
+                for (auto const& object : objects) { aosSum += object.mesh.transform.position.x + object.mesh.transform.position.y + object.mesh.transform.position.z; }
+                DoNotOptimize(aosSum);
+            });
+            auto const positions = scene.GetPositions();
+            auto const soaNs = MeasureNsPerElement(count, numRuns, [&]() {
+                for (auto i = 0u; i < count; ++i) { soaSum += positions.x[i] + positions.y[i] + positions.z[i]; }
+                DoNotOptimize(soaSum);
+            });
+            Report("positions", aosNs, soaNs);
+        }
+        {   // frustum culling, positions and scaled radii
+            std::vector<uint32_t> aosVisible(count), soaVisible(count);
+            uint32_t numAos = 0, numSoa = 0;
+            auto const aosNs = MeasureNsPerElement(count, numRuns, [&]() { numAos = CullAos(frustum, objects, aosVisible.data()); DoNotOptimize(numAos); });
+            auto const soaNs = MeasureNsPerElement(count, numRuns, [&]() { numSoa = scene.CullSpheres(frustum, soaVisible.data()); DoNotOptimize(numSoa); });
+            Report("cull spheres", aosNs, soaNs);
+
+            // @note    the objects were created in order and none destroyed yet, so dense indices are the objects'. rounding may only
+            //          disagree about spheres touching a plane
+            auto const positions = scene.GetPositions();
+            auto next = 0u;
+            for (auto i = 0u; i < count; ++i) {
+                auto const kept = next < numSoa && soaVisible[next] == i;
+                next += kept ? 1 : 0;
+                float const center[3] = { positions.x[i], positions.y[i], positions.z[i] };
+                auto const margin = Margin(frustum, center, static_cast<double>(objects[i].boundingRadius) * objects[i].mesh.transform.uniformScale);
+                ok &= kept == (margin >= 0.0) || fabs(margin) < 1e-3;
+            }
+            ok &= next == numSoa && numSoa > 0 && numSoa < count;
+            ok &= numAos > 0 && numAos < count;
+        }
+        {   // model matrices, e.g. for the instance buffer
+            std::vector<math::mat3x4f_t> aosMatrices(count), soaMatrices(count);
+            auto const aosNs = MeasureNsPerElement(count, numRuns, [&]() {
+                for (auto i = 0u; i < count; ++i) { aosMatrices[i] = ToAffine(objects[i].mesh.transform); }
+                DoNotOptimize(aosMatrices[0]);
+            });
+            auto const soaNs = MeasureNsPerElement(count, numRuns, [&]() { scene.ComposeAffine(0, count, soaMatrices.data()); DoNotOptimize(soaMatrices[0]); });
+            Report("compose matrices", aosNs, soaNs);
+            // @note the batch and make_affine may contract to FMA differently
+            for (auto i = 0u; i < count; ++i) {
+                for (auto e = 0; e < 12; ++e) { ok &= fabsf(soaMatrices[i].elements[e] - aosMatrices[i].elements[e]) <= 1e-5f * (1.0f + fabsf(aosMatrices[i].elements[e])); }
+            }
+        }
+        {   // random handle lookups go through the sparse set
+            std::vector<StaticMeshHandle> shuffled = handles;
+            std::shuffle(shuffled.begin(), shuffled.end(), rng);
+            float sum = 0.0f;
+            auto const positions = scene.GetPositions();
+            auto const lookupNs = MeasureNsPerElement(count, 1, [&]() {
+                for (auto handle : shuffled) { sum += positions.x[scene.GetDenseIndex(handle)]; }
+                DoNotOptimize(sum);
+            });
+            Report("lookup (random)", 0.0, lookupNs);
+
+            // destroy half in random order, every destroy moves the last object into the hole
+            auto const numDestroyed = count / 2;
+            auto const destroyNs = MeasureNsPerElement(numDestroyed, 1, [&]() {
+                for (auto i = 0u; i < numDestroyed; ++i) { ok &= scene.Destroy(shuffled[i]); }
+            });
+            Report("destroy (random)", 0.0, destroyNs);
+            ok &= scene.GetCount() == count - numDestroyed;
+
+            // the survivors still see their own transform. a fresh scene hands out slots 1, 2, ... in creation order
+            for (auto i = numDestroyed; i < count; ++i) {
+                auto const index = scene.GetDenseIndex(shuffled[i]);
+                ok &= index < scene.GetCount() && SameTransform(scene.GetTransform(index), objects[mini::SlotMapHandleLayout::GetIndex(shuffled[i].handle) - 1].mesh.transform);
+            }
+
+            // steady churn: one create per destroy, the free list is FIFO so slots cycle
+            auto const numChurn = numDestroyed;
+            auto const churnNs = MeasureNsPerElement(numChurn, 1, [&]() {
+                for (auto i = 0u; i < numChurn; ++i) {
+                    auto const& object = objects[i];
+                    shuffled[i] = scene.Create(object.mesh.resourceHandle, object.mesh.transform, object.boundingRadius);
+                    ok &= scene.Destroy(shuffled[numDestroyed + i]);
+                }
+            });
+            Report("churn (create+destroy)", 0.0, churnNs);
+            ok &= scene.GetCount() == count - numDestroyed;
+        }
+    }
+
+    if (!options.csv) {
+        printf("(backend %s)\n", math::GetSimdBackendName());
+        printf("static mesh scene checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+#include "TestMeshes.h"
+
+#include <Runtime/MeshProcessing/MeshOptimizer.h>
+#include <Runtime/MeshProcessing/MeshletBuilder.h>
+#include <Runtime/Culling/MeshBounds.h>
+#include <Runtime/common.h>
+
+#include <filesystem>
+#include <math.h>
+#include <string.h>
+
+void mini::bench::Cook(std::vector<float> const& vertices, std::vector<uint32_t> const& indices, LodChainSettings const* lodSettings, CookedMesh* outMesh)
+{
+    MeshData data;
+    data.vertexData = reinterpret_cast<char*>(const_cast<float*>(vertices.data()));
+    data.vertexDataSize = static_cast<uint32_t>(vertices.size() * sizeof(float));
+    data.vertexStride = VERTEX_STRIDE;
+    data.indexData = reinterpret_cast<char*>(const_cast<uint32_t*>(indices.data()));
+    data.indexDataSize = static_cast<uint32_t>(indices.size() * sizeof(uint32_t));
+    data.indexFormat = IndexFormat::R32_UINT;
+
+    eastl::vector<char> optimizedIndices, lodIndices;
+    eastl::vector<MeshLod> lods;
+    MeshData optimized, withLods;
+    OptimizeMeshData(data, &outMesh->vertexData, &optimizedIndices, &optimized);
+    if (lodSettings != nullptr) { BuildLodChainForMeshData(optimized, *lodSettings, &lodIndices, &lods, &withLods); }
+    BuildMeshletsForMeshData(lodSettings != nullptr ? withLods : optimized, &outMesh->indexData, &outMesh->meshlets, &outMesh->lods, &outMesh->data);
+    outMesh->indices.resize(outMesh->data.indexDataSize / GetIndexFormatStride(outMesh->data.indexFormat));
+    UnpackIndices(outMesh->data, outMesh->indices.data());
+
+    outMesh->resource.bounds = ComputeMeshBounds(outMesh->data.vertexData, outMesh->data.vertexDataSize / VERTEX_STRIDE, VERTEX_STRIDE);
+    outMesh->resource.numIndices = static_cast<uint32_t>(outMesh->indices.size());
+    outMesh->resource.numLods = outMesh->data.numLods;
+    memcpy(outMesh->resource.lods, outMesh->data.lods, outMesh->data.numLods * sizeof(MeshLod));
+}
+
+void mini::bench::AppendSphere(uint32_t stacks, uint32_t slices, float const center[3], float bumpiness, std::vector<float>& vertices, std::vector<uint32_t>& indices)
+{
+    auto const surface = [&](float theta, float phi, float* out) {
+        auto const r = 1.0f + bumpiness * sinf(5.0f * theta) * sinf(7.0f * phi);
+        out[0] = r * sinf(theta) * cosf(phi);
+        out[1] = r * cosf(theta);
+        out[2] = r * sinf(theta) * sinf(phi);
+    };
+    // @note a sphere's normal is its position, a bumpy one's comes from the surface's derivatives
+    auto const addVertex = [&](float theta, float phi) {
+        float p[3], n[3];
+        surface(theta, phi, p);
+        memcpy(n, p, sizeof(n));
+        if (bumpiness > 0.0f) {
+            float pt[3], pp[3];
+            auto const h = 1e-3f;
+            surface(theta + h, phi, pt);
+            surface(theta, phi + h, pp);
+            float const dt[3] = { pt[0] - p[0], pt[1] - p[1], pt[2] - p[2] };
+            float const dp[3] = { pp[0] - p[0], pp[1] - p[1], pp[2] - p[2] };
+            float const cross[3] = { dp[1] * dt[2] - dp[2] * dt[1], dp[2] * dt[0] - dp[0] * dt[2], dp[0] * dt[1] - dp[1] * dt[0] };
+            if (sqrtf(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]) >= 1e-12f) { memcpy(n, cross, sizeof(n)); }
+            auto const length = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (auto k = 0; k < 3; ++k) { n[k] /= length; }
+        }
+        vertices.insert(vertices.end(), { center[0] + p[0], center[1] + p[1], center[2] + p[2], n[0], n[1], n[2] });
+    };
+
+    auto const base = static_cast<uint32_t>(vertices.size() / FLOATS_PER_VERTEX);
+    addVertex(0.0f, 0.0f);
+    for (auto i = 1u; i < stacks; ++i) {
+        for (auto j = 0u; j < slices; ++j) {
+            addVertex(3.14159265f * i / stacks, 2.0f * 3.14159265f * j / slices);
+        }
+    }
+    addVertex(3.14159265f, 0.0f);
+
+    auto const ring = [&](uint32_t i, uint32_t j) { return base + 1 + (i - 1) * slices + j % slices; };
+    auto const bottom = static_cast<uint32_t>(vertices.size() / FLOATS_PER_VERTEX) - 1;
+    for (auto j = 0u; j < slices; ++j) {
+        indices.insert(indices.end(), { base, ring(1, j + 1), ring(1, j) });
+        indices.insert(indices.end(), { bottom, ring(stacks - 1, j), ring(stacks - 1, j + 1) });
+    }
+    for (auto i = 1u; i + 1 < stacks; ++i) {
+        for (auto j = 0u; j < slices; ++j) {
+            indices.insert(indices.end(), { ring(i, j), ring(i, j + 1), ring(i + 1, j) });
+            indices.insert(indices.end(), { ring(i, j + 1), ring(i + 1, j + 1), ring(i + 1, j) });
+        }
+    }
+}
+
+void mini::bench::AppendGrid(uint32_t quads, float size, std::vector<float>& vertices, std::vector<uint32_t>& indices)
+{
+    auto const base = static_cast<uint32_t>(vertices.size() / FLOATS_PER_VERTEX);
+    for (auto z = 0u; z <= quads; ++z) {
+        for (auto x = 0u; x <= quads; ++x) {
+            vertices.insert(vertices.end(), { size * x / quads, 0.0f, size * z / quads, 0.0f, 1.0f, 0.0f });
+        }
+    }
+    for (auto z = 0u; z < quads; ++z) {
+        for (auto x = 0u; x < quads; ++x) {
+            auto const a = base + z * (quads + 1) + x;
+            indices.insert(indices.end(), { a, a + quads + 1, a + 1, a + 1, a + quads + 1, a + quads + 2 });
+        }
+    }
+}
+
+std::vector<char> mini::bench::MakeGTMesh(GTMeshVertexFormat vertexFormat, uint32_t numVertices, bool writeBounds, std::mt19937& rng)
+{
+    MINI_ASSERT(vertexFormat == GTMeshVertexFormat::PositionNormal || vertexFormat == GTMeshVertexFormat::PositionNormalTangentTexcoord0, "Unsupported .gtmesh vertex format");
+    auto const stride = GetVertexFormatStride(vertexFormat == GTMeshVertexFormat::PositionNormal ? VertexFormat::PositionNormal : VertexFormat::PositionNormalTangentUV);
+    auto const columns = 16u;
+    auto const rows = numVertices / columns;
+    numVertices = rows * columns;
+    uint64_t const numIndices = static_cast<uint64_t>(rows - 1) * (columns - 1) * 6;
+    auto const indexFormat = numVertices <= 0x100 ? GTMeshIndexFormat::UInt8 : numVertices <= 0x10000 ? GTMeshIndexFormat::UInt16 : GTMeshIndexFormat::UInt32;
+    auto const indexSize = indexFormat == GTMeshIndexFormat::UInt8 ? 1u : indexFormat == GTMeshIndexFormat::UInt16 ? 2u : 4u;
+    uint32_t const numSubmeshes = 2;
+
+    std::vector<char> file;
+    file.reserve(GTMESH_HEADER_SIZE + static_cast<size_t>(numVertices) * stride + numIndices * indexSize + numSubmeshes * GTMESH_SUBMESH_SIZE);
+    auto const append = [&](void const* src, size_t size) { file.insert(file.end(), static_cast<char const*>(src), static_cast<char const*>(src) + size); };
+    uint8_t const formats[2] = { static_cast<uint8_t>(vertexFormat), static_cast<uint8_t>(indexFormat) };
+    uint64_t const numVertices64 = numVertices;
+    float bounds[6] = { static_cast<float>(columns - 1), 0.1f, static_cast<float>(rows - 1), 0.0f, 0.0f, 0.0f };   // @note max before min
+    if (!writeBounds) { memset(bounds, 0, sizeof(bounds)); }
+    append(formats, sizeof(formats));
+    append(&numVertices64, sizeof(numVertices64));
+    append(&numIndices, sizeof(numIndices));
+    append(&numSubmeshes, sizeof(numSubmeshes));
+    append(bounds, sizeof(bounds));
+    MINI_ASSERT(file.size() == GTMESH_HEADER_SIZE, "Header doesn't match GTMesh.h");
+
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<float> vertex(stride / sizeof(float));
+    for (auto v = 0u; v < numVertices; ++v) {
+        vertex[0] = static_cast<float>(v % columns);
+        vertex[1] = unit(rng) * 0.1f;
+        vertex[2] = static_cast<float>(v / columns);
+        vertex[3] = 0.0f; vertex[4] = 1.0f; vertex[5] = 0.0f;
+        if (vertex.size() == 12) {
+            vertex[6] = 1.0f; vertex[7] = 0.0f; vertex[8] = 0.0f; vertex[9] = 0.0f;
+            vertex[10] = vertex[0] / columns; vertex[11] = vertex[2] / rows;
+        }
+        append(vertex.data(), stride);
+    }
+    for (auto r = 0u; r + 1 < rows; ++r) {
+        for (auto c = 0u; c + 1 < columns; ++c) {
+            uint32_t const quad[6] = { r * columns + c, (r + 1) * columns + c, r * columns + c + 1, r * columns + c + 1, (r + 1) * columns + c, (r + 1) * columns + c + 1 };
+            for (auto const index : quad) { append(&index, indexSize); }  // @note little endian, the low bytes are the narrow index
+        }
+    }
+    uint64_t const submeshes[4] = { 0, numIndices / 6 * 3, numIndices / 6 * 3, numIndices - numIndices / 6 * 3 };
+    static_assert(sizeof(submeshes) == 2 * GTMESH_SUBMESH_SIZE);
+    append(submeshes, sizeof(submeshes));
+    return file;
+}
+
+bool mini::bench::WriteFile(char const* path, std::vector<char> const& data)
+{
+    FILE* file = fopen(path, "wb");
+    if (file == nullptr) { return false; }
+    auto const written = fwrite(data.data(), 1, data.size(), file);
+    fclose(file);
+    return written == data.size();
+}
+
+bool mini::bench::MakeCorpusDirectory(Options const& options, char const* name, std::string* outPath)
+{
+    auto const dir = std::filesystem::path(options.workDir) / name;
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+    if (ec) {
+        printf("Failed to create corpus directory: %s\n", dir.u8string().c_str());
+        return false;
+    }
+    *outPath = dir.u8string();
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Benchmark.h"
+
+#include <stdint.h>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+#include <Runtime/AssetLibraries/GTMesh.h>
+#include <Runtime/MeshProcessing/MeshSimplifier.h>
+
+#include <EASTL/vector.h>
+
+namespace mini
+{
+    namespace bench
+    {
+        /*
+            *   Generated test meshes and the cook pipeline the mesh processing benchmarks share. Vertices are PositionNormal,
+            *   six floats, indices 32 bit. The loading benchmarks get their .gtmesh files from here too.
+        */
+        constexpr uint32_t FLOATS_PER_VERTEX = 6;   // @note VertexFormat::PositionNormal
+        constexpr uint32_t VERTEX_STRIDE = FLOATS_PER_VERTEX * sizeof(float);
+
+        struct CookedMesh
+        {
+            eastl::vector<char>     vertexData;
+            eastl::vector<char>     indexData;
+            eastl::vector<Meshlet>  meshlets;
+            eastl::vector<MeshLod>  lods;
+            std::vector<uint32_t>   indices;    // unpacked from indexData, every LOD
+            MeshData                data;
+            MeshResource            resource;   // @note what MeshLibrary::SetData would make of it, for the LOD selector
+        };
+
+        // @note    runs the cook pipeline on an indexed mesh: welding and reordering, the LOD chain if lodSettings isn't null, then
+        //          meshlets. cube style inputs come out welded
+        void    Cook(std::vector<float> const& vertices, std::vector<uint32_t> const& indices, LodChainSettings const* lodSettings, CookedMesh* outMesh);
+
+        // @note    appends a UV sphere of radius 1 around center, poles are shared and there is no seam duplicate. a bumpiness above 0
+        //          makes it an asteroid, the radius varies by up to that much and the normals follow the surface
+        void    AppendSphere(uint32_t stacks, uint32_t slices, float const center[3], float bumpiness, std::vector<float>& vertices, std::vector<uint32_t>& indices);
+
+        // ground plane in xz facing up, from the origin to size
+        void    AppendGrid(uint32_t quads, float size, std::vector<float>& vertices, std::vector<uint32_t>& indices);
+
+        // @note    a .gtmesh file in the exporter's layout, see GTMesh.h: a grid of numVertices rounded down to 16 columns in the xz plane,
+        //          heights jittered by up to 0.1, split into two submeshes. indices use the narrowest format that fits and without
+        //          writeBounds the AABB is left zero, like an exporter that doesn't know it. only the formats ParseGTMesh accepts
+        std::vector<char>   MakeGTMesh(GTMeshVertexFormat vertexFormat, uint32_t numVertices, bool writeBounds, std::mt19937& rng);
+        bool                WriteFile(char const* path, std::vector<char> const& data);
+        // empties or creates the named directory under the work directory
+        bool                MakeCorpusDirectory(Options const& options, char const* name, std::string* outPath);
+    }
+}
@@ -0,0 +1,173 @@
+#include "Benchmark.h"
+
+#include <Runtime/Renderables/TransformHierarchy.h>
+#include <Runtime/Math/math_functions.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+    using mini::TransformHierarchy;
+    using mini::Transform;
+
+    Transform RandomLocalTransform(std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> coordinate(-2.0f, 2.0f), unit(-1.0f, 1.0f), scale(0.8f, 1.25f);
+        Transform transform;
+        transform.position = mini::math::vec3f_t(coordinate(rng), coordinate(rng), coordinate(rng));
+        transform.rotation = mini::math::normalize(mini::math::quatf_t(unit(rng), unit(rng), unit(rng), unit(rng) + 0.01f));
+        transform.uniformScale = scale(rng);
+        return transform;
+    }
+
+    // @note    a scene's worth of small hierarchies of treeSize nodes, each node hangs off a random earlier node of its tree. that's
+    //          around a dozen levels at most and a few descendants per node on average, roughly props on props and skeletons
+    std::vector<uint32_t> RandomParents(uint32_t count, uint32_t treeSize, std::mt19937& rng)
+    {
+        std::vector<uint32_t> parents(count);
+        for (auto i = 0u; i < count; ++i) {
+            auto const j = i % treeSize;
+            parents[i] = j == 0 ? TransformHierarchy::INVALID_NODE : i - j + rng() % j;
+        }
+        return parents;
+    }
+
+    // what rebuilding every matrix every frame looks like, walking the nodes in order with a matrix per local transform
+    void RebuildAll(TransformHierarchy const& hierarchy, std::vector<mini::math::mat3x4f_t>& worldMatrices)
+    {
+        for (auto node = 0u; node < hierarchy.GetCount(); ++node) {
+            auto const local = mini::ToAffine(hierarchy.GetLocalTransform(node));
+            auto const parent = hierarchy.GetParent(node);
+            worldMatrices[node] = parent == TransformHierarchy::INVALID_NODE ? local : worldMatrices[parent] * local;
+        }
+    }
+
+    // @note the batch and make_affine may contract to FMA differently, the error grows with the depth
+    bool SameMatrices(TransformHierarchy const& hierarchy, std::vector<mini::math::mat3x4f_t> const& expected)
+    {
+        bool ok = true;
+        for (auto node = 0u; node < hierarchy.GetCount(); ++node) {
+            auto const& m = hierarchy.GetWorldMatrix(node);
+            auto const tolerance = 1e-5f * (1.0f + hierarchy.GetDepth(node));
+            for (auto e = 0; e < 12; ++e) { ok &= fabsf(m.elements[e] - expected[node].elements[e]) <= tolerance * (1.0f + fabsf(expected[node].elements[e])); }
+        }
+        return ok;
+    }
+
+    // @note breadth first layout: levels contiguous, parents first, children contiguous and the inputs mapped to their own data
+    bool CheckLayout(std::mt19937& rng)
+    {
+        auto const count = 2000u;
+        // several trees, so the inputs of a level are spread over the input order
+        auto const parents = RandomParents(count, 300, rng);
+        std::vector<Transform> locals(count);
+        for (auto& local : locals) { local = RandomLocalTransform(rng); }
+        TransformHierarchy hierarchy;
+        std::vector<uint32_t> nodes(count);
+        bool ok = hierarchy.Build(parents.data(), locals.data(), count, nodes.data());
+
+        std::vector<uint32_t> inputs(count, TransformHierarchy::INVALID_NODE);
+        for (auto i = 0u; i < count; ++i) {
+            ok &= nodes[i] < count && inputs[nodes[i]] == TransformHierarchy::INVALID_NODE;
+            inputs[nodes[i]] = i;
+            auto const local = hierarchy.GetLocalTransform(nodes[i]);
+            ok &= memcmp(&local, &locals[i], sizeof(Transform)) == 0;
+            ok &= hierarchy.GetParent(nodes[i]) == (parents[i] == TransformHierarchy::INVALID_NODE ? TransformHierarchy::INVALID_NODE : nodes[parents[i]]);
+        }
+        ok &= hierarchy.GetLevelStart(0) == 0 && hierarchy.GetLevelStart(hierarchy.GetNumLevels()) == count;
+        for (auto level = 0u; level < hierarchy.GetNumLevels(); ++level) {
+            for (auto node = hierarchy.GetLevelStart(level); node < hierarchy.GetLevelStart(level + 1); ++node) {
+                ok &= hierarchy.GetDepth(node) == level;
+                auto const parent = hierarchy.GetParent(node);
+                ok &= level == 0 ? parent == TransformHierarchy::INVALID_NODE : parent < node && hierarchy.GetDepth(parent) == level - 1;
+                // siblings are together, in their parents' order
+                ok &= level == 0 || node == hierarchy.GetLevelStart(level) || parent >= hierarchy.GetParent(node - 1);
+            }
+        }
+
+        hierarchy.Clear();
+        ok &= hierarchy.GetCount() == 0 && hierarchy.UpdateWorldMatrices() == 0;
+        return ok;
+    }
+}
+
+int mini::bench::RunTransformHierarchyBenchmark(Options const& options)
+{
+    std::mt19937 rng(0x41e7);
+    bool ok = CheckLayout(rng);
+
+    auto const count = 100000u * options.scale;
+    auto const parents = RandomParents(count, 100, rng);
+    std::vector<Transform> locals(count);
+    for (auto& local : locals) { local = RandomLocalTransform(rng); }
+    TransformHierarchy hierarchy;
+    std::vector<uint32_t> nodes(count);
+    ok &= hierarchy.Build(parents.data(), locals.data(), count, nodes.data());
+    std::vector<math::mat3x4f_t> expected(count);
+
+    // the first update computes everything
+    auto const numInitial = hierarchy.UpdateWorldMatrices();
+    RebuildAll(hierarchy, expected);
+    ok &= numInitial == count && SameMatrices(hierarchy, expected);
+    ok &= hierarchy.UpdateWorldMatrices() == 0;     // nothing changed
+
+    auto const numRuns = 20u;
+
+    if (options.csv) {
+        printf("benchmark,changed,nodes,levels,updated_nodes,set_us,update_us,rebuild_all_us,speedup\n");
+    }
+    else {
+        printf("%u nodes, %u levels\n", count, hierarchy.GetNumLevels());
+        printf("%-10s %14s %9s %12s %16s %8s\n", "changed", "updated nodes", "set us", "update us", "rebuild all us", "speedup");
+    }
+
+    // @note    a frame changes the local transform of a random fraction of the nodes and updates. the updated count includes
+    //          the descendants, which move along. setting is timed apart, rebuilding everything reads local transforms that are
+    //          already in place too. the three are interleaved so noise hits them alike, the speedup is the update's
+    for (auto const fraction : { 0.001, 0.01, 0.1, 1.0 }) {
+        auto const numChanged = std::max(1u, static_cast<uint32_t>(count * fraction));
+        std::vector<std::vector<uint32_t>> frames(numRuns);
+        for (auto& frame : frames) {
+            frame.resize(numChanged);
+            for (auto& node : frame) { node = fraction == 1.0 ? static_cast<uint32_t>(&node - frame.data()) : rng() % count; }
+        }
+        uint64_t numUpdated = 0;
+        double setNs = 0.0, updateNs = 0.0, rebuildNs = 0.0;
+        for (auto run = 0u; run < numRuns; ++run) {
+            setNs += MeasureNsPerElement(1, 1, [&]() { for (auto const node : frames[run]) { hierarchy.SetLocalTransform(node, locals[run]); } }) / numRuns;
+            updateNs += MeasureNsPerElement(1, 1, [&]() { numUpdated += hierarchy.UpdateWorldMatrices(); }) / numRuns;
+            rebuildNs += MeasureNsPerElement(1, 1, [&]() { RebuildAll(hierarchy, expected); DoNotOptimize(expected[0]); }) / numRuns;
+        }
+        if (options.csv) {
+            printf("hierarchy,%.3f,%u,%u,%llu,%.1f,%.1f,%.1f,%.2f\n", fraction, count, hierarchy.GetNumLevels(), static_cast<unsigned long long>(numUpdated / numRuns),
+                setNs * 1e-3, updateNs * 1e-3, rebuildNs * 1e-3, rebuildNs / updateNs);
+        }
+        else {
+            printf("%9.1f%% %14llu %9.1f %12.1f %16.1f %7.2fx\n", fraction * 100.0, static_cast<unsigned long long>(numUpdated / numRuns), setNs * 1e-3, updateNs * 1e-3,
+                rebuildNs * 1e-3, rebuildNs / updateNs);
+        }
+    }
+
+    // random changes with new values against a full rebuild, including nodes changed along with one of their ancestors
+    for (auto frame = 0; frame < 8; ++frame) {
+        for (auto i = 0u; i < count / 100; ++i) {
+            auto const node = rng() % count;
+            hierarchy.SetLocalTransform(node, RandomLocalTransform(rng));
+            auto const parent = hierarchy.GetParent(node);
+            if (parent != TransformHierarchy::INVALID_NODE && (rng() & 1) != 0) { hierarchy.SetLocalTransform(parent, RandomLocalTransform(rng)); }
+        }
+        hierarchy.UpdateWorldMatrices();
+        RebuildAll(hierarchy, expected);
+        ok &= SameMatrices(hierarchy, expected);
+    }
+
+    if (!options.csv) {
+        printf("(backend %s)\n", math::GetSimdBackendName());
+        printf("transform hierarchy checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
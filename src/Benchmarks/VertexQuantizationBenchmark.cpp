@@ -0,0 +1,110 @@
+#include "Benchmark.h"
+
+#include <Runtime/MeshProcessing/VertexQuantization.h>
+#include <Runtime/util.h>
+
+#include <math.h>
+#include <random>
+#include <vector>
+#include <string.h>
+
+namespace
+{
+    // @note random unit vectors cover the whole octahedron including the folded lower half and the seams
+    void RandomUnitVector(std::mt19937& rng, float* out)
+    {
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        float length = 0.0f;
+        do {
+            for (auto c = 0; c < 3; ++c) { out[c] = normal(rng); }
+            length = sqrtf(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+        } while (length < 1e-3f);
+        for (auto c = 0; c < 3; ++c) { out[c] /= length; }
+    }
+
+    std::vector<float> MakeVertices(mini::VertexFormat format, uint32_t numVertices, std::mt19937& rng)
+    {
+        auto const floatsPerVertex = mini::GetVertexFormatStride(format) / sizeof(float);
+        std::vector<float> vertices(numVertices * floatsPerVertex);
+        std::uniform_real_distribution<float> position(-25.0f, 40.0f);
+        std::uniform_real_distribution<float> uv(-4.0f, 8.0f);
+        for (auto i = 0u; i < numVertices; ++i) {
+            auto v = vertices.data() + i * floatsPerVertex;
+            for (auto c = 0; c < 3; ++c) { v[c] = position(rng); }
+            RandomUnitVector(rng, v + 3);
+            if (format == mini::VertexFormat::PositionNormalTangentUV) {
+                RandomUnitVector(rng, v + 6);
+                v[9] = (rng() & 1) ? 1.0f : -1.0f;
+                v[10] = uv(rng);
+                v[11] = uv(rng);
+            }
+        }
+        return vertices;
+    }
+}
+
+int mini::bench::RunVertexQuantizationBenchmark(Options const& options)
+{
+    uint32_t const numVertices = 1000000 * options.scale + 3;   // @note + 3 so the scalar tail after the 4-wide kernel runs too
+    std::mt19937 rng(0x9a47);
+    bool ok = true;
+
+    if (!options.csv) {
+        printf("quantization kernel: %s\n", mini::GetVertexQuantizationKernelName());
+        printf("%-26s %8s %8s %12s %12s %12s %12s %10s %10s\n", "format", "bytes", "packed", "pos err", "pos bound", "normal deg", "tangent deg", "uv err", "simd==ref");
+    }
+
+    mini::VertexFormat const formats[] = { mini::VertexFormat::PositionNormal, mini::VertexFormat::PositionNormalTangentUV };
+    for (auto const format : formats) {
+        auto const quantizedFormat = mini::GetQuantizedVertexFormat(format);
+        auto const vertices = MakeVertices(format, numVertices, rng);
+        std::vector<char> quantized(numVertices * mini::GetVertexFormatStride(quantizedFormat));
+        std::vector<char> reference(quantized.size());
+
+        auto const params = mini::ComputeVertexQuantizationParams(format, vertices.data(), numVertices);
+
+        mini::Timer timer;
+        mini::QuantizeVerticesScalar(format, vertices.data(), numVertices, params, reference.data());
+        auto const scalarTime = timer.GetElapsedTime();
+        timer.Reset();
+        mini::QuantizeVertices(format, vertices.data(), numVertices, params, quantized.data());
+        auto const simdTime = timer.GetElapsedTime();
+
+        auto const simdMatches = memcmp(quantized.data(), reference.data(), quantized.size()) == 0;
+        auto const error = mini::MeasureQuantizationError(format, vertices.data(), quantized.data(), numVertices, params);
+
+        // @note    position error is bounded by half a step per axis, 16 bit octahedral vectors stay well below 0.01 degrees
+        //          and half floats keep 11 significant bits, i.e. a relative error of at most 2^-11
+        float maxAbsUV = 0.0f;
+        if (format == mini::VertexFormat::PositionNormalTangentUV) {
+            for (auto i = 0u; i < numVertices; ++i) {
+                for (auto c = 10; c < 12; ++c) { maxAbsUV = fabsf(vertices[i * 12 + c]) > maxAbsUV ? fabsf(vertices[i * 12 + c]) : maxAbsUV; }
+            }
+        }
+        auto const formatOk = simdMatches
+            && error.maxPositionError <= error.positionErrorBound * 1.001f
+            && error.maxNormalError < 0.01f && error.maxTangentError < 0.01f
+            && error.numTangentSignErrors == 0
+            && error.maxUVError <= maxAbsUV / 2048.0f;
+        ok &= formatOk;
+
+        auto const name = format == mini::VertexFormat::PositionNormal ? "position_normal" : "position_normal_tangent_uv";
+        auto const srcStride = mini::GetVertexFormatStride(format);
+        auto const dstStride = mini::GetVertexFormatStride(quantizedFormat);
+        if (options.csv) {
+            printf("vertex_quantization,%s,%u,%u,%u,%.7f,%.7f,%.5f,%.5f,%.6f,%d,%.2f,%.2f\n", name, numVertices, srcStride, dstStride,
+                error.maxPositionError, error.positionErrorBound, error.maxNormalError, error.maxTangentError, error.maxUVError, simdMatches ? 1 : 0,
+                numVertices / scalarTime / 1e6, numVertices / simdTime / 1e6);
+        }
+        else {
+            printf("%-26s %8u %8u %12.7f %12.7f %12.5f %12.5f %10.6f %10s\n", name, srcStride, dstStride, error.maxPositionError, error.positionErrorBound,
+                error.maxNormalError, error.maxTangentError, error.maxUVError, simdMatches ? "yes" : "NO");
+            printf("%-26s %.2fx smaller, scalar %.1f Mverts/s, %s %.1f Mverts/s%s\n", "", static_cast<float>(srcStride) / dstStride,
+                numVertices / scalarTime / 1e6, mini::GetVertexQuantizationKernelName(), numVertices / simdTime / 1e6, formatOk ? "" : "  <- FAILED");
+        }
+    }
+    if (!options.csv) {
+        printf("quantization checks: %s\n", ok ? "ok" : "FAILED");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+
+#include <string.h>
+#include <stdlib.h>
+
+namespace
+{
+    struct BenchmarkEntry
+    {
+        char const* name;
+        char const* description;
+        int(*run)(mini::bench::Options const&);
+    };
+
+    BenchmarkEntry const g_benchmarks[] = {
+        { "resources", "ResourceManager load throughput and latency on a synthetic corpus", mini::bench::RunResourceLoadBenchmark },
+        { "slotmap",   "Generational slot map allocate / free / lookup cost and stale handle detection", mini::bench::RunSlotMapBenchmark },
+        { "offsetalloc", "Offset allocator fragmentation checks, compaction and allocate / free throughput", mini::bench::RunOffsetAllocatorBenchmark },
+        { "ringalloc",   "Staging ring allocator reclamation checks against a simulated copy queue fence", mini::bench::RunRingAllocatorBenchmark },
+        { "meshstreaming", "Deferred mesh destruction against a simulated frame fence, resident bytes across load / unload cycles", mini::bench::RunMeshStreamingBenchmark },
+        { "quantize",    "Vertex quantization error bounds, SIMD vs scalar encode throughput", mini::bench::RunVertexQuantizationBenchmark },
+        { "meshopt",     "Vertex welding, cache, overdraw and fetch optimization measured with simulated caches and rasterization", mini::bench::RunMeshOptimizerBenchmark },
+        { "meshlets",    "Meshlet generation checks and CPU cluster culling of a test scene, culled triangle percentage", mini::bench::RunMeshletBenchmark },
+        { "lods",        "QEM LOD chain checks and screen space error LOD selection over a large scene, triangle reduction", mini::bench::RunMeshLodBenchmark },
+        { "gtmesh",      ".gtmesh validation checks and zero copy vs copying load throughput on a generated corpus", mini::bench::RunGTMeshLoadBenchmark },
+        { "meshbounds",  "Mesh bounds SIMD vs scalar checks and throughput, conservativeness of bounds culling", mini::bench::RunMeshBoundsBenchmark },
+        { "instancing",  "StaticMesh batching checks, draw calls with and without instancing and batch building cost", mini::bench::RunStaticMeshBatchingBenchmark },
+        { "staticbatch", "Cook time static batching checks, draw reduction against triangles drawn for different cluster sizes", mini::bench::RunStaticBatchingBenchmark },
+        { "mathsimd",    "mini::math matrix / quaternion kernels per SIMD backend, ns per op and ULP error against scalar", mini::bench::RunMathSimdBenchmark },
+        { "mathbatch",   "mini::math structure of arrays stream APIs against per element calls, ns per element and bandwidth", mini::bench::RunMathBatchBenchmark },
+        { "frustumcull", "Frustum extraction checks, batch sphere / AABB culling of 100k and 1M bounds against a per object loop", mini::bench::RunFrustumCullingBenchmark },
+        { "mathapprox",  "Fast sin / cos / rsqrt / atan2 / exp / log max error over their domains, ns against the C runtime and batch", mini::bench::RunMathApproxBenchmark },
+        { "packing",     "Half / UNORM / SNORM / R10G10B10A2 / octahedral packing exact against a double reference, scalar vs batch GB/s", mini::bench::RunPackingBenchmark },
+        { "quatanim",    "Batch nlerp / slerp / fast normalize and dual quaternion palettes for thousands of bones, skinning blend cost", mini::bench::RunQuatAnimBenchmark },
+        { "scene",       "SoA StaticMeshScene against an array of StaticMesh structs: create / destroy / lookup, position, culling and matrix passes at 1M", mini::bench::RunStaticMeshSceneBenchmark },
+        { "hierarchy",   "Breadth first transform hierarchy of 100k nodes: dirty subtree updates for 0.1% to 100% changed nodes against rebuilding every world matrix", mini::bench::RunTransformHierarchyBenchmark },
+    };
+
+    void PrintUsage()
+    {
+        printf("usage: Benchmarks [--dir <path>] [--scale <n>] [--csv] [benchmark...]\n");
+        printf("available benchmarks:\n");
+        for (auto const& entry : g_benchmarks) {
+            printf("  %-16s %s\n", entry.name, entry.description);
+        }
+    }
+}
+
+//
+int main(int argc, char* argv[])
+{
+    mini::bench::Options options;
+    bool selected[sizeof(g_benchmarks) / sizeof(g_benchmarks[0])] = {};
+    bool anySelected = false;
+
+    for (auto i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--dir") == 0 && i + 1 < argc) {
+            options.workDir = argv[++i];
+        }
+        else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            options.scale = static_cast<uint32_t>(atoi(argv[++i]));
+            options.scale = options.scale == 0 ? 1 : options.scale;
+        }
+        else if (strcmp(argv[i], "--csv") == 0) {
+            options.csv = true;
+        }
+        else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+            PrintUsage();
+            return 0;
+        }
+        else {
+            bool found = false;
+            for (auto j = 0u; j < sizeof(g_benchmarks) / sizeof(g_benchmarks[0]); ++j) {
+                if (strcmp(argv[i], g_benchmarks[j].name) == 0) {
+                    selected[j] = found = anySelected = true;
+                }
+            }
+            if (!found) {
+                printf("Unknown benchmark: %s\n", argv[i]);
+                PrintUsage();
+                return 1;
+            }
+        }
+    }
+
+    int result = 0;
+    for (auto j = 0u; j < sizeof(g_benchmarks) / sizeof(g_benchmarks[0]); ++j) {
+        if (anySelected && !selected[j]) { continue; }
+        if (!options.csv) {
+            printf("== %s ==\n", g_benchmarks[j].name);
+        }
+        result |= g_benchmarks[j].run(options);
+    }
+    return result;
+}
@@ -8,13 +8,38 @@ struct VS_Out
     float3 normal   : NORMAL;
 };
 
-struct Matrices
+struct View
 {
-    float4x4 object;
-    float4x4 mvp;
+    float4x4 viewProj;
 };
 
-ConstantBuffer<Matrices> constants : register(b0, space0);
+// @note    one per instance of a batch, the root SRV already points at the batch's first instance. an affine transform's
+//          columns, mini::math::mat3x4f_t's layout: structured buffers are packed tightly, so that's 48 bytes
+struct Instance
+{
+    float3 column0;
+    float3 column1;
+    float3 column2;
+    float3 translation;
+};
+
+// @note all meshes share one vertex and one index buffer, offsets are in bytes
+struct DrawInfo
+{
+    uint vertexOffset;
+    uint vertexStride;
+    uint indexOffset;
+    uint indexFormat;       // 0 = R16_UINT, 1 = R32_UINT
+    float3 positionOffset;  // quantized positions decode to offset + unorm * scale
+    uint vertexFormat;      // mini::VertexFormat
+    float3 positionScale;
+    uint padding;
+};
+
+#define VERTEX_FORMAT_QUANTIZED_POSITION_NORMAL 2
+
+ConstantBuffer<View> constants : register(b0, space0);
+ConstantBuffer<DrawInfo> drawInfo : register(b1, space0);
 
 struct Vertex
 {
@@ -22,17 +47,58 @@ struct Vertex
     float3 normal;
 };
 
-StructuredBuffer<Vertex> vertices : register(t0);
-StructuredBuffer<uint> indices : register(t1); 
+ByteAddressBuffer vertices : register(t0);
+ByteAddressBuffer indices : register(t1); 
+StructuredBuffer<Instance> instances : register(t2);
 
+uint LoadIndex(uint id)
+{
+    if (drawInfo.indexFormat == 0) {
+        uint address = drawInfo.indexOffset + id * 2;
+        uint word = indices.Load(address & ~3);
+        return (address & 2) ? (word >> 16) : (word & 0xffff);
+    }
+    return indices.Load(drawInfo.indexOffset + id * 4);
+}
 
-VS_Out VSMain(uint id: SV_VertexID)
+float3 DecodeOctahedral(uint packed)
 {
-    Vertex vertex = vertices[indices[id]];
-    
+    float2 f = max(float2(int2(packed << 16, packed) >> 16) / 32767.0, -1.0);
+    float3 n = float3(f, 1.0 - abs(f.x) - abs(f.y));
+    float t = saturate(-n.z);
+    n.xy += n.xy >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+// @note    quantized layouts: unorm16x4 position (w = bitangent sign) at 0, octahedral normal at 8,
+//          and for the tangent / uv variant an octahedral tangent at 12 and half2 uv at 16
+Vertex LoadVertex(uint index)
+{
+    uint address = drawInfo.vertexOffset + index * drawInfo.vertexStride;
+    Vertex vertex;
+    if (drawInfo.vertexFormat >= VERTEX_FORMAT_QUANTIZED_POSITION_NORMAL) {
+        uint3 p = vertices.Load3(address);
+        float3 unorm = float3(p.x & 0xffff, p.x >> 16, p.y & 0xffff) / 65535.0;
+        vertex.position = drawInfo.positionOffset + unorm * drawInfo.positionScale;
+        vertex.normal = DecodeOctahedral(p.z);
+    }
+    else {
+        vertex.position = asfloat(vertices.Load3(address));
+        vertex.normal = asfloat(vertices.Load3(address + 12));
+    }
+    return vertex;
+}
+
+
+VS_Out VSMain(uint id: SV_VertexID, uint instanceId: SV_InstanceID)
+{
+    Vertex vertex = LoadVertex(LoadIndex(id));
+    Instance object = instances[instanceId];
+    float3 world = object.column0 * vertex.position.x + object.column1 * vertex.position.y + object.column2 * vertex.position.z + object.translation;
+
     VS_Out output;
-    output.normal = mul(constants.object, vertex.normal);
-    output.position = mul(constants.mvp, float4(vertex.position, 1.0f));
+    output.normal = object.column0 * vertex.normal.x + object.column1 * vertex.normal.y + object.column2 * vertex.normal.z;
+    output.position = mul(constants.viewProj, float4(world, 1.0f));
     return output;
 }
 
@@ -0,0 +1,123 @@
+#include "MathBench.h"
+
+namespace
+{
+    using namespace mini;
+    using namespace mini::mathbench;
+    using math::vec3f_t;
+    using math::plane_t;
+    using math::line_t;
+
+    struct PlanePair { plane_t a; plane_t b; };
+    struct LinePlane { line_t line; plane_t plane; };
+
+    double Dot(vec3f_t const& a, vec3f_t const& b)
+    {
+        return static_cast<double>(a.x) * b.x + static_cast<double>(a.y) * b.y + static_cast<double>(a.z) * b.z;
+    }
+
+    void Cross(double const* a, double const* b, double* out)
+    {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    line_t NoLine()
+    {
+        line_t line;
+        line.normal = vec3f_t(NAN);
+        line.p = vec3f_t(NAN);
+        return line;
+    }
+}
+
+void mini::mathbench::RunGeometryCases(Suite& suite)
+{
+    auto const count = suite.GetCount();
+    Random random;
+
+    // @note    view projections of random cameras, the planes are rows of the matrix summed and normalized. the reference
+    //          measures each value in ULPs of the sum of the absolute terms over the plane's length
+    std::vector<math::mat4x4f_t> viewProjs(count);
+    for (auto& viewProj : viewProjs) {
+        auto const from = random.Vec3(-100.0f, 100.0f);
+        auto const view = math::inverse_rigid(math::make_lookat(from, from + random.Direction(), vec3f_t(0.0f, 1.0f, 0.0f)));
+        viewProj = math::make_perspective_proj(random.Uniform(0.5f, 2.0f), random.Uniform(1.0f, 2.0f), 0.1f, random.Uniform(100.0f, 10000.0f)) * view;
+    }
+    Measure(suite, "geometry", "make_frustum", viewProjs, [](math::mat4x4f_t const& m) { return math::make_frustum(m); },
+        [](math::mat4x4f_t const& m, Expected& e) {
+            // rows r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2
+            int const rows[6] = { 0, 0, 1, 1, 2, 2 };
+            double const signs[6] = { 1.0, -1.0, 1.0, -1.0, 0.0, -1.0 };
+            for (auto plane = 0; plane < 6; ++plane) {
+                double values[4], magnitudes[4];
+                for (auto column = 0; column < 4; ++column) {
+                    double const a = plane == 4 ? 0.0 : m[column][3], b = plane == 4 ? m[column][2] : signs[plane] * m[column][rows[plane]];
+                    values[column] = a + b;
+                    magnitudes[column] = fabs(a) + fabs(b);
+                }
+                auto const length = ::sqrt(values[0] * values[0] + values[1] * values[1] + values[2] * values[2]);
+                for (auto column = 0; column < 4; ++column) { e.Push(values[column] / length, magnitudes[column] / length); }
+            }
+        }, 5.0);
+
+    // planes at an angle of at least ~18 degrees, dot(normal, p) = d
+    std::vector<PlanePair> planePairs(count);
+    std::vector<PlanePair> parallelPlanes(count);
+    for (auto i = 0u; i < count; ++i) {
+        plane_t a = { random.Direction(), random.Uniform(-100.0f, 100.0f) };
+        plane_t b;
+        do { b = { random.Direction(), random.Uniform(-100.0f, 100.0f) }; } while (math::squared_length(math::cross(a.normal, b.normal)) < 0.1f);
+        planePairs[i] = { a, b };
+        parallelPlanes[i] = { a, { (random.Next() & 1) ? a.normal : -a.normal, random.Uniform(-100.0f, 100.0f) } };
+    }
+    // the line is along cross(a, b), not normalized, through the point of it closest to the origin
+    Measure(suite, "geometry", "intersect_planes", planePairs,
+        [](PlanePair const& v) { line_t line; return math::intersect_planes(v.a, v.b, &line) ? line : NoLine(); },
+        [](PlanePair const& v, Expected& e) {
+            double const na[3] = { v.a.normal.x, v.a.normal.y, v.a.normal.z }, nb[3] = { v.b.normal.x, v.b.normal.y, v.b.normal.z };
+            double direction[3], ca[3], cb[3];
+            Cross(na, nb, direction);
+            Cross(nb, direction, ca);
+            Cross(direction, na, cb);
+            auto const det = direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2];
+            for (auto i = 0; i < 3; ++i) {
+                e.Push(direction[i], fabs(na[(i + 1) % 3] * nb[(i + 2) % 3]) + fabs(na[(i + 2) % 3] * nb[(i + 1) % 3]));
+            }
+            for (auto i = 0; i < 3; ++i) {
+                e.Push((ca[i] * v.a.d + cb[i] * v.b.d) / det, (fabs(v.a.d) + fabs(v.b.d)) / det);
+            }
+        }, 4.0);
+    Measure(suite, "geometry", "intersect_planes (parallel)", parallelPlanes,
+        [](PlanePair const& v) { line_t line; return math::intersect_planes(v.a, v.b, &line); },
+        [](PlanePair const&, Expected& e) { e.Push(0.0); }, 0.0);
+
+    // lines at least ~17 degrees off the plane
+    std::vector<LinePlane> linePlanes(count);
+    std::vector<LinePlane> parallelLines(count);
+    for (auto i = 0u; i < count; ++i) {
+        plane_t const plane = { random.Direction(), random.Uniform(-100.0f, 100.0f) };
+        line_t line = { random.Direction(), random.Vec3(-100.0f, 100.0f) };
+        while (fabsf(math::dot(line.normal, plane.normal)) < 0.3f) { line.normal = random.Direction(); }
+        linePlanes[i] = { line, plane };
+        auto across = math::cross(plane.normal, random.Direction());
+        while (math::squared_length(across) < 0.1f) { across = math::cross(plane.normal, random.Direction()); }
+        auto const along = math::normalize(across);
+        parallelLines[i] = { { along, random.Vec3(-100.0f, 100.0f) }, plane };
+    }
+    Measure(suite, "geometry", "intersect_line_x_plane", linePlanes,
+        [](LinePlane const& v) { vec3f_t p; return math::intersect_line_x_plane(v.line, v.plane, &p) ? p : vec3f_t(NAN); },
+        [](LinePlane const& v, Expected& e) {
+            auto const cosine = Dot(v.line.normal, v.plane.normal);
+            auto const t = (v.plane.d - Dot(v.line.p, v.plane.normal)) / cosine;
+            // p and d cancel in the distance to the plane, which the angle then scales
+            auto const spread = (sqrt(Dot(v.line.p, v.line.p)) + fabs(v.plane.d)) / fabs(cosine);
+            for (auto i = 0; i < 3; ++i) {
+                e.Push(v.line.p[i] + t * v.line.normal[i], fabs(v.line.p[i]) + spread * fabs(v.line.normal[i]));
+            }
+        }, 6.0);
+    Measure(suite, "geometry", "intersect_line_x_plane (parallel)", parallelLines,
+        [](LinePlane const& v) { vec3f_t p; return math::intersect_line_x_plane(v.line, v.plane, &p); },
+        [](LinePlane const&, Expected& e) { e.Push(0.0); }, 0.0);
+}
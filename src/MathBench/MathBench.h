@@ -0,0 +1,240 @@
+#pragma once
+
+#include <Runtime/Math/math_functions.h>
+#include <Runtime/util.h>
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+/*
+    *   Microbenchmarks and accuracy checks for every public function in math_functions.h, so work on the math library can be
+    *   measured and regressions caught. Every function is one case:
+    *       throughput  ns per call over independent inputs, results stored to memory
+    *       latency     ns per call when each call's input depends on the previous result (the first output float, times a
+    *                   zero the compiler can't see, is added to the next input). the cost of that feedback is measured with an
+    *                   empty function and subtracted
+    *       accuracy    every output float against a double precision reference written from the definition, not from the
+    *                   float code: max and mean error in ULPs and the share of correctly rounded (<= 0.5 ULP) values. the ULP is
+    *                   taken at a magnitude the reference picks, see Expected
+    *   Each case has a max ULP bound, a little above what the current implementation reaches. A case above its bound fails the
+    *   run (exit code 1), like the Benchmarks' checks. --csv prints one line per case to track the numbers across commits.
+*/
+namespace mini
+{
+    namespace mathbench
+    {
+        struct Options
+        {
+            uint32_t    scale   = 1;            // multiplies the number of inputs per case
+            bool        csv     = false;
+            char const* filter  = nullptr;      // only cases whose group or name contains this
+        };
+
+        struct ErrorStats
+        {
+            double      maxUlps     = 0.0;
+            double      sumUlps     = 0.0;
+            uint64_t    numValues   = 0;
+            uint64_t    numRounded  = 0;   // within 0.5 ULP, i.e. correctly rounded
+        };
+
+        struct CaseResult
+        {
+            char const* group;
+            char const* name;
+            double      throughputNs;
+            double      latencyNs;
+            ErrorStats  error;
+            double      boundUlps;
+        };
+
+        class Suite
+        {
+        public:
+            explicit Suite(Options const& options) : m_options(options) {}
+
+            Options const& GetOptions() const { return m_options; }
+            uint32_t GetCount() const { return 4096 * m_options.scale; }
+            bool IsSelected(char const* group, char const* name) const
+            {
+                return m_options.filter == nullptr || strstr(group, m_options.filter) != nullptr || strstr(name, m_options.filter) != nullptr;
+            }
+
+            void Add(CaseResult const& result);
+            bool Finish() const;    // summary, false if any case failed
+
+        private:
+            Options                 m_options;
+            std::vector<CaseResult> m_results;
+            double                  m_feedbackNs = -1.0;
+
+        public:
+            double GetFeedbackNs();     // latency loop overhead, measured once
+        };
+
+        // -----------------------------------------------------------
+        // -----------------------------------------------------------
+
+        template <class T>
+        inline void DoNotOptimize(T const& value)
+        {
+#if defined(_MSC_VER)
+            static volatile char sink;
+            sink = *reinterpret_cast<char const volatile*>(&value);
+#else
+            asm volatile("" : : "r,m"(value) : "memory");
+#endif
+        }
+
+        // @note    reference values in double, pushed in the order Flatten writes the floats. each comes with the magnitude its
+        //          error is measured in ULPs of: by default the value itself. results that are sums of products (dot products,
+        //          matrix products, inverses) can't be accurate relative to a component that cancels to near zero, those push
+        //          the sum of the absolute terms instead, the usual bound for a float dot product. functions with an absolute
+        //          error bound like fast_sin push 1.0
+        struct Expected
+        {
+            double      values[24];
+            double      magnitudes[24];
+            uint32_t    count = 0;
+
+            void Push(double v) { Push(v, fabs(v)); }
+            void Push(double v, double magnitude) { values[count] = v; magnitudes[count] = magnitude; ++count; }
+            void UseLargest()
+            {
+                double largest = 0.0;
+                for (auto i = 0u; i < count; ++i) { largest = fmax(largest, fabs(values[i])); }
+                for (auto i = 0u; i < count; ++i) { magnitudes[i] = largest; }
+            }
+        };
+
+        // xorshift32, the same inputs on every run and platform
+        struct Random
+        {
+            uint32_t state = 0x12345678u;
+
+            uint32_t Next() { state ^= state << 13; state ^= state >> 17; state ^= state << 5; return state; }
+            float Uniform(float lo, float hi) { return lo + (hi - lo) * static_cast<float>(Next() >> 8) * (1.0f / 16777216.0f); }
+            // magnitude in [lo, hi], random sign
+            float Signed(float lo, float hi) { auto const v = Uniform(lo, hi); return (Next() & 1) ? -v : v; }
+            math::vec3f_t Vec3(float lo, float hi) { auto const x = Uniform(lo, hi), y = Uniform(lo, hi); return math::vec3f_t(x, y, Uniform(lo, hi)); }
+            math::vec3f_t Direction()
+            {
+                for (;;) {
+                    auto const v = Vec3(-1.0f, 1.0f);
+                    auto const lengthSq = v.x * v.x + v.y * v.y + v.z * v.z;
+                    if (lengthSq > 0.01f && lengthSq <= 1.0f) { return v / sqrtf(lengthSq); }
+                }
+            }
+        };
+
+        inline uint32_t Flatten(float v, float* out) { out[0] = v; return 1; }
+        inline uint32_t Flatten(bool v, float* out) { out[0] = v ? 1.0f : 0.0f; return 1; }
+        inline uint32_t Flatten(math::vec2f_t const& v, float* out) { memcpy(out, v.elements, sizeof(v.elements)); return 2; }
+        inline uint32_t Flatten(math::vec3f_t const& v, float* out) { memcpy(out, v.elements, sizeof(v.elements)); return 3; }
+        inline uint32_t Flatten(math::vec4f_t const& v, float* out) { memcpy(out, v.elements, sizeof(v.elements)); return 4; }
+        inline uint32_t Flatten(math::quatf_t const& v, float* out) { memcpy(out, v.elements, sizeof(v.elements)); return 4; }
+        inline uint32_t Flatten(math::dualquatf_t const& v, float* out) { memcpy(out, v.real.elements, sizeof(v.real.elements)); memcpy(out + 4, v.dual.elements, sizeof(v.dual.elements)); return 8; }
+        inline uint32_t Flatten(math::mat4x4f_t const& v, float* out) { memcpy(out, v.elements, sizeof(v.elements)); return 16; }
+        inline uint32_t Flatten(math::mat3x4f_t const& v, float* out) { memcpy(out, v.elements, sizeof(v.elements)); return 12; }
+        inline uint32_t Flatten(math::line_t const& v, float* out)
+        {
+            memcpy(out, v.normal.elements, sizeof(v.normal.elements));
+            memcpy(out + 3, v.p.elements, sizeof(v.p.elements));
+            return 6;
+        }
+        inline uint32_t Flatten(math::frustum_t const& v, float* out)
+        {
+            for (auto i = 0; i < math::frustum_t::NUM_PLANES; ++i) {
+                memcpy(out + i * 4, v.planes[i].normal.elements, sizeof(v.planes[i].normal.elements));
+                out[i * 4 + 3] = v.planes[i].d;
+            }
+            return 4 * math::frustum_t::NUM_PLANES;
+        }
+
+        // distance between value and reference in float spacings at magnitude
+        inline double UlpError(float value, double reference, double magnitude)
+        {
+            if (isnan(reference) || isnan(value)) { return isnan(reference) && isnan(value) ? 0.0 : INFINITY; }
+            if (isinf(reference) || isinf(value)) { return value == reference ? 0.0 : INFINITY; }
+            if (magnitude == 0.0) { return value == reference ? 0.0 : INFINITY; }     // exact values, e.g. flags and zeros
+            magnitude = magnitude < FLT_MAX ? magnitude : FLT_MAX;
+            auto const m = static_cast<float>(magnitude);
+            auto const ulp = m < FLT_MIN ? ldexp(1.0, -149) : static_cast<double>(nextafterf(m, INFINITY)) - m;
+            return fabs(static_cast<double>(value) - reference) / ulp;
+        }
+
+        // @note    In has to be plain floats so the latency loop can feed the previous result into its first one. fn is the
+        //          float function under test, reference fills an Expected from the same input
+        template <class In, class Fn, class Reference>
+        void Measure(Suite& suite, char const* group, char const* name, std::vector<In> const& inputs, Fn&& fn, Reference&& reference,
+            double boundUlps)
+        {
+            static_assert(sizeof(In) % sizeof(float) == 0, "inputs have to be made of floats");
+            if (!suite.IsSelected(group, name)) { return; }
+            using Out = decltype(fn(inputs[0]));
+            auto const count = static_cast<uint32_t>(inputs.size());
+            auto const numRuns = 32u;
+
+            CaseResult result = { group, name, 0.0, 0.0, {}, boundUlps };
+            for (auto i = 0u; i < count; ++i) {
+                float values[24];
+                auto const numValues = Flatten(fn(inputs[i]), values);
+                Expected expected;
+                reference(inputs[i], expected);
+                for (auto k = 0u; k < numValues && k < expected.count; ++k) {
+                    auto const error = UlpError(values[k], expected.values[k], expected.magnitudes[k]);
+                    result.error.maxUlps = fmax(result.error.maxUlps, error);
+                    result.error.sumUlps += error;
+                    result.error.numRounded += error <= 0.5 ? 1 : 0;
+                    ++result.error.numValues;
+                }
+            }
+
+            std::vector<Out> outputs(count);
+            for (auto i = 0u; i < count; ++i) { outputs[i] = fn(inputs[i]); }    // warm up, and the pages of outputs get mapped
+            Timer timer;
+            for (auto run = 0u; run < numRuns; ++run) {
+                for (auto i = 0u; i < count; ++i) { outputs[i] = fn(inputs[i]); }
+                DoNotOptimize(outputs[run % count]);
+            }
+            result.throughputNs = timer.GetElapsedTime() * 1e9 / (static_cast<double>(numRuns) * count);
+
+            volatile float hiddenZero = 0.0f;
+            float const zero = hiddenZero;
+            float carry = 0.0f;
+            timer.Reset();
+            for (auto run = 0u; run < numRuns; ++run) {
+                for (auto i = 0u; i < count; ++i) {
+                    auto input = inputs[i];
+                    float first;
+                    memcpy(&first, &input, sizeof(first));
+                    first += carry;
+                    memcpy(&input, &first, sizeof(first));
+                    auto const output = fn(input);
+                    DoNotOptimize(output);
+                    float values[24];
+                    Flatten(output, values);
+                    carry = values[0] * zero;
+                }
+            }
+            DoNotOptimize(carry);
+            result.latencyNs = timer.GetElapsedTime() * 1e9 / (static_cast<double>(numRuns) * count) - suite.GetFeedbackNs();
+            result.latencyNs = result.latencyNs > 0.0 ? result.latencyNs : 0.0;
+            suite.Add(result);
+        }
+
+        // -----------------------------------------------------------
+
+        // cases per part of math_functions.h: ScalarCases.cpp, VectorCases.cpp, MatrixCases.cpp (quaternions too), GeometryCases.cpp
+        void RunScalarCases(Suite& suite);
+        void RunVectorCases(Suite& suite);
+        void RunQuaternionCases(Suite& suite);
+        void RunDualQuatCases(Suite& suite);
+        void RunMatrixCases(Suite& suite);
+        void RunGeometryCases(Suite& suite);
+    }
+}
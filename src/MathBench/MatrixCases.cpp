@@ -0,0 +1,647 @@
+#include "MathBench.h"
+
+namespace
+{
+    using namespace mini;
+    using namespace mini::mathbench;
+    using math::vec3f_t;
+    using math::vec4f_t;
+    using math::quatf_t;
+    using math::mat4x4f_t;
+    using math::mat3x4f_t;
+    using math::dualquatf_t;
+
+    // column major like mat4x4f_t: m[column * 4 + row]
+    struct DMat4
+    {
+        double m[16];
+
+        double& operator () (int row, int column) { return m[column * 4 + row]; }
+        double operator () (int row, int column) const { return m[column * 4 + row]; }
+    };
+
+    struct MatPair { mat4x4f_t a; mat4x4f_t b; };
+    struct MatVec { mat4x4f_t m; vec4f_t v; };
+    struct MatPos { mat4x4f_t m; vec3f_t p; };
+    struct AffinePair { mat3x4f_t a; mat3x4f_t b; };
+    struct AffinePos { mat3x4f_t m; vec3f_t p; };
+    struct QuatPair { quatf_t a; quatf_t b; };
+    struct QuatLerp { quatf_t a; quatf_t b; float t; };
+    struct RigidParts { quatf_t r; vec3f_t t; };
+    struct DualQuatPair { dualquatf_t a; dualquatf_t b; };
+    struct DualQuatPos { dualquatf_t dq; vec3f_t p; };
+    struct Blend4 { dualquatf_t dqs[4]; float weights[4]; };
+    struct AxisAngle { vec3f_t axis; float rad; };
+    struct Perspective { float fov; float aspect; float zNear; float zFar; };
+    struct Ortho { float left; float right; float bottom; float top; float zNear; float zFar; };
+    struct LookAt { vec3f_t from; vec3f_t to; vec3f_t up; };
+    struct Trs { vec3f_t t; quatf_t q; vec3f_t s; };
+
+    DMat4 ToDouble(mat4x4f_t const& mat)
+    {
+        DMat4 result;
+        for (auto i = 0; i < 16; ++i) { result.m[i] = mat.elements[i]; }
+        return result;
+    }
+
+    DMat4 ToDouble(mat3x4f_t const& mat)
+    {
+        DMat4 result;
+        for (auto column = 0; column < 4; ++column) {
+            for (auto row = 0; row < 3; ++row) { result(row, column) = mat[column][row]; }
+            result(3, column) = column == 3 ? 1.0 : 0.0;
+        }
+        return result;
+    }
+
+    // rows < rows of the result are pushed, 3 for the affine matrices. magnitudes are the sums of the absolute products
+    void PushProduct(DMat4 const& a, DMat4 const& b, int rows, Expected& e)
+    {
+        for (auto column = 0; column < 4; ++column) {
+            for (auto row = 0; row < rows; ++row) {
+                double sum = 0.0, magnitude = 0.0;
+                for (auto k = 0; k < 4; ++k) {
+                    sum += a(row, k) * b(k, column);
+                    magnitude += fabs(a(row, k) * b(k, column));
+                }
+                e.Push(sum, magnitude);
+            }
+        }
+    }
+
+    void PushTransform(DMat4 const& m, double const* v, int rows, Expected& e)
+    {
+        for (auto row = 0; row < rows; ++row) {
+            double sum = 0.0, magnitude = 0.0;
+            for (auto k = 0; k < 4; ++k) {
+                sum += m(row, k) * v[k];
+                magnitude += fabs(m(row, k) * v[k]);
+            }
+            e.Push(sum, magnitude);
+        }
+    }
+
+    void PushMatrix(DMat4 const& m, int rows, Expected& e)
+    {
+        for (auto column = 0; column < 4; ++column) {
+            for (auto row = 0; row < rows; ++row) { e.Push(m(row, column)); }
+        }
+    }
+
+    // Gauss-Jordan with partial pivoting
+    DMat4 Inverse(DMat4 a)
+    {
+        DMat4 inv = {};
+        for (auto i = 0; i < 4; ++i) { inv(i, i) = 1.0; }
+        for (auto column = 0; column < 4; ++column) {
+            auto pivot = column;
+            for (auto row = column + 1; row < 4; ++row) {
+                if (fabs(a(row, column)) > fabs(a(pivot, column))) { pivot = row; }
+            }
+            for (auto k = 0; k < 4; ++k) {
+                auto const t = a(column, k); a(column, k) = a(pivot, k); a(pivot, k) = t;
+                auto const u = inv(column, k); inv(column, k) = inv(pivot, k); inv(pivot, k) = u;
+            }
+            auto const scale = 1.0 / a(column, column);
+            for (auto k = 0; k < 4; ++k) { a(column, k) *= scale; inv(column, k) *= scale; }
+            for (auto row = 0; row < 4; ++row) {
+                if (row == column) { continue; }
+                auto const f = a(row, column);
+                for (auto k = 0; k < 4; ++k) { a(row, k) -= f * a(column, k); inv(row, k) -= f * inv(column, k); }
+            }
+        }
+        return inv;
+    }
+
+    DMat4 QuatToMat(double w, double x, double y, double z)
+    {
+        DMat4 m = {};
+        m(0, 0) = 1.0 - 2.0 * (y * y + z * z);  m(0, 1) = 2.0 * (x * y - z * w);        m(0, 2) = 2.0 * (x * z + y * w);
+        m(1, 0) = 2.0 * (x * y + z * w);        m(1, 1) = 1.0 - 2.0 * (x * x + z * z);  m(1, 2) = 2.0 * (y * z - x * w);
+        m(2, 0) = 2.0 * (x * z - y * w);        m(2, 1) = 2.0 * (y * z + x * w);        m(2, 2) = 1.0 - 2.0 * (x * x + y * y);
+        m(3, 3) = 1.0;
+        return m;
+    }
+
+    // a quaternion and its negation are the same rotation, the one whose largest component is positive is compared
+    quatf_t Canonical(quatf_t q)
+    {
+        auto largest = 0;
+        for (auto i = 1; i < 4; ++i) { largest = fabsf(q.elements[i]) > fabsf(q.elements[largest]) ? i : largest; }
+        if (q.elements[largest] < 0.0f) { q = quatf_t(-q.w, -q.x, -q.y, -q.z); }
+        return q;
+    }
+
+    // both parts flipped with the real one
+    dualquatf_t Canonical(dualquatf_t const& dq)
+    {
+        auto largest = 0;
+        for (auto i = 1; i < 4; ++i) { largest = fabsf(dq.real.elements[i]) > fabsf(dq.real.elements[largest]) ? i : largest; }
+        if (dq.real.elements[largest] >= 0.0f) { return dq; }
+        return dualquatf_t(quatf_t(-dq.real.w, -dq.real.x, -dq.real.y, -dq.real.z), quatf_t(-dq.dual.w, -dq.dual.x, -dq.dual.y, -dq.dual.z));
+    }
+
+    void PushCanonical(double* q, Expected& e)
+    {
+        auto largest = 0;
+        for (auto i = 1; i < 4; ++i) { largest = fabs(q[i]) > fabs(q[largest]) ? i : largest; }
+        auto const sign = q[largest] < 0.0 ? -1.0 : 1.0;
+        for (auto i = 0; i < 4; ++i) { e.Push(q[i] * sign, 1.0); }
+    }
+
+    quatf_t RandomRotation(Random& random)
+    {
+        auto const axis = random.Direction();
+        auto const half = random.Uniform(-3.14159265f, 3.14159265f) * 0.5f;
+        auto const s = sinf(half);
+        return quatf_t(cosf(half), axis.x * s, axis.y * s, axis.z * s);
+    }
+
+    mat4x4f_t RandomMatrix(Random& random, float lo, float hi)
+    {
+        mat4x4f_t m;
+        for (auto& v : m.elements) { v = random.Signed(lo, hi); }
+        return m;
+    }
+
+    // translation, rotation and scales in [0.5, 2]: condition numbers below 4
+    mat3x4f_t RandomTrs(Random& random)
+    {
+        auto const scale = random.Vec3(0.5f, 2.0f);
+        return math::make_affine(random.Vec3(-10.0f, 10.0f), RandomRotation(random), scale);
+    }
+
+    mat3x4f_t RandomRigid(Random& random)
+    {
+        return math::make_affine(random.Vec3(-10.0f, 10.0f), RandomRotation(random), vec3f_t(1.0f));
+    }
+
+    dualquatf_t RandomDualQuat(Random& random)
+    {
+        return math::make_dualquat(RandomRotation(random), random.Vec3(-10.0f, 10.0f));
+    }
+
+    // the reference takes the eigenvector way out: from the largest of the four diagonal combinations, then normalized
+    void QuatFromMat(DMat4 const& m, double* q)
+    {
+        double const candidates[4] = { 1.0 + m(0, 0) + m(1, 1) + m(2, 2), 1.0 + m(0, 0) - m(1, 1) - m(2, 2), 1.0 - m(0, 0) + m(1, 1) - m(2, 2), 1.0 - m(0, 0) - m(1, 1) + m(2, 2) };
+        auto largest = 0;
+        for (auto i = 1; i < 4; ++i) { largest = candidates[i] > candidates[largest] ? i : largest; }
+        auto const s = 0.5 / ::sqrt(candidates[largest]);
+        q[largest] = 0.25 / s;
+        auto const wx = (m(2, 1) - m(1, 2)) * s, wy = (m(0, 2) - m(2, 0)) * s, wz = (m(1, 0) - m(0, 1)) * s;
+        auto const xy = (m(0, 1) + m(1, 0)) * s, xz = (m(0, 2) + m(2, 0)) * s, yz = (m(1, 2) + m(2, 1)) * s;
+        switch (largest) {
+            case 0: q[1] = wx; q[2] = wy; q[3] = wz; break;
+            case 1: q[0] = wx; q[2] = xy; q[3] = xz; break;
+            case 2: q[0] = wy; q[1] = xy; q[3] = yz; break;
+            default: q[0] = wz; q[1] = xz; q[2] = yz; break;
+        }
+        auto const length = ::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        for (auto i = 0; i < 4; ++i) { q[i] /= length; }
+    }
+
+    // Hamilton product in double, with the sums of the absolute terms
+    void QuatMul(double const* a, double const* b, double* out, double* outMagnitudes)
+    {
+        double const terms[4][4] = {
+            { a[0] * b[0], -a[1] * b[1], -a[2] * b[2], -a[3] * b[3] },
+            { a[0] * b[1], a[1] * b[0], a[2] * b[3], -a[3] * b[2] },
+            { a[0] * b[2], a[2] * b[0], a[3] * b[1], -a[1] * b[3] },
+            { a[0] * b[3], a[3] * b[0], a[1] * b[2], -a[2] * b[1] },
+        };
+        for (auto i = 0; i < 4; ++i) {
+            out[i] = terms[i][0] + terms[i][1] + terms[i][2] + terms[i][3];
+            outMagnitudes[i] = fabs(terms[i][0]) + fabs(terms[i][1]) + fabs(terms[i][2]) + fabs(terms[i][3]);
+        }
+    }
+
+    // 2 * dual * conjugate(real), the translation of a unit dual quaternion
+    void DualQuatTranslation(dualquatf_t const& dq, double* out)
+    {
+        double const d[4] = { dq.dual.w, dq.dual.x, dq.dual.y, dq.dual.z }, rc[4] = { dq.real.w, -dq.real.x, -dq.real.y, -dq.real.z };
+        double product[4], magnitudes[4];
+        QuatMul(d, rc, product, magnitudes);
+        for (auto i = 0; i < 3; ++i) { out[i] = 2.0 * product[i + 1]; }
+    }
+
+    // q and b in double, b flipped to a's side, reference for nlerp and slerp
+    void PushInterpolated(QuatLerp const& v, bool spherical, Expected& e)
+    {
+        double const a[4] = { v.a.w, v.a.x, v.a.y, v.a.z };
+        double b[4] = { v.b.w, v.b.x, v.b.y, v.b.z };
+        auto const d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        for (auto& c : b) { c = d < 0.0 ? -c : c; }
+        double wa = 1.0 - v.t, wb = v.t;
+        if (spherical) {
+            double diff = 0.0, sum = 0.0;
+            for (auto i = 0; i < 4; ++i) { diff += (a[i] - b[i]) * (a[i] - b[i]); sum += (a[i] + b[i]) * (a[i] + b[i]); }
+            auto const angle = 2.0 * ::atan2(::sqrt(diff), ::sqrt(sum));
+            if (::sin(angle) > 1e-12) {
+                wa = ::sin((1.0 - v.t) * angle) / ::sin(angle);
+                wb = ::sin(v.t * angle) / ::sin(angle);
+            }
+        }
+        double r[4], length = 0.0;
+        for (auto i = 0; i < 4; ++i) { r[i] = a[i] * wa + b[i] * wb; length += r[i] * r[i]; }
+        length = spherical ? 1.0 : ::sqrt(length);
+        for (auto i = 0; i < 4; ++i) { e.Push(r[i] / length, 1.0); }
+    }
+}
+
+void mini::mathbench::RunQuaternionCases(Suite& suite)
+{
+    auto const count = suite.GetCount();
+    Random random;
+    std::vector<QuatPair> pairs(count);
+    std::vector<quatf_t> rotations(count);
+    std::vector<quatf_t> scaled(count);
+    std::vector<AxisAngle> axisAngles(count);
+    std::vector<mat4x4f_t> rotationMatrices(count);
+    for (auto i = 0u; i < count; ++i) {
+        pairs[i] = { RandomRotation(random), RandomRotation(random) };
+        rotations[i] = RandomRotation(random);
+        auto const s = random.Uniform(0.1f, 10.0f);
+        auto const& q = rotations[i];
+        scaled[i] = quatf_t(q.w * s, q.x * s, q.y * s, q.z * s);
+        axisAngles[i] = { random.Vec3(-10.0f, 10.0f), random.Uniform(-6.28f, 6.28f) };
+        auto const r = RandomRotation(random);
+        auto const m = QuatToMat(r.w, r.x, r.y, r.z);
+        for (auto k = 0; k < 16; ++k) { rotationMatrices[i].elements[k] = static_cast<float>(m.m[k]); }
+    }
+
+    Measure(suite, "quat", "a * b", pairs, [](QuatPair const& v) { return v.a * v.b; },
+        [](QuatPair const& v, Expected& e) {
+            double const aw = v.a.w, ax = v.a.x, ay = v.a.y, az = v.a.z, bw = v.b.w, bx = v.b.x, by = v.b.y, bz = v.b.z;
+            double const terms[4][4] = {
+                { aw * bw, -ax * bx, -ay * by, -az * bz },
+                { aw * bx, ax * bw, ay * bz, -az * by },
+                { aw * by, ay * bw, az * bx, -ax * bz },
+                { aw * bz, az * bw, ax * by, -ay * bx },
+            };
+            for (auto const& t : terms) { e.Push(t[0] + t[1] + t[2] + t[3], fabs(t[0]) + fabs(t[1]) + fabs(t[2]) + fabs(t[3])); }
+        }, 2.5);
+
+    auto const pushNormalized = [](quatf_t const& q, Expected& e) {
+        double const length = ::sqrt(static_cast<double>(q.w) * q.w + static_cast<double>(q.x) * q.x + static_cast<double>(q.y) * q.y + static_cast<double>(q.z) * q.z);
+        for (auto v : q.elements) { e.Push(v / length); }
+    };
+    Measure(suite, "quat", "normalize", scaled, [](quatf_t const& q) { return math::normalize(q); }, pushNormalized, 3.0);
+    Measure(suite, "quat", "normalize_safe", scaled, [](quatf_t const& q) { return math::normalize_safe(q); }, pushNormalized, 3.0);
+    Measure(suite, "quat", "inverse", scaled, [](quatf_t const& q) { return math::inverse(q); },
+        [](quatf_t const& q, Expected& e) {
+            double const d = static_cast<double>(q.w) * q.w + static_cast<double>(q.x) * q.x + static_cast<double>(q.y) * q.y + static_cast<double>(q.z) * q.z;
+            e.Push(q.w / d); e.Push(-q.x / d); e.Push(-q.y / d); e.Push(-q.z / d);
+        }, 3.5);
+
+    Measure(suite, "quat", "angle_axis", axisAngles, [](AxisAngle const& v) { return math::angle_axis(v.axis, v.rad); },
+        [](AxisAngle const& v, Expected& e) {
+            double const length = ::sqrt(static_cast<double>(v.axis.x) * v.axis.x + static_cast<double>(v.axis.y) * v.axis.y + static_cast<double>(v.axis.z) * v.axis.z);
+            double const s = ::sin(0.5 * v.rad), c = ::cos(0.5 * v.rad);
+            e.Push(c, 1.0);
+            for (auto i = 0; i < 3; ++i) { e.Push(v.axis[i] / length * s, 1.0); }
+        }, 2.0);
+
+    Measure(suite, "quat", "quat_to_mat", rotations, [](quatf_t const& q) { return math::quat_to_mat(q); },
+        [](quatf_t const& q, Expected& e) { PushMatrix(QuatToMat(q.w, q.x, q.y, q.z), 4, e); e.UseLargest(); }, 3.0);
+
+    // @note    the float matrix is a rotation rounded to float, its quaternion is found in double
+    Measure(suite, "quat", "quat_from_mat", rotationMatrices, [](mat4x4f_t const& m) { return Canonical(math::quat_from_mat(m)); },
+        [](mat4x4f_t const& mat, Expected& e) { double q[4]; QuatFromMat(ToDouble(mat), q); PushCanonical(q, e); }, 4.0);
+
+    // -- interpolation, half of the pairs a few degrees apart like neighbouring keys and either sign
+
+    std::vector<QuatLerp> lerps(count);
+    for (auto i = 0u; i < count; ++i) {
+        auto const a = RandomRotation(random);
+        auto b = (i & 1) ? a * math::angle_axis(random.Direction(), random.Uniform(0.0f, 0.2f)) : RandomRotation(random);
+        b = (random.Next() & 1) ? quatf_t(-b.w, -b.x, -b.y, -b.z) : b;
+        lerps[i] = { a, b, random.Uniform(0.0f, 1.0f) };
+    }
+    Measure(suite, "quat", "nlerp", lerps, [](QuatLerp const& v) { return math::nlerp(v.a, v.b, v.t); },
+        [](QuatLerp const& v, Expected& e) { PushInterpolated(v, false, e); }, 6.0);
+    // @note    measured against 1 since the angle from fast_atan2 is off by up to 8e-7 in absolute terms
+    Measure(suite, "quat", "slerp", lerps, [](QuatLerp const& v) { return math::slerp(v.a, v.b, v.t); },
+        [](QuatLerp const& v, Expected& e) { PushInterpolated(v, true, e); }, 4.0);
+    Measure(suite, "quat", "fast_normalize", scaled, [](quatf_t const& q) { return math::fast_normalize(q); }, pushNormalized, 6.0);
+}
+
+void mini::mathbench::RunDualQuatCases(Suite& suite)
+{
+    auto const count = suite.GetCount();
+    Random random;
+    std::vector<RigidParts> parts(count);
+    std::vector<dualquatf_t> dualQuats(count);
+    std::vector<mat3x4f_t> rigids(count);
+    std::vector<DualQuatPair> pairs(count);
+    std::vector<DualQuatPos> positions(count);
+    std::vector<Blend4> blends(count);
+    for (auto i = 0u; i < count; ++i) {
+        parts[i] = { RandomRotation(random), random.Vec3(-10.0f, 10.0f) };
+        dualQuats[i] = RandomDualQuat(random);
+        rigids[i] = RandomRigid(random);
+        pairs[i] = { RandomDualQuat(random), RandomDualQuat(random) };
+        positions[i] = { RandomDualQuat(random), random.Vec3(-10.0f, 10.0f) };
+        // the bones a vertex is skinned to are within ~30 degrees of each other, stored with either sign
+        auto const base = RandomRotation(random);
+        auto sum = 0.0f;
+        for (auto k = 0; k < 4; ++k) {
+            auto r = base * math::angle_axis(random.Direction(), random.Uniform(0.0f, 0.5f));
+            r = (random.Next() & 1) ? quatf_t(-r.w, -r.x, -r.y, -r.z) : r;
+            blends[i].dqs[k] = math::make_dualquat(r, random.Vec3(-10.0f, 10.0f));
+            blends[i].weights[k] = random.Uniform(0.05f, 1.0f);
+            sum += blends[i].weights[k];
+        }
+        for (auto& w : blends[i].weights) { w /= sum; }
+    }
+
+    Measure(suite, "dualquat", "make_dualquat", parts, [](RigidParts const& v) { return math::make_dualquat(v.r, v.t); },
+        [](RigidParts const& v, Expected& e) {
+            for (auto c : v.r.elements) { e.Push(c); }
+            double const t[4] = { 0.0, v.t.x, v.t.y, v.t.z }, r[4] = { v.r.w, v.r.x, v.r.y, v.r.z };
+            double dual[4], magnitudes[4];
+            QuatMul(t, r, dual, magnitudes);
+            for (auto i = 0; i < 4; ++i) { e.Push(0.5 * dual[i], 0.5 * magnitudes[i]); }
+        }, 2.0);
+
+    // the translation is rounded relative to its length, the real part's errors times it end up in the dual part
+    Measure(suite, "dualquat", "dualquat_to_mat", dualQuats, [](dualquatf_t const& dq) { return math::dualquat_to_mat(dq); },
+        [](dualquatf_t const& dq, Expected& e) {
+            auto const r = QuatToMat(dq.real.w, dq.real.x, dq.real.y, dq.real.z);
+            for (auto column = 0; column < 3; ++column) {
+                for (auto row = 0; row < 3; ++row) { e.Push(r(row, column), 1.0); }
+            }
+            double t[3];
+            DualQuatTranslation(dq, t);
+            auto const length = ::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+            for (auto i = 0; i < 3; ++i) { e.Push(t[i], length); }
+        }, 4.0);
+    Measure(suite, "dualquat", "dualquat_from_mat", rigids, [](mat3x4f_t const& m) { return Canonical(math::dualquat_from_mat(m)); },
+        [](mat3x4f_t const& mat, Expected& e) {
+            double q[4];
+            QuatFromMat(ToDouble(mat), q);
+            auto largest = 0;
+            for (auto i = 1; i < 4; ++i) { largest = fabs(q[i]) > fabs(q[largest]) ? i : largest; }
+            if (q[largest] < 0.0) { for (auto& c : q) { c = -c; } }
+            double const t[4] = { 0.0, mat[3].x, mat[3].y, mat[3].z };
+            double dual[4], magnitudes[4];
+            QuatMul(t, q, dual, magnitudes);
+            auto const length = ::sqrt(t[1] * t[1] + t[2] * t[2] + t[3] * t[3]);
+            for (auto i = 0; i < 4; ++i) { e.Push(q[i], 1.0); }
+            for (auto i = 0; i < 4; ++i) { e.Push(0.5 * dual[i], 0.5 * length); }
+        }, 6.0);
+
+    Measure(suite, "dualquat", "a * b", pairs, [](DualQuatPair const& v) { return v.a * v.b; },
+        [](DualQuatPair const& v, Expected& e) {
+            double const ar[4] = { v.a.real.w, v.a.real.x, v.a.real.y, v.a.real.z }, ad[4] = { v.a.dual.w, v.a.dual.x, v.a.dual.y, v.a.dual.z };
+            double const br[4] = { v.b.real.w, v.b.real.x, v.b.real.y, v.b.real.z }, bd[4] = { v.b.dual.w, v.b.dual.x, v.b.dual.y, v.b.dual.z };
+            double real[4], realMagnitudes[4], rd[4], rdMagnitudes[4], dr[4], drMagnitudes[4];
+            QuatMul(ar, br, real, realMagnitudes);
+            QuatMul(ar, bd, rd, rdMagnitudes);
+            QuatMul(ad, br, dr, drMagnitudes);
+            for (auto i = 0; i < 4; ++i) { e.Push(real[i], realMagnitudes[i]); }
+            for (auto i = 0; i < 4; ++i) { e.Push(rd[i] + dr[i], rdMagnitudes[i] + drMagnitudes[i]); }
+        }, 3.0);
+
+    Measure(suite, "dualquat", "transform_pos", positions, [](DualQuatPos const& v) { return math::transform_pos(v.dq, v.p); },
+        [](DualQuatPos const& v, Expected& e) {
+            auto const r = QuatToMat(v.dq.real.w, v.dq.real.x, v.dq.real.y, v.dq.real.z);
+            double t[3];
+            DualQuatTranslation(v.dq, t);
+            auto const lengthP = ::sqrt(static_cast<double>(v.p.x) * v.p.x + static_cast<double>(v.p.y) * v.p.y + static_cast<double>(v.p.z) * v.p.z);
+            auto const lengthT = ::sqrt(t[0] * t[0] + t[1] * t[1] + t[2] * t[2]);
+            for (auto row = 0; row < 3; ++row) {
+                e.Push(r(row, 0) * v.p.x + r(row, 1) * v.p.y + r(row, 2) * v.p.z + t[row], lengthP + lengthT);
+            }
+        }, 4.0);
+
+    Measure(suite, "dualquat", "dualquat_blend (4)", blends, [](Blend4 const& v) { return math::dualquat_blend(v.dqs, v.weights, 4); },
+        [](Blend4 const& v, Expected& e) {
+            auto const& pivot = v.dqs[0].real;
+            double sum[8] = {}, magnitudes[8] = {};
+            for (auto k = 0; k < 4; ++k) {
+                auto const& r = v.dqs[k].real;
+                auto const d = static_cast<double>(pivot.w) * r.w + static_cast<double>(pivot.x) * r.x + static_cast<double>(pivot.y) * r.y + static_cast<double>(pivot.z) * r.z;
+                auto const w = d < 0.0 ? -static_cast<double>(v.weights[k]) : static_cast<double>(v.weights[k]);
+                for (auto i = 0; i < 4; ++i) {
+                    sum[i] += w * v.dqs[k].real.elements[i];
+                    sum[i + 4] += w * v.dqs[k].dual.elements[i];
+                    magnitudes[i + 4] += fabs(w * v.dqs[k].dual.elements[i]);
+                }
+            }
+            auto const length = ::sqrt(sum[0] * sum[0] + sum[1] * sum[1] + sum[2] * sum[2] + sum[3] * sum[3]);
+            double along = 0.0, alongMagnitude = 0.0;
+            for (auto i = 0; i < 4; ++i) {
+                along += sum[i] * sum[i + 4] / (length * length);
+                alongMagnitude += fabs(sum[i]) * magnitudes[i + 4] / (length * length);
+            }
+            for (auto i = 0; i < 4; ++i) { e.Push(sum[i] / length, 1.0); }
+            // the dual part loses its component along the real one, a dot product rounded relative to its absolute terms
+            for (auto i = 0; i < 4; ++i) { e.Push(sum[i + 4] / length - sum[i] / length * along, (magnitudes[i + 4] + fabs(sum[i]) * alongMagnitude) / length); }
+        }, 6.0);
+}
+
+void mini::mathbench::RunMatrixCases(Suite& suite)
+{
+    auto const count = suite.GetCount();
+    Random random;
+    std::vector<MatPair> matPairs(count);
+    std::vector<MatVec> matVecs(count);
+    std::vector<MatPos> matPositions(count);
+    std::vector<AffinePair> affinePairs(count);
+    std::vector<AffinePos> affinePositions(count);
+    std::vector<mat4x4f_t> matrices(count);
+    std::vector<mat4x4f_t> trsMatrices(count);
+    std::vector<mat3x4f_t> affines(count);
+    std::vector<mat4x4f_t> rigidMatrices(count);
+    std::vector<mat3x4f_t> rigidAffines(count);
+    for (auto i = 0u; i < count; ++i) {
+        matPairs[i] = { RandomMatrix(random, 0.0f, 10.0f), RandomMatrix(random, 0.0f, 10.0f) };
+        matVecs[i] = { RandomMatrix(random, 0.0f, 10.0f), vec4f_t(random.Vec3(-10.0f, 10.0f), random.Uniform(-10.0f, 10.0f)) };
+        matPositions[i] = { RandomMatrix(random, 0.0f, 10.0f), random.Vec3(-10.0f, 10.0f) };
+        affinePairs[i] = { RandomTrs(random), RandomTrs(random) };
+        affinePositions[i] = { RandomTrs(random), random.Vec3(-10.0f, 10.0f) };
+        matrices[i] = RandomMatrix(random, 0.0f, 10.0f);
+        affines[i] = RandomTrs(random);
+        trsMatrices[i] = math::to_mat4x4(RandomTrs(random));
+        rigidAffines[i] = RandomRigid(random);
+        rigidMatrices[i] = math::to_mat4x4(RandomRigid(random));
+    }
+
+    // -- products and transforms
+
+    Measure(suite, "matrix", "mat4x4 * mat4x4", matPairs, [](MatPair const& v) { return v.a * v.b; },
+        [](MatPair const& v, Expected& e) { PushProduct(ToDouble(v.a), ToDouble(v.b), 4, e); }, 3.0);
+    Measure(suite, "matrix", "mat4x4 * vec4", matVecs, [](MatVec const& v) { return v.m * v.v; },
+        [](MatVec const& v, Expected& e) { double const p[4] = { v.v.x, v.v.y, v.v.z, v.v.w }; PushTransform(ToDouble(v.m), p, 4, e); }, 3.0);
+    Measure(suite, "matrix", "transform_pos mat4x4", matPositions, [](MatPos const& v) { return math::transform_pos(v.m, v.p); },
+        [](MatPos const& v, Expected& e) { double const p[4] = { v.p.x, v.p.y, v.p.z, 1.0 }; PushTransform(ToDouble(v.m), p, 3, e); }, 3.0);
+    Measure(suite, "matrix", "transform_dir mat4x4", matPositions, [](MatPos const& v) { return math::transform_dir(v.m, v.p); },
+        [](MatPos const& v, Expected& e) { double const p[4] = { v.p.x, v.p.y, v.p.z, 0.0 }; PushTransform(ToDouble(v.m), p, 3, e); }, 3.0);
+
+    Measure(suite, "matrix", "mat3x4 * mat3x4", affinePairs, [](AffinePair const& v) { return v.a * v.b; },
+        [](AffinePair const& v, Expected& e) { PushProduct(ToDouble(v.a), ToDouble(v.b), 3, e); }, 3.0);
+    Measure(suite, "matrix", "transform_pos mat3x4", affinePositions, [](AffinePos const& v) { return math::transform_pos(v.m, v.p); },
+        [](AffinePos const& v, Expected& e) { double const p[4] = { v.p.x, v.p.y, v.p.z, 1.0 }; PushTransform(ToDouble(v.m), p, 3, e); }, 3.0);
+    Measure(suite, "matrix", "transform_dir mat3x4", affinePositions, [](AffinePos const& v) { return math::transform_dir(v.m, v.p); },
+        [](AffinePos const& v, Expected& e) { double const p[4] = { v.p.x, v.p.y, v.p.z, 0.0 }; PushTransform(ToDouble(v.m), p, 3, e); }, 3.0);
+
+    // -- element shuffles, exact
+
+    Measure(suite, "matrix", "to_affine", trsMatrices, [](mat4x4f_t const& m) { return math::to_affine(m); },
+        [](mat4x4f_t const& m, Expected& e) { PushMatrix(ToDouble(m), 3, e); }, 0.0);
+    Measure(suite, "matrix", "to_mat4x4", affines, [](mat3x4f_t const& m) { return math::to_mat4x4(m); },
+        [](mat3x4f_t const& m, Expected& e) { PushMatrix(ToDouble(m), 4, e); }, 0.0);
+    Measure(suite, "matrix", "transpose", matrices, [](mat4x4f_t const& m) { return math::transpose(m); },
+        [](mat4x4f_t const& m, Expected& e) { for (auto column = 0; column < 4; ++column) { for (auto row = 0; row < 4; ++row) { e.Push(m[row][column]); } } }, 0.0);
+    Measure(suite, "matrix", "column", matrices, [](mat4x4f_t const& m) { return math::column(m, 2); },
+        [](mat4x4f_t const& m, Expected& e) { for (auto row = 0; row < 4; ++row) { e.Push(m[2][row]); } }, 0.0);
+    Measure(suite, "matrix", "row", matrices, [](mat4x4f_t const& m) { return math::row(m, 2); },
+        [](mat4x4f_t const& m, Expected& e) { for (auto column = 0; column < 4; ++column) { e.Push(m[column][2]); } }, 0.0);
+
+    // -- inverses, in ULPs of the largest element like the kernels document them
+
+    Measure(suite, "matrix", "inverse mat4x4", trsMatrices, [](mat4x4f_t const& m) { return math::inverse(m); },
+        [](mat4x4f_t const& m, Expected& e) { PushMatrix(Inverse(ToDouble(m)), 4, e); e.UseLargest(); }, 32.0);
+    Measure(suite, "matrix", "inverse mat3x4", affines, [](mat3x4f_t const& m) { return math::inverse(m); },
+        [](mat3x4f_t const& m, Expected& e) { PushMatrix(Inverse(ToDouble(m)), 3, e); e.UseLargest(); }, 32.0);
+
+    // the inverse of a rigid transform is defined as the transposed rotation and the rotated back translation, the float
+    // rotation isn't exactly orthonormal so that's what the reference computes
+    auto const pushRigidInverse = [](DMat4 const& m, int rows, Expected& e) {
+        DMat4 inv = {};
+        for (auto column = 0; column < 3; ++column) {
+            for (auto row = 0; row < 3; ++row) { inv(row, column) = m(column, row); }
+        }
+        inv(3, 3) = 1.0;
+        for (auto column = 0; column < 4; ++column) {
+            for (auto row = 0; row < rows; ++row) {
+                if (column < 3) { e.Push(inv(row, column)); continue; }
+                double sum = 0.0, magnitude = 0.0;
+                for (auto k = 0; k < 3; ++k) {
+                    sum -= inv(row, k) * m(k, 3);
+                    magnitude += fabs(inv(row, k) * m(k, 3));
+                }
+                e.Push(row < 3 ? sum : 1.0, row < 3 ? magnitude : 1.0);
+            }
+        }
+    };
+    Measure(suite, "matrix", "inverse_rigid mat4x4", rigidMatrices, [](mat4x4f_t const& m) { return math::inverse_rigid(m); },
+        [&](mat4x4f_t const& m, Expected& e) { pushRigidInverse(ToDouble(m), 4, e); }, 2.0);
+    Measure(suite, "matrix", "inverse_rigid mat3x4", rigidAffines, [](mat3x4f_t const& m) { return math::inverse_rigid(m); },
+        [&](mat3x4f_t const& m, Expected& e) { pushRigidInverse(ToDouble(m), 3, e); }, 2.0);
+
+    // -- builders
+
+    std::vector<vec3f_t> vectors(count);
+    std::vector<AxisAngle> axisAngles(count);
+    std::vector<Perspective> perspectives(count);
+    std::vector<Ortho> orthos(count);
+    std::vector<LookAt> lookAts(count);
+    std::vector<Trs> trs(count);
+    for (auto i = 0u; i < count; ++i) {
+        vectors[i] = random.Vec3(-100.0f, 100.0f);
+        axisAngles[i] = { random.Vec3(-10.0f, 10.0f), random.Uniform(-6.28f, 6.28f) };
+        auto const zNear = random.Uniform(0.01f, 1.0f);
+        perspectives[i] = { random.Uniform(0.2f, 2.5f), random.Uniform(0.5f, 2.5f), zNear, zNear * random.Uniform(10.0f, 10000.0f) };
+        auto const left = random.Uniform(-100.0f, 100.0f), bottom = random.Uniform(-100.0f, 100.0f);
+        orthos[i] = { left, left + random.Uniform(1.0f, 100.0f), bottom, bottom + random.Uniform(1.0f, 100.0f), zNear, zNear + random.Uniform(1.0f, 1000.0f) };
+        auto const from = random.Vec3(-10.0f, 10.0f);
+        auto const direction = random.Direction() * random.Uniform(1.0f, 10.0f);
+        auto up = random.Direction();
+        while (fabsf(math::dot(up, direction)) > 0.9f * math::length(direction)) { up = random.Direction(); }    // not along the view direction
+        lookAts[i] = { from, from + direction, up };
+        trs[i] = { random.Vec3(-10.0f, 10.0f), RandomRotation(random), random.Vec3(0.5f, 2.0f) };
+    }
+
+    Measure(suite, "make", "make_translation", vectors, [](vec3f_t const& v) { return math::make_translation(v); },
+        [](vec3f_t const& v, Expected& e) {
+            DMat4 m = {};
+            for (auto i = 0; i < 4; ++i) { m(i, i) = 1.0; }
+            for (auto i = 0; i < 3; ++i) { m(i, 3) = v[i]; }
+            PushMatrix(m, 4, e);
+        }, 0.0);
+    Measure(suite, "make", "make_scale", vectors, [](vec3f_t const& v) { return math::make_scale(v); },
+        [](vec3f_t const& v, Expected& e) {
+            DMat4 m = {};
+            for (auto i = 0; i < 3; ++i) { m(i, i) = v[i]; }
+            m(3, 3) = 1.0;
+            PushMatrix(m, 4, e);
+        }, 0.0);
+    // Rodrigues' rotation formula around the normalized axis
+    Measure(suite, "make", "make_rotation", axisAngles, [](AxisAngle const& v) { return math::make_rotation(v.axis, v.rad); },
+        [](AxisAngle const& v, Expected& e) {
+            double const length = ::sqrt(static_cast<double>(v.axis.x) * v.axis.x + static_cast<double>(v.axis.y) * v.axis.y + static_cast<double>(v.axis.z) * v.axis.z);
+            double const n[3] = { v.axis.x / length, v.axis.y / length, v.axis.z / length };
+            double const c = ::cos(static_cast<double>(v.rad)), s = ::sin(static_cast<double>(v.rad));
+            DMat4 m = {};
+            for (auto row = 0; row < 3; ++row) {
+                for (auto column = 0; column < 3; ++column) { m(row, column) = (1.0 - c) * n[row] * n[column] + (row == column ? c : 0.0); }
+            }
+            m(0, 1) -= s * n[2]; m(1, 0) += s * n[2];
+            m(0, 2) += s * n[1]; m(2, 0) -= s * n[1];
+            m(1, 2) -= s * n[0]; m(2, 1) += s * n[0];
+            m(3, 3) = 1.0;
+            PushMatrix(m, 4, e);
+            e.UseLargest();
+        }, 6.0);
+    Measure(suite, "make", "make_perspective_proj", perspectives, [](Perspective const& v) { return math::make_perspective_proj(v.fov, v.aspect, v.zNear, v.zFar); },
+        [](Perspective const& v, Expected& e) {
+            double const yScale = 1.0 / ::tan(0.5 * v.fov), zn = v.zNear, zf = v.zFar;
+            DMat4 m = {};
+            m(0, 0) = yScale / v.aspect;
+            m(1, 1) = yScale;
+            m(2, 2) = zf / (zf - zn);
+            m(2, 3) = -zn * zf / (zf - zn);
+            m(3, 2) = 1.0;
+            PushMatrix(m, 4, e);
+        }, 3.0);
+    // maps x to [-1, 1], y to [-1, 1] and z to [0, 1]. the float sums of the bounds round relative to the bounds
+    Measure(suite, "make", "make_ortho_proj", orthos, [](Ortho const& v) { return math::make_ortho_proj(v.left, v.right, v.bottom, v.top, v.zNear, v.zFar); },
+        [](Ortho const& v, Expected& e) {
+            double const l = v.left, r = v.right, b = v.bottom, t = v.top, zn = v.zNear, zf = v.zFar;
+            double const values[16] = {
+                2.0 / (r - l), 0.0, 0.0, 0.0,
+                0.0, 2.0 / (t - b), 0.0, 0.0,
+                0.0, 0.0, 1.0 / (zf - zn), 0.0,
+                -(r + l) / (r - l), -(t + b) / (t - b), -zn / (zf - zn), 1.0,
+            };
+            double const magnitudes[16] = {
+                values[0], 0.0, 0.0, 0.0,
+                0.0, values[5], 0.0, 0.0,
+                0.0, 0.0, values[10], 0.0,
+                (fabs(r) + fabs(l)) / (r - l), (fabs(t) + fabs(b)) / (t - b), (fabs(zn) + fabs(zf)) / (zf - zn), 1.0,
+            };
+            for (auto i = 0; i < 16; ++i) { e.Push(values[i], magnitudes[i]); }
+        }, 4.0);
+    // left handed: x = up x forward, y = forward x x, z = forward, translation = from. the rotation's error grows with how
+    // much of from and to cancels in to - from, measured in ULPs of 1 here
+    Measure(suite, "make", "make_lookat", lookAts, [](LookAt const& v) { return math::make_lookat(v.from, v.to, v.up); },
+        [](LookAt const& v, Expected& e) {
+            auto const normalized = [](double* d) { auto const l = ::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]); for (auto i = 0; i < 3; ++i) { d[i] /= l; } };
+            auto const cross = [](double const* a, double const* b, double* out) {
+                out[0] = a[1] * b[2] - a[2] * b[1]; out[1] = a[2] * b[0] - a[0] * b[2]; out[2] = a[0] * b[1] - a[1] * b[0];
+            };
+            double forward[3], up[3] = { v.up.x, v.up.y, v.up.z }, x[3], y[3];
+            for (auto i = 0; i < 3; ++i) { forward[i] = static_cast<double>(v.to[i]) - v.from[i]; }
+            normalized(forward);
+            cross(up, forward, x);
+            normalized(x);
+            cross(forward, x, y);
+            double const* axes[3] = { x, y, forward };
+            for (auto column = 0; column < 3; ++column) {
+                for (auto row = 0; row < 3; ++row) { e.Push(axes[column][row], 1.0); }
+                e.Push(0.0);
+            }
+            for (auto row = 0; row < 3; ++row) { e.Push(v.from[row]); }
+            e.Push(1.0);
+        }, 4.0);
+    Measure(suite, "make", "make_affine", trs, [](Trs const& v) { return math::make_affine(v.t, v.q, v.s); },
+        [](Trs const& v, Expected& e) {
+            auto const r = QuatToMat(v.q.w, v.q.x, v.q.y, v.q.z);
+            for (auto column = 0; column < 3; ++column) {
+                for (auto row = 0; row < 3; ++row) { e.Push(r(row, column) * v.s[column], fabs(v.s[column])); }
+            }
+            for (auto row = 0; row < 3; ++row) { e.Push(v.t[row]); }
+        }, 3.0);
+}
@@ -0,0 +1,113 @@
+#include "MathBench.h"
+
+namespace
+{
+    using namespace mini;
+    using namespace mini::mathbench;
+
+    struct FloatPair { float a; float b; };
+    struct FloatTriple { float a; float b; float c; };
+
+    std::vector<float> MakeFloats(Random& random, uint32_t count, float lo, float hi)
+    {
+        std::vector<float> values(count);
+        for (auto& v : values) { v = random.Uniform(lo, hi); }
+        return values;
+    }
+
+    // positive and spread over the exponents instead of the range
+    std::vector<float> MakeLogFloats(Random& random, uint32_t count, float minExponent, float maxExponent)
+    {
+        std::vector<float> values(count);
+        for (auto& v : values) { v = exp2f(random.Uniform(minExponent, maxExponent)); }
+        return values;
+    }
+
+    std::vector<FloatPair> MakePairs(Random& random, uint32_t count, float lo, float hi)
+    {
+        std::vector<FloatPair> values(count);
+        for (auto& v : values) { v = { random.Uniform(lo, hi), random.Uniform(lo, hi) }; }
+        return values;
+    }
+}
+
+void mini::mathbench::RunScalarCases(Suite& suite)
+{
+    auto const count = suite.GetCount();
+    Random random;
+
+    auto const wide = MakeFloats(random, count, -100.0f, 100.0f);
+    auto const positive = MakeLogFloats(random, count, -60.0f, 60.0f);
+    auto const unit = MakeFloats(random, count, -1.0f, 1.0f);
+    auto const angles = MakeFloats(random, count, -8192.0f, 8192.0f);
+    auto const pairs = MakePairs(random, count, -100.0f, 100.0f);
+
+    // -- thin wrappers around the CRT, measured so the fast tier has something to compare against
+
+    Measure(suite, "scalar", "sqrt", positive, [](float v) { return math::sqrt(v); },
+        [](float v, Expected& e) { e.Push(::sqrt(static_cast<double>(v))); }, 0.5);
+    Measure(suite, "scalar", "rsqrt", positive, [](float v) { return math::rsqrt(v); },
+        [](float v, Expected& e) { e.Push(1.0 / ::sqrt(static_cast<double>(v))); }, 1.5);
+    Measure(suite, "scalar", "sin", wide, [](float v) { return math::sin(v); },
+        [](float v, Expected& e) { e.Push(::sin(static_cast<double>(v))); }, 1.0);
+    Measure(suite, "scalar", "cos", wide, [](float v) { return math::cos(v); },
+        [](float v, Expected& e) { e.Push(::cos(static_cast<double>(v))); }, 1.0);
+    Measure(suite, "scalar", "tan", unit, [](float v) { return math::tan(v * 1.5f); },
+        [](float v, Expected& e) { e.Push(::tan(static_cast<double>(v * 1.5f))); }, 1.0);
+    Measure(suite, "scalar", "acos", unit, [](float v) { return math::acos(v); },
+        [](float v, Expected& e) { e.Push(::acos(static_cast<double>(v))); }, 1.0);
+    Measure(suite, "scalar", "asin", unit, [](float v) { return math::asin(v); },
+        [](float v, Expected& e) { e.Push(::asin(static_cast<double>(v))); }, 1.0);
+    Measure(suite, "scalar", "atan2", pairs, [](FloatPair const& v) { return math::atan2(v.a, v.b); },
+        [](FloatPair const& v, Expected& e) { e.Push(::atan2(static_cast<double>(v.a), static_cast<double>(v.b))); }, 1.5);
+    Measure(suite, "scalar", "exp", MakeFloats(random, count, -87.0f, 88.0f), [](float v) { return math::exp(v); },
+        [](float v, Expected& e) { e.Push(::exp(static_cast<double>(v))); }, 1.0);
+    Measure(suite, "scalar", "log", positive, [](float v) { return math::log(v); },
+        [](float v, Expected& e) { e.Push(::log(static_cast<double>(v))); }, 1.0);
+
+    // -- helpers. PI is a float so the conversions are a little off the exact ones
+
+    Measure(suite, "scalar", "RadToDeg", wide, [](float v) { return math::RadToDeg(v); },
+        [](float v, Expected& e) { e.Push(static_cast<double>(v) * (180.0 / 3.14159265358979323846)); }, 2.0);
+    Measure(suite, "scalar", "DegToRad", wide, [](float v) { return math::DegToRad(v * 2.0f); },
+        [](float v, Expected& e) { e.Push(static_cast<double>(v * 2.0f) * (3.14159265358979323846 / 180.0)); }, 2.0);
+
+    std::vector<FloatTriple> lerps(count);
+    for (auto& v : lerps) { v = { random.Uniform(-100.0f, 100.0f), random.Uniform(-100.0f, 100.0f), random.Uniform(0.0f, 1.0f) }; }
+    Measure(suite, "scalar", "lerp", lerps, [](FloatTriple const& v) { return math::lerp(v.a, v.b, v.c); },
+        [](FloatTriple const& v, Expected& e) {
+            double const a = v.a, b = v.b, t = v.c;
+            e.Push(a * (1.0 - t) + b * t, fabs(a * (1.0 - t)) + fabs(b * t));
+        }, 1.5);
+
+    Measure(suite, "scalar", "min", pairs, [](FloatPair const& v) { return math::min(v.a, v.b); },
+        [](FloatPair const& v, Expected& e) { e.Push(v.a < v.b ? v.a : v.b); }, 0.0);
+    Measure(suite, "scalar", "max", pairs, [](FloatPair const& v) { return math::max(v.a, v.b); },
+        [](FloatPair const& v, Expected& e) { e.Push(v.a > v.b ? v.a : v.b); }, 0.0);
+    Measure(suite, "scalar", "clamp", wide, [](float v) { return math::clamp(v, -50.0f, 25.0f); },
+        [](float v, Expected& e) { e.Push(fmin(fmax(static_cast<double>(v), -50.0), 25.0)); }, 0.0);
+    Measure(suite, "scalar", "saturate", unit, [](float v) { return math::saturate(v * 2.0f); },
+        [](float v, Expected& e) { e.Push(fmin(fmax(static_cast<double>(v) * 2.0, 0.0), 1.0)); }, 0.0);
+    Measure(suite, "scalar", "abs", wide, [](float v) { return math::abs(v); },
+        [](float v, Expected& e) { e.Push(fabs(static_cast<double>(v))); }, 0.0);
+    Measure(suite, "scalar", "sign", wide, [](float v) { return math::sign(v); },
+        [](float v, Expected& e) { e.Push(v >= 0.0f ? 1.0 : -1.0); }, 0.0);
+
+    // -- fast tier, against the bounds documented in math_functions.h. sin, cos and atan2 are bounded in absolute error
+
+    Measure(suite, "fast", "fast_sin", angles, [](float v) { return math::fast_sin(v); },
+        [](float v, Expected& e) { e.Push(::sin(static_cast<double>(v)), 1.0); }, 1.5);
+    Measure(suite, "fast", "fast_cos", angles, [](float v) { return math::fast_cos(v); },
+        [](float v, Expected& e) { e.Push(::cos(static_cast<double>(v)), 1.0); }, 1.5);
+    Measure(suite, "fast", "fast_sincos", angles,
+        [](float v) { math::vec2f_t r; math::fast_sincos(v, &r.x, &r.y); return r; },
+        [](float v, Expected& e) { e.Push(::sin(static_cast<double>(v)), 1.0); e.Push(::cos(static_cast<double>(v)), 1.0); }, 1.5);
+    Measure(suite, "fast", "fast_rsqrt", positive, [](float v) { return math::fast_rsqrt(v); },
+        [](float v, Expected& e) { e.Push(1.0 / ::sqrt(static_cast<double>(v))); }, 4.0);     // 2^-21
+    Measure(suite, "fast", "fast_atan2", pairs, [](FloatPair const& v) { return math::fast_atan2(v.a, v.b); },
+        [](FloatPair const& v, Expected& e) { e.Push(::atan2(static_cast<double>(v.a), static_cast<double>(v.b)), 1.0); }, 3.5);
+    Measure(suite, "fast", "fast_exp", MakeFloats(random, count, -87.0f, 88.0f), [](float v) { return math::fast_exp(v); },
+        [](float v, Expected& e) { e.Push(::exp(static_cast<double>(v))); }, 2.0);
+    Measure(suite, "fast", "fast_log", positive, [](float v) { return math::fast_log(v); },
+        [](float v, Expected& e) { e.Push(::log(static_cast<double>(v))); }, 2.0);
+}
@@ -0,0 +1,144 @@
+#include "MathBench.h"
+
+namespace
+{
+    using namespace mini;
+    using namespace mini::mathbench;
+
+    template <class V> struct VecPair { V a; V b; };
+    template <class V> struct VecScalar { V a; float s; };
+
+    template <class V>
+    constexpr uint32_t Size() { return sizeof(V) / sizeof(float); }
+
+    template <class V>
+    V MakeVec(Random& random, float lo, float hi)
+    {
+        V v;
+        for (auto i = 0u; i < Size<V>(); ++i) { v.elements[i] = random.Signed(lo, hi); }
+        return v;
+    }
+
+    template <class V>
+    double Dot(V const& a, V const& b, double* outMagnitude = nullptr)
+    {
+        double sum = 0.0, magnitude = 0.0;
+        for (auto i = 0u; i < Size<V>(); ++i) {
+            sum += static_cast<double>(a.elements[i]) * b.elements[i];
+            magnitude += fabs(static_cast<double>(a.elements[i]) * b.elements[i]);
+        }
+        if (outMagnitude != nullptr) { *outMagnitude = magnitude; }
+        return sum;
+    }
+
+    template <class V>
+    void PushScaled(V const& v, double scale, Expected& e)
+    {
+        for (auto i = 0u; i < Size<V>(); ++i) { e.Push(v.elements[i] * scale); }
+    }
+
+    // the same cases for vec2f_t, vec3f_t and vec4f_t
+    template <class V>
+    void RunVectorCasesOf(Suite& suite, char const* group)
+    {
+        auto const count = suite.GetCount();
+        Random random;
+        std::vector<VecPair<V>> pairs(count);
+        std::vector<VecScalar<V>> scalars(count);
+        std::vector<V> vectors(count);
+        for (auto i = 0u; i < count; ++i) {
+            // divisors stay away from zero, the second of a pair is a divisor too
+            pairs[i] = { MakeVec<V>(random, 0.0f, 100.0f), MakeVec<V>(random, 0.5f, 100.0f) };
+            scalars[i] = { MakeVec<V>(random, 0.0f, 100.0f), random.Signed(0.5f, 100.0f) };
+            vectors[i] = MakeVec<V>(random, 0.0f, 100.0f);
+        }
+
+        auto const perElement = [](VecPair<V> const& v, Expected& e, double (*op)(double, double)) {
+            for (auto i = 0u; i < Size<V>(); ++i) { e.Push(op(v.a.elements[i], v.b.elements[i])); }
+        };
+        auto const perScalar = [](VecScalar<V> const& v, Expected& e, double (*op)(double, double)) {
+            for (auto i = 0u; i < Size<V>(); ++i) { e.Push(op(v.a.elements[i], v.s)); }
+        };
+        static double (* const add)(double, double) = [](double a, double b) { return a + b; };
+        static double (* const sub)(double, double) = [](double a, double b) { return a - b; };
+        static double (* const mul)(double, double) = [](double a, double b) { return a * b; };
+        static double (* const div)(double, double) = [](double a, double b) { return a / b; };
+
+        // -- operators are one correctly rounded operation per element
+
+        Measure(suite, group, "a + b", pairs, [](VecPair<V> const& v) { return v.a + v.b; }, [&](VecPair<V> const& v, Expected& e) { perElement(v, e, add); }, 0.5);
+        Measure(suite, group, "a - b", pairs, [](VecPair<V> const& v) { return v.a - v.b; }, [&](VecPair<V> const& v, Expected& e) { perElement(v, e, sub); }, 0.5);
+        Measure(suite, group, "a * b", pairs, [](VecPair<V> const& v) { return v.a * v.b; }, [&](VecPair<V> const& v, Expected& e) { perElement(v, e, mul); }, 0.5);
+        Measure(suite, group, "a / b", pairs, [](VecPair<V> const& v) { return v.a / v.b; }, [&](VecPair<V> const& v, Expected& e) { perElement(v, e, div); }, 0.5);
+        Measure(suite, group, "a + s", scalars, [](VecScalar<V> const& v) { return v.a + v.s; }, [&](VecScalar<V> const& v, Expected& e) { perScalar(v, e, add); }, 0.5);
+        Measure(suite, group, "a - s", scalars, [](VecScalar<V> const& v) { return v.a - v.s; }, [&](VecScalar<V> const& v, Expected& e) { perScalar(v, e, sub); }, 0.5);
+        Measure(suite, group, "a * s", scalars, [](VecScalar<V> const& v) { return v.a * v.s; }, [&](VecScalar<V> const& v, Expected& e) { perScalar(v, e, mul); }, 0.5);
+        Measure(suite, group, "a / s", scalars, [](VecScalar<V> const& v) { return v.a / v.s; }, [&](VecScalar<V> const& v, Expected& e) { perScalar(v, e, div); }, 0.5);
+        Measure(suite, group, "-a", vectors, [](V const& v) { return -v; }, [](V const& v, Expected& e) { PushScaled(v, -1.0, e); }, 0.0);
+
+        // -- reductions
+
+        Measure(suite, group, "dot", pairs, [](VecPair<V> const& v) { return math::dot(v.a, v.b); },
+            [](VecPair<V> const& v, Expected& e) { double magnitude; auto const d = Dot(v.a, v.b, &magnitude); e.Push(d, magnitude); }, 3.0);
+        Measure(suite, group, "squared_length", vectors, [](V const& v) { return math::squared_length(v); },
+            [](V const& v, Expected& e) { e.Push(Dot(v, v)); }, 3.0);
+        Measure(suite, group, "length", vectors, [](V const& v) { return math::length(v); },
+            [](V const& v, Expected& e) { e.Push(::sqrt(Dot(v, v))); }, 1.5);
+        Measure(suite, group, "distance", pairs, [](VecPair<V> const& v) { return math::distance(v.a, v.b); },
+            [](VecPair<V> const& v, Expected& e) {
+                double sum = 0.0, magnitude = 0.0;
+                for (auto i = 0u; i < Size<V>(); ++i) {
+                    auto const d = static_cast<double>(v.a.elements[i]) - v.b.elements[i];
+                    auto const m = fabs(static_cast<double>(v.a.elements[i])) + fabs(static_cast<double>(v.b.elements[i]));
+                    sum += d * d;
+                    magnitude += m * m;
+                }
+                e.Push(::sqrt(sum), ::sqrt(magnitude));     // the subtraction rounds relative to the inputs, not the difference
+            }, 3.0);
+
+        // -- normalization
+
+        Measure(suite, group, "normalize", vectors, [](V const& v) { return math::normalize(v); },
+            [](V const& v, Expected& e) { PushScaled(v, 1.0 / ::sqrt(Dot(v, v)), e); }, 2.5);
+        Measure(suite, group, "normalize_safe", vectors, [](V const& v) { return math::normalize_safe(v); },
+            [](V const& v, Expected& e) { PushScaled(v, 1.0 / ::sqrt(Dot(v, v)), e); }, 2.5);
+    }
+
+    // the functions only vec3f_t has
+    void RunVec3Cases(Suite& suite)
+    {
+        auto const count = suite.GetCount();
+        Random random;
+        std::vector<VecPair<math::vec3f_t>> pairs(count);
+        std::vector<math::vec3f_t> vectors(count);
+        std::vector<math::vec3f_t> tiny(count);
+        for (auto i = 0u; i < count; ++i) {
+            pairs[i] = { MakeVec<math::vec3f_t>(random, 0.0f, 100.0f), MakeVec<math::vec3f_t>(random, 0.0f, 100.0f) };
+            vectors[i] = MakeVec<math::vec3f_t>(random, 0.01f, 100.0f);
+            tiny[i] = MakeVec<math::vec3f_t>(random, 0.0f, 1e-6f);
+        }
+
+        Measure(suite, "vec3", "cross", pairs, [](VecPair<math::vec3f_t> const& v) { return math::cross(v.a, v.b); },
+            [](VecPair<math::vec3f_t> const& v, Expected& e) {
+                for (auto i = 0; i < 3; ++i) {
+                    auto const j = (i + 1) % 3, k = (i + 2) % 3;
+                    auto const p = static_cast<double>(v.a[j]) * v.b[k], q = static_cast<double>(v.b[j]) * v.a[k];
+                    e.Push(p - q, fabs(p) + fabs(q));
+                }
+            }, 2.0);
+        Measure(suite, "vec3", "fast_normalize", vectors, [](math::vec3f_t const& v) { return math::fast_normalize(v); },
+            [](math::vec3f_t const& v, Expected& e) { PushScaled(v, 1.0 / ::sqrt(Dot(v, v)), e); }, 6.0);   // fast_rsqrt's 2^-21
+        // below eps the result is zero
+        Measure(suite, "vec3", "normalize_safe (below eps)", tiny, [](math::vec3f_t const& v) { return math::normalize_safe(v); },
+            [](math::vec3f_t const&, Expected& e) { e.Push(0.0); e.Push(0.0); e.Push(0.0); }, 0.0);
+    }
+}
+
+void mini::mathbench::RunVectorCases(Suite& suite)
+{
+    RunVectorCasesOf<math::vec2f_t>(suite, "vec2");
+    RunVectorCasesOf<math::vec3f_t>(suite, "vec3");
+    RunVec3Cases(suite);
+    RunVectorCasesOf<math::vec4f_t>(suite, "vec4");
+}
+
@@ -0,0 +1,111 @@
+#include "MathBench.h"
+
+#include <stdlib.h>
+
+/*
+    *   MathBench [--csv] [--filter <text>] [--scale <n>]
+    *       --csv       one line per case instead of the table
+    *       --filter    only the cases whose group or name contains text, e.g. --filter mat4x4
+    *       --scale     n times the default 4096 inputs per case, for steadier timings
+    *   Prints the results and "math bench checks: ok" or "FAILED", the exit code is 1 if any case went over its ULP bound.
+*/
+
+namespace
+{
+    float Feedback(float v) { return v; }
+}
+
+double mini::mathbench::Suite::GetFeedbackNs()
+{
+    if (m_feedbackNs >= 0.0) { return m_feedbackNs; }
+
+    // the latency loop of Measure around a function that does nothing
+    auto const count = GetCount();
+    auto const numRuns = 32u;
+    std::vector<float> inputs(count, 1.0f);
+    volatile float hiddenZero = 0.0f;
+    float const zero = hiddenZero;
+    float carry = 0.0f;
+    Timer timer;
+    for (auto run = 0u; run < numRuns; ++run) {
+        for (auto i = 0u; i < count; ++i) {
+            auto const output = Feedback(inputs[i] + carry);
+            DoNotOptimize(output);
+            carry = output * zero;
+        }
+    }
+    DoNotOptimize(carry);
+    m_feedbackNs = timer.GetElapsedTime() * 1e9 / (static_cast<double>(numRuns) * count);
+    return m_feedbackNs;
+}
+
+void mini::mathbench::Suite::Add(CaseResult const& result)
+{
+    m_results.push_back(result);
+}
+
+bool mini::mathbench::Suite::Finish() const
+{
+    auto ok = true;
+    if (m_options.csv) {
+        printf("group,name,throughput_ns,latency_ns,max_ulps,mean_ulps,rounded,bound_ulps,ok\n");
+    }
+    else {
+        printf("%-10s %-36s %12s %12s %10s %10s %9s %8s\n", "group", "name", "ns/call", "latency ns", "max ulp", "mean ulp", "rounded", "bound");
+    }
+
+    char const* group = nullptr;
+    for (auto const& result : m_results) {
+        auto const passed = result.error.maxUlps <= result.boundUlps;
+        ok &= passed;
+        auto const meanUlps = result.error.numValues > 0 ? result.error.sumUlps / static_cast<double>(result.error.numValues) : 0.0;
+        auto const rounded = result.error.numValues > 0 ? 100.0 * static_cast<double>(result.error.numRounded) / static_cast<double>(result.error.numValues) : 100.0;
+        if (m_options.csv) {
+            printf("%s,%s,%.3f,%.3f,%.3f,%.4f,%.2f,%.1f,%d\n", result.group, result.name, result.throughputNs, result.latencyNs,
+                result.error.maxUlps, meanUlps, rounded, result.boundUlps, passed ? 1 : 0);
+            continue;
+        }
+        if (group != nullptr && strcmp(group, result.group) != 0) { printf("\n"); }
+        group = result.group;
+        printf("%-10s %-36s %12.2f %12.2f %10.2f %10.3f %8.1f%% %8.1f%s\n", result.group, result.name, result.throughputNs, result.latencyNs,
+            result.error.maxUlps, meanUlps, rounded, result.boundUlps, passed ? "" : "  <-- over bound");
+    }
+
+    printf("%smath bench checks: %s (%u cases)\n", m_options.csv ? "" : "\n", ok ? "ok" : "FAILED", static_cast<uint32_t>(m_results.size()));
+    return ok;
+}
+
+// -----------------------------------------------------------
+// -----------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    using namespace mini::mathbench;
+
+    Options options;
+    for (auto i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--csv") == 0) {
+            options.csv = true;
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        }
+        else if (strcmp(argv[i], "--scale") == 0 && i + 1 < argc) {
+            auto const scale = atoi(argv[++i]);
+            options.scale = scale > 0 ? static_cast<uint32_t>(scale) : 1;
+        }
+        else {
+            printf("usage: %s [--csv] [--filter <text>] [--scale <n>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Suite suite(options);
+    RunScalarCases(suite);
+    RunVectorCases(suite);
+    RunQuaternionCases(suite);
+    RunDualQuatCases(suite);
+    RunMatrixCases(suite);
+    RunGeometryCases(suite);
+    return suite.Finish() ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#include "GTMesh.h"
+#include <Runtime/common.h>
+#include <Runtime/Culling/MeshBounds.h>
+
+#include <string.h>
+
+namespace
+{
+    template <class T>
+    inline T ReadUnaligned(char const* src)
+    {
+        T value;
+        memcpy(&value, src, sizeof(T));
+        return value;
+    }
+
+    // @note only layouts the runtime has a VertexFormat for, everything else is rejected
+    inline bool GetRuntimeVertexFormat(mini::GTMeshVertexFormat format, mini::VertexFormat* outFormat)
+    {
+        switch (format) {
+            case mini::GTMeshVertexFormat::PositionNormal: *outFormat = mini::VertexFormat::PositionNormal; return true;
+            case mini::GTMeshVertexFormat::PositionNormalTangentTexcoord0: *outFormat = mini::VertexFormat::PositionNormalTangentUV; return true;
+            default: return false;
+        }
+    }
+
+    inline uint32_t GetIndexSize(mini::GTMeshIndexFormat format)
+    {
+        return format == mini::GTMeshIndexFormat::UInt8 ? 1 : format == mini::GTMeshIndexFormat::UInt16 ? 2 : 4;
+    }
+}
+
+char const* mini::GetGTMeshParseResultName(GTMeshParseResult result)
+{
+    switch (result) {
+        case GTMeshParseResult::Success: return "Success";
+        case GTMeshParseResult::TooSmall: return "TooSmall";
+        case GTMeshParseResult::UnknownVertexFormat: return "UnknownVertexFormat";
+        case GTMeshParseResult::UnsupportedVertexFormat: return "UnsupportedVertexFormat";
+        case GTMeshParseResult::UnknownIndexFormat: return "UnknownIndexFormat";
+        case GTMeshParseResult::UnsupportedIndexFormat: return "UnsupportedIndexFormat";
+        case GTMeshParseResult::InvalidCounts: return "InvalidCounts";
+        case GTMeshParseResult::SizeMismatch: return "SizeMismatch";
+        case GTMeshParseResult::InvalidSubmesh: return "InvalidSubmesh";
+    }
+    return "Unknown";
+}
+
+mini::GTMeshParseResult mini::ParseGTMesh(char const* data, uint64_t size, GTMeshView* outView)
+{
+    if (data == nullptr || size < GTMESH_HEADER_SIZE) { return GTMeshParseResult::TooSmall; }
+
+    auto const vertexFormat = ReadUnaligned<uint8_t>(data);
+    auto const indexFormat = ReadUnaligned<uint8_t>(data + 1);
+    auto const numVertices = ReadUnaligned<uint64_t>(data + 2);
+    auto const numIndices = ReadUnaligned<uint64_t>(data + 10);
+    auto const numSubmeshes = ReadUnaligned<uint32_t>(data + 18);
+
+    if (vertexFormat >= static_cast<uint8_t>(GTMeshVertexFormat::_LastFormat)) { return GTMeshParseResult::UnknownVertexFormat; }
+    VertexFormat runtimeFormat;
+    if (!GetRuntimeVertexFormat(static_cast<GTMeshVertexFormat>(vertexFormat), &runtimeFormat)) { return GTMeshParseResult::UnsupportedVertexFormat; }
+    if (indexFormat >= static_cast<uint8_t>(GTMeshIndexFormat::_LastFormat)) { return GTMeshParseResult::UnknownIndexFormat; }
+    // @todo non indexed meshes, the exporter never writes them
+    if (indexFormat == static_cast<uint8_t>(GTMeshIndexFormat::None)) { return GTMeshParseResult::UnsupportedIndexFormat; }
+
+    // @note MeshData sizes are 32 bit, counts are checked before they are multiplied so the size check below can't overflow
+    auto const vertexStride = GetVertexFormatStride(runtimeFormat);
+    auto const indexSize = GetIndexSize(static_cast<GTMeshIndexFormat>(indexFormat));
+    if (numVertices == 0 || numIndices == 0 || numIndices % 3 != 0 || numVertices > UINT32_MAX / vertexStride || numIndices > UINT32_MAX / indexSize) {
+        return GTMeshParseResult::InvalidCounts;
+    }
+    if (indexFormat == static_cast<uint8_t>(GTMeshIndexFormat::UInt16) && numVertices > 0x10000) { return GTMeshParseResult::InvalidCounts; }
+    if (indexFormat == static_cast<uint8_t>(GTMeshIndexFormat::UInt8) && numVertices > 0x100) { return GTMeshParseResult::InvalidCounts; }
+
+    auto const vertexBytes = numVertices * vertexStride;
+    auto const indexBytes = numIndices * indexSize;
+    auto const submeshBytes = static_cast<uint64_t>(numSubmeshes) * GTMESH_SUBMESH_SIZE;
+    if (size != GTMESH_HEADER_SIZE + vertexBytes + indexBytes + submeshBytes) { return GTMeshParseResult::SizeMismatch; }
+
+    GTMeshView view;
+    view.vertexFormat = static_cast<GTMeshVertexFormat>(vertexFormat);
+    view.indexFormat = static_cast<GTMeshIndexFormat>(indexFormat);
+    view.numVertices = static_cast<uint32_t>(numVertices);
+    view.numIndices = static_cast<uint32_t>(numIndices);
+    view.numSubmeshes = numSubmeshes;
+    for (auto k = 0; k < 3; ++k) {
+        view.aabbMax[k] = ReadUnaligned<float>(data + 22 + k * 4);
+        view.aabbMin[k] = ReadUnaligned<float>(data + 34 + k * 4);
+    }
+    view.vertexData = data + GTMESH_HEADER_SIZE;
+    view.indexData = view.vertexData + vertexBytes;
+    view.submeshData = view.indexData + indexBytes;
+
+    for (auto i = 0u; i < numSubmeshes; ++i) {
+        auto const firstIndex = ReadUnaligned<uint64_t>(view.submeshData + i * GTMESH_SUBMESH_SIZE);
+        auto const count = ReadUnaligned<uint64_t>(view.submeshData + i * GTMESH_SUBMESH_SIZE + 8);
+        if (firstIndex > numIndices || count > numIndices - firstIndex) { return GTMeshParseResult::InvalidSubmesh; }
+    }
+
+    *outView = view;
+    return GTMeshParseResult::Success;
+}
+
+void mini::GetGTMeshData(GTMeshView const& view, GTMeshScratch* scratch, MeshData* outData)
+{
+    MeshData data;
+    GetRuntimeVertexFormat(view.vertexFormat, &data.vertexFormat);
+    data.vertexStride = GetVertexFormatStride(data.vertexFormat);
+    data.vertexData = const_cast<char*>(view.vertexData);     // @note MeshData is never written through by the library
+    data.vertexDataSize = view.numVertices * data.vertexStride;
+
+    if (view.indexFormat == GTMeshIndexFormat::UInt8) {
+        scratch->indexData.resize(view.numIndices * sizeof(uint16_t));
+        auto const src = reinterpret_cast<uint8_t const*>(view.indexData);
+        auto const dst = reinterpret_cast<uint16_t*>(scratch->indexData.data());
+        for (auto i = 0u; i < view.numIndices; ++i) { dst[i] = src[i]; }
+        data.indexFormat = IndexFormat::R16_UINT;
+        data.indexData = scratch->indexData.data();
+    }
+    else {
+        data.indexFormat = view.indexFormat == GTMeshIndexFormat::UInt16 ? IndexFormat::R16_UINT : IndexFormat::R32_UINT;
+        data.indexData = const_cast<char*>(view.indexData);
+    }
+    data.indexDataSize = view.numIndices * GetIndexFormatStride(data.indexFormat);
+
+    // @note ranges were validated by ParseGTMesh, so they fit 32 bits
+    scratch->submeshes.resize(view.numSubmeshes);
+    for (auto i = 0u; i < view.numSubmeshes; ++i) {
+        auto const firstIndex = ReadUnaligned<uint64_t>(view.submeshData + i * GTMESH_SUBMESH_SIZE);
+        auto const count = ReadUnaligned<uint64_t>(view.submeshData + i * GTMESH_SUBMESH_SIZE + 8);
+        scratch->submeshes[i] = { static_cast<uint32_t>(firstIndex), static_cast<uint32_t>(count), i };
+    }
+    data.submeshes = scratch->submeshes.data();
+    data.numSubmeshes = view.numSubmeshes;
+
+    scratch->bounds = IsValidAabb(view.aabbMin, view.aabbMax) ? MakeMeshBounds(view.aabbMin, view.aabbMax)
+        : ComputeMeshBounds(view.vertexData, view.numVertices, data.vertexStride);
+    data.bounds = &scratch->bounds;
+    *outData = data;
+}
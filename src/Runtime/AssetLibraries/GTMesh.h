@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+
+#include <EASTL/vector.h>
+
+namespace mini
+{
+    /*
+        *   .gtmesh files as written by scripts/blender/mesh_export.py, little endian and tightly packed:
+        *       uint8 vertex format, uint8 index format, uint64 vertex count, uint64 index count, uint32 submesh count,
+        *       float3 aabb max, float3 aabb min, vertices, indices, submeshes (uint64 first index, uint64 index count)
+        *   Parsing only validates the layout and points into the file's bytes, nothing is copied. The sections aren't aligned,
+        *   so they must only be read with memcpy, which is all MeshLibrary does with them.
+    */
+    enum class GTMeshVertexFormat : uint8_t
+    {
+        Position, PositionNormal, PositionNormalTexcoord0, PositionNormalTexcoord01, PositionNormalTangentTexcoord0,
+        PositionNormalTangentTexcoord01, Color0, Color01, BoneWeightsIndices, _LastFormat
+    };
+
+    enum class GTMeshIndexFormat : uint8_t
+    {
+        None, UInt8, UInt16, UInt32, _LastFormat
+    };
+
+    enum class GTMeshParseResult : uint8_t
+    {
+        Success, TooSmall, UnknownVertexFormat, UnsupportedVertexFormat, UnknownIndexFormat, UnsupportedIndexFormat,
+        InvalidCounts, SizeMismatch, InvalidSubmesh
+    };
+
+    static constexpr uint32_t GTMESH_HEADER_SIZE    = 1 + 1 + 8 + 8 + 4 + 6 * 4;
+    static constexpr uint32_t GTMESH_SUBMESH_SIZE   = 8 + 8;
+
+    struct GTMeshView
+    {
+        GTMeshVertexFormat  vertexFormat = GTMeshVertexFormat::PositionNormal;
+        GTMeshIndexFormat   indexFormat = GTMeshIndexFormat::UInt16;
+        uint32_t            numVertices = 0;
+        uint32_t            numIndices = 0;
+        uint32_t            numSubmeshes = 0;
+        float               aabbMin[3] = { 0.0f, 0.0f, 0.0f };
+        float               aabbMax[3] = { 0.0f, 0.0f, 0.0f };
+
+        char const*         vertexData = nullptr;   // @note unaligned, see above
+        char const*         indexData = nullptr;
+        char const*         submeshData = nullptr;
+    };
+
+    // @note CPU side storage GetGTMeshData's MeshData points into when the file's data can't be used as is, reusable across loads
+    struct GTMeshScratch
+    {
+        eastl::vector<char>     indexData;
+        eastl::vector<Submesh>  submeshes;
+        MeshBounds              bounds;
+    };
+
+    char const*         GetGTMeshParseResultName(GTMeshParseResult result);
+
+    // @note    checks the header against size before anything is dereferenced, so truncated or corrupt files fail here.
+    //          index values aren't range checked, that would touch every index a second time on the load path
+    GTMeshParseResult   ParseGTMesh(char const* data, uint64_t size, GTMeshView* outView);
+
+    // @note    outData references the view's vertices and indices directly. only UINT8 indices, which the GPU side doesn't support,
+    //          are widened to R16_UINT into the scratch storage. submeshes get their table index as material slot and the file's AABB
+    //          is used unless it is invalid, then the bounds are computed from the vertices
+    void                GetGTMeshData(GTMeshView const& view, GTMeshScratch* scratch, MeshData* outData);
+}
@@ -0,0 +1,77 @@
+#include "MeshAllocator.h"
+#include <Runtime/common.h>
+
+bool mini::MeshAllocator::Initialize(uint32_t maxMeshes, uint32_t maxPendingReleases, uint32_t vertexBufferSize, uint32_t indexBufferSize, uint32_t meshletCapacity, uint32_t submeshCapacity)
+{
+    auto const maxAllocations = GetMaxAllocations(maxMeshes, maxPendingReleases);
+    return m_vertexAllocator.Initialize(vertexBufferSize, maxAllocations)
+        && m_indexAllocator.Initialize(indexBufferSize, maxAllocations)
+        && m_meshletAllocator.Initialize(meshletCapacity, maxAllocations)
+        && m_submeshAllocator.Initialize(submeshCapacity, maxAllocations);
+}
+
+bool mini::MeshAllocator::AllocateGeometry(uint32_t vertexSize, uint32_t indexSize, MeshAllocations* outAllocations)
+{
+    *outAllocations = MeshAllocations();
+    auto const vertex = m_vertexAllocator.Allocate(vertexSize);
+    auto const index = m_indexAllocator.Allocate(indexSize);
+    MINI_ASSERT(vertex.IsValid(), "Out of vertex buffer memory");
+    MINI_ASSERT(index.IsValid(), "Out of index buffer memory");
+    if (!vertex.IsValid() || !index.IsValid()) {
+        m_vertexAllocator.Free(vertex);
+        m_indexAllocator.Free(index);
+        return false;
+    }
+    outAllocations->vertex = vertex;
+    outAllocations->index = index;
+    return true;
+}
+
+mini::OffsetAllocation mini::MeshAllocator::AllocateMeshlets(uint32_t count)
+{
+    auto const allocation = m_meshletAllocator.Allocate(count);
+    MINI_ASSERT(allocation.IsValid(), "Out of meshlet memory");
+    return allocation;
+}
+
+mini::OffsetAllocation mini::MeshAllocator::AllocateSubmeshes(uint32_t count)
+{
+    auto const allocation = m_submeshAllocator.Allocate(count);
+    MINI_ASSERT(allocation.IsValid(), "Out of submesh memory");
+    return allocation;
+}
+
+void mini::MeshAllocator::Release(MeshAllocations const& allocations)
+{
+    if (!allocations.IsEmpty()) {
+        m_pendingReleases.Push(allocations, m_frameFenceValue);
+    }
+}
+
+void mini::MeshAllocator::BeginFrame(uint64_t frameFenceValue, uint64_t completedFenceValue)
+{
+    m_frameFenceValue = frameFenceValue;
+    CollectGarbage(completedFenceValue);
+}
+
+uint32_t mini::MeshAllocator::CollectGarbage(uint64_t completedFenceValue)
+{
+    return m_pendingReleases.Release(completedFenceValue, [this](MeshAllocations& allocations) {
+        m_vertexAllocator.Free(allocations.vertex);
+        m_indexAllocator.Free(allocations.index);
+        m_meshletAllocator.Free(allocations.meshlet);
+        m_submeshAllocator.Free(allocations.submesh);
+    });
+}
+
+uint64_t mini::MeshAllocator::GetResidentBytes() const
+{
+    return static_cast<uint64_t>(m_vertexAllocator.GetUsed()) + m_indexAllocator.GetUsed();
+}
+
+float mini::MeshAllocator::GetFragmentation() const
+{
+    auto const vertexFragmentation = m_vertexAllocator.GetReport().GetFragmentation();
+    auto const indexFragmentation = m_indexAllocator.GetReport().GetFragmentation();
+    return vertexFragmentation > indexFragmentation ? vertexFragmentation : indexFragmentation;
+}
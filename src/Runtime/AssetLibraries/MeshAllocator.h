@@ -0,0 +1,64 @@
+#pragma once
+#include <stdint.h>
+#include <Runtime/Memory/OffsetAllocator.h>
+#include <Runtime/Memory/DeferredReleaseQueue.h>
+
+namespace mini
+{
+    // @note the ranges one mesh occupies, vertices and indices in bytes, meshlets and submeshes in elements
+    struct MeshAllocations
+    {
+        OffsetAllocation    vertex;
+        OffsetAllocation    index;
+        OffsetAllocation    meshlet;    // @note CPU side, but this frame's culling may still have read them
+        OffsetAllocation    submesh;
+
+        bool IsEmpty() const { return !vertex.IsValid() && !index.IsValid() && !meshlet.IsValid() && !submesh.IsValid(); }
+    };
+
+    /*
+        *   The device independent half of MeshLibrary: sub-allocates the vertex, index, meshlet and submesh ranges of every mesh and
+        *   keeps released ranges reserved until no frame in flight can read them anymore.
+        *   Every allocator needs a node per live range, per range waiting for its frame and per free region between them, so the node
+        *   pools are sized from the number of live meshes and the number of releases that may be pending at once.
+    */
+    class MeshAllocator
+    {
+        OffsetAllocator     m_vertexAllocator;
+        OffsetAllocator     m_indexAllocator;
+        OffsetAllocator     m_meshletAllocator;
+        OffsetAllocator     m_submeshAllocator;
+
+        DeferredReleaseQueue<MeshAllocations>   m_pendingReleases;
+        uint64_t                                m_frameFenceValue = 0;
+
+    public:
+        // @note free regions never outnumber the allocations around them by more than one
+        static constexpr uint32_t GetMaxAllocations(uint32_t maxMeshes, uint32_t maxPendingReleases) { return 2 * (maxMeshes + maxPendingReleases) + 1; }
+
+        bool                Initialize(uint32_t maxMeshes, uint32_t maxPendingReleases, uint32_t vertexBufferSize, uint32_t indexBufferSize, uint32_t meshletCapacity, uint32_t submeshCapacity);
+
+        // @note sizes are used as is, the caller aligns them. on failure nothing stays allocated and outAllocations is left empty
+        bool                AllocateGeometry(uint32_t vertexSize, uint32_t indexSize, MeshAllocations* outAllocations);
+        OffsetAllocation    AllocateMeshlets(uint32_t count);
+        OffsetAllocation    AllocateSubmeshes(uint32_t count);
+
+        // @note    the ranges stay reserved until the frame fence passed the value given to the last BeginFrame call.
+        //          empty allocations aren't queued
+        void                Release(MeshAllocations const& allocations);
+
+        // frameFenceValue is signaled once the frame that's about to be recorded finished, completedFenceValue is the last finished one
+        void                BeginFrame(uint64_t frameFenceValue, uint64_t completedFenceValue);
+        // frees the ranges whose frames are done, returns the number of released meshes
+        uint32_t            CollectGarbage(uint64_t completedFenceValue);
+
+        // bytes of vertex and index buffer memory in use, including ranges waiting for their frame
+        uint64_t            GetResidentBytes() const;
+        uint32_t            GetNumPendingReleases() const { return m_pendingReleases.GetSize(); }
+        float               GetFragmentation() const;
+
+        // @note for defragmentation, which moves vertex and index ranges around
+        OffsetAllocator&    GetVertexAllocator() { return m_vertexAllocator; }
+        OffsetAllocator&    GetIndexAllocator() { return m_indexAllocator; }
+    };
+}
@@ -1,40 +1,186 @@
 #include "MeshLibrary.h"
+#include "GTMesh.h"
+#include "MeshAllocator.h"
 #include <Runtime/common.h>
+#include <Runtime/Culling/MeshBounds.h>
+#include <Runtime/Containers/SlotMap.h>
+#include <Runtime/Memory/RingAllocator.h>
 #include <Runtime/Resources/Resource.h>
 
 #define WIN32_LEAN_AND_MEAN
 #define VC_EXTRA_LEAN
 #define NOMINMAX
+#include <Windows.h>
 #include <d3d12.h>
 
+#include <EASTL/vector.h>
+
 #pragma warning(push, 0)
 #include <Runtime/par_shapes-h.h>
 #pragma warning(pop)
 
-// @todo use generational handle instead of straight index to detect use after free
 struct mini::MeshPool
 {
-    struct Element
+    struct ColdData
+    {
+        ResourceID          resourceId;
+        MeshAllocations     allocations;
+    };
+    SlotMap<MeshResourceHandle, MeshResource, ColdData> slots;
+    MeshAllocator           allocator;          // @note buffer ranges and their deferred release
+
+    eastl::vector<Meshlet>  meshlets;
+    eastl::vector<Submesh>  submeshes;
+
+    GTMeshScratch           gtmeshScratch;      // @note reused across .gtmesh loads
+
+    struct PendingCopy
+    {
+        ID3D12Resource* dst;
+        ID3D12Resource* src;
+        uint32_t        dstOffset;
+        uint32_t        srcOffset;
+        uint32_t        size;
+    };
+    struct CopyContext
     {
-        MeshResource    resource;
-        bool            isUsed      = false;
-        ResourceID      resourceId; 
-    }                   *elements   = nullptr;;
-    uint32_t            size        = 0;
+        ID3D12CommandAllocator* allocator = nullptr;
+        uint64_t                fenceValue = 0;     // @note last submission recorded with this allocator
+    };
+    RingAllocator               stagingRing;
+    eastl::vector<PendingCopy>  pendingCopies;
+    CopyContext                 copyContexts[MeshLibrary::NUM_COPY_CONTEXTS];
+    uint32_t                    nextCopyContext = 0;
+    uint64_t                    copyFenceValue = 0;
 };
 
-bool mini::MeshLibrary::Initialize(ID3D12Device* device, uint32_t poolSize)
+namespace
+{
+    uint32_t AlignBufferSize(uint32_t size)
+    {
+        return (size + mini::MeshLibrary::BUFFER_ALIGNMENT - 1) & ~(mini::MeshLibrary::BUFFER_ALIGNMENT - 1);
+    }
+
+    ID3D12Resource* CreateBuffer(ID3D12Device* device, uint32_t size, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES initialState)
+    {
+        D3D12_HEAP_PROPERTIES heapProperties = {};
+        heapProperties.Type = heapType;
+        heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+        D3D12_RESOURCE_DESC desc = {};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Alignment = 0;
+        desc.Width = size;
+        desc.Height = 1;
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels = 1;
+        desc.Format = DXGI_FORMAT_UNKNOWN;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+        desc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+        ID3D12Resource* resource = nullptr;
+        auto res = device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &desc, initialState, nullptr, IID_PPV_ARGS(&resource));
+        MINI_ASSERT(SUCCEEDED(res), "Failed to create commited resource for buffer");
+        return SUCCEEDED(res) ? resource : nullptr;
+    }
+
+    // @note    geometry buffers are created in the common state and rely on implicit state promotion: 
+    //          copy queue writes promote them to COPY_DEST and they decay back to COMMON once the copy list finished executing,
+    //          so the graphics queue can read them without any explicit barriers
+    ID3D12Resource* CreateGeometryBuffer(ID3D12Device* device, uint32_t size)
+    {
+        return CreateBuffer(device, size, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_COMMON);
+    }
+
+    void CreateRawBufferView(ID3D12Device* device, ID3D12Resource* resource, uint32_t size, D3D12_CPU_DESCRIPTOR_HANDLE descriptor)
+    {
+        D3D12_SHADER_RESOURCE_VIEW_DESC desc = {};
+        desc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
+        desc.Format = DXGI_FORMAT_R32_TYPELESS;
+        desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        desc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_RAW;
+        desc.Buffer.FirstElement = 0;
+        desc.Buffer.NumElements = size / sizeof(uint32_t);
+        desc.Buffer.StructureByteStride = 0;
+        device->CreateShaderResourceView(resource, &desc, descriptor);
+    }
+
+    void CreateGeometryBufferViews(ID3D12Device* device, ID3D12DescriptorHeap* heap, ID3D12Resource* vertexBuffer, uint32_t vertexBufferSize, ID3D12Resource* indexBuffer, uint32_t indexBufferSize)
+    {   // @note raw views so meshes with different vertex strides and index formats can share the buffers
+        auto const incrSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        auto descriptor = heap->GetCPUDescriptorHandleForHeapStart();
+        CreateRawBufferView(device, vertexBuffer, vertexBufferSize, descriptor);
+        descriptor.ptr += incrSize;
+        CreateRawBufferView(device, indexBuffer, indexBufferSize, descriptor);
+    }
+}
+
+bool mini::MeshLibrary::Initialize(ID3D12Device* device, uint32_t poolSize, uint32_t vertexBufferSize, uint32_t indexBufferSize, uint32_t stagingBufferSize)
 {
     m_device = device;
 
     m_pool = new MeshPool;
-    m_pool->elements = new MeshPool::Element[poolSize];
-    m_pool->size = poolSize;
+    if (!m_pool->slots.Initialize(poolSize)) {
+        return false;
+    }
+    vertexBufferSize = AlignBufferSize(vertexBufferSize);
+    indexBufferSize = AlignBufferSize(indexBufferSize);
+    if (!m_pool->allocator.Initialize(poolSize, GetMaxPendingDestroys(poolSize), vertexBufferSize, indexBufferSize, MESHLET_CAPACITY, SUBMESH_CAPACITY)) {
+        return false;
+    }
+    m_pool->meshlets.resize(MESHLET_CAPACITY);
+    m_pool->submeshes.resize(SUBMESH_CAPACITY);
+
+    m_vertexBuffer = CreateGeometryBuffer(m_device, vertexBufferSize);
+    m_indexBuffer = CreateGeometryBuffer(m_device, indexBufferSize);
+    if (m_vertexBuffer == nullptr || m_indexBuffer == nullptr) {
+        return false;
+    }
+    m_vertexBuffer->SetName(L"Mesh Library Vertex Buffer");
+    m_indexBuffer->SetName(L"Mesh Library Index Buffer");
+
+    {   // staging ring, upload heap resources can stay mapped for their entire lifetime
+        stagingBufferSize = AlignBufferSize(stagingBufferSize);
+        m_stagingBuffer = CreateBuffer(m_device, stagingBufferSize, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+        if (m_stagingBuffer == nullptr) {
+            return false;
+        }
+        m_stagingBuffer->SetName(L"Mesh Library Staging Buffer");
+        D3D12_RANGE readRange = {};
+        void* map = nullptr;
+        auto res = m_stagingBuffer->Map(0, &readRange, &map);
+        MINI_ASSERT(SUCCEEDED(res), "Failed to map staging buffer");
+        m_stagingBufferData = static_cast<char*>(map);
+        m_pool->stagingRing.Initialize(stagingBufferSize);
+    }
+    {   // copy queue and everything needed to record and track submissions on it
+        D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+        queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COPY;
+        queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+        auto res = m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&m_copyQueue));
+        MINI_ASSERT(SUCCEEDED(res), "Failed to create copy queue");
+        for (auto& context : m_pool->copyContexts) {
+            res = m_device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COPY, IID_PPV_ARGS(&context.allocator));
+            MINI_ASSERT(SUCCEEDED(res), "Failed to create copy command allocator");
+        }
+        res = m_device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COPY, m_pool->copyContexts[0].allocator, nullptr, IID_PPV_ARGS(&m_copyCommandList));
+        MINI_ASSERT(SUCCEEDED(res), "Failed to create copy command list");
+        m_copyCommandList->Close();
+        res = m_device->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_copyFence));
+        MINI_ASSERT(SUCCEEDED(res), "Failed to create copy fence");
+        m_copyFenceEvent = CreateEvent(0, 0, FALSE, 0);
+        MINI_ASSERT(m_copyFenceEvent != NULL, "Failed to create copy fence event");
+        if (m_copyQueue == nullptr || m_copyCommandList == nullptr || m_copyFence == nullptr) {
+            return false;
+        }
+    }
 
-    // create a descriptor heap for vertex and index buffer SRVs 
+    // create a descriptor heap for the vertex and index buffer SRVs 
     D3D12_DESCRIPTOR_HEAP_DESC desc = {};
     desc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-    desc.NumDescriptors = poolSize * 2;     // @note see notes for MeshLibrary::SetData
+    desc.NumDescriptors = 2;
     desc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;   // @note this heap doesn't need to be shader visible because descriptors are copied into a ringbuffer at render time
     desc.NodeMask = 0;
     auto res = m_device->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&m_srvHeap));
@@ -42,10 +188,13 @@ bool mini::MeshLibrary::Initialize(ID3D12Device* device, uint32_t poolSize)
     if (FAILED(res)) {
         return false;
     }
+    CreateGeometryBufferViews(m_device, m_srvHeap, m_vertexBuffer, vertexBufferSize, m_indexBuffer, indexBufferSize);
 
 
     // @note reserve first element for a fallback mesh so missing resources are visually represented in the scene
-    m_pool->elements[0].isUsed = true;  
+    //       the first allocation from a fresh pool always lands in slot 0 with generation 0, i.e. the default handle
+    auto const fallbackHandle = m_pool->slots.Allocate();
+    MINI_ASSERT(fallbackHandle.handle == 0, "Fallback mesh must occupy slot 0");
     {
         char* meshDataBuf = nullptr;   // @note we share an allocation for vertices and indices
         mini::MeshData meshData;
@@ -74,7 +223,7 @@ bool mini::MeshLibrary::Initialize(ID3D12Device* device, uint32_t poolSize)
             memcpy(meshData.indexData, mesh->triangles, meshData.indexDataSize);
         }
 
-        SetData({ 0 }, meshData);
+        SetData(fallbackHandle, meshData);
         free(meshDataBuf);  // @note we can free our mesh data here since we don't have a reason to keep it around any longer
     }
 
@@ -86,16 +235,12 @@ bool mini::MeshLibrary::Initialize(ID3D12Device* device, uint32_t poolSize)
 
 mini::MeshResourceHandle mini::MeshLibrary::Allocate(ResourceID const& resourceId) const
 {
-    for(auto i = 0u; i < m_pool->size; ++i)
-    {
-        if(m_pool->elements[i].isUsed == false)
-        {
-            m_pool->elements[i].isUsed = true;
-            m_pool->elements[i].resourceId = resourceId;
-            return { i };   
-        }
+    auto handle = m_pool->slots.Allocate();
+    if (!m_pool->slots.IsValid(handle)) {
+        return MeshResourceHandle();    // @note slot 0 is reserved for error case
     }
-    return MeshResourceHandle();    // @note index 0 is reserved for error case
+    m_pool->slots.LookupCold(handle)->resourceId = resourceId;
+    return handle;
 }
 
 mini::MeshResourceHandle mini::MeshLibrary::AllocateWithData(ResourceID const& resourceId, MeshData const& data)
@@ -106,141 +251,323 @@ mini::MeshResourceHandle mini::MeshLibrary::AllocateWithData(ResourceID const& r
     return handle;
 }
 
+mini::MeshResourceHandle mini::MeshLibrary::AllocateFromGTMesh(ResourceID const& resourceId, char const* fileData, uint64_t fileSize)
+{
+    GTMeshView view;
+    if (ParseGTMesh(fileData, fileSize, &view) != GTMeshParseResult::Success) {
+        return MeshResourceHandle();
+    }
+    MeshData data;
+    GetGTMeshData(view, &m_pool->gtmeshScratch, &data);
+    return AllocateWithData(resourceId, data);
+}
+
+void mini::MeshLibrary::AllocateWithData(ResourceID const* resourceIds, MeshData const* data, uint32_t count, MeshResourceHandle* outHandles)
+{
+    for (auto i = 0u; i < count; ++i) {
+        outHandles[i] = AllocateWithData(resourceIds[i], data[i]);
+    }
+}
+
 mini::MeshResource const* mini::MeshLibrary::Lookup(MeshResourceHandle handle) const
 {
-    // @todo assert generation here
-    if (!m_pool->elements[handle.handle].isUsed) { return nullptr; }
-    return &m_pool->elements[handle.handle].resource;
+    // @note stale handles resolve to the fallback mesh so use after free shows up visually instead of reading recycled data
+    auto resource = m_pool->slots.LookupHot(handle);
+    return resource != nullptr ? resource : m_pool->slots.LookupHot(MeshResourceHandle());
+}
+
+bool mini::MeshLibrary::IsValid(MeshResourceHandle handle) const
+{
+    return m_pool->slots.IsValid(handle);
+}
+
+mini::Meshlet const* mini::MeshLibrary::GetMeshlets(MeshResource const& resource) const
+{
+    return m_pool->meshlets.data() + resource.firstMeshlet;
+}
+
+mini::Submesh const* mini::MeshLibrary::GetSubmeshes(MeshResource const& resource) const
+{
+    return m_pool->submeshes.data() + resource.firstSubmesh;
 }
 
 mini::MeshResourceHandle mini::MeshLibrary::GetHandleForResourceId(ResourceID resourceId) const
 {
-    for(auto i = 0u; i < m_pool->size; ++i)
-    {
-        if(m_pool->elements[i].resourceId == resourceId)
-        {
-            return { i };
+    MeshResourceHandle result;
+    bool found = false;
+    m_pool->slots.ForEach([&](MeshResourceHandle handle, MeshResource const&, MeshPool::ColdData const& cold) {
+        if (!found && cold.resourceId == resourceId) {
+            result = handle;
+            found = true;
         }
-    }
-    return MeshResourceHandle();
+    });
+    return result;
 }
 
+void mini::MeshLibrary::Destroy(MeshResourceHandle handle)
+{
+    MINI_ASSERT(handle.handle != 0, "Can't destroy the fallback mesh");
+    auto cold = m_pool->slots.LookupCold(handle);
+    if (handle.handle == 0 || cold == nullptr) { return; }
+
+    // @note    freeing the slot right away bumps its generation so the handle resolves to the fallback mesh from here on,
+    //          while the buffer ranges stay reserved until no frame in flight can read them anymore
+    m_pool->allocator.Release(cold->allocations);
+    cold->allocations = MeshAllocations();
+    m_pool->slots.Free(handle);
+}
 
-void mini::MeshLibrary::SetData(MeshResourceHandle handle, MeshData const& data) const
+void mini::MeshLibrary::BeginFrame(uint64_t frameFenceValue, uint64_t completedFenceValue)
 {
-    auto& resource = m_pool->elements[handle.handle].resource;
+    m_pool->allocator.BeginFrame(frameFenceValue, completedFenceValue);
+}
 
-    resource.numVertices = data.vertexDataSize / data.vertexStride;
-    resource.numIndices = data.indexDataSize / GetIndexFormatStride(data.indexFormat);
+uint32_t mini::MeshLibrary::CollectGarbage(uint64_t completedFenceValue)
+{
+    return m_pool->allocator.CollectGarbage(completedFenceValue);
+}
 
-    {   // Vertex Buffer
-        // @todo    Use a staging buffer for uploading and issue a GPU copy into GPU exclusive memory 
-        //          instead of using an upload heap for the vertex data 
+uint64_t mini::MeshLibrary::GetResidentBytes() const
+{
+    return m_pool->allocator.GetResidentBytes();
+}
 
-        D3D12_HEAP_PROPERTIES heapProperties = {};
-        heapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
-        heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-        heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+uint32_t mini::MeshLibrary::GetNumPendingDestroys() const
+{
+    return m_pool->allocator.GetNumPendingReleases();
+}
 
-        D3D12_RESOURCE_DESC desc = {};
-        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-        desc.Alignment = 0;
-        desc.Width = data.vertexDataSize;
-        desc.Height = 1;
-        desc.DepthOrArraySize = 1;
-        desc.MipLevels = 1;
-        desc.Format = DXGI_FORMAT_UNKNOWN;
-        desc.SampleDesc.Count = 1;
-        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-        desc.Flags = D3D12_RESOURCE_FLAG_NONE;
-        // @note we allow the runtime to manage our memory allocation here
-        auto res = m_device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource.vertexBufferResource));
-        MINI_ASSERT(SUCCEEDED(res), "Failed to create commited resource for vertex buffer");
+uint64_t mini::MeshLibrary::GetBufferViews() const
+{
+    return m_srvHeap->GetCPUDescriptorHandleForHeapStart().ptr;
+}
 
 
-        D3D12_RANGE readRange = {};
-        void* map = nullptr;
-        res = resource.vertexBufferResource->Map(0, &readRange, &map);
-        MINI_ASSERT(SUCCEEDED(res), "Failed to map vertex buffer");
-        memcpy(map, data.vertexData, data.vertexDataSize);
-        resource.vertexBufferResource->Unmap(0, 0);
+void mini::MeshLibrary::SetData(MeshResourceHandle handle, MeshData const& data) const
+{
+    MINI_ASSERT(m_pool->slots.IsValid(handle), "Invalid mesh handle");
+    auto& resource = *m_pool->slots.LookupHot(handle);
+    auto& cold = *m_pool->slots.LookupCold(handle);
+
+    // @note    whatever the mesh had before is released like Destroy does: frames in flight may still draw the old ranges, so they
+    //          stay reserved until the frame fence passes and the new data never lands on top of them
+    m_pool->allocator.Release(cold.allocations);
+    cold.allocations = MeshAllocations();
+
+    if (!m_pool->allocator.AllocateGeometry(AlignBufferSize(data.vertexDataSize), AlignBufferSize(data.indexDataSize), &cold.allocations)) {
+        resource = MeshResource();
+        return;
     }
 
-    {   // Index buffer
-        // @todo    Use a staging buffer for uploading and issue a GPU copy into GPU exclusive memory 
-        //          instead of using an upload heap for the index data
-        // @todo    Share an allocation between vertex and index data
+    StageCopy(m_vertexBuffer, cold.allocations.vertex.offset, data.vertexData, data.vertexDataSize);
+    StageCopy(m_indexBuffer, cold.allocations.index.offset, data.indexData, data.indexDataSize);
 
-        D3D12_HEAP_PROPERTIES heapProperties = {};
-        heapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
-        heapProperties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-        heapProperties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    resource.vertexOffset = cold.allocations.vertex.offset;
+    resource.indexOffset = cold.allocations.index.offset;
+    resource.vertexStride = data.vertexStride;
+    resource.indexFormat = data.indexFormat;
+    resource.vertexFormat = data.vertexFormat;
+    memcpy(resource.positionOffset, data.positionOffset, sizeof(resource.positionOffset));
+    memcpy(resource.positionScale, data.positionScale, sizeof(resource.positionScale));
+    resource.numVertices = data.vertexDataSize / data.vertexStride;
+    resource.numIndices = data.indexDataSize / GetIndexFormatStride(data.indexFormat);
 
-        D3D12_RESOURCE_DESC desc = {};
-        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-        desc.Alignment = 0;
-        desc.Width = data.indexDataSize;
-        desc.Height = 1;
-        desc.DepthOrArraySize = 1;
-        desc.MipLevels = 1;
-        desc.Format = DXGI_FORMAT_UNKNOWN;
-        desc.SampleDesc.Count = 1;
-        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-        desc.Flags = D3D12_RESOURCE_FLAG_NONE;
-        // @note we allow the runtime to manage our memory allocation here
-        auto res = m_device->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&resource.indexBufferResource));
-        MINI_ASSERT(SUCCEEDED(res), "Failed to create commited resource for index buffer");
+    resource.firstMeshlet = resource.numMeshlets = 0;
+    if (data.numMeshlets > 0) {
+        cold.allocations.meshlet = m_pool->allocator.AllocateMeshlets(data.numMeshlets);
+        if (cold.allocations.meshlet.IsValid()) {
+            memcpy(m_pool->meshlets.data() + cold.allocations.meshlet.offset, data.meshlets, data.numMeshlets * sizeof(Meshlet));
+            resource.firstMeshlet = cold.allocations.meshlet.offset;
+            resource.numMeshlets = data.numMeshlets;
+        }
+    }
 
+    MINI_ASSERT(data.numLods <= MAX_MESH_LODS, "Too many LODs");
+    resource.numLods = data.numLods < MAX_MESH_LODS ? data.numLods : MAX_MESH_LODS;
+    for (auto i = 0u; i < resource.numLods; ++i) {
+        resource.lods[i] = data.lods[i];
+        if (resource.numMeshlets == 0) {
+            resource.lods[i].firstMeshlet = resource.lods[i].numMeshlets = 0;   // @note out of meshlet memory, LODs are drawn whole
+        }
+    }
+    if (resource.numLods == 0) {
+        resource.lods[0] = { 0, resource.numIndices, 0, resource.numMeshlets, 0.0f };
+        resource.numLods = 1;
+    }
 
-        D3D12_RANGE readRange = {};
-        void* map = nullptr;
-        res = resource.indexBufferResource->Map(0, &readRange, &map);
-        MINI_ASSERT(SUCCEEDED(res), "Failed to map index buffer");
-        memcpy(map, data.indexData, data.indexDataSize);
-        resource.indexBufferResource->Unmap(0, 0);
+    // @note without submeshes LOD 0 becomes one, so drawing by submesh works for every mesh
+    Submesh const wholeMesh = { resource.lods[0].firstIndex, resource.lods[0].numIndices, 0 };
+    auto const submeshes = data.numSubmeshes > 0 ? data.submeshes : &wholeMesh;
+    auto const numSubmeshes = data.numSubmeshes > 0 ? data.numSubmeshes : 1;
+    resource.firstSubmesh = resource.numSubmeshes = 0;
+    cold.allocations.submesh = m_pool->allocator.AllocateSubmeshes(numSubmeshes);
+    if (cold.allocations.submesh.IsValid()) {
+        for (auto i = 0u; i < numSubmeshes; ++i) {
+            MINI_ASSERT(submeshes[i].firstIndex + submeshes[i].numIndices <= resource.numIndices, "Submesh is out of the mesh's index range");
+        }
+        memcpy(m_pool->submeshes.data() + cold.allocations.submesh.offset, submeshes, numSubmeshes * sizeof(Submesh));
+        resource.firstSubmesh = cold.allocations.submesh.offset;
+        resource.numSubmeshes = numSubmeshes;
     }
 
+    // @note quantized positions span exactly their AABB, see VertexQuantization.h, float positions are scanned
+    if (data.bounds != nullptr) {
+        resource.bounds = *data.bounds;
+    }
+    else if (IsQuantizedVertexFormat(data.vertexFormat)) {
+        float const aabbMax[3] = { data.positionOffset[0] + data.positionScale[0], data.positionOffset[1] + data.positionScale[1], data.positionOffset[2] + data.positionScale[2] };
+        resource.bounds = MakeMeshBounds(data.positionOffset, aabbMax);
+    }
+    else {
+        resource.bounds = ComputeMeshBounds(data.vertexData, resource.numVertices, data.vertexStride);
+    }
+}
+
+
+void mini::MeshLibrary::Defragment()
+{
+    // @note the GPU is idle, so meshes waiting for destruction can go now. compaction would drop their ranges anyway
+    CollectGarbage(UINT64_MAX);
+
+    eastl::vector<MeshResourceHandle> handles;
+    eastl::vector<OffsetAllocation> vertexAllocations;
+    eastl::vector<OffsetAllocation> indexAllocations;
+    m_pool->slots.ForEach([&](MeshResourceHandle handle, MeshResource const&, MeshPool::ColdData const& cold) {
+        handles.push_back(handle);
+        vertexAllocations.push_back(cold.allocations.vertex);
+        indexAllocations.push_back(cold.allocations.index);
+    });
+
+    // @note    buffer to buffer copies within the same resource must not overlap, which compaction can't guarantee, 
+    //          so live ranges are copied into new buffers instead. this briefly needs twice the memory
+    auto& vertexAllocator = m_pool->allocator.GetVertexAllocator();
+    auto& indexAllocator = m_pool->allocator.GetIndexAllocator();
+    auto const vertexBufferSize = vertexAllocator.GetSize();
+    auto const indexBufferSize = indexAllocator.GetSize();
+    auto newVertexBuffer = CreateGeometryBuffer(m_device, vertexBufferSize);
+    auto newIndexBuffer = CreateGeometryBuffer(m_device, indexBufferSize);
+    MINI_ASSERT(newVertexBuffer != nullptr && newIndexBuffer != nullptr, "Failed to create geometry buffers for defragmentation");
+    if (newVertexBuffer == nullptr || newIndexBuffer == nullptr) {
+        if (newVertexBuffer != nullptr) { newVertexBuffer->Release(); }
+        if (newIndexBuffer != nullptr) { newIndexBuffer->Release(); }
+        return;
+    }
+    newVertexBuffer->SetName(L"Mesh Library Vertex Buffer");
+    newIndexBuffer->SetName(L"Mesh Library Index Buffer");
+
+    // @note copies staged so far target the old buffers and have to land before their contents are moved over
+    WaitForCopyFence(SubmitCopies());
+
+    eastl::vector<OffsetAllocation> oldVertexAllocations = vertexAllocations;
+    eastl::vector<OffsetAllocation> oldIndexAllocations = indexAllocations;
+    eastl::vector<OffsetAllocatorMove> moves(handles.size());
+    vertexAllocator.Compact(vertexAllocations.data(), static_cast<uint32_t>(handles.size()), moves.data());
+    indexAllocator.Compact(indexAllocations.data(), static_cast<uint32_t>(handles.size()), moves.data());
+
+    for (auto i = 0u; i < handles.size(); ++i) {
+        auto const vertexSize = vertexAllocator.GetAllocationSize(vertexAllocations[i]);
+        auto const indexSize = indexAllocator.GetAllocationSize(indexAllocations[i]);
+        if (vertexSize > 0) {
+            m_pool->pendingCopies.push_back({ newVertexBuffer, m_vertexBuffer, vertexAllocations[i].offset, oldVertexAllocations[i].offset, vertexSize });
+        }
+        if (indexSize > 0) {
+            m_pool->pendingCopies.push_back({ newIndexBuffer, m_indexBuffer, indexAllocations[i].offset, oldIndexAllocations[i].offset, indexSize });
+        }
+    }
+    WaitForCopyFence(SubmitCopies());
+
+    m_vertexBuffer->Release();
+    m_indexBuffer->Release();
+    m_vertexBuffer = newVertexBuffer;
+    m_indexBuffer = newIndexBuffer;
+    CreateGeometryBufferViews(m_device, m_srvHeap, m_vertexBuffer, vertexBufferSize, m_indexBuffer, indexBufferSize);
+
+    for (auto i = 0u; i < handles.size(); ++i) {
+        auto& resource = *m_pool->slots.LookupHot(handles[i]);
+        auto& cold = *m_pool->slots.LookupCold(handles[i]);
+        cold.allocations.vertex = vertexAllocations[i];
+        cold.allocations.index = indexAllocations[i];
+        resource.vertexOffset = vertexAllocations[i].offset;
+        resource.indexOffset = indexAllocations[i].offset;
+    }
+}
 
-    auto srvStartCPU = m_srvHeap->GetCPUDescriptorHandleForHeapStart();
-    auto const incrSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+float mini::MeshLibrary::GetFragmentation() const
+{
+    return m_pool->allocator.GetFragmentation();
+}
 
-    D3D12_CPU_DESCRIPTOR_HANDLE vertexBufferSRVCPU = srvStartCPU;
 
-    // @note we allocate descriptors in pairs of 2 (one for vertex and index buffer each), using the index of the resource as an index into the descriptor pool 
-    vertexBufferSRVCPU.ptr += incrSize * 2 * handle.handle;
-    {
-        D3D12_SHADER_RESOURCE_VIEW_DESC desc = {};
-        desc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-        desc.Format = DXGI_FORMAT_UNKNOWN;
-        desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        desc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
-        desc.Buffer.FirstElement = 0;
-        desc.Buffer.NumElements = data.vertexDataSize / data.vertexStride;
-        desc.Buffer.StructureByteStride = data.vertexStride;
-        m_device->CreateShaderResourceView(resource.vertexBufferResource, &desc, vertexBufferSRVCPU);
+void mini::MeshLibrary::StageCopy(ID3D12Resource* dst, uint32_t dstOffset, char const* src, uint32_t size) const
+{
+    auto& ring = m_pool->stagingRing;
+    // @note large meshes are split up so they can't exceed the ring, smaller chunks also let the ring recycle earlier batches
+    auto const maxChunkSize = ring.GetSize() / 4;
+    while (size > 0) {
+        auto const chunkSize = size < maxChunkSize ? size : maxChunkSize;
+        auto stagingOffset = ring.Allocate(chunkSize, BUFFER_ALIGNMENT);
+        if (stagingOffset == RingAllocator::NO_SPACE) {
+            // ring is full, kick off what we have and wait for the copy queue to drain it
+            ring.Reclaim(m_copyFence->GetCompletedValue());
+            stagingOffset = ring.Allocate(chunkSize, BUFFER_ALIGNMENT);
+            if (stagingOffset == RingAllocator::NO_SPACE) {
+                WaitForCopyFence(SubmitCopies());
+                ring.Reclaim(m_copyFence->GetCompletedValue());
+                stagingOffset = ring.Allocate(chunkSize, BUFFER_ALIGNMENT);
+            }
+            MINI_ASSERT(stagingOffset != RingAllocator::NO_SPACE, "Failed to allocate staging memory");
+        }
+
+        memcpy(m_stagingBufferData + stagingOffset, src, chunkSize);
+        m_pool->pendingCopies.push_back({ dst, m_stagingBuffer, dstOffset, stagingOffset, chunkSize });
+        src += chunkSize;
+        dstOffset += chunkSize;
+        size -= chunkSize;
     }
-    D3D12_CPU_DESCRIPTOR_HANDLE indexBufferSRVCPU = vertexBufferSRVCPU;
-    indexBufferSRVCPU.ptr += incrSize;
-    {
-        DXGI_FORMAT indexFormats[] = {
-            DXGI_FORMAT_R16_UINT,
-            DXGI_FORMAT_R32_UINT
-        };
+}
 
-        D3D12_SHADER_RESOURCE_VIEW_DESC desc = {};
-        desc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-        desc.Format = indexFormats[static_cast<int>(data.indexFormat)];
-        desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-        desc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
-        desc.Buffer.FirstElement = 0;
-        desc.Buffer.NumElements = resource.numIndices;
-        desc.Buffer.StructureByteStride = 0;
-        m_device->CreateShaderResourceView(resource.indexBufferResource, &desc, indexBufferSRVCPU);
+uint64_t mini::MeshLibrary::SubmitCopies() const
+{
+    if (m_pool->pendingCopies.empty()) {
+        return m_pool->copyFenceValue;
     }
 
-    // @note we use the CPU descriptor here because we copy these on the CPU timeline into a per-frame ringbuffer at render time
-    resource.vertexBufferView = vertexBufferSRVCPU.ptr;
-    resource.indexBufferView = indexBufferSRVCPU.ptr;
+    auto& context = m_pool->copyContexts[m_pool->nextCopyContext];
+    m_pool->nextCopyContext = (m_pool->nextCopyContext + 1) % NUM_COPY_CONTEXTS;
+    WaitForCopyFence(context.fenceValue);   // @note the allocator can't be reset while its previous submission is in flight
+
+    context.allocator->Reset();
+    m_copyCommandList->Reset(context.allocator, nullptr);
+    for (auto const& copy : m_pool->pendingCopies) {
+        m_copyCommandList->CopyBufferRegion(copy.dst, copy.dstOffset, copy.src, copy.srcOffset, copy.size);
+    }
+    m_copyCommandList->Close();
+
+    ID3D12CommandList* submits[] = { m_copyCommandList };
+    m_copyQueue->ExecuteCommandLists(1, submits);
+    m_pool->copyFenceValue++;
+    m_copyQueue->Signal(m_copyFence, m_pool->copyFenceValue);
+
+    context.fenceValue = m_pool->copyFenceValue;
+    m_pool->stagingRing.CloseBatch(m_pool->copyFenceValue);
+    m_pool->pendingCopies.clear();
+    return m_pool->copyFenceValue;
 }
 
+void mini::MeshLibrary::WaitForCopyFence(uint64_t fenceValue) const
+{
+    if (m_copyFence->GetCompletedValue() < fenceValue) {
+        m_copyFence->SetEventOnCompletion(fenceValue, m_copyFenceEvent);
+        WaitForSingleObject(m_copyFenceEvent, INFINITE);
+    }
+}
 
+uint64_t mini::MeshLibrary::FlushUploads(ID3D12CommandQueue* graphicsQueue) const
+{
+    m_pool->stagingRing.Reclaim(m_copyFence->GetCompletedValue());
+    auto const fenceValue = SubmitCopies();
+    if (graphicsQueue != nullptr && fenceValue > 0) {
+        graphicsQueue->Wait(m_copyFence, fenceValue);   // @note GPU side wait, doesn't block the CPU
+    }
+    return fenceValue;
+}
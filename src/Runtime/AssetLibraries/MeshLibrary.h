@@ -5,6 +5,9 @@
 struct ID3D12Device;
 struct ID3D12DescriptorHeap;
 struct ID3D12Resource;
+struct ID3D12CommandQueue;
+struct ID3D12GraphicsCommandList;
+struct ID3D12Fence;
 
 namespace mini
 {
@@ -19,6 +22,73 @@ namespace mini
         return format == IndexFormat::R16_UINT ? sizeof(uint16_t) : sizeof(uint32_t);
     }
 
+    // @note must stay in sync with LoadVertex in Shader.hlsl
+    enum class VertexFormat : uint8_t
+    {
+        PositionNormal,                     // float3 position, float3 normal
+        PositionNormalTangentUV,            // float3 position, float3 normal, float4 tangent, float2 uv (.gtmesh layout)
+        QuantizedPositionNormal,            // unorm16x4 position, octahedral snorm16x2 normal
+        QuantizedPositionNormalTangentUV,   // unorm16x4 position (w = bitangent sign), octahedral snorm16x2 normal and tangent, half2 uv
+    };
+
+    static constexpr uint32_t GetVertexFormatStride(VertexFormat format)
+    {
+        return format == VertexFormat::PositionNormal ? 24 :
+            format == VertexFormat::PositionNormalTangentUV ? 48 :
+            format == VertexFormat::QuantizedPositionNormal ? 12 : 20;
+    }
+
+    static constexpr bool IsQuantizedVertexFormat(VertexFormat format)
+    {
+        return format == VertexFormat::QuantizedPositionNormal || format == VertexFormat::QuantizedPositionNormalTangentUV;
+    }
+
+    static constexpr uint32_t MAX_MESHLET_VERTICES  = 64;
+    static constexpr uint32_t MAX_MESHLET_TRIANGLES = 124;
+
+    // @note    a cluster of at most MAX_MESHLET_VERTICES unique vertices and MAX_MESHLET_TRIANGLES triangles. its triangles are a 
+    //          contiguous range of the mesh's indices, so a visible meshlet is drawn by offsetting into them. bounds are in object space
+    struct Meshlet
+    {
+        float       center[3];
+        float       radius;
+        float       coneAxis[3];    // average facing of the triangles
+        float       coneCutoff;     // sine of the normal cone's half angle, 1 if the normals spread too far for backface culling
+        uint32_t    firstIndex;
+        uint32_t    numIndices;
+    };
+
+    static constexpr uint32_t MAX_MESH_LODS = 8;
+
+    // @note    LODs share the mesh's vertices, each one is a range of its indices with its own meshlets.
+    //          error is the geometric deviation from LOD 0 in object space units, it never decreases along the chain
+    struct MeshLod
+    {
+        uint32_t    firstIndex;
+        uint32_t    numIndices;
+        uint32_t    firstMeshlet;   // relative to the mesh's first meshlet
+        uint32_t    numMeshlets;
+        float       error;
+    };
+
+    // @note object space bounds, the sphere is centered on the box and encloses every vertex
+    struct MeshBounds
+    {
+        float       aabbMin[3] = { 0.0f, 0.0f, 0.0f };
+        float       aabbMax[3] = { 0.0f, 0.0f, 0.0f };
+        float       sphereCenter[3] = { 0.0f, 0.0f, 0.0f };
+        float       sphereRadius = 0.0f;
+    };
+
+    // @note    a range of LOD 0's indices drawn with one material, materialSlot indexes the materials of whatever draws the mesh.
+    //          simplification and meshlet building reorder indices across submeshes, cooked meshes with LODs have a single one
+    struct Submesh
+    {
+        uint32_t    firstIndex;
+        uint32_t    numIndices;
+        uint32_t    materialSlot;
+    };
+
     struct  MeshResource;
     struct  MeshData
     {
@@ -29,41 +99,127 @@ namespace mini
         IndexFormat indexFormat = IndexFormat::R16_UINT;
         uint32_t    vertexDataSize = 0;
         uint32_t    indexDataSize = 0;
+
+        VertexFormat vertexFormat = VertexFormat::PositionNormal;
+        float       positionOffset[3] = { 0.0f, 0.0f, 0.0f };   // @note quantized positions decode to offset + unorm * scale
+        float       positionScale[3] = { 1.0f, 1.0f, 1.0f };
+
+        Meshlet const*  meshlets = nullptr;     // @note optional, see MeshletBuilder.h
+        uint32_t        numMeshlets = 0;
+        MeshLod const*  lods = nullptr;         // @note optional, see MeshSimplifier.h. without LODs the whole mesh is LOD 0
+        uint32_t        numLods = 0;
+        MeshBounds const*   bounds = nullptr;   // @note optional, computed from the vertices when missing
+        Submesh const*      submeshes = nullptr;    // @note optional, without submeshes LOD 0 is a single submesh with material slot 0
+        uint32_t            numSubmeshes = 0;
     };
 
     struct  MeshPool;
 
     struct ResourceID;
 
+    /*
+        *   All geometry lives in two large buffers, one for vertices and one for indices, sub-allocated per mesh.
+        *   Shaders see both through a single pair of raw SRVs and address a mesh by the offsets in its MeshResource.
+        *   The buffers live in GPU local memory. Mesh data is written into a persistently mapped staging ring and copied over 
+        *   on a dedicated copy queue, batched until FlushUploads is called. Staging memory is reclaimed once the copy fence passes it.
+    */
     class MeshLibrary
     {
         ID3D12Device*           m_device = nullptr;
         ID3D12DescriptorHeap*   m_srvHeap = nullptr;
         MeshPool*               m_pool = nullptr;
-    public:
 
-        bool                Initialize(ID3D12Device* device, uint32_t poolSize);
+        ID3D12Resource*         m_vertexBuffer = nullptr;
+        ID3D12Resource*         m_indexBuffer = nullptr;
+
+        ID3D12CommandQueue*         m_copyQueue = nullptr;
+        ID3D12GraphicsCommandList*  m_copyCommandList = nullptr;
+        ID3D12Fence*                m_copyFence = nullptr;
+        void*                       m_copyFenceEvent = nullptr;
+        ID3D12Resource*             m_stagingBuffer = nullptr;
+        char*                       m_stagingBufferData = nullptr;  // @note persistently mapped
+
+        void                StageCopy(ID3D12Resource* dst, uint32_t dstOffset, char const* src, uint32_t size) const;
+        uint64_t            SubmitCopies() const;
+        void                WaitForCopyFence(uint64_t fenceValue) const;
+    public:
+        static constexpr uint32_t DEFAULT_VERTEX_BUFFER_SIZE    = 64 * 1024 * 1024;
+        static constexpr uint32_t DEFAULT_INDEX_BUFFER_SIZE     = 32 * 1024 * 1024;
+        static constexpr uint32_t DEFAULT_STAGING_BUFFER_SIZE   = 16 * 1024 * 1024;
+        static constexpr uint32_t BUFFER_ALIGNMENT              = 16;   // @note keeps offsets aligned for raw buffer loads
+        static constexpr uint32_t NUM_COPY_CONTEXTS             = 3;
+        static constexpr uint32_t MESHLET_CAPACITY              = 128 * 1024;
+        static constexpr uint32_t SUBMESH_CAPACITY              = 64 * 1024;
+
+        // @note    buffer ranges are sized for poolSize live meshes plus GetMaxPendingDestroys destroyed ones waiting for their frames,
+        //          so a whole pool's worth of meshes can be swapped out at once, e.g. when a level is replaced by the next one
+        static constexpr uint32_t GetMaxPendingDestroys(uint32_t poolSize) { return poolSize; }
+        bool                Initialize(ID3D12Device* device, uint32_t poolSize, uint32_t vertexBufferSize = DEFAULT_VERTEX_BUFFER_SIZE, uint32_t indexBufferSize = DEFAULT_INDEX_BUFFER_SIZE, uint32_t stagingBufferSize = DEFAULT_STAGING_BUFFER_SIZE);
 
         MeshResourceHandle  Allocate(ResourceID const& resourceId) const;
         MeshResourceHandle  AllocateWithData(ResourceID const& resourceId, MeshData const& data);
+        // @note    parses a .gtmesh file (see GTMesh.h) and stages its vertices and indices straight from fileData, the file can be
+        //          freed once this returns. returns the fallback handle if the file is rejected
+        MeshResourceHandle  AllocateFromGTMesh(ResourceID const& resourceId, char const* fileData, uint64_t fileSize);
+        // @note batched version, all meshes end up in the same copy submission unless they overflow the staging ring
+        void                AllocateWithData(ResourceID const* resourceIds, MeshData const* data, uint32_t count, MeshResourceHandle* outHandles);
+        // @note    the data is copied into staging memory right away but only reaches the GPU with the next FlushUploads. the previous
+        //          data's ranges are released like Destroy's, frames in flight keep drawing the old mesh
         void                SetData(MeshResourceHandle handle, MeshData const& data) const;
+
+        // submits all staged copies on the copy queue and makes graphicsQueue wait for them, returns the copy fence value of the submission
+        uint64_t            FlushUploads(ID3D12CommandQueue* graphicsQueue) const;
         MeshResource const* Lookup(MeshResourceHandle handle) const;
         MeshResourceHandle  GetHandleForResourceId(ResourceID resourceId) const;
-
-        void                Destroy(MeshResourceHandle);
+        bool                IsValid(MeshResourceHandle handle) const;
+        // @note CPU side copy of the mesh's meshlets, resource.numMeshlets entries. meshlets are only needed for culling so they never go to the GPU
+        Meshlet const*      GetMeshlets(MeshResource const& resource) const;
+        // @note resource.numSubmeshes entries, every mesh has at least one unless the library ran out of submesh memory
+        Submesh const*      GetSubmeshes(MeshResource const& resource) const;
+
+        // @note    the handle is invalidated immediately, its buffer ranges are only recycled once the frame fence 
+        //          passed the value given to the last BeginFrame call, i.e. every frame that might still draw the mesh is done
+        void                Destroy(MeshResourceHandle handle);
+
+        // frameFenceValue is signaled once the frame that's about to be recorded finished, completedFenceValue is the last finished one
+        void                BeginFrame(uint64_t frameFenceValue, uint64_t completedFenceValue);
+        // releases the buffer ranges of destroyed meshes whose frames are done, returns the number of released meshes
+        uint32_t            CollectGarbage(uint64_t completedFenceValue);
+        // bytes of vertex and index buffer memory in use, including meshes waiting for deferred destruction
+        uint64_t            GetResidentBytes() const;
+        uint32_t            GetNumPendingDestroys() const;
+
+        // @note CPU descriptor handle of the vertex / index buffer SRV pair shared by all meshes
+        uint64_t            GetBufferViews() const;
+
+        // packs all live meshes into freshly allocated geometry buffers, the GPU must not be using any mesh while this runs
+        void                Defragment();
+        float               GetFragmentation() const;
 
     };
 
 
+    // @note this is the hot part of a mesh pool entry that's touched when drawing, 
+    //       buffer allocations and the resource id live in the pool's cold storage
     struct MeshResource
     {
-        uint64_t vertexBufferView = 0;
-        uint64_t indexBufferView = 0;
-
-        ID3D12Resource* vertexBufferResource = nullptr;
-        ID3D12Resource* indexBufferResource = nullptr;
-
-        uint32_t numIndices = 0;
-        uint32_t numVertices = 0;
+        uint32_t    vertexOffset = 0;   // in bytes from the start of the shared vertex buffer
+        uint32_t    indexOffset = 0;    // in bytes from the start of the shared index buffer
+        uint32_t    vertexStride = 0;
+        IndexFormat indexFormat = IndexFormat::R16_UINT;
+        VertexFormat vertexFormat = VertexFormat::PositionNormal;
+
+        uint32_t    numIndices = 0;
+        uint32_t    numVertices = 0;
+        uint32_t    firstMeshlet = 0;
+        uint32_t    numMeshlets = 0;
+        uint32_t    numLods = 0;
+        MeshLod     lods[MAX_MESH_LODS] = {};
+        uint32_t    firstSubmesh = 0;
+        uint32_t    numSubmeshes = 0;
+        MeshBounds  bounds;
+
+        float       positionOffset[3] = { 0.0f, 0.0f, 0.0f };
+        float       positionScale[3] = { 1.0f, 1.0f, 1.0f };
     };
 }
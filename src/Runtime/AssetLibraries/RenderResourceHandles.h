@@ -4,7 +4,9 @@
 
 namespace mini
 {
+    // @note handles are generational, packed as [generation:12 | index:20], see Runtime/Containers/SlotMap.h
+    //       a default constructed handle refers to slot 0 which libraries reserve for their fallback resource
     struct MeshResourceHandle       { uint32_t handle = 0; };
     struct MaterialResourceHandle   { uint32_t handle = 0; };
     struct TextureResourceHandle    { uint32_t handle = 0; };
-}
\ No newline at end of file
+}
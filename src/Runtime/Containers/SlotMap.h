@@ -0,0 +1,174 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/common.h>
+
+namespace mini
+{
+    /*
+        *   Generational slot map
+        *   Handles are plain { uint32_t handle } structs packed as [generation:12 | index:20].
+        *   Freeing a slot bumps its generation, so handles to freed slots fail lookups instead of aliasing whatever reuses the slot.
+        *   Free slots are kept in a FIFO free list which makes Allocate / Free O(1) and spreads reuse of individual slots out as far as possible.
+        *   Per-slot data is split into hot and cold arrays so iteration over frequently accessed data doesn't drag rarely used fields through the cache.
+    */
+    struct SlotMapHandleLayout
+    {
+        static constexpr uint32_t INDEX_BITS        = 20;
+        static constexpr uint32_t GENERATION_BITS   = 32 - INDEX_BITS;
+        static constexpr uint32_t INDEX_MASK        = (1u << INDEX_BITS) - 1;
+        static constexpr uint32_t GENERATION_MASK   = (1u << GENERATION_BITS) - 1;
+        static constexpr uint32_t MAX_CAPACITY      = INDEX_MASK;           // @note the all-ones index is never handed out...
+        static constexpr uint32_t INVALID_HANDLE    = 0xffffffff;           // ...so this can never be a live handle
+
+        static constexpr uint32_t Pack(uint32_t index, uint32_t generation) { return (generation << INDEX_BITS) | index; }
+        static constexpr uint32_t GetIndex(uint32_t handle) { return handle & INDEX_MASK; }
+        static constexpr uint32_t GetGeneration(uint32_t handle) { return handle >> INDEX_BITS; }
+    };
+
+    struct SlotMapNoColdData {};
+
+    template <class HandleT, class HotT, class ColdT = SlotMapNoColdData>
+    class SlotMap
+    {
+        using Layout = SlotMapHandleLayout;
+        static constexpr uint32_t END_OF_LIST = 0xffffffff;
+        static constexpr uint16_t ALIVE_BIT = 0x8000;
+
+        HotT*       m_hot           = nullptr;
+        ColdT*      m_cold          = nullptr;
+        uint16_t*   m_slotStates    = nullptr;  // generation in the low bits, ALIVE_BIT if the slot is in use
+        uint32_t*   m_nextFree      = nullptr;
+        uint32_t    m_freeHead      = END_OF_LIST;
+        uint32_t    m_freeTail      = END_OF_LIST;
+        uint32_t    m_capacity      = 0;
+        uint32_t    m_numAlive      = 0;
+
+        bool IsAliveIndex(uint32_t index) const { return (m_slotStates[index] & ALIVE_BIT) != 0; }
+        uint32_t GetSlotGeneration(uint32_t index) const { return m_slotStates[index] & Layout::GENERATION_MASK; }
+
+    public:
+        SlotMap() = default;
+        SlotMap(SlotMap const&) = delete;
+        SlotMap& operator = (SlotMap const&) = delete;
+        ~SlotMap() { Shutdown(); }
+
+        bool Initialize(uint32_t capacity)
+        {
+            MINI_ASSERT(capacity > 0 && capacity <= Layout::MAX_CAPACITY, "Slot map capacity out of range");
+            if (capacity == 0 || capacity > Layout::MAX_CAPACITY) { return false; }
+
+            m_hot = new HotT[capacity];
+            m_cold = new ColdT[capacity];
+            m_slotStates = new uint16_t[capacity];
+            m_nextFree = new uint32_t[capacity];
+            m_capacity = capacity;
+            m_numAlive = 0;
+            for (auto i = 0u; i < capacity; ++i) {
+                m_slotStates[i] = 0;
+                m_nextFree[i] = i + 1 < capacity ? i + 1 : END_OF_LIST;
+            }
+            m_freeHead = 0;
+            m_freeTail = capacity - 1;
+            return true;
+        }
+
+        void Shutdown()
+        {
+            delete[] m_hot;
+            delete[] m_cold;
+            delete[] m_slotStates;
+            delete[] m_nextFree;
+            m_hot = nullptr;
+            m_cold = nullptr;
+            m_slotStates = nullptr;
+            m_nextFree = nullptr;
+            m_freeHead = m_freeTail = END_OF_LIST;
+            m_capacity = m_numAlive = 0;
+        }
+
+        // @note returns a handle with INVALID_HANDLE as its value if the map is full
+        HandleT Allocate()
+        {
+            HandleT handle;
+            if (m_freeHead == END_OF_LIST) {
+                handle.handle = Layout::INVALID_HANDLE;
+                return handle;
+            }
+            auto const index = m_freeHead;
+            m_freeHead = m_nextFree[index];
+            if (m_freeHead == END_OF_LIST) { m_freeTail = END_OF_LIST; }
+
+            m_slotStates[index] |= ALIVE_BIT;
+            m_numAlive++;
+            handle.handle = Layout::Pack(index, GetSlotGeneration(index));
+            return handle;
+        }
+
+        bool Free(HandleT handle)
+        {
+            if (!IsValid(handle)) { return false; }
+            auto const index = Layout::GetIndex(handle.handle);
+
+            m_hot[index] = HotT();
+            m_cold[index] = ColdT();
+            m_slotStates[index] = static_cast<uint16_t>((GetSlotGeneration(index) + 1) & Layout::GENERATION_MASK);
+            m_numAlive--;
+
+            m_nextFree[index] = END_OF_LIST;
+            if (m_freeTail == END_OF_LIST) {
+                m_freeHead = index;
+            }
+            else {
+                m_nextFree[m_freeTail] = index;
+            }
+            m_freeTail = index;
+            return true;
+        }
+
+        bool IsValid(HandleT handle) const
+        {
+            auto const index = Layout::GetIndex(handle.handle);
+            if (index >= m_capacity || !IsAliveIndex(index)) { return false; }
+            return GetSlotGeneration(index) == Layout::GetGeneration(handle.handle);
+        }
+
+        HotT* LookupHot(HandleT handle) { return IsValid(handle) ? &m_hot[Layout::GetIndex(handle.handle)] : nullptr; }
+        HotT const* LookupHot(HandleT handle) const { return IsValid(handle) ? &m_hot[Layout::GetIndex(handle.handle)] : nullptr; }
+        ColdT* LookupCold(HandleT handle) { return IsValid(handle) ? &m_cold[Layout::GetIndex(handle.handle)] : nullptr; }
+        ColdT const* LookupCold(HandleT handle) const { return IsValid(handle) ? &m_cold[Layout::GetIndex(handle.handle)] : nullptr; }
+
+        // @note unchecked access by slot index, e.g. for data laid out in parallel to the slot map
+        static uint32_t GetIndex(HandleT handle) { return Layout::GetIndex(handle.handle); }
+        HotT& GetHot(uint32_t index) { return m_hot[index]; }
+        HotT const& GetHot(uint32_t index) const { return m_hot[index]; }
+        ColdT& GetCold(uint32_t index) { return m_cold[index]; }
+        ColdT const& GetCold(uint32_t index) const { return m_cold[index]; }
+
+        uint32_t GetCapacity() const { return m_capacity; }
+        uint32_t GetNumAlive() const { return m_numAlive; }
+
+        // calls func(HandleT, HotT&, ColdT&) for every live slot
+        template <class Func>
+        void ForEach(Func&& func)
+        {
+            for (auto i = 0u; i < m_capacity; ++i) {
+                if (!IsAliveIndex(i)) { continue; }
+                HandleT handle;
+                handle.handle = Layout::Pack(i, GetSlotGeneration(i));
+                func(handle, m_hot[i], m_cold[i]);
+            }
+        }
+
+        template <class Func>
+        void ForEach(Func&& func) const
+        {
+            for (auto i = 0u; i < m_capacity; ++i) {
+                if (!IsAliveIndex(i)) { continue; }
+                HandleT handle;
+                handle.handle = Layout::Pack(i, GetSlotGeneration(i));
+                func(handle, m_hot[i], m_cold[i]);
+            }
+        }
+    };
+}
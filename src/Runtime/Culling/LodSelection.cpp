@@ -0,0 +1,28 @@
+#include "LodSelection.h"
+
+#include <math.h>
+
+float mini::ComputeLodProjectionScale(float fovY, float viewportHeight)
+{
+    return viewportHeight / (2.0f * tanf(fovY * 0.5f));
+}
+
+uint32_t mini::SelectMeshLod(MeshResource const& resource, float const position[3], float scale, LodSelectionView const& view)
+{
+    float const d[3] = { position[0] - view.position[0], position[1] - view.position[1], position[2] - view.position[2] };
+    // @note    distance to the bounding sphere wherever the rotation puts it, i.e. the origin's distance minus the sphere's reach.
+    //          that's never further than the closest vertex, so the error can't be underestimated
+    auto const& bounds = resource.bounds;
+    auto const reach = (sqrtf(bounds.sphereCenter[0] * bounds.sphereCenter[0] + bounds.sphereCenter[1] * bounds.sphereCenter[1]
+        + bounds.sphereCenter[2] * bounds.sphereCenter[2]) + bounds.sphereRadius) * scale;
+    auto distance = sqrtf(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]) - reach;
+    distance = distance > view.minDistance ? distance : view.minDistance;
+
+    // @note errors grow along the chain, so compare against the largest error allowed at this distance
+    auto const maxError = view.errorThreshold * distance / (view.projectionScale * scale);
+    uint32_t lod = 0;
+    while (lod + 1 < resource.numLods && resource.lods[lod + 1].error <= maxError) {
+        lod++;
+    }
+    return lod;
+}
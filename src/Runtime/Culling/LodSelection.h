@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+
+namespace mini
+{
+    /*
+        *   Runtime LOD selection by projected screen space error: a LOD's geometric error is projected at the instance's distance
+        *   and the coarsest LOD whose error stays below the threshold in pixels is picked.
+    */
+    struct LodSelectionView
+    {
+        float   position[3] = { 0.0f, 0.0f, 0.0f };
+        float   projectionScale = 1.0f;     // pixels per object space unit at distance 1, see ComputeLodProjectionScale
+        float   errorThreshold = 1.0f;      // in pixels
+        float   minDistance = 0.1f;         // @note usually the near plane, keeps instances around the camera at LOD 0
+    };
+
+    float       ComputeLodProjectionScale(float fovY, float viewportHeight);
+
+    // @note position and scale are the instance's, scale multiplies the LOD errors. the distance is measured to the mesh's bounding sphere
+    uint32_t    SelectMeshLod(MeshResource const& resource, float const position[3], float scale, LodSelectionView const& view);
+}
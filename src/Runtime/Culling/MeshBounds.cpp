@@ -0,0 +1,217 @@
+#include "MeshBounds.h"
+#include <Runtime/common.h>
+#include <Runtime/Math/math_simd.h>
+
+#include <math.h>
+#include <string.h>
+
+namespace
+{
+    inline void LoadPosition(char const* vertex, float* out)
+    {
+        memcpy(out, vertex, sizeof(float) * 3);
+    }
+
+    inline void FinishSphere(mini::MeshBounds* bounds, float maxDistanceSquared)
+    {
+        bounds->sphereRadius = sqrtf(maxDistanceSquared);
+    }
+
+    inline void SetCenter(mini::MeshBounds* bounds)
+    {
+        for (auto k = 0; k < 3; ++k) { bounds->sphereCenter[k] = (bounds->aabbMin[k] + bounds->aabbMax[k]) * 0.5f; }
+    }
+
+    inline float DistanceSquared(float const* a, float const* b)
+    {
+        auto const dx = a[0] - b[0];
+        auto const dy = a[1] - b[1];
+        auto const dz = a[2] - b[2];
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // @note the last vertex might end right after its position, vector loads read 16 bytes so it's left to the scalar tail then
+    inline uint32_t GetNumVectorVertices(uint32_t numVertices, uint32_t vertexStride)
+    {
+        return vertexStride >= sizeof(float) * 4 || numVertices == 0 ? numVertices : numVertices - 1;
+    }
+}
+
+mini::MeshBounds mini::ComputeMeshBoundsScalar(void const* vertices, uint32_t numVertices, uint32_t vertexStride)
+{
+    MeshBounds bounds;
+    if (numVertices == 0) { return bounds; }
+    auto const bytes = static_cast<char const*>(vertices);
+    LoadPosition(bytes, bounds.aabbMin);
+    LoadPosition(bytes, bounds.aabbMax);
+    for (auto i = 1u; i < numVertices; ++i) {
+        float p[3];
+        LoadPosition(bytes + static_cast<size_t>(i) * vertexStride, p);
+        for (auto k = 0; k < 3; ++k) {
+            bounds.aabbMin[k] = p[k] < bounds.aabbMin[k] ? p[k] : bounds.aabbMin[k];
+            bounds.aabbMax[k] = p[k] > bounds.aabbMax[k] ? p[k] : bounds.aabbMax[k];
+        }
+    }
+    SetCenter(&bounds);
+    auto maxDistanceSquared = 0.0f;
+    for (auto i = 0u; i < numVertices; ++i) {
+        float p[3];
+        LoadPosition(bytes + static_cast<size_t>(i) * vertexStride, p);
+        auto const d = DistanceSquared(p, bounds.sphereCenter);
+        maxDistanceSquared = d > maxDistanceSquared ? d : maxDistanceSquared;
+    }
+    FinishSphere(&bounds, maxDistanceSquared);
+    return bounds;
+}
+
+mini::MeshBounds mini::ComputeMeshBounds(void const* vertices, uint32_t numVertices, uint32_t vertexStride)
+{
+#if defined(MINI_SIMD_SSE4) || defined(MINI_SIMD_NEON)
+    MeshBounds bounds;
+    if (numVertices == 0) { return bounds; }
+    auto const bytes = static_cast<char const*>(vertices);
+    auto const numVector = GetNumVectorVertices(numVertices, vertexStride);
+    float first[4] = {};
+    LoadPosition(bytes, first);
+#endif
+
+#if defined(MINI_SIMD_SSE4)
+    // @note w holds whatever follows the position and is ignored. two accumulators each keep the min / max chains independent
+    auto min0 = _mm_loadu_ps(first), min1 = min0, max0 = min0, max1 = min0;
+    auto i = 0u;
+    for (; i + 1 < numVector; i += 2) {
+        auto const p0 = _mm_loadu_ps(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i) * vertexStride));
+        auto const p1 = _mm_loadu_ps(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i + 1) * vertexStride));
+        min0 = _mm_min_ps(min0, p0);
+        max0 = _mm_max_ps(max0, p0);
+        min1 = _mm_min_ps(min1, p1);
+        max1 = _mm_max_ps(max1, p1);
+    }
+    float aabbMin[4], aabbMax[4];
+    _mm_storeu_ps(aabbMin, _mm_min_ps(min0, min1));
+    _mm_storeu_ps(aabbMax, _mm_max_ps(max0, max1));
+#elif defined(MINI_SIMD_NEON)
+    auto min0 = vld1q_f32(first), max0 = min0;
+    auto i = 0u;
+    for (; i < numVector; ++i) {
+        auto const p = vld1q_f32(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i) * vertexStride));
+        min0 = vminq_f32(min0, p);
+        max0 = vmaxq_f32(max0, p);
+    }
+    float aabbMin[4], aabbMax[4];
+    vst1q_f32(aabbMin, min0);
+    vst1q_f32(aabbMax, max0);
+#endif
+
+#if defined(MINI_SIMD_SSE4) || defined(MINI_SIMD_NEON)
+    for (; i < numVertices; ++i) {
+        float p[3];
+        LoadPosition(bytes + static_cast<size_t>(i) * vertexStride, p);
+        for (auto k = 0; k < 3; ++k) {
+            aabbMin[k] = p[k] < aabbMin[k] ? p[k] : aabbMin[k];
+            aabbMax[k] = p[k] > aabbMax[k] ? p[k] : aabbMax[k];
+        }
+    }
+    memcpy(bounds.aabbMin, aabbMin, sizeof(bounds.aabbMin));
+    memcpy(bounds.aabbMax, aabbMax, sizeof(bounds.aabbMax));
+    SetCenter(&bounds);
+    float center[4] = { bounds.sphereCenter[0], bounds.sphereCenter[1], bounds.sphereCenter[2], 0.0f };
+#endif
+
+#if defined(MINI_SIMD_SSE4)
+    // @note    four vertices per iteration, transposed so x, y and z each fill a register and the distances need no horizontal
+    //          sums. (x² + y²) + z², summed in the same order as the scalar path
+    auto const cx = _mm_set1_ps(center[0]), cy = _mm_set1_ps(center[1]), cz = _mm_set1_ps(center[2]);
+    auto maxDistance = _mm_setzero_ps();
+    for (i = 0; i + 4 <= numVector; i += 4) {
+        auto r0 = _mm_loadu_ps(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i) * vertexStride));
+        auto r1 = _mm_loadu_ps(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i + 1) * vertexStride));
+        auto r2 = _mm_loadu_ps(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i + 2) * vertexStride));
+        auto r3 = _mm_loadu_ps(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i + 3) * vertexStride));
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        auto const dx = _mm_sub_ps(r0, cx), dy = _mm_sub_ps(r1, cy), dz = _mm_sub_ps(r2, cz);
+        maxDistance = _mm_max_ps(maxDistance, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+    }
+    maxDistance = _mm_max_ps(maxDistance, _mm_movehl_ps(maxDistance, maxDistance));
+    maxDistance = _mm_max_ss(maxDistance, _mm_shuffle_ps(maxDistance, maxDistance, _MM_SHUFFLE(1, 1, 1, 1)));
+    auto maxDistanceSquared = _mm_cvtss_f32(maxDistance);
+#elif defined(MINI_SIMD_NEON)
+    auto const cx = vdupq_n_f32(center[0]), cy = vdupq_n_f32(center[1]), cz = vdupq_n_f32(center[2]);
+    auto maxDistance = vdupq_n_f32(0.0f);
+    for (i = 0; i + 4 <= numVector; i += 4) {
+        auto const r0 = vld1q_f32(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i) * vertexStride));
+        auto const r1 = vld1q_f32(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i + 1) * vertexStride));
+        auto const r2 = vld1q_f32(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i + 2) * vertexStride));
+        auto const r3 = vld1q_f32(reinterpret_cast<float const*>(bytes + static_cast<size_t>(i + 3) * vertexStride));
+        auto const t01 = vtrnq_f32(r0, r1), t23 = vtrnq_f32(r2, r3);    // x0 x1 z0 z1, y0 y1 w0 w1, ...
+        auto const x = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+        auto const y = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+        auto const z = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+        auto const dx = vsubq_f32(x, cx), dy = vsubq_f32(y, cy), dz = vsubq_f32(z, cz);
+        maxDistance = vmaxq_f32(maxDistance, vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(dz, dz)));
+    }
+    auto maxDistanceSquared = vmaxvq_f32(maxDistance);
+#endif
+
+#if defined(MINI_SIMD_SSE4) || defined(MINI_SIMD_NEON)
+    for (; i < numVertices; ++i) {
+        float p[3];
+        LoadPosition(bytes + static_cast<size_t>(i) * vertexStride, p);
+        auto const d = DistanceSquared(p, bounds.sphereCenter);
+        maxDistanceSquared = d > maxDistanceSquared ? d : maxDistanceSquared;
+    }
+    FinishSphere(&bounds, maxDistanceSquared);
+    return bounds;
+#else
+    return ComputeMeshBoundsScalar(vertices, numVertices, vertexStride);
+#endif
+}
+
+char const* mini::GetMeshBoundsKernelName()
+{
+#if defined(MINI_SIMD_SSE4)
+    return "sse4";
+#elif defined(MINI_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+mini::MeshBounds mini::MakeMeshBounds(float const aabbMin[3], float const aabbMax[3])
+{
+    MeshBounds bounds;
+    memcpy(bounds.aabbMin, aabbMin, sizeof(bounds.aabbMin));
+    memcpy(bounds.aabbMax, aabbMax, sizeof(bounds.aabbMax));
+    SetCenter(&bounds);
+    FinishSphere(&bounds, DistanceSquared(bounds.aabbMax, bounds.sphereCenter));
+    return bounds;
+}
+
+bool mini::IsValidAabb(float const aabbMin[3], float const aabbMax[3])
+{
+    bool allZero = true;
+    for (auto k = 0; k < 3; ++k) {
+        // @note written this way round so NaNs fail
+        if (!(aabbMin[k] <= aabbMax[k]) || !isfinite(aabbMin[k]) || !isfinite(aabbMax[k])) { return false; }
+        allZero &= aabbMin[k] == 0.0f && aabbMax[k] == 0.0f;
+    }
+    return !allZero;  // @note an all zero box is what exporters write when they don't know the bounds
+}
+
+bool mini::IsMeshVisible(MeshBounds const& bounds, CullingView const& view)
+{
+    for (auto p = 0; p < 6; ++p) {
+        auto const plane = view.frustumPlanes[p];
+        auto const distance = plane[0] * bounds.sphereCenter[0] + plane[1] * bounds.sphereCenter[1] + plane[2] * bounds.sphereCenter[2] + plane[3];
+        if (distance < -bounds.sphereRadius) { return false; }
+
+        // the box corner furthest along the plane normal, if even that is outside so is the box
+        float const corner[3] = {
+            plane[0] >= 0.0f ? bounds.aabbMax[0] : bounds.aabbMin[0],
+            plane[1] >= 0.0f ? bounds.aabbMax[1] : bounds.aabbMin[1],
+            plane[2] >= 0.0f ? bounds.aabbMax[2] : bounds.aabbMin[2] };
+        if (plane[0] * corner[0] + plane[1] * corner[1] + plane[2] * corner[2] + plane[3] < 0.0f) { return false; }
+    }
+    return true;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+#include <Runtime/Culling/MeshletCulling.h>
+
+namespace mini
+{
+    /*
+        *   Mesh level bounding volumes, computed when a mesh is loaded without them and tested before any of its meshlets.
+        *   Vertices are read as float3 position at the start of every vertex, they don't need to be aligned.
+    */
+
+    // @note    ComputeMeshBounds has an SSE4 and a NEON kernel and is the scalar path elsewhere, ComputeMeshBoundsScalar is the reference
+    //          it's checked against. both pass over the vertices twice, once for the box and once for the radius around its center,
+    //          the kernels take the radius four vertices at a time
+    MeshBounds  ComputeMeshBounds(void const* vertices, uint32_t numVertices, uint32_t vertexStride);
+    MeshBounds  ComputeMeshBoundsScalar(void const* vertices, uint32_t numVertices, uint32_t vertexStride);
+    // the kernel ComputeMeshBounds was compiled with, for benchmark output
+    char const* GetMeshBoundsKernelName();
+
+    // box as given, the sphere is the one around the box. used when only an AABB is known, e.g. for quantized vertices
+    MeshBounds  MakeMeshBounds(float const aabbMin[3], float const aabbMax[3]);
+    bool        IsValidAabb(float const aabbMin[3], float const aabbMax[3]);
+
+    // view in the mesh's object space, see TransformCullingView. tests the sphere, then the box against the frustum planes
+    bool        IsMeshVisible(MeshBounds const& bounds, CullingView const& view);
+}
@@ -0,0 +1,138 @@
+#include "MeshletCulling.h"
+#include <Runtime/common.h>
+
+#include <math.h>
+
+namespace
+{
+    void Normalize(float* v)
+    {
+        auto const length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        auto const invLength = length > 0.0f ? 1.0f / length : 0.0f;
+        for (auto k = 0; k < 3; ++k) { v[k] *= invLength; }
+    }
+
+    void Cross(float const* a, float const* b, float* out)
+    {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    float Dot(float const* a, float const* b)
+    {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    // rotates v by the inverse of the unit quaternion q (xyzw)
+    void InverseRotate(float const* q, float const* v, float* out)
+    {
+        float const u[3] = { -q[0], -q[1], -q[2] };
+        float t[3];
+        Cross(u, v, t);
+        for (auto k = 0; k < 3; ++k) { t[k] *= 2.0f; }
+        float c[3];
+        Cross(u, t, c);
+        for (auto k = 0; k < 3; ++k) { out[k] = v[k] + q[3] * t[k] + c[k]; }
+    }
+
+    void SetPlane(float* plane, float const* normal, float const* point)
+    {
+        float n[3] = { normal[0], normal[1], normal[2] };
+        Normalize(n);
+        for (auto k = 0; k < 3; ++k) { plane[k] = n[k]; }
+        plane[3] = -Dot(n, point);
+    }
+}
+
+mini::CullingView mini::MakeCullingView(float const position[3], float const forward[3], float const up[3], float fovY, float aspectRatio, float zNear, float zFar)
+{
+    CullingView view;
+    for (auto k = 0; k < 3; ++k) { view.position[k] = position[k]; }
+
+    float f[3] = { forward[0], forward[1], forward[2] };
+    Normalize(f);
+    float r[3];
+    Cross(up, f, r);    // @note left handed, right = up x forward
+    Normalize(r);
+    float u[3];
+    Cross(f, r, u);
+
+    auto const tanY = tanf(fovY * 0.5f);
+    auto const tanX = tanY * aspectRatio;
+    float const nearPoint[3] = { position[0] + f[0] * zNear, position[1] + f[1] * zNear, position[2] + f[2] * zNear };
+    float const farPoint[3] = { position[0] + f[0] * zFar, position[1] + f[1] * zFar, position[2] + f[2] * zFar };
+    float const back[3] = { -f[0], -f[1], -f[2] };
+    SetPlane(view.frustumPlanes[0], f, nearPoint);
+    SetPlane(view.frustumPlanes[1], back, farPoint);
+
+    // @note side planes go through the camera, their normals are the forward axis tilted against the side's direction
+    for (auto side = 0; side < 4; ++side) {
+        auto const axis = side < 2 ? r : u;
+        auto const slope = side < 2 ? tanX : tanY;
+        auto const sign = (side & 1) ? -1.0f : 1.0f;
+        float const normal[3] = { f[0] * slope + axis[0] * sign, f[1] * slope + axis[1] * sign, f[2] * slope + axis[2] * sign };
+        SetPlane(view.frustumPlanes[2 + side], normal, position);
+    }
+    return view;
+}
+
+mini::CullingView mini::TransformCullingView(CullingView const& view, float const position[3], float const rotation[4], float scale)
+{
+    MINI_ASSERT(scale > 0.0f, "Instances need a positive scale");
+    // world = position + scale * R * object
+    CullingView result;
+    float const relative[3] = { view.position[0] - position[0], view.position[1] - position[1], view.position[2] - position[2] };
+    InverseRotate(rotation, relative, result.position);
+    for (auto k = 0; k < 3; ++k) { result.position[k] /= scale; }
+
+    // @note the rotated normal stays unit length, dividing the distance by scale keeps the plane normalized in object space
+    for (auto p = 0; p < 6; ++p) {
+        auto const plane = view.frustumPlanes[p];
+        InverseRotate(rotation, plane, result.frustumPlanes[p]);
+        result.frustumPlanes[p][3] = (Dot(plane, position) + plane[3]) / scale;
+    }
+    return result;
+}
+
+uint32_t mini::CullMeshlets(Meshlet const* meshlets, uint32_t numMeshlets, CullingView const& view, uint32_t* outVisible, MeshletCullingStats* stats)
+{
+    uint32_t numVisible = 0;
+    uint32_t numFrustumCulled = 0;
+    uint32_t numBackfaceCulled = 0;
+    uint64_t numTriangles = 0;
+    uint64_t numVisibleTriangles = 0;
+    for (auto i = 0u; i < numMeshlets; ++i) {
+        auto const& meshlet = meshlets[i];
+        numTriangles += meshlet.numIndices / 3;
+
+        bool outside = false;
+        for (auto p = 0; p < 6 && !outside; ++p) {
+            outside = Dot(view.frustumPlanes[p], meshlet.center) + view.frustumPlanes[p][3] < -meshlet.radius;
+        }
+        if (outside) {
+            numFrustumCulled++;
+            continue;
+        }
+
+        // @note    the cluster is back facing if the direction towards it is within 90 degrees minus the cone's half angle of the
+        //          cone axis, for every point of the bounding sphere
+        float const toCenter[3] = { meshlet.center[0] - view.position[0], meshlet.center[1] - view.position[1], meshlet.center[2] - view.position[2] };
+        if (Dot(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * sqrtf(Dot(toCenter, toCenter)) + meshlet.radius) {
+            numBackfaceCulled++;
+            continue;
+        }
+
+        outVisible[numVisible++] = i;
+        numVisibleTriangles += meshlet.numIndices / 3;
+    }
+
+    if (stats != nullptr) {
+        stats->numMeshlets += numMeshlets;
+        stats->numFrustumCulled += numFrustumCulled;
+        stats->numBackfaceCulled += numBackfaceCulled;
+        stats->numTriangles += numTriangles;
+        stats->numVisibleTriangles += numVisibleTriangles;
+    }
+    return numVisible;
+}
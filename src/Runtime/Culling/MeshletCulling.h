@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+
+namespace mini
+{
+    /*
+        *   CPU reference culling of meshlets against a view. A meshlet is rejected if its bounding sphere is outside one of the
+        *   frustum planes or if its normal cone faces away from the camera entirely. Front faces are those whose
+        *   cross(b - a, c - a) normal points towards the camera, which is what clockwise front faces give in the left handed view space.
+    */
+    struct CullingView
+    {
+        float   position[3] = { 0.0f, 0.0f, 0.0f };
+        float   frustumPlanes[6][4] = {};       // @note normalized, pointing inwards: dot(plane.xyz, p) + plane.w >= 0 is inside
+    };
+
+    struct MeshletCullingStats
+    {
+        uint32_t    numMeshlets = 0;
+        uint32_t    numFrustumCulled = 0;
+        uint32_t    numBackfaceCulled = 0;
+        uint32_t    numMeshesCulled = 0;    // @note whole meshes rejected by their bounds, see MeshBounds.h. their meshlets aren't counted
+        uint64_t    numTriangles = 0;
+        uint64_t    numVisibleTriangles = 0;
+
+        float GetCulledTrianglePercentage() const { return numTriangles > 0 ? 100.0f * (numTriangles - numVisibleTriangles) / numTriangles : 0.0f; }
+    };
+
+    // perspective view looking along forward, fovY in radians
+    CullingView     MakeCullingView(float const position[3], float const forward[3], float const up[3], float fovY, float aspectRatio, float zNear, float zFar);
+    // moves a world space view into the object space of an instance at position, with rotation as a quaternion (xyzw) and uniform scale
+    CullingView     TransformCullingView(CullingView const& view, float const position[3], float const rotation[4], float scale);
+
+    // writes the indices of the visible meshlets to outVisible and returns their number, stats accumulate if given
+    uint32_t        CullMeshlets(Meshlet const* meshlets, uint32_t numMeshlets, CullingView const& view, uint32_t* outVisible, MeshletCullingStats* stats = nullptr);
+}
@@ -0,0 +1,514 @@
+#include "math_batch.h"
+#include "math_functions.h"
+#include "math_lanes.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace
+{
+    using mini::math::lanes::ScalarLanes;
+    using mini::math::lanes::VectorLanes;
+
+    // ((m0 x + m4 y) + m8 z) + m12, like kernels::scalar::transform_pos
+    template <class L, bool Position>
+    void Transform(float const* m, mini::math::vec3f_soa_const_t in, mini::math::vec3f_soa_t out, uint32_t i)
+    {
+        auto const x = L::Load(in.x + i), y = L::Load(in.y + i), z = L::Load(in.z + i);
+        typename L::type result[3];
+        for (auto row = 0; row < 3; ++row) {
+            auto sum = L::Add(L::Add(L::Mul(L::Set(m[row]), x), L::Mul(L::Set(m[4 + row]), y)), L::Mul(L::Set(m[8 + row]), z));
+            result[row] = Position ? L::Add(sum, L::Set(m[12 + row])) : sum;
+        }
+        L::Store(out.x + i, result[0]);
+        L::Store(out.y + i, result[1]);
+        L::Store(out.z + i, result[2]);
+    }
+
+    template <class L, bool Position>
+    void TransformStream(mini::math::mat4x4f_t const& transform, mini::math::vec3f_soa_const_t in, mini::math::vec3f_soa_t out, uint32_t count)
+    {
+        auto i = 0u;
+        for (; i + L::count <= count; i += L::count) { Transform<L, Position>(transform.elements, in, out, i); }
+        for (; i < count; ++i) { Transform<ScalarLanes, Position>(transform.elements, in, out, i); }
+    }
+
+    // column of every lane's matrix: 4 floats per column and 16 per matrix, or 3 and 12 for mat3x4f_t
+    template <class L, bool Affine>
+    void StoreMatrixColumn(float* out, int column, typename L::type a, typename L::type b, typename L::type c, typename L::type d)
+    {
+        if (Affine) {
+            L::StoreColumn3(out + column * 3, a, b, c);
+        }
+        else {
+            L::StoreColumn(out + column * 4, a, b, c, d);
+        }
+    }
+
+    // the rotation's columns scaled by s, written as columns 0 to 2. the expressions are kernels::scalar::quat_to_mat's
+    template <class L, bool Affine>
+    void StoreRotation(mini::math::quatf_soa_const_t q, typename L::type const* s, uint32_t i, float* out)
+    {
+        auto const w = L::Load(q.w + i), x = L::Load(q.x + i), y = L::Load(q.y + i), z = L::Load(q.z + i);
+        auto const two = L::Set(2.0f), one = L::Set(1.0f), zero = L::Set(0.0f);
+        auto const x2 = L::Mul(two, x), y2 = L::Mul(two, y), z2 = L::Mul(two, z);
+        auto const xx = L::Mul(x2, x), yy = L::Mul(y2, y), zz = L::Mul(z2, z);
+        auto const xy = L::Mul(x2, y), xz = L::Mul(x2, z), yz = L::Mul(y2, z);
+        auto const zw = L::Mul(z2, w), yw = L::Mul(y2, w), xw = L::Mul(x2, w);
+        StoreMatrixColumn<L, Affine>(out, 0, L::Mul(L::Sub(L::Sub(one, yy), zz), s[0]), L::Mul(L::Add(xy, zw), s[0]), L::Mul(L::Sub(xz, yw), s[0]), zero);
+        StoreMatrixColumn<L, Affine>(out, 1, L::Mul(L::Sub(xy, zw), s[1]), L::Mul(L::Sub(L::Sub(one, xx), zz), s[1]), L::Mul(L::Add(yz, xw), s[1]), zero);
+        StoreMatrixColumn<L, Affine>(out, 2, L::Mul(L::Add(xz, yw), s[2]), L::Mul(L::Sub(yz, xw), s[2]), L::Mul(L::Sub(L::Sub(one, xx), yy), s[2]), zero);
+    }
+
+    template <class L>
+    void QuatToMat(mini::math::quatf_soa_const_t q, uint32_t i, float* out)
+    {
+        // @note multiplying by 1 is exact, so the rotation is shared with ComposeTrs
+        typename L::type const one[3] = { L::Set(1.0f), L::Set(1.0f), L::Set(1.0f) };
+        StoreRotation<L, false>(q, one, i, out);
+        L::StoreColumn(out + 12, L::Set(0.0f), L::Set(0.0f), L::Set(0.0f), L::Set(1.0f));
+    }
+
+    template <class L, bool Affine>
+    void ComposeTrs(mini::math::vec3f_soa_const_t t, mini::math::quatf_soa_const_t q, mini::math::vec3f_soa_const_t s, uint32_t i, float* out)
+    {
+        typename L::type const scale[3] = { L::Load(s.x + i), L::Load(s.y + i), L::Load(s.z + i) };
+        StoreRotation<L, Affine>(q, scale, i, out);
+        StoreMatrixColumn<L, Affine>(out, 3, L::Load(t.x + i), L::Load(t.y + i), L::Load(t.z + i), L::Set(1.0f));
+    }
+}
+
+namespace
+{
+    // plane components broadcast once per call
+    template <class L>
+    struct FrustumLanes
+    {
+        typename L::type nx[mini::math::frustum_t::NUM_PLANES], ny[mini::math::frustum_t::NUM_PLANES], nz[mini::math::frustum_t::NUM_PLANES];
+        typename L::type d[mini::math::frustum_t::NUM_PLANES];
+        typename L::type ax[mini::math::frustum_t::NUM_PLANES], ay[mini::math::frustum_t::NUM_PLANES], az[mini::math::frustum_t::NUM_PLANES];   // |normal|
+
+        explicit FrustumLanes(mini::math::frustum_t const& frustum)
+        {
+            for (auto p = 0; p < mini::math::frustum_t::NUM_PLANES; ++p) {
+                auto const& plane = frustum.planes[p];
+                nx[p] = L::Set(plane.normal.x);
+                ny[p] = L::Set(plane.normal.y);
+                nz[p] = L::Set(plane.normal.z);
+                d[p] = L::Set(plane.d);
+                ax[p] = L::Set(fabsf(plane.normal.x));
+                ay[p] = L::Set(fabsf(plane.normal.y));
+                az[p] = L::Set(fabsf(plane.normal.z));
+            }
+        }
+    };
+
+    // bit per lane, set if the bounds are outside a plane: signed distance of the center below -radius, where a box's radius is
+    // its extent projected on the plane normal. all six planes are tested, an early out doesn't pay off with several lanes
+    template <class L, bool Box>
+    uint32_t OutsideMask(FrustumLanes<L> const& frustum, mini::math::vec3f_soa_const_t centers, float const* radii, mini::math::vec3f_soa_const_t extents, uint32_t i)
+    {
+        auto const x = L::Load(centers.x + i), y = L::Load(centers.y + i), z = L::Load(centers.z + i);
+        auto ex = L::Set(0.0f), ey = ex, ez = ex, radius = ex;
+        if (Box) {
+            ex = L::Load(extents.x + i);
+            ey = L::Load(extents.y + i);
+            ez = L::Load(extents.z + i);
+        }
+        else {
+            radius = L::Sub(L::Set(0.0f), L::Load(radii + i));
+        }
+        auto outside = L::None();
+        for (auto p = 0; p < mini::math::frustum_t::NUM_PLANES; ++p) {
+            auto const distance = L::Add(L::Add(L::Add(L::Mul(frustum.nx[p], x), L::Mul(frustum.ny[p], y)), L::Mul(frustum.nz[p], z)), frustum.d[p]);
+            if (Box) {
+                radius = L::Sub(L::Set(0.0f), L::Add(L::Add(L::Mul(frustum.ax[p], ex), L::Mul(frustum.ay[p], ey)), L::Mul(frustum.az[p], ez)));
+            }
+            outside = L::Or(outside, L::Less(distance, radius));
+        }
+        return L::MoveMask(outside);
+    }
+
+    // @note    every lane's index is written, the count only advances for visible ones. no branches, and the write position never
+    //          passes the number of elements processed so outVisible only needs room for count
+    template <class L, bool Box>
+    uint32_t CullStream(mini::math::frustum_t const& frustum, mini::math::vec3f_soa_const_t centers, float const* radii,
+        mini::math::vec3f_soa_const_t extents, uint32_t count, uint32_t* outVisible)
+    {
+        FrustumLanes<L> const lanes(frustum);
+        FrustumLanes<ScalarLanes> const scalar(frustum);
+        uint32_t numVisible = 0;
+        auto i = 0u;
+        for (; i + L::count <= count; i += L::count) {
+            auto const outside = OutsideMask<L, Box>(lanes, centers, radii, extents, i);
+            for (auto lane = 0u; lane < L::count; ++lane) {
+                outVisible[numVisible] = i + lane;
+                numVisible += ((outside >> lane) & 1) ^ 1;
+            }
+        }
+        for (; i < count; ++i) {
+            outVisible[numVisible] = i;
+            numVisible += OutsideMask<ScalarLanes, Box>(scalar, centers, radii, extents, i) ^ 1;
+        }
+        return numVisible;
+    }
+
+    // -- fast_ functions, the expressions of their scalar versions in math_functions.h
+
+    template <class L>
+    void SinCos(typename L::type v, typename L::type* outSin, typename L::type* outCos)
+    {
+        auto const shifted = L::Add(L::Mul(v, L::Set(0.636619772367581343f)), L::Set(12582912.0f));
+        auto const k = L::Sub(shifted, L::Set(12582912.0f));
+        auto const r = L::Sub(L::Sub(L::Sub(v, L::Mul(k, L::Set(1.5703125f))), L::Mul(k, L::Set(4.837512969970703125e-4f))), L::Mul(k, L::Set(7.54978995489188216e-8f)));
+        auto const z = L::Mul(r, r);
+        auto const s = L::Add(L::Mul(L::Mul(L::Sub(L::Mul(L::Add(L::Mul(L::Set(-1.9515295891e-4f), z), L::Set(8.3321608736e-3f)), z), L::Set(1.6666654611e-1f)), z), r), r);
+        auto const cPoly = L::Add(L::Mul(L::Sub(L::Mul(L::Set(2.443315711809948e-5f), z), L::Set(1.388731625493765e-3f)), z), L::Set(4.166664568298827e-2f));
+        auto const c = L::Add(L::Sub(L::Mul(L::Mul(cPoly, z), z), L::Mul(L::Set(0.5f), z)), L::Set(1.0f));
+
+        auto const q = L::AsInt(shifted);
+        auto const odd = L::TestBit(q, 1);
+        auto const sinQ = L::Select(odd, c, s);
+        auto const cosQ = L::Select(odd, s, c);
+        *outSin = L::Select(L::TestBit(q, 2), L::Neg(sinQ), sinQ);
+        *outCos = L::Select(L::TestBit(L::IAdd(q, L::ISet(1)), 2), L::Neg(cosQ), cosQ);
+    }
+
+    template <class L>
+    typename L::type Atan2(typename L::type y, typename L::type x)
+    {
+        auto const absX = L::Abs(x), absY = L::Abs(y);
+        auto const a = L::Div(L::Min(absX, absY), L::Max(L::Max(absX, absY), L::Set(1.17549435e-38f)));
+        auto const reduce = L::Greater(a, L::Set(0.414213562373095f));
+        auto const t = L::Select(reduce, L::Div(L::Sub(a, L::Set(1.0f)), L::Add(a, L::Set(1.0f))), a);
+        auto const base = L::Select(reduce, L::Set(0.785398163397448f), L::Set(0.0f));
+        auto const z = L::Mul(t, t);
+        auto poly = L::Sub(L::Mul(L::Set(8.05374449538e-2f), z), L::Set(1.38776856032e-1f));
+        poly = L::Sub(L::Mul(L::Add(L::Mul(poly, z), L::Set(1.99777106478e-1f)), z), L::Set(3.33329491539e-1f));
+        auto r = L::Add(L::Add(L::Mul(L::Mul(poly, z), t), t), base);
+        r = L::Select(L::Greater(absY, absX), L::Sub(L::Set(1.57079632679490f), r), r);
+        r = L::Select(L::Less(x, L::Set(0.0f)), L::Sub(L::Set(3.14159265358979f), r), r);
+        return L::Select(L::Less(y, L::Set(0.0f)), L::Neg(r), r);
+    }
+
+    // e^v = 2^n e^r with n = round(v / ln 2) and |r| <= ln 2 / 2, ln 2 split in two. Cephes' expf polynomial for e^r, 2^n built
+    // in the exponent bits from shifted's, which hold n + 1.5 2^23. the clamp keeps n in [-126, 127]
+    template <class L>
+    typename L::type Exp(typename L::type v)
+    {
+        v = L::Max(v, L::Set(-87.3f));
+        v = L::Min(v, L::Set(88.3f));
+        auto const shifted = L::Add(L::Mul(v, L::Set(1.44269504088896341f)), L::Set(12582912.0f));
+        auto const n = L::Sub(shifted, L::Set(12582912.0f));
+        auto const r = L::Sub(L::Sub(v, L::Mul(n, L::Set(0.693359375f))), L::Mul(n, L::Set(-2.12194440e-4f)));
+        auto p = L::Add(L::Mul(L::Add(L::Mul(L::Set(1.9875691500e-4f), r), L::Set(1.3981999507e-3f)), r), L::Set(8.3334519073e-3f));
+        p = L::Add(L::Mul(L::Add(L::Mul(L::Add(L::Mul(p, r), L::Set(4.1665795894e-2f)), r), L::Set(1.6666665459e-1f)), r), L::Set(5.0000001201e-1f));
+        p = L::Add(L::Add(L::Mul(L::Mul(p, r), r), r), L::Set(1.0f));
+        auto const scale = L::AsFloat(L::template ShiftLeft<23>(L::IAdd(L::AsInt(shifted), L::ISet(127 - 0x4b400000))));
+        return L::Mul(p, scale);
+    }
+
+    template <class L>
+    typename L::type Log(typename L::type v)
+    {
+        auto const bits = L::AsInt(v);
+        auto e = L::ToFloat(L::IAdd(L::template ShiftRight<23>(bits), L::ISet(-127)));
+        auto m = L::AsFloat(L::IOr(L::IAnd(bits, L::ISet(0x007fffff)), L::ISet(0x3f800000)));
+        auto const above = L::Greater(m, L::Set(1.41421356237309f));
+        m = L::Select(above, L::Mul(m, L::Set(0.5f)), m);
+        e = L::Select(above, L::Add(e, L::Set(1.0f)), e);
+        auto const f = L::Sub(m, L::Set(1.0f));
+        auto const z = L::Mul(f, f);
+        auto poly = L::Sub(L::Mul(L::Set(7.0376836292e-2f), f), L::Set(1.1514610310e-1f));
+        poly = L::Sub(L::Mul(L::Add(L::Mul(poly, f), L::Set(1.1676998740e-1f)), f), L::Set(1.2420140846e-1f));
+        poly = L::Sub(L::Mul(L::Add(L::Mul(poly, f), L::Set(1.4249322787e-1f)), f), L::Set(1.6668057665e-1f));
+        poly = L::Sub(L::Mul(L::Add(L::Mul(poly, f), L::Set(2.0000714765e-1f)), f), L::Set(2.4999993993e-1f));
+        poly = L::Add(L::Mul(poly, f), L::Set(3.3333331174e-1f));
+        auto y = L::Mul(L::Mul(poly, f), z);
+        y = L::Sub(L::Add(y, L::Mul(e, L::Set(-2.12194440e-4f))), L::Mul(L::Set(0.5f), z));
+        return L::Add(L::Add(f, y), L::Mul(e, L::Set(0.693359375f)));
+    }
+
+    // out[i] = Kernel(in[i]) over the vector lanes, the tail through the scalar ones
+    // @note without vector lanes everything goes through the scalar kernel, which may be the faster exact tier (see fast_exp)
+    template <VectorLanes::type (*VectorKernel)(VectorLanes::type), float (*ScalarKernel)(float)>
+    void UnaryStream(float const* in, float* out, uint32_t count)
+    {
+        auto i = 0u;
+        for (; VectorLanes::count > 1 && i + VectorLanes::count <= count; i += VectorLanes::count) { VectorLanes::Store(out + i, VectorKernel(VectorLanes::Load(in + i))); }
+        for (; i < count; ++i) { out[i] = ScalarKernel(in[i]); }
+    }
+
+    template <class L>
+    void SinCosStream(float const* v, float* outSin, float* outCos, uint32_t count)
+    {
+        auto i = 0u;
+        for (; i + L::count <= count; i += L::count) {
+            typename L::type s, c;
+            SinCos<L>(L::Load(v + i), &s, &c);
+            if (outSin) { L::Store(outSin + i, s); }
+            if (outCos) { L::Store(outCos + i, c); }
+        }
+        for (; i < count; ++i) {
+            float s, c;
+            SinCos<ScalarLanes>(v[i], &s, &c);
+            if (outSin) { outSin[i] = s; }
+            if (outCos) { outCos[i] = c; }
+        }
+    }
+
+    // -- quaternions, the expressions of nlerp, slerp and make_dualquat in math_functions.h
+
+    template <class L>
+    struct QuatLanes
+    {
+        typename L::type w, x, y, z;
+
+        static QuatLanes Load(mini::math::quatf_soa_const_t q, uint32_t i) { return { L::Load(q.w + i), L::Load(q.x + i), L::Load(q.y + i), L::Load(q.z + i) }; }
+        void Store(mini::math::quatf_soa_t q, uint32_t i) const { L::Store(q.w + i, w); L::Store(q.x + i, x); L::Store(q.y + i, y); L::Store(q.z + i, z); }
+    };
+
+    template <class L>
+    typename L::type Dot(QuatLanes<L> const& a, QuatLanes<L> const& b)
+    {
+        return L::Add(L::Add(L::Add(L::Mul(a.w, b.w), L::Mul(a.x, b.x)), L::Mul(a.y, b.y)), L::Mul(a.z, b.z));
+    }
+
+    // a * wa + b * wb
+    template <class L>
+    QuatLanes<L> Weighted(QuatLanes<L> const& a, typename L::type wa, QuatLanes<L> const& b, typename L::type wb)
+    {
+        return { L::Add(L::Mul(a.w, wa), L::Mul(b.w, wb)), L::Add(L::Mul(a.x, wa), L::Mul(b.x, wb)),
+            L::Add(L::Mul(a.y, wa), L::Mul(b.y, wb)), L::Add(L::Mul(a.z, wa), L::Mul(b.z, wb)) };
+    }
+
+    template <class L>
+    QuatLanes<L> FastNormalize(QuatLanes<L> const& q)
+    {
+        auto const s = L::Rsqrt(Dot(q, q));
+        return { L::Mul(q.w, s), L::Mul(q.x, s), L::Mul(q.y, s), L::Mul(q.z, s) };
+    }
+
+    template <class L>
+    QuatLanes<L> Nlerp(QuatLanes<L> const& a, QuatLanes<L> const& b, typename L::type t)
+    {
+        auto const wb = L::Select(L::Less(Dot(a, b), L::Set(0.0f)), L::Neg(t), t);
+        return FastNormalize(Weighted(a, L::Sub(L::Set(1.0f), t), b, wb));
+    }
+
+    template <class L>
+    QuatLanes<L> Slerp(QuatLanes<L> const& a, QuatLanes<L> const& b, typename L::type t)
+    {
+        auto const sign = L::Select(L::Less(Dot(a, b), L::Set(0.0f)), L::Set(-1.0f), L::Set(1.0f));
+        QuatLanes<L> const c = { L::Mul(b.w, sign), L::Mul(b.x, sign), L::Mul(b.y, sign), L::Mul(b.z, sign) };
+        QuatLanes<L> const d = { L::Sub(a.w, c.w), L::Sub(a.x, c.x), L::Sub(a.y, c.y), L::Sub(a.z, c.z) };
+        QuatLanes<L> const s = { L::Add(a.w, c.w), L::Add(a.x, c.x), L::Add(a.y, c.y), L::Add(a.z, c.z) };
+        auto const angle = L::Mul(L::Set(2.0f), Atan2<L>(L::Sqrt(Dot(d, d)), L::Sqrt(Dot(s, s))));
+
+        typename L::type sinAngle, sinA, sinB, unused;
+        SinCos<L>(angle, &sinAngle, &unused);
+        auto const oneMinusT = L::Sub(L::Set(1.0f), t);
+        SinCos<L>(L::Mul(oneMinusT, angle), &sinA, &unused);
+        SinCos<L>(L::Mul(t, angle), &sinB, &unused);
+        auto const small = L::Less(sinAngle, L::Set(0.000001f));
+        auto const wa = L::Select(small, oneMinusT, L::Div(sinA, sinAngle));
+        auto const wb = L::Select(small, t, L::Div(sinB, sinAngle));
+        return Weighted(a, wa, c, wb);
+    }
+
+    // t is per element when not nullptr
+    template <bool Spherical>
+    void InterpolateStream(mini::math::quatf_soa_const_t a, mini::math::quatf_soa_const_t b, float const* t, float uniformT, mini::math::quatf_soa_t out, uint32_t count)
+    {
+        auto i = 0u;
+        for (; i + VectorLanes::count <= count; i += VectorLanes::count) {
+            auto const qa = QuatLanes<VectorLanes>::Load(a, i), qb = QuatLanes<VectorLanes>::Load(b, i);
+            auto const ti = t != nullptr ? VectorLanes::Load(t + i) : VectorLanes::Set(uniformT);
+            (Spherical ? Slerp<VectorLanes>(qa, qb, ti) : Nlerp<VectorLanes>(qa, qb, ti)).Store(out, i);
+        }
+        for (; i < count; ++i) {
+            auto const qa = QuatLanes<ScalarLanes>::Load(a, i), qb = QuatLanes<ScalarLanes>::Load(b, i);
+            auto const ti = t != nullptr ? t[i] : uniformT;
+            (Spherical ? Slerp<ScalarLanes>(qa, qb, ti) : Nlerp<ScalarLanes>(qa, qb, ti)).Store(out, i);
+        }
+    }
+
+    // real and dual parts written as the two halves of each 8 float dualquatf_t
+    template <class L>
+    void MakeDualQuat(mini::math::quatf_soa_const_t rotations, mini::math::vec3f_soa_const_t translations, uint32_t i, float* out)
+    {
+        auto const r = QuatLanes<L>::Load(rotations, i);
+        auto const tx = L::Load(translations.x + i), ty = L::Load(translations.y + i), tz = L::Load(translations.z + i);
+        auto const half = L::Set(0.5f), minusHalf = L::Set(-0.5f);
+        auto const dw = L::Mul(minusHalf, L::Add(L::Add(L::Mul(tx, r.x), L::Mul(ty, r.y)), L::Mul(tz, r.z)));
+        auto const dx = L::Mul(half, L::Sub(L::Add(L::Mul(tx, r.w), L::Mul(ty, r.z)), L::Mul(tz, r.y)));
+        auto const dy = L::Mul(half, L::Sub(L::Add(L::Mul(ty, r.w), L::Mul(tz, r.x)), L::Mul(tx, r.z)));
+        auto const dz = L::Mul(half, L::Sub(L::Add(L::Mul(tz, r.w), L::Mul(tx, r.y)), L::Mul(ty, r.x)));
+        L::template StoreColumn<8>(out, r.w, r.x, r.y, r.z);
+        L::template StoreColumn<8>(out + 4, dw, dx, dy, dz);
+    }
+}
+
+void mini::math::transform_pos_batch(mat4x4f_t const& transform, vec3f_soa_const_t positions, vec3f_soa_t outPositions, uint32_t count)
+{
+    TransformStream<VectorLanes, true>(transform, positions, outPositions, count);
+}
+
+void mini::math::transform_dir_batch(mat4x4f_t const& transform, vec3f_soa_const_t directions, vec3f_soa_t outDirections, uint32_t count)
+{
+    TransformStream<VectorLanes, false>(transform, directions, outDirections, count);
+}
+
+void mini::math::quat_to_mat_batch(quatf_soa_const_t rotations, mat4x4f_t* outMatrices, uint32_t count)
+{
+    auto i = 0u;
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) { QuatToMat<VectorLanes>(rotations, i, outMatrices[i].elements); }
+    for (; i < count; ++i) { QuatToMat<ScalarLanes>(rotations, i, outMatrices[i].elements); }
+}
+
+void mini::math::compose_trs_batch(vec3f_soa_const_t translations, quatf_soa_const_t rotations, vec3f_soa_const_t scales, mat4x4f_t* outMatrices, uint32_t count)
+{
+    auto i = 0u;
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) { ComposeTrs<VectorLanes, false>(translations, rotations, scales, i, outMatrices[i].elements); }
+    for (; i < count; ++i) { ComposeTrs<ScalarLanes, false>(translations, rotations, scales, i, outMatrices[i].elements); }
+}
+
+void mini::math::compose_trs_batch(vec3f_soa_const_t translations, quatf_soa_const_t rotations, vec3f_soa_const_t scales, mat3x4f_t* outMatrices, uint32_t count)
+{
+    auto i = 0u;
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) { ComposeTrs<VectorLanes, true>(translations, rotations, scales, i, outMatrices[i].elements); }
+    for (; i < count; ++i) { ComposeTrs<ScalarLanes, true>(translations, rotations, scales, i, outMatrices[i].elements); }
+}
+
+void mini::math::mat_mul_batch(mat4x4f_t const& lhs, mat4x4f_t const* matrices, mat4x4f_t* outMatrices, uint32_t count)
+{
+    // @note matrices are whole registers already, so this is kernels::selected::mat_mul with lhs' columns hoisted out of the loop
+#if defined(MINI_SIMD_AVX2)
+    __m256 c[4];
+    for (auto k = 0; k < 4; ++k) { c[k] = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(lhs.elements + k * 4)); }
+    for (auto i = 0u; i < count; ++i) {
+        auto const rhs = matrices[i].elements;
+        __m256 result[2];
+        for (auto half = 0; half < 2; ++half) {
+            auto const r = _mm256_loadu_ps(rhs + half * 8);
+            auto sum = _mm256_add_ps(_mm256_mul_ps(c[0], _mm256_shuffle_ps(r, r, 0x00)), _mm256_mul_ps(c[1], _mm256_shuffle_ps(r, r, 0x55)));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(c[2], _mm256_shuffle_ps(r, r, 0xaa)));
+            result[half] = _mm256_add_ps(sum, _mm256_mul_ps(c[3], _mm256_shuffle_ps(r, r, 0xff)));
+        }
+        _mm256_storeu_ps(outMatrices[i].elements, result[0]);
+        _mm256_storeu_ps(outMatrices[i].elements + 8, result[1]);
+    }
+#elif defined(MINI_SIMD_SSE4)
+    __m128 c[4];
+    for (auto k = 0; k < 4; ++k) { c[k] = _mm_loadu_ps(lhs.elements + k * 4); }
+    for (auto i = 0u; i < count; ++i) {
+        auto const rhs = matrices[i].elements;
+        __m128 result[4];
+        for (auto column = 0; column < 4; ++column) {
+            auto const r = _mm_loadu_ps(rhs + column * 4);
+            auto sum = _mm_add_ps(_mm_mul_ps(c[0], _mm_shuffle_ps(r, r, 0x00)), _mm_mul_ps(c[1], _mm_shuffle_ps(r, r, 0x55)));
+            sum = _mm_add_ps(sum, _mm_mul_ps(c[2], _mm_shuffle_ps(r, r, 0xaa)));
+            result[column] = _mm_add_ps(sum, _mm_mul_ps(c[3], _mm_shuffle_ps(r, r, 0xff)));
+        }
+        for (auto column = 0; column < 4; ++column) { _mm_storeu_ps(outMatrices[i].elements + column * 4, result[column]); }
+    }
+#elif defined(MINI_SIMD_NEON)
+    float32x4_t c[4];
+    for (auto k = 0; k < 4; ++k) { c[k] = vld1q_f32(lhs.elements + k * 4); }
+    for (auto i = 0u; i < count; ++i) {
+        auto const rhs = matrices[i].elements;
+        float32x4_t result[4];
+        for (auto column = 0; column < 4; ++column) {
+            auto const r = vld1q_f32(rhs + column * 4);
+            auto sum = vaddq_f32(vmulq_n_f32(c[0], vgetq_lane_f32(r, 0)), vmulq_n_f32(c[1], vgetq_lane_f32(r, 1)));
+            sum = vaddq_f32(sum, vmulq_n_f32(c[2], vgetq_lane_f32(r, 2)));
+            result[column] = vaddq_f32(sum, vmulq_n_f32(c[3], vgetq_lane_f32(r, 3)));
+        }
+        for (auto column = 0; column < 4; ++column) { vst1q_f32(outMatrices[i].elements + column * 4, result[column]); }
+    }
+#else
+    auto const copy = lhs;  // @note lhs may be one of the outputs
+    for (auto i = 0u; i < count; ++i) { kernels::scalar::mat_mul(copy.elements, matrices[i].elements, outMatrices[i].elements); }
+#endif
+}
+
+uint32_t mini::math::cull_spheres_batch(frustum_t const& frustum, vec3f_soa_const_t centers, float const* radii, uint32_t count, uint32_t* outVisible)
+{
+    return CullStream<VectorLanes, false>(frustum, centers, radii, centers, count, outVisible);
+}
+
+uint32_t mini::math::cull_aabbs_batch(frustum_t const& frustum, vec3f_soa_const_t centers, vec3f_soa_const_t extents, uint32_t count, uint32_t* outVisible)
+{
+    return CullStream<VectorLanes, true>(frustum, centers, nullptr, extents, count, outVisible);
+}
+
+void mini::math::fast_sin_batch(float const* v, float* out, uint32_t count)
+{
+    SinCosStream<VectorLanes>(v, out, nullptr, count);
+}
+
+void mini::math::fast_cos_batch(float const* v, float* out, uint32_t count)
+{
+    SinCosStream<VectorLanes>(v, nullptr, out, count);
+}
+
+void mini::math::fast_sincos_batch(float const* v, float* outSin, float* outCos, uint32_t count)
+{
+    SinCosStream<VectorLanes>(v, outSin, outCos, count);
+}
+
+void mini::math::fast_rsqrt_batch(float const* v, float* out, uint32_t count)
+{
+    UnaryStream<VectorLanes::Rsqrt, ScalarLanes::Rsqrt>(v, out, count);
+}
+
+void mini::math::fast_atan2_batch(float const* y, float const* x, float* out, uint32_t count)
+{
+    auto i = 0u;
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) { VectorLanes::Store(out + i, Atan2<VectorLanes>(VectorLanes::Load(y + i), VectorLanes::Load(x + i))); }
+    for (; i < count; ++i) { out[i] = Atan2<ScalarLanes>(y[i], x[i]); }
+}
+
+void mini::math::fast_exp_batch(float const* v, float* out, uint32_t count)
+{
+    UnaryStream<Exp<VectorLanes>, fast_exp>(v, out, count);
+}
+
+void mini::math::fast_log_batch(float const* v, float* out, uint32_t count)
+{
+    UnaryStream<Log<VectorLanes>, fast_log>(v, out, count);
+}
+
+void mini::math::nlerp_batch(quatf_soa_const_t a, quatf_soa_const_t b, float t, quatf_soa_t out, uint32_t count)
+{
+    InterpolateStream<false>(a, b, nullptr, t, out, count);
+}
+
+void mini::math::nlerp_batch(quatf_soa_const_t a, quatf_soa_const_t b, float const* t, quatf_soa_t out, uint32_t count)
+{
+    InterpolateStream<false>(a, b, t, 0.0f, out, count);
+}
+
+void mini::math::slerp_batch(quatf_soa_const_t a, quatf_soa_const_t b, float t, quatf_soa_t out, uint32_t count)
+{
+    InterpolateStream<true>(a, b, nullptr, t, out, count);
+}
+
+void mini::math::slerp_batch(quatf_soa_const_t a, quatf_soa_const_t b, float const* t, quatf_soa_t out, uint32_t count)
+{
+    InterpolateStream<true>(a, b, t, 0.0f, out, count);
+}
+
+void mini::math::fast_normalize_batch(quatf_soa_const_t quats, quatf_soa_t out, uint32_t count)
+{
+    auto i = 0u;
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) { FastNormalize(QuatLanes<VectorLanes>::Load(quats, i)).Store(out, i); }
+    for (; i < count; ++i) { FastNormalize(QuatLanes<ScalarLanes>::Load(quats, i)).Store(out, i); }
+}
+
+void mini::math::make_dualquat_batch(quatf_soa_const_t rotations, vec3f_soa_const_t translations, dualquatf_t* outDualQuats, uint32_t count)
+{
+    auto i = 0u;
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) { MakeDualQuat<VectorLanes>(rotations, translations, i, outDualQuats[i].real.elements); }
+    for (; i < count; ++i) { MakeDualQuat<ScalarLanes>(rotations, translations, i, outDualQuats[i].real.elements); }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include "math_types.h"
+
+#include <stdint.h>
+
+/*
+    *   Stream versions of the per value operations in math_functions.h, for per object work over whole scenes.
+    *   Positions, directions, rotations and scales come as structure of arrays, one float array per component, so every
+    *   SIMD lane handles one element and nothing needs to be shuffled. Matrices stay mat4x4f_t or mat3x4f_t arrays since that's what
+    *   gets uploaded to the GPU. The widest instruction set compiled in processes 8 (AVX2) or 4 (SSE4, NEON) elements at a
+    *   time and the remainder goes through the same expressions in scalar code, so count doesn't need to be a multiple of anything.
+    *
+    *   Every lane evaluates the single value kernels' expressions in the same order: results match transform_pos, transform_dir,
+    *   quat_to_mat and mat4x4f_t multiplication, bit exact unless the compiler contracts either side into FMAs.
+    *   Outputs may be the inputs (in place), any other overlap is undefined.
+*/
+namespace mini
+{
+    namespace math
+    {
+        struct vec3f_soa_t
+        {
+            float* x;
+            float* y;
+            float* z;
+        };
+
+        struct vec3f_soa_const_t
+        {
+            float const* x;
+            float const* y;
+            float const* z;
+
+            vec3f_soa_const_t(float const* a, float const* b, float const* c) : x(a), y(b), z(c) {}
+            vec3f_soa_const_t(vec3f_soa_t const& v) : x(v.x), y(v.y), z(v.z) {}
+        };
+
+        struct quatf_soa_t
+        {
+            float* w;
+            float* x;
+            float* y;
+            float* z;
+        };
+
+        // unit quaternions, one array per component like quatf_t's wxyz
+        struct quatf_soa_const_t
+        {
+            float const* w;
+            float const* x;
+            float const* y;
+            float const* z;
+
+            quatf_soa_const_t(float const* d, float const* a, float const* b, float const* c) : w(d), x(a), y(b), z(c) {}
+            quatf_soa_const_t(quatf_soa_t const& q) : w(q.w), x(q.x), y(q.y), z(q.z) {}
+        };
+
+        // out = transform * (p, 1) and transform * (d, 0) for count elements
+        void transform_pos_batch(mat4x4f_t const& transform, vec3f_soa_const_t positions, vec3f_soa_t outPositions, uint32_t count);
+        void transform_dir_batch(mat4x4f_t const& transform, vec3f_soa_const_t directions, vec3f_soa_t outDirections, uint32_t count);
+
+        // outMatrices[i] = quat_to_mat(rotations[i])
+        void quat_to_mat_batch(quatf_soa_const_t rotations, mat4x4f_t* outMatrices, uint32_t count);
+
+        // outMatrices[i] = make_translation(t) * quat_to_mat(r) * make_scale(s), without the two matrix multiplies. see make_affine
+        void compose_trs_batch(vec3f_soa_const_t translations, quatf_soa_const_t rotations, vec3f_soa_const_t scales, mat4x4f_t* outMatrices, uint32_t count);
+        void compose_trs_batch(vec3f_soa_const_t translations, quatf_soa_const_t rotations, vec3f_soa_const_t scales, mat3x4f_t* outMatrices, uint32_t count);
+
+        // outMatrices[i] = lhs * matrices[i], e.g. a view projection times every object's model matrix. lhs is loaded once
+        void mat_mul_batch(mat4x4f_t const& lhs, mat4x4f_t const* matrices, mat4x4f_t* outMatrices, uint32_t count);
+
+        // @note    frustum culling, the indices of the bounds that aren't entirely outside one of the planes are written to outVisible
+        //          in increasing order and their number is returned. outVisible needs room for count indices. boxes are given as
+        //          center and half extent and tested conservatively: near the frustum's edges a box outside may still be kept
+        uint32_t cull_spheres_batch(frustum_t const& frustum, vec3f_soa_const_t centers, float const* radii, uint32_t count, uint32_t* outVisible);
+        uint32_t cull_aabbs_batch(frustum_t const& frustum, vec3f_soa_const_t centers, vec3f_soa_const_t extents, uint32_t count, uint32_t* outVisible);
+
+        // out[i] = nlerp(a[i], b[i], t) or slerp, t either the same for all or one per element, e.g. every bone of a skeleton
+        // between two keys. fast_normalize_batch is quatf_t's fast_normalize
+        void nlerp_batch(quatf_soa_const_t a, quatf_soa_const_t b, float t, quatf_soa_t out, uint32_t count);
+        void nlerp_batch(quatf_soa_const_t a, quatf_soa_const_t b, float const* t, quatf_soa_t out, uint32_t count);
+        void slerp_batch(quatf_soa_const_t a, quatf_soa_const_t b, float t, quatf_soa_t out, uint32_t count);
+        void slerp_batch(quatf_soa_const_t a, quatf_soa_const_t b, float const* t, quatf_soa_t out, uint32_t count);
+        void fast_normalize_batch(quatf_soa_const_t quats, quatf_soa_t out, uint32_t count);
+
+        // outDualQuats[i] = make_dualquat(rotations[i], translations[i]), e.g. a skinning palette from the posed bones
+        void make_dualquat_batch(quatf_soa_const_t rotations, vec3f_soa_const_t translations, dualquatf_t* outDualQuats, uint32_t count);
+
+        // out[i] = fast_sin(v[i]) etc., see math_functions.h for the domains and error bounds. fast_sincos_batch takes either
+        // output as nullptr. outputs may be the inputs. fast_rsqrt uses the instruction set's estimate, so the bulk and the
+        // scalar tail only agree within the bound
+        void fast_sin_batch(float const* v, float* out, uint32_t count);
+        void fast_cos_batch(float const* v, float* out, uint32_t count);
+        void fast_sincos_batch(float const* v, float* outSin, float* outCos, uint32_t count);
+        void fast_rsqrt_batch(float const* v, float* out, uint32_t count);
+        void fast_atan2_batch(float const* y, float const* x, float* out, uint32_t count);
+        void fast_exp_batch(float const* v, float* out, uint32_t count);
+        void fast_log_batch(float const* v, float* out, uint32_t count);
+    }
+}
@@ -1,8 +1,10 @@
 #pragma once
 #include "math_types.h"
+#include "math_kernels.h"
 
 #include <math.h>
 #include <memory.h>
+#include <stdint.h>
 
 namespace mini
 {
@@ -11,80 +13,90 @@ namespace mini
         // -----------------------------------------------------------
         // -----------------------------------------------------------
 
-        inline vec2f_t operator + (vec2f_t const& lhs, vec2f_t const& rhs);
-        inline vec2f_t operator - (vec2f_t const& lhs, vec2f_t const& rhs);
-        inline vec2f_t operator / (vec2f_t const& lhs, vec2f_t const& rhs);
-        inline vec2f_t operator * (vec2f_t const& lhs, vec2f_t const& rhs);
+        inline constexpr vec2f_t operator + (vec2f_t const& lhs, vec2f_t const& rhs);
+        inline constexpr vec2f_t operator - (vec2f_t const& lhs, vec2f_t const& rhs);
+        inline constexpr vec2f_t operator / (vec2f_t const& lhs, vec2f_t const& rhs);
+        inline constexpr vec2f_t operator * (vec2f_t const& lhs, vec2f_t const& rhs);
 
-        inline vec3f_t operator + (vec3f_t const& lhs, vec3f_t const& rhs);
-        inline vec3f_t operator - (vec3f_t const& lhs, vec3f_t const& rhs);
-        inline vec3f_t operator / (vec3f_t const& lhs, vec3f_t const& rhs);
-        inline vec3f_t operator * (vec3f_t const& lhs, vec3f_t const& rhs);
+        inline constexpr vec3f_t operator + (vec3f_t const& lhs, vec3f_t const& rhs);
+        inline constexpr vec3f_t operator - (vec3f_t const& lhs, vec3f_t const& rhs);
+        inline constexpr vec3f_t operator / (vec3f_t const& lhs, vec3f_t const& rhs);
+        inline constexpr vec3f_t operator * (vec3f_t const& lhs, vec3f_t const& rhs);
 
-        inline vec4f_t operator + (vec4f_t const& lhs, vec4f_t const& rhs);
-        inline vec4f_t operator - (vec4f_t const& lhs, vec4f_t const& rhs);
-        inline vec4f_t operator / (vec4f_t const& lhs, vec4f_t const& rhs);
-        inline vec4f_t operator * (vec4f_t const& lhs, vec4f_t const& rhs);
+        inline constexpr vec4f_t operator + (vec4f_t const& lhs, vec4f_t const& rhs);
+        inline constexpr vec4f_t operator - (vec4f_t const& lhs, vec4f_t const& rhs);
+        inline constexpr vec4f_t operator / (vec4f_t const& lhs, vec4f_t const& rhs);
+        inline constexpr vec4f_t operator * (vec4f_t const& lhs, vec4f_t const& rhs);
 
-        inline vec2f_t operator + (vec2f_t const& lhs, float rhs);
-        inline vec2f_t operator - (vec2f_t const& lhs, float rhs);
-        inline vec2f_t operator * (vec2f_t const& lhs, float rhs);
-        inline vec2f_t operator / (vec2f_t const& lhs, float rhs);
+        inline constexpr vec2f_t operator + (vec2f_t const& lhs, float rhs);
+        inline constexpr vec2f_t operator - (vec2f_t const& lhs, float rhs);
+        inline constexpr vec2f_t operator * (vec2f_t const& lhs, float rhs);
+        inline constexpr vec2f_t operator / (vec2f_t const& lhs, float rhs);
 
-        inline vec3f_t operator + (vec3f_t const& lhs, float rhs);
-        inline vec3f_t operator - (vec3f_t const& lhs, float rhs);
-        inline vec3f_t operator * (vec3f_t const& lhs, float rhs);
-        inline vec3f_t operator / (vec3f_t const& lhs, float rhs);
+        inline constexpr vec3f_t operator + (vec3f_t const& lhs, float rhs);
+        inline constexpr vec3f_t operator - (vec3f_t const& lhs, float rhs);
+        inline constexpr vec3f_t operator * (vec3f_t const& lhs, float rhs);
+        inline constexpr vec3f_t operator / (vec3f_t const& lhs, float rhs);
 
-        inline vec4f_t operator + (vec4f_t const& lhs, float rhs);
-        inline vec4f_t operator - (vec4f_t const& lhs, float rhs);
-        inline vec4f_t operator * (vec4f_t const& lhs, float rhs);
-        inline vec4f_t operator / (vec4f_t const& lhs, float rhs);
+        inline constexpr vec4f_t operator + (vec4f_t const& lhs, float rhs);
+        inline constexpr vec4f_t operator - (vec4f_t const& lhs, float rhs);
+        inline constexpr vec4f_t operator * (vec4f_t const& lhs, float rhs);
+        inline constexpr vec4f_t operator / (vec4f_t const& lhs, float rhs);
 
-        inline vec2f_t operator - (vec2f_t const& vec);
-        inline vec3f_t operator - (vec3f_t const& vec);
-        inline vec4f_t operator - (vec4f_t const& vec);
+        inline constexpr vec2f_t operator - (vec2f_t const& vec);
+        inline constexpr vec3f_t operator - (vec3f_t const& vec);
+        inline constexpr vec4f_t operator - (vec4f_t const& vec);
 
         // -----------------------------------------------------------
 
         inline vec4f_t operator * (mat4x4f_t const& lhs, vec4f_t const& rhs);
         inline vec4f_t operator * (quatf_t const& lhs, vec4f_t const& rhs);
 
-        inline quatf_t operator * (quatf_t const& lhs, quatf_t const& rhs);
+        inline constexpr quatf_t operator * (quatf_t const& lhs, quatf_t const& rhs);
         inline mat4x4f_t operator * (mat4x4f_t const& lhs, mat4x4f_t const& rhs);
 
         inline vec3f_t transform_pos(mat4x4f_t const& transform, vec3f_t const& position);
         inline vec3f_t transform_dir(mat4x4f_t const& transform, vec3f_t const& direction);
 
+        // affine versions skip the implicit last row: 36 multiplies for a product instead of 64
+        inline mat3x4f_t operator * (mat3x4f_t const& lhs, mat3x4f_t const& rhs);
+        inline vec3f_t transform_pos(mat3x4f_t const& transform, vec3f_t const& position);
+        inline vec3f_t transform_dir(mat3x4f_t const& transform, vec3f_t const& direction);
+
+        inline mat3x4f_t to_affine(mat4x4f_t const& mat);   // @note drops the last row, which has to be (0, 0, 0, 1)
+        inline mat4x4f_t to_mat4x4(mat3x4f_t const& mat);
+
         inline mat4x4f_t    quat_to_mat(quatf_t const& quat);
         inline quatf_t      quat_from_mat(mat4x4f_t const& mat);
 
-        inline mat4x4f_t make_translation(vec3f_t const& translation);
-        inline mat4x4f_t make_scale(vec3f_t const& scale);
+        inline constexpr mat4x4f_t make_translation(vec3f_t const& translation);
+        inline constexpr mat4x4f_t make_scale(vec3f_t const& scale);
         inline mat4x4f_t make_rotation(vec3f_t const& axis, float rad);
         inline mat4x4f_t make_perspective_proj(float fovInRad, float aspectRatio, float zNear, float zFar);
         inline mat4x4f_t make_ortho_proj(float left, float right, float bottom, float top, float zNear, float zFar);
         inline mat4x4f_t make_lookat(vec3f_t const& from, vec3f_t const& to, vec3f_t const& up);
+        inline frustum_t make_frustum(mat4x4f_t const& viewProj);
+        inline mat3x4f_t make_affine(vec3f_t const& translation, quatf_t const& rotation, vec3f_t const& scale);     // T * R * S
         // -----------------------------------------------------------
         // -----------------------------------------------------------
 
-        inline float dot(vec2f_t const& lhs, vec2f_t const& rhs);
-        inline float dot(vec3f_t const& lhs, vec3f_t const& rhs);
-        inline float dot(vec4f_t const& lhs, vec4f_t const& rhs);
+        inline constexpr float dot(vec2f_t const& lhs, vec2f_t const& rhs);
+        inline constexpr float dot(vec3f_t const& lhs, vec3f_t const& rhs);
+        inline constexpr float dot(vec4f_t const& lhs, vec4f_t const& rhs);
 
         inline float length(vec2f_t const& vec);
         inline float length(vec3f_t const& vec);
         inline float length(vec4f_t const& vec);
 
-        inline float squared_length(vec2f_t const& vec);
-        inline float squared_length(vec3f_t const& vec);
-        inline float squared_length(vec4f_t const& vec);
+        inline constexpr float squared_length(vec2f_t const& vec);
+        inline constexpr float squared_length(vec3f_t const& vec);
+        inline constexpr float squared_length(vec4f_t const& vec);
 
         inline float distance(vec2f_t const& a, vec2f_t const& b);
         inline float distance(vec3f_t const& a, vec3f_t const& b);
         inline float distance(vec4f_t const& a, vec4f_t const& b);
 
-        inline vec3f_t cross(vec3f_t const& lhs, vec3f_t const& rhs);
+        inline constexpr vec3f_t cross(vec3f_t const& lhs, vec3f_t const& rhs);
 
         inline vec2f_t normalize(vec2f_t const& vec);
         inline vec3f_t normalize(vec3f_t const& vec);
@@ -100,25 +112,57 @@ namespace mini
         inline quatf_t angle_axis(vec3f_t const& axis, float rad);
 
         inline quatf_t inverse(quatf_t const& quat);
+
+        // @note    both take the shorter way around: b is negated when dot(a, b) < 0, q and -q being the same rotation. nlerp is
+        //          lerp then fast_normalize, cheap and fine for blending but not at a constant speed. slerp is, with the angle from
+        //          fast_atan2 and the weights from fast_sin so slerp_batch can evaluate the same expressions. a and b are unit length
+        inline quatf_t nlerp(quatf_t const& a, quatf_t const& b, float t);
+        inline quatf_t slerp(quatf_t const& a, quatf_t const& b, float t);
+        inline quatf_t fast_normalize(quatf_t const& quat);   // quat * fast_rsqrt(squared length), quat can't be zero
+
+        // -----------------------------------------------------------
+        // -----------------------------------------------------------
+
+        // @note    the dual quaternion functions take unit ones (rigid transforms) unless noted. products apply rhs first, like the
+        //          matrices, and transform_pos/transform_dir rotate then translate
+        inline dualquatf_t make_dualquat(quatf_t const& rotation, vec3f_t const& translation);
+        inline dualquatf_t dualquat_from_mat(mat3x4f_t const& mat);     // @note rotation and translation only, see inverse_rigid
+        inline mat3x4f_t   dualquat_to_mat(dualquatf_t const& dq);
+        inline vec3f_t     dualquat_translation(dualquatf_t const& dq);
+
+        inline dualquatf_t operator * (dualquatf_t const& lhs, dualquatf_t const& rhs);
+        inline vec3f_t transform_pos(dualquatf_t const& dq, vec3f_t const& position);
+        inline vec3f_t transform_dir(dualquatf_t const& dq, vec3f_t const& direction);
+
+        inline dualquatf_t normalize(dualquatf_t const& dq);   // any non zero real part, the dual part is made orthogonal to it
+        inline dualquatf_t inverse(dualquatf_t const& dq);
+        // @note    linear blend of count > 0 dual quaternions, each flipped to the same side as the first one's real part, then
+        //          normalized. weights don't need to add up to 1
+        inline dualquatf_t dualquat_blend(dualquatf_t const* dqs, float const* weights, uint32_t count);
         
         // -----------------------------------------------------------
         // -----------------------------------------------------------
 
         inline mat4x4f_t inverse(mat4x4f_t const& mat);
+        inline mat3x4f_t inverse(mat3x4f_t const& mat);
+        // @note    rotation and translation only, e.g. a camera's transform: the rotation is transposed and the translation rotated
+        //          back and negated. anything scaled or sheared needs inverse()
+        inline mat4x4f_t inverse_rigid(mat4x4f_t const& mat);
+        inline mat3x4f_t inverse_rigid(mat3x4f_t const& mat);
 
         inline mat4x4f_t transpose(mat4x4f_t const& mat);
 
-        inline vec4f_t column(mat4x4f_t const& mat, int index);
+        inline constexpr vec4f_t column(mat4x4f_t const& mat, int index);
         inline vec4f_t row(mat4x4f_t const& mat, int index);
         
         // -----------------------------------------------------------
         // -----------------------------------------------------------
 
-        inline float RadToDeg(float rad);
-        inline float DegToRad(float deg);
+        inline constexpr float RadToDeg(float rad);
+        inline constexpr float DegToRad(float deg);
 
-        inline double DegToRad(double deg);
-        inline double RadToDeg(double rad);
+        inline constexpr double DegToRad(double deg);
+        inline constexpr double RadToDeg(double rad);
 
         inline float sqrt(float v);
         inline double sqrt(double v);
@@ -135,6 +179,35 @@ namespace mini
         inline double acos(double v);
         inline double asin(double v);
 
+        inline float rsqrt(float v);
+        inline float atan2(float y, float x);
+        inline float exp(float v);
+        inline float log(float v);
+
+        inline double atan2(double y, double x);
+        inline double exp(double v);
+        inline double log(double v);
+
+        // @note    fast tier: polynomial approximations with bounded error for the tight loops (animation, lighting, culling),
+        //          checked against double precision over their whole domain by the mathapprox benchmark. math_batch.h has
+        //          them over arrays. max errors:
+        //              fast_sin, fast_cos, fast_sincos     1.5e-7 absolute for |v| <= 8192, slowly more above
+        //              fast_rsqrt                          2^-21 relative, v > 0 and normal
+        //              fast_atan2                          4e-7 absolute (radians), finite inputs. fast_atan2(0, 0) is 0
+        //              fast_exp                            2 ULP. v is clamped to [-87.3, 88.3] so the result stays finite and normal
+        //              fast_log                            2 ULP, v > 0 and normal
+        //          without FMA one element at a time fast_exp and fast_log are the exact tier: a table driven C runtime is as fast.
+        //          the batches keep the polynomials
+        inline float fast_sin(float v);
+        inline float fast_cos(float v);
+        inline void  fast_sincos(float v, float* outSin, float* outCos);
+        inline float fast_rsqrt(float v);
+        inline float fast_atan2(float y, float x);
+        inline float fast_exp(float v);
+        inline float fast_log(float v);
+
+        inline vec3f_t fast_normalize(vec3f_t const& vec);    // vec * fast_rsqrt(squared length), vec can't be zero
+
         // -----------------------------------------------------------
         // -----------------------------------------------------------
 
@@ -145,43 +218,43 @@ namespace mini
         // -----------------------------------------------------------
         
         template <typename T>
-        T lerp(T const& a, T const& b, float alpha)
+        constexpr T lerp(T const& a, T const& b, float alpha)
         {
             return a * (1.0f - alpha) + b * alpha;
         }
 
         template <typename T>
-        T min(T a, T b)
+        constexpr T min(T a, T b)
         {
             return a < b ? a : b;
         }
 
         template <typename T>
-        T max(T a, T b)
+        constexpr T max(T a, T b)
         {
             return a > b ? a : b;
         }
 
         template <typename T>
-        T clamp(T value, T min_value, T max_value)
+        constexpr T clamp(T value, T min_value, T max_value)
         {
             return min(max_value, max(value, min_value));
         }
 
         template <typename T>
-        T saturate(T value)
+        constexpr T saturate(T value)
         {
             return clamp(value, static_cast<T>(0), static_cast<T>(1));
         }
 
         template <typename T>
-        T abs(T value)
+        constexpr T abs(T value)
         {
             return value > static_cast<T>(0) ? value : -value;
         }
 
         template <typename T>
-        T sign(T value)
+        constexpr T sign(T value)
         {
             return value >= 0.0f ? static_cast<T>(1) : static_cast<T>(-1);
         }
@@ -191,44 +264,44 @@ namespace mini
 // -----------------------------------------------------------
 // -----------------------------------------------------------
 
-mini::math::vec2f_t mini::math::operator + (mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
+constexpr mini::math::vec2f_t mini::math::operator + (mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
 {
     return vec2f_t(lhs.x + rhs.x, lhs.y + rhs.y);
 }
 
-mini::math::vec2f_t mini::math::operator - (mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
+constexpr mini::math::vec2f_t mini::math::operator - (mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
 {
     return vec2f_t(lhs.x - rhs.x, lhs.y - rhs.y);
 }
 
-mini::math::vec2f_t mini::math::operator * (mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
+constexpr mini::math::vec2f_t mini::math::operator * (mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
 {
     return vec2f_t(lhs.x * rhs.x, lhs.y * rhs.y);
 }
 
-mini::math::vec2f_t mini::math::operator / (mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
+constexpr mini::math::vec2f_t mini::math::operator / (mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
 {
     return vec2f_t(lhs.x / rhs.x, lhs.y / rhs.y);
 }
 
 // -- 
 
-mini::math::vec2f_t mini::math::operator + (mini::math::vec2f_t const& lhs, float rhs)
+constexpr mini::math::vec2f_t mini::math::operator + (mini::math::vec2f_t const& lhs, float rhs)
 {
     return vec2f_t(lhs.x + rhs, lhs.y + rhs);
 }
 
-mini::math::vec2f_t mini::math::operator - (mini::math::vec2f_t const& lhs, float rhs)
+constexpr mini::math::vec2f_t mini::math::operator - (mini::math::vec2f_t const& lhs, float rhs)
 {
     return vec2f_t(lhs.x - rhs, lhs.y - rhs);
 }
 
-mini::math::vec2f_t mini::math::operator * (mini::math::vec2f_t const& lhs, float rhs)
+constexpr mini::math::vec2f_t mini::math::operator * (mini::math::vec2f_t const& lhs, float rhs)
 {
     return vec2f_t(lhs.x * rhs, lhs.y * rhs);
 }
 
-mini::math::vec2f_t mini::math::operator / (mini::math::vec2f_t const& lhs, float rhs)
+constexpr mini::math::vec2f_t mini::math::operator / (mini::math::vec2f_t const& lhs, float rhs)
 {
     return vec2f_t(lhs.x / rhs, lhs.y / rhs);
 }
@@ -236,105 +309,105 @@ mini::math::vec2f_t mini::math::operator / (mini::math::vec2f_t const& lhs, floa
 // ---------------------
 
 
-mini::math::vec3f_t mini::math::operator + (mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
+constexpr mini::math::vec3f_t mini::math::operator + (mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
 {
     return vec3f_t(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z);
 }
 
-mini::math::vec3f_t mini::math::operator - (mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
+constexpr mini::math::vec3f_t mini::math::operator - (mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
 {
     return vec3f_t(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
 }
 
-mini::math::vec3f_t mini::math::operator * (mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
+constexpr mini::math::vec3f_t mini::math::operator * (mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
 {
     return vec3f_t(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z);
 }
 
-mini::math::vec3f_t mini::math::operator / (mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
+constexpr mini::math::vec3f_t mini::math::operator / (mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
 {
     return vec3f_t(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z);
 }
 
 // -- 
 
-mini::math::vec3f_t mini::math::operator + (mini::math::vec3f_t const& lhs, float rhs)
+constexpr mini::math::vec3f_t mini::math::operator + (mini::math::vec3f_t const& lhs, float rhs)
 {
     return vec3f_t(lhs.x + rhs, lhs.y + rhs, lhs.z + rhs);
 }
 
-mini::math::vec3f_t mini::math::operator - (mini::math::vec3f_t const& lhs, float rhs)
+constexpr mini::math::vec3f_t mini::math::operator - (mini::math::vec3f_t const& lhs, float rhs)
 {
     return vec3f_t(lhs.x - rhs, lhs.y - rhs, lhs.z - rhs);
 }
 
-mini::math::vec3f_t mini::math::operator * (mini::math::vec3f_t const& lhs, float rhs)
+constexpr mini::math::vec3f_t mini::math::operator * (mini::math::vec3f_t const& lhs, float rhs)
 {
     return vec3f_t(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs);
 }
 
-mini::math::vec3f_t mini::math::operator / (mini::math::vec3f_t const& lhs, float rhs)
+constexpr mini::math::vec3f_t mini::math::operator / (mini::math::vec3f_t const& lhs, float rhs)
 {
     return vec3f_t(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs);
 }
 
 // ---------------------
 
-mini::math::vec4f_t mini::math::operator + (mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
+constexpr mini::math::vec4f_t mini::math::operator + (mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
 {
     return vec4f_t(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w);
 }
 
-mini::math::vec4f_t mini::math::operator - (mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
+constexpr mini::math::vec4f_t mini::math::operator - (mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
 {
     return vec4f_t(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w);
 }
 
-mini::math::vec4f_t mini::math::operator * (mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
+constexpr mini::math::vec4f_t mini::math::operator * (mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
 {
     return vec4f_t(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z, lhs.w * rhs.w);
 }
 
-mini::math::vec4f_t mini::math::operator / (mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
+constexpr mini::math::vec4f_t mini::math::operator / (mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
 {
     return vec4f_t(lhs.x / rhs.x, lhs.y / rhs.y, lhs.z / rhs.z, lhs.w / rhs.w);
 }
 
 // -- 
 
-mini::math::vec4f_t mini::math::operator + (mini::math::vec4f_t const& lhs, float rhs)
+constexpr mini::math::vec4f_t mini::math::operator + (mini::math::vec4f_t const& lhs, float rhs)
 {
     return vec4f_t(lhs.x + rhs, lhs.y + rhs, lhs.z + rhs, lhs.w + rhs);
 }
 
-mini::math::vec4f_t mini::math::operator - (mini::math::vec4f_t const& lhs, float rhs)
+constexpr mini::math::vec4f_t mini::math::operator - (mini::math::vec4f_t const& lhs, float rhs)
 {
     return vec4f_t(lhs.x - rhs, lhs.y - rhs, lhs.z - rhs, lhs.w - rhs);
 }
 
-mini::math::vec4f_t mini::math::operator * (mini::math::vec4f_t const& lhs, float rhs)
+constexpr mini::math::vec4f_t mini::math::operator * (mini::math::vec4f_t const& lhs, float rhs)
 {
     return vec4f_t(lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.w * rhs);
 }
 
-mini::math::vec4f_t mini::math::operator / (mini::math::vec4f_t const& lhs, float rhs)
+constexpr mini::math::vec4f_t mini::math::operator / (mini::math::vec4f_t const& lhs, float rhs)
 {
     return vec4f_t(lhs.x / rhs, lhs.y / rhs, lhs.z / rhs, lhs.w / rhs);
 }
 
 // --
 
-mini::math::vec2f_t mini::math::operator - (mini::math::vec2f_t const& vec)
+constexpr mini::math::vec2f_t mini::math::operator - (mini::math::vec2f_t const& vec)
 {
     return vec2f_t(-vec.x, -vec.y);
 }
 
-mini::math::vec3f_t mini::math::operator - (mini::math::vec3f_t const& vec)
+constexpr mini::math::vec3f_t mini::math::operator - (mini::math::vec3f_t const& vec)
 {
     return vec3f_t(-vec.x, -vec.y, -vec.z);
 }
 
-mini::math::vec4f_t mini::math::operator - (mini::math::vec4f_t const& vec)
+constexpr mini::math::vec4f_t mini::math::operator - (mini::math::vec4f_t const& vec)
 {
     return vec4f_t(-vec.x, -vec.y, -vec.z, -vec.w);
 }
@@ -352,50 +425,28 @@ mini::math::vec4f_t mini::math::operator * (mini::math::mat4x4f_t const& lhs, mi
     );
 }
 
-mini::math::quatf_t mini::math::operator * (mini::math::quatf_t const& lhs, mini::math::quatf_t const& rhs)
+constexpr mini::math::quatf_t mini::math::operator * (mini::math::quatf_t const& lhs, mini::math::quatf_t const& rhs)
 {
     return quatf_t(
-        lhs.r * rhs.r - lhs.i * rhs.i - lhs.j * rhs.j - lhs.k * rhs.k,
-        lhs.r * rhs.i + lhs.i * rhs.r + lhs.j * rhs.k - lhs.k * rhs.j,
-        lhs.r * rhs.j + lhs.j * rhs.r + lhs.k * rhs.i - lhs.i * rhs.k,
-        lhs.r * rhs.k + lhs.k * rhs.r + lhs.i * rhs.j - lhs.j * rhs.i
+        lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z,
+        lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+        lhs.w * rhs.y + lhs.y * rhs.w + lhs.z * rhs.x - lhs.x * rhs.z,
+        lhs.w * rhs.z + lhs.z * rhs.w + lhs.x * rhs.y - lhs.y * rhs.x
     );
 }
 
 mini::math::mat4x4f_t mini::math::operator * (mini::math::mat4x4f_t const& lhs, mini::math::mat4x4f_t const& rhs)
 {
     mat4x4f_t result;
-
-    // first row
-    result[0][0] = lhs[0][0] * rhs[0][0] + lhs[1][0] * rhs[0][1] + lhs[2][0] * rhs[0][2] + lhs[3][0] * rhs[0][3];
-    result[1][0] = lhs[0][0] * rhs[1][0] + lhs[1][0] * rhs[1][1] + lhs[2][0] * rhs[1][2] + lhs[3][0] * rhs[1][3];
-    result[2][0] = lhs[0][0] * rhs[2][0] + lhs[1][0] * rhs[2][1] + lhs[2][0] * rhs[2][2] + lhs[3][0] * rhs[2][3];
-    result[3][0] = lhs[0][0] * rhs[3][0] + lhs[1][0] * rhs[3][1] + lhs[2][0] * rhs[3][2] + lhs[3][0] * rhs[3][3];
-
-    // second row
-    result[0][1] = lhs[0][1] * rhs[0][0] + lhs[1][1] * rhs[0][1] + lhs[2][1] * rhs[0][2] + lhs[3][1] * rhs[0][3];
-    result[1][1] = lhs[0][1] * rhs[1][0] + lhs[1][1] * rhs[1][1] + lhs[2][1] * rhs[1][2] + lhs[3][1] * rhs[1][3];
-    result[2][1] = lhs[0][1] * rhs[2][0] + lhs[1][1] * rhs[2][1] + lhs[2][1] * rhs[2][2] + lhs[3][1] * rhs[2][3];
-    result[3][1] = lhs[0][1] * rhs[3][0] + lhs[1][1] * rhs[3][1] + lhs[2][1] * rhs[3][2] + lhs[3][1] * rhs[3][3];
-
-    // third row
-    result[0][2] = lhs[0][2] * rhs[0][0] + lhs[1][2] * rhs[0][1] + lhs[2][2] * rhs[0][2] + lhs[3][2] * rhs[0][3];
-    result[1][2] = lhs[0][2] * rhs[1][0] + lhs[1][2] * rhs[1][1] + lhs[2][2] * rhs[1][2] + lhs[3][2] * rhs[1][3];
-    result[2][2] = lhs[0][2] * rhs[2][0] + lhs[1][2] * rhs[2][1] + lhs[2][2] * rhs[2][2] + lhs[3][2] * rhs[2][3];
-    result[3][2] = lhs[0][2] * rhs[3][0] + lhs[1][2] * rhs[3][1] + lhs[2][2] * rhs[3][2] + lhs[3][2] * rhs[3][3];
-
-    // fourth row
-    result[0][3] = lhs[0][3] * rhs[0][0] + lhs[1][3] * rhs[0][1] + lhs[2][3] * rhs[0][2] + lhs[3][3] * rhs[0][3];
-    result[1][3] = lhs[0][3] * rhs[1][0] + lhs[1][3] * rhs[1][1] + lhs[2][3] * rhs[1][2] + lhs[3][3] * rhs[1][3];
-    result[2][3] = lhs[0][3] * rhs[2][0] + lhs[1][3] * rhs[2][1] + lhs[2][3] * rhs[2][2] + lhs[3][3] * rhs[2][3];
-    result[3][3] = lhs[0][3] * rhs[3][0] + lhs[1][3] * rhs[3][1] + lhs[2][3] * rhs[3][2] + lhs[3][3] * rhs[3][3];
-
+    kernels::selected::mat_mul(lhs.elements, rhs.elements, result.elements);
     return result;
 }
 
 mini::math::vec3f_t mini::math::transform_pos(mini::math::mat4x4f_t const& transform, mini::math::vec3f_t const& position)
 {
-    return (transform * vec4f_t(position, 1.0f)).xyz;
+    vec3f_t result;
+    kernels::selected::transform_pos(transform.elements, position.elements, result.elements);
+    return result;
 }
 
 mini::math::vec3f_t mini::math::transform_dir(mini::math::mat4x4f_t const& transform, mini::math::vec3f_t const& direction)
@@ -404,6 +455,51 @@ mini::math::vec3f_t mini::math::transform_dir(mini::math::mat4x4f_t const& trans
 
 }
 
+mini::math::mat3x4f_t mini::math::operator * (mini::math::mat3x4f_t const& lhs, mini::math::mat3x4f_t const& rhs)
+{
+    mat3x4f_t result;
+    kernels::selected::affine_mul(lhs.elements, rhs.elements, result.elements);
+    return result;
+}
+
+mini::math::vec3f_t mini::math::transform_pos(mini::math::mat3x4f_t const& transform, mini::math::vec3f_t const& position)
+{
+    auto const m = transform.elements;
+    vec3f_t result;
+    for (auto row = 0; row < 3; ++row) {
+        result[row] = m[row] * position.x + m[3 + row] * position.y + m[6 + row] * position.z + m[9 + row];
+    }
+    return result;
+}
+
+mini::math::vec3f_t mini::math::transform_dir(mini::math::mat3x4f_t const& transform, mini::math::vec3f_t const& direction)
+{
+    auto const m = transform.elements;
+    vec3f_t result;
+    for (auto row = 0; row < 3; ++row) {
+        result[row] = m[row] * direction.x + m[3 + row] * direction.y + m[6 + row] * direction.z;
+    }
+    return result;
+}
+
+mini::math::mat3x4f_t mini::math::to_affine(mini::math::mat4x4f_t const& mat)
+{
+    mat3x4f_t result;
+    for (auto column = 0; column < 4; ++column) {
+        result[column] = mat[column].xyz;
+    }
+    return result;
+}
+
+mini::math::mat4x4f_t mini::math::to_mat4x4(mini::math::mat3x4f_t const& mat)
+{
+    mat4x4f_t result;
+    for (auto column = 0; column < 4; ++column) {
+        result[column] = vec4f_t(mat[column], column == 3 ? 1.0f : 0.0f);
+    }
+    return result;
+}
+
 mini::math::mat4x4f_t mini::math::transpose(mini::math::mat4x4f_t const& mat)
 {
     mini::math::mat4x4f_t res;
@@ -418,33 +514,8 @@ mini::math::mat4x4f_t mini::math::transpose(mini::math::mat4x4f_t const& mat)
 mini::math::mat4x4f_t mini::math::quat_to_mat(mini::math::quatf_t const& quat)
 {
     mat4x4f_t result;
-
-    /*result[0][0] = 1.0f - 2.0f * quat.y * quat.y - 2.0f * quat.z * quat.z;
-    result[1][0] = 2.0f * quat.x * quat.y - 2.0f * quat.z * quat.w;
-    result[2][0] = 2.0f * quat.x * quat.z - 2.0f * quat.y * quat.w;
-
-    result[0][1] = 2.0f * quat.x * quat.y + 2.0f * quat.z * quat.w;
-    result[1][1] = 1.0f - 2.0f * quat.x * quat.x - 2.0f * quat.z * quat.z;
-    result[2][1] = 2.0f * quat.y * quat.z - 2.0f * quat.x * quat.w;
-
-    result[0][2] = 2.0f * quat.x * quat.z - 2.0f * quat.y * quat.w;
-    result[1][2] = 2.0f * quat.y * quat.z + 2.0f * quat.x * quat.w;
-    result[2][2] = 1.0f - 2.0f * quat.x * quat.x - 2.0f * quat.y * quat.y;*/
-
-
-    result(0) = 1.0f - 2.0f * quat.y * quat.y - 2.0f * quat.z * quat.z;
-    result(1) = 2.0f * quat.x * quat.y - 2.0f * quat.z * quat.w;
-    result(2) = 2.0f * quat.x * quat.z + 2.0f * quat.y * quat.w;
-
-    result(4) = 2.0f * quat.x * quat.y + 2.0f * quat.z * quat.w;
-    result(5) = 1.0f - 2.0f * quat.x * quat.x - 2.0f * quat.z * quat.z;
-    result(6) = 2.0f * quat.y * quat.z - 2.0f * quat.x * quat.w;
-
-    result(8) = 2.0f * quat.x * quat.z - 2.0f * quat.y * quat.w;
-    result(9) = 2.0f * quat.y * quat.z + 2.0f * quat.x * quat.w;
-    result(10) = 1.0f - 2.0f * quat.x * quat.x - 2.0f * quat.y * quat.y;
-
-    return transpose(result);
+    kernels::selected::quat_to_mat(quat.elements, result.elements);
+    return result;
 }
 
 mini::math::quatf_t mini::math::quat_from_mat(mat4x4f_t const& mat)
@@ -489,46 +560,40 @@ mini::math::quatf_t mini::math::quat_from_mat(mat4x4f_t const& mat)
 // ---- 
 
 
-mini::math::mat4x4f_t mini::math::make_translation(vec3f_t const& translation)
+constexpr mini::math::mat4x4f_t mini::math::make_translation(vec3f_t const& translation)
 {
-    mat4x4f_t result;
-    result.columns[3] = vec4f_t(translation, 1.0f);
-    return result;
+    return mat4x4f_t(vec4f_t(1.0f, 0.0f, 0.0f, 0.0f), vec4f_t(0.0f, 1.0f, 0.0f, 0.0f), vec4f_t(0.0f, 0.0f, 1.0f, 0.0f), vec4f_t(translation, 1.0f));
 }
 
-mini::math::mat4x4f_t mini::math::make_scale(vec3f_t const& scale)
+constexpr mini::math::mat4x4f_t mini::math::make_scale(vec3f_t const& scale)
 {
-    mat4x4f_t result;
-    result[0][0] = scale.x;
-    result[1][1] = scale.y;
-    result[2][2] = scale.z;
-    return result;
+    return mat4x4f_t(vec4f_t(scale.x, 0.0f, 0.0f, 0.0f), vec4f_t(0.0f, scale.y, 0.0f, 0.0f), vec4f_t(0.0f, 0.0f, scale.z, 0.0f), vec4f_t(0.0f, 0.0f, 0.0f, 1.0f));
 }
 
 
 mini::math::mat4x4f_t mini::math::make_rotation(vec3f_t const& axis, float rad)
 {
-    mat4x4f_t rotate;
-    mat4x4f_t base;
+    auto rotate = mat4x4f_t::identity();
+    auto const base = mat4x4f_t::identity();
 
     float a = rad;
     float c = cos(a);
     float s = sin(a);
 
-    auto normalizedAxis = normalize(axis);
-    auto temp = normalizedAxis * (1.0f - c);
+    auto const n = normalize(axis);
+    auto temp = n * (1.0f - c);
 
-    rotate[0][0] = c + temp[0] * axis[0];
-    rotate[0][1] = temp[0] * axis[1] + s * axis[2];
-    rotate[0][2] = temp[0] * axis[2] - s * axis[1];
+    rotate[0][0] = c + temp[0] * n[0];
+    rotate[0][1] = temp[0] * n[1] + s * n[2];
+    rotate[0][2] = temp[0] * n[2] - s * n[1];
 
-    rotate[1][0] = temp[1] * axis[0] - s * axis[2];
-    rotate[1][1] = c + temp[1] * axis[1];
-    rotate[1][2] = temp[1] * axis[2] + s * axis[0];
+    rotate[1][0] = temp[1] * n[0] - s * n[2];
+    rotate[1][1] = c + temp[1] * n[1];
+    rotate[1][2] = temp[1] * n[2] + s * n[0];
 
-    rotate[2][0] = temp[2] * axis[0] + s * axis[1];
-    rotate[2][1] = temp[2] * axis[1] - s * axis[0];
-    rotate[2][2] = c + temp[2] * axis[2];
+    rotate[2][0] = temp[2] * n[0] + s * n[1];
+    rotate[2][1] = temp[2] * n[1] - s * n[0];
+    rotate[2][2] = c + temp[2] * n[2];
 
     auto m0 = column(base, 0);
     auto m1 = column(base, 1);
@@ -537,10 +602,10 @@ mini::math::mat4x4f_t mini::math::make_rotation(vec3f_t const& axis, float rad)
 
     mat4x4f_t result;
     for (int i = 0; i < 4; ++i) {
-        result[i][0] = m0[i] * rotate[0][0] + m1[i] * rotate[0][1] + m2[i] * rotate[0][2];
-        result[i][1] = m0[i] * rotate[1][0] + m1[i] * rotate[1][1] + m2[i] * rotate[1][2];
-        result[i][2] = m0[i] * rotate[2][0] + m1[i] * rotate[2][1] + m2[i] * rotate[2][2];
-        result[i][3] = m3[i];
+        result[0][i] = m0[i] * rotate[0][0] + m1[i] * rotate[0][1] + m2[i] * rotate[0][2];    // @note columns, same rotation as angle_axis
+        result[1][i] = m0[i] * rotate[1][0] + m1[i] * rotate[1][1] + m2[i] * rotate[1][2];
+        result[2][i] = m0[i] * rotate[2][0] + m1[i] * rotate[2][1] + m2[i] * rotate[2][2];
+        result[3][i] = m3[i];
     }
     /*result[0] = normalize(result[0]);
     result[1] = normalize(result[1]);
@@ -551,7 +616,7 @@ mini::math::mat4x4f_t mini::math::make_rotation(vec3f_t const& axis, float rad)
 
 mini::math::mat4x4f_t mini::math::make_perspective_proj(float fovInRad, float aspectRatio, float zNear, float zFar)
 {
-    mat4x4f_t result;
+    auto result = mat4x4f_t::identity();
 
     float yScale = 1.0f / tan(fovInRad * 0.5f);
     float xScale = yScale / (aspectRatio);
@@ -567,14 +632,14 @@ mini::math::mat4x4f_t mini::math::make_perspective_proj(float fovInRad, float as
 
 mini::math::mat4x4f_t mini::math::make_ortho_proj(float left, float right, float bottom, float top, float zNear, float zFar)
 {
-    mat4x4f_t result;
+    auto result = mat4x4f_t::identity();
 
     result[0][0] = 2.0f / (right - left);
     result[1][1] = 2.0f / (top - bottom);
     result[2][2] = 1.0f / (zFar - zNear);
-    result[0][3] = (left + right) / (left - right);
-    result[1][3] = (top + bottom) / (bottom - top);
-    result[2][3] = zNear / (zNear - zFar);
+    result[3][0] = (left + right) / (left - right);    // @note column 3 like make_perspective_proj's depth offset
+    result[3][1] = (top + bottom) / (bottom - top);
+    result[3][2] = zNear / (zNear - zFar);
 
     return result;
 }
@@ -593,25 +658,51 @@ mini::math::mat4x4f_t mini::math::make_lookat(mini::math::vec3f_t const& from, m
     return result;
 }
 
+mini::math::mat3x4f_t mini::math::make_affine(vec3f_t const& translation, quatf_t const& rotation, vec3f_t const& scale)
+{
+    auto const r = quat_to_mat(rotation);
+    mat3x4f_t result;
+    for (auto column = 0; column < 3; ++column) {
+        result[column] = r[column].xyz * scale[column];
+    }
+    result[3] = translation;
+    return result;
+}
+
+// @note    Gribb / Hartmann: a point is inside if -w <= x, y <= w and 0 <= z <= w in clip space (D3D depth range),
+//          every bound is a sum or difference of viewProj's rows. the planes are normalized so d is a distance
+mini::math::frustum_t mini::math::make_frustum(mini::math::mat4x4f_t const& viewProj)
+{
+    auto const r0 = row(viewProj, 0), r1 = row(viewProj, 1), r2 = row(viewProj, 2), r3 = row(viewProj, 3);
+    vec4f_t const planes[frustum_t::NUM_PLANES] = { r3 + r0, r3 - r0, r3 + r1, r3 - r1, r2, r3 - r2 };
+    frustum_t frustum;
+    for (auto i = 0; i < frustum_t::NUM_PLANES; ++i) {
+        auto const scale = 1.0f / length(planes[i].xyz);
+        frustum.planes[i].normal = planes[i].xyz * scale;
+        frustum.planes[i].d = planes[i].w * scale;
+    }
+    return frustum;
+}
+
 // -----------------------------------------------------------
 // -----------------------------------------------------------
 
-float mini::math::dot(mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
+constexpr float mini::math::dot(mini::math::vec2f_t const& lhs, mini::math::vec2f_t const& rhs)
 {
     return lhs.x* rhs.x + lhs.y * rhs.y;
 }
 
-float mini::math::dot(mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
+constexpr float mini::math::dot(mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
 {
     return lhs.x* rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
 }
 
-float mini::math::dot(mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
+constexpr float mini::math::dot(mini::math::vec4f_t const& lhs, mini::math::vec4f_t const& rhs)
 {
     return lhs.x* rhs.x + lhs.y * rhs.y + lhs.z * rhs.z + lhs.w * rhs.w;
 }
 
-mini::math::vec3f_t mini::math::cross(mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
+constexpr mini::math::vec3f_t mini::math::cross(mini::math::vec3f_t const& lhs, mini::math::vec3f_t const& rhs)
 {
     return vec3f_t(
         lhs.y * rhs.z - rhs.y * lhs.z,
@@ -628,7 +719,7 @@ mini::math::vec2f_t mini::math::normalize(mini::math::vec2f_t const& vec)
 mini::math::vec2f_t mini::math::normalize_safe(mini::math::vec2f_t const& vec, float eps)
 {
     auto sqrLen = dot(vec, vec);
-    if (sqrLen <= eps * eps) { return vec2f_t(); }
+    if (sqrLen <= eps * eps) { return vec2f_t::zero(); }
     return normalize(vec);
 }
 
@@ -640,7 +731,7 @@ mini::math::vec3f_t mini::math::normalize(mini::math::vec3f_t const& vec)
 mini::math::vec3f_t mini::math::normalize_safe(mini::math::vec3f_t const& vec, float eps)
 {
     auto sqrLen = dot(vec, vec);
-    if (sqrLen <= eps * eps) { return vec3f_t(); }
+    if (sqrLen <= eps * eps) { return vec3f_t::zero(); }
     return normalize(vec);
 }
 
@@ -652,7 +743,7 @@ mini::math::vec4f_t mini::math::normalize(mini::math::vec4f_t const& vec)
 mini::math::vec4f_t mini::math::normalize_safe(mini::math::vec4f_t const& vec, float eps)
 {
     auto sqrLen = squared_length(vec);
-    if (sqrLen <= eps * eps) { return vec4f_t(); }
+    if (sqrLen <= eps * eps) { return vec4f_t::zero(); }
     return normalize(vec);
 }
 
@@ -662,7 +753,7 @@ float mini::math::length(mini::math::vec2f_t const& vec)
     return sqrt(dot(vec, vec));
 }
 
-float mini::math::squared_length(mini::math::vec2f_t const& vec)
+constexpr float mini::math::squared_length(mini::math::vec2f_t const& vec)
 {
     return dot(vec, vec);
 }
@@ -672,7 +763,7 @@ float mini::math::length(mini::math::vec3f_t const& vec)
     return sqrt(dot(vec, vec));
 }
 
-float mini::math::squared_length(mini::math::vec3f_t const& vec)
+constexpr float mini::math::squared_length(mini::math::vec3f_t const& vec)
 {
     return dot(vec, vec);
 }
@@ -683,7 +774,7 @@ float mini::math::length(mini::math::vec4f_t const& vec)
     return sqrt(dot(vec, vec));
 }
 
-float mini::math::squared_length(mini::math::vec4f_t const& vec)
+constexpr float mini::math::squared_length(mini::math::vec4f_t const& vec)
 {
     return dot(vec, vec);
 }
@@ -721,7 +812,7 @@ mini::math::quatf_t mini::math::normalize_safe(mini::math::quatf_t const& quat,
 {
     const auto d = quat.w * quat.w + quat.x * quat.x + quat.y * quat.y + quat.z * quat.z;
     if (d < eps * eps) {
-        return quatf_t();
+        return quatf_t::identity();
     }
     const auto invLen = 1.0f / sqrt(d);
 
@@ -745,14 +836,45 @@ mini::math::quatf_t mini::math::inverse(mini::math::quatf_t const& quat)
     );
 }
 
+mini::math::quatf_t mini::math::nlerp(mini::math::quatf_t const& a, mini::math::quatf_t const& b, float t)
+{
+    auto const d = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    auto const wb = d < 0.0f ? -t : t;
+    auto const wa = 1.0f - t;
+    return fast_normalize(quatf_t(a.w * wa + b.w * wb, a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb));
+}
+
+mini::math::quatf_t mini::math::slerp(mini::math::quatf_t const& a, mini::math::quatf_t const& b, float t)
+{
+    // the angle between a and b is 2 atan(|a - b| / |a + b|), which unlike acos(dot) stays accurate when they are close.
+    // below 1e-6 rad sin(angle) is too small to divide by and lerp is as good
+    auto const d = a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+    auto const sign = d < 0.0f ? -1.0f : 1.0f;
+    quatf_t const c(b.w * sign, b.x * sign, b.y * sign, b.z * sign);
+    auto const dw = a.w - c.w, dx = a.x - c.x, dy = a.y - c.y, dz = a.z - c.z;
+    auto const sw = a.w + c.w, sx = a.x + c.x, sy = a.y + c.y, sz = a.z + c.z;
+    auto const angle = 2.0f * fast_atan2(sqrtf(dw * dw + dx * dx + dy * dy + dz * dz), sqrtf(sw * sw + sx * sx + sy * sy + sz * sz));
+    auto const s = fast_sin(angle);
+    auto const small = s < 0.000001f;
+    auto const wa = small ? 1.0f - t : fast_sin((1.0f - t) * angle) / s;
+    auto const wb = small ? t : fast_sin(t * angle) / s;
+    return quatf_t(a.w * wa + c.w * wb, a.x * wa + c.x * wb, a.y * wa + c.y * wb, a.z * wa + c.z * wb);
+}
+
+mini::math::quatf_t mini::math::fast_normalize(mini::math::quatf_t const& quat)
+{
+    auto const s = fast_rsqrt(quat.w * quat.w + quat.x * quat.x + quat.y * quat.y + quat.z * quat.z);
+    return quatf_t(quat.w * s, quat.x * s, quat.y * s, quat.z * s);
+}
+
 mini::math::quatf_t mini::math::angle_axis(mini::math::vec3f_t const& axis, float rad)
 {
-    auto normalized_axis = normalize(axis); // @NOTE just assume this is already normalized?
+    auto normalized_axis = normalize(axis);
     quatf_t res;
     auto s = math::sin(rad * 0.5f);
-    res.x = axis.x * s;
-    res.y = axis.y * s;
-    res.z = axis.z * s;
+    res.x = normalized_axis.x * s;
+    res.y = normalized_axis.y * s;
+    res.z = normalized_axis.z * s;
     res.w = math::cos(rad * 0.5f);
     return res;
 }
@@ -760,144 +882,126 @@ mini::math::quatf_t mini::math::angle_axis(mini::math::vec3f_t const& axis, floa
 // -----------------------------------------------------------
 // -----------------------------------------------------------
 
-mini::math::mat4x4f_t mini::math::inverse(mini::math::mat4x4f_t const& mat)
+mini::math::dualquatf_t mini::math::make_dualquat(mini::math::quatf_t const& rotation, mini::math::vec3f_t const& translation)
 {
-    mat4x4f_t result;
+    // 0.5 * (0, t) * r
+    auto const& r = rotation;
+    auto const& t = translation;
+    return dualquatf_t(r, quatf_t(
+        -0.5f * (t.x * r.x + t.y * r.y + t.z * r.z),
+        0.5f * (t.x * r.w + t.y * r.z - t.z * r.y),
+        0.5f * (t.y * r.w + t.z * r.x - t.x * r.z),
+        0.5f * (t.z * r.w + t.x * r.y - t.y * r.x)));
+}
 
-    float det = 0.0f;
-    float const* m = mat.elements;
-    float* inv = result.elements;
-
-    inv[0] = m[5] * m[10] * m[15] -
-        m[5] * m[11] * m[14] -
-        m[9] * m[6] * m[15] +
-        m[9] * m[7] * m[14] +
-        m[13] * m[6] * m[11] -
-        m[13] * m[7] * m[10];
-
-    inv[4] = -m[4] * m[10] * m[15] +
-        m[4] * m[11] * m[14] +
-        m[8] * m[6] * m[15] -
-        m[8] * m[7] * m[14] -
-        m[12] * m[6] * m[11] +
-        m[12] * m[7] * m[10];
-
-    inv[8] = m[4] * m[9] * m[15] -
-        m[4] * m[11] * m[13] -
-        m[8] * m[5] * m[15] +
-        m[8] * m[7] * m[13] +
-        m[12] * m[5] * m[11] -
-        m[12] * m[7] * m[9];
-
-    inv[12] = -m[4] * m[9] * m[14] +
-        m[4] * m[10] * m[13] +
-        m[8] * m[5] * m[14] -
-        m[8] * m[6] * m[13] -
-        m[12] * m[5] * m[10] +
-        m[12] * m[6] * m[9];
-
-    inv[1] = -m[1] * m[10] * m[15] +
-        m[1] * m[11] * m[14] +
-        m[9] * m[2] * m[15] -
-        m[9] * m[3] * m[14] -
-        m[13] * m[2] * m[11] +
-        m[13] * m[3] * m[10];
-
-    inv[5] = m[0] * m[10] * m[15] -
-        m[0] * m[11] * m[14] -
-        m[8] * m[2] * m[15] +
-        m[8] * m[3] * m[14] +
-        m[12] * m[2] * m[11] -
-        m[12] * m[3] * m[10];
-
-    inv[9] = -m[0] * m[9] * m[15] +
-        m[0] * m[11] * m[13] +
-        m[8] * m[1] * m[15] -
-        m[8] * m[3] * m[13] -
-        m[12] * m[1] * m[11] +
-        m[12] * m[3] * m[9];
-
-    inv[13] = m[0] * m[9] * m[14] -
-        m[0] * m[10] * m[13] -
-        m[8] * m[1] * m[14] +
-        m[8] * m[2] * m[13] +
-        m[12] * m[1] * m[10] -
-        m[12] * m[2] * m[9];
-
-    inv[2] = m[1] * m[6] * m[15] -
-        m[1] * m[7] * m[14] -
-        m[5] * m[2] * m[15] +
-        m[5] * m[3] * m[14] +
-        m[13] * m[2] * m[7] -
-        m[13] * m[3] * m[6];
-
-    inv[6] = -m[0] * m[6] * m[15] +
-        m[0] * m[7] * m[14] +
-        m[4] * m[2] * m[15] -
-        m[4] * m[3] * m[14] -
-        m[12] * m[2] * m[7] +
-        m[12] * m[3] * m[6];
-
-    inv[10] = m[0] * m[5] * m[15] -
-        m[0] * m[7] * m[13] -
-        m[4] * m[1] * m[15] +
-        m[4] * m[3] * m[13] +
-        m[12] * m[1] * m[7] -
-        m[12] * m[3] * m[5];
-
-    inv[14] = -m[0] * m[5] * m[14] +
-        m[0] * m[6] * m[13] +
-        m[4] * m[1] * m[14] -
-        m[4] * m[2] * m[13] -
-        m[12] * m[1] * m[6] +
-        m[12] * m[2] * m[5];
-
-    inv[3] = -m[1] * m[6] * m[11] +
-        m[1] * m[7] * m[10] +
-        m[5] * m[2] * m[11] -
-        m[5] * m[3] * m[10] -
-        m[9] * m[2] * m[7] +
-        m[9] * m[3] * m[6];
-
-    inv[7] = m[0] * m[6] * m[11] -
-        m[0] * m[7] * m[10] -
-        m[4] * m[2] * m[11] +
-        m[4] * m[3] * m[10] +
-        m[8] * m[2] * m[7] -
-        m[8] * m[3] * m[6];
-
-    inv[11] = -m[0] * m[5] * m[11] +
-        m[0] * m[7] * m[9] +
-        m[4] * m[1] * m[11] -
-        m[4] * m[3] * m[9] -
-        m[8] * m[1] * m[7] +
-        m[8] * m[3] * m[5];
-
-    inv[15] = m[0] * m[5] * m[10] -
-        m[0] * m[6] * m[9] -
-        m[4] * m[1] * m[10] +
-        m[4] * m[2] * m[9] +
-        m[8] * m[1] * m[6] -
-        m[8] * m[2] * m[5];
-
-    det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
-
-    if (det == 0) {
-        return mat4x4f_t();
-    }
+mini::math::dualquatf_t mini::math::dualquat_from_mat(mini::math::mat3x4f_t const& mat)
+{
+    return make_dualquat(quat_from_mat(to_mat4x4(mat)), mat[3]);
+}
+
+mini::math::mat3x4f_t mini::math::dualquat_to_mat(mini::math::dualquatf_t const& dq)
+{
+    auto const r = quat_to_mat(dq.real);
+    return mat3x4f_t(r[0].xyz, r[1].xyz, r[2].xyz, dualquat_translation(dq));
+}
 
-    det = 1.0f / det;
+mini::math::vec3f_t mini::math::dualquat_translation(mini::math::dualquatf_t const& dq)
+{
+    // 2 * dual * conjugate(real), whose w is 0 for unit dual quaternions
+    auto const& r = dq.real;
+    auto const& d = dq.dual;
+    auto const ru = vec3f_t(r.x, r.y, r.z), du = vec3f_t(d.x, d.y, d.z);
+    return (du * r.w - ru * d.w + cross(ru, du)) * 2.0f;
+}
 
-    for (auto i = 0; i < 16; i++) {
-        inv[i] = inv[i] * det;
+mini::math::dualquatf_t mini::math::operator * (mini::math::dualquatf_t const& lhs, mini::math::dualquatf_t const& rhs)
+{
+    auto const a = lhs.real * rhs.dual, b = lhs.dual * rhs.real;
+    return dualquatf_t(lhs.real * rhs.real, quatf_t(a.w + b.w, a.x + b.x, a.y + b.y, a.z + b.z));
+}
+
+mini::math::vec3f_t mini::math::transform_pos(mini::math::dualquatf_t const& dq, mini::math::vec3f_t const& position)
+{
+    return transform_dir(dq, position) + dualquat_translation(dq);
+}
+
+mini::math::vec3f_t mini::math::transform_dir(mini::math::dualquatf_t const& dq, mini::math::vec3f_t const& direction)
+{
+    // v + w t + u x t with t = 2 u x v
+    auto const u = vec3f_t(dq.real.x, dq.real.y, dq.real.z);
+    auto const t = cross(u, direction) * 2.0f;
+    return direction + t * dq.real.w + cross(u, t);
+}
+
+mini::math::dualquatf_t mini::math::normalize(mini::math::dualquatf_t const& dq)
+{
+    auto const& r = dq.real;
+    auto const& d = dq.dual;
+    auto const invLen = 1.0f / sqrt(r.w * r.w + r.x * r.x + r.y * r.y + r.z * r.z);
+    quatf_t const real(r.w * invLen, r.x * invLen, r.y * invLen, r.z * invLen);
+    quatf_t const dual(d.w * invLen, d.x * invLen, d.y * invLen, d.z * invLen);
+    auto const along = real.w * dual.w + real.x * dual.x + real.y * dual.y + real.z * dual.z;
+    return dualquatf_t(real, quatf_t(dual.w - real.w * along, dual.x - real.x * along, dual.y - real.y * along, dual.z - real.z * along));
+}
+
+mini::math::dualquatf_t mini::math::inverse(mini::math::dualquatf_t const& dq)
+{
+    // the conjugate of both parts
+    return dualquatf_t(
+        quatf_t(dq.real.w, -dq.real.x, -dq.real.y, -dq.real.z),
+        quatf_t(dq.dual.w, -dq.dual.x, -dq.dual.y, -dq.dual.z));
+}
+
+mini::math::dualquatf_t mini::math::dualquat_blend(mini::math::dualquatf_t const* dqs, float const* weights, uint32_t count)
+{
+    auto const& pivot = dqs[0].real;
+    float sum[8] = {};
+    for (auto i = 0u; i < count; ++i) {
+        auto const& r = dqs[i].real;
+        auto const d = pivot.w * r.w + pivot.x * r.x + pivot.y * r.y + pivot.z * r.z;
+        auto const w = d < 0.0f ? -weights[i] : weights[i];
+        for (auto k = 0; k < 4; ++k) {
+            sum[k] += dqs[i].real.elements[k] * w;
+            sum[k + 4] += dqs[i].dual.elements[k] * w;
+        }
     }
+    return normalize(dualquatf_t(quatf_t(sum[0], sum[1], sum[2], sum[3]), quatf_t(sum[4], sum[5], sum[6], sum[7])));
+}
 
+// -----------------------------------------------------------
+// -----------------------------------------------------------
+
+mini::math::mat4x4f_t mini::math::inverse(mini::math::mat4x4f_t const& mat)
+{
+    // @note singular matrices give the identity
+    mat4x4f_t result;
+    kernels::selected::inverse(mat.elements, result.elements);
+    return result;
+}
+
+mini::math::mat3x4f_t mini::math::inverse(mini::math::mat3x4f_t const& mat)
+{
+    // @note singular matrices give the identity, like the 4x4 inverse
+    mat3x4f_t result;
+    kernels::selected::affine_inverse(mat.elements, result.elements);
+    return result;
+}
+
+mini::math::mat4x4f_t mini::math::inverse_rigid(mini::math::mat4x4f_t const& mat)
+{
+    return to_mat4x4(inverse_rigid(to_affine(mat)));
+}
+
+mini::math::mat3x4f_t mini::math::inverse_rigid(mini::math::mat3x4f_t const& mat)
+{
+    mat3x4f_t result;
+    kernels::selected::affine_inverse_rigid(mat.elements, result.elements);
     return result;
 }
 
 // --
 
-mini::math::vec4f_t mini::math::column(mini::math::mat4x4f_t const& mat, int index)
+constexpr mini::math::vec4f_t mini::math::column(mini::math::mat4x4f_t const& mat, int index)
 {
     return mat.columns[index];
 }
@@ -916,22 +1020,22 @@ mini::math::vec4f_t mini::math::row(mini::math::mat4x4f_t const& mat, int index)
 // -----------------------------------------------------------
 
 
-float mini::math::RadToDeg(float rad)
+constexpr float mini::math::RadToDeg(float rad)
 {
     return rad * (180.0f / PI);
 }
 
-float mini::math::DegToRad(float deg)
+constexpr float mini::math::DegToRad(float deg)
 {
     return deg * (PI / 180.0f);
 }
 
-double mini::math::DegToRad(double deg)
+constexpr double mini::math::DegToRad(double deg)
 {
     return deg * (static_cast<double>(PI) / 180.0);
 }
 
-double mini::math::RadToDeg(double rad)
+constexpr double mini::math::RadToDeg(double rad)
 {
     return rad * (180.0 / static_cast<double>(PI));
 }
@@ -991,26 +1095,193 @@ double mini::math::asin(double v)
     return ::asin(v);
 }
 
+float mini::math::rsqrt(float v)
+{
+    return 1.0f / ::sqrtf(v);
+}
+
+float mini::math::atan2(float y, float x)
+{
+    return ::atan2f(y, x);
+}
+
+float mini::math::exp(float v)
+{
+    return ::expf(v);
+}
+
+float mini::math::log(float v)
+{
+    return ::logf(v);
+}
+
+double mini::math::atan2(double y, double x)
+{
+    return ::atan2(y, x);
+}
+
+double mini::math::exp(double v)
+{
+    return ::exp(v);
+}
+
+double mini::math::log(double v)
+{
+    return ::log(v);
+}
+
+// -- fast tier. math_batch.cpp evaluates the same expressions in the same order per lane, keep them in sync. where the exact tier
+//    is as fast per element the polynomial only lives there
+
+void mini::math::fast_sincos(float v, float* outSin, float* outCos)
+{
+    // k = nearest multiple of pi/2, r = v - k pi/2 in [-pi/4, pi/4] with pi/2 split in three (Cody-Waite): the first two
+    // parts have few enough bits that k times them is exact for |k| < 2^15. minimax polynomials from Cephes' sinf/cosf
+    // @note    rounded with 1.5 2^23: floats that large have no fraction bits, adding it rounds to the nearest integer for |x| < 2^22
+    //          and leaves that integer in the low mantissa bits, subtracting it again gives it as a float. floorf would be an out of
+    //          line libm call
+    auto const shifted = v * 0.636619772367581343f + 12582912.0f;
+    auto const k = shifted - 12582912.0f;
+    auto const r = ((v - k * 1.5703125f) - k * 4.837512969970703125e-4f) - k * 7.54978995489188216e-8f;
+    auto const z = r * r;
+    auto const s = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+    auto const c = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+
+    // the quadrant picks which of the two and the signs: sin(r + q pi/2) is sin r, cos r, -sin r, -cos r. only q's low bits are
+    // needed, which are shifted's
+    int32_t q;
+    memcpy(&q, &shifted, sizeof(q));
+    auto const sinQ = (q & 1) ? c : s;
+    auto const cosQ = (q & 1) ? s : c;
+    *outSin = (q & 2) ? -sinQ : sinQ;
+    *outCos = ((q + 1) & 2) ? -cosQ : cosQ;
+}
+
+float mini::math::fast_sin(float v)
+{
+    float s, c;
+    fast_sincos(v, &s, &c);
+    return s;
+}
+
+float mini::math::fast_cos(float v)
+{
+    float s, c;
+    fast_sincos(v, &s, &c);
+    return c;
+}
+
+float mini::math::fast_rsqrt(float v)
+{
+    // @note    the hardware estimate plus Newton steps (y' = y (1.5 - v/2 y^2)) until below 2^-21: one for SSE's 12 bit estimate,
+    //          two for NEON's 8 bit one. without either it's the exact tier
+#if defined(MINI_SIMD_SSE4)
+    // @note set1 rather than set_ss, which merges into whatever register and chains every call in a loop to the previous one
+    auto const y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set1_ps(v)));
+    auto const halfV = 0.5f * v;
+    return y * (1.5f - halfV * y * y);
+#elif defined(MINI_SIMD_NEON)
+    auto y = vrsqrtes_f32(v);
+    auto const halfV = 0.5f * v;
+    y = y * (1.5f - halfV * y * y);
+    return y * (1.5f - halfV * y * y);
+#else
+    return rsqrt(v);
+#endif
+}
+
+float mini::math::fast_atan2(float y, float x)
+{
+    // atan of a = min / max in [0, 1], reduced once more to [0, tan(pi/8)] with atan a = pi/4 + atan((a - 1) / (a + 1)).
+    // Cephes' atanf polynomial, then the octant from the signs and which of |x| and |y| was larger
+    auto const absX = fabsf(x), absY = fabsf(y);
+    auto const minXY = absX < absY ? absX : absY;
+    auto const maxXY = absX > absY ? absX : absY;
+    auto const a = minXY / (maxXY > 1.17549435e-38f ? maxXY : 1.17549435e-38f);
+    auto const reduce = a > 0.414213562373095f;
+    auto const t = reduce ? (a - 1.0f) / (a + 1.0f) : a;
+    auto const base = reduce ? 0.785398163397448f : 0.0f;
+    auto const z = t * t;
+    auto r = (((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f) * z * t + t + base;
+    r = absY > absX ? 1.57079632679490f - r : r;
+    r = x < 0.0f ? 3.14159265358979f - r : r;
+    return y < 0.0f ? -r : r;
+}
+
+float mini::math::fast_exp(float v)
+{
+    // e^v = 2^n e^r with n = round(v / ln 2) and |r| <= ln 2 / 2, ln 2 split in two. Cephes' expf polynomial for e^r, 2^n built
+    // in the exponent bits from shifted's, which hold n + 1.5 2^23 (see fast_sincos). the clamp keeps n in [-126, 127]
+    // @note the polynomial only beats a table driven C runtime expf like glibc's with FMA, without it's the exact tier
+    v = v < -87.3f ? -87.3f : v;
+    v = v > 88.3f ? 88.3f : v;
+#if defined(MINI_SIMD_FMA)
+    auto const shifted = v * 1.44269504088896341f + 12582912.0f;
+    auto const n = shifted - 12582912.0f;
+    auto const r = (v - n * 0.693359375f) - n * -2.12194440e-4f;
+    auto const p = (((((1.9875691500e-4f * r + 1.3981999507e-3f) * r + 8.3334519073e-3f) * r + 4.1665795894e-2f) * r
+        + 1.6666665459e-1f) * r + 5.0000001201e-1f) * r * r + r + 1.0f;
+    uint32_t bits;
+    memcpy(&bits, &shifted, sizeof(bits));
+    bits = (bits + (127 - 0x4b400000u)) << 23;
+    float scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+#else
+    return exp(v);
+#endif
+}
+
+float mini::math::fast_log(float v)
+{
+    // v = m 2^e with m in [sqrt(2) / 2, sqrt(2)), log v = log m + e ln 2 with ln 2 split in two. Cephes' logf polynomial for
+    // log(1 + f), f = m - 1
+    // @note like fast_exp the nine term polynomial only beats the C runtime's logf with FMA, without it's the exact tier
+#if defined(MINI_SIMD_FMA)
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    auto e = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+    bits = (bits & 0x007fffffu) | 0x3f800000u;
+    float m;
+    memcpy(&m, &bits, sizeof(m));
+    auto const above = m > 1.41421356237309f;
+    m = above ? m * 0.5f : m;
+    e = above ? e + 1.0f : e;
+    auto const f = m - 1.0f;
+    auto const z = f * f;
+    auto y = ((((((((7.0376836292e-2f * f - 1.1514610310e-1f) * f + 1.1676998740e-1f) * f - 1.2420140846e-1f) * f
+        + 1.4249322787e-1f) * f - 1.6668057665e-1f) * f + 2.0000714765e-1f) * f - 2.4999993993e-1f) * f + 3.3333331174e-1f) * f * z;
+    y = y + e * -2.12194440e-4f - 0.5f * z;
+    return (f + y) + e * 0.693359375f;
+#else
+    return log(v);
+#endif
+}
+
+mini::math::vec3f_t mini::math::fast_normalize(mini::math::vec3f_t const& vec)
+{
+    return vec * fast_rsqrt(dot(vec, vec));
+}
+
 //
 
 bool mini::math::intersect_planes(plane_t const& a, plane_t const& b, line_t* intersection_line)
 {
+    // @note planes are dot(normal, p) = d here, parallel planes don't intersect
     auto p3_normal = cross(a.normal, b.normal);
     auto det = squared_length(p3_normal);
-    if (det < 0.000001f) {
-        if (intersection_line != nullptr) {
-            intersection_line->p = (cross(p3_normal, b.normal) * a.d + cross(a.normal, p3_normal) * b.d) / det;
-            intersection_line->normal = p3_normal;
-        }
-        return true;
+    if (det < 0.000001f) { return false; }
+    if (intersection_line != nullptr) {
+        intersection_line->p = (cross(b.normal, p3_normal) * a.d + cross(p3_normal, a.normal) * b.d) / det;
+        intersection_line->normal = p3_normal;
     }
-    return false;
+    return true;
 }
 
 bool mini::math::intersect_line_x_plane(line_t const& line, plane_t const& plane, vec3f_t* intersection_point)
 {
     auto plane_p = plane.normal * plane.d;
-    if (dot(line.normal, plane.normal) < 0.000001f) { return false; }
+    if (fabsf(dot(line.normal, plane.normal)) < 0.000001f) { return false; }      // parallel, either side of the plane
     if (!intersection_point) { return true; }
     auto diff = line.p - plane_p;
     auto prod1 = dot(diff, plane.normal);
@@ -1018,4 +1289,14 @@ bool mini::math::intersect_line_x_plane(line_t const& line, plane_t const& plane
     auto prod3 = prod1 / prod2;
     *intersection_point = line.p - line.normal * prod3;
     return true;
-}
\ No newline at end of file
+}
+
+// -----------------------------------------------------------
+// -----------------------------------------------------------
+
+// @note the constexpr paths have to stay constexpr, e.g. for constants built from other constants
+static_assert(mini::math::cross(mini::math::vec3f_t(1.0f, 0.0f, 0.0f), mini::math::vec3f_t(0.0f, 1.0f, 0.0f)).z == 1.0f, "cross must be constexpr");
+static_assert(mini::math::dot(mini::math::vec4f_t(1.0f, 2.0f, 3.0f, 4.0f) * 2.0f - 1.0f, mini::math::vec4f_t(1.0f)) == 16.0f, "vector operators must be constexpr");
+static_assert((mini::math::quatf_t::identity() * mini::math::quatf_t(0.0f, 1.0f, 0.0f, 0.0f)).x == 1.0f, "quaternion products must be constexpr");
+static_assert(mini::math::column(mini::math::make_translation(mini::math::vec3f_t(1.0f, 2.0f, 3.0f)), 3).w == 1.0f, "make_translation must be constexpr");
+static_assert(mini::math::clamp(mini::math::DegToRad(180.0f), 0.0f, 1.0f) == 1.0f, "scalar helpers must be constexpr");
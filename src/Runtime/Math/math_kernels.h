@@ -0,0 +1,606 @@
+#pragma once
+#include "math_simd.h"
+
+#include <string.h>
+
+/*
+    *   Kernels behind the mat4x4f_t / mat3x4f_t / quatf_t operations in math_functions.h, on column major float[16] and float[12]
+    *   and on wxyz float[4].
+    *   Every instruction set gets its own namespace so benchmarks can compare them, math_functions.h calls kernels::selected,
+    *   the widest one compiled in. Where a backend has nothing better it reuses the next narrower one's kernel.
+    *
+    *   Results against kernels::scalar:
+    *       mat_mul, transform_pos, quat_to_mat     the SIMD kernels do the same multiplies and adds in the same order (no FMA, AVX2
+    *                                               included), bit identical unless the compiler contracts the scalar code into FMAs,
+    *                                               then within 1 ULP of the largest element. same for the affine_* kernels
+    *       inverse                                 block wise 2x2 inversion instead of 16 cofactors, within 32 ULP of the largest
+    *                                               element of the inverse for TRS matrices with a condition number below 100
+    *   Singular matrices make every inverse kernel return false and write the identity, like the scalar one always did.
+*/
+namespace mini
+{
+    namespace math
+    {
+        namespace kernels
+        {
+            namespace scalar
+            {
+                inline void mat_mul(float const* lhs, float const* rhs, float* out)
+                {
+                    float result[16];
+                    for (auto column = 0; column < 4; ++column) {
+                        for (auto row = 0; row < 4; ++row) {
+                            result[column * 4 + row] = lhs[row] * rhs[column * 4] + lhs[4 + row] * rhs[column * 4 + 1]
+                                + lhs[8 + row] * rhs[column * 4 + 2] + lhs[12 + row] * rhs[column * 4 + 3];
+                        }
+                    }
+                    memcpy(out, result, sizeof(result));
+                }
+
+                inline void transform_pos(float const* m, float const* position, float* out)
+                {
+                    float result[3];
+                    for (auto row = 0; row < 3; ++row) {
+                        result[row] = m[row] * position[0] + m[4 + row] * position[1] + m[8 + row] * position[2] + m[12 + row];
+                    }
+                    memcpy(out, result, sizeof(result));
+                }
+
+                inline void quat_to_mat(float const* q, float* out)
+                {
+                    auto const w = q[0], x = q[1], y = q[2], z = q[3];
+                    float const result[16] = {
+                        1.0f - 2.0f * y * y - 2.0f * z * z, 2.0f * x * y + 2.0f * z * w, 2.0f * x * z - 2.0f * y * w, 0.0f,
+                        2.0f * x * y - 2.0f * z * w, 1.0f - 2.0f * x * x - 2.0f * z * z, 2.0f * y * z + 2.0f * x * w, 0.0f,
+                        2.0f * x * z + 2.0f * y * w, 2.0f * y * z - 2.0f * x * w, 1.0f - 2.0f * x * x - 2.0f * y * y, 0.0f,
+                        0.0f, 0.0f, 0.0f, 1.0f,
+                    };
+                    memcpy(out, result, sizeof(result));
+                }
+
+                inline bool inverse(float const* m, float* out)
+                {
+                    float inv[16];
+                    inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+                    inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+                    inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+                    inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+                    inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+                    inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+                    inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+                    inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+                    inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+                    inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+                    inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+                    inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+                    inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+                    inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+                    inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+                    inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+                    auto det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+                    if (det == 0.0f) {
+                        float const identity[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+                        memcpy(out, identity, sizeof(identity));
+                        return false;
+                    }
+                    det = 1.0f / det;
+                    for (auto i = 0; i < 16; i++) {
+                        out[i] = inv[i] * det;
+                    }
+                    return true;
+                }
+
+                // affine 3x4 kernels, column major float[12] with the last row (0, 0, 0, 1) implied
+                inline void affine_mul(float const* lhs, float const* rhs, float* out)
+                {
+                    float result[12];
+                    for (auto column = 0; column < 4; ++column) {
+                        for (auto row = 0; row < 3; ++row) {
+                            result[column * 3 + row] = lhs[row] * rhs[column * 3] + lhs[3 + row] * rhs[column * 3 + 1] + lhs[6 + row] * rhs[column * 3 + 2];
+                        }
+                    }
+                    for (auto row = 0; row < 3; ++row) { result[9 + row] += lhs[9 + row]; }
+                    memcpy(out, result, sizeof(result));
+                }
+
+                // the rotation transposed, the translation rotated back and negated
+                inline void affine_inverse_rigid(float const* m, float* out)
+                {
+                    float result[12];
+                    for (auto column = 0; column < 3; ++column) {
+                        for (auto row = 0; row < 3; ++row) { result[column * 3 + row] = m[row * 3 + column]; }
+                    }
+                    for (auto row = 0; row < 3; ++row) { result[9 + row] = -(result[row] * m[9] + result[3 + row] * m[10] + result[6 + row] * m[11]); }
+                    memcpy(out, result, sizeof(result));
+                }
+
+                // @note the 3x3 part's inverse is its adjugate over the determinant, the adjugate's rows are cross products of the columns
+                inline bool affine_inverse(float const* m, float* out)
+                {
+                    auto const a = m, b = m + 3, c = m + 6;
+                    float const bc[3] = { b[1] * c[2] - b[2] * c[1], b[2] * c[0] - b[0] * c[2], b[0] * c[1] - b[1] * c[0] };
+                    float const ca[3] = { c[1] * a[2] - c[2] * a[1], c[2] * a[0] - c[0] * a[2], c[0] * a[1] - c[1] * a[0] };
+                    float const ab[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+                    auto const det = a[0] * bc[0] + a[1] * bc[1] + a[2] * bc[2];
+                    if (det == 0.0f) {
+                        float const identity[12] = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+                        memcpy(out, identity, sizeof(identity));
+                        return false;
+                    }
+                    auto const rcpDet = 1.0f / det;
+                    float result[12];
+                    for (auto column = 0; column < 3; ++column) {
+                        result[column * 3] = bc[column] * rcpDet;
+                        result[column * 3 + 1] = ca[column] * rcpDet;
+                        result[column * 3 + 2] = ab[column] * rcpDet;
+                    }
+                    for (auto row = 0; row < 3; ++row) { result[9 + row] = -(result[row] * m[9] + result[3 + row] * m[10] + result[6 + row] * m[11]); }
+                    memcpy(out, result, sizeof(result));
+                    return true;
+                }
+            }
+
+#if defined(MINI_SIMD_SSE4)
+            namespace sse4
+            {
+                inline void mat_mul(float const* lhs, float const* rhs, float* out)
+                {
+                    auto const c0 = _mm_loadu_ps(lhs), c1 = _mm_loadu_ps(lhs + 4), c2 = _mm_loadu_ps(lhs + 8), c3 = _mm_loadu_ps(lhs + 12);
+                    __m128 result[4];
+                    for (auto column = 0; column < 4; ++column) {
+                        auto const r = _mm_loadu_ps(rhs + column * 4);
+                        auto sum = _mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(r, r, 0x00)), _mm_mul_ps(c1, _mm_shuffle_ps(r, r, 0x55)));
+                        sum = _mm_add_ps(sum, _mm_mul_ps(c2, _mm_shuffle_ps(r, r, 0xaa)));
+                        result[column] = _mm_add_ps(sum, _mm_mul_ps(c3, _mm_shuffle_ps(r, r, 0xff)));
+                    }
+                    for (auto column = 0; column < 4; ++column) { _mm_storeu_ps(out + column * 4, result[column]); }    // @note out may alias lhs or rhs
+                }
+
+                inline void transform_pos(float const* m, float const* position, float* out)
+                {
+                    auto sum = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(position[0])), _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_set1_ps(position[1])));
+                    sum = _mm_add_ps(_mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_set1_ps(position[2]))), _mm_loadu_ps(m + 12));
+                    float result[4];
+                    _mm_storeu_ps(result, sum);
+                    memcpy(out, result, sizeof(float) * 3);
+                }
+
+                // @note    every column is (base + a * signA) + b * signB, multiplying by +-1 and adding 0 is exact so each lane
+                //          rounds like the scalar expression it stands for
+                inline void quat_to_mat(float const* q, float* out)
+                {
+                    auto const wxyz = _mm_loadu_ps(q);
+                    auto const twice = _mm_add_ps(wxyz, wxyz);
+                    auto const lane = [](__m128 v, int i) { return _mm_castsi128_ps(_mm_shuffle_epi32(_mm_castps_si128(v), i * 0x55)); };
+                    auto const w = lane(wxyz, 0), x = lane(wxyz, 1), y = lane(wxyz, 2), z = lane(wxyz, 3);
+                    auto const x2 = lane(twice, 1), y2 = lane(twice, 2), z2 = lane(twice, 3);
+
+                    auto const Column = [](__m128 base, __m128 a, __m128 signA, __m128 b, __m128 signB) {
+                        return _mm_add_ps(_mm_add_ps(base, _mm_mul_ps(a, signA)), _mm_mul_ps(b, signB));
+                    };
+                    // column 0: 1 - 2yy - 2zz, 2xy + 2zw, 2xz - 2yw
+                    auto const col0 = Column(_mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f),
+                        _mm_mul_ps(_mm_blend_ps(y2, x2, 0x6), _mm_blend_ps(y, z, 0x4)), _mm_setr_ps(-1.0f, 1.0f, 1.0f, 0.0f),
+                        _mm_mul_ps(_mm_blend_ps(z2, y2, 0x4), _mm_blend_ps(z, w, 0x6)), _mm_setr_ps(-1.0f, 1.0f, -1.0f, 0.0f));
+                    // column 1: 2xy - 2zw, 1 - 2xx - 2zz, 2yz + 2xw
+                    auto const col1 = Column(_mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f),
+                        _mm_mul_ps(_mm_blend_ps(x2, y2, 0x4), _mm_blend_ps(y, _mm_blend_ps(x, z, 0x4), 0x6)), _mm_setr_ps(1.0f, -1.0f, 1.0f, 0.0f),
+                        _mm_mul_ps(_mm_blend_ps(z2, x2, 0x4), _mm_blend_ps(w, _mm_blend_ps(z, w, 0x4), 0x6)), _mm_setr_ps(-1.0f, -1.0f, 1.0f, 0.0f));
+                    // column 2: 2xz + 2yw, 2yz - 2xw, 1 - 2xx - 2yy
+                    auto const col2 = Column(_mm_setr_ps(0.0f, 0.0f, 1.0f, 0.0f),
+                        _mm_mul_ps(_mm_blend_ps(x2, y2, 0x2), _mm_blend_ps(z, x, 0x4)), _mm_setr_ps(1.0f, 1.0f, -1.0f, 0.0f),
+                        _mm_mul_ps(_mm_blend_ps(y2, x2, 0x2), _mm_blend_ps(w, y, 0x4)), _mm_setr_ps(1.0f, -1.0f, -1.0f, 0.0f));
+                    _mm_storeu_ps(out, col0);
+                    _mm_storeu_ps(out + 4, col1);
+                    _mm_storeu_ps(out + 8, col2);
+                    _mm_storeu_ps(out + 12, _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+                }
+
+                // 2x2 helpers for inverse, a 2x2 matrix is (m00, m01, m10, m11) in one register
+                inline __m128 mat2_mul(__m128 a, __m128 b)
+                {
+                    return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+                }
+                // adj(a) * b
+                inline __m128 mat2_adj_mul(__m128 a, __m128 b)
+                {
+                    return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+                }
+                // a * adj(b)
+                inline __m128 mat2_mul_adj(__m128 a, __m128 b)
+                {
+                    return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+                }
+
+                // @note    block wise inversion, the columns are treated as rows, which inverts the transpose and so the matrix.
+                //          M = | A B |, the inverse's blocks are the adjugates of D|A| - B adj(D) C etc. divided by |M|
+                //              | C D |
+                inline bool inverse(float const* m, float* out)
+                {
+                    auto const r0 = _mm_loadu_ps(m), r1 = _mm_loadu_ps(m + 4), r2 = _mm_loadu_ps(m + 8), r3 = _mm_loadu_ps(m + 12);
+                    auto const a = _mm_movelh_ps(r0, r1);
+                    auto const b = _mm_movehl_ps(r1, r0);
+                    auto const c = _mm_movelh_ps(r2, r3);
+                    auto const d = _mm_movehl_ps(r3, r2);
+
+                    // |A| |B| |C| |D|
+                    auto const detSub = _mm_sub_ps(
+                        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+                        _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+                    auto const detA = _mm_shuffle_ps(detSub, detSub, 0x00);
+                    auto const detB = _mm_shuffle_ps(detSub, detSub, 0x55);
+                    auto const detC = _mm_shuffle_ps(detSub, detSub, 0xaa);
+                    auto const detD = _mm_shuffle_ps(detSub, detSub, 0xff);
+
+                    auto const dc = mat2_adj_mul(d, c);
+                    auto const ab = mat2_adj_mul(a, b);
+                    auto x = _mm_sub_ps(_mm_mul_ps(detD, a), mat2_mul(b, dc));
+                    auto w = _mm_sub_ps(_mm_mul_ps(detA, d), mat2_mul(c, ab));
+                    auto y = _mm_sub_ps(_mm_mul_ps(detB, c), mat2_mul_adj(d, ab));
+                    auto z = _mm_sub_ps(_mm_mul_ps(detC, b), mat2_mul_adj(a, dc));
+
+                    // |M| = |A||D| + |B||C| - tr(adj(A) B adj(D) C)
+                    auto tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+                    tr = _mm_hadd_ps(tr, tr);
+                    tr = _mm_hadd_ps(tr, tr);
+                    auto const detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+                    if (_mm_cvtss_f32(detM) == 0.0f) {
+                        float const identity[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+                        memcpy(out, identity, sizeof(identity));
+                        return false;
+                    }
+
+                    auto const rcpDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+                    x = _mm_mul_ps(x, rcpDet);
+                    y = _mm_mul_ps(y, rcpDet);
+                    z = _mm_mul_ps(z, rcpDet);
+                    w = _mm_mul_ps(w, rcpDet);
+
+                    // @note the adjugate's shuffle and the store's are combined
+                    _mm_storeu_ps(out, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+                    _mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+                    _mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+                    _mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+                    return true;
+                }
+
+                // @note    affine columns are 3 floats apart, the matrix is read and written as three 4 float blocks and repacked
+                //          into columns. overlapping column stores would defeat store to load forwarding for whoever reads the result
+                //          next. the 4th lane of each column is whatever came along and is ignored
+                inline void affine_load(float const* m, __m128* columns)
+                {
+                    auto const v0 = _mm_loadu_ps(m);
+                    auto const v1 = _mm_loadu_ps(m + 4);
+                    auto const v2 = _mm_loadu_ps(m + 8);
+                    columns[0] = v0;
+                    columns[1] = _mm_castsi128_ps(_mm_alignr_epi8(_mm_castps_si128(v1), _mm_castps_si128(v0), 12));
+                    columns[2] = _mm_castsi128_ps(_mm_alignr_epi8(_mm_castps_si128(v2), _mm_castps_si128(v1), 8));
+                    columns[3] = _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(0, 3, 2, 1));
+                }
+
+                inline void affine_store(float* m, __m128 const* columns)
+                {
+                    auto const lastTwo = _mm_shuffle_ps(columns[2], columns[3], _MM_SHUFFLE(0, 0, 2, 2));
+                    _mm_storeu_ps(m, _mm_blend_ps(columns[0], _mm_shuffle_ps(columns[1], columns[1], _MM_SHUFFLE(0, 0, 0, 0)), 0x8));
+                    _mm_storeu_ps(m + 4, _mm_shuffle_ps(columns[1], columns[2], _MM_SHUFFLE(1, 0, 2, 1)));
+                    _mm_storeu_ps(m + 8, _mm_shuffle_ps(lastTwo, columns[3], _MM_SHUFFLE(2, 1, 2, 0)));
+                }
+
+                inline void affine_mul(float const* lhs, float const* rhs, float* out)
+                {
+                    __m128 c[4];
+                    affine_load(lhs, c);
+                    auto const Column = [&](float const* r) {
+                        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0], _mm_set1_ps(r[0])), _mm_mul_ps(c[1], _mm_set1_ps(r[1]))), _mm_mul_ps(c[2], _mm_set1_ps(r[2])));
+                    };
+                    __m128 const result[4] = { Column(rhs), Column(rhs + 3), Column(rhs + 6), _mm_add_ps(Column(rhs + 9), c[3]) };
+                    affine_store(out, result);
+                }
+
+                inline void affine_inverse_rigid(float const* m, float* out)
+                {
+                    __m128 c[4];
+                    affine_load(m, c);
+                    auto const t = c[3];
+                    c[3] = _mm_setzero_ps();
+                    _MM_TRANSPOSE4_PS(c[0], c[1], c[2], c[3]);
+                    auto sum = _mm_add_ps(_mm_mul_ps(c[0], _mm_shuffle_ps(t, t, 0x00)), _mm_mul_ps(c[1], _mm_shuffle_ps(t, t, 0x55)));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(c[2], _mm_shuffle_ps(t, t, 0xaa)));
+                    c[3] = _mm_sub_ps(_mm_setzero_ps(), sum);
+                    affine_store(out, c);
+                }
+
+                // the scalar kernel's cross products and determinant, three lanes at a time
+                inline bool affine_inverse(float const* m, float* out)
+                {
+                    __m128 c[4];
+                    affine_load(m, c);
+                    auto const Cross = [](__m128 u, __m128 v) {
+                        auto const uYzx = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 0, 2, 1)), uZxy = _mm_shuffle_ps(u, u, _MM_SHUFFLE(3, 1, 0, 2));
+                        auto const vYzx = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 0, 2, 1)), vZxy = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 1, 0, 2));
+                        return _mm_sub_ps(_mm_mul_ps(uYzx, vZxy), _mm_mul_ps(uZxy, vYzx));
+                    };
+                    auto bc = Cross(c[1], c[2]), ca = Cross(c[2], c[0]), ab = Cross(c[0], c[1]);
+                    auto const p = _mm_mul_ps(c[0], bc);
+                    auto const det = _mm_add_ss(_mm_add_ss(p, _mm_shuffle_ps(p, p, _MM_SHUFFLE(1, 1, 1, 1))), _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 2, 2)));
+                    if (_mm_cvtss_f32(det) == 0.0f) {
+                        float const identity[12] = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+                        memcpy(out, identity, sizeof(identity));
+                        return false;
+                    }
+                    auto const rcpDet = _mm_set1_ps(1.0f / _mm_cvtss_f32(det));
+                    auto const t = c[3];
+                    auto w = _mm_setzero_ps();
+                    _MM_TRANSPOSE4_PS(bc, ca, ab, w);
+                    c[0] = _mm_mul_ps(bc, rcpDet);
+                    c[1] = _mm_mul_ps(ca, rcpDet);
+                    c[2] = _mm_mul_ps(ab, rcpDet);
+                    auto sum = _mm_add_ps(_mm_mul_ps(c[0], _mm_shuffle_ps(t, t, 0x00)), _mm_mul_ps(c[1], _mm_shuffle_ps(t, t, 0x55)));
+                    sum = _mm_add_ps(sum, _mm_mul_ps(c[2], _mm_shuffle_ps(t, t, 0xaa)));
+                    c[3] = _mm_sub_ps(_mm_setzero_ps(), sum);
+                    affine_store(out, c);
+                    return true;
+                }
+            }
+#endif
+
+#if defined(MINI_SIMD_AVX2)
+            namespace avx2
+            {
+                // two result columns per register, each 128 bit half broadcasts its own column's elements
+                inline void mat_mul(float const* lhs, float const* rhs, float* out)
+                {
+                    auto const c0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(lhs));
+                    auto const c1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(lhs + 4));
+                    auto const c2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(lhs + 8));
+                    auto const c3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(lhs + 12));
+                    __m256 result[2];
+                    for (auto half = 0; half < 2; ++half) {
+                        auto const r = _mm256_loadu_ps(rhs + half * 8);
+                        auto sum = _mm256_add_ps(_mm256_mul_ps(c0, _mm256_shuffle_ps(r, r, 0x00)), _mm256_mul_ps(c1, _mm256_shuffle_ps(r, r, 0x55)));
+                        sum = _mm256_add_ps(sum, _mm256_mul_ps(c2, _mm256_shuffle_ps(r, r, 0xaa)));
+                        result[half] = _mm256_add_ps(sum, _mm256_mul_ps(c3, _mm256_shuffle_ps(r, r, 0xff)));
+                    }
+                    _mm256_storeu_ps(out, result[0]);
+                    _mm256_storeu_ps(out + 8, result[1]);
+                }
+
+                using sse4::transform_pos;
+                using sse4::quat_to_mat;
+                using sse4::inverse;
+                using sse4::affine_mul;
+                using sse4::affine_inverse_rigid;
+                using sse4::affine_inverse;
+            }
+#endif
+
+#if defined(MINI_SIMD_NEON)
+            namespace neon
+            {
+                // @note vmulq / vaddq rather than vfmaq, fused multiply adds would round differently than the scalar kernels
+                inline void mat_mul(float const* lhs, float const* rhs, float* out)
+                {
+                    auto const c0 = vld1q_f32(lhs), c1 = vld1q_f32(lhs + 4), c2 = vld1q_f32(lhs + 8), c3 = vld1q_f32(lhs + 12);
+                    float32x4_t result[4];
+                    for (auto column = 0; column < 4; ++column) {
+                        auto const r = vld1q_f32(rhs + column * 4);
+                        auto sum = vaddq_f32(vmulq_n_f32(c0, vgetq_lane_f32(r, 0)), vmulq_n_f32(c1, vgetq_lane_f32(r, 1)));
+                        sum = vaddq_f32(sum, vmulq_n_f32(c2, vgetq_lane_f32(r, 2)));
+                        result[column] = vaddq_f32(sum, vmulq_n_f32(c3, vgetq_lane_f32(r, 3)));
+                    }
+                    for (auto column = 0; column < 4; ++column) { vst1q_f32(out + column * 4, result[column]); }
+                }
+
+                inline void transform_pos(float const* m, float const* position, float* out)
+                {
+                    auto sum = vaddq_f32(vmulq_n_f32(vld1q_f32(m), position[0]), vmulq_n_f32(vld1q_f32(m + 4), position[1]));
+                    sum = vaddq_f32(vaddq_f32(sum, vmulq_n_f32(vld1q_f32(m + 8), position[2])), vld1q_f32(m + 12));
+                    float result[4];
+                    vst1q_f32(result, sum);
+                    memcpy(out, result, sizeof(float) * 3);
+                }
+
+                // @note same lane layout as the SSE4 kernel, operands are gathered through memory since NEON has no cheap arbitrary shuffle
+                inline void quat_to_mat(float const* q, float* out)
+                {
+                    auto const w = q[0], x = q[1], y = q[2], z = q[3];
+                    auto const x2 = 2.0f * x, y2 = 2.0f * y, z2 = 2.0f * z;
+                    auto const Column = [](float const* base, float const* a0, float const* a1, float const* signA, float const* b0, float const* b1, float const* signB) {
+                        return vaddq_f32(vaddq_f32(vld1q_f32(base), vmulq_f32(vmulq_f32(vld1q_f32(a0), vld1q_f32(a1)), vld1q_f32(signA))),
+                            vmulq_f32(vmulq_f32(vld1q_f32(b0), vld1q_f32(b1)), vld1q_f32(signB)));
+                    };
+                    float const base0[4] = { 1.0f, 0.0f, 0.0f, 0.0f }, a00[4] = { y2, x2, x2, 0.0f }, a01[4] = { y, y, z, 0.0f }, sa0[4] = { -1.0f, 1.0f, 1.0f, 0.0f };
+                    float const b00[4] = { z2, z2, y2, 0.0f }, b01[4] = { z, w, w, 0.0f }, sb0[4] = { -1.0f, 1.0f, -1.0f, 0.0f };
+                    float const base1[4] = { 0.0f, 1.0f, 0.0f, 0.0f }, a10[4] = { x2, x2, y2, 0.0f }, a11[4] = { y, x, z, 0.0f }, sa1[4] = { 1.0f, -1.0f, 1.0f, 0.0f };
+                    float const b10[4] = { z2, z2, x2, 0.0f }, b11[4] = { w, z, w, 0.0f }, sb1[4] = { -1.0f, -1.0f, 1.0f, 0.0f };
+                    float const base2[4] = { 0.0f, 0.0f, 1.0f, 0.0f }, a20[4] = { x2, y2, x2, 0.0f }, a21[4] = { z, z, x, 0.0f }, sa2[4] = { 1.0f, 1.0f, -1.0f, 0.0f };
+                    float const b20[4] = { y2, x2, y2, 0.0f }, b21[4] = { w, w, y, 0.0f }, sb2[4] = { 1.0f, -1.0f, -1.0f, 0.0f };
+                    float const col3[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+                    vst1q_f32(out, Column(base0, a00, a01, sa0, b00, b01, sb0));
+                    vst1q_f32(out + 4, Column(base1, a10, a11, sa1, b10, b11, sb1));
+                    vst1q_f32(out + 8, Column(base2, a20, a21, sa2, b20, b21, sb2));
+                    vst1q_f32(out + 12, vld1q_f32(col3));
+                }
+
+                // 2x2 helpers for inverse like the SSE4 ones, the shuffles are built from lane dups, vext and vrev64
+                inline float32x4_t mat2_mul(float32x4_t a, float32x4_t b)
+                {
+                    auto const b03 = vset_lane_f32(vgetq_lane_f32(b, 3), vget_low_f32(b), 1);
+                    auto const b21 = vrev64_f32(vget_low_f32(vextq_f32(b, b, 1)));
+                    return vaddq_f32(vmulq_f32(a, vcombine_f32(b03, b03)), vmulq_f32(vrev64q_f32(a), vcombine_f32(b21, b21)));
+                }
+                // adj(a) * b
+                inline float32x4_t mat2_adj_mul(float32x4_t a, float32x4_t b)
+                {
+                    auto const a3300 = vcombine_f32(vdup_lane_f32(vget_high_f32(a), 1), vdup_lane_f32(vget_low_f32(a), 0));
+                    auto const a1122 = vcombine_f32(vdup_lane_f32(vget_low_f32(a), 1), vdup_lane_f32(vget_high_f32(a), 0));
+                    return vsubq_f32(vmulq_f32(a3300, b), vmulq_f32(a1122, vextq_f32(b, b, 2)));
+                }
+                // a * adj(b)
+                inline float32x4_t mat2_mul_adj(float32x4_t a, float32x4_t b)
+                {
+                    auto const b30 = vext_f32(vget_high_f32(b), vget_low_f32(b), 1);
+                    auto const b21 = vrev64_f32(vget_low_f32(vextq_f32(b, b, 1)));
+                    return vsubq_f32(vmulq_f32(a, vcombine_f32(b30, b30)), vmulq_f32(vrev64q_f32(a), vcombine_f32(b21, b21)));
+                }
+
+                // @note    the SSE4 kernel's block wise inversion step for step, so both round the same way
+                inline bool inverse(float const* m, float* out)
+                {
+                    auto const r0 = vld1q_f32(m), r1 = vld1q_f32(m + 4), r2 = vld1q_f32(m + 8), r3 = vld1q_f32(m + 12);
+                    auto const a = vcombine_f32(vget_low_f32(r0), vget_low_f32(r1));
+                    auto const b = vcombine_f32(vget_high_f32(r0), vget_high_f32(r1));
+                    auto const c = vcombine_f32(vget_low_f32(r2), vget_low_f32(r3));
+                    auto const d = vcombine_f32(vget_high_f32(r2), vget_high_f32(r3));
+
+                    // |A| |B| |C| |D|
+                    auto const r02 = vuzpq_f32(r0, r2), r13 = vuzpq_f32(r1, r3);
+                    auto const detSub = vsubq_f32(vmulq_f32(r02.val[0], r13.val[1]), vmulq_f32(r02.val[1], r13.val[0]));
+                    auto const detA = vdupq_n_f32(vgetq_lane_f32(detSub, 0));
+                    auto const detB = vdupq_n_f32(vgetq_lane_f32(detSub, 1));
+                    auto const detC = vdupq_n_f32(vgetq_lane_f32(detSub, 2));
+                    auto const detD = vdupq_n_f32(vgetq_lane_f32(detSub, 3));
+
+                    auto const dc = mat2_adj_mul(d, c);
+                    auto const ab = mat2_adj_mul(a, b);
+                    auto x = vsubq_f32(vmulq_f32(detD, a), mat2_mul(b, dc));
+                    auto w = vsubq_f32(vmulq_f32(detA, d), mat2_mul(c, ab));
+                    auto y = vsubq_f32(vmulq_f32(detB, c), mat2_mul_adj(d, ab));
+                    auto z = vsubq_f32(vmulq_f32(detC, b), mat2_mul_adj(a, dc));
+
+                    // |M| = |A||D| + |B||C| - tr(adj(A) B adj(D) C), the pairwise adds sum in _mm_hadd_ps' order
+                    auto const dcUzp = vuzpq_f32(dc, dc);
+                    auto const tr4 = vmulq_f32(ab, vcombine_f32(vget_low_f32(dcUzp.val[0]), vget_low_f32(dcUzp.val[1])));
+                    auto const tr2 = vpadd_f32(vget_low_f32(tr4), vget_high_f32(tr4));
+                    auto const tr = vdupq_lane_f32(vpadd_f32(tr2, tr2), 0);
+                    auto const detM = vsubq_f32(vaddq_f32(vmulq_f32(detA, detD), vmulq_f32(detB, detC)), tr);
+                    if (vgetq_lane_f32(detM, 0) == 0.0f) {
+                        float const identity[16] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+                        memcpy(out, identity, sizeof(identity));
+                        return false;
+                    }
+
+                    // @note no vdivq on ARMv7, +-1 / |M| is the same either way
+                    float const signs[4] = { 1.0f, -1.0f, -1.0f, 1.0f };
+                    auto const rcpDet = vmulq_n_f32(vld1q_f32(signs), 1.0f / vgetq_lane_f32(detM, 0));
+                    x = vmulq_f32(x, rcpDet);
+                    y = vmulq_f32(y, rcpDet);
+                    z = vmulq_f32(z, rcpDet);
+                    w = vmulq_f32(w, rcpDet);
+
+                    // the odd lanes then the even ones, each pair reversed
+                    auto const xy = vuzpq_f32(x, y), zw = vuzpq_f32(z, w);
+                    vst1q_f32(out, vrev64q_f32(xy.val[1]));
+                    vst1q_f32(out + 4, vrev64q_f32(xy.val[0]));
+                    vst1q_f32(out + 8, vrev64q_f32(zw.val[1]));
+                    vst1q_f32(out + 12, vrev64q_f32(zw.val[0]));
+                    return true;
+                }
+
+                // @note the SSE4 affine loads and stores: three 4 float blocks repacked into columns with vext, the 4th lane is ignored
+                inline void affine_load(float const* m, float32x4_t* columns)
+                {
+                    auto const v0 = vld1q_f32(m);
+                    auto const v1 = vld1q_f32(m + 4);
+                    auto const v2 = vld1q_f32(m + 8);
+                    columns[0] = v0;
+                    columns[1] = vextq_f32(v0, v1, 3);
+                    columns[2] = vextq_f32(v1, v2, 2);
+                    columns[3] = vextq_f32(v2, v2, 1);
+                }
+
+                inline void affine_store(float* m, float32x4_t const* columns)
+                {
+                    auto const v0 = vextq_f32(vextq_f32(columns[0], columns[0], 3), columns[1], 1);
+                    auto const v1 = vcombine_f32(vget_low_f32(vextq_f32(columns[1], columns[1], 1)), vget_low_f32(columns[2]));
+                    auto const v2 = vextq_f32(vextq_f32(columns[2], columns[2], 3), columns[3], 3);
+                    vst1q_f32(m, v0);
+                    vst1q_f32(m + 4, v1);
+                    vst1q_f32(m + 8, v2);
+                }
+
+                inline void transpose(float32x4_t* rows)
+                {
+                    auto const t01 = vtrnq_f32(rows[0], rows[1]), t23 = vtrnq_f32(rows[2], rows[3]);
+                    rows[0] = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+                    rows[1] = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+                    rows[2] = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+                    rows[3] = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+                }
+
+                // -(c0 t.x + c1 t.y + c2 t.z), subtracted from 0 like the SSE4 kernels
+                inline float32x4_t affine_rotate_back(float32x4_t const* c, float32x4_t t)
+                {
+                    auto sum = vaddq_f32(vmulq_n_f32(c[0], vgetq_lane_f32(t, 0)), vmulq_n_f32(c[1], vgetq_lane_f32(t, 1)));
+                    sum = vaddq_f32(sum, vmulq_n_f32(c[2], vgetq_lane_f32(t, 2)));
+                    return vsubq_f32(vdupq_n_f32(0.0f), sum);
+                }
+
+                inline void affine_mul(float const* lhs, float const* rhs, float* out)
+                {
+                    float32x4_t c[4];
+                    affine_load(lhs, c);
+                    auto const Column = [&](float const* r) {
+                        return vaddq_f32(vaddq_f32(vmulq_n_f32(c[0], r[0]), vmulq_n_f32(c[1], r[1])), vmulq_n_f32(c[2], r[2]));
+                    };
+                    float32x4_t const result[4] = { Column(rhs), Column(rhs + 3), Column(rhs + 6), vaddq_f32(Column(rhs + 9), c[3]) };
+                    affine_store(out, result);
+                }
+
+                inline void affine_inverse_rigid(float const* m, float* out)
+                {
+                    float32x4_t c[4];
+                    affine_load(m, c);
+                    auto const t = c[3];
+                    c[3] = vdupq_n_f32(0.0f);
+                    transpose(c);
+                    c[3] = affine_rotate_back(c, t);
+                    affine_store(out, c);
+                }
+
+                // the scalar kernel's cross products and determinant, three lanes at a time
+                inline bool affine_inverse(float const* m, float* out)
+                {
+                    float32x4_t c[4];
+                    affine_load(m, c);
+                    // (y, z, x, y), applied twice (z, x, y, z)
+                    auto const Yzx = [](float32x4_t u) { return vcombine_f32(vget_low_f32(vextq_f32(u, u, 1)), vget_low_f32(u)); };
+                    auto const Cross = [&](float32x4_t u, float32x4_t v) {
+                        auto const uYzx = Yzx(u), vYzx = Yzx(v);
+                        return vsubq_f32(vmulq_f32(uYzx, Yzx(vYzx)), vmulq_f32(Yzx(uYzx), vYzx));
+                    };
+                    float32x4_t adjugate[4] = { Cross(c[1], c[2]), Cross(c[2], c[0]), Cross(c[0], c[1]), vdupq_n_f32(0.0f) };
+                    auto const p = vmulq_f32(c[0], adjugate[0]);
+                    auto const det = (vgetq_lane_f32(p, 0) + vgetq_lane_f32(p, 1)) + vgetq_lane_f32(p, 2);
+                    if (det == 0.0f) {
+                        float const identity[12] = { 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f };
+                        memcpy(out, identity, sizeof(identity));
+                        return false;
+                    }
+                    auto const rcpDet = 1.0f / det;
+                    auto const t = c[3];
+                    transpose(adjugate);
+                    for (auto column = 0; column < 3; ++column) { c[column] = vmulq_n_f32(adjugate[column], rcpDet); }
+                    c[3] = affine_rotate_back(c, t);
+                    affine_store(out, c);
+                    return true;
+                }
+            }
+#endif
+
+#if defined(MINI_SIMD_AVX2)
+            namespace selected = avx2;
+#elif defined(MINI_SIMD_SSE4)
+            namespace selected = sse4;
+#elif defined(MINI_SIMD_NEON)
+            namespace selected = neon;
+#else
+            namespace selected = scalar;
+#endif
+        }
+    }
+}
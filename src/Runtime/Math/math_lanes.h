@@ -0,0 +1,420 @@
+#pragma once
+#include "math_functions.h"
+#include "math_simd.h"
+
+#include <EASTL/type_traits.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+    *   SIMD lane abstraction shared by the stream kernels in math_batch.cpp and math_packing.cpp. Not part of the public math
+    *   API: VectorLanes is the widest instruction set compiled in (8 lanes for AVX2, 4 for SSE4 and NEON), ScalarLanes the same
+    *   operations on one float for the tails and the scalar build. Masks come from the comparisons and feed Select / MoveMask,
+    *   itype holds 32 bit integer lanes for bit manipulation and the narrow integer loads and stores.
+*/
+namespace mini
+{
+    namespace math
+    {
+        namespace lanes
+        {
+            // @note    the element kernels are written once against these overloads, instantiated with the widest vector type for the
+            //          bulk and with float for the tail, so both evaluate the same expressions in the same order
+            struct ScalarLanes
+            {
+                using type = float;
+                using mask = bool;
+                static constexpr uint32_t count = 1;
+
+                static float Load(float const* p) { return *p; }
+                static float Set(float v) { return v; }
+                static void Store(float* p, float v) { *p = v; }
+                static float Add(float a, float b) { return a + b; }
+                static float Sub(float a, float b) { return a - b; }
+                static float Mul(float a, float b) { return a * b; }
+                static bool Less(float a, float b) { return a < b; }
+                static bool Or(bool a, bool b) { return a || b; }
+                static bool None() { return false; }
+                static uint32_t MoveMask(bool m) { return m ? 1u : 0u; }
+
+                // for the fast_ functions: divides, selects and int32 lanes for exponent bits, see math_functions.h
+                using itype = int32_t;
+                static float Div(float a, float b) { return a / b; }
+                static float Min(float a, float b) { return a < b ? a : b; }
+                static float Max(float a, float b) { return a > b ? a : b; }
+                static float Abs(float a) { return fabsf(a); }
+                static float Neg(float a) { return -a; }
+                static float Rsqrt(float a) { return mini::math::fast_rsqrt(a); }
+                static bool Greater(float a, float b) { return a > b; }
+                static float Select(bool m, float a, float b) { return m ? a : b; }
+                static int32_t ISet(int32_t v) { return v; }
+                static int32_t IAdd(int32_t a, int32_t b) { return a + b; }
+                static int32_t IAnd(int32_t a, int32_t b) { return a & b; }
+                static int32_t IOr(int32_t a, int32_t b) { return a | b; }
+                template <int N> static int32_t ShiftLeft(int32_t a) { return static_cast<int32_t>(static_cast<uint32_t>(a) << N); }
+                template <int N> static int32_t ShiftRight(int32_t a) { return static_cast<int32_t>(static_cast<uint32_t>(a) >> N); }
+                template <int N> static int32_t ShiftRightArith(int32_t a) { return a >> N; }
+                static bool TestBit(int32_t a, int32_t bit) { return (a & bit) != 0; }
+                static int32_t ToInt(float a) { return static_cast<int32_t>(a); }       // truncates
+                static int32_t RoundToInt(float a) { return static_cast<int32_t>(lrintf(a)); }     // to nearest even
+                static float ToFloat(int32_t a) { return static_cast<float>(a); }
+                static int32_t AsInt(float a) { int32_t i; memcpy(&i, &a, sizeof(i)); return i; }
+                static float AsFloat(int32_t a) { float f; memcpy(&f, &a, sizeof(f)); return f; }
+
+                // for the packed formats in math_packing.h: +-1 from the sign bit, and T lanes widened to / narrowed from itype.
+                // values stored have to fit T
+                static float SignOf(float a) { return copysignf(1.0f, a); }
+                static float Sqrt(float a) { return sqrtf(a); }
+                template <class T> static int32_t LoadInts(T const* p) { return static_cast<int32_t>(*p); }
+                template <class T> static void StoreInts(T* p, int32_t a) { *p = static_cast<T>(a); }
+                static bool IGreater(int32_t a, int32_t b) { return a > b; }
+                static int32_t ISelect(bool m, int32_t a, int32_t b) { return m ? a : b; }
+
+                // out[0..3] = a, b, c, d. Stride is how far apart the lanes' outputs are, 16 for a mat4x4f_t's column
+                template <uint32_t Stride = 16>
+                static void StoreColumn(float* out, float a, float b, float c, float d)
+                {
+                    out[0] = a;
+                    out[1] = b;
+                    out[2] = c;
+                    out[3] = d;
+                }
+
+                // out[0..2] = a, b, c
+                static void StoreColumn3(float* out, float a, float b, float c)
+                {
+                    out[0] = a;
+                    out[1] = b;
+                    out[2] = c;
+                }
+            };
+
+#if defined(MINI_SIMD_AVX2)
+            struct VectorLanes
+            {
+                using type = __m256;
+                using mask = __m256;
+                static constexpr uint32_t count = 8;
+
+                static __m256 Load(float const* p) { return _mm256_loadu_ps(p); }
+                static __m256 Set(float v) { return _mm256_set1_ps(v); }
+                static void Store(float* p, __m256 v) { _mm256_storeu_ps(p, v); }
+                static __m256 Add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+                static __m256 Sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+                static __m256 Mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+                static __m256 Less(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+                static __m256 Or(__m256 a, __m256 b) { return _mm256_or_ps(a, b); }
+                static __m256 None() { return _mm256_setzero_ps(); }
+                static uint32_t MoveMask(__m256 m) { return static_cast<uint32_t>(_mm256_movemask_ps(m)); }
+
+                using itype = __m256i;
+                static __m256 Div(__m256 a, __m256 b) { return _mm256_div_ps(a, b); }
+                static __m256 Min(__m256 a, __m256 b) { return _mm256_min_ps(a, b); }
+                static __m256 Max(__m256 a, __m256 b) { return _mm256_max_ps(a, b); }
+                static __m256 Abs(__m256 a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+                static __m256 Neg(__m256 a) { return _mm256_xor_ps(_mm256_set1_ps(-0.0f), a); }
+                static __m256 Rsqrt(__m256 a)
+                {
+                    auto const y = _mm256_rsqrt_ps(a);
+                    auto const halfA = _mm256_mul_ps(_mm256_set1_ps(0.5f), a);
+                    return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(halfA, y), y)));
+                }
+                static __m256 Greater(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+                static __m256 Select(__m256 m, __m256 a, __m256 b) { return _mm256_blendv_ps(b, a, m); }
+                static __m256i ISet(int32_t v) { return _mm256_set1_epi32(v); }
+                static __m256i IAdd(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+                static __m256i IAnd(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+                static __m256i IOr(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+                template <int N> static __m256i ShiftLeft(__m256i a) { return _mm256_slli_epi32(a, N); }
+                template <int N> static __m256i ShiftRight(__m256i a) { return _mm256_srli_epi32(a, N); }
+                template <int N> static __m256i ShiftRightArith(__m256i a) { return _mm256_srai_epi32(a, N); }
+                static __m256 TestBit(__m256i a, int32_t bit)
+                {
+                    auto const b = _mm256_set1_epi32(bit);
+                    return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(a, b), b));
+                }
+                static __m256i ToInt(__m256 a) { return _mm256_cvttps_epi32(a); }
+                static __m256i RoundToInt(__m256 a) { return _mm256_cvtps_epi32(a); }
+                static __m256 ToFloat(__m256i a) { return _mm256_cvtepi32_ps(a); }
+                static __m256i AsInt(__m256 a) { return _mm256_castps_si256(a); }
+                static __m256 AsFloat(__m256i a) { return _mm256_castsi256_ps(a); }
+
+                static __m256 SignOf(__m256 a) { return _mm256_or_ps(_mm256_and_ps(a, _mm256_set1_ps(-0.0f)), _mm256_set1_ps(1.0f)); }
+                static __m256 Sqrt(__m256 a) { return _mm256_sqrt_ps(a); }
+                static __m256 IGreater(__m256i a, __m256i b) { return _mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b)); }
+                static __m256i ISelect(__m256 m, __m256i a, __m256i b) { return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b), _mm256_castsi256_ps(a), m)); }
+                template <class T> static __m256i LoadInts(T const* p)
+                {
+                    if constexpr (sizeof(T) == 4) { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)); }
+                    else if constexpr (sizeof(T) == 2) {
+                        auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+                        return eastl::is_signed<T>::value ? _mm256_cvtepi16_epi32(v) : _mm256_cvtepu16_epi32(v);
+                    }
+                    else {
+                        auto const v = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(p));
+                        return eastl::is_signed<T>::value ? _mm256_cvtepi8_epi32(v) : _mm256_cvtepu8_epi32(v);
+                    }
+                }
+                // @note the packs work per 128 bit half, the permute brings both halves' results together
+                template <class T> static void StoreInts(T* p, __m256i a)
+                {
+                    if constexpr (sizeof(T) == 4) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a); }
+                    else {
+                        auto narrow = eastl::is_signed<T>::value ? _mm256_packs_epi32(a, a) : _mm256_packus_epi32(a, a);
+                        if constexpr (sizeof(T) == 1) { narrow = eastl::is_signed<T>::value ? _mm256_packs_epi16(narrow, narrow) : _mm256_packus_epi16(narrow, narrow); }
+                        narrow = _mm256_permutevar8x32_epi32(narrow, sizeof(T) == 2 ? _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7) : _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+                        if constexpr (sizeof(T) == 2) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(narrow)); }
+                        else { _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(narrow)); }
+                    }
+                }
+
+                // lane i of a, b, c, d goes to out[i * Stride + 0..3], a 4x4 transpose in each 128 bit half
+                template <uint32_t Stride = 16>
+                static void StoreColumn(float* out, __m256 a, __m256 b, __m256 c, __m256 d)
+                {
+                    auto const ab0 = _mm256_unpacklo_ps(a, b), ab1 = _mm256_unpackhi_ps(a, b);
+                    auto const cd0 = _mm256_unpacklo_ps(c, d), cd1 = _mm256_unpackhi_ps(c, d);
+                    __m256 const rows[4] = {
+                        _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(1, 0, 1, 0)), _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(3, 2, 3, 2)),
+                        _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(1, 0, 1, 0)), _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(3, 2, 3, 2)) };
+                    for (auto i = 0; i < 4; ++i) {
+                        _mm_storeu_ps(out + i * Stride, _mm256_castps256_ps128(rows[i]));
+                        _mm_storeu_ps(out + (i + 4) * Stride, _mm256_extractf128_ps(rows[i], 1));
+                    }
+                }
+
+                // lane i of a, b, c goes to out[i * 12 + 0..2], two stores each so nothing past the last matrix is written
+                static void StoreColumn3(float* out, __m256 a, __m256 b, __m256 c)
+                {
+                    auto const d = _mm256_setzero_ps();
+                    auto const ab0 = _mm256_unpacklo_ps(a, b), ab1 = _mm256_unpackhi_ps(a, b);
+                    auto const cd0 = _mm256_unpacklo_ps(c, d), cd1 = _mm256_unpackhi_ps(c, d);
+                    __m256 const rows[4] = {
+                        _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(1, 0, 1, 0)), _mm256_shuffle_ps(ab0, cd0, _MM_SHUFFLE(3, 2, 3, 2)),
+                        _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(1, 0, 1, 0)), _mm256_shuffle_ps(ab1, cd1, _MM_SHUFFLE(3, 2, 3, 2)) };
+                    for (auto i = 0; i < 4; ++i) {
+                        auto const lo = _mm256_castps256_ps128(rows[i]), hi = _mm256_extractf128_ps(rows[i], 1);
+                        _mm_storel_pi(reinterpret_cast<__m64*>(out + i * 12), lo);
+                        _mm_store_ss(out + i * 12 + 2, _mm_movehl_ps(lo, lo));
+                        _mm_storel_pi(reinterpret_cast<__m64*>(out + (i + 4) * 12), hi);
+                        _mm_store_ss(out + (i + 4) * 12 + 2, _mm_movehl_ps(hi, hi));
+                    }
+                }
+            };
+#elif defined(MINI_SIMD_SSE4)
+            struct VectorLanes
+            {
+                using type = __m128;
+                using mask = __m128;
+                static constexpr uint32_t count = 4;
+
+                static __m128 Load(float const* p) { return _mm_loadu_ps(p); }
+                static __m128 Set(float v) { return _mm_set1_ps(v); }
+                static void Store(float* p, __m128 v) { _mm_storeu_ps(p, v); }
+                static __m128 Add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+                static __m128 Sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+                static __m128 Mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+                static __m128 Less(__m128 a, __m128 b) { return _mm_cmplt_ps(a, b); }
+                static __m128 Or(__m128 a, __m128 b) { return _mm_or_ps(a, b); }
+                static __m128 None() { return _mm_setzero_ps(); }
+                static uint32_t MoveMask(__m128 m) { return static_cast<uint32_t>(_mm_movemask_ps(m)); }
+
+                using itype = __m128i;
+                static __m128 Div(__m128 a, __m128 b) { return _mm_div_ps(a, b); }
+                static __m128 Min(__m128 a, __m128 b) { return _mm_min_ps(a, b); }
+                static __m128 Max(__m128 a, __m128 b) { return _mm_max_ps(a, b); }
+                static __m128 Abs(__m128 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+                static __m128 Neg(__m128 a) { return _mm_xor_ps(_mm_set1_ps(-0.0f), a); }
+                static __m128 Rsqrt(__m128 a)
+                {
+                    auto const y = _mm_rsqrt_ps(a);
+                    auto const halfA = _mm_mul_ps(_mm_set1_ps(0.5f), a);
+                    return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(halfA, y), y)));
+                }
+                static __m128 Greater(__m128 a, __m128 b) { return _mm_cmpgt_ps(a, b); }
+                static __m128 Select(__m128 m, __m128 a, __m128 b) { return _mm_blendv_ps(b, a, m); }
+                static __m128i ISet(int32_t v) { return _mm_set1_epi32(v); }
+                static __m128i IAdd(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+                static __m128i IAnd(__m128i a, __m128i b) { return _mm_and_si128(a, b); }
+                static __m128i IOr(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+                template <int N> static __m128i ShiftLeft(__m128i a) { return _mm_slli_epi32(a, N); }
+                template <int N> static __m128i ShiftRight(__m128i a) { return _mm_srli_epi32(a, N); }
+                template <int N> static __m128i ShiftRightArith(__m128i a) { return _mm_srai_epi32(a, N); }
+                static __m128 TestBit(__m128i a, int32_t bit)
+                {
+                    auto const b = _mm_set1_epi32(bit);
+                    return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(a, b), b));
+                }
+                static __m128i ToInt(__m128 a) { return _mm_cvttps_epi32(a); }
+                static __m128i RoundToInt(__m128 a) { return _mm_cvtps_epi32(a); }
+                static __m128 ToFloat(__m128i a) { return _mm_cvtepi32_ps(a); }
+                static __m128i AsInt(__m128 a) { return _mm_castps_si128(a); }
+                static __m128 AsFloat(__m128i a) { return _mm_castsi128_ps(a); }
+
+                static __m128 SignOf(__m128 a) { return _mm_or_ps(_mm_and_ps(a, _mm_set1_ps(-0.0f)), _mm_set1_ps(1.0f)); }
+                static __m128 Sqrt(__m128 a) { return _mm_sqrt_ps(a); }
+                static __m128 IGreater(__m128i a, __m128i b) { return _mm_castsi128_ps(_mm_cmpgt_epi32(a, b)); }
+                static __m128i ISelect(__m128 m, __m128i a, __m128i b) { return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(b), _mm_castsi128_ps(a), m)); }
+                template <class T> static __m128i LoadInts(T const* p)
+                {
+                    if constexpr (sizeof(T) == 4) { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)); }
+                    else if constexpr (sizeof(T) == 2) {
+                        auto const v = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(p));
+                        return eastl::is_signed<T>::value ? _mm_cvtepi16_epi32(v) : _mm_cvtepu16_epi32(v);
+                    }
+                    else {
+                        int32_t bytes;
+                        memcpy(&bytes, p, sizeof(bytes));
+                        auto const v = _mm_cvtsi32_si128(bytes);
+                        return eastl::is_signed<T>::value ? _mm_cvtepi8_epi32(v) : _mm_cvtepu8_epi32(v);
+                    }
+                }
+                template <class T> static void StoreInts(T* p, __m128i a)
+                {
+                    if constexpr (sizeof(T) == 4) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a); }
+                    else {
+                        auto narrow = eastl::is_signed<T>::value ? _mm_packs_epi32(a, a) : _mm_packus_epi32(a, a);
+                        if constexpr (sizeof(T) == 2) { _mm_storel_epi64(reinterpret_cast<__m128i*>(p), narrow); }
+                        else {
+                            narrow = eastl::is_signed<T>::value ? _mm_packs_epi16(narrow, narrow) : _mm_packus_epi16(narrow, narrow);
+                            auto const bytes = _mm_cvtsi128_si32(narrow);
+                            memcpy(p, &bytes, sizeof(bytes));
+                        }
+                    }
+                }
+
+                template <uint32_t Stride = 16>
+                static void StoreColumn(float* out, __m128 a, __m128 b, __m128 c, __m128 d)
+                {
+                    _MM_TRANSPOSE4_PS(a, b, c, d);
+                    _mm_storeu_ps(out, a);
+                    _mm_storeu_ps(out + Stride, b);
+                    _mm_storeu_ps(out + Stride * 2, c);
+                    _mm_storeu_ps(out + Stride * 3, d);
+                }
+
+                static void StoreColumn3(float* out, __m128 a, __m128 b, __m128 c)
+                {
+                    auto d = _mm_setzero_ps();
+                    _MM_TRANSPOSE4_PS(a, b, c, d);
+                    __m128 const rows[4] = { a, b, c, d };
+                    for (auto i = 0; i < 4; ++i) {
+                        _mm_storel_pi(reinterpret_cast<__m64*>(out + i * 12), rows[i]);
+                        _mm_store_ss(out + i * 12 + 2, _mm_movehl_ps(rows[i], rows[i]));
+                    }
+                }
+            };
+#elif defined(MINI_SIMD_NEON)
+            struct VectorLanes
+            {
+                using type = float32x4_t;
+                using mask = uint32x4_t;
+                static constexpr uint32_t count = 4;
+
+                static float32x4_t Load(float const* p) { return vld1q_f32(p); }
+                static float32x4_t Set(float v) { return vdupq_n_f32(v); }
+                static void Store(float* p, float32x4_t v) { vst1q_f32(p, v); }
+                static float32x4_t Add(float32x4_t a, float32x4_t b) { return vaddq_f32(a, b); }
+                static float32x4_t Sub(float32x4_t a, float32x4_t b) { return vsubq_f32(a, b); }
+                static float32x4_t Mul(float32x4_t a, float32x4_t b) { return vmulq_f32(a, b); }   // @note no vfmaq, see math_kernels.h
+                static uint32x4_t Less(float32x4_t a, float32x4_t b) { return vcltq_f32(a, b); }
+                static uint32x4_t Or(uint32x4_t a, uint32x4_t b) { return vorrq_u32(a, b); }
+                static uint32x4_t None() { return vdupq_n_u32(0); }
+                static uint32_t MoveMask(uint32x4_t m)
+                {
+                    uint32_t const bits[4] = { 1, 2, 4, 8 };
+                    return vaddvq_u32(vandq_u32(m, vld1q_u32(bits)));
+                }
+
+                using itype = int32x4_t;
+                static float32x4_t Div(float32x4_t a, float32x4_t b) { return vdivq_f32(a, b); }
+                static float32x4_t Min(float32x4_t a, float32x4_t b) { return vbslq_f32(vcltq_f32(a, b), a, b); }     // @note vminq differs for NaN
+                static float32x4_t Max(float32x4_t a, float32x4_t b) { return vbslq_f32(vcgtq_f32(a, b), a, b); }
+                static float32x4_t Abs(float32x4_t a) { return vabsq_f32(a); }
+                static float32x4_t Neg(float32x4_t a) { return vnegq_f32(a); }
+                static float32x4_t Rsqrt(float32x4_t a)
+                {
+                    auto y = vrsqrteq_f32(a);
+                    auto const halfA = vmulq_f32(vdupq_n_f32(0.5f), a);
+                    y = vmulq_f32(y, vsubq_f32(vdupq_n_f32(1.5f), vmulq_f32(vmulq_f32(halfA, y), y)));
+                    return vmulq_f32(y, vsubq_f32(vdupq_n_f32(1.5f), vmulq_f32(vmulq_f32(halfA, y), y)));
+                }
+                static uint32x4_t Greater(float32x4_t a, float32x4_t b) { return vcgtq_f32(a, b); }
+                static float32x4_t Select(uint32x4_t m, float32x4_t a, float32x4_t b) { return vbslq_f32(m, a, b); }
+                static int32x4_t ISet(int32_t v) { return vdupq_n_s32(v); }
+                static int32x4_t IAdd(int32x4_t a, int32x4_t b) { return vaddq_s32(a, b); }
+                static int32x4_t IAnd(int32x4_t a, int32x4_t b) { return vandq_s32(a, b); }
+                static int32x4_t IOr(int32x4_t a, int32x4_t b) { return vorrq_s32(a, b); }
+                template <int N> static int32x4_t ShiftLeft(int32x4_t a) { return vshlq_n_s32(a, N); }
+                template <int N> static int32x4_t ShiftRight(int32x4_t a) { return vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(a), N)); }
+                template <int N> static int32x4_t ShiftRightArith(int32x4_t a) { return vshrq_n_s32(a, N); }
+                static uint32x4_t TestBit(int32x4_t a, int32_t bit) { return vtstq_s32(a, vdupq_n_s32(bit)); }
+                static int32x4_t ToInt(float32x4_t a) { return vcvtq_s32_f32(a); }
+                static int32x4_t RoundToInt(float32x4_t a) { return vcvtnq_s32_f32(a); }
+                static float32x4_t ToFloat(int32x4_t a) { return vcvtq_f32_s32(a); }
+                static int32x4_t AsInt(float32x4_t a) { return vreinterpretq_s32_f32(a); }
+                static float32x4_t AsFloat(int32x4_t a) { return vreinterpretq_f32_s32(a); }
+
+                static float32x4_t SignOf(float32x4_t a)
+                {
+                    return vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(a), vdupq_n_u32(0x80000000u)), vreinterpretq_u32_f32(vdupq_n_f32(1.0f))));
+                }
+                static float32x4_t Sqrt(float32x4_t a) { return vsqrtq_f32(a); }
+                static uint32x4_t IGreater(int32x4_t a, int32x4_t b) { return vcgtq_s32(a, b); }
+                static int32x4_t ISelect(uint32x4_t m, int32x4_t a, int32x4_t b) { return vbslq_s32(m, a, b); }
+                template <class T> static int32x4_t LoadInts(T const* p)
+                {
+                    if constexpr (sizeof(T) == 4) { return vld1q_s32(reinterpret_cast<int32_t const*>(p)); }
+                    else if constexpr (sizeof(T) == 2) {
+                        if constexpr (eastl::is_signed<T>::value) { return vmovl_s16(vld1_s16(reinterpret_cast<int16_t const*>(p))); }
+                        else { return vreinterpretq_s32_u32(vmovl_u16(vld1_u16(reinterpret_cast<uint16_t const*>(p)))); }
+                    }
+                    else {
+                        uint32_t bytes;
+                        memcpy(&bytes, p, sizeof(bytes));
+                        auto const v = vreinterpret_u8_u32(vdup_n_u32(bytes));
+                        if constexpr (eastl::is_signed<T>::value) { return vmovl_s16(vget_low_s16(vmovl_s8(vreinterpret_s8_u8(v)))); }
+                        else { return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(vmovl_u8(v)))); }
+                    }
+                }
+                template <class T> static void StoreInts(T* p, int32x4_t a)
+                {
+                    if constexpr (sizeof(T) == 4) { vst1q_s32(reinterpret_cast<int32_t*>(p), a); }
+                    else if constexpr (sizeof(T) == 2) { vst1_s16(reinterpret_cast<int16_t*>(p), vmovn_s32(a)); }
+                    else {
+                        auto const narrow = vmovn_s16(vcombine_s16(vmovn_s32(a), vmovn_s32(a)));
+                        vst1_lane_u32(reinterpret_cast<uint32_t*>(p), vreinterpret_u32_s8(narrow), 0);     // @note p may be unaligned, see StoreColumn3
+                    }
+                }
+
+                template <uint32_t Stride = 16>
+                static void StoreColumn(float* out, float32x4_t a, float32x4_t b, float32x4_t c, float32x4_t d)
+                {
+                    auto const ab = vtrnq_f32(a, b);
+                    auto const cd = vtrnq_f32(c, d);
+                    vst1q_f32(out, vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0])));
+                    vst1q_f32(out + Stride, vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1])));
+                    vst1q_f32(out + Stride * 2, vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0])));
+                    vst1q_f32(out + Stride * 3, vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1])));
+                }
+
+                static void StoreColumn3(float* out, float32x4_t a, float32x4_t b, float32x4_t c)
+                {
+                    auto const ab = vtrnq_f32(a, b);
+                    auto const cd = vtrnq_f32(c, vdupq_n_f32(0.0f));
+                    float32x4_t const rows[4] = {
+                        vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0])), vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1])),
+                        vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0])), vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1])) };
+                    for (auto i = 0; i < 4; ++i) {
+                        vst1_f32(out + i * 12, vget_low_f32(rows[i]));
+                        vst1q_lane_f32(out + i * 12 + 2, rows[i], 2);
+                    }
+                }
+            };
+#else
+            using VectorLanes = ScalarLanes;
+#endif
+        }
+    }
+}
@@ -0,0 +1,278 @@
+#include "math_packing.h"
+#include "math_lanes.h"
+
+#include <math.h>
+#include <string.h>
+
+namespace
+{
+    using mini::math::lanes::ScalarLanes;
+    using mini::math::lanes::VectorLanes;
+
+    // clamp to [0, 1] or [-1, 1] with NaN going to 0, like pack_unorm / pack_snorm. for snorm the two halves are clamped
+    // separately and added, min and max return their second operand for NaN so both halves are 0
+    template <class L, bool Signed>
+    typename L::itype PackNorm(typename L::type v, float scale)
+    {
+        auto c = L::Min(L::Max(v, L::Set(0.0f)), L::Set(1.0f));
+        if (Signed) { c = L::Add(c, L::Max(L::Min(v, L::Set(0.0f)), L::Set(-1.0f))); }
+        return L::RoundToInt(L::Mul(c, L::Set(scale)));
+    }
+
+    template <class L, bool Signed>
+    typename L::type UnpackNorm(typename L::itype q, float scale)
+    {
+        auto const v = L::Div(L::ToFloat(q), L::Set(scale));
+        return Signed ? L::Max(v, L::Set(-1.0f)) : v;
+    }
+
+    template <class T, uint32_t Bits>
+    void PackNormStream(float const* v, T* out, uint32_t count)
+    {
+        constexpr auto isSigned = eastl::is_signed<T>::value;
+        constexpr auto scale = static_cast<float>((1u << (isSigned ? Bits - 1 : Bits)) - 1);
+        auto i = 0u;
+        for (; i + VectorLanes::count <= count; i += VectorLanes::count) {
+            VectorLanes::StoreInts(out + i, PackNorm<VectorLanes, isSigned>(VectorLanes::Load(v + i), scale));
+        }
+        for (; i < count; ++i) { out[i] = static_cast<T>(isSigned ? mini::math::pack_snorm(v[i], Bits) : mini::math::pack_unorm(v[i], Bits)); }
+    }
+
+    template <class T, uint32_t Bits>
+    void UnpackNormStream(T const* q, float* out, uint32_t count)
+    {
+        constexpr auto isSigned = eastl::is_signed<T>::value;
+        constexpr auto scale = static_cast<float>((1u << (isSigned ? Bits - 1 : Bits)) - 1);
+        auto i = 0u;
+        for (; i + VectorLanes::count <= count; i += VectorLanes::count) {
+            VectorLanes::Store(out + i, UnpackNorm<VectorLanes, isSigned>(VectorLanes::LoadInts(q + i), scale));
+        }
+        for (; i < count; ++i) { out[i] = isSigned ? mini::math::unpack_snorm(q[i], Bits) : mini::math::unpack_unorm(q[i], Bits); }
+    }
+
+    // -----------------------------------------------------------
+
+    // float_to_half's three cases computed for every lane and selected, for the builds without hardware conversions
+    template <class L>
+    typename L::itype FloatToHalf(typename L::type v)
+    {
+        constexpr int32_t denormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+        constexpr auto rebias = static_cast<int32_t>((static_cast<uint32_t>(15 - 127) << 23) + 0xfff);
+        auto const bits = L::AsInt(v);
+        auto const sign = L::IAnd(bits, L::ISet(static_cast<int32_t>(0x80000000u)));
+        auto const x = L::IAnd(bits, L::ISet(0x7fffffff));
+
+        auto const mantissaOdd = L::IAnd(L::template ShiftRight<13>(x), L::ISet(1));
+        auto const normal = L::template ShiftRight<13>(L::IAdd(L::IAdd(x, L::ISet(rebias)), mantissaOdd));
+        auto const denormal = L::IAdd(L::AsInt(L::Add(L::AsFloat(x), L::AsFloat(L::ISet(denormMagic)))), L::ISet(-denormMagic));
+        auto const overflow = L::ISelect(L::IGreater(x, L::ISet(255 << 23)), L::ISet(0x7e00), L::ISet(0x7c00));
+
+        auto result = L::ISelect(L::IGreater(L::ISet(113 << 23), x), denormal, normal);
+        result = L::ISelect(L::IGreater(x, L::ISet((143 << 23) - 1)), overflow, result);
+        return L::IOr(result, L::template ShiftRight<16>(sign));
+    }
+
+    template <class L>
+    typename L::type HalfToFloat(typename L::itype h)
+    {
+        auto const exponent = L::IAnd(h, L::ISet(0x7c00));
+        auto const mantissa = L::IAnd(h, L::ISet(0x3ff));
+        auto const normal = L::IAdd(L::template ShiftLeft<13>(L::IAnd(h, L::ISet(0x7fff))), L::ISet(112 << 23));
+        auto const infNaN = L::IOr(L::ISet(0x7f800000), L::template ShiftLeft<13>(mantissa));
+        auto const denormal = L::AsInt(L::Mul(L::ToFloat(mantissa), L::Set(1.0f / 16777216.0f)));
+
+        auto result = L::ISelect(L::IGreater(L::ISet(0x0400), exponent), denormal, normal);
+        result = L::ISelect(L::IGreater(exponent, L::ISet(0x7bff)), infNaN, result);
+        return L::AsFloat(L::IOr(result, L::template ShiftLeft<16>(L::IAnd(h, L::ISet(0x8000)))));
+    }
+
+    // -----------------------------------------------------------
+
+    // same steps as pack_octahedral / unpack_octahedral
+    template <class L>
+    typename L::itype PackOctahedral(typename L::type x, typename L::type y, typename L::type z)
+    {
+        auto const one = L::Set(1.0f);
+        auto const l1 = L::Max(L::Add(L::Add(L::Abs(x), L::Abs(y)), L::Abs(z)), L::Set(1e-20f));
+        auto const invL1 = L::Div(one, l1);
+        auto px = L::Mul(x, invL1);
+        auto py = L::Mul(y, invL1);
+
+        auto const wrapX = L::Mul(L::Sub(one, L::Abs(py)), L::SignOf(px));
+        auto const wrapY = L::Mul(L::Sub(one, L::Abs(px)), L::SignOf(py));
+        auto const lowerHemisphere = L::Less(z, L::Set(0.0f));
+        px = L::Select(lowerHemisphere, wrapX, px);
+        py = L::Select(lowerHemisphere, wrapY, py);
+
+        auto const qx = PackNorm<L, true>(px, 32767.0f);
+        auto const qy = PackNorm<L, true>(py, 32767.0f);
+        return L::IOr(L::IAnd(qx, L::ISet(0xffff)), L::template ShiftLeft<16>(qy));
+    }
+
+    template <class L>
+    void UnpackOctahedral(typename L::itype packed, typename L::type* out)
+    {
+        auto x = UnpackNorm<L, true>(L::template ShiftRightArith<16>(L::template ShiftLeft<16>(packed)), 32767.0f);
+        auto y = UnpackNorm<L, true>(L::template ShiftRightArith<16>(packed), 32767.0f);
+        auto const zero = L::Set(0.0f);
+        auto const z = L::Sub(L::Sub(L::Set(1.0f), L::Abs(x)), L::Abs(y));
+        auto const t = L::Min(L::Max(L::Neg(z), zero), L::Set(1.0f));
+        x = L::Add(x, L::Select(L::Less(x, zero), t, L::Neg(t)));
+        y = L::Add(y, L::Select(L::Less(y, zero), t, L::Neg(t)));
+        auto const invLength = L::Div(L::Set(1.0f), L::Sqrt(L::Add(L::Add(L::Mul(x, x), L::Mul(y, y)), L::Mul(z, z))));
+        out[0] = L::Mul(x, invLength);
+        out[1] = L::Mul(y, invLength);
+        out[2] = L::Mul(z, invLength);
+    }
+}
+
+// -----------------------------------------------------------
+// -----------------------------------------------------------
+
+void mini::math::float_to_half_batch(float const* v, uint16_t* out, uint32_t count)
+{
+    auto i = 0u;
+#if defined(MINI_SIMD_AVX2) && defined(MINI_SIMD_F16C)
+    for (; i + 8 <= count; i += 8) { _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(v + i), _MM_FROUND_TO_NEAREST_INT)); }
+#elif defined(MINI_SIMD_F16C)
+    for (; i + 4 <= count; i += 4) { _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_cvtps_ph(_mm_loadu_ps(v + i), _MM_FROUND_TO_NEAREST_INT)); }
+#elif defined(MINI_SIMD_NEON)
+    for (; i + 4 <= count; i += 4) { vst1_u16(out + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(v + i)))); }
+#else
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) { VectorLanes::StoreInts(out + i, FloatToHalf<VectorLanes>(VectorLanes::Load(v + i))); }
+#endif
+    for (; i < count; ++i) { out[i] = float_to_half(v[i]); }
+}
+
+void mini::math::half_to_float_batch(uint16_t const* h, float* out, uint32_t count)
+{
+    auto i = 0u;
+#if defined(MINI_SIMD_AVX2) && defined(MINI_SIMD_F16C)
+    for (; i + 8 <= count; i += 8) { _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(h + i)))); }
+#elif defined(MINI_SIMD_F16C)
+    for (; i + 4 <= count; i += 4) { _mm_storeu_ps(out + i, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(h + i)))); }
+#elif defined(MINI_SIMD_NEON)
+    for (; i + 4 <= count; i += 4) { vst1q_f32(out + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(h + i)))); }
+#else
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) { VectorLanes::Store(out + i, HalfToFloat<VectorLanes>(VectorLanes::LoadInts(h + i))); }
+#endif
+    for (; i < count; ++i) { out[i] = half_to_float(h[i]); }
+}
+
+// -----------------------------------------------------------
+
+void mini::math::pack_unorm8_batch(float const* v, uint8_t* out, uint32_t count) { PackNormStream<uint8_t, 8>(v, out, count); }
+void mini::math::pack_unorm16_batch(float const* v, uint16_t* out, uint32_t count) { PackNormStream<uint16_t, 16>(v, out, count); }
+void mini::math::pack_snorm8_batch(float const* v, int8_t* out, uint32_t count) { PackNormStream<int8_t, 8>(v, out, count); }
+void mini::math::pack_snorm16_batch(float const* v, int16_t* out, uint32_t count) { PackNormStream<int16_t, 16>(v, out, count); }
+
+void mini::math::unpack_unorm8_batch(uint8_t const* q, float* out, uint32_t count) { UnpackNormStream<uint8_t, 8>(q, out, count); }
+void mini::math::unpack_unorm16_batch(uint16_t const* q, float* out, uint32_t count) { UnpackNormStream<uint16_t, 16>(q, out, count); }
+void mini::math::unpack_snorm8_batch(int8_t const* q, float* out, uint32_t count) { UnpackNormStream<int8_t, 8>(q, out, count); }
+void mini::math::unpack_snorm16_batch(int16_t const* q, float* out, uint32_t count) { UnpackNormStream<int16_t, 16>(q, out, count); }
+
+// -----------------------------------------------------------
+
+// @note    the four channels of one value fill one SSE / NEON register (two values per AVX2 register), so this works on the
+//          interleaved values directly: quantize all channels at once, shift them into place and or them together
+void mini::math::pack_r10g10b10a2_batch(vec4f_t const* v, uint32_t* out, uint32_t count)
+{
+    auto i = 0u;
+#if defined(MINI_SIMD_AVX2)
+    auto const scale = _mm256_setr_ps(1023.0f, 1023.0f, 1023.0f, 3.0f, 1023.0f, 1023.0f, 1023.0f, 3.0f);
+    auto const shift = _mm256_setr_epi32(0, 10, 20, 30, 0, 10, 20, 30);
+    for (; i + 2 <= count; i += 2) {
+        auto const c = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(v[i].elements), _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+        auto q = _mm256_sllv_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(c, scale)), shift);
+        q = _mm256_or_si256(q, _mm256_shuffle_epi32(q, _MM_SHUFFLE(1, 0, 3, 2)));
+        q = _mm256_or_si256(q, _mm256_shuffle_epi32(q, _MM_SHUFFLE(2, 3, 0, 1)));
+        out[i] = static_cast<uint32_t>(_mm256_extract_epi32(q, 0));
+        out[i + 1] = static_cast<uint32_t>(_mm256_extract_epi32(q, 4));
+    }
+#elif defined(MINI_SIMD_SSE4)
+    auto const scale = _mm_setr_ps(1023.0f, 1023.0f, 1023.0f, 3.0f);
+    auto const shift = _mm_setr_epi32(1, 1 << 10, 1 << 20, 1 << 30);     // no variable shifts before AVX2, multiply instead
+    for (; i < count; ++i) {
+        auto const c = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(v[i].elements), _mm_setzero_ps()), _mm_set1_ps(1.0f));
+        auto q = _mm_mullo_epi32(_mm_cvtps_epi32(_mm_mul_ps(c, scale)), shift);
+        q = _mm_or_si128(q, _mm_shuffle_epi32(q, _MM_SHUFFLE(1, 0, 3, 2)));
+        q = _mm_or_si128(q, _mm_shuffle_epi32(q, _MM_SHUFFLE(2, 3, 0, 1)));
+        out[i] = static_cast<uint32_t>(_mm_cvtsi128_si32(q));
+    }
+#elif defined(MINI_SIMD_NEON)
+    float const scaleValues[4] = { 1023.0f, 1023.0f, 1023.0f, 3.0f };
+    int32_t const shiftValues[4] = { 0, 10, 20, 30 };
+    auto const scale = vld1q_f32(scaleValues);
+    auto const shift = vld1q_s32(shiftValues);
+    for (; i < count; ++i) {
+        auto const c = VectorLanes::Min(VectorLanes::Max(vld1q_f32(v[i].elements), vdupq_n_f32(0.0f)), vdupq_n_f32(1.0f));
+        auto const q = vshlq_u32(vreinterpretq_u32_s32(vcvtnq_s32_f32(vmulq_f32(c, scale))), shift);
+        out[i] = vaddvq_u32(q);     // the channels don't overlap, adding is or-ing
+    }
+#endif
+    for (; i < count; ++i) { out[i] = pack_r10g10b10a2(v[i]); }
+}
+
+void mini::math::unpack_r10g10b10a2_batch(uint32_t const* packed, vec4f_t* out, uint32_t count)
+{
+    auto i = 0u;
+#if defined(MINI_SIMD_AVX2)
+    auto const scale = _mm256_setr_ps(1023.0f, 1023.0f, 1023.0f, 3.0f, 1023.0f, 1023.0f, 1023.0f, 3.0f);
+    auto const shift = _mm256_setr_epi32(0, 10, 20, 30, 0, 10, 20, 30);
+    auto const mask = _mm256_setr_epi32(0x3ff, 0x3ff, 0x3ff, 3, 0x3ff, 0x3ff, 0x3ff, 3);
+    for (; i + 2 <= count; i += 2) {
+        auto const p = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+        auto const broadcast = _mm256_permutevar8x32_epi32(_mm256_castsi128_si256(_mm_loadl_epi64(reinterpret_cast<__m128i const*>(packed + i))), p);
+        auto const q = _mm256_and_si256(_mm256_srlv_epi32(broadcast, shift), mask);
+        _mm256_storeu_ps(out[i].elements, _mm256_div_ps(_mm256_cvtepi32_ps(q), scale));
+    }
+#elif defined(MINI_SIMD_SSE4)
+    auto const scale = _mm_setr_ps(1023.0f, 1023.0f, 1023.0f, 3.0f);
+    for (; i < count; ++i) {
+        auto const p = packed[i];
+        auto const q = _mm_setr_epi32(static_cast<int32_t>(p & 0x3ff), static_cast<int32_t>((p >> 10) & 0x3ff), static_cast<int32_t>((p >> 20) & 0x3ff), static_cast<int32_t>(p >> 30));
+        _mm_storeu_ps(out[i].elements, _mm_div_ps(_mm_cvtepi32_ps(q), scale));
+    }
+#elif defined(MINI_SIMD_NEON)
+    float const scaleValues[4] = { 1023.0f, 1023.0f, 1023.0f, 3.0f };
+    int32_t const shiftValues[4] = { 0, -10, -20, -30 };   // negative counts shift right
+    uint32_t const maskValues[4] = { 0x3ff, 0x3ff, 0x3ff, 3 };
+    auto const scale = vld1q_f32(scaleValues);
+    auto const shift = vld1q_s32(shiftValues);
+    auto const mask = vld1q_u32(maskValues);
+    for (; i < count; ++i) {
+        auto const q = vandq_u32(vshlq_u32(vdupq_n_u32(packed[i]), shift), mask);
+        vst1q_f32(out[i].elements, vdivq_f32(vcvtq_f32_u32(q), scale));
+    }
+#endif
+    for (; i < count; ++i) { out[i] = unpack_r10g10b10a2(packed[i]); }
+}
+
+// -----------------------------------------------------------
+
+void mini::math::pack_octahedral_batch(vec3f_soa_const_t normals, uint32_t* out, uint32_t count)
+{
+    auto i = 0u;
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) {
+        VectorLanes::StoreInts(out + i, PackOctahedral<VectorLanes>(VectorLanes::Load(normals.x + i), VectorLanes::Load(normals.y + i), VectorLanes::Load(normals.z + i)));
+    }
+    for (; i < count; ++i) { out[i] = pack_octahedral(vec3f_t(normals.x[i], normals.y[i], normals.z[i])); }
+}
+
+void mini::math::unpack_octahedral_batch(uint32_t const* packed, vec3f_soa_t outNormals, uint32_t count)
+{
+    auto i = 0u;
+    for (; i + VectorLanes::count <= count; i += VectorLanes::count) {
+        VectorLanes::type n[3];
+        UnpackOctahedral<VectorLanes>(VectorLanes::LoadInts(packed + i), n);
+        VectorLanes::Store(outNormals.x + i, n[0]);
+        VectorLanes::Store(outNormals.y + i, n[1]);
+        VectorLanes::Store(outNormals.z + i, n[2]);
+    }
+    for (; i < count; ++i) {
+        auto const n = unpack_octahedral(packed[i]);
+        outNormals.x[i] = n.x;
+        outNormals.y[i] = n.y;
+        outNormals.z[i] = n.z;
+    }
+}
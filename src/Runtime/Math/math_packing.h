@@ -0,0 +1,199 @@
+#pragma once
+#include "math_types.h"
+#include "math_batch.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+    *   Conversions between floats and the packed formats vertex data, textures and constants get uploaded in: IEEE half floats,
+    *   UNORM and SNORM integers of any width up to 16 bits, DXGI_FORMAT_R10G10B10A2_UNORM and octahedral unit vectors in two
+    *   SNORM16 values. The single value functions are here, the _batch versions over arrays in math_packing.cpp.
+    *
+    *   Rounding follows the D3D conversion rules, the same ones the GPU applies when it reads these formats back:
+    *       half        round to nearest even, overflow goes to infinity, NaN stays NaN (with the hardware conversions the
+    *                   payload may differ), denormals on both sides are kept
+    *       unorm       clamp to [0, 1], NaN becomes 0, times 2^bits - 1 in float and round to nearest even
+    *       snorm       clamp to [-1, 1], NaN becomes 0, times 2^(bits - 1) - 1 in float and round to nearest even. both the
+    *                   lowest and the next code decode to -1
+    *       unpacking   q / max as a correctly rounded float division, not a multiply by the reciprocal
+    *   The batch versions produce the same bits as these for every input, except for unpack_octahedral's normalization which
+    *   may differ in the last bit where the compiler contracts the scalar one into FMAs. The packing benchmark checks both
+    *   against a double precision reference, exhaustively wherever the input space allows it.
+*/
+namespace mini
+{
+    namespace math
+    {
+        inline uint16_t float_to_half(float v);
+        inline float    half_to_float(uint16_t h);
+
+        // bits in [1, 16]. snorm codes are sign extended: pack_snorm(-1.0f, 8) is -127, not 0x81
+        inline uint32_t pack_unorm(float v, uint32_t bits);
+        inline int32_t  pack_snorm(float v, uint32_t bits);
+        inline float    unpack_unorm(uint32_t q, uint32_t bits);
+        inline float    unpack_snorm(int32_t q, uint32_t bits);
+
+        // x in the low 10 bits, w in the top 2
+        inline uint32_t pack_r10g10b10a2(vec4f_t const& v);
+        inline vec4f_t  unpack_r10g10b10a2(uint32_t packed);
+
+        // @note    octahedral: the unit sphere projected on the octahedron |x| + |y| + |z| = 1, the lower half folded over the
+        //          diagonals, x and y stored as snorm16 with x in the low half. n doesn't need to be normalized, zero encodes +z.
+        //          unpacking returns a normalized vector, within 0.005 degrees of the packed direction
+        inline uint32_t pack_octahedral(vec3f_t const& n);
+        inline vec3f_t  unpack_octahedral(uint32_t packed);
+
+        // -----------------------------------------------------------
+        // -----------------------------------------------------------
+
+        // out[i] = float_to_half(v[i]) etc. F16C and NEON convert halves in hardware, the other conversions run on the
+        // VectorLanes of math_lanes.h with the scalar functions for the tail
+        void float_to_half_batch(float const* v, uint16_t* out, uint32_t count);
+        void half_to_float_batch(uint16_t const* h, float* out, uint32_t count);
+
+        void pack_unorm8_batch(float const* v, uint8_t* out, uint32_t count);
+        void pack_unorm16_batch(float const* v, uint16_t* out, uint32_t count);
+        void pack_snorm8_batch(float const* v, int8_t* out, uint32_t count);
+        void pack_snorm16_batch(float const* v, int16_t* out, uint32_t count);
+        void unpack_unorm8_batch(uint8_t const* q, float* out, uint32_t count);
+        void unpack_unorm16_batch(uint16_t const* q, float* out, uint32_t count);
+        void unpack_snorm8_batch(int8_t const* q, float* out, uint32_t count);
+        void unpack_snorm16_batch(int16_t const* q, float* out, uint32_t count);
+
+        void pack_r10g10b10a2_batch(vec4f_t const* v, uint32_t* out, uint32_t count);
+        void unpack_r10g10b10a2_batch(uint32_t const* packed, vec4f_t* out, uint32_t count);
+
+        // normals come as structure of arrays like the other stream functions
+        void pack_octahedral_batch(vec3f_soa_const_t normals, uint32_t* out, uint32_t count);
+        void unpack_octahedral_batch(uint32_t const* packed, vec3f_soa_t outNormals, uint32_t count);
+    }
+}
+
+// -----------------------------------------------------------
+// -----------------------------------------------------------
+
+uint16_t mini::math::float_to_half(float v)
+{
+    uint32_t x;
+    memcpy(&x, &v, sizeof(x));
+    uint32_t const sign = x & 0x80000000u;
+    x ^= sign;
+
+    uint32_t result = 0;
+    if (x >= (143u << 23)) {    // >= 65536.0f, anything that rounds past the largest half
+        result = x > (255u << 23) ? 0x7e00 : 0x7c00;
+    }
+    else if (x < (113u << 23)) {    // becomes a half denormal, let the FPU do the rounding
+        uint32_t const denormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+        float magic, f;
+        memcpy(&magic, &denormMagic, sizeof(magic));
+        memcpy(&f, &x, sizeof(f));
+        f += magic;
+        memcpy(&result, &f, sizeof(result));
+        result -= denormMagic;
+    }
+    else {
+        uint32_t const mantissaOdd = (x >> 13) & 1;
+        x += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff;
+        x += mantissaOdd;
+        result = x >> 13;
+    }
+    return static_cast<uint16_t>(result | (sign >> 16));
+}
+
+float mini::math::half_to_float(uint16_t h)
+{
+    uint32_t const sign = static_cast<uint32_t>(h & 0x8000) << 16;
+    uint32_t const exponent = (h >> 10) & 0x1f;
+    uint32_t const mantissa = h & 0x3ff;
+    float result;
+    if (exponent == 0) {
+        result = static_cast<float>(mantissa) * (1.0f / 16777216.0f);  // @note denormal: mantissa * 2^-24
+    }
+    else if (exponent == 31) {
+        uint32_t const bits = 0x7f800000u | (mantissa << 13);
+        memcpy(&result, &bits, sizeof(result));
+    }
+    else {
+        uint32_t const bits = ((exponent + 112) << 23) | (mantissa << 13);
+        memcpy(&result, &bits, sizeof(result));
+    }
+    return sign ? -result : result;
+}
+
+// -----------------------------------------------------------
+// -----------------------------------------------------------
+
+// @note    the clamps are comparisons that are false for NaN so it ends up as 0, the SIMD versions get the same from min / max
+uint32_t mini::math::pack_unorm(float v, uint32_t bits)
+{
+    auto const scale = static_cast<float>((1u << bits) - 1);
+    v = v > 0.0f ? v : 0.0f;
+    v = v < 1.0f ? v : 1.0f;
+    return static_cast<uint32_t>(lrintf(v * scale));
+}
+
+int32_t mini::math::pack_snorm(float v, uint32_t bits)
+{
+    auto const scale = static_cast<float>((1u << (bits - 1)) - 1);
+    v = v > 0.0f ? (v < 1.0f ? v : 1.0f) : (v < 0.0f ? (v > -1.0f ? v : -1.0f) : 0.0f);
+    return static_cast<int32_t>(lrintf(v * scale));
+}
+
+float mini::math::unpack_unorm(uint32_t q, uint32_t bits)
+{
+    return static_cast<float>(q) / static_cast<float>((1u << bits) - 1);
+}
+
+float mini::math::unpack_snorm(int32_t q, uint32_t bits)
+{
+    auto const v = static_cast<float>(q) / static_cast<float>((1u << (bits - 1)) - 1);
+    return v > -1.0f ? v : -1.0f;
+}
+
+// -----------------------------------------------------------
+
+uint32_t mini::math::pack_r10g10b10a2(vec4f_t const& v)
+{
+    return pack_unorm(v.x, 10) | (pack_unorm(v.y, 10) << 10) | (pack_unorm(v.z, 10) << 20) | (pack_unorm(v.w, 2) << 30);
+}
+
+mini::math::vec4f_t mini::math::unpack_r10g10b10a2(uint32_t packed)
+{
+    return vec4f_t(unpack_unorm(packed & 0x3ff, 10), unpack_unorm((packed >> 10) & 0x3ff, 10), unpack_unorm((packed >> 20) & 0x3ff, 10), unpack_unorm(packed >> 30, 2));
+}
+
+// -----------------------------------------------------------
+
+uint32_t mini::math::pack_octahedral(vec3f_t const& n)
+{
+    auto l1 = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+    l1 = l1 > 1e-20f ? l1 : 1e-20f;     // @note zero length vectors encode as +z instead of NaN
+    auto const invL1 = 1.0f / l1;
+    auto px = n.x * invL1;
+    auto py = n.y * invL1;
+    if (n.z < 0.0f) {     // fold the lower hemisphere over the diagonals
+        auto const wrapX = (1.0f - fabsf(py)) * copysignf(1.0f, px);
+        auto const wrapY = (1.0f - fabsf(px)) * copysignf(1.0f, py);
+        px = wrapX;
+        py = wrapY;
+    }
+    auto const qx = pack_snorm(px, 16);
+    auto const qy = pack_snorm(py, 16);
+    return (static_cast<uint32_t>(qx) & 0xffff) | (static_cast<uint32_t>(qy) << 16);
+}
+
+mini::math::vec3f_t mini::math::unpack_octahedral(uint32_t packed)
+{
+    auto x = unpack_snorm(static_cast<int16_t>(packed & 0xffff), 16);
+    auto y = unpack_snorm(static_cast<int16_t>(packed >> 16), 16);
+    auto const z = 1.0f - fabsf(x) - fabsf(y);
+    auto t = -z > 0.0f ? -z : 0.0f;     // only the folded half has z < 0
+    t = t < 1.0f ? t : 1.0f;
+    x += x < 0.0f ? t : -t;
+    y += y < 0.0f ? t : -t;
+    auto const invLength = 1.0f / sqrtf(x * x + y * y + z * z);
+    return vec3f_t(x * invLength, y * invLength, z * invLength);
+}
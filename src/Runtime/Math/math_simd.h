@@ -0,0 +1,53 @@
+#pragma once
+
+/*
+    *   Compile time SIMD feature detection, every kernel keeps a scalar path so MINI_SIMD_FORCE_SCALAR can be defined to compare against it.
+    *   MSVC only advertises AVX through __AVX__ / __AVX2__ (i.e. /arch:AVX, /arch:AVX2) and has no SSE4 equivalent, so builds that target
+    *   SSE4.1 define MINI_SIMD_SSE4_BASELINE (see genie.lua), without any of those it falls back to scalar code.
+*/
+#if !defined(MINI_SIMD_FORCE_SCALAR)
+    #if defined(__AVX2__)
+        #define MINI_SIMD_AVX2 1
+    #endif
+    #if defined(__SSE4_1__) || defined(__AVX__) || defined(__AVX2__) || defined(MINI_SIMD_SSE4_BASELINE)
+        #define MINI_SIMD_SSE4 1
+    #endif
+    // @note    MSVC has no __F16C__ or __FMA__ but /arch:AVX2 implies both, GCC and Clang only report them for -mf16c / -mfma or a
+    //          -march that has them
+    #if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+        #define MINI_SIMD_F16C 1
+    #endif
+    #if defined(__FMA__) || defined(__ARM_FEATURE_FMA) || (defined(_MSC_VER) && defined(__AVX2__))
+        #define MINI_SIMD_FMA 1
+    #endif
+    #if defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define MINI_SIMD_NEON 1
+    #endif
+#endif
+
+#if defined(MINI_SIMD_SSE4)
+    #include <immintrin.h>
+#endif
+#if defined(MINI_SIMD_NEON)
+    #include <arm_neon.h>
+#endif
+
+namespace mini
+{
+    namespace math
+    {
+        // name of the widest instruction set compiled in, for benchmark output
+        inline char const* GetSimdBackendName()
+        {
+#if defined(MINI_SIMD_AVX2)
+            return "avx2";
+#elif defined(MINI_SIMD_SSE4)
+            return "sse4";
+#elif defined(MINI_SIMD_NEON)
+            return "neon";
+#else
+            return "scalar";
+#endif
+        }
+    }
+}
@@ -1,5 +1,14 @@
 #pragma once
-#include <memory.h>
+#include <type_traits>
+
+/*
+    *   Math types are trivially default constructible: "vec3f_t v;" or "new mat4x4f_t[n]" leave the values uninitialized, so
+    *   bulk buffers that get written anyway cost nothing to create. Ask for a value explicitly with the factories (zero(),
+    *   identity()) or the constructors. Value initialization ("vec3f_t()", "mat4x4f_t{}") zero fills, including matrices
+    *   and quaternions, which used to default to the identity.
+    *   Constructors and factories are constexpr. The elements[] aliases and operator[] are runtime only: reading a union member
+    *   other than the one initialized isn't a constant expression.
+*/
 
 namespace mini 
 {
@@ -20,9 +29,11 @@ namespace mini
                 float elements[2];
             };
 
-            vec2f_t(float v) : x(v), y(v) {}
-            vec2f_t() : vec2f_t(0.0f) {}
-            vec2f_t(float a, float b) : x(a), y(b) {} 
+            vec2f_t() = default;
+            constexpr vec2f_t(float v) : x(v), y(v) {}
+            constexpr vec2f_t(float a, float b) : x(a), y(b) {}
+
+            static constexpr vec2f_t zero() { return vec2f_t(0.0f); }
 
             explicit operator float* () { return elements; }
 
@@ -43,10 +54,12 @@ namespace mini
                 float elements[3];
             };
 
-            vec3f_t(float v) : x(v), y(v), z(v) {}
-            vec3f_t() : vec3f_t(0.0f) {}
-            vec3f_t(float a, float b, float c) : x(a), y(b), z(c) {}
-        
+            vec3f_t() = default;
+            constexpr vec3f_t(float v) : x(v), y(v), z(v) {}
+            constexpr vec3f_t(float a, float b, float c) : x(a), y(b), z(c) {}
+
+            static constexpr vec3f_t zero() { return vec3f_t(0.0f); }
+
             explicit operator float* () { return elements; }
 
             float const& operator [] (int index) const { return elements[index]; }
@@ -68,10 +81,12 @@ namespace mini
                 float elements[4];
             };
 
-            vec4f_t(float v) : x(v), y(v), z(v), w(z) {}
-            vec4f_t() : vec4f_t(0.0f) {}
-            vec4f_t(float a, float b, float c, float d) : x(a), y(b), z(c), w(d) {}
-            explicit vec4f_t(vec3f_t const& abc, float d) : xyz(abc), w(d) {}
+            vec4f_t() = default;
+            constexpr vec4f_t(float v) : x(v), y(v), z(v), w(v) {}
+            constexpr vec4f_t(float a, float b, float c, float d) : x(a), y(b), z(c), w(d) {}
+            constexpr explicit vec4f_t(vec3f_t const& abc, float d) : x(abc.x), y(abc.y), z(abc.z), w(d) {}
+
+            static constexpr vec4f_t zero() { return vec4f_t(0.0f); }
 
             explicit operator float* () { return elements; }
 
@@ -98,9 +113,11 @@ namespace mini
                 float elements[4];
             };
 
-            quatf_t() : w(1.0f), x(0.0f), y(0.0f), z(0.0f) {}
-            quatf_t(float d, float a, float b, float c) : w(d), x(a), y(b), z(c) {}
-        
+            quatf_t() = default;
+            constexpr quatf_t(float d, float a, float b, float c) : w(d), x(a), y(b), z(c) {}
+
+            static constexpr quatf_t identity() { return quatf_t(1.0f, 0.0f, 0.0f, 0.0f); }
+
             explicit operator float* () { return elements; }
         };
 
@@ -114,13 +131,13 @@ namespace mini
                 float elements[16];
             };
 
-            mat4x4f_t()
+            mat4x4f_t() = default;
+            constexpr mat4x4f_t(vec4f_t const& c0, vec4f_t const& c1, vec4f_t const& c2, vec4f_t const& c3) : columns{ c0, c1, c2, c3 } {}
+
+            static constexpr mat4x4f_t zero() { return mat4x4f_t(vec4f_t(0.0f), vec4f_t(0.0f), vec4f_t(0.0f), vec4f_t(0.0f)); }
+            static constexpr mat4x4f_t identity()
             {
-                memset(elements, 0x0, sizeof(float) * 16);
-                elements[0] = 1.0f;
-                elements[5] = 1.0f;
-                elements[10] = 1.0f;
-                elements[15] = 1.0f;
+                return mat4x4f_t(vec4f_t(1.0f, 0.0f, 0.0f, 0.0f), vec4f_t(0.0f, 1.0f, 0.0f, 0.0f), vec4f_t(0.0f, 0.0f, 1.0f, 0.0f), vec4f_t(0.0f, 0.0f, 0.0f, 1.0f));
             }
 
             explicit operator float* () { return elements; }
@@ -135,6 +152,45 @@ namespace mini
             }
         };
 
+        // -----------------------------------------------------------
+        // affine transform, a mat4x4f_t whose last row is (0, 0, 0, 1) and isn't stored. column major too, columns[3] is the translation
+        struct mat3x4f_t
+        {
+            union {
+                struct {
+                    vec3f_t columns[4];
+                };
+                float elements[12];
+            };
+
+            mat3x4f_t() = default;
+            constexpr mat3x4f_t(vec3f_t const& c0, vec3f_t const& c1, vec3f_t const& c2, vec3f_t const& c3) : columns{ c0, c1, c2, c3 } {}
+
+            static constexpr mat3x4f_t zero() { return mat3x4f_t(vec3f_t(0.0f), vec3f_t(0.0f), vec3f_t(0.0f), vec3f_t(0.0f)); }
+            static constexpr mat3x4f_t identity()
+            {
+                return mat3x4f_t(vec3f_t(1.0f, 0.0f, 0.0f), vec3f_t(0.0f, 1.0f, 0.0f), vec3f_t(0.0f, 0.0f, 1.0f), vec3f_t(0.0f));
+            }
+
+            explicit operator float* () { return elements; }
+            vec3f_t&          operator [] (int column)        { return columns[column]; }
+            vec3f_t const&    operator [] (int column) const  { return columns[column]; }
+        };
+
+        // -----------------------------------------------------------
+        // rigid transform as real + eps * dual: real is the rotation, dual = 0.5 * (0, translation) * real. skinning blends these
+        // instead of matrices so joints don't collapse, see dualquat_blend
+        struct dualquatf_t
+        {
+            quatf_t real;
+            quatf_t dual;
+
+            dualquatf_t() = default;
+            constexpr dualquatf_t(quatf_t const& r, quatf_t const& d) : real(r), dual(d) {}
+
+            static constexpr dualquatf_t identity() { return dualquatf_t(quatf_t::identity(), quatf_t(0.0f, 0.0f, 0.0f, 0.0f)); }
+        };
+
         // -----------------------------------------------------------
         static constexpr float PI = 3.14159265359f;
    
@@ -151,6 +207,26 @@ namespace mini
             vec3f_t p;
         };
 
+        // planes point inwards, dot(normal, p) + d >= 0 is inside. see make_frustum
+        struct frustum_t {
+            enum { PLANE_LEFT, PLANE_RIGHT, PLANE_BOTTOM, PLANE_TOP, PLANE_NEAR, PLANE_FAR, NUM_PLANES };  // @note windows.h defines NEAR and FAR
+            plane_t planes[NUM_PLANES];
+        };
+
+        // -----------------------------------------------------------
+        // @note    the batch kernels, GPU uploads and memcpy'd buffers rely on these
+        template <typename T>
+        constexpr bool is_pod_math_type = std::is_trivially_default_constructible<T>::value && std::is_trivially_copyable<T>::value
+            && std::is_standard_layout<T>::value;
+
+        static_assert(is_pod_math_type<vec2f_t> && sizeof(vec2f_t) == sizeof(float) * 2, "vec2f_t must stay 2 plain floats");
+        static_assert(is_pod_math_type<vec3f_t> && sizeof(vec3f_t) == sizeof(float) * 3, "vec3f_t must stay 3 plain floats");
+        static_assert(is_pod_math_type<vec4f_t> && sizeof(vec4f_t) == sizeof(float) * 4, "vec4f_t must stay 4 plain floats");
+        static_assert(is_pod_math_type<quatf_t> && sizeof(quatf_t) == sizeof(float) * 4, "quatf_t must stay 4 plain floats");
+        static_assert(is_pod_math_type<mat4x4f_t> && sizeof(mat4x4f_t) == sizeof(float) * 16, "mat4x4f_t must stay 16 plain floats");
+        static_assert(is_pod_math_type<mat3x4f_t> && sizeof(mat3x4f_t) == sizeof(float) * 12, "mat3x4f_t must stay 12 plain floats");
+        static_assert(is_pod_math_type<dualquatf_t> && sizeof(dualquatf_t) == sizeof(float) * 8, "dualquatf_t must stay 8 plain floats");
+        static_assert(is_pod_math_type<plane_t> && is_pod_math_type<line_t> && is_pod_math_type<frustum_t>, "plane_t, line_t and frustum_t must stay plain floats");
      }
 
     
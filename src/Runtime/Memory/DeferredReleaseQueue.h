@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/common.h>
+
+#include <EASTL/deque.h>
+
+namespace mini
+{
+    /*
+        *   Holds on to items the GPU may still reference until a fence value has been reached.
+        *   Items are pushed with the fence value of the last submission that may use them and handed back
+        *   to a release callback in push order once the completed fence value passes it.
+    */
+    template <class T>
+    class DeferredReleaseQueue
+    {
+        struct Entry
+        {
+            T           item;
+            uint64_t    fenceValue;
+        };
+        eastl::deque<Entry> m_entries;
+
+    public:
+        void Push(T const& item, uint64_t fenceValue)
+        {
+            MINI_ASSERT(m_entries.empty() || m_entries.back().fenceValue <= fenceValue, "Fence values must increase monotonically");
+            m_entries.push_back({ item, fenceValue });
+        }
+
+        // calls release(T&) for every item whose fence value is <= completedFenceValue, returns the number of released items
+        template <class Func>
+        uint32_t Release(uint64_t completedFenceValue, Func&& release)
+        {
+            uint32_t numReleased = 0;
+            while (!m_entries.empty() && m_entries.front().fenceValue <= completedFenceValue) {
+                release(m_entries.front().item);
+                m_entries.pop_front();
+                numReleased++;
+            }
+            return numReleased;
+        }
+
+        uint32_t GetSize() const { return static_cast<uint32_t>(m_entries.size()); }
+        bool IsEmpty() const { return m_entries.empty(); }
+    };
+}
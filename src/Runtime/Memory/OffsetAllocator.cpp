@@ -0,0 +1,346 @@
+#include "OffsetAllocator.h"
+#include <Runtime/common.h>
+
+#include <EASTL/vector.h>
+#include <EASTL/sort.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    constexpr uint32_t MANTISSA_BITS    = 3;
+    constexpr uint32_t MANTISSA_VALUE   = 1 << MANTISSA_BITS;
+    constexpr uint32_t MANTISSA_MASK    = MANTISSA_VALUE - 1;
+
+    inline uint32_t CountLeadingZeros(uint32_t v)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        return _BitScanReverse(&index, v) ? 31 - index : 32;
+#else
+        return v != 0 ? static_cast<uint32_t>(__builtin_clz(v)) : 32;
+#endif
+    }
+
+    inline uint32_t CountTrailingZeros(uint32_t v)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        return _BitScanForward(&index, v) ? index : 32;
+#else
+        return v != 0 ? static_cast<uint32_t>(__builtin_ctz(v)) : 32;
+#endif
+    }
+
+    inline uint32_t FindLowestSetBitAfter(uint32_t bitMask, uint32_t startBitIndex)
+    {
+        if (startBitIndex >= 32) { return mini::OffsetAllocation::NO_SPACE; }
+        auto const maskBeforeStartIndex = (1u << startBitIndex) - 1;
+        auto const bitsAfter = bitMask & ~maskBeforeStartIndex;
+        return bitsAfter != 0 ? CountTrailingZeros(bitsAfter) : mini::OffsetAllocation::NO_SPACE;
+    }
+}
+
+// -----------------------------------------------------------
+
+uint32_t mini::OffsetAllocator::SizeToBinRoundUp(uint32_t size)
+{
+    uint32_t exponent = 0;
+    uint32_t mantissa = 0;
+    if (size < MANTISSA_VALUE) {
+        mantissa = size;    // @note denormals
+    }
+    else {
+        auto const highestSetBit = 31 - CountLeadingZeros(size);
+        auto const mantissaStartBit = highestSetBit - MANTISSA_BITS;
+        exponent = mantissaStartBit + 1;
+        mantissa = (size >> mantissaStartBit) & MANTISSA_MASK;
+        auto const lowBitsMask = (1u << mantissaStartBit) - 1;
+        if ((size & lowBitsMask) != 0) {
+            mantissa++;
+        }
+    }
+    return (exponent << MANTISSA_BITS) + mantissa;  // @note + instead of | so a mantissa overflow carries into the exponent
+}
+
+uint32_t mini::OffsetAllocator::SizeToBinRoundDown(uint32_t size)
+{
+    uint32_t exponent = 0;
+    uint32_t mantissa = 0;
+    if (size < MANTISSA_VALUE) {
+        mantissa = size;
+    }
+    else {
+        auto const highestSetBit = 31 - CountLeadingZeros(size);
+        auto const mantissaStartBit = highestSetBit - MANTISSA_BITS;
+        exponent = mantissaStartBit + 1;
+        mantissa = (size >> mantissaStartBit) & MANTISSA_MASK;
+    }
+    return (exponent << MANTISSA_BITS) | mantissa;
+}
+
+uint32_t mini::OffsetAllocator::BinToSize(uint32_t bin)
+{
+    auto const exponent = bin >> MANTISSA_BITS;
+    auto const mantissa = bin & MANTISSA_MASK;
+    if (exponent == 0) { return mantissa; }
+    return (mantissa | MANTISSA_VALUE) << (exponent - 1);
+}
+
+// -----------------------------------------------------------
+
+bool mini::OffsetAllocator::Initialize(uint32_t size, uint32_t maxAllocations)
+{
+    MINI_ASSERT(size > 0 && maxAllocations > 0, "Invalid offset allocator size");
+    Shutdown();
+    m_size = size;
+    m_maxAllocations = maxAllocations;
+    m_nodes = new Node[maxAllocations];
+    m_freeNodes = new uint32_t[maxAllocations];
+    Reset();
+    return true;
+}
+
+void mini::OffsetAllocator::Shutdown()
+{
+    delete[] m_nodes;
+    delete[] m_freeNodes;
+    m_nodes = nullptr;
+    m_freeNodes = nullptr;
+    m_numFreeNodes = 0;
+    m_size = m_maxAllocations = m_freeStorage = 0;
+}
+
+void mini::OffsetAllocator::Reset()
+{
+    m_freeStorage = 0;
+    m_usedBinsTop = 0;
+    for (auto& bins : m_usedBins) { bins = 0; }
+    for (auto& index : m_binIndices) { index = Node::UNUSED; }
+
+    // @note free node stack is popped from the back, so node 0 is handed out first
+    for (auto i = 0u; i < m_maxAllocations; ++i) {
+        m_nodes[i] = Node();
+        m_freeNodes[i] = m_maxAllocations - i - 1;
+    }
+    m_numFreeNodes = m_maxAllocations;
+
+    InsertNodeIntoBin(m_size, 0);
+}
+
+uint32_t mini::OffsetAllocator::InsertNodeIntoBin(uint32_t size, uint32_t dataOffset)
+{
+    // @note round down so every region in a bin is at least as large as the bin's size class
+    auto const binIndex = SizeToBinRoundDown(size);
+    auto const topBinIndex = binIndex / BINS_PER_LEAF;
+    auto const leafBinIndex = binIndex % BINS_PER_LEAF;
+
+    if (m_binIndices[binIndex] == Node::UNUSED) {
+        m_usedBins[topBinIndex] |= 1 << leafBinIndex;
+        m_usedBinsTop |= 1u << topBinIndex;
+    }
+
+    auto const topNodeIndex = m_binIndices[binIndex];
+    MINI_ASSERT(m_numFreeNodes > 0, "Offset allocator ran out of nodes");
+    auto const nodeIndex = m_freeNodes[--m_numFreeNodes];
+
+    Node node;
+    node.dataOffset = dataOffset;
+    node.dataSize = size;
+    node.binListNext = topNodeIndex;
+    m_nodes[nodeIndex] = node;
+    if (topNodeIndex != Node::UNUSED) {
+        m_nodes[topNodeIndex].binListPrev = nodeIndex;
+    }
+    m_binIndices[binIndex] = nodeIndex;
+
+    m_freeStorage += size;
+    return nodeIndex;
+}
+
+void mini::OffsetAllocator::RemoveNodeFromBin(uint32_t nodeIndex)
+{
+    auto& node = m_nodes[nodeIndex];
+    if (node.binListPrev != Node::UNUSED) {
+        // easy case: not the head of the bin list
+        m_nodes[node.binListPrev].binListNext = node.binListNext;
+        if (node.binListNext != Node::UNUSED) {
+            m_nodes[node.binListNext].binListPrev = node.binListPrev;
+        }
+    }
+    else {
+        // head of the bin list, update the bin and clear the used bits if it runs empty
+        auto const binIndex = SizeToBinRoundDown(node.dataSize);
+        auto const topBinIndex = binIndex / BINS_PER_LEAF;
+        auto const leafBinIndex = binIndex % BINS_PER_LEAF;
+
+        m_binIndices[binIndex] = node.binListNext;
+        if (node.binListNext != Node::UNUSED) {
+            m_nodes[node.binListNext].binListPrev = Node::UNUSED;
+        }
+        if (m_binIndices[binIndex] == Node::UNUSED) {
+            m_usedBins[topBinIndex] &= ~(1 << leafBinIndex);
+            if (m_usedBins[topBinIndex] == 0) {
+                m_usedBinsTop &= ~(1u << topBinIndex);
+            }
+        }
+    }
+
+    m_freeNodes[m_numFreeNodes++] = nodeIndex;
+    m_freeStorage -= node.dataSize;
+}
+
+mini::OffsetAllocation mini::OffsetAllocator::Allocate(uint32_t size)
+{
+    if (m_numFreeNodes == 0 || size == 0) { return OffsetAllocation(); }
+
+    // @note round up so any region in the chosen bin is guaranteed to fit
+    auto const minBinIndex = SizeToBinRoundUp(size);
+    auto const minTopBinIndex = minBinIndex / BINS_PER_LEAF;
+    auto const minLeafBinIndex = minBinIndex % BINS_PER_LEAF;
+
+    auto topBinIndex = minTopBinIndex;
+    auto leafBinIndex = OffsetAllocation::NO_SPACE;
+
+    if (m_usedBinsTop & (1u << topBinIndex)) {
+        leafBinIndex = FindLowestSetBitAfter(m_usedBins[topBinIndex], minLeafBinIndex);
+    }
+    if (leafBinIndex == OffsetAllocation::NO_SPACE) {
+        topBinIndex = FindLowestSetBitAfter(m_usedBinsTop, minTopBinIndex + 1);
+        if (topBinIndex == OffsetAllocation::NO_SPACE) { return OffsetAllocation(); }
+        // @note any leaf bin of a larger top bin fits, take the smallest one
+        leafBinIndex = CountTrailingZeros(m_usedBins[topBinIndex]);
+    }
+
+    auto const binIndex = topBinIndex * BINS_PER_LEAF + leafBinIndex;
+    auto const nodeIndex = m_binIndices[binIndex];
+    auto& node = m_nodes[nodeIndex];
+    auto const nodeTotalSize = node.dataSize;
+    node.dataSize = size;
+    node.used = true;
+
+    m_binIndices[binIndex] = node.binListNext;
+    if (node.binListNext != Node::UNUSED) {
+        m_nodes[node.binListNext].binListPrev = Node::UNUSED;
+    }
+    node.binListPrev = node.binListNext = Node::UNUSED;
+    m_freeStorage -= nodeTotalSize;
+
+    if (m_binIndices[binIndex] == Node::UNUSED) {
+        m_usedBins[topBinIndex] &= ~(1 << leafBinIndex);
+        if (m_usedBins[topBinIndex] == 0) {
+            m_usedBinsTop &= ~(1u << topBinIndex);
+        }
+    }
+
+    // put the remainder back as a new free region right after this allocation
+    auto const remainderSize = nodeTotalSize - size;
+    if (remainderSize > 0) {
+        auto const newNodeIndex = InsertNodeIntoBin(remainderSize, node.dataOffset + size);
+        auto& newNode = m_nodes[newNodeIndex];
+        if (node.neighborNext != Node::UNUSED) {
+            m_nodes[node.neighborNext].neighborPrev = newNodeIndex;
+        }
+        newNode.neighborPrev = nodeIndex;
+        newNode.neighborNext = node.neighborNext;
+        node.neighborNext = newNodeIndex;
+    }
+
+    OffsetAllocation allocation;
+    allocation.offset = node.dataOffset;
+    allocation.metadata = nodeIndex;
+    return allocation;
+}
+
+void mini::OffsetAllocator::Free(OffsetAllocation allocation)
+{
+    if (allocation.metadata == OffsetAllocation::NO_SPACE) { return; }
+    MINI_ASSERT(allocation.metadata < m_maxAllocations && m_nodes[allocation.metadata].used, "Invalid or double free of offset allocation");
+
+    auto const nodeIndex = allocation.metadata;
+    auto& node = m_nodes[nodeIndex];
+
+    auto offset = node.dataOffset;
+    auto size = node.dataSize;
+
+    // merge with free neighbours
+    if (node.neighborPrev != Node::UNUSED && !m_nodes[node.neighborPrev].used) {
+        auto const& prevNode = m_nodes[node.neighborPrev];
+        offset = prevNode.dataOffset;
+        size += prevNode.dataSize;
+        auto const prevIndex = node.neighborPrev;
+        node.neighborPrev = prevNode.neighborPrev;
+        RemoveNodeFromBin(prevIndex);
+    }
+    if (node.neighborNext != Node::UNUSED && !m_nodes[node.neighborNext].used) {
+        auto const& nextNode = m_nodes[node.neighborNext];
+        size += nextNode.dataSize;
+        auto const nextIndex = node.neighborNext;
+        node.neighborNext = nextNode.neighborNext;
+        RemoveNodeFromBin(nextIndex);
+    }
+
+    auto const neighborNext = node.neighborNext;
+    auto const neighborPrev = node.neighborPrev;
+
+    // @note return the allocation's node to the stack, the merged region gets a fresh one
+    m_freeNodes[m_numFreeNodes++] = nodeIndex;
+
+    auto const combinedNodeIndex = InsertNodeIntoBin(size, offset);
+    if (neighborNext != Node::UNUSED) {
+        m_nodes[combinedNodeIndex].neighborNext = neighborNext;
+        m_nodes[neighborNext].neighborPrev = combinedNodeIndex;
+    }
+    if (neighborPrev != Node::UNUSED) {
+        m_nodes[combinedNodeIndex].neighborPrev = neighborPrev;
+        m_nodes[neighborPrev].neighborNext = combinedNodeIndex;
+    }
+}
+
+uint32_t mini::OffsetAllocator::GetAllocationSize(OffsetAllocation allocation) const
+{
+    if (allocation.metadata == OffsetAllocation::NO_SPACE) { return 0; }
+    return m_nodes[allocation.metadata].dataSize;
+}
+
+mini::OffsetAllocatorReport mini::OffsetAllocator::GetReport() const
+{
+    OffsetAllocatorReport report;
+    report.totalFree = m_freeStorage;
+    for (auto i = 0u; i < NUM_LEAF_BINS; ++i) {
+        for (auto nodeIndex = m_binIndices[i]; nodeIndex != Node::UNUSED; nodeIndex = m_nodes[nodeIndex].binListNext) {
+            auto const size = m_nodes[nodeIndex].dataSize;
+            report.largestFree = size > report.largestFree ? size : report.largestFree;
+            report.numFreeRegions++;
+        }
+    }
+    return report;
+}
+
+uint32_t mini::OffsetAllocator::Compact(OffsetAllocation* allocations, uint32_t count, OffsetAllocatorMove* outMoves)
+{
+    struct Entry { uint32_t index; uint32_t offset; uint32_t size; };
+    eastl::vector<Entry> entries;
+    entries.reserve(count);
+    for (auto i = 0u; i < count; ++i) {
+        if (!allocations[i].IsValid()) { continue; }
+        entries.push_back({ i, allocations[i].offset, GetAllocationSize(allocations[i]) });
+    }
+    eastl::sort(entries.begin(), entries.end(), [](Entry const& a, Entry const& b) { return a.offset < b.offset; });
+
+    // @note a fresh allocator carves allocations off the front of its single free region,
+    //       so allocating in offset order packs everything without gaps
+    Reset();
+    uint32_t numMoves = 0;
+    for (auto const& entry : entries) {
+        auto const allocation = Allocate(entry.size);
+        MINI_ASSERT(allocation.IsValid() && allocation.offset <= entry.offset, "Compaction must never move allocations upwards");
+        allocations[entry.index] = allocation;
+        if (allocation.offset != entry.offset) {
+            outMoves[numMoves++] = { entry.index, entry.offset, allocation.offset, entry.size };
+        }
+    }
+    return numMoves;
+}
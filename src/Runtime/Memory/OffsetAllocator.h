@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace mini
+{
+    struct OffsetAllocation
+    {
+        static constexpr uint32_t NO_SPACE = 0xffffffff;
+
+        uint32_t offset     = NO_SPACE;
+        uint32_t metadata   = NO_SPACE;     // @note internal node index, needed to free the allocation
+
+        bool IsValid() const { return offset != NO_SPACE; }
+    };
+
+    struct OffsetAllocatorReport
+    {
+        uint32_t totalFree      = 0;
+        uint32_t largestFree    = 0;
+        uint32_t numFreeRegions = 0;
+
+        // 0 if all free space is one contiguous region, approaching 1 the more it's scattered
+        float GetFragmentation() const { return totalFree > 0 ? 1.0f - static_cast<float>(largestFree) / static_cast<float>(totalFree) : 0.0f; }
+    };
+
+    struct OffsetAllocatorMove
+    {
+        uint32_t index      = 0;    // index into the allocation array passed to Compact
+        uint32_t srcOffset  = 0;
+        uint32_t dstOffset  = 0;
+        uint32_t size       = 0;
+    };
+
+    /*
+        *   TLSF-style allocator handing out ranges of an externally owned address space, e.g. a GPU buffer.
+        *   Free regions are binned by size classes encoded as small floats (3 bit mantissa, 5 bit exponent),
+        *   a two level bitmask finds a fitting bin in O(1) and freed regions are merged with their free neighbours immediately.
+        *   The allocator never touches the memory it manages so it's usable (and testable) without a GPU.
+    */
+    class OffsetAllocator
+    {
+    public:
+        static constexpr uint32_t NUM_TOP_BINS      = 32;
+        static constexpr uint32_t BINS_PER_LEAF     = 8;
+        static constexpr uint32_t NUM_LEAF_BINS     = NUM_TOP_BINS * BINS_PER_LEAF;
+
+    private:
+        struct Node
+        {
+            static constexpr uint32_t UNUSED = 0xffffffff;
+
+            uint32_t dataOffset     = 0;
+            uint32_t dataSize       = 0;
+            uint32_t binListPrev    = UNUSED;
+            uint32_t binListNext    = UNUSED;
+            uint32_t neighborPrev   = UNUSED;
+            uint32_t neighborNext   = UNUSED;
+            bool     used           = false;
+        };
+
+        uint32_t    m_size              = 0;
+        uint32_t    m_maxAllocations    = 0;
+        uint32_t    m_freeStorage       = 0;
+
+        uint32_t    m_usedBinsTop       = 0;
+        uint8_t     m_usedBins[NUM_TOP_BINS] = {};
+        uint32_t    m_binIndices[NUM_LEAF_BINS] = {};
+
+        Node*       m_nodes             = nullptr;
+        uint32_t*   m_freeNodes         = nullptr;
+        uint32_t    m_numFreeNodes      = 0;
+
+        uint32_t    InsertNodeIntoBin(uint32_t size, uint32_t dataOffset);
+        void        RemoveNodeFromBin(uint32_t nodeIndex);
+
+    public:
+        OffsetAllocator() = default;
+        OffsetAllocator(OffsetAllocator const&) = delete;
+        OffsetAllocator& operator = (OffsetAllocator const&) = delete;
+        ~OffsetAllocator() { Shutdown(); }
+
+        bool                    Initialize(uint32_t size, uint32_t maxAllocations = 128 * 1024);
+        void                    Shutdown();
+        void                    Reset();
+
+        OffsetAllocation        Allocate(uint32_t size);
+        void                    Free(OffsetAllocation allocation);
+
+        uint32_t                GetAllocationSize(OffsetAllocation allocation) const;
+        uint32_t                GetSize() const { return m_size; }
+        uint32_t                GetUsed() const { return m_size - m_freeStorage; }
+        OffsetAllocatorReport   GetReport() const;
+
+        // @note    packs the given live allocations towards offset 0, keeping their relative order.
+        //          allocations are updated in place and every allocation that changed offset is written to outMoves (which needs room for count entries).
+        //          moves are returned in ascending order and never move data upwards, so applying them in order with memmove is safe.
+        //          allocations not passed in are dropped.
+        uint32_t                Compact(OffsetAllocation* allocations, uint32_t count, OffsetAllocatorMove* outMoves);
+
+        static uint32_t         SizeToBinRoundUp(uint32_t size);
+        static uint32_t         SizeToBinRoundDown(uint32_t size);
+        static uint32_t         BinToSize(uint32_t bin);
+    };
+}
@@ -0,0 +1,100 @@
+#include "RingAllocator.h"
+#include <Runtime/common.h>
+
+namespace
+{
+    inline uint32_t AlignUp(uint32_t value, uint32_t alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+// -----------------------------------------------------------
+
+void mini::RingAllocator::Initialize(uint32_t size)
+{
+    m_size = size;
+    Reset();
+}
+
+void mini::RingAllocator::Reset()
+{
+    m_head = m_tail = 0;
+    m_used = 0;
+    m_openBatchSize = 0;
+    m_firstBatch = m_numBatches = 0;
+}
+
+uint32_t mini::RingAllocator::Allocate(uint32_t size, uint32_t alignment)
+{
+    MINI_ASSERT(alignment > 0 && (alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+    if (size == 0 || size > m_size) { return NO_SPACE; }
+
+    if (m_used == 0) {
+        m_head = m_tail = 0;    // @note an empty ring can start over from the beginning, keeps large allocations from failing on a wrap
+    }
+
+    auto const offset = AlignUp(m_head, alignment);
+    uint32_t result = NO_SPACE;
+    uint32_t newHead = 0;
+    if (m_head > m_tail || m_used == 0) {
+        // free space is [head, size) followed by [0, tail)
+        if (static_cast<uint64_t>(offset) + size <= m_size) {
+            result = offset;
+            newHead = offset + size;
+        }
+        else if (size <= m_tail) {
+            result = 0;     // @note wrap around, the rest of the ring is wasted until this batch is reclaimed
+            newHead = size;
+        }
+    }
+    else if (static_cast<uint64_t>(offset) + size <= m_tail) {     // @note also rejects everything when head == tail on a full ring
+        result = offset;
+        newHead = offset + size;
+    }
+    if (result == NO_SPACE) { return NO_SPACE; }
+
+    auto const consumed = newHead > m_head ? newHead - m_head : (m_size - m_head) + newHead;
+    m_used += consumed;
+    m_openBatchSize += consumed;
+    m_head = newHead == m_size ? 0 : newHead;
+    return result;
+}
+
+void mini::RingAllocator::CloseBatch(uint64_t fenceValue)
+{
+    if (m_openBatchSize == 0) { return; }
+
+    if (m_numBatches == MAX_PENDING_BATCHES) {
+        // @note out of batch slots, fold into the newest batch. that only delays its reclamation which is always safe
+        auto& newest = m_batches[(m_firstBatch + m_numBatches - 1) % MAX_PENDING_BATCHES];
+        MINI_ASSERT(fenceValue >= newest.fenceValue, "Fence values must increase monotonically");
+        newest.fenceValue = fenceValue;
+        newest.end = m_head;
+        newest.size += m_openBatchSize;
+    }
+    else {
+        auto& batch = m_batches[(m_firstBatch + m_numBatches) % MAX_PENDING_BATCHES];
+        batch.fenceValue = fenceValue;
+        batch.end = m_head;
+        batch.size = m_openBatchSize;
+        m_numBatches++;
+    }
+    m_openBatchSize = 0;
+}
+
+uint32_t mini::RingAllocator::Reclaim(uint64_t completedFenceValue)
+{
+    uint32_t reclaimed = 0;
+    while (m_numBatches > 0) {
+        auto const& batch = m_batches[m_firstBatch];
+        if (batch.fenceValue > completedFenceValue) { break; }
+
+        m_tail = batch.end;
+        m_used -= batch.size;
+        reclaimed += batch.size;
+        m_firstBatch = (m_firstBatch + 1) % MAX_PENDING_BATCHES;
+        m_numBatches--;
+    }
+    return reclaimed;
+}
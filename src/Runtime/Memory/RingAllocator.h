@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stdint.h>
+
+namespace mini
+{
+    /*
+        *   Ring allocator for transient data the GPU consumes asynchronously, e.g. staging memory for uploads.
+        *   Allocations are grouped into batches, CloseBatch tags everything allocated since the last call with a fence value
+        *   and Reclaim releases all batches whose fence value the GPU has passed. Memory is released strictly in order.
+        *   Like OffsetAllocator it only hands out offsets and never touches the memory, so it's usable without a GPU.
+    */
+    class RingAllocator
+    {
+    public:
+        static constexpr uint32_t NO_SPACE              = 0xffffffff;
+        static constexpr uint32_t MAX_PENDING_BATCHES   = 64;
+
+    private:
+        struct Batch
+        {
+            uint64_t fenceValue = 0;
+            uint32_t end        = 0;    // head position when the batch was closed
+            uint32_t size       = 0;    // bytes including padding and wrap around waste
+        };
+
+        uint32_t    m_size          = 0;
+        uint32_t    m_head          = 0;    // next allocation starts here
+        uint32_t    m_tail          = 0;    // oldest byte still in use
+        uint32_t    m_used          = 0;
+        uint32_t    m_openBatchSize = 0;
+
+        Batch       m_batches[MAX_PENDING_BATCHES];
+        uint32_t    m_firstBatch    = 0;
+        uint32_t    m_numBatches    = 0;
+
+    public:
+        void        Initialize(uint32_t size);
+        void        Reset();
+
+        // @note returns NO_SPACE if the ring is full, callers are expected to Reclaim (or wait on the GPU) and retry
+        uint32_t    Allocate(uint32_t size, uint32_t alignment = 16);
+
+        // ties everything allocated since the previous call to fenceValue, fence values must increase monotonically
+        void        CloseBatch(uint64_t fenceValue);
+        // releases all batches with a fence value <= completedFenceValue, returns the number of bytes reclaimed
+        uint32_t    Reclaim(uint64_t completedFenceValue);
+
+        uint32_t    GetSize() const { return m_size; }
+        uint32_t    GetUsed() const { return m_used; }
+        uint32_t    GetNumPendingBatches() const { return m_numBatches; }
+        bool        HasOpenBatch() const { return m_openBatchSize > 0; }
+    };
+}
@@ -0,0 +1,602 @@
+#include "MeshOptimizer.h"
+#include <Runtime/common.h>
+
+#include <EASTL/sort.h>
+
+#include <math.h>
+#include <string.h>
+
+namespace
+{
+    constexpr uint32_t INVALID_INDEX = 0xffffffff;
+
+    inline float const* GetPosition(void const* vertices, uint32_t stride, uint32_t index)
+    {
+        return reinterpret_cast<float const*>(static_cast<char const*>(vertices) + static_cast<size_t>(index) * stride);
+    }
+
+    inline uint32_t HashCell(int32_t x, int32_t y, int32_t z)
+    {
+        return (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u) ^ (static_cast<uint32_t>(z) * 83492791u);
+    }
+
+    inline uint32_t NextPowerOfTwo(uint32_t v)
+    {
+        uint32_t result = 1;
+        while (result < v) { result <<= 1; }
+        return result;
+    }
+
+    // -----------------------------------------------------------
+    //  Forsyth vertex cache optimisation, scores as in the original article
+
+    constexpr uint32_t FORSYTH_CACHE_SIZE       = 32;
+    constexpr uint32_t FORSYTH_MAX_VALENCE      = 64;
+    constexpr float FORSYTH_LAST_TRI_SCORE      = 0.75f;
+    constexpr float FORSYTH_DECAY_POWER         = 1.5f;
+    constexpr float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+    constexpr float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+    struct ForsythTables
+    {
+        float cacheScores[FORSYTH_CACHE_SIZE];
+        float valenceScores[FORSYTH_MAX_VALENCE];
+
+        ForsythTables()
+        {
+            for (auto i = 0u; i < FORSYTH_CACHE_SIZE; ++i) {
+                if (i < 3) {
+                    cacheScores[i] = FORSYTH_LAST_TRI_SCORE;    // @note the last triangle's vertices get a fixed score so it's not simply repeated
+                }
+                else {
+                    auto const scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+                    cacheScores[i] = powf(1.0f - (i - 3) * scaler, FORSYTH_DECAY_POWER);
+                }
+            }
+            valenceScores[0] = 0.0f;
+            for (auto i = 1u; i < FORSYTH_MAX_VALENCE; ++i) {
+                valenceScores[i] = FORSYTH_VALENCE_BOOST_SCALE * powf(static_cast<float>(i), -FORSYTH_VALENCE_BOOST_POWER);
+            }
+        }
+
+        float Score(int32_t cachePosition, uint32_t liveTriangles) const
+        {
+            if (liveTriangles == 0) { return -1.0f; }
+            auto const cacheScore = cachePosition >= 0 ? cacheScores[cachePosition] : 0.0f;
+            return cacheScore + valenceScores[liveTriangles < FORSYTH_MAX_VALENCE ? liveTriangles : FORSYTH_MAX_VALENCE - 1];
+        }
+    };
+
+    // -----------------------------------------------------------
+
+    struct Cluster
+    {
+        uint32_t    firstTriangle;
+        uint32_t    numTriangles;
+        float       sortKey;
+    };
+
+    // triangles whose vertices all miss a FIFO cache of cacheSize start a new cluster, those are the natural seams of a cache optimized list
+    void FindHardBoundaries(uint32_t const* indices, uint32_t numIndices, uint32_t numVertices, uint32_t cacheSize, eastl::vector<uint32_t>& outBoundaries)
+    {
+        eastl::vector<uint32_t> timestamps(numVertices, 0);
+        uint32_t time = cacheSize + 1;
+        for (auto i = 0u; i < numIndices; i += 3) {
+            uint32_t misses = 0;
+            for (auto k = 0; k < 3; ++k) {
+                auto const v = indices[i + k];
+                if (time - timestamps[v] > cacheSize) {
+                    timestamps[v] = time++;
+                    misses++;
+                }
+            }
+            if (misses == 3) { outBoundaries.push_back(i / 3); }
+        }
+    }
+}
+
+// -----------------------------------------------------------
+
+uint32_t mini::WeldVertices(void const* vertices, uint32_t numVertices, uint32_t vertexStride, float positionEpsilon, float attributeEpsilon, uint32_t* outRemap)
+{
+    MINI_ASSERT(vertexStride % sizeof(float) == 0 && vertexStride >= sizeof(float) * 3, "Vertices must be float attributes starting with a position");
+    auto const numFloats = vertexStride / sizeof(float);
+
+    // @note    cells are twice the welding distance so candidates are always in the same or a neighbouring cell.
+    //          an epsilon of 0 hashes the exact bit pattern of the position instead and only looks at one cell
+    auto const exact = positionEpsilon <= 0.0f;
+    auto const invCellSize = exact ? 0.0f : 1.0f / (positionEpsilon * 2.0f);
+    auto const cellOf = [&](float const* p, int32_t* cell) {
+        for (auto c = 0; c < 3; ++c) {
+            if (exact) { memcpy(&cell[c], &p[c], sizeof(float)); }
+            else { cell[c] = static_cast<int32_t>(floorf(p[c] * invCellSize)); }
+        }
+    };
+
+    // open addressing table of cells, every cell links the unique vertices that live in it
+    auto const tableSize = NextPowerOfTwo(numVertices * 2 + 1);
+    struct CellEntry { int32_t cell[3]; uint32_t firstVertex; };
+    eastl::vector<CellEntry> table(tableSize, CellEntry{ { 0, 0, 0 }, INVALID_INDEX });
+    eastl::vector<uint32_t> nextInCell(numVertices, INVALID_INDEX);
+    eastl::vector<uint32_t> uniqueVertices;
+    uniqueVertices.reserve(numVertices);
+
+    auto const findCell = [&](int32_t const* cell) -> CellEntry& {
+        auto slot = HashCell(cell[0], cell[1], cell[2]) & (tableSize - 1);
+        while (table[slot].firstVertex != INVALID_INDEX && memcmp(table[slot].cell, cell, sizeof(table[slot].cell)) != 0) {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        return table[slot];
+    };
+    auto const isEqual = [&](float const* a, float const* b) {
+        for (auto c = 0u; c < 3; ++c) {
+            if (fabsf(a[c] - b[c]) > positionEpsilon) { return false; }
+        }
+        for (auto c = 3u; c < numFloats; ++c) {
+            if (fabsf(a[c] - b[c]) > attributeEpsilon) { return false; }
+        }
+        return true;
+    };
+
+    for (auto i = 0u; i < numVertices; ++i) {
+        auto const p = GetPosition(vertices, vertexStride, i);
+        int32_t cell[3];
+        cellOf(p, cell);
+
+        // @note a neighbouring cell only needs a look if the position is within epsilon of the shared face
+        int32_t low[3] = { 0, 0, 0 }, high[3] = { 0, 0, 0 };
+        for (auto c = 0; !exact && c < 3; ++c) {
+            auto const local = p[c] * invCellSize - static_cast<float>(cell[c]);
+            low[c] = local < 0.5f ? -1 : 0;
+            high[c] = local > 0.5f ? 1 : 0;
+        }
+        auto match = INVALID_INDEX;
+        for (auto dz = low[2]; dz <= high[2] && match == INVALID_INDEX; ++dz) {
+            for (auto dy = low[1]; dy <= high[1] && match == INVALID_INDEX; ++dy) {
+                for (auto dx = low[0]; dx <= high[0] && match == INVALID_INDEX; ++dx) {
+                    int32_t const neighbour[3] = { cell[0] + dx, cell[1] + dy, cell[2] + dz };
+                    for (auto u = findCell(neighbour).firstVertex; u != INVALID_INDEX; u = nextInCell[u]) {
+                        if (isEqual(p, GetPosition(vertices, vertexStride, uniqueVertices[u]))) { match = u; break; }
+                    }
+                }
+            }
+        }
+
+        if (match == INVALID_INDEX) {
+            match = static_cast<uint32_t>(uniqueVertices.size());
+            uniqueVertices.push_back(i);
+            auto& entry = findCell(cell);
+            memcpy(entry.cell, cell, sizeof(cell));
+            nextInCell[match] = entry.firstVertex;
+            entry.firstVertex = match;
+        }
+        outRemap[i] = match;
+    }
+    return static_cast<uint32_t>(uniqueVertices.size());
+}
+
+void mini::RemapVertices(void* dst, void const* vertices, uint32_t numVertices, uint32_t vertexStride, uint32_t const* remap)
+{
+    for (auto i = 0u; i < numVertices; ++i) {
+        if (remap[i] == INVALID_INDEX) { continue; }
+        memcpy(static_cast<char*>(dst) + static_cast<size_t>(remap[i]) * vertexStride, static_cast<char const*>(vertices) + static_cast<size_t>(i) * vertexStride, vertexStride);
+    }
+}
+
+void mini::RemapIndices(uint32_t* dst, uint32_t const* indices, uint32_t numIndices, uint32_t const* remap)
+{
+    for (auto i = 0u; i < numIndices; ++i) {
+        dst[i] = remap[indices[i]];
+    }
+}
+
+// -----------------------------------------------------------
+
+void mini::OptimizeVertexCache(uint32_t* dst, uint32_t const* indices, uint32_t numIndices, uint32_t numVertices)
+{
+    static ForsythTables const tables;
+    auto const numTriangles = numIndices / 3;
+    if (numTriangles == 0) { return; }
+
+    // vertex -> triangle adjacency
+    eastl::vector<uint32_t> liveTriangles(numVertices, 0);
+    for (auto i = 0u; i < numIndices; ++i) { liveTriangles[indices[i]]++; }
+    eastl::vector<uint32_t> adjacencyOffsets(numVertices + 1, 0);
+    for (auto v = 0u; v < numVertices; ++v) { adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v]; }
+    eastl::vector<uint32_t> adjacency(numIndices);
+    {
+        eastl::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (auto i = 0u; i < numIndices; ++i) { adjacency[fill[indices[i]]++] = i / 3; }
+    }
+
+    eastl::vector<int32_t> cachePositions(numVertices, -1);
+    eastl::vector<float> vertexScores(numVertices);
+    for (auto v = 0u; v < numVertices; ++v) { vertexScores[v] = tables.Score(-1, liveTriangles[v]); }
+    eastl::vector<float> triangleScores(numTriangles);
+    eastl::vector<bool> emitted(numTriangles, false);
+    for (auto t = 0u; t < numTriangles; ++t) {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+    }
+
+    uint32_t cache[FORSYTH_CACHE_SIZE + 3];
+    uint32_t cacheCount = 0;
+    uint32_t scanCursor = 0;
+    auto bestTriangle = INVALID_INDEX;
+    {
+        auto bestScore = -1.0f;
+        for (auto t = 0u; t < numTriangles; ++t) {
+            if (triangleScores[t] > bestScore) { bestScore = triangleScores[t]; bestTriangle = t; }
+        }
+    }
+
+    for (auto outputTriangle = 0u; outputTriangle < numTriangles; ++outputTriangle) {
+        if (bestTriangle == INVALID_INDEX) {
+            // @note nothing in the cache has live triangles left, continue with the next unemitted triangle in input order
+            while (emitted[scanCursor]) { scanCursor++; }
+            bestTriangle = scanCursor;
+        }
+        auto const tri = bestTriangle;
+        emitted[tri] = true;
+        uint32_t const triVertices[3] = { indices[tri * 3], indices[tri * 3 + 1], indices[tri * 3 + 2] };
+        memcpy(dst + outputTriangle * 3, triVertices, sizeof(triVertices));
+
+        // remove the triangle from its vertices' live lists
+        for (auto const v : triVertices) {
+            auto const begin = adjacency.begin() + adjacencyOffsets[v];
+            auto const end = begin + liveTriangles[v];
+            for (auto it = begin; it != end; ++it) {
+                if (*it == tri) { *it = *(end - 1); break; }
+            }
+            liveTriangles[v]--;
+        }
+
+        // new cache: the triangle's vertices in front, everything else shifted back
+        uint32_t newCache[FORSYTH_CACHE_SIZE + 3];
+        uint32_t newCacheCount = 0;
+        for (auto const v : triVertices) {
+            bool duplicate = false;
+            for (auto k = 0u; k < newCacheCount; ++k) { duplicate |= newCache[k] == v; }
+            if (!duplicate) { newCache[newCacheCount++] = v; }
+        }
+        for (auto k = 0u; k < cacheCount; ++k) {
+            auto const v = cache[k];
+            if (v != triVertices[0] && v != triVertices[1] && v != triVertices[2]) { newCache[newCacheCount++] = v; }
+        }
+
+        // rescore everything that moved, vertices that fell out of the cache lose their cache score
+        bestTriangle = INVALID_INDEX;
+        auto bestScore = -1.0f;
+        for (auto k = 0u; k < newCacheCount; ++k) {
+            auto const v = newCache[k];
+            auto const position = k < FORSYTH_CACHE_SIZE ? static_cast<int32_t>(k) : -1;
+            cachePositions[v] = position;
+            auto const score = tables.Score(position, liveTriangles[v]);
+            auto const delta = score - vertexScores[v];
+            vertexScores[v] = score;
+            for (auto a = 0u; a < liveTriangles[v]; ++a) {
+                auto const t = adjacency[adjacencyOffsets[v] + a];
+                triangleScores[t] += delta;
+                if (position >= 0 && triangleScores[t] > bestScore) { bestScore = triangleScores[t]; bestTriangle = t; }
+            }
+        }
+        cacheCount = newCacheCount < FORSYTH_CACHE_SIZE ? newCacheCount : FORSYTH_CACHE_SIZE;
+        memcpy(cache, newCache, cacheCount * sizeof(uint32_t));
+    }
+}
+
+void mini::OptimizeOverdraw(uint32_t* dst, uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride, float threshold)
+{
+    auto const numTriangles = numIndices / 3;
+    if (numTriangles == 0) { return; }
+    uint32_t const cacheSize = 16;
+
+    // hard boundaries, then soft boundaries inside each hard cluster wherever its running ACMR is within threshold of the cluster's total
+    eastl::vector<uint32_t> hardBoundaries;
+    FindHardBoundaries(indices, numIndices, numVertices, cacheSize, hardBoundaries);
+    if (hardBoundaries.empty() || hardBoundaries[0] != 0) { hardBoundaries.insert(hardBoundaries.begin(), 0u); }
+    hardBoundaries.push_back(numTriangles);
+
+    eastl::vector<Cluster> clusters;
+    eastl::vector<uint32_t> timestamps(numVertices, 0);
+    uint32_t time = cacheSize + 1;
+    for (auto h = 0u; h + 1 < hardBoundaries.size(); ++h) {
+        auto const first = hardBoundaries[h];
+        auto const last = hardBoundaries[h + 1];
+        auto const clusterAcmr = AnalyzeVertexCache(indices + first * 3, (last - first) * 3, numVertices, cacheSize).acmr;
+
+        auto start = first;
+        uint32_t misses = 0;
+        time += cacheSize + 1;
+        for (auto t = first; t < last; ++t) {
+            for (auto k = 0; k < 3; ++k) {
+                auto const v = indices[t * 3 + k];
+                if (time - timestamps[v] > cacheSize) { timestamps[v] = time++; misses++; }
+            }
+            auto const runningAcmr = static_cast<float>(misses) / (t - start + 1);
+            if (t + 1 < last && runningAcmr <= clusterAcmr * threshold) {
+                clusters.push_back({ start, t + 1 - start, 0.0f });
+                start = t + 1;
+                misses = 0;
+                time += cacheSize + 1;  // @note the next cluster may be emitted anywhere, assume a cold cache
+            }
+        }
+        clusters.push_back({ start, last - start, 0.0f });
+    }
+
+    // sort key: how far a cluster faces outwards from the mesh center, those are likely to occlude the rest
+    double meshCentroid[3] = { 0.0, 0.0, 0.0 };
+    double meshArea = 0.0;
+    eastl::vector<float> clusterData(clusters.size() * 7, 0.0f);    // centroid * area, normal * area, area
+    for (auto c = 0u; c < clusters.size(); ++c) {
+        auto data = clusterData.data() + c * 7;
+        for (auto t = clusters[c].firstTriangle; t < clusters[c].firstTriangle + clusters[c].numTriangles; ++t) {
+            auto const a = GetPosition(vertices, vertexStride, indices[t * 3]);
+            auto const b = GetPosition(vertices, vertexStride, indices[t * 3 + 1]);
+            auto const p = GetPosition(vertices, vertexStride, indices[t * 3 + 2]);
+            float const e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+            float const e1[3] = { p[0] - a[0], p[1] - a[1], p[2] - a[2] };
+            float const n[3] = { e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0] };
+            auto const area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (auto k = 0; k < 3; ++k) {
+                auto const center = (a[k] + b[k] + p[k]) / 3.0f;
+                data[k] += center * area;
+                data[3 + k] += n[k];    // @note the cross product is already area weighted
+                meshCentroid[k] += center * area;
+            }
+            data[6] += area;
+            meshArea += area;
+        }
+    }
+    for (auto k = 0; k < 3; ++k) { meshCentroid[k] = meshArea > 0.0 ? meshCentroid[k] / meshArea : 0.0; }
+    for (auto c = 0u; c < clusters.size(); ++c) {
+        auto const data = clusterData.data() + c * 7;
+        float key = 0.0f;
+        if (data[6] > 0.0f) {
+            auto const normalLength = sqrtf(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+            for (auto k = 0; k < 3; ++k) {
+                auto const toCluster = data[k] / data[6] - static_cast<float>(meshCentroid[k]);
+                key += toCluster * (normalLength > 0.0f ? data[3 + k] / normalLength : 0.0f);
+            }
+        }
+        clusters[c].sortKey = key;
+    }
+    eastl::stable_sort(clusters.begin(), clusters.end(), [](Cluster const& a, Cluster const& b) { return a.sortKey > b.sortKey; });
+
+    eastl::vector<uint32_t> result(numIndices);
+    uint32_t offset = 0;
+    for (auto const& cluster : clusters) {
+        memcpy(result.data() + offset, indices + cluster.firstTriangle * 3, cluster.numTriangles * 3 * sizeof(uint32_t));
+        offset += cluster.numTriangles * 3;
+    }
+
+    // @note reordering clusters trades cache efficiency for overdraw, keep the input if that trade went over budget
+    auto const inputAcmr = AnalyzeVertexCache(indices, numIndices, numVertices, cacheSize).acmr;
+    auto const resultAcmr = AnalyzeVertexCache(result.data(), numIndices, numVertices, cacheSize).acmr;
+    memcpy(dst, resultAcmr <= inputAcmr * threshold ? result.data() : indices, numIndices * sizeof(uint32_t));
+}
+
+uint32_t mini::OptimizeVertexFetch(void* dst, uint32_t* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride)
+{
+    eastl::vector<uint32_t> remap(numVertices, INVALID_INDEX);
+    uint32_t numUnique = 0;
+    for (auto i = 0u; i < numIndices; ++i) {
+        auto& target = remap[indices[i]];
+        if (target == INVALID_INDEX) { target = numUnique++; }
+        indices[i] = target;
+    }
+    RemapVertices(dst, vertices, numVertices, vertexStride, remap.data());
+    return numUnique;
+}
+
+// -----------------------------------------------------------
+
+mini::VertexCacheStatistics mini::AnalyzeVertexCache(uint32_t const* indices, uint32_t numIndices, uint32_t numVertices, uint32_t cacheSize)
+{
+    VertexCacheStatistics stats;
+    if (numIndices == 0) { return stats; }
+
+    // @note FIFO cache, a vertex is a hit if it was inserted less than cacheSize insertions ago
+    eastl::vector<uint32_t> timestamps(numVertices, 0);
+    eastl::vector<bool> referenced(numVertices, false);
+    uint32_t time = cacheSize + 1;
+    uint32_t numUnique = 0;
+    for (auto i = 0u; i < numIndices; ++i) {
+        auto const v = indices[i];
+        if (time - timestamps[v] > cacheSize) {
+            timestamps[v] = time++;
+            stats.verticesTransformed++;
+        }
+        if (!referenced[v]) { referenced[v] = true; numUnique++; }
+    }
+    stats.acmr = static_cast<float>(stats.verticesTransformed) / (numIndices / 3);
+    stats.atvr = static_cast<float>(stats.verticesTransformed) / numUnique;
+    return stats;
+}
+
+mini::OverdrawStatistics mini::AnalyzeOverdraw(uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride)
+{
+    OverdrawStatistics stats;
+    if (numIndices == 0 || numVertices == 0) { return stats; }
+
+    // normalize into the unit cube so the raster resolution is independent of the mesh size
+    float minimum[3], maximum[3];
+    memcpy(minimum, GetPosition(vertices, vertexStride, 0), sizeof(minimum));
+    memcpy(maximum, minimum, sizeof(maximum));
+    for (auto v = 1u; v < numVertices; ++v) {
+        auto const p = GetPosition(vertices, vertexStride, v);
+        for (auto k = 0; k < 3; ++k) {
+            minimum[k] = p[k] < minimum[k] ? p[k] : minimum[k];
+            maximum[k] = p[k] > maximum[k] ? p[k] : maximum[k];
+        }
+    }
+    auto extent = 0.0f;
+    for (auto k = 0; k < 3; ++k) { extent = maximum[k] - minimum[k] > extent ? maximum[k] - minimum[k] : extent; }
+    auto const invExtent = extent > 0.0f ? 1.0f / extent : 0.0f;
+
+    // @note winding of a closed mesh decides which side is the front, the sign of its volume tells which convention it uses
+    double volume = 0.0;
+    for (auto i = 0u; i + 2 < numIndices; i += 3) {
+        auto const a = GetPosition(vertices, vertexStride, indices[i]);
+        auto const b = GetPosition(vertices, vertexStride, indices[i + 1]);
+        auto const c = GetPosition(vertices, vertexStride, indices[i + 2]);
+        volume += a[0] * (static_cast<double>(b[1]) * c[2] - static_cast<double>(b[2]) * c[1])
+            - a[1] * (static_cast<double>(b[0]) * c[2] - static_cast<double>(b[2]) * c[0])
+            + a[2] * (static_cast<double>(b[0]) * c[1] - static_cast<double>(b[1]) * c[0]);
+    }
+    auto const orientation = volume >= 0.0 ? 1.0f : -1.0f;
+
+    // six orthographic views along the axes, depth tested, back faces culled
+    constexpr int32_t RESOLUTION = 256;
+    eastl::vector<float> depthBuffer(RESOLUTION * RESOLUTION);
+    for (auto view = 0; view < 6; ++view) {
+        auto const axis = view / 2;
+        auto const direction = (view & 1) ? -1.0f : 1.0f;     // @note looking down +axis or -axis
+        auto const u = (axis + 1) % 3;
+        auto const w = (axis + 2) % 3;
+        for (auto& d : depthBuffer) { d = 2.0f; }
+
+        for (auto i = 0u; i + 2 < numIndices; i += 3) {
+            float p[3][3];
+            for (auto k = 0; k < 3; ++k) {
+                auto const src = GetPosition(vertices, vertexStride, indices[i + k]);
+                p[k][0] = (src[u] - minimum[u]) * invExtent * RESOLUTION;
+                p[k][1] = (src[w] - minimum[w]) * invExtent * RESOLUTION;
+                p[k][2] = (src[axis] - minimum[axis]) * invExtent;
+                if (direction < 0.0f) { p[k][2] = 1.0f - p[k][2]; }
+            }
+            // face normal along the view axis decides whether it faces the viewer
+            auto const area = (p[1][0] - p[0][0]) * (p[2][1] - p[0][1]) - (p[1][1] - p[0][1]) * (p[2][0] - p[0][0]);
+            if (area * direction * orientation >= 0.0f) { continue; }
+
+            auto const minX = static_cast<int32_t>(floorf(fminf(p[0][0], fminf(p[1][0], p[2][0]))));
+            auto const maxX = static_cast<int32_t>(ceilf(fmaxf(p[0][0], fmaxf(p[1][0], p[2][0]))));
+            auto const minY = static_cast<int32_t>(floorf(fminf(p[0][1], fminf(p[1][1], p[2][1]))));
+            auto const maxY = static_cast<int32_t>(ceilf(fmaxf(p[0][1], fmaxf(p[1][1], p[2][1]))));
+            auto const invArea = 1.0f / area;
+            for (auto y = minY < 0 ? 0 : minY; y <= maxY && y < RESOLUTION; ++y) {
+                for (auto x = minX < 0 ? 0 : minX; x <= maxX && x < RESOLUTION; ++x) {
+                    auto const px = x + 0.5f;
+                    auto const py = y + 0.5f;
+                    auto const w0 = ((p[2][0] - p[1][0]) * (py - p[1][1]) - (p[2][1] - p[1][1]) * (px - p[1][0])) * invArea;
+                    auto const w1 = ((p[0][0] - p[2][0]) * (py - p[2][1]) - (p[0][1] - p[2][1]) * (px - p[2][0])) * invArea;
+                    auto const w2 = 1.0f - w0 - w1;
+                    if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) { continue; }
+                    auto const depth = w0 * p[0][2] + w1 * p[1][2] + w2 * p[2][2];
+                    auto& stored = depthBuffer[y * RESOLUTION + x];
+                    if (depth < stored) {
+                        stored = depth;
+                        stats.pixelsShaded++;
+                    }
+                }
+            }
+        }
+        for (auto const d : depthBuffer) { stats.pixelsCovered += d < 2.0f ? 1 : 0; }
+    }
+    stats.overdraw = stats.pixelsCovered > 0 ? static_cast<float>(stats.pixelsShaded) / stats.pixelsCovered : 0.0f;
+    return stats;
+}
+
+mini::VertexFetchStatistics mini::AnalyzeVertexFetch(uint32_t const* indices, uint32_t numIndices, uint32_t numVertices, uint32_t vertexStride)
+{
+    VertexFetchStatistics stats;
+    if (numIndices == 0) { return stats; }
+
+    // @note    only post-transform cache misses (FIFO of 16) fetch, they go through a 16KB direct mapped cache with 64 byte lines,
+    //          roughly a vertex fetch L1
+    constexpr uint32_t CACHE_SIZE = 16;
+    constexpr uint32_t LINE_SIZE = 64;
+    constexpr uint32_t NUM_LINES = 256;
+    uint64_t lines[NUM_LINES];
+    for (auto& line : lines) { line = ~0ull; }
+
+    eastl::vector<uint32_t> timestamps(numVertices, 0);
+    eastl::vector<bool> referenced(numVertices, false);
+    uint32_t time = CACHE_SIZE + 1;
+    uint32_t numUnique = 0;
+    for (auto i = 0u; i < numIndices; ++i) {
+        auto const v = indices[i];
+        if (!referenced[v]) { referenced[v] = true; numUnique++; }
+        if (time - timestamps[v] <= CACHE_SIZE) { continue; }
+        timestamps[v] = time++;
+        auto const begin = static_cast<uint64_t>(v) * vertexStride;
+        auto const end = begin + vertexStride;
+        for (auto line = begin / LINE_SIZE; line <= (end - 1) / LINE_SIZE; ++line) {
+            auto& slot = lines[line % NUM_LINES];
+            if (slot != line) {
+                slot = line;
+                stats.bytesFetched += LINE_SIZE;
+            }
+        }
+    }
+    stats.overfetch = static_cast<float>(stats.bytesFetched) / (static_cast<float>(numUnique) * vertexStride);
+    return stats;
+}
+
+// -----------------------------------------------------------
+
+void mini::UnpackIndices(MeshData const& data, uint32_t* dst)
+{
+    auto const numIndices = data.indexDataSize / GetIndexFormatStride(data.indexFormat);
+    for (auto i = 0u; i < numIndices; ++i) {
+        if (data.indexFormat == IndexFormat::R16_UINT) {
+            uint16_t index;
+            memcpy(&index, data.indexData + i * sizeof(uint16_t), sizeof(index));
+            dst[i] = index;
+        }
+        else {
+            memcpy(&dst[i], data.indexData + i * sizeof(uint32_t), sizeof(uint32_t));
+        }
+    }
+}
+
+mini::IndexFormat mini::PackIndices(uint32_t const* indices, uint32_t numIndices, uint32_t numVertices, eastl::vector<char>* outIndexData)
+{
+    auto const indexFormat = numVertices <= 0xffff ? IndexFormat::R16_UINT : IndexFormat::R32_UINT;
+    outIndexData->resize(static_cast<size_t>(numIndices) * GetIndexFormatStride(indexFormat));
+    for (auto i = 0u; i < numIndices; ++i) {
+        if (indexFormat == IndexFormat::R16_UINT) {
+            auto const index = static_cast<uint16_t>(indices[i]);
+            memcpy(outIndexData->data() + i * sizeof(uint16_t), &index, sizeof(index));
+        }
+        else {
+            memcpy(outIndexData->data() + i * sizeof(uint32_t), &indices[i], sizeof(uint32_t));
+        }
+    }
+    return indexFormat;
+}
+
+bool mini::OptimizeMeshData(MeshData const& data, eastl::vector<char>* outVertexData, eastl::vector<char>* outIndexData, MeshData* outData)
+{
+    MINI_ASSERT(!IsQuantizedVertexFormat(data.vertexFormat), "Optimize meshes before quantizing them");
+    if (IsQuantizedVertexFormat(data.vertexFormat) || data.vertexStride == 0) { return false; }
+
+    auto const numVertices = data.vertexDataSize / data.vertexStride;
+    auto const numIndices = data.indexDataSize / GetIndexFormatStride(data.indexFormat);
+    eastl::vector<uint32_t> indices(numIndices);
+    UnpackIndices(data, indices.data());
+
+    // @note small tolerances so only what is the same vertex up to float noise gets merged
+    eastl::vector<uint32_t> remap(numVertices);
+    auto const numWelded = WeldVertices(data.vertexData, numVertices, data.vertexStride, 1e-6f, 1e-5f, remap.data());
+    eastl::vector<char> welded(static_cast<size_t>(numWelded) * data.vertexStride);
+    RemapVertices(welded.data(), data.vertexData, numVertices, data.vertexStride, remap.data());
+    RemapIndices(indices.data(), indices.data(), numIndices, remap.data());
+
+    eastl::vector<uint32_t> optimized(numIndices);
+    OptimizeVertexCache(optimized.data(), indices.data(), numIndices, numWelded);
+    OptimizeOverdraw(indices.data(), optimized.data(), numIndices, welded.data(), numWelded, data.vertexStride, 1.05f);
+
+    outVertexData->resize(welded.size());
+    auto const numFinal = OptimizeVertexFetch(outVertexData->data(), indices.data(), numIndices, welded.data(), numWelded, data.vertexStride);
+    outVertexData->resize(static_cast<size_t>(numFinal) * data.vertexStride);
+
+    auto const indexFormat = PackIndices(indices.data(), numIndices, numFinal, outIndexData);
+
+    *outData = data;
+    outData->vertexData = outVertexData->data();
+    outData->vertexDataSize = static_cast<uint32_t>(outVertexData->size());
+    outData->indexData = outIndexData->data();
+    outData->indexDataSize = static_cast<uint32_t>(outIndexData->size());
+    outData->indexFormat = indexFormat;
+    return true;
+}
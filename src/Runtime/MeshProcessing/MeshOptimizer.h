@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+
+#include <EASTL/vector.h>
+
+namespace mini
+{
+    /*
+        *   Cook time mesh optimization, run before quantization:
+        *       WeldVertices        merges duplicate vertices found through a spatial hash over the positions
+        *       OptimizeVertexCache reorders triangles for the post-transform cache (Forsyth, linear speed vertex cache optimisation)
+        *       OptimizeOverdraw    reorders clusters of the cache optimized list front to back as seen from outside, within an ACMR budget
+        *       OptimizeVertexFetch reorders vertices by first use so vertex fetch walks memory linearly
+        *   The Analyze* functions simulate the respective hardware behaviour so results can be checked without a GPU.
+        *   Vertices are read as float3 position at the start of every vertex, all other attributes are compared as floats.
+        *   Index buffers are always 32 bit, OptimizeMeshData converts from and to the MeshData index format.
+    */
+    struct VertexCacheStatistics
+    {
+        uint32_t    verticesTransformed = 0;
+        float       acmr = 0.0f;    // transformed vertices per triangle, 0.5 is the optimum for large regular meshes, 3 the worst case
+        float       atvr = 0.0f;    // transformed vertices per unique vertex, 1 is the optimum
+    };
+
+    struct OverdrawStatistics
+    {
+        uint32_t    pixelsCovered = 0;
+        uint32_t    pixelsShaded = 0;
+        float       overdraw = 0.0f;    // shaded per covered pixel, 1 is the optimum
+    };
+
+    struct VertexFetchStatistics
+    {
+        uint32_t    bytesFetched = 0;
+        float       overfetch = 0.0f;   // fetched bytes per byte of referenced vertex data, 1 is the optimum
+    };
+
+    // @note    fills outRemap with the new index of every vertex and returns the number of unique vertices.
+    //          vertices are equal if their positions are within positionEpsilon and all other attributes within attributeEpsilon
+    uint32_t                WeldVertices(void const* vertices, uint32_t numVertices, uint32_t vertexStride, float positionEpsilon, float attributeEpsilon, uint32_t* outRemap);
+    void                    RemapVertices(void* dst, void const* vertices, uint32_t numVertices, uint32_t vertexStride, uint32_t const* remap);
+    void                    RemapIndices(uint32_t* dst, uint32_t const* indices, uint32_t numIndices, uint32_t const* remap);
+
+    void                    OptimizeVertexCache(uint32_t* dst, uint32_t const* indices, uint32_t numIndices, uint32_t numVertices);
+    // @note threshold limits how much ACMR may degrade in exchange for less overdraw, e.g. 1.05 allows 5%
+    void                    OptimizeOverdraw(uint32_t* dst, uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride, float threshold);
+    // @note indices are remapped in place, unreferenced vertices are dropped. returns the number of vertices written to dst
+    uint32_t                OptimizeVertexFetch(void* dst, uint32_t* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride);
+
+    VertexCacheStatistics   AnalyzeVertexCache(uint32_t const* indices, uint32_t numIndices, uint32_t numVertices, uint32_t cacheSize = 16);
+    OverdrawStatistics      AnalyzeOverdraw(uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride);
+    VertexFetchStatistics   AnalyzeVertexFetch(uint32_t const* indices, uint32_t numIndices, uint32_t numVertices, uint32_t vertexStride);
+
+    // @note    conversion between MeshData index buffers and the 32 bit indices used by the cook stages,
+    //          PackIndices picks 16 bit indices whenever numVertices allows it
+    void                    UnpackIndices(MeshData const& data, uint32_t* dst);
+    IndexFormat             PackIndices(uint32_t const* indices, uint32_t numIndices, uint32_t numVertices, eastl::vector<char>* outIndexData);
+
+    // runs the full pipeline on data, outData references the storage in outVertexData / outIndexData
+    bool                    OptimizeMeshData(MeshData const& data, eastl::vector<char>* outVertexData, eastl::vector<char>* outIndexData, MeshData* outData);
+}
@@ -0,0 +1,293 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+#include <Runtime/common.h>
+
+#include <EASTL/sort.h>
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+namespace
+{
+    inline float const* GetVertex(void const* vertices, uint32_t stride, uint32_t index)
+    {
+        return reinterpret_cast<float const*>(static_cast<char const*>(vertices) + static_cast<size_t>(index) * stride);
+    }
+
+    // symmetric 4x4 matrix of the summed plane equations, error(p) = p'Ap + 2b'p + c
+    struct Quadric
+    {
+        double a00 = 0.0, a01 = 0.0, a02 = 0.0, a11 = 0.0, a12 = 0.0, a22 = 0.0;
+        double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+        double c = 0.0;
+        double weight = 0.0;
+
+        static Quadric FromPlane(double const* n, double d, double weight)
+        {
+            Quadric q;
+            q.a00 = weight * n[0] * n[0]; q.a01 = weight * n[0] * n[1]; q.a02 = weight * n[0] * n[2];
+            q.a11 = weight * n[1] * n[1]; q.a12 = weight * n[1] * n[2]; q.a22 = weight * n[2] * n[2];
+            q.b0 = weight * n[0] * d; q.b1 = weight * n[1] * d; q.b2 = weight * n[2] * d;
+            q.c = weight * d * d;
+            q.weight = weight;
+            return q;
+        }
+
+        void Add(Quadric const& o)
+        {
+            a00 += o.a00; a01 += o.a01; a02 += o.a02; a11 += o.a11; a12 += o.a12; a22 += o.a22;
+            b0 += o.b0; b1 += o.b1; b2 += o.b2;
+            c += o.c;
+            weight += o.weight;
+        }
+
+        // @note normalized by the accumulated area, so this is a mean squared distance
+        double Evaluate(float const* p) const
+        {
+            double const x = p[0], y = p[1], z = p[2];
+            auto const error = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + a11 * y * y + 2.0 * a12 * y * z + a22 * z * z
+                + 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+            return weight > 0.0 ? (error > 0.0 ? error : 0.0) / weight : 0.0;
+        }
+    };
+
+    struct Collapse
+    {
+        uint32_t    from;
+        uint32_t    to;
+        float       cost;
+    };
+
+    float ComputeExtent(void const* vertices, uint32_t numVertices, uint32_t vertexStride)
+    {
+        float minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        for (auto v = 0u; v < numVertices; ++v) {
+            auto const p = GetVertex(vertices, vertexStride, v);
+            for (auto k = 0; k < 3; ++k) {
+                minimum[k] = p[k] < minimum[k] ? p[k] : minimum[k];
+                maximum[k] = p[k] > maximum[k] ? p[k] : maximum[k];
+            }
+        }
+        auto extent = 0.0f;
+        for (auto k = 0; k < 3 && numVertices > 0; ++k) { extent = maximum[k] - minimum[k] > extent ? maximum[k] - minimum[k] : extent; }
+        return extent;
+    }
+
+    void TriangleNormal(float const* a, float const* b, float const* c, double* out)
+    {
+        double const e0[3] = { static_cast<double>(b[0]) - a[0], static_cast<double>(b[1]) - a[1], static_cast<double>(b[2]) - a[2] };
+        double const e1[3] = { static_cast<double>(c[0]) - a[0], static_cast<double>(c[1]) - a[1], static_cast<double>(c[2]) - a[2] };
+        out[0] = e0[1] * e1[2] - e0[2] * e1[1];
+        out[1] = e0[2] * e1[0] - e0[0] * e1[2];
+        out[2] = e0[0] * e1[1] - e0[1] * e1[0];
+    }
+}
+
+uint32_t mini::SimplifyMesh(uint32_t* dst, uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride,
+    uint32_t targetIndexCount, SimplifySettings const& settings, float* outError)
+{
+    MINI_ASSERT(vertexStride % sizeof(float) == 0 && vertexStride >= sizeof(float) * 3, "Vertices must be float attributes starting with a position");
+    memcpy(dst, indices, numIndices * sizeof(uint32_t));
+    *outError = 0.0f;
+    auto const numFloats = vertexStride / sizeof(float);
+    auto const extent = ComputeExtent(vertices, numVertices, vertexStride);
+    if (numIndices <= targetIndexCount || extent <= 0.0f) { return numIndices; }
+
+    // @note    attribute seams are vertices sharing their position with another one, collapsing only one side would tear the mesh open.
+    //          positions are welded exactly for that, all attributes compare equal with an infinite epsilon
+    eastl::vector<uint32_t> positionIds(numVertices);
+    auto const numPositions = WeldVertices(vertices, numVertices, vertexStride, 0.0f, FLT_MAX, positionIds.data());
+    eastl::vector<uint32_t> verticesPerPosition(numPositions, 0);
+    for (auto v = 0u; v < numVertices; ++v) { verticesPerPosition[positionIds[v]]++; }
+    eastl::vector<bool> locked(numVertices, false);
+    for (auto v = 0u; v < numVertices; ++v) { locked[v] = verticesPerPosition[positionIds[v]] > 1; }
+
+    // open borders: a directed edge without its reverse, compared by position so seams don't count as borders
+    {
+        eastl::vector<uint64_t> edges;
+        edges.reserve(numIndices);
+        for (auto i = 0u; i < numIndices; i += 3) {
+            for (auto k = 0u; k < 3; ++k) {
+                auto const a = positionIds[indices[i + k]];
+                auto const b = positionIds[indices[i + (k + 1) % 3]];
+                edges.push_back((static_cast<uint64_t>(a) << 32) | b);
+            }
+        }
+        eastl::sort(edges.begin(), edges.end());
+        for (auto i = 0u; i < numIndices; i += 3) {
+            for (auto k = 0u; k < 3; ++k) {
+                auto const a = positionIds[indices[i + k]];
+                auto const b = positionIds[indices[i + (k + 1) % 3]];
+                auto const reverse = (static_cast<uint64_t>(b) << 32) | a;
+                auto const it = eastl::lower_bound(edges.begin(), edges.end(), reverse);
+                if (it == edges.end() || *it != reverse) {
+                    locked[indices[i + k]] = locked[indices[i + (k + 1) % 3]] = true;
+                }
+            }
+        }
+    }
+
+    eastl::vector<Quadric> quadrics(numVertices);
+    for (auto i = 0u; i < numIndices; i += 3) {
+        auto const p0 = GetVertex(vertices, vertexStride, indices[i]);
+        double n[3];
+        TriangleNormal(p0, GetVertex(vertices, vertexStride, indices[i + 1]), GetVertex(vertices, vertexStride, indices[i + 2]), n);
+        auto const length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (length <= 0.0) { continue; }
+        for (auto k = 0; k < 3; ++k) { n[k] /= length; }
+        auto const quadric = Quadric::FromPlane(n, -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]), length * 0.5);
+        for (auto k = 0u; k < 3; ++k) { quadrics[indices[i + k]].Add(quadric); }
+    }
+
+    auto const maxCost = static_cast<double>(settings.targetError) * extent * settings.targetError * extent;
+    auto const attributeScale = static_cast<double>(settings.attributeWeight) * extent * settings.attributeWeight * extent;
+    auto const collapseCost = [&](uint32_t from, uint32_t to) {
+        auto const a = GetVertex(vertices, vertexStride, from);
+        auto const b = GetVertex(vertices, vertexStride, to);
+        auto cost = quadrics[from].Evaluate(b);
+        double attributeError = 0.0;
+        for (auto k = 3u; k < numFloats; ++k) { attributeError += static_cast<double>(a[k] - b[k]) * (a[k] - b[k]); }
+        return cost + attributeError * attributeScale;
+    };
+
+    eastl::vector<uint32_t> adjacencyOffsets(numVertices + 1);
+    eastl::vector<uint32_t> adjacency;
+    eastl::vector<Collapse> collapses;
+    eastl::vector<uint32_t> remap(numVertices);
+    for (auto v = 0u; v < numVertices; ++v) { remap[v] = v; }
+    eastl::vector<uint32_t> touched(numVertices, 0);
+    uint32_t pass = 0;
+    double highestError = 0.0;
+
+    // @note    every pass collapses the cheapest edges whose neighbourhoods don't overlap, then rebuilds the index list.
+    //          that avoids keeping a priority queue up to date and needs only a handful of passes per halving
+    auto count = numIndices;
+    while (count > targetIndexCount) {
+        pass++;
+        for (auto& offset : adjacencyOffsets) { offset = 0; }
+        for (auto i = 0u; i < count; ++i) { adjacencyOffsets[dst[i] + 1]++; }
+        for (auto v = 0u; v < numVertices; ++v) { adjacencyOffsets[v + 1] += adjacencyOffsets[v]; }
+        adjacency.resize(count);
+        {
+            eastl::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (auto i = 0u; i < count; ++i) { adjacency[fill[dst[i]]++] = i / 3; }
+        }
+
+        collapses.clear();
+        for (auto i = 0u; i < count; i += 3) {
+            for (auto k = 0u; k < 3; ++k) {
+                auto const a = dst[i + k];
+                auto const b = dst[i + (k + 1) % 3];
+                if (a > b) { continue; }   // @note each edge once, interior edges still show up from both triangles
+                auto const costAB = locked[a] ? DBL_MAX : collapseCost(a, b);
+                auto const costBA = locked[b] ? DBL_MAX : collapseCost(b, a);
+                if (costAB == DBL_MAX && costBA == DBL_MAX) { continue; }
+                collapses.push_back(costAB <= costBA ? Collapse{ a, b, static_cast<float>(costAB) } : Collapse{ b, a, static_cast<float>(costBA) });
+            }
+        }
+        eastl::sort(collapses.begin(), collapses.end(), [](Collapse const& x, Collapse const& y) { return x.cost < y.cost; });
+
+        uint32_t removed = 0;
+        uint32_t applied = 0;
+        for (auto const& collapse : collapses) {
+            if (collapse.cost > maxCost || count - removed <= targetIndexCount) { break; }
+            if (touched[collapse.from] == pass || touched[collapse.to] == pass) { continue; }
+
+            // reject collapses that flip a remaining triangle around the moving vertex
+            auto const target = GetVertex(vertices, vertexStride, collapse.to);
+            bool flips = false;
+            uint32_t collapsing = 0;
+            for (auto a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1] && !flips; ++a) {
+                auto const tri = dst + adjacency[a] * 3;
+                if (tri[0] == collapse.to || tri[1] == collapse.to || tri[2] == collapse.to) {
+                    collapsing++;
+                    continue;
+                }
+                float const* before[3];
+                float const* after[3];
+                for (auto k = 0; k < 3; ++k) {
+                    before[k] = GetVertex(vertices, vertexStride, tri[k]);
+                    after[k] = tri[k] == collapse.from ? target : before[k];
+                }
+                double n0[3], n1[3];
+                TriangleNormal(before[0], before[1], before[2], n0);
+                TriangleNormal(after[0], after[1], after[2], n1);
+                flips = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2] <= 0.0;
+            }
+            if (flips) { continue; }
+
+            // @note the reported error is geometric only, attributes just steer which collapses go first
+            auto const error = quadrics[collapse.from].Evaluate(target);
+            highestError = error > highestError ? error : highestError;
+            remap[collapse.from] = collapse.to;
+            quadrics[collapse.to].Add(quadrics[collapse.from]);
+            for (auto a = adjacencyOffsets[collapse.from]; a < adjacencyOffsets[collapse.from + 1]; ++a) {
+                auto const tri = dst + adjacency[a] * 3;
+                touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = pass;
+            }
+            removed += collapsing * 3;
+            applied++;
+        }
+        if (applied == 0) { break; }
+
+        auto write = 0u;
+        for (auto i = 0u; i < count; i += 3) {
+            uint32_t const tri[3] = { remap[dst[i]], remap[dst[i + 1]], remap[dst[i + 2]] };
+            if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) { continue; }
+            memcpy(dst + write, tri, sizeof(tri));
+            write += 3;
+        }
+        count = write;
+        for (auto i = 0u; i < count; ++i) { remap[dst[i]] = dst[i]; }
+    }
+
+    *outError = static_cast<float>(sqrt(highestError)) / extent;
+    return count;
+}
+
+bool mini::BuildLodChainForMeshData(MeshData const& data, LodChainSettings const& settings, eastl::vector<char>* outIndexData, eastl::vector<MeshLod>* outLods, MeshData* outData)
+{
+    MINI_ASSERT(!IsQuantizedVertexFormat(data.vertexFormat), "Build LODs before quantizing the mesh");
+    if (IsQuantizedVertexFormat(data.vertexFormat) || data.vertexStride == 0) { return false; }
+
+    auto const numVertices = data.vertexDataSize / data.vertexStride;
+    auto const numIndices = data.indexDataSize / GetIndexFormatStride(data.indexFormat);
+    auto const extent = ComputeExtent(data.vertexData, numVertices, data.vertexStride);
+    eastl::vector<uint32_t> combined(numIndices);
+    UnpackIndices(data, combined.data());
+
+    outLods->clear();
+    outLods->push_back({ 0, numIndices, 0, 0, 0.0f });
+
+    // @note every LOD is simplified from the full mesh rather than the previous LOD, so errors don't compound
+    eastl::vector<uint32_t> simplified(numIndices);
+    eastl::vector<uint32_t> optimized(numIndices);
+    SimplifySettings simplifySettings;
+    simplifySettings.targetError = settings.maxError;
+    simplifySettings.attributeWeight = settings.attributeWeight;
+    auto previousCount = numIndices;
+    while (outLods->size() < MAX_MESH_LODS) {
+        auto const targetCount = static_cast<uint32_t>(previousCount / 3 * settings.reductionPerLod) * 3;
+        if (targetCount / 3 < settings.minTriangles) { break; }
+
+        float error = 0.0f;
+        auto const count = SimplifyMesh(simplified.data(), combined.data(), numIndices, data.vertexData, numVertices, data.vertexStride, targetCount, simplifySettings, &error);
+        if (count > previousCount - previousCount / 8) { break; }     // @note stuck on the error limit or locked vertices, another LOD wouldn't pay off
+
+        OptimizeVertexCache(optimized.data(), simplified.data(), count, numVertices);
+        auto const lodError = error * extent > outLods->back().error ? error * extent : outLods->back().error;
+        outLods->push_back({ static_cast<uint32_t>(combined.size()), count, 0, 0, lodError });
+        combined.insert(combined.end(), optimized.begin(), optimized.begin() + count);
+        previousCount = count;
+    }
+
+    *outData = data;
+    outData->indexFormat = PackIndices(combined.data(), static_cast<uint32_t>(combined.size()), numVertices, outIndexData);
+    outData->indexData = outIndexData->data();
+    outData->indexDataSize = static_cast<uint32_t>(outIndexData->size());
+    outData->lods = outLods->data();
+    outData->numLods = static_cast<uint32_t>(outLods->size());
+    return true;
+}
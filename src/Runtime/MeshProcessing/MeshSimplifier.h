@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+
+#include <EASTL/vector.h>
+
+namespace mini
+{
+    /*
+        *   Cook time mesh simplification by edge collapses ordered by quadric error (Garland / Heckbert).
+        *   Vertices only ever collapse onto a neighbour, so every LOD is just another index list over the original vertex buffer.
+        *   The cost of a collapse is the area weighted quadric distance plus the squared difference of all attributes after the
+        *   position, scaled by attributeWeight, so normals and UVs hold where they change quickly.
+        *   Vertices on open borders and on attribute seams (several vertices sharing a position) are locked to keep the mesh closed.
+        *   Errors are relative to the largest extent of the mesh's AABB.
+    */
+    struct SimplifySettings
+    {
+        float   targetError = 0.01f;        // collapses costing more than this are skipped
+        float   attributeWeight = 0.25f;    // @note an attribute difference of 1 costs as much as this fraction of the extent
+    };
+
+    // @note    writes at most numIndices indices to dst and returns how many were written, outError receives the relative error
+    //          of the most expensive collapse, geometry only. the result can end up above targetIndexCount if the error limit is reached first
+    uint32_t    SimplifyMesh(uint32_t* dst, uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride,
+                    uint32_t targetIndexCount, SimplifySettings const& settings, float* outError);
+
+    struct LodChainSettings
+    {
+        float       reductionPerLod = 0.5f;     // triangle count of a LOD relative to the previous one
+        float       maxError = 0.05f;           // relative error at which the chain stops
+        float       attributeWeight = 0.25f;
+        uint32_t    minTriangles = 32;
+    };
+
+    // @note    builds up to MAX_MESH_LODS LODs into one index buffer, LOD 0 being the input. LOD errors are stored in object space units,
+    //          outData references the indices in outIndexData and the LODs in outLods
+    bool        BuildLodChainForMeshData(MeshData const& data, LodChainSettings const& settings, eastl::vector<char>* outIndexData, eastl::vector<MeshLod>* outLods, MeshData* outData);
+}
@@ -0,0 +1,228 @@
+#include "MeshletBuilder.h"
+#include "MeshOptimizer.h"
+#include <Runtime/common.h>
+
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+namespace
+{
+    constexpr uint32_t INVALID_INDEX = 0xffffffff;
+    constexpr float CONE_WEIGHT = 0.5f;     // @note how much a diverging normal counts against a candidate, relative to one new vertex
+
+    inline float const* GetPosition(void const* vertices, uint32_t stride, uint32_t index)
+    {
+        return reinterpret_cast<float const*>(static_cast<char const*>(vertices) + static_cast<size_t>(index) * stride);
+    }
+
+    // unit normal of the triangle, returns false for degenerate triangles
+    bool ComputeTriangleNormal(float const* a, float const* b, float const* c, float* outNormal)
+    {
+        float const e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+        float const e1[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+        outNormal[0] = e0[1] * e1[2] - e0[2] * e1[1];
+        outNormal[1] = e0[2] * e1[0] - e0[0] * e1[2];
+        outNormal[2] = e0[0] * e1[1] - e0[1] * e1[0];
+        auto const length = sqrtf(outNormal[0] * outNormal[0] + outNormal[1] * outNormal[1] + outNormal[2] * outNormal[2]);
+        if (length <= 0.0f) {
+            outNormal[0] = outNormal[1] = outNormal[2] = 0.0f;
+            return false;
+        }
+        for (auto k = 0; k < 3; ++k) { outNormal[k] /= length; }
+        return true;
+    }
+}
+
+uint32_t mini::BuildMeshlets(uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride,
+    uint32_t maxVertices, uint32_t maxTriangles, uint32_t* outIndices, eastl::vector<Meshlet>* outMeshlets)
+{
+    MINI_ASSERT(maxVertices >= 3 && maxVertices <= MAX_MESHLET_VERTICES, "Meshlet vertex limit out of range");
+    MINI_ASSERT(maxTriangles >= 1 && maxTriangles <= MAX_MESHLET_TRIANGLES, "Meshlet triangle limit out of range");
+    auto const numTriangles = numIndices / 3;
+
+    eastl::vector<float> normals(static_cast<size_t>(numTriangles) * 3);
+    for (auto t = 0u; t < numTriangles; ++t) {
+        ComputeTriangleNormal(GetPosition(vertices, vertexStride, indices[t * 3]), GetPosition(vertices, vertexStride, indices[t * 3 + 1]),
+            GetPosition(vertices, vertexStride, indices[t * 3 + 2]), normals.data() + t * 3);
+    }
+
+    // vertex -> triangle adjacency
+    eastl::vector<uint32_t> adjacencyOffsets(numVertices + 1, 0);
+    for (auto i = 0u; i < numIndices; ++i) { adjacencyOffsets[indices[i] + 1]++; }
+    for (auto v = 0u; v < numVertices; ++v) { adjacencyOffsets[v + 1] += adjacencyOffsets[v]; }
+    eastl::vector<uint32_t> adjacency(numIndices);
+    {
+        eastl::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (auto i = 0u; i < numIndices; ++i) { adjacency[fill[indices[i]]++] = i / 3; }
+    }
+
+    // @note tags hold the id of the meshlet that last touched a vertex / triangle, so nothing needs clearing between meshlets
+    eastl::vector<uint32_t> vertexTags(numVertices, INVALID_INDEX);
+    eastl::vector<uint32_t> candidateTags(numTriangles, INVALID_INDEX);
+    eastl::vector<bool> emitted(numTriangles, false);
+    eastl::vector<uint32_t> candidates;
+    eastl::vector<uint32_t> meshletTriangles;
+    meshletTriangles.reserve(maxTriangles);
+
+    uint32_t numEmitted = 0;
+    uint32_t cursor = 0;
+    uint32_t outIndex = 0;
+    uint32_t numMeshlets = 0;
+    while (numEmitted < numTriangles) {
+        auto const meshletId = numMeshlets;
+        uint32_t numMeshletVertices = 0;
+        float axis[3] = { 0.0f, 0.0f, 0.0f };
+        meshletTriangles.clear();
+        candidates.clear();
+
+        while (emitted[cursor]) { cursor++; }
+        auto next = cursor;
+        while (next != INVALID_INDEX) {
+            emitted[next] = true;
+            numEmitted++;
+            meshletTriangles.push_back(next);
+            for (auto k = 0; k < 3; ++k) {
+                auto const v = indices[next * 3 + k];
+                if (vertexTags[v] == meshletId) { continue; }
+                vertexTags[v] = meshletId;
+                numMeshletVertices++;
+                for (auto a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; ++a) {
+                    auto const t = adjacency[a];
+                    if (!emitted[t] && candidateTags[t] != meshletId) {
+                        candidateTags[t] = meshletId;
+                        candidates.push_back(t);
+                    }
+                }
+            }
+            for (auto k = 0; k < 3; ++k) { axis[k] += normals[next * 3 + k]; }
+            if (meshletTriangles.size() == maxTriangles || numEmitted == numTriangles) { break; }
+
+            auto const axisLength = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+            auto const invAxisLength = axisLength > 0.0f ? 1.0f / axisLength : 0.0f;
+            next = INVALID_INDEX;
+            auto bestScore = FLT_MAX;
+            for (auto c = 0u; c < candidates.size();) {
+                auto const t = candidates[c];
+                if (emitted[t]) {
+                    candidates[c] = candidates.back();
+                    candidates.pop_back();
+                    continue;
+                }
+                ++c;
+                uint32_t newVertices = 0;
+                for (auto k = 0; k < 3; ++k) { newVertices += vertexTags[indices[t * 3 + k]] != meshletId ? 1 : 0; }
+                if (numMeshletVertices + newVertices > maxVertices) { continue; }
+                auto const n = normals.data() + t * 3;
+                auto const alignment = (n[0] * axis[0] + n[1] * axis[1] + n[2] * axis[2]) * invAxisLength;
+                auto const score = newVertices + CONE_WEIGHT * (1.0f - alignment);
+                if (score < bestScore) {
+                    bestScore = score;
+                    next = t;
+                }
+            }
+            // @note    nothing connected fits anymore, e.g. the meshlet covers a whole small part. continue with the next triangle
+            //          in input order, which MeshOptimizer already made spatially coherent
+            if (next == INVALID_INDEX && numMeshletVertices + 3 <= maxVertices) {
+                while (emitted[cursor]) { cursor++; }
+                next = cursor;
+            }
+        }
+
+        Meshlet meshlet;
+        meshlet.firstIndex = outIndex;
+        meshlet.numIndices = static_cast<uint32_t>(meshletTriangles.size()) * 3;
+        for (auto const t : meshletTriangles) {
+            memcpy(outIndices + outIndex, indices + t * 3, sizeof(uint32_t) * 3);
+            outIndex += 3;
+        }
+        ComputeMeshletBounds(outIndices + meshlet.firstIndex, meshlet.numIndices, vertices, vertexStride, &meshlet);
+        outMeshlets->push_back(meshlet);
+        numMeshlets++;
+    }
+    return numMeshlets;
+}
+
+void mini::ComputeMeshletBounds(uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t vertexStride, Meshlet* outMeshlet)
+{
+    float minimum[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float maximum[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+    for (auto i = 0u; i < numIndices; ++i) {
+        auto const p = GetPosition(vertices, vertexStride, indices[i]);
+        for (auto k = 0; k < 3; ++k) {
+            minimum[k] = p[k] < minimum[k] ? p[k] : minimum[k];
+            maximum[k] = p[k] > maximum[k] ? p[k] : maximum[k];
+        }
+    }
+    auto radiusSquared = 0.0f;
+    for (auto k = 0; k < 3; ++k) { outMeshlet->center[k] = (minimum[k] + maximum[k]) * 0.5f; }
+    for (auto i = 0u; i < numIndices; ++i) {
+        auto const p = GetPosition(vertices, vertexStride, indices[i]);
+        float const d[3] = { p[0] - outMeshlet->center[0], p[1] - outMeshlet->center[1], p[2] - outMeshlet->center[2] };
+        auto const distanceSquared = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+        radiusSquared = distanceSquared > radiusSquared ? distanceSquared : radiusSquared;
+    }
+    outMeshlet->radius = sqrtf(radiusSquared);
+
+    // @note the cone's axis is the average normal, its angle is set by the normal that deviates most from it
+    float axis[3] = { 0.0f, 0.0f, 0.0f };
+    for (auto i = 0u; i + 2 < numIndices; i += 3) {
+        float n[3];
+        if (ComputeTriangleNormal(GetPosition(vertices, vertexStride, indices[i]), GetPosition(vertices, vertexStride, indices[i + 1]), GetPosition(vertices, vertexStride, indices[i + 2]), n)) {
+            for (auto k = 0; k < 3; ++k) { axis[k] += n[k]; }
+        }
+    }
+    auto const axisLength = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+    outMeshlet->coneCutoff = 1.0f;
+    if (axisLength <= 0.0f) {
+        outMeshlet->coneAxis[0] = outMeshlet->coneAxis[1] = outMeshlet->coneAxis[2] = 0.0f;
+        return;
+    }
+    for (auto k = 0; k < 3; ++k) { outMeshlet->coneAxis[k] = axis[k] / axisLength; }
+
+    auto minimumDot = 1.0f;
+    for (auto i = 0u; i + 2 < numIndices; i += 3) {
+        float n[3];
+        if (ComputeTriangleNormal(GetPosition(vertices, vertexStride, indices[i]), GetPosition(vertices, vertexStride, indices[i + 1]), GetPosition(vertices, vertexStride, indices[i + 2]), n)) {
+            auto const d = n[0] * outMeshlet->coneAxis[0] + n[1] * outMeshlet->coneAxis[1] + n[2] * outMeshlet->coneAxis[2];
+            minimumDot = d < minimumDot ? d : minimumDot;
+        }
+    }
+    // @note cones close to a hemisphere or wider practically never cull anything, those are disabled
+    outMeshlet->coneCutoff = minimumDot <= 0.1f ? 1.0f : sqrtf(1.0f - minimumDot * minimumDot);
+}
+
+bool mini::BuildMeshletsForMeshData(MeshData const& data, eastl::vector<char>* outIndexData, eastl::vector<Meshlet>* outMeshlets, eastl::vector<MeshLod>* outLods, MeshData* outData)
+{
+    MINI_ASSERT(!IsQuantizedVertexFormat(data.vertexFormat), "Build meshlets before quantizing the mesh");
+    if (IsQuantizedVertexFormat(data.vertexFormat) || data.vertexStride == 0) { return false; }
+
+    auto const numVertices = data.vertexDataSize / data.vertexStride;
+    auto const numIndices = data.indexDataSize / GetIndexFormatStride(data.indexFormat);
+    eastl::vector<uint32_t> indices(numIndices);
+    UnpackIndices(data, indices.data());
+
+    outLods->clear();
+    if (data.numLods > 0) { outLods->insert(outLods->end(), data.lods, data.lods + data.numLods); }
+    else { outLods->push_back({ 0, numIndices, 0, 0, 0.0f }); }
+
+    // @note every LOD gets its own meshlets, their index ranges stay relative to the whole index buffer
+    eastl::vector<uint32_t> meshletIndices(numIndices);
+    outMeshlets->clear();
+    for (auto& lod : *outLods) {
+        lod.firstMeshlet = static_cast<uint32_t>(outMeshlets->size());
+        lod.numMeshlets = BuildMeshlets(indices.data() + lod.firstIndex, lod.numIndices, data.vertexData, numVertices, data.vertexStride,
+            MAX_MESHLET_VERTICES, MAX_MESHLET_TRIANGLES, meshletIndices.data() + lod.firstIndex, outMeshlets);
+        for (auto m = lod.firstMeshlet; m < lod.firstMeshlet + lod.numMeshlets; ++m) { (*outMeshlets)[m].firstIndex += lod.firstIndex; }
+    }
+
+    *outData = data;
+    outData->indexFormat = PackIndices(meshletIndices.data(), numIndices, numVertices, outIndexData);
+    outData->indexData = outIndexData->data();
+    outData->indexDataSize = static_cast<uint32_t>(outIndexData->size());
+    outData->meshlets = outMeshlets->data();
+    outData->numMeshlets = static_cast<uint32_t>(outMeshlets->size());
+    outData->lods = outLods->data();
+    outData->numLods = static_cast<uint32_t>(outLods->size());
+    return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+
+#include <EASTL/vector.h>
+
+namespace mini
+{
+    /*
+        *   Cook time meshlet generation, run after MeshOptimizer and MeshSimplifier, before quantization.
+        *   Triangles are grouped greedily: a meshlet grows by the adjacent triangle that adds the fewest new vertices and whose
+        *   normal deviates least from the meshlet's, and is closed once it hits its vertex or triangle limit. The index buffer is
+        *   rewritten so every meshlet is a contiguous range, then each gets a bounding sphere and a normal cone for culling.
+        *   Vertices are read as float3 position at the start of every vertex.
+    */
+
+    // @note    writes the reordered indices to outIndices (numIndices entries) and appends the meshlets, returns the number of meshlets.
+    //          maxVertices and maxTriangles can't exceed MAX_MESHLET_VERTICES / MAX_MESHLET_TRIANGLES
+    uint32_t    BuildMeshlets(uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t numVertices, uint32_t vertexStride,
+                    uint32_t maxVertices, uint32_t maxTriangles, uint32_t* outIndices, eastl::vector<Meshlet>* outMeshlets);
+
+    // bounding sphere and normal cone of the triangles in indices, firstIndex / numIndices are left alone
+    void        ComputeMeshletBounds(uint32_t const* indices, uint32_t numIndices, void const* vertices, uint32_t vertexStride, Meshlet* outMeshlet);
+
+    // @note    builds meshlets for every LOD of data, or for the whole mesh if it has none. outData references the reordered indices
+    //          in outIndexData, the meshlets in outMeshlets and the LODs, now with their meshlet ranges, in outLods
+    bool        BuildMeshletsForMeshData(MeshData const& data, eastl::vector<char>* outIndexData, eastl::vector<Meshlet>* outMeshlets, eastl::vector<MeshLod>* outLods, MeshData* outData);
+}
@@ -0,0 +1,233 @@
+#include "StaticBatchBuilder.h"
+#include "MeshOptimizer.h"
+#include <Runtime/common.h>
+#include <Runtime/Culling/MeshBounds.h>
+
+#include <EASTL/sort.h>
+#include <EASTL/algorithm.h>
+#include <float.h>
+#include <string.h>
+
+namespace
+{
+    struct SourceInfo
+    {
+        float       worldMin[3];
+        float       worldMax[3];
+        float       center[3];
+        uint32_t    numVertices;
+        uint32_t    firstIndex;     // LOD 0's range
+        uint32_t    numIndices;
+        uint64_t    groupKey;       // [vertex format:32 | material key:32]
+    };
+
+    void Cross(float const* a, float const* b, float* out)
+    {
+        out[0] = a[1] * b[2] - a[2] * b[1];
+        out[1] = a[2] * b[0] - a[0] * b[2];
+        out[2] = a[0] * b[1] - a[1] * b[0];
+    }
+
+    // rotates v by the unit quaternion q (xyzw)
+    void Rotate(float const* q, float const* v, float* out)
+    {
+        float t[3];
+        Cross(q, v, t);
+        for (auto k = 0; k < 3; ++k) { t[k] *= 2.0f; }
+        float c[3];
+        Cross(q, t, c);
+        for (auto k = 0; k < 3; ++k) { out[k] = v[k] + q[3] * t[k] + c[k]; }
+    }
+
+    void TransformPoint(mini::StaticBatchSource const& source, float const* p, float* out)
+    {
+        float const scaled[3] = { p[0] * source.scale, p[1] * source.scale, p[2] * source.scale };
+        Rotate(source.rotation, scaled, out);
+        for (auto k = 0; k < 3; ++k) { out[k] += source.position[k]; }
+    }
+
+    // @note uniform scale only, so directions just rotate. tangent w (the bitangent sign) is left alone
+    void TransformVertex(mini::StaticBatchSource const& source, mini::VertexFormat format, char const* src, char* dst)
+    {
+        auto const stride = mini::GetVertexFormatStride(format);
+        memcpy(dst, src, stride);
+        float v[3], out[3];
+        memcpy(v, src, sizeof(v));
+        TransformPoint(source, v, out);
+        memcpy(dst, out, sizeof(out));
+        memcpy(v, src + 12, sizeof(v));
+        Rotate(source.rotation, v, out);
+        memcpy(dst + 12, out, sizeof(out));
+        if (format == mini::VertexFormat::PositionNormalTangentUV) {
+            memcpy(v, src + 24, sizeof(v));
+            Rotate(source.rotation, v, out);
+            memcpy(dst + 24, out, sizeof(out));
+        }
+    }
+
+    bool GetSourceInfo(mini::StaticBatchSource const& source, mini::StaticBatchSettings const& settings, SourceInfo* outInfo)
+    {
+        auto const data = source.data;
+        if (data == nullptr || mini::IsQuantizedVertexFormat(data->vertexFormat) || data->vertexStride != mini::GetVertexFormatStride(data->vertexFormat)) {
+            return false;
+        }
+        SourceInfo info;
+        info.numVertices = data->vertexDataSize / data->vertexStride;
+        info.firstIndex = data->numLods > 0 ? data->lods[0].firstIndex : 0;
+        info.numIndices = data->numLods > 0 ? data->lods[0].numIndices : data->indexDataSize / mini::GetIndexFormatStride(data->indexFormat);
+        // @note the vertex count is an upper bound, LOD 0 usually references all of them
+        if (info.numIndices == 0 || info.numVertices == 0 || info.numVertices > settings.maxClusterVertices) { return false; }
+        info.groupKey = (static_cast<uint64_t>(data->vertexFormat) << 32) | source.materialKey;
+
+        auto const bounds = data->bounds != nullptr ? *data->bounds : mini::ComputeMeshBounds(data->vertexData, info.numVertices, data->vertexStride);
+        for (auto k = 0; k < 3; ++k) {
+            info.worldMin[k] = FLT_MAX;
+            info.worldMax[k] = -FLT_MAX;
+        }
+        for (auto corner = 0; corner < 8; ++corner) {
+            float const p[3] = {
+                (corner & 1) ? bounds.aabbMax[0] : bounds.aabbMin[0],
+                (corner & 2) ? bounds.aabbMax[1] : bounds.aabbMin[1],
+                (corner & 4) ? bounds.aabbMax[2] : bounds.aabbMin[2] };
+            float world[3];
+            TransformPoint(source, p, world);
+            for (auto k = 0; k < 3; ++k) {
+                info.worldMin[k] = eastl::min(info.worldMin[k], world[k]);
+                info.worldMax[k] = eastl::max(info.worldMax[k], world[k]);
+            }
+        }
+        for (auto k = 0; k < 3; ++k) { info.center[k] = (info.worldMin[k] + info.worldMax[k]) * 0.5f; }
+        *outInfo = info;
+        return true;
+    }
+
+    void EmitBatch(mini::StaticBatchSource const* sources, SourceInfo const* infos, uint32_t const* members, uint32_t numMembers, mini::StaticBatch* outBatch)
+    {
+        auto const format = sources[members[0]].data->vertexFormat;
+        auto const stride = mini::GetVertexFormatStride(format);
+        outBatch->vertexFormat = format;
+        outBatch->materialKey = sources[members[0]].materialKey;
+
+        eastl::vector<uint32_t> indices;
+        eastl::vector<uint32_t> sourceIndices;
+        eastl::vector<uint32_t> remap;
+        uint32_t numVertices = 0;
+        for (auto m = 0u; m < numMembers; ++m) {
+            auto const& source = sources[members[m]];
+            auto const& info = infos[members[m]];
+            auto const& data = *source.data;
+
+            sourceIndices.resize(data.indexDataSize / mini::GetIndexFormatStride(data.indexFormat));
+            mini::UnpackIndices(data, sourceIndices.data());
+
+            // @note only what LOD 0 references is copied, in order of first use
+            remap.assign(info.numVertices, UINT32_MAX);
+            outBatch->sources.push_back({ source.sourceId, static_cast<uint32_t>(indices.size()), info.numIndices });
+            for (auto i = info.firstIndex; i < info.firstIndex + info.numIndices; ++i) {
+                auto const index = sourceIndices[i];
+                if (remap[index] == UINT32_MAX) {
+                    remap[index] = numVertices++;
+                    outBatch->vertexData.resize(static_cast<size_t>(numVertices) * stride);
+                    TransformVertex(source, format, data.vertexData + static_cast<size_t>(index) * stride, outBatch->vertexData.data() + static_cast<size_t>(remap[index]) * stride);
+                }
+                indices.push_back(remap[index]);
+            }
+        }
+        outBatch->numVertices = numVertices;
+        outBatch->numIndices = static_cast<uint32_t>(indices.size());
+        outBatch->indexFormat = mini::PackIndices(indices.data(), outBatch->numIndices, numVertices, &outBatch->indexData);
+        outBatch->bounds = mini::ComputeMeshBounds(outBatch->vertexData.data(), numVertices, stride);
+    }
+}
+
+uint32_t mini::BuildStaticBatches(StaticBatchSource const* sources, uint32_t numSources, StaticBatchSettings const& settings,
+    eastl::vector<StaticBatch>* outBatches, eastl::vector<uint32_t>* outUnbatched)
+{
+    MINI_ASSERT(settings.maxClusterExtent > 0.0f && settings.maxClusterVertices > 0, "Static batch limits must be positive");
+    eastl::vector<SourceInfo> infos(numSources);
+    eastl::vector<uint32_t> candidates;
+    for (auto i = 0u; i < numSources; ++i) {
+        if (GetSourceInfo(sources[i], settings, &infos[i])) {
+            candidates.push_back(i);
+        }
+        else {
+            outUnbatched->push_back(i);
+        }
+    }
+    eastl::stable_sort(candidates.begin(), candidates.end(), [&infos](uint32_t a, uint32_t b) { return infos[a].groupKey < infos[b].groupKey; });
+
+    struct Range
+    {
+        uint32_t begin;
+        uint32_t end;
+    };
+    eastl::vector<Range> stack;
+    uint32_t numBatches = 0;
+    for (auto groupBegin = 0u; groupBegin < candidates.size();) {
+        auto groupEnd = groupBegin + 1;
+        while (groupEnd < candidates.size() && infos[candidates[groupEnd]].groupKey == infos[candidates[groupBegin]].groupKey) { groupEnd++; }
+
+        stack.push_back({ groupBegin, groupEnd });
+        while (!stack.empty()) {
+            auto const range = stack.back();
+            stack.pop_back();
+
+            float boxMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, boxMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            float centerMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX }, centerMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+            uint64_t numVertices = 0;
+            for (auto i = range.begin; i < range.end; ++i) {
+                auto const& info = infos[candidates[i]];
+                for (auto k = 0; k < 3; ++k) {
+                    boxMin[k] = eastl::min(boxMin[k], info.worldMin[k]);
+                    boxMax[k] = eastl::max(boxMax[k], info.worldMax[k]);
+                    centerMin[k] = eastl::min(centerMin[k], info.center[k]);
+                    centerMax[k] = eastl::max(centerMax[k], info.center[k]);
+                }
+                numVertices += info.numVertices;
+            }
+            auto const extent = eastl::max(boxMax[0] - boxMin[0], eastl::max(boxMax[1] - boxMin[1], boxMax[2] - boxMin[2]));
+            if (range.end - range.begin == 1 || (extent <= settings.maxClusterExtent && numVertices <= settings.maxClusterVertices)) {
+                EmitBatch(sources, infos.data(), candidates.data() + range.begin, range.end - range.begin, &outBatches->push_back());
+                numBatches++;
+                continue;
+            }
+
+            // @note    median split, so both halves shrink even when the centers coincide along every axis
+            auto axis = 0;
+            for (auto k = 1; k < 3; ++k) {
+                if (centerMax[k] - centerMin[k] > centerMax[axis] - centerMin[axis]) { axis = k; }
+            }
+            auto const mid = range.begin + (range.end - range.begin) / 2;
+            eastl::nth_element(candidates.begin() + range.begin, candidates.begin() + mid, candidates.begin() + range.end,
+                [&infos, axis](uint32_t a, uint32_t b) { return infos[a].center[axis] < infos[b].center[axis]; });
+            stack.push_back({ mid, range.end });
+            stack.push_back({ range.begin, mid });
+        }
+        groupBegin = groupEnd;
+    }
+    return numBatches;
+}
+
+uint32_t mini::FindStaticBatchSource(StaticBatch const& batch, uint32_t triangleIndex)
+{
+    auto const index = static_cast<uint64_t>(triangleIndex) * 3;
+    if (index >= batch.numIndices) { return UINT32_MAX; }
+    // @note the last range starting at or before the index
+    auto const it = eastl::upper_bound(batch.sources.begin(), batch.sources.end(), static_cast<uint32_t>(index),
+        [](uint32_t value, StaticBatchSourceRange const& range) { return value < range.firstIndex; });
+    return (it - 1)->sourceId;
+}
+
+void mini::GetStaticBatchMeshData(StaticBatch const& batch, MeshData* outData)
+{
+    MeshData data;
+    data.vertexData = const_cast<char*>(batch.vertexData.data());   // @note MeshData is never written through by the library
+    data.indexData = const_cast<char*>(batch.indexData.data());
+    data.vertexFormat = batch.vertexFormat;
+    data.vertexStride = GetVertexFormatStride(batch.vertexFormat);
+    data.indexFormat = batch.indexFormat;
+    data.vertexDataSize = static_cast<uint32_t>(batch.vertexData.size());
+    data.indexDataSize = static_cast<uint32_t>(batch.indexData.size());
+    data.bounds = &batch.bounds;
+    *outData = data;
+}
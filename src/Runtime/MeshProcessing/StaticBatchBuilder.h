@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+
+#include <EASTL/vector.h>
+
+namespace mini
+{
+    /*
+        *   Cook time static batching. Placed meshes that never move and share a vertex format and material are merged into
+        *   combined meshes with their vertices pre-transformed to world space, so a whole cluster of props is a single draw.
+        *   Sources are grouped by vertex format and material, then split at the median of their centers along the longest axis
+        *   until a cluster fits the size and vertex limits. Small clusters keep bounds culling effective, a batch spanning the
+        *   level would be drawn whenever any of its props is visible.
+        *   Only LOD 0 is merged and the result has no meshlets, run the batches through the usual cook stages if they need them.
+    */
+    struct StaticBatchSource
+    {
+        MeshData const* data = nullptr;     // @note unquantized vertex formats only, quantized sources end up unbatched
+        float           position[3] = { 0.0f, 0.0f, 0.0f };
+        float           rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };  // unit quaternion, xyzw
+        float           scale = 1.0f;
+        uint32_t        materialKey = 0;    // only sources with equal keys are merged
+        uint32_t        sourceId = 0;       // whatever identifies the placed object, see FindStaticBatchSource
+    };
+
+    struct StaticBatchSettings
+    {
+        float       maxClusterExtent = 32.0f;       // largest side of a batch's world space box, in world units
+        uint32_t    maxClusterVertices = 0xffff;    // @note the default keeps indices 16 bit, see PackIndices
+    };
+
+    // @note the source's triangles are the contiguous range [firstIndex, firstIndex + numIndices) of the batch's indices
+    struct StaticBatchSourceRange
+    {
+        uint32_t    sourceId;
+        uint32_t    firstIndex;
+        uint32_t    numIndices;
+    };
+
+    struct StaticBatch
+    {
+        VertexFormat            vertexFormat = VertexFormat::PositionNormal;
+        uint32_t                materialKey = 0;
+        eastl::vector<char>     vertexData;
+        eastl::vector<char>     indexData;
+        IndexFormat             indexFormat = IndexFormat::R16_UINT;
+        uint32_t                numVertices = 0;
+        uint32_t                numIndices = 0;
+        MeshBounds              bounds;     // world space
+        eastl::vector<StaticBatchSourceRange>   sources;    // ordered by firstIndex
+    };
+
+    // @note    appends the batches to outBatches and the indices of the sources that can't be merged to outUnbatched: quantized ones,
+    //          ones without triangles and ones over maxClusterVertices on their own. returns the number of batches appended
+    uint32_t    BuildStaticBatches(StaticBatchSource const* sources, uint32_t numSources, StaticBatchSettings const& settings,
+                    eastl::vector<StaticBatch>* outBatches, eastl::vector<uint32_t>* outUnbatched);
+
+    // sourceId of the object a triangle of the batch came from, e.g. for picking. UINT32_MAX if triangleIndex is out of range
+    uint32_t    FindStaticBatchSource(StaticBatch const& batch, uint32_t triangleIndex);
+
+    // outData references the batch's storage and bounds, a single submesh with material slot 0
+    void        GetStaticBatchMeshData(StaticBatch const& batch, MeshData* outData);
+}
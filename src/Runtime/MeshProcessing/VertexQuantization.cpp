@@ -0,0 +1,360 @@
+#include "VertexQuantization.h"
+#include <Runtime/common.h>
+#include <Runtime/Math/math_packing.h>
+#include <Runtime/Math/math_simd.h>
+
+#include <math.h>
+#include <string.h>
+
+namespace
+{
+    constexpr float UNORM16_MAX = 65535.0f;
+    constexpr float SNORM16_MAX = 32767.0f;
+    constexpr float MIN_OCTAHEDRAL_LENGTH = 1e-20f;   // @note zero length vectors encode as +z instead of NaN
+
+    // offsets in floats into the uncompressed vertex layouts
+    constexpr uint32_t POSITION_OFFSET  = 0;
+    constexpr uint32_t NORMAL_OFFSET    = 3;
+    constexpr uint32_t TANGENT_OFFSET   = 6;
+    constexpr uint32_t UV_OFFSET        = 10;
+
+    inline float Clamp(float v, float lo, float hi) { return v < lo ? lo : (v > hi ? hi : v); }
+
+    inline uint16_t EncodePosition(float p, float offset, float invScale)
+    {
+        return static_cast<uint16_t>(lrintf(Clamp((p - offset) * invScale, 0.0f, UNORM16_MAX)));
+    }
+
+    struct QuantizationConstants
+    {
+        float offset[3];
+        float invScale[3];
+    };
+
+    QuantizationConstants GetConstants(mini::VertexQuantizationParams const& params)
+    {
+        QuantizationConstants constants;
+        for (auto i = 0; i < 3; ++i) {
+            constants.offset[i] = params.positionOffset[i];
+            constants.invScale[i] = params.positionScale[i] > 0.0f ? UNORM16_MAX / params.positionScale[i] : 0.0f;
+        }
+        return constants;
+    }
+
+    void QuantizeVertexScalar(bool hasTangentUV, float const* v, QuantizationConstants const& constants, char* out)
+    {
+        uint16_t const position[4] = {
+            EncodePosition(v[POSITION_OFFSET + 0], constants.offset[0], constants.invScale[0]),
+            EncodePosition(v[POSITION_OFFSET + 1], constants.offset[1], constants.invScale[1]),
+            EncodePosition(v[POSITION_OFFSET + 2], constants.offset[2], constants.invScale[2]),
+            static_cast<uint16_t>(hasTangentUV && v[TANGENT_OFFSET + 3] < 0.0f ? 1 : 0),
+        };
+        auto const normal = mini::math::pack_octahedral(mini::math::vec3f_t(v[NORMAL_OFFSET + 0], v[NORMAL_OFFSET + 1], v[NORMAL_OFFSET + 2]));
+        memcpy(out, position, sizeof(position));
+        memcpy(out + 8, &normal, sizeof(normal));
+        if (hasTangentUV) {
+            auto const tangent = mini::math::pack_octahedral(mini::math::vec3f_t(v[TANGENT_OFFSET + 0], v[TANGENT_OFFSET + 1], v[TANGENT_OFFSET + 2]));
+            uint16_t const uv[2] = { mini::math::float_to_half(v[UV_OFFSET + 0]), mini::math::float_to_half(v[UV_OFFSET + 1]) };
+            memcpy(out + 12, &tangent, sizeof(tangent));
+            memcpy(out + 16, uv, sizeof(uv));
+        }
+    }
+
+#if defined(MINI_SIMD_SSE4)
+    // math::pack_octahedral four vertices at a time, on the transposed attributes
+    inline __m128i EncodeOctahedralSSE(__m128 x, __m128 y, __m128 z)
+    {
+        auto const signMask = _mm_set1_ps(-0.0f);
+        auto const one = _mm_set1_ps(1.0f);
+        auto const l1 = _mm_max_ps(_mm_add_ps(_mm_add_ps(_mm_andnot_ps(signMask, x), _mm_andnot_ps(signMask, y)), _mm_andnot_ps(signMask, z)), _mm_set1_ps(MIN_OCTAHEDRAL_LENGTH));
+        auto const invL1 = _mm_div_ps(one, l1);
+        auto px = _mm_mul_ps(x, invL1);
+        auto py = _mm_mul_ps(y, invL1);
+
+        auto const wrapX = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, py)), _mm_or_ps(_mm_and_ps(px, signMask), one));
+        auto const wrapY = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(signMask, px)), _mm_or_ps(_mm_and_ps(py, signMask), one));
+        auto const lowerHemisphere = _mm_cmplt_ps(z, _mm_setzero_ps());
+        px = _mm_blendv_ps(px, wrapX, lowerHemisphere);
+        py = _mm_blendv_ps(py, wrapY, lowerHemisphere);
+
+        auto const minusOne = _mm_set1_ps(-1.0f);
+        auto const scale = _mm_set1_ps(SNORM16_MAX);
+        auto const qx = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(px, minusOne), one), scale));
+        auto const qy = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(py, minusOne), one), scale));
+        return _mm_or_si128(_mm_and_si128(qx, _mm_set1_epi32(0xffff)), _mm_slli_epi32(qy, 16));
+    }
+
+    inline __m128i EncodePositionSSE(__m128 p, float offset, float invScale)
+    {
+        auto const q = _mm_mul_ps(_mm_sub_ps(p, _mm_set1_ps(offset)), _mm_set1_ps(invScale));
+        return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(q, _mm_setzero_ps()), _mm_set1_ps(UNORM16_MAX)));
+    }
+
+    // @note    four vertices per iteration: load each vertex' attributes as a row, transpose to SoA, encode, write back interleaved.
+    //          loads are arranged so they never read past the end of the last vertex. returns the number of vertices processed
+    uint32_t QuantizeVerticesSSE(bool hasTangentUV, char const* src, uint32_t srcStride, uint32_t numVertices, QuantizationConstants const& constants, char* dst, uint32_t dstStride)
+    {
+        auto const numBatched = numVertices & ~3u;
+        for (auto i = 0u; i < numBatched; i += 4) {
+            float const* v[4];
+            for (auto k = 0; k < 4; ++k) { v[k] = reinterpret_cast<float const*>(src + (i + k) * srcStride); }
+
+            auto px = _mm_loadu_ps(v[0] + POSITION_OFFSET), py = _mm_loadu_ps(v[1] + POSITION_OFFSET);
+            auto pz = _mm_loadu_ps(v[2] + POSITION_OFFSET), pw = _mm_loadu_ps(v[3] + POSITION_OFFSET);
+            _MM_TRANSPOSE4_PS(px, py, pz, pw);      // x, y, z, normal.x
+            auto n0 = _mm_loadu_ps(v[0] + NORMAL_OFFSET - 1), n1 = _mm_loadu_ps(v[1] + NORMAL_OFFSET - 1);
+            auto n2 = _mm_loadu_ps(v[2] + NORMAL_OFFSET - 1), n3 = _mm_loadu_ps(v[3] + NORMAL_OFFSET - 1);
+            _MM_TRANSPOSE4_PS(n0, n1, n2, n3);      // position.z, x, y, z
+
+            alignas(16) uint32_t positions[8];
+            alignas(16) uint32_t normals[4];
+            alignas(16) uint32_t tangents[4];
+            alignas(16) uint32_t uvs[4];
+
+            auto tangentSigns = _mm_setzero_si128();
+            if (hasTangentUV) {
+                auto t0 = _mm_loadu_ps(v[0] + TANGENT_OFFSET), t1 = _mm_loadu_ps(v[1] + TANGENT_OFFSET);
+                auto t2 = _mm_loadu_ps(v[2] + TANGENT_OFFSET), t3 = _mm_loadu_ps(v[3] + TANGENT_OFFSET);
+                _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+                _mm_store_si128(reinterpret_cast<__m128i*>(tangents), EncodeOctahedralSSE(t0, t1, t2));
+                tangentSigns = _mm_srli_epi32(_mm_castps_si128(_mm_cmplt_ps(t3, _mm_setzero_ps())), 31);
+
+                auto u0 = _mm_loadu_ps(v[0] + UV_OFFSET - 2), u1 = _mm_loadu_ps(v[1] + UV_OFFSET - 2);
+                auto u2 = _mm_loadu_ps(v[2] + UV_OFFSET - 2), u3 = _mm_loadu_ps(v[3] + UV_OFFSET - 2);
+                _MM_TRANSPOSE4_PS(u0, u1, u2, u3);  // tangent.z, tangent.w, u, v
+#if defined(MINI_SIMD_F16C)
+                auto const halfU = _mm_cvtps_ph(u2, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                auto const halfV = _mm_cvtps_ph(u3, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+                _mm_store_si128(reinterpret_cast<__m128i*>(uvs), _mm_unpacklo_epi16(halfU, halfV));
+#else
+                alignas(16) float us[4], vs[4];
+                _mm_store_ps(us, u2);
+                _mm_store_ps(vs, u3);
+                for (auto k = 0; k < 4; ++k) { uvs[k] = mini::math::float_to_half(us[k]) | (static_cast<uint32_t>(mini::math::float_to_half(vs[k])) << 16); }
+#endif
+            }
+            _mm_store_si128(reinterpret_cast<__m128i*>(normals), EncodeOctahedralSSE(n1, n2, n3));
+
+            // x0..x3 y0..y3 / z0..z3 w0..w3 -> x y z w per vertex
+            auto const xy = _mm_packus_epi32(EncodePositionSSE(px, constants.offset[0], constants.invScale[0]), EncodePositionSSE(py, constants.offset[1], constants.invScale[1]));
+            auto const zw = _mm_packus_epi32(EncodePositionSSE(pz, constants.offset[2], constants.invScale[2]), tangentSigns);
+            auto const xyInterleaved = _mm_unpacklo_epi16(xy, _mm_srli_si128(xy, 8));
+            auto const zwInterleaved = _mm_unpacklo_epi16(zw, _mm_srli_si128(zw, 8));
+            _mm_store_si128(reinterpret_cast<__m128i*>(positions), _mm_unpacklo_epi32(xyInterleaved, zwInterleaved));
+            _mm_store_si128(reinterpret_cast<__m128i*>(positions + 4), _mm_unpackhi_epi32(xyInterleaved, zwInterleaved));
+
+            for (auto k = 0; k < 4; ++k) {
+                auto out = dst + (i + k) * dstStride;
+                memcpy(out, positions + k * 2, 8);
+                memcpy(out + 8, normals + k, 4);
+                if (hasTangentUV) {
+                    memcpy(out + 12, tangents + k, 4);
+                    memcpy(out + 16, uvs + k, 4);
+                }
+            }
+        }
+        return numBatched;
+    }
+#endif
+
+    bool Quantize(mini::VertexFormat sourceFormat, void const* src, uint32_t numVertices, mini::VertexQuantizationParams const& params, void* dst, bool allowSimd)
+    {
+        MINI_ASSERT(!mini::IsQuantizedVertexFormat(sourceFormat), "Vertices are already quantized");
+        if (mini::IsQuantizedVertexFormat(sourceFormat)) { return false; }
+
+        auto const hasTangentUV = sourceFormat == mini::VertexFormat::PositionNormalTangentUV;
+        auto const srcStride = mini::GetVertexFormatStride(sourceFormat);
+        auto const dstStride = mini::GetVertexFormatStride(mini::GetQuantizedVertexFormat(sourceFormat));
+        auto const constants = GetConstants(params);
+        auto const srcBytes = static_cast<char const*>(src);
+        auto const dstBytes = static_cast<char*>(dst);
+
+        uint32_t first = 0;
+#if defined(MINI_SIMD_SSE4)
+        if (allowSimd) {
+            first = QuantizeVerticesSSE(hasTangentUV, srcBytes, srcStride, numVertices, constants, dstBytes, dstStride);
+        }
+#endif
+        for (auto i = first; i < numVertices; ++i) {
+            QuantizeVertexScalar(hasTangentUV, reinterpret_cast<float const*>(srcBytes + i * srcStride), constants, dstBytes + i * dstStride);
+        }
+        return true;
+    }
+
+    inline float AngleInDegrees(float const* a, float const* b)
+    {   // @note atan2 of |cross| and dot stays accurate for tiny angles where acos(dot) doesn't
+        double const cx = static_cast<double>(a[1]) * b[2] - static_cast<double>(a[2]) * b[1];
+        double const cy = static_cast<double>(a[2]) * b[0] - static_cast<double>(a[0]) * b[2];
+        double const cz = static_cast<double>(a[0]) * b[1] - static_cast<double>(a[1]) * b[0];
+        double const d = static_cast<double>(a[0]) * b[0] + static_cast<double>(a[1]) * b[1] + static_cast<double>(a[2]) * b[2];
+        return static_cast<float>(atan2(sqrt(cx * cx + cy * cy + cz * cz), d) * 57.29577951308232);
+    }
+
+    inline bool NormalizeInPlace(float* v)
+    {
+        auto const length = sqrtf(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        if (length <= 1e-6f) { return false; }
+        v[0] /= length; v[1] /= length; v[2] /= length;
+        return true;
+    }
+}
+
+// -----------------------------------------------------------
+
+mini::VertexFormat mini::GetQuantizedVertexFormat(VertexFormat format)
+{
+    switch (format) {
+    case VertexFormat::PositionNormal: return VertexFormat::QuantizedPositionNormal;
+    case VertexFormat::PositionNormalTangentUV: return VertexFormat::QuantizedPositionNormalTangentUV;
+    default: return format;
+    }
+}
+
+mini::VertexQuantizationParams mini::ComputeVertexQuantizationParams(VertexFormat sourceFormat, void const* vertices, uint32_t numVertices)
+{
+    VertexQuantizationParams params;
+    if (numVertices == 0 || IsQuantizedVertexFormat(sourceFormat)) { return params; }
+
+    auto const stride = GetVertexFormatStride(sourceFormat);
+    auto const bytes = static_cast<char const*>(vertices);
+    float minimum[3], maximum[3];
+    memcpy(minimum, bytes, sizeof(minimum));
+    memcpy(maximum, bytes, sizeof(maximum));
+    for (auto i = 1u; i < numVertices; ++i) {
+        auto const p = reinterpret_cast<float const*>(bytes + i * stride);
+        for (auto c = 0; c < 3; ++c) {
+            minimum[c] = p[c] < minimum[c] ? p[c] : minimum[c];
+            maximum[c] = p[c] > maximum[c] ? p[c] : maximum[c];
+        }
+    }
+    for (auto c = 0; c < 3; ++c) {
+        params.positionOffset[c] = minimum[c];
+        params.positionScale[c] = maximum[c] - minimum[c];
+    }
+    return params;
+}
+
+bool mini::QuantizeVertices(VertexFormat sourceFormat, void const* src, uint32_t numVertices, VertexQuantizationParams const& params, void* dst)
+{
+    return Quantize(sourceFormat, src, numVertices, params, dst, true);
+}
+
+bool mini::QuantizeVerticesScalar(VertexFormat sourceFormat, void const* src, uint32_t numVertices, VertexQuantizationParams const& params, void* dst)
+{
+    return Quantize(sourceFormat, src, numVertices, params, dst, false);
+}
+
+char const* mini::GetVertexQuantizationKernelName()
+{
+#if defined(MINI_SIMD_SSE4) && defined(MINI_SIMD_F16C)
+    return "sse4+f16c";
+#elif defined(MINI_SIMD_SSE4)
+    return "sse4";
+#else
+    return "scalar";
+#endif
+}
+
+mini::DecodedVertex mini::DecodeVertex(VertexFormat format, void const* vertex, VertexQuantizationParams const& params)
+{
+    DecodedVertex result = {};
+    auto const bytes = static_cast<char const*>(vertex);
+    if (!IsQuantizedVertexFormat(format)) {
+        memcpy(result.position, bytes + POSITION_OFFSET * sizeof(float), sizeof(result.position));
+        memcpy(result.normal, bytes + NORMAL_OFFSET * sizeof(float), sizeof(result.normal));
+        if (format == VertexFormat::PositionNormalTangentUV) {
+            memcpy(result.tangent, bytes + TANGENT_OFFSET * sizeof(float), sizeof(result.tangent));
+            memcpy(result.uv, bytes + UV_OFFSET * sizeof(float), sizeof(result.uv));
+        }
+        return result;
+    }
+
+    // @note mirrors LoadVertex in Shader.hlsl
+    uint16_t position[4];
+    uint32_t normal;
+    memcpy(position, bytes, sizeof(position));
+    memcpy(&normal, bytes + 8, sizeof(normal));
+    for (auto c = 0; c < 3; ++c) {
+        result.position[c] = params.positionOffset[c] + static_cast<float>(position[c]) / UNORM16_MAX * params.positionScale[c];
+    }
+    auto const normalDirection = mini::math::unpack_octahedral(normal);
+    memcpy(result.normal, normalDirection.elements, sizeof(result.normal));
+    if (format == VertexFormat::QuantizedPositionNormalTangentUV) {
+        uint32_t tangent;
+        uint16_t uv[2];
+        memcpy(&tangent, bytes + 12, sizeof(tangent));
+        memcpy(uv, bytes + 16, sizeof(uv));
+        auto const tangentDirection = mini::math::unpack_octahedral(tangent);
+        memcpy(result.tangent, tangentDirection.elements, sizeof(tangentDirection.elements));
+        result.tangent[3] = position[3] != 0 ? -1.0f : 1.0f;
+        result.uv[0] = mini::math::half_to_float(uv[0]);
+        result.uv[1] = mini::math::half_to_float(uv[1]);
+    }
+    return result;
+}
+
+mini::VertexQuantizationError mini::MeasureQuantizationError(VertexFormat sourceFormat, void const* src, void const* quantized, uint32_t numVertices, VertexQuantizationParams const& params)
+{
+    VertexQuantizationError error;
+    auto const quantizedFormat = GetQuantizedVertexFormat(sourceFormat);
+    auto const srcStride = GetVertexFormatStride(sourceFormat);
+    auto const dstStride = GetVertexFormatStride(quantizedFormat);
+    auto const hasTangentUV = sourceFormat == VertexFormat::PositionNormalTangentUV;
+
+    float stepSquared = 0.0f;
+    for (auto c = 0; c < 3; ++c) {
+        auto const halfStep = 0.5f * params.positionScale[c] / UNORM16_MAX;
+        stepSquared += halfStep * halfStep;
+    }
+    error.positionErrorBound = sqrtf(stepSquared);
+
+    for (auto i = 0u; i < numVertices; ++i) {
+        auto reference = DecodeVertex(sourceFormat, static_cast<char const*>(src) + i * srcStride, params);
+        auto const decoded = DecodeVertex(quantizedFormat, static_cast<char const*>(quantized) + i * dstStride, params);
+
+        float distanceSquared = 0.0f;
+        for (auto c = 0; c < 3; ++c) {
+            auto const d = reference.position[c] - decoded.position[c];
+            distanceSquared += d * d;
+        }
+        auto const positionError = sqrtf(distanceSquared);
+        error.maxPositionError = positionError > error.maxPositionError ? positionError : error.maxPositionError;
+
+        if (NormalizeInPlace(reference.normal)) {
+            auto const angle = AngleInDegrees(reference.normal, decoded.normal);
+            error.maxNormalError = angle > error.maxNormalError ? angle : error.maxNormalError;
+        }
+        if (hasTangentUV) {
+            if (NormalizeInPlace(reference.tangent)) {
+                auto const angle = AngleInDegrees(reference.tangent, decoded.tangent);
+                error.maxTangentError = angle > error.maxTangentError ? angle : error.maxTangentError;
+            }
+            auto const referenceSign = reference.tangent[3] < 0.0f ? -1.0f : 1.0f;
+            error.numTangentSignErrors += referenceSign != decoded.tangent[3] ? 1 : 0;
+            for (auto c = 0; c < 2; ++c) {
+                auto const uvError = fabsf(reference.uv[c] - decoded.uv[c]);
+                error.maxUVError = uvError > error.maxUVError ? uvError : error.maxUVError;
+            }
+        }
+    }
+    return error;
+}
+
+bool mini::QuantizeMeshData(MeshData const& data, char* outVertexData, MeshData* outData)
+{
+    MINI_ASSERT(data.vertexStride == GetVertexFormatStride(data.vertexFormat), "Vertex stride doesn't match the vertex format");
+    if (IsQuantizedVertexFormat(data.vertexFormat) || data.vertexStride != GetVertexFormatStride(data.vertexFormat)) { return false; }
+
+    auto const numVertices = data.vertexDataSize / data.vertexStride;
+    auto const params = ComputeVertexQuantizationParams(data.vertexFormat, data.vertexData, numVertices);
+    if (!QuantizeVertices(data.vertexFormat, data.vertexData, numVertices, params, outVertexData)) { return false; }
+
+    *outData = data;
+    outData->vertexFormat = GetQuantizedVertexFormat(data.vertexFormat);
+    outData->vertexStride = GetVertexFormatStride(outData->vertexFormat);
+    outData->vertexData = outVertexData;
+    outData->vertexDataSize = numVertices * outData->vertexStride;
+    memcpy(outData->positionOffset, params.positionOffset, sizeof(params.positionOffset));
+    memcpy(outData->positionScale, params.positionScale, sizeof(params.positionScale));
+    return true;
+}
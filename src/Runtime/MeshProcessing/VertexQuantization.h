@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/MeshLibrary.h>
+
+namespace mini
+{
+    /*
+        *   Cook time vertex quantization
+        *   Positions become unorm16 relative to the mesh AABB, normals and tangents are octahedral encoded into two snorm16 values
+        *   and UVs are stored as half floats. PositionNormal (24 bytes) shrinks to 12 bytes, the 48 byte .gtmesh layout to 20 bytes.
+        *   The decode side lives in Shader.hlsl (LoadVertex), DecodeVertex below mirrors it for error measurement on the CPU.
+    */
+    struct VertexQuantizationParams
+    {
+        float positionOffset[3] = { 0.0f, 0.0f, 0.0f };
+        float positionScale[3] = { 1.0f, 1.0f, 1.0f };
+    };
+
+    struct VertexQuantizationError
+    {
+        float maxPositionError      = 0.0f;     // in object space units
+        float positionErrorBound    = 0.0f;     // half a quantization step along the AABB diagonal
+        float maxNormalError        = 0.0f;     // in degrees
+        float maxTangentError       = 0.0f;     // in degrees
+        float maxUVError            = 0.0f;
+        uint32_t numTangentSignErrors = 0;
+    };
+
+    // float vertex view used for measuring errors, unused attributes are left zero
+    struct DecodedVertex
+    {
+        float position[3];
+        float normal[3];
+        float tangent[4];
+        float uv[2];
+    };
+
+    VertexFormat                GetQuantizedVertexFormat(VertexFormat format);
+    VertexQuantizationParams    ComputeVertexQuantizationParams(VertexFormat sourceFormat, void const* vertices, uint32_t numVertices);
+
+    // @note    dst needs GetVertexFormatStride(GetQuantizedVertexFormat(sourceFormat)) * numVertices bytes
+    //          QuantizeVertices runs four vertices at a time with SSE4, half floats with F16C when it's there, and is the scalar path
+    //          everywhere else, NEON included. QuantizeVerticesScalar is the reference it's checked against
+    bool                        QuantizeVertices(VertexFormat sourceFormat, void const* src, uint32_t numVertices, VertexQuantizationParams const& params, void* dst);
+    bool                        QuantizeVerticesScalar(VertexFormat sourceFormat, void const* src, uint32_t numVertices, VertexQuantizationParams const& params, void* dst);
+    // the kernel QuantizeVertices was compiled with, for benchmark output
+    char const*                 GetVertexQuantizationKernelName();
+
+    DecodedVertex               DecodeVertex(VertexFormat format, void const* vertex, VertexQuantizationParams const& params);
+    VertexQuantizationError     MeasureQuantizationError(VertexFormat sourceFormat, void const* src, void const* quantized, uint32_t numVertices, VertexQuantizationParams const& params);
+
+    // quantizes the vertex stream of data into outVertexData and describes the result in outData, index data is shared with data
+    bool                        QuantizeMeshData(MeshData const& data, char* outVertexData, MeshData* outData);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/AssetLibraries/RenderResourceHandles.h>
+
+#include <EASTL/vector.h>
+
+namespace mini
+{
+    /*
+        *   Groups visible StaticMeshes that draw the same mesh at the same LOD so each group goes out as one instanced draw.
+        *   The caller writes per instance data in batch order, a batch's instances are a contiguous range of it.
+    */
+    struct StaticMeshInstance
+    {
+        MeshResourceHandle  resourceHandle;
+        uint32_t            lod = 0;
+        uint32_t            meshIndex = 0;  // @note whatever identifies the StaticMesh for the caller, e.g. its index in the scene
+    };
+
+    struct StaticMeshBatch
+    {
+        MeshResourceHandle  resourceHandle;
+        uint32_t            lod = 0;
+        uint32_t            firstInstance = 0;  // into the instance order written by BuildStaticMeshBatches
+        uint32_t            numInstances = 0;
+    };
+
+    static constexpr uint32_t MAX_BATCHED_MESH_INDEX = (1u << 24) - 1;
+
+    // @note    writes the meshIndex of every instance to outInstanceOrder (numInstances entries) grouped by batch, and replaces the
+    //          contents of outBatches. instances keep their relative order within a batch. LODs must stay below 256. nothing is kept
+    //          between calls, every call sorts all instances
+    void    BuildStaticMeshBatches(StaticMeshInstance const* instances, uint32_t numInstances, uint32_t* outInstanceOrder, eastl::vector<StaticMeshBatch>* outBatches);
+}
@@ -2,16 +2,22 @@
 
 #include <Runtime/AssetLibraries/RenderResourceHandles.h>
 #include <Runtime/Math/math_types.h>
+#include <Runtime/Math/math_functions.h>
 
 namespace mini
 {
     struct Transform
     {
-        math::vec3f_t   position;
-        math::quatf_t   rotation;
-        float           uniformScale;
+        math::vec3f_t   position = math::vec3f_t::zero();
+        math::quatf_t   rotation = math::quatf_t::identity();
+        float           uniformScale = 1.0f;
     };
 
+    inline math::mat3x4f_t ToAffine(Transform const& transform)
+    {
+        return math::make_affine(transform.position, transform.rotation, math::vec3f_t(transform.uniformScale));
+    }
+
     struct StaticMesh
     {
         MeshResourceHandle  resourceHandle;
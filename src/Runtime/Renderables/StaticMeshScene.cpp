@@ -0,0 +1,136 @@
+#include "StaticMeshScene.h"
+#include <Runtime/common.h>
+
+bool mini::StaticMeshScene::Initialize(uint32_t capacity)
+{
+    MINI_ASSERT(capacity > 0 && capacity <= MAX_CAPACITY, "Scene capacity out of range");
+    if (capacity == 0 || capacity > MAX_CAPACITY) { return false; }
+    Shutdown();
+
+    // @note one more slot than elements, the first allocation from a fresh slot map is slot 0 with generation 0, i.e. the default handle
+    if (!m_slots.Initialize(capacity + 1)) { return false; }
+    auto const reserved = m_slots.Allocate();
+    MINI_ASSERT(reserved.handle == 0, "Slot 0 must be reserved");
+    (void)reserved;
+
+    for (auto& stream : m_positions) { stream = new float[capacity]; }
+    for (auto& stream : m_rotations) { stream = new float[capacity]; }
+    m_scales = new float[capacity];
+    m_radii = new float[capacity];
+    m_meshRadii = new float[capacity];
+    m_meshes = new MeshResourceHandle[capacity];
+    m_handles = new StaticMeshHandle[capacity];
+    m_capacity = capacity;
+    m_count = 0;
+    return true;
+}
+
+void mini::StaticMeshScene::Shutdown()
+{
+    m_slots.Shutdown();
+    for (auto& stream : m_positions) { delete[] stream; stream = nullptr; }
+    for (auto& stream : m_rotations) { delete[] stream; stream = nullptr; }
+    delete[] m_scales;
+    delete[] m_radii;
+    delete[] m_meshRadii;
+    delete[] m_meshes;
+    delete[] m_handles;
+    m_scales = m_radii = m_meshRadii = nullptr;
+    m_meshes = nullptr;
+    m_handles = nullptr;
+    m_capacity = m_count = 0;
+}
+
+mini::StaticMeshHandle mini::StaticMeshScene::Create(MeshResourceHandle mesh, Transform const& transform, float boundingRadius)
+{
+    auto const handle = m_slots.Allocate();
+    if (!m_slots.IsValid(handle)) { return handle; }
+
+    auto const index = m_count++;
+    m_slots.GetHot(Slots::GetIndex(handle)) = index;
+    m_handles[index] = handle;
+    m_meshes[index] = mesh;
+    m_meshRadii[index] = boundingRadius;
+    SetTransform(index, transform);
+    return handle;
+}
+
+bool mini::StaticMeshScene::Destroy(StaticMeshHandle handle)
+{
+    auto const index = GetDenseIndex(handle);
+    if (index == INVALID_INDEX) { return false; }
+
+    // the last element fills the hole
+    auto const last = --m_count;
+    if (index != last) {
+        for (auto stream : m_positions) { stream[index] = stream[last]; }
+        for (auto stream : m_rotations) { stream[index] = stream[last]; }
+        m_scales[index] = m_scales[last];
+        m_radii[index] = m_radii[last];
+        m_meshRadii[index] = m_meshRadii[last];
+        m_meshes[index] = m_meshes[last];
+        m_handles[index] = m_handles[last];
+        m_slots.GetHot(Slots::GetIndex(m_handles[index])) = index;
+    }
+    m_slots.Free(handle);
+    return true;
+}
+
+bool mini::StaticMeshScene::IsValid(StaticMeshHandle handle) const
+{
+    return Slots::GetIndex(handle) != 0 && m_slots.IsValid(handle);
+}
+
+uint32_t mini::StaticMeshScene::GetDenseIndex(StaticMeshHandle handle) const
+{
+    return IsValid(handle) ? m_slots.GetHot(Slots::GetIndex(handle)) : INVALID_INDEX;
+}
+
+bool mini::StaticMeshScene::SetTransform(StaticMeshHandle handle, Transform const& transform)
+{
+    auto const index = GetDenseIndex(handle);
+    if (index == INVALID_INDEX) { return false; }
+    SetTransform(index, transform);
+    return true;
+}
+
+bool mini::StaticMeshScene::GetTransform(StaticMeshHandle handle, Transform* outTransform) const
+{
+    auto const index = GetDenseIndex(handle);
+    if (index == INVALID_INDEX) { return false; }
+    *outTransform = GetTransform(index);
+    return true;
+}
+
+void mini::StaticMeshScene::SetTransform(uint32_t denseIndex, Transform const& transform)
+{
+    MINI_ASSERT(denseIndex < m_count, "Dense index out of range");
+    for (auto k = 0; k < 3; ++k) { m_positions[k][denseIndex] = transform.position[k]; }
+    for (auto k = 0; k < 4; ++k) { m_rotations[k][denseIndex] = transform.rotation.elements[k]; }
+    m_scales[denseIndex] = transform.uniformScale;
+    m_radii[denseIndex] = m_meshRadii[denseIndex] * math::abs(transform.uniformScale);
+}
+
+mini::Transform mini::StaticMeshScene::GetTransform(uint32_t denseIndex) const
+{
+    MINI_ASSERT(denseIndex < m_count, "Dense index out of range");
+    Transform transform;
+    transform.position = math::vec3f_t(m_positions[0][denseIndex], m_positions[1][denseIndex], m_positions[2][denseIndex]);
+    transform.rotation = math::quatf_t(m_rotations[0][denseIndex], m_rotations[1][denseIndex], m_rotations[2][denseIndex], m_rotations[3][denseIndex]);
+    transform.uniformScale = m_scales[denseIndex];
+    return transform;
+}
+
+uint32_t mini::StaticMeshScene::CullSpheres(math::frustum_t const& frustum, uint32_t* outVisible) const
+{
+    return math::cull_spheres_batch(frustum, GetPositions(), m_radii, m_count, outVisible);
+}
+
+void mini::StaticMeshScene::ComposeAffine(uint32_t first, uint32_t count, math::mat3x4f_t* outMatrices) const
+{
+    MINI_ASSERT(first + count <= m_count, "Range out of bounds");
+    // @note the uniform scale is the same stream three times
+    auto const scales = m_scales + first;
+    math::compose_trs_batch({ m_positions[0] + first, m_positions[1] + first, m_positions[2] + first },
+        { m_rotations[0] + first, m_rotations[1] + first, m_rotations[2] + first, m_rotations[3] + first }, { scales, scales, scales }, outMatrices, count);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/Containers/SlotMap.h>
+#include <Runtime/Renderables/StaticMeshRenderer.h>
+#include <Runtime/Math/math_batch.h>
+
+namespace mini
+{
+    /*
+        *   The scene's StaticMeshes as structure of arrays: every field is its own dense array, so culling reads positions and
+        *   bounding radii only, building matrices reads the transform and nothing reads the mesh handles it doesn't need.
+        *   The streams are exactly what the math_batch functions take.
+        *   Handles go through a sparse set: a StaticMeshHandle is a SlotMap handle whose slot holds the element's dense index.
+        *   Destroy moves the last element into the hole (swap-remove), so Create and Destroy are O(1) and the arrays stay packed,
+        *   but dense indices and the stream pointers' contents change with every Destroy. Keep handles, not dense indices, across frames.
+        *   Slot 0 is taken by Initialize and never freed, so a default constructed StaticMeshHandle is never valid.
+    */
+    class StaticMeshScene
+    {
+        using Slots = SlotMap<StaticMeshHandle, uint32_t>;
+
+        Slots               m_slots;                        // sparse, the dense index per slot
+
+        // dense, per element
+        float*              m_positions[3]      = {};
+        float*              m_rotations[4]      = {};       // wxyz like quatf_t
+        float*              m_scales            = nullptr;  // uniform
+        float*              m_radii             = nullptr;  // bounding radius times scale, what culling reads
+        float*              m_meshRadii         = nullptr;  // as given to Create, for when the scale changes
+        MeshResourceHandle* m_meshes            = nullptr;
+        StaticMeshHandle*   m_handles           = nullptr;  // back to the sparse slot, for swap-remove
+
+        uint32_t            m_capacity          = 0;
+        uint32_t            m_count             = 0;
+
+    public:
+        static constexpr uint32_t MAX_CAPACITY = SlotMapHandleLayout::MAX_CAPACITY - 1;
+        static constexpr uint32_t INVALID_INDEX = 0xffffffff;
+
+        StaticMeshScene() = default;
+        StaticMeshScene(StaticMeshScene const&) = delete;
+        StaticMeshScene& operator = (StaticMeshScene const&) = delete;
+        ~StaticMeshScene() { Shutdown(); }
+
+        bool Initialize(uint32_t capacity);
+        void Shutdown();
+
+        // @note    boundingRadius is a sphere around transform.position that holds the mesh whatever the rotation, before scaling.
+        //          returns a handle with INVALID_HANDLE as its value if the scene is full
+        StaticMeshHandle Create(MeshResourceHandle mesh, Transform const& transform, float boundingRadius);
+        bool Destroy(StaticMeshHandle handle);
+
+        bool IsValid(StaticMeshHandle handle) const;
+        // @note INVALID_INDEX for handles that aren't valid. only until the next Destroy
+        uint32_t GetDenseIndex(StaticMeshHandle handle) const;
+
+        bool SetTransform(StaticMeshHandle handle, Transform const& transform);
+        bool GetTransform(StaticMeshHandle handle, Transform* outTransform) const;
+        void SetTransform(uint32_t denseIndex, Transform const& transform);
+        Transform GetTransform(uint32_t denseIndex) const;
+
+        uint32_t GetCount() const { return m_count; }
+        uint32_t GetCapacity() const { return m_capacity; }
+
+        // -- dense streams, GetCount() elements each. read only, transforms change through SetTransform so the radii follow
+
+        math::vec3f_soa_const_t     GetPositions() const    { return { m_positions[0], m_positions[1], m_positions[2] }; }
+        math::quatf_soa_const_t     GetRotations() const    { return { m_rotations[0], m_rotations[1], m_rotations[2], m_rotations[3] }; }
+        float const*                GetScales() const       { return m_scales; }
+        float const*                GetBoundingRadii() const { return m_radii; }    // scaled
+        MeshResourceHandle const*   GetMeshes() const       { return m_meshes; }
+        StaticMeshHandle const*     GetHandles() const      { return m_handles; }
+
+        // @note    writes the dense indices of the elements whose scaled bounding sphere isn't entirely outside the frustum in
+        //          increasing order and returns their number. outVisible needs room for GetCount() entries
+        uint32_t CullSpheres(math::frustum_t const& frustum, uint32_t* outVisible) const;
+        // outMatrices[i] = ToAffine(GetTransform(first + i))
+        void ComposeAffine(uint32_t first, uint32_t count, math::mat3x4f_t* outMatrices) const;
+    };
+}
@@ -0,0 +1,178 @@
+#include "TransformHierarchy.h"
+#include <Runtime/Math/math_functions.h>
+#include <Runtime/common.h>
+
+#include <string.h>
+
+namespace
+{
+    // @note    a node of the gathered path costs about four of a walk over the whole level in node order, the gather and the
+    //          parents are scattered. past a quarter of a level the rest of the hierarchy is rebuilt instead (see the hierarchy benchmark)
+    constexpr uint32_t FULL_LEVEL_DIVISOR = 4;
+}
+
+bool mini::TransformHierarchy::Build(uint32_t const* parents, Transform const* localTransforms, uint32_t count, uint32_t* outNodes)
+{
+    Clear();
+
+    // children of every input as one array, in input order
+    eastl::vector<uint32_t> childStarts(count + 1, 0);
+    eastl::vector<uint16_t> inputDepths(count);
+    for (auto i = 0u; i < count; ++i) {
+        auto const parent = parents[i];
+        if (parent == INVALID_NODE) {
+            inputDepths[i] = 0;
+            continue;
+        }
+        MINI_ASSERT(parent < i, "Parents must come before their children");
+        MINI_ASSERT(inputDepths[parent] < MAX_DEPTH, "Hierarchy too deep");
+        if (parent >= i || inputDepths[parent] >= MAX_DEPTH) { return false; }
+        inputDepths[i] = static_cast<uint16_t>(inputDepths[parent] + 1);
+        childStarts[parent + 1]++;
+    }
+    for (auto i = 0u; i < count; ++i) { childStarts[i + 1] += childStarts[i]; }
+    eastl::vector<uint32_t> children(count);
+    {
+        eastl::vector<uint32_t> fill(childStarts.begin(), childStarts.end() - 1);
+        for (auto i = 0u; i < count; ++i) {
+            if (parents[i] != INVALID_NODE) { children[fill[parents[i]]++] = i; }
+        }
+    }
+
+    // @note    breadth first from the roots: the queue is the node order. levels come out contiguous and a node's children are
+    //          appended together when it's dequeued
+    eastl::vector<uint32_t> order;
+    order.reserve(count);
+    for (auto i = 0u; i < count; ++i) {
+        if (parents[i] == INVALID_NODE) { order.push_back(i); }
+    }
+    m_parents.resize(count);
+    m_firstChildren.resize(count);
+    m_numChildren.resize(count);
+    m_depths.resize(count);
+    for (auto node = 0u; node < count; ++node) {
+        auto const input = order[node];
+        outNodes[input] = node;
+        m_parents[node] = parents[input] == INVALID_NODE ? INVALID_NODE : outNodes[parents[input]];
+        m_depths[node] = inputDepths[input];
+        m_firstChildren[node] = static_cast<uint32_t>(order.size());
+        m_numChildren[node] = childStarts[input + 1] - childStarts[input];
+        order.insert(order.end(), children.begin() + childStarts[input], children.begin() + childStarts[input + 1]);
+    }
+
+    m_localTransforms.resize(count);
+    m_worldMatrices.resize(count);
+    m_isQueued.resize(count, 0);
+    for (auto node = 0u; node < count; ++node) {
+        if (node == 0 || m_depths[node] != m_depths[node - 1]) {
+            m_levelStarts.push_back(node);
+            m_queued.emplace_back();
+        }
+        SetLocalTransform(node, localTransforms[order[node]]);
+    }
+    m_levelStarts.push_back(count);
+    return true;
+}
+
+void mini::TransformHierarchy::Clear()
+{
+    m_parents.clear();
+    m_firstChildren.clear();
+    m_numChildren.clear();
+    m_depths.clear();
+    m_isQueued.clear();
+    m_localTransforms.clear();
+    m_worldMatrices.clear();
+    m_levelStarts.clear();
+    m_queued.clear();
+}
+
+void mini::TransformHierarchy::SetLocalTransform(uint32_t node, Transform const& localTransform)
+{
+    MINI_ASSERT(node < GetCount(), "Node out of range");
+    m_localTransforms[node] = localTransform;
+    if (m_isQueued[node] == 0) {
+        m_isQueued[node] = 1;
+        m_queued[m_depths[node]].push_back(node);
+    }
+}
+
+uint32_t mini::TransformHierarchy::UpdateWorldMatrices()
+{
+    // every queued node moves its descendants too, with a quarter of the nodes queued most of the hierarchy changes
+    size_t numQueued = 0;
+    for (auto const& queued : m_queued) { numQueued += queued.size(); }
+    if (numQueued * FULL_LEVEL_DIVISOR > GetCount()) { return RebuildLevels(0); }
+
+    uint32_t numUpdated = 0;
+    m_work.clear();
+    for (auto level = 0u; level < GetNumLevels(); ++level) {
+        auto const levelStart = m_levelStarts[level];
+        auto const levelSize = m_levelStarts[level + 1] - levelStart;
+
+        // @note    the children of what changed on the level above, then the nodes queued on this one. queued children are only taken
+        //          once, so the work never exceeds the level
+        m_nextWork.resize(levelSize);
+        auto work = m_nextWork.data();
+        auto numWork = 0u;
+        for (auto const parent : m_work) {
+            auto const first = m_firstChildren[parent];
+            for (auto child = first; child < first + m_numChildren[parent]; ++child) {
+                work[numWork] = child;
+                numWork += m_isQueued[child] == 0 ? 1 : 0;
+            }
+        }
+        for (auto const node : m_queued[level]) {
+            m_isQueued[node] = 0;
+            work[numWork++] = node;
+        }
+        m_queued[level].clear();
+        m_nextWork.resize(numWork);
+        m_work.swap(m_nextWork);
+        if (numWork == 0) { continue; }
+
+        // @note once a level is walked whole the level below takes all of its nodes too and so on, i.e. the rest is a rebuild
+        if (numWork * FULL_LEVEL_DIVISOR > levelSize) { return numUpdated + RebuildLevels(level); }
+        numUpdated += numWork;
+        m_localMatrices.resize(numWork);
+
+        // the level's local transforms as streams: translation xyz, rotation wxyz, uniform scale
+        m_gathered.resize(numWork * 8);
+        float* streams[8];
+        for (auto k = 0u; k < 8; ++k) { streams[k] = m_gathered.data() + k * numWork; }
+        for (auto i = 0u; i < numWork; ++i) {
+            auto const& local = m_localTransforms[m_work[i]];
+            for (auto k = 0; k < 3; ++k) { streams[k][i] = local.position[k]; }
+            for (auto k = 0; k < 4; ++k) { streams[3 + k][i] = local.rotation.elements[k]; }
+            streams[7][i] = local.uniformScale;
+        }
+        math::compose_trs_batch({ streams[0], streams[1], streams[2] }, { streams[3], streams[4], streams[5], streams[6] },
+            { streams[7], streams[7], streams[7] }, m_localMatrices.data(), numWork);
+
+        // only roots are on level 0 and every other level has parents
+        if (level == 0) {
+            for (auto i = 0u; i < numWork; ++i) { m_worldMatrices[m_work[i]] = m_localMatrices[i]; }
+        }
+        else {
+            for (auto i = 0u; i < numWork; ++i) {
+                auto const node = m_work[i];
+                m_worldMatrices[node] = m_worldMatrices[m_parents[node]] * m_localMatrices[i];
+            }
+        }
+    }
+    return numUpdated;
+}
+
+uint32_t mini::TransformHierarchy::RebuildLevels(uint32_t firstLevel)
+{
+    auto const first = m_levelStarts[firstLevel];
+    for (auto level = firstLevel; level < GetNumLevels(); ++level) { m_queued[level].clear(); }
+    memset(m_isQueued.data() + first, 0, GetCount() - first);
+
+    auto node = first;
+    if (firstLevel == 0) {
+        for (; node < m_levelStarts[1]; ++node) { m_worldMatrices[node] = ToAffine(m_localTransforms[node]); }
+    }
+    for (; node < GetCount(); ++node) { m_worldMatrices[node] = m_worldMatrices[m_parents[node]] * ToAffine(m_localTransforms[node]); }
+    return GetCount() - first;
+}
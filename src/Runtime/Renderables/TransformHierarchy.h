@@ -0,0 +1,76 @@
+#pragma once
+
+#include <stdint.h>
+#include <Runtime/Renderables/StaticMeshRenderer.h>
+#include <Runtime/Math/math_batch.h>
+
+#include <EASTL/vector.h>
+
+namespace mini
+{
+    /*
+        *   Parent / child transforms with world matrices that are only recomputed where something changed.
+        *   Nodes are stored breadth first: every depth level is a contiguous range, parents come before their children and a node's
+        *   children are contiguous too.
+        *   SetLocalTransform queues the node on its level, UpdateWorldMatrices then walks the levels top down: a level's work is its
+        *   queued nodes plus the children of what changed on the level above. The level's local transforms are gathered into
+        *   streams, composed in one compose_trs_batch call and multiplied with their parents' world matrices. Untouched subtrees are
+        *   never visited, so the cost follows the number of changed nodes and their descendants, not the size of the hierarchy.
+        *   The gather is scattered though: once the work covers a quarter of a level, or a quarter of all nodes are queued, the rest
+        *   of the hierarchy is rebuilt in node order instead, so an update never costs much more than rebuilding everything.
+        *   @note   hierarchy benchmark, 100k nodes: 20x a rebuild's speed with 0.1% changed, 4-5x with 1%, on par from 10% on
+        *   @note   local transforms are stored as Transform structs, not streams: changes are scattered over the hierarchy and a
+        *           node's transform is half a cache line this way, where streams would be a line per component
+    */
+    class TransformHierarchy
+    {
+        // per node, breadth first
+        eastl::vector<uint32_t>         m_parents;
+        eastl::vector<uint32_t>         m_firstChildren;
+        eastl::vector<uint32_t>         m_numChildren;
+        eastl::vector<uint16_t>         m_depths;
+        eastl::vector<uint8_t>          m_isQueued;
+        eastl::vector<Transform>        m_localTransforms;
+        eastl::vector<math::mat3x4f_t>  m_worldMatrices;
+
+        // per level
+        eastl::vector<uint32_t>                 m_levelStarts;  // one more than levels, the last is the node count
+        eastl::vector<eastl::vector<uint32_t>>  m_queued;       // nodes whose local transform changed
+
+        // scratch for UpdateWorldMatrices
+        eastl::vector<uint32_t>         m_work;
+        eastl::vector<uint32_t>         m_nextWork;
+        eastl::vector<float>            m_gathered;
+        eastl::vector<math::mat3x4f_t>  m_localMatrices;
+
+        // drops the queues from firstLevel on and recomputes every node there in node order, returns how many
+        uint32_t RebuildLevels(uint32_t firstLevel);
+
+    public:
+        static constexpr uint32_t INVALID_NODE = 0xffffffff;
+        static constexpr uint32_t MAX_DEPTH = 0xffff;
+
+        // @note    replaces the hierarchy. parents[i] is the index of i's parent in the same arrays or INVALID_NODE for a root, parents
+        //          must come before their children (parents[i] < i) like a skeleton's bones. writes the node of every input to
+        //          outNodes, all nodes start out queued. returns false if the order or the depth is off
+        bool Build(uint32_t const* parents, Transform const* localTransforms, uint32_t count, uint32_t* outNodes);
+        void Clear();
+
+        void SetLocalTransform(uint32_t node, Transform const& localTransform);
+        Transform const& GetLocalTransform(uint32_t node) const    { return m_localTransforms[node]; }
+
+        // @note recomputes the world matrices of the queued nodes and their descendants, returns how many
+        uint32_t UpdateWorldMatrices();
+
+        // @note as of the last UpdateWorldMatrices
+        math::mat3x4f_t const& GetWorldMatrix(uint32_t node) const  { return m_worldMatrices[node]; }
+        math::mat3x4f_t const* GetWorldMatrices() const             { return m_worldMatrices.data(); }
+
+        uint32_t GetParent(uint32_t node) const     { return m_parents[node]; }
+        uint32_t GetDepth(uint32_t node) const      { return m_depths[node]; }
+        uint32_t GetCount() const                   { return static_cast<uint32_t>(m_parents.size()); }
+        uint32_t GetNumLevels() const               { return static_cast<uint32_t>(m_queued.size()); }
+        // nodes of depth level are [GetLevelStart(level), GetLevelStart(level + 1))
+        uint32_t GetLevelStart(uint32_t level) const { return m_levelStarts[level]; }
+    };
+}
@@ -9,6 +9,11 @@ namespace mini
         Mesh, Shader, Texture2D, Material, _LastType
     };
 
+    enum class ResourceLoadResult
+    {
+        Success, FileNotFound, Cached, OutOfMemory, InvalidData
+    };
+
     struct ResourceID
     {
         uint32_t value = 0;
@@ -34,6 +39,6 @@ namespace mini
         Resource(ResourceInfo info, char* data) : m_info(info), m_rawData(data) {}
         
         ResourceInfo const& GetInfo() const { return m_info; }
-        char const* const   GetData() const { return m_rawData; }
+        char const*         GetData() const { return m_rawData; }
     };
 }
\ No newline at end of file
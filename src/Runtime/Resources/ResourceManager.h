@@ -1,17 +1,26 @@
 #pragma once
 
 #include "Resource.h"
+#include "ResourceTelemetry.h"
+#include <EASTL/functional.h>
 #include <EASTL/fixed_function.h>
 #include <Runtime/util.h>
 
 namespace mini
 {
-    enum class ResourceLoadResult
-    {
-        Success, FileNotFound, Cached, OutOfMemory
-    };
+    // @note returns false if the data can't be decoded, the resource is dropped again and the load fails with InvalidData
+    using ResourceHandler = eastl::fixed_function<sizeof(void*) * 4, bool(Resource*)>;
 
-    using ResourceHandler = eastl::fixed_function<sizeof(void*) * 4, void(Resource*)>;
+    // @note resource type is derived from the file extension, anything unknown is treated as a mesh for now
+    inline ResourceType GetResourceTypeFromPath(char const* filePath)
+    {
+        auto const extension = strrchr(filePath, '.');
+        if (extension == nullptr) { return ResourceType::Mesh; }
+        if (strcmp(extension, ".shader") == 0) { return ResourceType::Shader; }
+        if (strcmp(extension, ".dds") == 0 || strcmp(extension, ".png") == 0) { return ResourceType::Texture2D; }
+        if (strcmp(extension, ".material") == 0) { return ResourceType::Material; }
+        return ResourceType::Mesh;
+    }
 
     template <int NUM_RESOURCES>
     class ResourceManager
@@ -21,11 +30,24 @@ namespace mini
 
         ResourceHandler m_resourceHandlers[static_cast<int>(ResourceType::_LastType)];
 
+        Timer               m_clock;
+        ResourceTelemetry   m_telemetry;
+
+        Resource* FindResource(ResourceID id);
     public:
-        
+        ~ResourceManager() { UnloadAll(); }
+
         void RegisterResourceHandler(ResourceType resourceType, ResourceHandler handler);
 
         ResourceLoadResult LoadResource(char const* filePath, ResourceID id, Resource** outResource = nullptr);
+
+        // @note frees the raw data of every loaded resource, handlers are expected to have copied out what they need
+        void UnloadAll();
+
+        uint32_t GetNumResources() const { return m_numResources; }
+
+        ResourceTelemetry const& GetTelemetry() const { return m_telemetry; }
+        void ResetTelemetry() { m_telemetry.Reset(); }
     };
 }
 
@@ -37,26 +59,73 @@ void mini::ResourceManager<NUM_RESOURCES>::RegisterResourceHandler(ResourceType
     m_resourceHandlers[static_cast<int>(resourceType)] = handler;
 }
 
+template <int NUM_RESOURCES>
+mini::Resource* mini::ResourceManager<NUM_RESOURCES>::FindResource(ResourceID id)
+{
+    for (auto i = 0u; i < m_numResources; ++i) {
+        if (m_resources[i].GetInfo().id == id) { return &m_resources[i]; }
+    }
+    return nullptr;
+}
+
 template <int NUM_RESOURCES>
 mini::ResourceLoadResult mini::ResourceManager<NUM_RESOURCES>::LoadResource(char const* filePath, ResourceID id, Resource** outResource)
 {
-    if (m_numResources == NUM_RESOURCES) { return ResourceLoadResult::OutOfMemory; }
+    ResourceLoadRecord record;
+    record.id = id;
+    record.type = GetResourceTypeFromPath(filePath);
+    record.queuedTime = m_clock.GetElapsedTime();
+    ResourceTelemetry::CopyPath(record, filePath);
+
+    auto Finish = [&](ResourceLoadResult result) {
+        record.result = result;
+        record.finalizedTime = m_clock.GetElapsedTime();
+        record.readTime = record.readTime == 0.0 ? record.finalizedTime : record.readTime;
+        record.decodedTime = record.decodedTime == 0.0 ? record.finalizedTime : record.decodedTime;
+        m_telemetry.Record(record);
+        return result;
+    };
+
+    if (auto cached = FindResource(id)) {
+        record.cacheHit = true;
+        if (outResource != nullptr) { *outResource = cached; }
+        return Finish(ResourceLoadResult::Cached);
+    }
+    if (m_numResources == NUM_RESOURCES) { return Finish(ResourceLoadResult::OutOfMemory); }
 
     ResourceInfo info;
-    info.type = ResourceType::Mesh;
+    info.type = record.type;
     info.file.path = filePath;
     info.id = id;
-    auto const resourceData = static_cast<char*>(Win32LoadFileContents(filePath, &info.file.size));
+    auto const resourceData = static_cast<char*>(LoadFileContents(filePath, &info.file.size));
+    record.readTime = m_clock.GetElapsedTime();
     if(!resourceData)
     {
-        return ResourceLoadResult::FileNotFound;
+        return Finish(ResourceLoadResult::FileNotFound);
     }
+    record.bytesRead = info.file.size;
     m_resources[m_numResources++] = Resource(info, resourceData);
     auto resourcePtr = &m_resources[m_numResources - 1];
     if(m_resourceHandlers[static_cast<int>(info.type)] != nullptr)
     {
-        m_resourceHandlers[static_cast<int>(info.type)](resourcePtr);
+        if (!m_resourceHandlers[static_cast<int>(info.type)](resourcePtr)) {
+            free(resourceData);
+            m_resources[--m_numResources] = Resource();
+            record.decodedTime = m_clock.GetElapsedTime();
+            return Finish(ResourceLoadResult::InvalidData);
+        }
     }
+    record.decodedTime = m_clock.GetElapsedTime();
     if (outResource != nullptr) { *outResource = resourcePtr; }
-    return ResourceLoadResult::Success;
-}
\ No newline at end of file
+    return Finish(ResourceLoadResult::Success);
+}
+
+template <int NUM_RESOURCES>
+void mini::ResourceManager<NUM_RESOURCES>::UnloadAll()
+{
+    for (auto i = 0u; i < m_numResources; ++i) {
+        free(const_cast<char*>(m_resources[i].GetData()));
+        m_resources[i] = Resource();
+    }
+    m_numResources = 0;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "Resource.h"
+#include <string.h>
+
+namespace mini
+{
+    // @note timestamps are in seconds relative to the creation of the owning ResourceManager
+    struct ResourceLoadRecord
+    {
+        ResourceID          id;
+        ResourceType        type = ResourceType::Undefined;
+        ResourceLoadResult  result = ResourceLoadResult::Success;
+        bool                cacheHit = false;
+        uint64_t            bytesRead = 0;
+
+        double              queuedTime = 0.0;       // load was requested
+        double              readTime = 0.0;         // file contents are in memory
+        double              decodedTime = 0.0;      // resource handler returned
+        double              finalizedTime = 0.0;    // resource is published to the caller
+
+        char                path[96] = {};          // @note tail end of the path if it doesn't fit
+
+        double GetTotalTime() const { return finalizedTime - queuedTime; }
+        double GetReadTime() const { return readTime - queuedTime; }
+        double GetDecodeTime() const { return decodedTime - readTime; }
+    };
+
+    struct ResourceTypeStats
+    {
+        static constexpr uint32_t WINDOW_SIZE = 64;
+
+        uint32_t    numLoads = 0;
+        uint32_t    numCacheHits = 0;
+        uint32_t    numFailures = 0;
+        uint64_t    bytesRead = 0;
+        double      totalLoadTime = 0.0;
+        double      maxLoadTime = 0.0;
+
+        // rolling window over the most recent loads of this type
+        float       window[WINDOW_SIZE] = {};
+        uint32_t    windowHead = 0;
+        uint32_t    windowCount = 0;
+
+        double GetRollingAverage() const
+        {
+            if (windowCount == 0) { return 0.0; }
+            double sum = 0.0;
+            for (auto i = 0u; i < windowCount; ++i) { sum += window[i]; }
+            return sum / windowCount;
+        }
+
+        double GetRollingMax() const
+        {
+            float result = 0.0f;
+            for (auto i = 0u; i < windowCount; ++i) { result = window[i] > result ? window[i] : result; }
+            return result;
+        }
+    };
+
+    class ResourceTelemetry
+    {
+    public:
+        static constexpr uint32_t HISTORY_SIZE = 256;
+
+    private:
+        ResourceLoadRecord  m_history[HISTORY_SIZE];
+        uint32_t            m_historyHead = 0;
+        uint32_t            m_historyCount = 0;
+
+        ResourceTypeStats   m_typeStats[static_cast<int>(ResourceType::_LastType)];
+
+    public:
+        void Record(ResourceLoadRecord const& record)
+        {
+            m_history[m_historyHead] = record;
+            m_historyHead = (m_historyHead + 1) % HISTORY_SIZE;
+            m_historyCount = m_historyCount < HISTORY_SIZE ? m_historyCount + 1 : HISTORY_SIZE;
+
+            auto& stats = m_typeStats[static_cast<int>(record.type)];
+            if (record.cacheHit) {
+                stats.numCacheHits++;
+                return;
+            }
+            if (record.result != ResourceLoadResult::Success) {
+                stats.numFailures++;
+                return;
+            }
+            auto const loadTime = record.GetTotalTime();
+            stats.numLoads++;
+            stats.bytesRead += record.bytesRead;
+            stats.totalLoadTime += loadTime;
+            stats.maxLoadTime = loadTime > stats.maxLoadTime ? loadTime : stats.maxLoadTime;
+            stats.window[stats.windowHead] = static_cast<float>(loadTime);
+            stats.windowHead = (stats.windowHead + 1) % ResourceTypeStats::WINDOW_SIZE;
+            stats.windowCount = stats.windowCount < ResourceTypeStats::WINDOW_SIZE ? stats.windowCount + 1 : ResourceTypeStats::WINDOW_SIZE;
+        }
+
+        uint32_t GetNumRecords() const { return m_historyCount; }
+
+        // @note index 0 is the most recent load
+        ResourceLoadRecord const& GetRecord(uint32_t index) const
+        {
+            return m_history[(m_historyHead + HISTORY_SIZE - 1 - index) % HISTORY_SIZE];
+        }
+
+        ResourceTypeStats const& GetTypeStats(ResourceType type) const { return m_typeStats[static_cast<int>(type)]; }
+
+        void Reset() { *this = ResourceTelemetry(); }
+
+        static void CopyPath(ResourceLoadRecord& record, char const* path)
+        {
+            auto const len = strlen(path);
+            auto const offset = len >= sizeof(record.path) ? len - (sizeof(record.path) - 1) : 0;
+            memcpy(record.path, path + offset, len - offset);
+            record.path[len - offset] = '\0';
+        }
+    };
+
+    inline char const* GetResourceTypeName(ResourceType type)
+    {
+        switch (type) {
+            case ResourceType::Mesh: return "Mesh";
+            case ResourceType::Shader: return "Shader";
+            case ResourceType::Texture2D: return "Texture2D";
+            case ResourceType::Material: return "Material";
+            default: return "Undefined";
+        }
+    }
+}
@@ -5,4 +5,4 @@
 
 #define ARRAY_SIZE(Array) (sizeof(Array)/sizeof((Array)[0]))
 #define MINI_ASSERT(condition, msgFmt, ...) \
-assert(condition)
\ No newline at end of file
+assert(condition)
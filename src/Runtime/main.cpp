@@ -6,6 +6,7 @@
 
 #include "Math/math_types.h"
 #include "Math/math_functions.h"
+#include "Math/math_batch.h"
 
 #include <imgui/imgui.h>
 #include <imgui/bindings/imgui_impl_dx12.h>
@@ -18,7 +19,16 @@
 
 #include <Runtime/Renderer/rendergraph.h>
 #include <Runtime/AssetLibraries/MeshLibrary.h>
+#include <Runtime/MeshProcessing/MeshOptimizer.h>
+#include <Runtime/MeshProcessing/MeshSimplifier.h>
+#include <Runtime/MeshProcessing/MeshletBuilder.h>
+#include <Runtime/Culling/MeshletCulling.h>
+#include <Runtime/Culling/LodSelection.h>
+#include <Runtime/Culling/MeshBounds.h>
+#include <Runtime/MeshProcessing/VertexQuantization.h>
 #include <Runtime/Renderables/StaticMeshRenderer.h>
+#include <Runtime/Renderables/StaticMeshScene.h>
+#include <Runtime/Renderables/StaticMeshBatching.h>
 #include <Runtime/util.h>
 #include <Runtime/Resources/ResourceManager.h>
 
@@ -73,6 +83,47 @@ LRESULT CALLBACK WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
 /*
 
 */
+static void DrawResourceTelemetry(mini::ResourceTelemetry const& telemetry)
+{
+    if (!ImGui::CollapsingHeader("Resource Loading")) { return; }
+
+    ImGui::Columns(7, "#resourceTypes");
+    ImGui::Text("Type"); ImGui::NextColumn();
+    ImGui::Text("Loads"); ImGui::NextColumn();
+    ImGui::Text("Hits"); ImGui::NextColumn();
+    ImGui::Text("Failed"); ImGui::NextColumn();
+    ImGui::Text("MB"); ImGui::NextColumn();
+    ImGui::Text("Avg ms"); ImGui::NextColumn();
+    ImGui::Text("Max ms"); ImGui::NextColumn();
+    ImGui::Separator();
+    for (auto i = static_cast<int>(mini::ResourceType::Mesh); i < static_cast<int>(mini::ResourceType::_LastType); ++i) {
+        auto const type = static_cast<mini::ResourceType>(i);
+        auto const& stats = telemetry.GetTypeStats(type);
+        ImGui::Text("%s", mini::GetResourceTypeName(type)); ImGui::NextColumn();
+        ImGui::Text("%u", stats.numLoads); ImGui::NextColumn();
+        ImGui::Text("%u", stats.numCacheHits); ImGui::NextColumn();
+        ImGui::Text("%u", stats.numFailures); ImGui::NextColumn();
+        ImGui::Text("%.2f", stats.bytesRead / (1024.0 * 1024.0)); ImGui::NextColumn();
+        ImGui::Text("%.3f", stats.GetRollingAverage() * 1000.0); ImGui::NextColumn();   // @note avg/max over the rolling window
+        ImGui::Text("%.3f", stats.GetRollingMax() * 1000.0); ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+
+    if (ImGui::TreeNode("Recent Loads")) {
+        auto const numRecords = telemetry.GetNumRecords() < 32 ? telemetry.GetNumRecords() : 32;
+        for (auto i = 0u; i < numRecords; ++i) {
+            auto const& record = telemetry.GetRecord(i);
+            auto const totalMs = record.GetTotalTime() * 1000.0;
+            // @note highlight anything that would eat a noticeable part of a 60hz frame
+            auto const color = record.result != mini::ResourceLoadResult::Success && !record.cacheHit ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f)
+                : totalMs > 4.0 ? ImVec4(1.0f, 0.7f, 0.2f, 1.0f) : ImVec4(0.8f, 0.8f, 0.8f, 1.0f);
+            ImGui::TextColored(color, "%8.3fms (read %.3f, decode %.3f) %8.1fKB %s %s", totalMs, record.GetReadTime() * 1000.0, record.GetDecodeTime() * 1000.0,
+                record.bytesRead / 1024.0, record.cacheHit ? "hit " : "miss", record.path);
+        }
+        ImGui::TreePop();
+    }
+}
+
 #include <stdio.h>
 int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
 {
@@ -80,6 +131,8 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
     AttachConsole(GetCurrentProcessId());
     FILE* file = nullptr;
     freopen_s(&file, "CON", "w", stdout);
+    // @note the kernels are picked at compile time by genie's --simd option, a misconfigured build silently runs the scalar ones
+    printf("mini::math simd backend: %s\n", mini::math::GetSimdBackendName());
 
     // Window Setup
     WNDCLASS windowClass = {};
@@ -292,12 +345,12 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
 
         D3D12_ROOT_PARAMETER params[64];
            
-        {   // Reserve space for one float4x4 matrix to be used as mvp transform and uploaded via root constant
-            // @note    apparently, this isn't the most efficient way to deal with a transformation matrix but it'll do for now
+        {   // Reserve space for one float4x4 matrix to be used as view projection transform and uploaded via root constant
+            // @note    object transforms are per instance, see params[3]
             auto& param = params[0];
             param.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
             param.ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
-            param.Constants.Num32BitValues = 32;    
+            param.Constants.Num32BitValues = 16;    
             param.Constants.RegisterSpace = 0;
             param.Constants.ShaderRegister = 0;
         }
@@ -316,9 +369,24 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
             param.DescriptorTable.NumDescriptorRanges = 1;
             param.DescriptorTable.pDescriptorRanges = ranges;
         }
+        {   // Per draw offsets into the shared vertex / index buffers, see MeshLibrary
+            auto& param = params[2];
+            param.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+            param.ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+            param.Constants.Num32BitValues = 12;
+            param.Constants.RegisterSpace = 0;
+            param.Constants.ShaderRegister = 1;
+        }
+        {   // Per instance transforms, a root SRV so every batch can point at its own range without a descriptor
+            auto& param = params[3];
+            param.ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+            param.ShaderVisibility = D3D12_SHADER_VISIBILITY_VERTEX;
+            param.Descriptor.RegisterSpace = 0;
+            param.Descriptor.ShaderRegister = 2;
+        }
 
         D3D12_ROOT_SIGNATURE_DESC desc = {};
-        desc.NumParameters = 2;
+        desc.NumParameters = 4;
         desc.pParameters = params;
         desc.NumStaticSamplers = 0;
         desc.pStaticSamplers = nullptr;
@@ -397,6 +465,10 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
     mini::ResourceManager<1024> resourceManager;
     mini::MeshLibrary meshLibrary;
     meshLibrary.Initialize(d3dDevice, 1024);
+    resourceManager.RegisterResourceHandler(mini::ResourceType::Mesh, [&meshLibrary](mini::Resource* resource) {
+        auto const& info = resource->GetInfo();
+        return meshLibrary.AllocateFromGTMesh(info.id, resource->GetData(), info.file.size).handle != 0;
+    });
 
     mini::MeshResourceHandle cubeMesh, sphereMesh;
 
@@ -428,7 +500,32 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
             memcpy(meshData.indexData, mesh->triangles, meshData.indexDataSize);
         }
 
-        cubeMesh = meshLibrary.AllocateWithData({ 0 }, meshData);
+        {   // @note optimized, simplified, clustered and quantized copy of the mesh, see MeshOptimizer.h, MeshSimplifier.h, MeshletBuilder.h and VertexQuantization.h
+            eastl::vector<char> optimizedVertices, optimizedIndices, lodIndices, meshletIndices;
+            eastl::vector<mini::MeshLod> lods, meshletLods;
+            eastl::vector<mini::Meshlet> meshlets;
+            mini::MeshData optimizedData;
+            if (!mini::OptimizeMeshData(meshData, &optimizedVertices, &optimizedIndices, &optimizedData)) {
+                optimizedData = meshData;
+            }
+            mini::MeshData lodData;
+            if (mini::BuildLodChainForMeshData(optimizedData, mini::LodChainSettings(), &lodIndices, &lods, &lodData)) {
+                optimizedData = lodData;
+            }
+            mini::MeshData meshletData;
+            if (mini::BuildMeshletsForMeshData(optimizedData, &meshletIndices, &meshlets, &meshletLods, &meshletData)) {
+                optimizedData = meshletData;
+            }
+            mini::MeshData quantizedData;
+            auto quantizedVertices = reinterpret_cast<char*>(malloc(optimizedData.vertexDataSize));
+            if (mini::QuantizeMeshData(optimizedData, quantizedVertices, &quantizedData)) {
+                cubeMesh = meshLibrary.AllocateWithData({ 0 }, quantizedData);
+            }
+            else {
+                cubeMesh = meshLibrary.AllocateWithData({ 0 }, optimizedData);
+            }
+            free(quantizedVertices);
+        }
         free(meshDataBuf);  // @note we can free our mesh data here since we don't have a reason to keep it around any longer
 
     }
@@ -462,7 +559,32 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
             memcpy(meshData.indexData, mesh->triangles, meshData.indexDataSize);
         }
 
-        sphereMesh = meshLibrary.AllocateWithData({ 1 }, meshData);
+        {   // @note optimized, simplified, clustered and quantized copy of the mesh, see MeshOptimizer.h, MeshSimplifier.h, MeshletBuilder.h and VertexQuantization.h
+            eastl::vector<char> optimizedVertices, optimizedIndices, lodIndices, meshletIndices;
+            eastl::vector<mini::MeshLod> lods, meshletLods;
+            eastl::vector<mini::Meshlet> meshlets;
+            mini::MeshData optimizedData;
+            if (!mini::OptimizeMeshData(meshData, &optimizedVertices, &optimizedIndices, &optimizedData)) {
+                optimizedData = meshData;
+            }
+            mini::MeshData lodData;
+            if (mini::BuildLodChainForMeshData(optimizedData, mini::LodChainSettings(), &lodIndices, &lods, &lodData)) {
+                optimizedData = lodData;
+            }
+            mini::MeshData meshletData;
+            if (mini::BuildMeshletsForMeshData(optimizedData, &meshletIndices, &meshlets, &meshletLods, &meshletData)) {
+                optimizedData = meshletData;
+            }
+            mini::MeshData quantizedData;
+            auto quantizedVertices = reinterpret_cast<char*>(malloc(optimizedData.vertexDataSize));
+            if (mini::QuantizeMeshData(optimizedData, quantizedVertices, &quantizedData)) {
+                sphereMesh = meshLibrary.AllocateWithData({ 1 }, quantizedData);
+            }
+            else {
+                sphereMesh = meshLibrary.AllocateWithData({ 1 }, optimizedData);
+            }
+            free(quantizedVertices);
+        }
         free(meshDataBuf);  // @note we can free our mesh data here since we don't have a reason to keep it around any longer
     }
 
@@ -475,6 +597,36 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         frameFenceEvent = CreateEvent(0, 0, FALSE, 0);
         MINI_ASSERT(frameFenceEvent != NULL, "Failed to create frame fence event");
     }
+
+    // @note    one affine 3x4 matrix per visible StaticMesh (48 bytes, the last row is implied), written in batch order every frame.
+    //          a single upload buffer is enough as long as frames don't overlap, see the wait at the end of the frame loop
+    struct InstanceData
+    {
+        mini::math::mat3x4f_t model;
+    };
+    static constexpr uint32_t MAX_SCENE_INSTANCES = 64 * 1024;
+    ID3D12Resource* instanceBuffer = nullptr;
+    InstanceData* instanceData = nullptr;
+    {
+        D3D12_RESOURCE_DESC desc = {};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+        desc.Width = sizeof(InstanceData) * MAX_SCENE_INSTANCES;
+        desc.Height = 1;
+        desc.DepthOrArraySize = 1;
+        desc.MipLevels = 1;
+        desc.SampleDesc.Count = 1;
+        desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+        D3D12_HEAP_PROPERTIES heapProperties = {};
+        heapProperties.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+        auto res = d3dDevice->CreateCommittedResource(&heapProperties, D3D12_HEAP_FLAG_NONE, &desc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&instanceBuffer));
+        MINI_ASSERT(SUCCEEDED(res), "Failed to create instance buffer");
+        instanceBuffer->SetName(L"Instance Buffer");
+        D3D12_RANGE readRange = { 0, 0 };
+        res = instanceBuffer->Map(0, &readRange, reinterpret_cast<void**>(&instanceData));
+        MINI_ASSERT(SUCCEEDED(res), "Failed to map instance buffer");
+    }
     
     /*
     */
@@ -488,14 +640,32 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
     mini::Timer timer;
     mini::rendergraph::RenderGraph rg;
 
-    eastl::vector<mini::StaticMesh> meshes;
+    // @note    the bounding radius is a sphere around the origin reaching the far side of the mesh's bounding sphere whatever the
+    //          rotation, so frustum culling only needs the positions
+    mini::StaticMeshScene scene;
+    scene.Initialize(MAX_SCENE_INSTANCES);
     for(auto i = -3; i < 6; ++i)
     {
-        auto& mesh = meshes.emplace_back();
-        mesh.resourceHandle = i % 2 == 0 ? cubeMesh : sphereMesh;
-        mesh.transform.position = mini::math::vec3f_t(i * 1.5f, 0.0f, 0.0f);
+        auto const resourceHandle = i % 2 == 0 ? cubeMesh : sphereMesh;
+        auto const& bounds = meshLibrary.Lookup(resourceHandle)->bounds;
+        auto const& center = bounds.sphereCenter;
+        mini::Transform transform;
+        transform.position = mini::math::vec3f_t(i * 1.5f, 0.0f, 0.0f);
+        scene.Create(resourceHandle, transform, sqrtf(center[0] * center[0] + center[1] * center[1] + center[2] * center[2]) + bounds.sphereRadius);
     }
 
+    eastl::vector<uint32_t> visibleMeshlets;
+    eastl::vector<uint8_t> batchMeshletVisibility;
+    mini::MeshletCullingStats meshletCullingStats;
+
+    eastl::vector<mini::StaticMeshInstance> visibleInstances;
+    eastl::vector<mini::CullingView> meshCullingViews;
+    eastl::vector<uint32_t> instanceOrder;
+    eastl::vector<mini::StaticMeshBatch> meshBatches;
+    eastl::vector<float> instanceTransforms;    // translation xyz, rotation wxyz, uniform scale, one stream per component
+    eastl::vector<uint32_t> meshCandidates;
+    uint32_t numDrawCalls = 0;
+
     D3D12_CPU_DESCRIPTOR_HANDLE frameSRVOffsetCPU;
     D3D12_GPU_DESCRIPTOR_HANDLE frameSRVOffsetGPU;
     const auto srvIncrement = d3dDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
@@ -516,6 +686,15 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         frameSRVOffsetCPU.ptr += srvIncrement;  // @note skip the first slot because we reserved that for imgui
         frameSRVOffsetGPU.ptr += srvIncrement;
 
+        auto const lastMeshletCullingStats = meshletCullingStats;  // @note the scene pass of the previous frame filled these
+        meshletCullingStats = mini::MeshletCullingStats();
+        auto const lastNumDrawCalls = numDrawCalls;
+        auto const lastNumBatches = static_cast<uint32_t>(meshBatches.size());
+        auto const lastNumInstances = static_cast<uint32_t>(instanceOrder.size());
+        numDrawCalls = 0;
+
+        // @note frameFenceValue + 1 is signaled once this frame finished executing
+        meshLibrary.BeginFrame(frameFenceValue + 1, frameFence->GetCompletedValue());
         rg.StartFrame();
 
         ImGui_ImplDX12_NewFrame();
@@ -526,7 +705,12 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
             ImGui::SetNextWindowPos(ImVec2(20.0f, 20.0f));
             auto const windowFlags = ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_NoTitleBar;
             if (ImGui::Begin("#info", nullptr, windowFlags)) {
-                ImGui::Text("Frame Time : %fms", frameTime * 1000.0);
+                ImGui::Text("Frame Time : %fms (math backend %s)", frameTime * 1000.0, mini::math::GetSimdBackendName());
+                DrawResourceTelemetry(resourceManager.GetTelemetry());
+                ImGui::Text("Meshlets : %u culled by frustum, %u by normal cone, %.1f%% of triangles culled", lastMeshletCullingStats.numFrustumCulled,
+                    lastMeshletCullingStats.numBackfaceCulled, lastMeshletCullingStats.GetCulledTrianglePercentage());
+                ImGui::Text("Meshes : %u culled by bounds", lastMeshletCullingStats.numMeshesCulled);
+                ImGui::Text("Draws : %u for %u instances in %u batches", lastNumDrawCalls, lastNumInstances, lastNumBatches);
             } ImGui::End();
 
             //
@@ -587,33 +771,126 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
                         cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
                         const auto proj = mini::math::make_perspective_proj(mini::math::DegToRad(60.0f), viewport.Width / viewport.Height, 0.1f, 100.0f);
-                        const auto view = mini::math::inverse(mini::math::make_lookat(mini::math::vec3f_t(0.0f, 1.5f, -8.0f), mini::math::vec3f_t(), mini::math::vec3f_t(0.0f, 1.0f, 0.0f)));
+                        const auto view = mini::math::inverse_rigid(mini::math::make_lookat(mini::math::vec3f_t(0.0f, 1.5f, -8.0f), mini::math::vec3f_t(), mini::math::vec3f_t(0.0f, 1.0f, 0.0f)));
+                        float const eye[3] = { 0.0f, 1.5f, -8.0f };
+                        float const forward[3] = { 0.0f, -1.5f, 8.0f };
+                        float const up[3] = { 0.0f, 1.0f, 0.0f };
+                        auto const cullingView = mini::MakeCullingView(eye, forward, up, mini::math::DegToRad(60.0f), viewport.Width / viewport.Height, 0.1f, 100.0f);
+                        mini::LodSelectionView lodView;
+                        memcpy(lodView.position, eye, sizeof(eye));
+                        lodView.projectionScale = mini::ComputeLodProjectionScale(mini::math::DegToRad(60.0f), viewport.Height);
 
 
                         static float rot = 0.0f;
                         rot += 0.5f * static_cast<float>(frameTime);
-                        for (auto const& mesh : meshes) {
+                        // @note all meshes share the same vertex / index buffers, so their SRVs are copied into the frame ringbuffer heap and bound once
+                        d3dDevice->CopyDescriptorsSimple(2, frameSRVOffsetCPU, { meshLibrary.GetBufferViews() }, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+                        cmdList->SetGraphicsRootDescriptorTable(1, frameSRVOffsetGPU);
+                        frameSRVOffsetCPU.ptr += srvIncrement * 2;
+                        frameSRVOffsetGPU.ptr += srvIncrement * 2;
+
+                        // @note    all meshes are first tested at once against the view projection's frustum with their bounding spheres,
+                        //          which reads the scene's positions and radii only. the survivors get the exact test below
+                        const auto viewProj = proj * view;
+                        auto const numMeshes = scene.GetCount();
+                        meshCandidates.resize(numMeshes);
+                        auto const numCandidates = scene.CullSpheres(mini::math::make_frustum(viewProj), meshCandidates.data());
+                        meshletCullingStats.numMeshesCulled += numMeshes - numCandidates;
+
+                        // visible meshes are grouped by mesh and LOD so each group goes out as one instanced draw
+                        auto const positions = scene.GetPositions();
+                        auto const rotations = scene.GetRotations();
+                        auto const scales = scene.GetScales();
+                        visibleInstances.clear();
+                        meshCullingViews.resize(numMeshes);
+                        for (auto c = 0u; c < numCandidates; ++c) {
+                            auto const i = meshCandidates[c];
+                            auto const resourceHandle = scene.GetMeshes()[i];
+                            auto meshResource = meshLibrary.Lookup(resourceHandle);
+
+                            float const position[3] = { positions.x[i], positions.y[i], positions.z[i] };
+                            float const rotation[4] = { rotations.x[i], rotations.y[i], rotations.z[i], rotations.w[i] };
+                            meshCullingViews[i] = mini::TransformCullingView(cullingView, position, rotation, scales[i]);
+                            if (!mini::IsMeshVisible(meshResource->bounds, meshCullingViews[i])) {
+                                meshletCullingStats.numMeshesCulled++;
+                                continue;
+                            }
+                            visibleInstances.push_back({ resourceHandle, mini::SelectMeshLod(*meshResource, position, scales[i], lodView), i });
+                        }
+                        MINI_ASSERT(visibleInstances.size() <= MAX_SCENE_INSTANCES, "Too many visible meshes for the instance buffer");
+                        instanceOrder.resize(visibleInstances.size());
+                        mini::BuildStaticMeshBatches(visibleInstances.data(), static_cast<uint32_t>(visibleInstances.size()), instanceOrder.data(), &meshBatches);
+
+                        // @note    the visible transforms are gathered from the scene's streams in batch order so every model matrix is built by
+                        //          one batch call, straight into the upload buffer
+                        auto const numInstances = static_cast<uint32_t>(instanceOrder.size());
+                        instanceTransforms.resize(numInstances * 8);
+                        auto const stream = [&](uint32_t component) { return instanceTransforms.data() + component * numInstances; };
+                        float const* const sources[8] = { positions.x, positions.y, positions.z, rotations.w, rotations.x, rotations.y, rotations.z, scales };
+                        for (auto k = 0u; k < 8; ++k) {
+                            auto const source = sources[k];
+                            auto const destination = stream(k);
+                            for (auto i = 0u; i < numInstances; ++i) { destination[i] = source[instanceOrder[i]]; }
+                        }
+                        static_assert(sizeof(InstanceData) == sizeof(mini::math::mat3x4f_t), "compose_trs_batch writes consecutive matrices");
+                        mini::math::compose_trs_batch({ stream(0), stream(1), stream(2) }, { stream(3), stream(4), stream(5), stream(6) },
+                            { stream(7), stream(7), stream(7) }, &instanceData->model, numInstances);
 
-                            auto meshResource = meshLibrary.Lookup(mesh.resourceHandle);
-                            // @note allocate two SRVs from the frame ringbuffer heap, copy resource descriptors over then bind them for rendering
+                        cmdList->SetGraphicsRoot32BitConstants(0, 16, &viewProj, 0);
 
-                            d3dDevice->CopyDescriptorsSimple(2, frameSRVOffsetCPU, { meshResource->vertexBufferView }, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-                            cmdList->SetGraphicsRootDescriptorTable(1, frameSRVOffsetGPU);
-                            frameSRVOffsetCPU.ptr += srvIncrement * 2;
-                            frameSRVOffsetGPU.ptr += srvIncrement * 2;
+                        for (auto const& batch : meshBatches) {
 
-                            const auto model = mini::math::make_translation(mesh.transform.position) * mini::math::quat_to_mat(mesh.transform.rotation);
-                            const auto mvp = proj * view * model;
+                            auto meshResource = meshLibrary.Lookup(batch.resourceHandle);
 
-                            struct Constants
+                            struct DrawInfo
                             {
-                                math::mat4x4f_t model;
-                                math::mat4x4f_t mvp;
-                            } constants { model, mvp };
-
-                            cmdList->SetGraphicsRoot32BitConstants(0, 32, &constants, 0);
-
-                            cmdList->DrawInstanced(meshResource->numIndices, 1, 0, 0);
+                                uint32_t vertexOffset;
+                                uint32_t vertexStride;
+                                uint32_t indexOffset;
+                                uint32_t indexFormat;
+                                float    positionOffset[3];
+                                uint32_t vertexFormat;
+                                float    positionScale[3];
+                                uint32_t padding;
+                            } drawInfo { meshResource->vertexOffset, meshResource->vertexStride, meshResource->indexOffset, static_cast<uint32_t>(meshResource->indexFormat),
+                                { meshResource->positionOffset[0], meshResource->positionOffset[1], meshResource->positionOffset[2] }, static_cast<uint32_t>(meshResource->vertexFormat),
+                                { meshResource->positionScale[0], meshResource->positionScale[1], meshResource->positionScale[2] }, 0 };
+                            static_assert(sizeof(DrawInfo) == sizeof(uint32_t) * 12, "DrawInfo must match the root constant layout");
+                            cmdList->SetGraphicsRoot32BitConstants(2, 12, &drawInfo, 0);
+
+                            // @note SV_InstanceID always starts at 0, so the batch's instances are addressed through the root SRV's offset
+                            cmdList->SetGraphicsRootShaderResourceView(3, instanceBuffer->GetGPUVirtualAddress() + batch.firstInstance * sizeof(InstanceData));
+
+                            auto const& lod = meshResource->lods[batch.lod];
+                            if (lod.numMeshlets == 0) {
+                                cmdList->DrawInstanced(lod.numIndices, batch.numInstances, lod.firstIndex, 0);
+                                numDrawCalls++;
+                                continue;
+                            }
+
+                            // @note    instances of a batch share their draws, so a meshlet is drawn for all of them once any instance sees it.
+                            //          culling stays conservative, it just rejects less the more instances a batch has
+                            auto const meshlets = meshLibrary.GetMeshlets(*meshResource) + lod.firstMeshlet;
+                            visibleMeshlets.resize(lod.numMeshlets);
+                            batchMeshletVisibility.assign(lod.numMeshlets, 0);
+                            for (auto i = batch.firstInstance; i < batch.firstInstance + batch.numInstances; ++i) {
+                                auto const numVisible = mini::CullMeshlets(meshlets, lod.numMeshlets, meshCullingViews[instanceOrder[i]], visibleMeshlets.data(), &meshletCullingStats);
+                                for (auto v = 0u; v < numVisible; ++v) {
+                                    batchMeshletVisibility[visibleMeshlets[v]] = 1;
+                                }
+                            }
+
+                            // meshlets are contiguous index ranges, so runs of visible neighbours go out as a single draw
+                            for (auto i = 0u; i < lod.numMeshlets;) {
+                                if (!batchMeshletVisibility[i]) { ++i; continue; }
+                                auto const firstIndex = meshlets[i].firstIndex;
+                                auto numIndices = 0u;
+                                for (; i < lod.numMeshlets && batchMeshletVisibility[i]; ++i) {
+                                    numIndices += meshlets[i].numIndices;
+                                }
+                                cmdList->DrawInstanced(numIndices, batch.numInstances, firstIndex, 0);   // @note SV_VertexID starts at firstIndex, see LoadIndex
+                                numDrawCalls++;
+                            }
                         }
                     };
                 })
@@ -654,6 +931,9 @@ int CALLBACK WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
 
         cmdList->Close();
 
+        // @note mesh data staged since the last frame is copied on the copy queue, the frame waits for it on the GPU
+        meshLibrary.FlushUploads(graphicsQueue);
+
         ID3D12CommandList* submits[] = { cmdList };
         graphicsQueue->ExecuteCommandLists(1, submits);
 
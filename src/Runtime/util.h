@@ -2,11 +2,18 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#if defined(_WIN32)
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <windows.h>
+#else
+#include <time.h>
+#endif
 
 namespace mini {
+#if defined(_WIN32)
     /*
         *   Win32 High Precision Timer
     */
@@ -37,6 +44,32 @@ namespace mini {
             return static_cast<double>(currentTime.QuadPart - m_timestamp) / static_cast<double>(m_frequency);
         }
     };
+#else
+    /*
+        *   POSIX monotonic clock timer, used by the headless tools on Linux
+    */
+    class Timer
+    {
+        uint64_t m_timestamp;
+
+        static uint64_t Now()
+        {
+            timespec ts = {};
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+        }
+    public:
+        Timer() : m_timestamp(Now()) {}
+
+        void Reset() {
+            m_timestamp = Now();
+        }
+
+        double GetElapsedTime() {
+            return static_cast<double>(Now() - m_timestamp) * 1e-9;
+        }
+    };
+#endif
 
     class ByteStream
     {
@@ -82,7 +115,7 @@ namespace mini {
         }
     };
 
-
+#if defined(_WIN32)
     inline void* Win32LoadFileContents(char const* path, uint64_t* outFileSize = nullptr)
     {
         HANDLE handle = CreateFileA(path, GENERIC_READ, 0, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
@@ -105,4 +138,33 @@ namespace mini {
         CloseHandle(handle);
         return buffer;
     }
-}
\ No newline at end of file
+#endif
+
+    // @note returned buffer is allocated with malloc and null terminated, same as Win32LoadFileContents
+    inline void* LoadFileContents(char const* path, uint64_t* outFileSize = nullptr)
+    {
+#if defined(_WIN32)
+        return Win32LoadFileContents(path, outFileSize);
+#else
+        FILE* file = fopen(path, "rb");
+        if (file == nullptr) {
+            return nullptr;
+        }
+        fseek(file, 0, SEEK_END);
+        auto const size = static_cast<uint64_t>(ftell(file));
+        fseek(file, 0, SEEK_SET);
+        void* buffer = malloc(size + 1);
+        memset(buffer, 0x0, size + 1);
+        auto const bytesRead = fread(buffer, 1, size, file);
+        fclose(file);
+        if (outFileSize != nullptr) {
+            *outFileSize = size;
+        }
+        if (bytesRead != size) {
+            free(buffer);
+            return nullptr;
+        }
+        return buffer;
+#endif
+    }
+}